@@ -0,0 +1,12 @@
+#ifndef HEADER_fd_src_choreo_fd_choreo_h
+#define HEADER_fd_src_choreo_fd_choreo_h
+
+#include "fd_choreo_base.h"
+#include "epoch/fd_epoch.h"
+#include "eqvoc/fd_eqvoc.h"
+#include "forks/fd_forks.h"
+#include "ghost/fd_ghost.h"
+#include "tower/fd_tower.h"
+#include "voter/fd_voter.h"
+
+#endif /* HEADER_fd_src_choreo_fd_choreo_h */
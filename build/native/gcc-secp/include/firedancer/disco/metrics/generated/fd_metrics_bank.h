@@ -0,0 +1,129 @@
+/* THIS FILE IS GENERATED BY gen_metrics.py. DO NOT HAND EDIT. */
+
+#include "../fd_metrics_base.h"
+#include "fd_metrics_enums.h"
+
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_SANITIZE_FAILURE_OFF  (16UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_SANITIZE_FAILURE_NAME "bank_transaction_sanitize_failure"
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_SANITIZE_FAILURE_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_SANITIZE_FAILURE_DESC "Number of transactions that failed to sanitize."
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_SANITIZE_FAILURE_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_NOT_EXECUTED_FAILURE_OFF  (17UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_NOT_EXECUTED_FAILURE_NAME "bank_transaction_not_executed_failure"
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_NOT_EXECUTED_FAILURE_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_NOT_EXECUTED_FAILURE_DESC "Number of transactions that did not execute. This is different than transactions which fail to execute, which make it onto the chain."
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_NOT_EXECUTED_FAILURE_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_BANK_PRECOMPILE_VERIFY_FAILURE_OFF  (18UL)
+#define FD_METRICS_COUNTER_BANK_PRECOMPILE_VERIFY_FAILURE_NAME "bank_precompile_verify_failure"
+#define FD_METRICS_COUNTER_BANK_PRECOMPILE_VERIFY_FAILURE_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_BANK_PRECOMPILE_VERIFY_FAILURE_DESC "Number of transactions that failed precompile verification and thus will not execute."
+#define FD_METRICS_COUNTER_BANK_PRECOMPILE_VERIFY_FAILURE_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_BANK_SLOT_ACQUIRE_OFF  (19UL)
+#define FD_METRICS_COUNTER_BANK_SLOT_ACQUIRE_NAME "bank_slot_acquire"
+#define FD_METRICS_COUNTER_BANK_SLOT_ACQUIRE_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_BANK_SLOT_ACQUIRE_DESC "Result of acquiring a slot."
+#define FD_METRICS_COUNTER_BANK_SLOT_ACQUIRE_CVT  (FD_METRICS_CONVERTER_NONE)
+#define FD_METRICS_COUNTER_BANK_SLOT_ACQUIRE_CNT  (3UL)
+
+#define FD_METRICS_COUNTER_BANK_SLOT_ACQUIRE_SUCCESS_OFF (19UL)
+#define FD_METRICS_COUNTER_BANK_SLOT_ACQUIRE_TOO_HIGH_OFF (20UL)
+#define FD_METRICS_COUNTER_BANK_SLOT_ACQUIRE_TOO_LOW_OFF (21UL)
+
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_LOAD_ADDRESS_TABLES_OFF  (22UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_LOAD_ADDRESS_TABLES_NAME "bank_transaction_load_address_tables"
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_LOAD_ADDRESS_TABLES_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_LOAD_ADDRESS_TABLES_DESC "Result of loading address lookup tables for a transaction. If there are multiple errors for the transaction, only the first one is reported."
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_LOAD_ADDRESS_TABLES_CVT  (FD_METRICS_CONVERTER_NONE)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_LOAD_ADDRESS_TABLES_CNT  (6UL)
+
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_LOAD_ADDRESS_TABLES_SUCCESS_OFF (22UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_LOAD_ADDRESS_TABLES_SLOT_HASHES_SYSVAR_NOT_FOUND_OFF (23UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_LOAD_ADDRESS_TABLES_ACCOUNT_NOT_FOUND_OFF (24UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_LOAD_ADDRESS_TABLES_INVALID_ACCOUNT_OWNER_OFF (25UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_LOAD_ADDRESS_TABLES_INVALID_ACCOUNT_DATA_OFF (26UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_LOAD_ADDRESS_TABLES_INVALID_INDEX_OFF (27UL)
+
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_OFF  (28UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_NAME "bank_transaction_result"
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_DESC "Result of loading and executing a transaction."
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_CVT  (FD_METRICS_CONVERTER_NONE)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_CNT  (41UL)
+
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_SUCCESS_OFF (28UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_ACCOUNT_IN_USE_OFF (29UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_ACCOUNT_LOADED_TWICE_OFF (30UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_ACCOUNT_NOT_FOUND_OFF (31UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_PROGRAM_ACCOUNT_NOT_FOUND_OFF (32UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_INSUFFICIENT_FUNDS_FOR_FEE_OFF (33UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_INVALID_ACCOUNT_FOR_FEE_OFF (34UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_ALREADY_PROCESSED_OFF (35UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_BLOCKHASH_NOT_FOUND_OFF (36UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_INSTRUCTION_ERROR_OFF (37UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_CALL_CHAIN_TOO_DEEP_OFF (38UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_MISSING_SIGNATURE_FOR_FEE_OFF (39UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_INVALID_ACCOUNT_INDEX_OFF (40UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_SIGNATURE_FAILURE_OFF (41UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_INVALID_PROGRAM_FOR_EXECUTION_OFF (42UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_SANITIZE_FAILURE_OFF (43UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_CLUSTER_MAINTENANCE_OFF (44UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_ACCOUNT_BORROW_OUTSTANDING_OFF (45UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT_OFF (46UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_UNSUPPORTED_VERSION_OFF (47UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_INVALID_WRITABLE_ACCOUNT_OFF (48UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT_OFF (49UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT_OFF (50UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_TOO_MANY_ACCOUNT_LOCKS_OFF (51UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_ADDRESS_LOOKUP_TABLE_NOT_FOUND_OFF (52UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_INVALID_ADDRESS_LOOKUP_TABLE_OWNER_OFF (53UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_INVALID_ADDRESS_LOOKUP_TABLE_DATA_OFF (54UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_INVALID_ADDRESS_LOOKUP_TABLE_INDEX_OFF (55UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_INVALID_RENT_PAYING_ACCOUNT_OFF (56UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_WOULD_EXCEED_MAX_VOTE_COST_LIMIT_OFF (57UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT_OFF (58UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_DUPLICATE_INSTRUCTION_OFF (59UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_INSUFFICIENT_FUNDS_FOR_RENT_OFF (60UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED_OFF (61UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT_OFF (62UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_RESANITIZATION_NEEDED_OFF (63UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED_OFF (64UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_UNBALANCED_TRANSACTION_OFF (65UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_PROGRAM_CACHE_HIT_MAX_LIMIT_OFF (66UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_COMMIT_CANCELLED_OFF (67UL)
+#define FD_METRICS_COUNTER_BANK_TRANSACTION_RESULT_BUNDLE_PEER_OFF (68UL)
+
+#define FD_METRICS_COUNTER_BANK_PROCESSING_FAILED_OFF  (69UL)
+#define FD_METRICS_COUNTER_BANK_PROCESSING_FAILED_NAME "bank_processing_failed"
+#define FD_METRICS_COUNTER_BANK_PROCESSING_FAILED_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_BANK_PROCESSING_FAILED_DESC "Count of transactions for which the processing stage failed and won't land on chain"
+#define FD_METRICS_COUNTER_BANK_PROCESSING_FAILED_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_BANK_FEE_ONLY_TRANSACTIONS_OFF  (70UL)
+#define FD_METRICS_COUNTER_BANK_FEE_ONLY_TRANSACTIONS_NAME "bank_fee_only_transactions"
+#define FD_METRICS_COUNTER_BANK_FEE_ONLY_TRANSACTIONS_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_BANK_FEE_ONLY_TRANSACTIONS_DESC "Count of transactions that will land on chain but without executing"
+#define FD_METRICS_COUNTER_BANK_FEE_ONLY_TRANSACTIONS_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_BANK_EXECUTED_FAILED_TRANSACTIONS_OFF  (71UL)
+#define FD_METRICS_COUNTER_BANK_EXECUTED_FAILED_TRANSACTIONS_NAME "bank_executed_failed_transactions"
+#define FD_METRICS_COUNTER_BANK_EXECUTED_FAILED_TRANSACTIONS_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_BANK_EXECUTED_FAILED_TRANSACTIONS_DESC "Count of transactions that execute on chain but failed"
+#define FD_METRICS_COUNTER_BANK_EXECUTED_FAILED_TRANSACTIONS_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_BANK_SUCCESSFUL_TRANSACTIONS_OFF  (72UL)
+#define FD_METRICS_COUNTER_BANK_SUCCESSFUL_TRANSACTIONS_NAME "bank_successful_transactions"
+#define FD_METRICS_COUNTER_BANK_SUCCESSFUL_TRANSACTIONS_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_BANK_SUCCESSFUL_TRANSACTIONS_DESC "Count of transactions that execute on chain and succeed"
+#define FD_METRICS_COUNTER_BANK_SUCCESSFUL_TRANSACTIONS_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_BANK_COST_MODEL_UNDERCOUNT_OFF  (73UL)
+#define FD_METRICS_COUNTER_BANK_COST_MODEL_UNDERCOUNT_NAME "bank_cost_model_undercount"
+#define FD_METRICS_COUNTER_BANK_COST_MODEL_UNDERCOUNT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_BANK_COST_MODEL_UNDERCOUNT_DESC "Count of transactions that used more CUs than the cost model should have permitted them to"
+#define FD_METRICS_COUNTER_BANK_COST_MODEL_UNDERCOUNT_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_BANK_TOTAL (58UL)
+extern const fd_metrics_meta_t FD_METRICS_BANK[FD_METRICS_BANK_TOTAL];
@@ -0,0 +1,55 @@
+/* THIS FILE IS GENERATED BY gen_metrics.py. DO NOT HAND EDIT. */
+
+#include "../fd_metrics_base.h"
+#include "fd_metrics_enums.h"
+
+#define FD_METRICS_GAUGE_REPLAY_SLOT_OFF  (16UL)
+#define FD_METRICS_GAUGE_REPLAY_SLOT_NAME "replay_slot"
+#define FD_METRICS_GAUGE_REPLAY_SLOT_TYPE (FD_METRICS_TYPE_GAUGE)
+#define FD_METRICS_GAUGE_REPLAY_SLOT_DESC ""
+#define FD_METRICS_GAUGE_REPLAY_SLOT_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_GAUGE_REPLAY_LAST_VOTED_SLOT_OFF  (17UL)
+#define FD_METRICS_GAUGE_REPLAY_LAST_VOTED_SLOT_NAME "replay_last_voted_slot"
+#define FD_METRICS_GAUGE_REPLAY_LAST_VOTED_SLOT_TYPE (FD_METRICS_TYPE_GAUGE)
+#define FD_METRICS_GAUGE_REPLAY_LAST_VOTED_SLOT_DESC ""
+#define FD_METRICS_GAUGE_REPLAY_LAST_VOTED_SLOT_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_HIT_OFF  (18UL)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_HIT_NAME "replay_progcache_hit"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_HIT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_HIT_DESC "The number of times a validated program was found in the program cache"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_HIT_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_MISS_OFF  (19UL)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_MISS_NAME "replay_progcache_miss"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_MISS_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_MISS_DESC "The number of times a program had to be loaded and validated because it was not in the program cache"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_MISS_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INSERT_OFF  (20UL)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INSERT_NAME "replay_progcache_insert"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INSERT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INSERT_DESC "The number of validated programs inserted into the program cache"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INSERT_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_EVICT_OFF  (21UL)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_EVICT_NAME "replay_progcache_evict"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_EVICT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_EVICT_DESC "The number of programs evicted from the program cache to make room for others"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_EVICT_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INVALIDATE_OFF  (22UL)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INVALIDATE_NAME "replay_progcache_invalidate"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INVALIDATE_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INVALIDATE_DESC "The number of programs removed from the program cache because their program data account was modified"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INVALIDATE_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_GAUGE_REPLAY_PROGCACHE_DATA_SZ_OFF  (23UL)
+#define FD_METRICS_GAUGE_REPLAY_PROGCACHE_DATA_SZ_NAME "replay_progcache_data_sz"
+#define FD_METRICS_GAUGE_REPLAY_PROGCACHE_DATA_SZ_TYPE (FD_METRICS_TYPE_GAUGE)
+#define FD_METRICS_GAUGE_REPLAY_PROGCACHE_DATA_SZ_DESC "The number of bytes of validated programs currently held in the program cache"
+#define FD_METRICS_GAUGE_REPLAY_PROGCACHE_DATA_SZ_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_REPLAY_TOTAL (8UL)
+extern const fd_metrics_meta_t FD_METRICS_REPLAY[FD_METRICS_REPLAY_TOTAL];
@@ -0,0 +1,154 @@
+#ifndef HEADER_fd_src_flamenco_runtime_fd_progcache_h
+#define HEADER_fd_src_flamenco_runtime_fd_progcache_h
+
+/* fd_progcache is a content addressed cache of loaded and validated
+   sBPF program images (see fd_sbpf_validated_program_t).  Loading and
+   validating a program is the bulk of the cost of creating a program
+   cache entry in funk, and the same program bytes are loaded over and
+   over again: once per fork that touches the program account, once
+   per lamport transfer to the program account, and once per restart
+   from a snapshot.  fd_progcache lets all of these reuse the first
+   result.
+
+   Entries are keyed by the SHA-256 of the program's ELF bytes and a
+   digest of everything else that influences loading and validation
+   (the enabled sBPF version range and the registered syscalls).  As
+   such, a stale entry can never be returned for changed program bytes
+   or a changed feature set; invalidation (e.g. on Upgrade or Close of
+   an upgradeable program) is only needed to reclaim memory early.
+
+   The cache is a set associative table of FD_PROGCACHE_WAY_CNT ways
+   per set.  Images are stored out of line in wksp allocations in the
+   workspace holding the cache (tagged with the cache's wksp_tag) and
+   the total bytes used by images is bounded by data_max.  When a set
+   is full or data_max would be exceeded, the least recently used
+   entries are evicted.
+
+   Any number of threads / processes can query concurrently with a
+   writer.  Each entry has a sequence lock; a reader that overlaps a
+   concurrent update of the entry it is reading sees a miss.  Inserts
+   and invalidates are serialized by a lock in the cache header. */
+
+#include "../fd_flamenco_base.h"
+
+#define FD_PROGCACHE_ALIGN   (128UL)
+#define FD_PROGCACHE_WAY_CNT (4UL)
+#define FD_PROGCACHE_MAGIC   (0xF17EDA2CE5B0CAC0UL) /* FIREDANCE SBPF CACHE V0 */
+
+/* Default sizing, enough for the working set of mainnet programs. */
+
+#define FD_PROGCACHE_DEFAULT_SET_CNT  (4096UL)
+#define FD_PROGCACHE_DEFAULT_DATA_MAX (2UL<<30)
+#define FD_PROGCACHE_DEFAULT_WKSP_TAG (0x9C0UL)
+
+/* fd_progcache_key_t identifies an image.  hash is the SHA-256 of the
+   ELF bytes and features is a digest of the loader configuration
+   (see fd_bpf_program_util.c). */
+
+struct fd_progcache_key {
+  uchar hash[ 32 ];
+  ulong features;
+};
+
+typedef struct fd_progcache_key fd_progcache_key_t;
+
+/* fd_progcache_metrics_t are cumulative event counters since the cache
+   was created.  data_sz is the number of image bytes currently held. */
+
+struct fd_progcache_metrics {
+  ulong hit_cnt;
+  ulong miss_cnt;
+  ulong insert_cnt;
+  ulong evict_cnt;
+  ulong invalidate_cnt;
+  ulong data_sz;
+};
+
+typedef struct fd_progcache_metrics fd_progcache_metrics_t;
+
+struct fd_progcache_private;
+typedef struct fd_progcache_private fd_progcache_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_progcache_{align,footprint} return the required alignment and
+   footprint of a memory region suitable for use as a program cache
+   with set_cnt sets.  set_cnt must be a power of 2.  footprint returns
+   0 for invalid set_cnt.  The footprint does not include the memory
+   used by cached images, which is allocated from the containing wksp
+   on demand. */
+
+FD_FN_CONST ulong
+fd_progcache_align( void );
+
+FD_FN_CONST ulong
+fd_progcache_footprint( ulong set_cnt );
+
+/* fd_progcache_new formats an unused memory region for use as a
+   program cache.  shmem must be a part of a wksp (images are allocated
+   from that wksp with tag wksp_tag).  data_max bounds the total number
+   of image bytes held by the cache.  Returns shmem on success and NULL
+   on failure (logs details). */
+
+void *
+fd_progcache_new( void * shmem,
+                  ulong  set_cnt,
+                  ulong  data_max,
+                  ulong  wksp_tag );
+
+fd_progcache_t *
+fd_progcache_join( void * shcache );
+
+void *
+fd_progcache_leave( fd_progcache_t * cache );
+
+/* fd_progcache_delete unformats a memory region used as a program
+   cache and frees all images held by it.  Assumes nobody is joined. */
+
+void *
+fd_progcache_delete( void * shcache );
+
+/* fd_progcache_query looks up key in the cache.  On a hit, copies the
+   image into [dst,dst+dst_sz) and returns 1.  On a miss (including
+   when the cached image size does not match dst_sz or when the entry
+   was concurrently updated), returns 0 and the contents of dst are
+   unspecified. */
+
+int
+fd_progcache_query( fd_progcache_t *           cache,
+                    fd_progcache_key_t const * key,
+                    void *                     dst,
+                    ulong                      dst_sz );
+
+/* fd_progcache_insert copies the image [img,img+img_sz) into the
+   cache under key, evicting other entries as needed.  addr is the
+   account address the image was loaded from (used by
+   fd_progcache_invalidate).  If key is already present, this just
+   marks it as recently used.  Returns 1 if the image is in the cache
+   on return and 0 otherwise (e.g. img_sz exceeds data_max or the wksp
+   is out of memory). */
+
+int
+fd_progcache_insert( fd_progcache_t *           cache,
+                     fd_progcache_key_t const * key,
+                     fd_pubkey_t const *        addr,
+                     void const *               img,
+                     ulong                      img_sz );
+
+/* fd_progcache_invalidate removes all images loaded from account addr.
+   Returns the number of entries removed.  This is O(entry count). */
+
+ulong
+fd_progcache_invalidate( fd_progcache_t *    cache,
+                         fd_pubkey_t const * addr );
+
+/* fd_progcache_metrics_snap copies a snapshot of the cache metrics
+   into out and returns out. */
+
+fd_progcache_metrics_t *
+fd_progcache_metrics_snap( fd_progcache_t const *   cache,
+                           fd_progcache_metrics_t * out );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_runtime_fd_progcache_h */
@@ -0,0 +1,226 @@
+#ifndef HEADER_fd_src_flamenco_snapshot_fd_snapshot_restore_h
+#define HEADER_fd_src_flamenco_snapshot_fd_snapshot_restore_h
+
+/* fd_snapshot_restore.h provides APIs for the downstream part of the
+   snapshot loading pipeline.
+
+     read => unzstd => untar => restore
+                                ^^^^^^^
+
+   This header provides APIs for restoring an execution context from the
+   individual snapshot files.  (The outer layers, such as the TAR stream
+   and Zstandard compression, are managed by fd_snapshot_load).
+
+   By default, all restore work runs on the caller's thread.  Optionally,
+   AppendVec parsing and account insertion can be fanned out to a thread
+   pool (see fd_snapshot_restore_set_tpool), in which case the caller's
+   thread only decompresses and untars, and buffers each AppendVec for a
+   worker:
+
+     read => unzstd => untar => buffer ==> worker 1: parse => insert
+                                       ==> worker 2: parse => insert
+                                       ==> ...
+
+   The snapshot format contains complex data structures without size
+   restrictions.  This API will effectively make an unbounded amount of
+   heap allocations while loading a snapshot. */
+
+#include "fd_snapshot_base.h"
+#include "../../util/archive/fd_tar.h"
+#include "../../util/tpool/fd_tpool.h"
+#include "../runtime/context/fd_exec_slot_ctx.h"
+
+/* We want to exit out of snapshot loading once the manifest has been loaded in.
+   Once it has been seen, we don't want to exit out of snapshot loading if we
+   have already done so once. We exit out to allow for manifest data to be used
+   around the codebase. */
+
+#define MANIFEST_DONE          (INT_MAX)
+#define MANIFEST_DONE_NOT_SEEN (1)
+#define MANIFEST_DONE_SEEN     (2)
+
+/* FD_SNAPSHOT_RESTORE_PARA_BUF_SZ is the recommended per-worker buffer
+   size for parallel restore.  Almost all AppendVecs in a mainnet
+   snapshot fit.  Larger AppendVecs are restored on the caller's
+   thread. */
+
+#define FD_SNAPSHOT_RESTORE_PARA_BUF_SZ (16UL<<20) /* 16 MiB */
+
+/* fd_snapshot_restore_t implements a streaming TAR reader that parses
+   archive records on the fly.  Records include the manifest (at the
+   start of the file), and account data.  Notably, this object does on-
+   the-fly heap allocations. */
+
+struct fd_snapshot_restore;
+typedef struct fd_snapshot_restore fd_snapshot_restore_t;
+
+/* fd_snapshot_restore_cb_manifest_fn_t is a callback that provides the
+   user of snapshot restore with the deserialized manifest.  The caller
+   may move out data from the manifest (by zeroing out the fields that
+   data was moved out from).  The lifetime of these moved values is
+   that of the memory allocator in fd_snapshot_restore_new.  Any
+   leftover fields will be freed on return.  The caller is responsible
+   for freeing any moved objects even when returning an error.
+
+   ctx is the pointer provided to fd_snapshot_restore_set_cb_manifest.
+   Returns 0 on success.  Non-zero return value implies failure.  The
+   return value gets forwarded to the original caller of the restore
+   API. */
+
+typedef int
+(* fd_snapshot_restore_cb_manifest_fn_t)( void *                 ctx,
+                                          fd_solana_manifest_t * manifest,
+                                          fd_spad_t *            spad );
+
+/* fd_snapshot_restore_cb_status_cache_fn_t is a callback that provides the
+   user of snapshot restore with the deserialized slot deltas.  The caller
+   may copy data from the deltas. Any leftover fields will be freed on return.
+
+   ctx is the pointer provided to fd_snapshot_restore_set_cb_status_cache.
+   Returns 0 on success.  Non-zero return value implies failure.  The
+   return value gets forwarded to the original caller of the restore
+   API. */
+typedef int
+(* fd_snapshot_restore_cb_status_cache_fn_t)( void *                  ctx,
+                                              fd_bank_slot_deltas_t * slot_deltas,
+                                              fd_spad_t *             spad );
+
+typedef int
+(* fd_snapshot_restore_cb_rent_fresh_account_fn_t)( fd_exec_slot_ctx_t * slot_ctx,
+                                                    fd_pubkey_t const *  pubkey );
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_snapshot_restore_{align,footprint} return required memory region
+   parameters for the fd_snapshot_restore_t object. */
+
+FD_FN_CONST ulong
+fd_snapshot_restore_align( void );
+
+FD_FN_CONST ulong
+fd_snapshot_restore_footprint( void );
+
+/* fd_snapshot_restore_new creates a restore object in the given memory
+   region, which adheres to above alignment/footprint requirements.
+   Returns qualified handle to object given restore object on success.
+
+   spad is a bump allocator that outlives the snapshot restore
+   object.  This allocator is used to buffer the serialized snapshot
+   manifest (ca ~500 MB) and account data.
+
+   The snapshot manifest is provided to the callback function.  This
+   callback is invoked up to one time per restore object.  cb_manifest_ctx is an
+   opaque pointer that is passed to the callback (and ignored by this
+   API otherwise).  It is valid to provide a NULL cb_manifest_ctx.
+
+   The status cache is also restored using the provided callback if
+   a valid callback method is provided. It is valid to provide a NULL
+   callback for testing purposes as of now, and the status_cache_ctx
+   can also be NULL.
+
+   Accounts are restored into the given account manager and funk
+   transaction.  (Note that the restore process will leave behind
+   "tombstone" account records that are invisible to fd_txn_account_init_from_funk_readonly,
+   but do appear to fd_funk_get_acc_meta_readonly.)
+
+   On failure, returns NULL.  Reasons for failure include invalid memory
+   region.  Logs reasons for failure. */
+
+fd_snapshot_restore_t *
+fd_snapshot_restore_new( void *                                         mem,
+                         fd_funk_t *                                    funk,
+                         fd_funk_txn_t *                                txn,
+                         fd_spad_t *                                    spad,
+                         void *                                         cb_manifest_ctx,
+                         fd_snapshot_restore_cb_manifest_fn_t           cb_manifest,
+                         fd_snapshot_restore_cb_status_cache_fn_t       cb_status_cache,
+                         fd_snapshot_restore_cb_rent_fresh_account_fn_t cb_rent_fresh_account );
+
+/* fd_snapshot_restore_delete destroys the given restore object and
+   frees any resources.  Waits for any in-flight parallel restore work
+   to finish.  Returns allocated memory region back to caller. */
+
+void *
+fd_snapshot_restore_delete( fd_snapshot_restore_t * self );
+
+/* fd_snapshot_restore_file provides a file to fd_snapshot_restore_t.
+   restore is a fd_snapshot_restore_t pointer.  meta is the TAR file
+   header of the file.  sz is the size of the file.  Suitable as a
+   fd_tar_file_fn_t callback to fd_tar_reader. */
+
+int
+fd_snapshot_restore_file( void *                restore,
+                          fd_tar_meta_t const * meta,
+                          ulong                 sz );
+
+/* fd_snapshot_restore_chunk provides a chunk of a file to
+   fd_snapshot_restore_t.  restore is a fd_snapshot_restore_t pointer.
+   [buf,buf+bufsz) is the memory region containing the file chunk.
+   Suitable as a fd_tar_read_fn_t callback to fd_tar_reader. */
+
+int
+fd_snapshot_restore_chunk( void *       restore,
+                           void const * buf,
+                           ulong        bufsz );
+
+/* fd_snapshot_restore_set_tpool configures restore to parse AppendVec
+   files and insert their accounts on tpool threads [t0,t1).  Each
+   worker gets a buf_sz byte buffer allocated from the restore spad
+   (FD_SNAPSHOT_RESTORE_PARA_BUF_SZ is a reasonable default).  The
+   caller's thread copies each AppendVec that fits into the next
+   worker's buffer and dispatches it; AppendVecs that don't fit are
+   restored on the caller's thread after all workers went idle.
+
+   Concurrent inserts of the same account are serialized with a striped
+   lock keyed by account address, so the newest revision of an account
+   wins as in the serial case.  Ties (the same account appearing twice
+   in AppendVecs of the same slot) resolve in unspecified order.
+
+   The funk transaction restored into must not be modified by the
+   caller while restore work is in flight (see
+   fd_snapshot_restore_drain).  cb_rent_fresh_account may be called
+   from worker threads (calls are serialized).
+
+   Must be called before the first AppendVec is provided.  Assumes
+   tpool threads [t0,t1) are idle and not used by the caller while the
+   restore object is active.  Returns restore on success.  On failure
+   (invalid range or insufficient spad space), logs a warning and
+   returns NULL, leaving restore in serial mode. */
+
+fd_snapshot_restore_t *
+fd_snapshot_restore_set_tpool( fd_snapshot_restore_t * restore,
+                               fd_tpool_t *            tpool,
+                               ulong                   t0,
+                               ulong                   t1,
+                               ulong                   buf_sz );
+
+/* fd_snapshot_restore_drain waits for all in-flight parallel restore
+   work to finish.  Returns 0 on success or an errno-compatible error
+   code if any worker failed (logs details).  No-op when restore is in
+   serial mode.  fd_snapshot_loader_advance calls this before reporting
+   EOF. */
+
+int
+fd_snapshot_restore_drain( fd_snapshot_restore_t * restore );
+
+ulong
+fd_snapshot_restore_get_slot( fd_snapshot_restore_t * restore );
+
+/* fd_snapshot_restore_get_{acc_cnt,accv_sz} return the number of
+   account records and the number of AppendVec bytes restored so far.
+   Only counts completed work (call fd_snapshot_restore_drain first for
+   an exact count). */
+
+ulong
+fd_snapshot_restore_get_acc_cnt( fd_snapshot_restore_t * restore );
+
+ulong
+fd_snapshot_restore_get_accv_sz( fd_snapshot_restore_t * restore );
+
+/* fd_snapshot_restore_tar_vt implements fd_tar_read_vtable_t. */
+
+extern fd_tar_read_vtable_t const fd_snapshot_restore_tar_vt;
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_snapshot_fd_snapshot_restore_h */
@@ -0,0 +1,12 @@
+#ifndef HEADER_fd_src_groove_fd_groove_h
+#define HEADER_fd_src_groove_fd_groove_h
+
+/* Note: will still function without FD_HAS_ATOMIC but will not be safe
+   to use concurrently. */
+
+//#include "fd_groove_base.h"   /* includes ../util/fd_util.h */
+//#include "fd_groove_meta.h"   /* includes fd_groove_base.h */
+//#include "fd_groove_volume.h" /* includes fd_groove_base.h */
+#include "fd_groove_data.h"     /* includes fd_groove_meta.h, fd_groove_volume.h */
+
+#endif /* HEADER_fd_src_groove_fd_groove_h */
@@ -0,0 +1,6 @@
+#ifndef HEADER_fd_src_waltz_fd_waltz_base_h
+#define HEADER_fd_src_waltz_fd_waltz_base_h
+
+#include "../util/fd_util.h"
+
+#endif /* HEADER_fd_src_waltz_fd_waltz_base_h */
@@ -0,0 +1,13 @@
+#ifndef HEADER_fd_src_waltz_quic_fd_quic_proto_structs_h
+#define HEADER_fd_src_waltz_quic_fd_quic_proto_structs_h
+
+#include "fd_quic_common.h"
+#include "fd_quic_types.h"
+
+#include "templ/fd_quic_defs.h"
+#include "templ/fd_quic_templ.h"
+#include "templ/fd_quic_frames_templ.h"
+#include "templ/fd_quic_undefs.h"
+
+#endif /* HEADER_fd_src_waltz_quic_fd_quic_proto_structs_h */
+
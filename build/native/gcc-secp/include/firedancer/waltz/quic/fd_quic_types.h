@@ -0,0 +1,13 @@
+#ifndef HEADER_fd_quic_types_h
+#define HEADER_fd_quic_types_h
+
+/* Integer typedefs used by the templ macros. */
+
+#define fd_quic_uchar  uchar
+#define fd_quic_ushort ushort
+#define fd_quic_uint   uint
+#define fd_quic_ulong  ulong
+
+#define FD_QUIC_CONN_ID_TYPE ulong
+
+#endif
@@ -0,0 +1,255 @@
+#ifndef HEADER_fd_src_waltz_uring_fd_io_uring_h
+#define HEADER_fd_src_waltz_uring_fd_io_uring_h
+
+#if defined(__linux__)
+
+/* fd_io_uring provides a minimal io_uring API on top of the raw
+   io_uring_setup(2), io_uring_enter(2) and io_uring_register(2)
+   syscalls (liburing is not a dependency).
+
+   ### Background
+
+   io_uring is a Linux API for asynchronous I/O built on two shared
+   memory ring buffers mapped from the kernel: the submission queue (SQ)
+   through which the user posts I/O requests (SQEs), and the completion
+   queue (CQ) through which the kernel posts results (CQEs).  Many
+   requests can be submitted and their results reaped with a single
+   io_uring_enter syscall.
+
+   A "multishot" request keeps producing completions until it is
+   canceled or fails.  E.g. a multishot recvmsg request posts one CQE
+   per received datagram.  The datagrams are written into buffers taken
+   from a "provided buffer ring", a third shared ring (owned by the
+   user) through which the user hands empty buffers to the kernel.  The
+   kernel consumes provided buffers in ring order.
+
+   This API is intended for single-threaded use by one tile.  All
+   functions that take an fd_io_uring_t are not thread safe. */
+
+#include "../../util/bits/fd_bits.h"
+#include <linux/io_uring.h>
+
+/* FD_IO_URING_BUF_RING_ALIGN is the byte alignment of the memory
+   backing a provided buffer ring.  Set by the kernel. */
+
+#define FD_IO_URING_BUF_RING_ALIGN (4096UL)
+
+/* fd_io_uring_params_t holds the parameters of a new ring. */
+
+struct fd_io_uring_params {
+  uint sq_depth; /* number of SQ entries, power of 2 */
+  uint cq_depth; /* number of CQ entries, power of 2 >= sq_depth, 0 for 2*sq_depth */
+  uint flags;    /* IORING_SETUP_* flags */
+};
+
+typedef struct fd_io_uring_params fd_io_uring_params_t;
+
+/* fd_io_uring_t describes an io_uring instance mapped into the local
+   address space.  The k* pointers point into kernel-shared memory. */
+
+struct fd_io_uring {
+  int  ring_fd;
+  uint features; /* IORING_FEAT_* */
+
+  struct {
+    uint *                khead;
+    uint *                ktail;
+    uint *                kflags;
+    uint *                array;
+    struct io_uring_sqe * sqes;
+    uint                  mask;
+    uint                  depth;
+    uint                  tail;     /* local tail, not yet published */
+
+    void *                ring_mem; /* mmap() params for munmap() */
+    ulong                 ring_sz;
+    ulong                 sqes_sz;
+  } sq;
+
+  struct {
+    uint *                khead;
+    uint *                ktail;
+    uint *                koverflow;
+    struct io_uring_cqe * cqes;
+    uint                  mask;
+    uint                  depth;
+
+    void *                ring_mem; /* NULL if shared with SQ ring */
+    ulong                 ring_sz;
+  } cq;
+};
+
+typedef struct fd_io_uring fd_io_uring_t;
+
+/* fd_io_uring_buf_ring_t is a provided buffer ring registered with an
+   io_uring instance.  The ring memory is owned by the user. */
+
+struct fd_io_uring_buf_ring {
+  struct io_uring_buf_ring * br;
+  uint                       mask;
+  ushort                     tail; /* published tail */
+  ushort                     bgid; /* buffer group ID */
+};
+
+typedef struct fd_io_uring_buf_ring fd_io_uring_buf_ring_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_io_uring_init creates a new io_uring instance and maps its rings
+   into the local address space.  Returns ring on success.  On failure,
+   logs a warning and returns NULL.  Fails if the kernel does not
+   support io_uring (or it is disabled via sysctl), or does not support
+   the given setup flags.
+
+   May issue the following syscalls:
+
+   - io_uring_setup( sq_depth, ... ) = fd
+   - mmap( ..., fd, ... )
+   - munmap  ; on fail
+   - close   ; on fail */
+
+fd_io_uring_t *
+fd_io_uring_init( fd_io_uring_t *              ring,
+                  fd_io_uring_params_t const * params );
+
+/* fd_io_uring_fini unmaps the rings and closes the io_uring file
+   descriptor.  Any in-flight requests are canceled by the kernel.
+   Returns ring. */
+
+fd_io_uring_t *
+fd_io_uring_fini( fd_io_uring_t * ring );
+
+/* fd_io_uring_enter wraps io_uring_enter(2).  Returns the number of
+   SQEs consumed on success, or a negative errno on failure. */
+
+int
+fd_io_uring_enter( fd_io_uring_t * ring,
+                   uint            to_submit,
+                   uint            min_complete,
+                   uint            flags );
+
+/* fd_io_uring_sqe_acquire returns a zeroed SQE at the local tail of the
+   submission queue, or NULL if the submission queue is full.  The SQE
+   is published to the kernel with fd_io_uring_sq_flush. */
+
+static inline struct io_uring_sqe *
+fd_io_uring_sqe_acquire( fd_io_uring_t * ring ) {
+  uint head = FD_VOLATILE_CONST( *ring->sq.khead );
+  if( FD_UNLIKELY( ring->sq.tail-head>=ring->sq.depth ) ) return NULL;
+  struct io_uring_sqe * sqe = ring->sq.sqes + ( ring->sq.tail & ring->sq.mask );
+  ring->sq.tail++;
+  memset( sqe, 0, sizeof(struct io_uring_sqe) );
+  return sqe;
+}
+
+/* fd_io_uring_sq_flush publishes all acquired SQEs to the kernel.
+   Returns the number of SQEs published and not yet consumed by the
+   kernel (i.e. the to_submit argument of the next enter call). */
+
+static inline uint
+fd_io_uring_sq_flush( fd_io_uring_t * ring ) {
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( *ring->sq.ktail ) = ring->sq.tail;
+  FD_COMPILER_MFENCE();
+  return ring->sq.tail - FD_VOLATILE_CONST( *ring->sq.khead );
+}
+
+/* fd_io_uring_submit publishes all acquired SQEs and submits them to
+   the kernel.  If min_complete is non-zero, waits until at least
+   min_complete CQEs are available.  Returns the number of SQEs
+   submitted, or a negative errno on failure. */
+
+static inline int
+fd_io_uring_submit( fd_io_uring_t * ring,
+                    uint            min_complete ) {
+  uint to_submit = fd_io_uring_sq_flush( ring );
+  if( FD_UNLIKELY( !to_submit && !min_complete ) ) return 0;
+  return fd_io_uring_enter( ring, to_submit, min_complete, min_complete ? IORING_ENTER_GETEVENTS : 0U );
+}
+
+/* fd_io_uring_cq_ready returns the number of CQEs available. */
+
+static inline uint
+fd_io_uring_cq_ready( fd_io_uring_t const * ring ) {
+  uint tail = FD_VOLATILE_CONST( *ring->cq.ktail );
+  FD_COMPILER_MFENCE();
+  return tail - *ring->cq.khead;
+}
+
+/* fd_io_uring_cqe returns the idx-th CQE after the CQ head.  idx must
+   be less than fd_io_uring_cq_ready. */
+
+static inline struct io_uring_cqe const *
+fd_io_uring_cqe( fd_io_uring_t const * ring,
+                 uint                  idx ) {
+  return ring->cq.cqes + ( ( *ring->cq.khead + idx ) & ring->cq.mask );
+}
+
+/* fd_io_uring_cq_advance releases cnt CQEs back to the kernel. */
+
+static inline void
+fd_io_uring_cq_advance( fd_io_uring_t * ring,
+                        uint            cnt ) {
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( *ring->cq.khead ) = *ring->cq.khead + cnt;
+  FD_COMPILER_MFENCE();
+}
+
+/* fd_io_uring_buf_ring_footprint returns the size of the memory region
+   backing a provided buffer ring with depth entries.  depth is a power
+   of 2 in [1,2^15].  The region is aligned by
+   FD_IO_URING_BUF_RING_ALIGN. */
+
+FD_FN_CONST static inline ulong
+fd_io_uring_buf_ring_footprint( ulong depth ) {
+  return fd_ulong_align_up( depth*sizeof(struct io_uring_buf), FD_IO_URING_BUF_RING_ALIGN );
+}
+
+/* fd_io_uring_buf_ring_register registers the memory at mem as a
+   provided buffer ring of depth entries with buffer group ID bgid.
+   The ring starts out empty.  Returns buf_ring on success.  On failure,
+   logs a warning and returns NULL.  Requires Linux 5.19 or newer.
+
+   May issue the following syscalls:
+
+   - io_uring_register( fd, IORING_REGISTER_PBUF_RING, ... ) */
+
+fd_io_uring_buf_ring_t *
+fd_io_uring_buf_ring_register( fd_io_uring_t *          ring,
+                               fd_io_uring_buf_ring_t * buf_ring,
+                               void *                   mem,
+                               ulong                    depth,
+                               ushort                   bgid );
+
+/* fd_io_uring_buf_ring_add stages the buffer [addr,addr+len) with
+   buffer ID bid at offset off past the published tail.  Staged buffers
+   are handed to the kernel with fd_io_uring_buf_ring_advance.  The
+   caller is responsible for not exceeding the ring depth. */
+
+static inline void
+fd_io_uring_buf_ring_add( fd_io_uring_buf_ring_t * buf_ring,
+                          void *                   addr,
+                          uint                     len,
+                          ushort                   bid,
+                          uint                     off ) {
+  struct io_uring_buf * buf = &buf_ring->br->bufs[ ( buf_ring->tail + off ) & buf_ring->mask ];
+  buf->addr = (ulong)addr;
+  buf->len  = len;
+  buf->bid  = bid;
+}
+
+/* fd_io_uring_buf_ring_advance publishes cnt staged buffers. */
+
+static inline void
+fd_io_uring_buf_ring_advance( fd_io_uring_buf_ring_t * buf_ring,
+                              uint                     cnt ) {
+  buf_ring->tail = (ushort)( buf_ring->tail + cnt );
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( buf_ring->br->tail ) = buf_ring->tail;
+  FD_COMPILER_MFENCE();
+}
+
+FD_PROTOTYPES_END
+
+#endif /* defined(__linux__) */
+#endif /* HEADER_fd_src_waltz_uring_fd_io_uring_h */
@@ -56,4 +56,24 @@ cat contrib/test/test-vectors-fixtures/elf-loader-fixtures/*.list | xargs -P $NU
 LOG=$LOG_PATH/test_exec_instr
 cat contrib/test/test-vectors-fixtures/instr-fixtures/*.list | xargs -P $NUM_PROCESSES -n 1000 ./$OBJDIR/unit-test/test_exec_sol_compat --log-path $LOG --wksp-page-sz 1073741824
 
+# Re-run the fixtures that execute sBPF programs with the JIT enabled
+# ([development.sbpf_jit], x86-64 only)
+if [ "$(uname -m)" == "x86_64" ]; then
+  export SOL_COMPAT_JIT=1
+
+  LOG=$LOG_PATH/test_exec_interp_jit
+  cat contrib/test/test-vectors-fixtures/vm-interp-fixtures/*.list | xargs -P $NUM_PROCESSES -n 1000 ./$OBJDIR/unit-test/test_exec_sol_compat --log-path $LOG --wksp-page-sz 1073741824
+  find dump/test-vectors/vm_interp/fixtures/v0 -type f -name '*.fix' | xargs -P $NUM_PROCESSES -n 1000 ./$OBJDIR/unit-test/test_exec_sol_compat --log-path $LOG --wksp-page-sz 1073741824
+  find dump/test-vectors/vm_interp/fixtures/v1 -type f -name '*.fix' | xargs -P $NUM_PROCESSES -n 1000 ./$OBJDIR/unit-test/test_exec_sol_compat --log-path $LOG --wksp-page-sz 1073741824
+  find dump/test-vectors/vm_interp/fixtures/v2 -type f -name '*.fix' | xargs -P $NUM_PROCESSES -n 1000 ./$OBJDIR/unit-test/test_exec_sol_compat --log-path $LOG --wksp-page-sz 1073741824
+
+  LOG=$LOG_PATH/test_exec_txn_jit
+  cat contrib/test/test-vectors-fixtures/txn-fixtures/*.list | xargs -P $NUM_PROCESSES ./$OBJDIR/unit-test/test_exec_sol_compat --log-path $LOG --wksp-page-sz 1073741824
+
+  LOG=$LOG_PATH/test_exec_instr_jit
+  cat contrib/test/test-vectors-fixtures/instr-fixtures/*.list | xargs -P $NUM_PROCESSES -n 1000 ./$OBJDIR/unit-test/test_exec_sol_compat --log-path $LOG --wksp-page-sz 1073741824
+
+  unset SOL_COMPAT_JIT
+fi
+
 echo Test vectors success
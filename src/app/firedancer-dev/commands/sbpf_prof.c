@@ -0,0 +1,107 @@
+/* The sbpf_prof command dumps the sBPF profiles accumulated by the exec
+   tiles of a running (or stopped) validator with
+   [development.sbpf_profiler] enabled.  The profiles of all exec tiles
+   are printed to stdout in the folded stack format, one line per
+   (call stack, pc):
+
+     <program_id>;<cpi program_id>;...;pc:<pc> <value>
+
+   which can be fed directly to flamegraph tools.  The value is the
+   number of compute units (--metric cu, the default), instructions
+   (--metric ic) or samples (--metric samples) attributed to it. */
+
+#include "../../shared/fd_config.h"
+#include "../../shared/fd_action.h"
+#include "../../../disco/topo/fd_topo.h"
+#include "../../../flamenco/vm/fd_vm_base.h"
+
+#include <stdio.h>
+
+#define SBPF_PROF_METRIC_CU      (0)
+#define SBPF_PROF_METRIC_IC      (1)
+#define SBPF_PROF_METRIC_SAMPLES (2)
+
+static void
+sbpf_prof_cmd_args( int *    pargc,
+                    char *** pargv,
+                    args_t * args ) {
+  char const * metric = fd_env_strip_cmdline_cstr( pargc, pargv, "--metric", NULL, "cu" );
+  if(      !strcmp( metric, "cu"      ) ) args->sbpf_prof.metric = SBPF_PROF_METRIC_CU;
+  else if( !strcmp( metric, "ic"      ) ) args->sbpf_prof.metric = SBPF_PROF_METRIC_IC;
+  else if( !strcmp( metric, "samples" ) ) args->sbpf_prof.metric = SBPF_PROF_METRIC_SAMPLES;
+  else FD_LOG_ERR(( "unknown --metric `%s`, expected one of cu, ic or samples", metric ));
+}
+
+static void
+sbpf_prof_dump( fd_vm_prof_t const * prof,
+                int                  metric ) {
+  fd_vm_prof_bucket_t const * bucket     = fd_vm_prof_bucket( prof );
+  ulong                       bucket_max = fd_vm_prof_bucket_max( prof );
+
+  ulong skip_cnt = 0UL;
+  for( ulong i=0UL; i<bucket_max; i++ ) {
+    ulong key = FD_VOLATILE_CONST( bucket[ i ].key );
+    if( !key ) continue;
+
+    ulong value;
+    switch( metric ) {
+    case SBPF_PROF_METRIC_IC:      value = bucket[ i ].ic;         break;
+    case SBPF_PROF_METRIC_SAMPLES: value = bucket[ i ].sample_cnt; break;
+    default:                       value = bucket[ i ].cu;         break;
+    }
+    if( !value ) continue;
+
+    char stack[ FD_VM_PROF_STACK_CSTR_MAX ];
+    if( FD_UNLIKELY( !fd_vm_prof_stack_cstr( prof, fd_vm_prof_key_node( key ), stack ) ) ) {
+      skip_cnt++;
+      continue;
+    }
+    printf( "%s;pc:%lu %lu\n", stack, fd_vm_prof_key_pc( key ), value );
+  }
+
+  if( FD_UNLIKELY( skip_cnt ) ) FD_LOG_WARNING(( "skipped %lu buckets with an unknown call stack", skip_cnt ));
+}
+
+static void
+sbpf_prof_cmd_fn( args_t *   args,
+                  config_t * config ) {
+  if( FD_UNLIKELY( !config->firedancer.development.sbpf_profiler.enabled ) ) {
+    FD_LOG_ERR(( "the sBPF profiler is not enabled, set [development.sbpf_profiler.enabled] to true and restart" ));
+  }
+
+  fd_topo_t * topo = &config->topo;
+  fd_topo_join_workspaces( topo, FD_SHMEM_JOIN_MODE_READ_ONLY );
+  fd_topo_fill( topo );
+
+  ulong prof_cnt = 0UL;
+  for( ulong i=0UL; i<topo->obj_cnt; i++ ) {
+    fd_topo_obj_t const * obj = &topo->objs[ i ];
+    if( strcmp( obj->name, "vm_prof" ) ) continue;
+
+    /* The profile is being written concurrently by the exec tile, so
+       this is a best effort snapshot. */
+    fd_vm_prof_t const * prof = fd_vm_prof_join( fd_topo_obj_laddr( topo, obj->id ) );
+    if( FD_UNLIKELY( !prof ) ) FD_LOG_ERR(( "fd_vm_prof_join failed for obj %lu", obj->id ));
+
+    FD_LOG_NOTICE(( "vm_prof obj %lu: %lu samples (%lu call stacks, %lu buckets), %lu dropped (%lu ic, %lu cu)",
+                    obj->id, prof->sample_cnt, prof->node_cnt, prof->bucket_cnt,
+                    prof->drop_cnt, prof->drop_ic, prof->drop_cu ));
+
+    sbpf_prof_dump( prof, args->sbpf_prof.metric );
+    prof_cnt++;
+  }
+  fflush( stdout );
+
+  if( FD_UNLIKELY( !prof_cnt ) ) FD_LOG_WARNING(( "no vm_prof objects found in topology" ));
+
+  fd_topo_leave_workspaces( topo );
+}
+
+action_t fd_action_sbpf_prof = {
+  .name          = "sbpf_prof",
+  .args          = sbpf_prof_cmd_args,
+  .fn            = sbpf_prof_cmd_fn,
+  .perm          = NULL,
+  .description   = "Dump sBPF profiles from the exec tiles as folded stacks",
+  .is_diagnostic = 1
+};
@@ -21,7 +21,10 @@ extern fd_topo_obj_callbacks_t fd_obj_cb_tile;
 extern fd_topo_obj_callbacks_t fd_obj_cb_runtime_pub;
 extern fd_topo_obj_callbacks_t fd_obj_cb_blockstore;
 extern fd_topo_obj_callbacks_t fd_obj_cb_txncache;
+extern fd_topo_obj_callbacks_t fd_obj_cb_progcache;
+extern fd_topo_obj_callbacks_t fd_obj_cb_lthash_delta;
 extern fd_topo_obj_callbacks_t fd_obj_cb_exec_spad;
+extern fd_topo_obj_callbacks_t fd_obj_cb_vm_prof;
 
 fd_topo_obj_callbacks_t * CALLBACKS[] = {
   &fd_obj_cb_mcache,
@@ -38,7 +41,10 @@ fd_topo_obj_callbacks_t * CALLBACKS[] = {
   &fd_obj_cb_runtime_pub,
   &fd_obj_cb_blockstore,
   &fd_obj_cb_txncache,
+  &fd_obj_cb_progcache,
+  &fd_obj_cb_lthash_delta,
   &fd_obj_cb_exec_spad,
+  &fd_obj_cb_vm_prof,
   NULL,
 };
 
@@ -162,6 +168,7 @@ extern action_t fd_action_wksp;
 extern action_t fd_action_gossip;
 extern action_t fd_action_sim;
 extern action_t fd_action_backtest;
+extern action_t fd_action_sbpf_prof;
 
 action_t * ACTIONS[] = {
   &fd_action_run,
@@ -187,6 +194,7 @@ action_t * ACTIONS[] = {
   &fd_action_gossip,
   &fd_action_sim,
   &fd_action_backtest,
+  &fd_action_sbpf_prof,
   NULL,
 };
 
@@ -3,9 +3,12 @@
 
 #include "../../funk/fd_funk.h"
 #include "../../flamenco/runtime/fd_txncache.h"
+#include "../../flamenco/runtime/fd_progcache.h"
+#include "../../flamenco/runtime/fd_lthash_delta.h"
 #include "../../flamenco/runtime/fd_blockstore.h"
 #include "../../flamenco/runtime/fd_runtime.h"
 #include "../../flamenco/runtime/fd_runtime_public.h"
+#include "../../flamenco/vm/fd_vm_base.h"
 
 #define VAL(name) (__extension__({                                                             \
   ulong __x = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "obj.%lu.%s", obj->id, name );      \
@@ -87,6 +90,65 @@ fd_topo_obj_callbacks_t fd_obj_cb_txncache = {
   .new       = txncache_new,
 };
 
+static ulong
+progcache_footprint( fd_topo_t const *     topo,
+                     fd_topo_obj_t const * obj ) {
+  return fd_progcache_footprint( VAL("set_cnt") );
+}
+
+static ulong
+progcache_align( fd_topo_t const *     topo FD_FN_UNUSED,
+                 fd_topo_obj_t const * obj  FD_FN_UNUSED ) {
+  return fd_progcache_align();
+}
+
+static ulong
+progcache_loose( fd_topo_t const *     topo,
+                 fd_topo_obj_t const * obj ) {
+  /* Images are allocated from the workspace on demand, with up to
+     64 bytes of alignment padding each */
+  return VAL("data_max") + VAL("set_cnt")*FD_PROGCACHE_WAY_CNT*64UL;
+}
+
+static void
+progcache_new( fd_topo_t const *     topo,
+               fd_topo_obj_t const * obj ) {
+  FD_TEST( fd_progcache_new( fd_topo_obj_laddr( topo, obj->id ), VAL("set_cnt"), VAL("data_max"), VAL("wksp_tag") ) );
+}
+
+fd_topo_obj_callbacks_t fd_obj_cb_progcache = {
+  .name      = "progcache",
+  .footprint = progcache_footprint,
+  .align     = progcache_align,
+  .loose     = progcache_loose,
+  .new       = progcache_new,
+};
+
+static ulong
+lthash_delta_footprint( fd_topo_t const *     topo,
+                        fd_topo_obj_t const * obj ) {
+  return fd_lthash_delta_footprint( VAL("shard_cnt") );
+}
+
+static ulong
+lthash_delta_align( fd_topo_t const *     topo FD_FN_UNUSED,
+                    fd_topo_obj_t const * obj  FD_FN_UNUSED ) {
+  return fd_lthash_delta_align();
+}
+
+static void
+lthash_delta_new( fd_topo_t const *     topo,
+                  fd_topo_obj_t const * obj ) {
+  FD_TEST( fd_lthash_delta_new( fd_topo_obj_laddr( topo, obj->id ), VAL("shard_cnt") ) );
+}
+
+fd_topo_obj_callbacks_t fd_obj_cb_lthash_delta = {
+  .name      = "lthash_delta",
+  .footprint = lthash_delta_footprint,
+  .align     = lthash_delta_align,
+  .new       = lthash_delta_new,
+};
+
 static ulong
 exec_spad_footprint( fd_topo_t const *     topo FD_FN_UNUSED,
                      fd_topo_obj_t const * obj  FD_FN_UNUSED ) {
@@ -112,4 +174,29 @@ fd_topo_obj_callbacks_t fd_obj_cb_exec_spad = {
   .new       = exec_spad_new,
 };
 
+static ulong
+vm_prof_footprint( fd_topo_t const *     topo,
+                   fd_topo_obj_t const * obj ) {
+  return fd_vm_prof_footprint( VAL("node_max"), VAL("bucket_max") );
+}
+
+static ulong
+vm_prof_align( fd_topo_t const *     topo FD_FN_UNUSED,
+               fd_topo_obj_t const * obj  FD_FN_UNUSED ) {
+  return fd_vm_prof_align();
+}
+
+static void
+vm_prof_new( fd_topo_t const *     topo,
+             fd_topo_obj_t const * obj ) {
+  FD_TEST( fd_vm_prof_new( fd_topo_obj_laddr( topo, obj->id ), VAL("node_max"), VAL("bucket_max"), VAL("sample_period"), obj->id ) );
+}
+
+fd_topo_obj_callbacks_t fd_obj_cb_vm_prof = {
+  .name      = "vm_prof",
+  .footprint = vm_prof_footprint,
+  .align     = vm_prof_align,
+  .new       = vm_prof_new,
+};
+
 #undef VAL
@@ -20,7 +20,10 @@ extern fd_topo_obj_callbacks_t fd_obj_cb_tile;
 extern fd_topo_obj_callbacks_t fd_obj_cb_runtime_pub;
 extern fd_topo_obj_callbacks_t fd_obj_cb_blockstore;
 extern fd_topo_obj_callbacks_t fd_obj_cb_txncache;
+extern fd_topo_obj_callbacks_t fd_obj_cb_progcache;
+extern fd_topo_obj_callbacks_t fd_obj_cb_lthash_delta;
 extern fd_topo_obj_callbacks_t fd_obj_cb_exec_spad;
+extern fd_topo_obj_callbacks_t fd_obj_cb_vm_prof;
 
 fd_topo_obj_callbacks_t * CALLBACKS[] = {
   &fd_obj_cb_mcache,
@@ -37,7 +40,10 @@ fd_topo_obj_callbacks_t * CALLBACKS[] = {
   &fd_obj_cb_runtime_pub,
   &fd_obj_cb_blockstore,
   &fd_obj_cb_txncache,
+  &fd_obj_cb_progcache,
+  &fd_obj_cb_lthash_delta,
   &fd_obj_cb_exec_spad,
+  &fd_obj_cb_vm_prof,
   NULL,
 };
 
@@ -7,10 +7,12 @@
 #include "../../disco/topo/fd_topob.h"
 #include "../../disco/topo/fd_cpu_topo.h"
 #include "../../disco/topo/fd_pod_format.h"
+#include "../../disco/verify/fd_verify_tile.h"
 #include "../../flamenco/runtime/fd_blockstore.h"
 #include "../../flamenco/runtime/fd_runtime.h"
 #include "../../flamenco/runtime/fd_runtime_public.h"
 #include "../../flamenco/runtime/fd_txncache.h"
+#include "../../flamenco/runtime/fd_progcache.h"
 #include "../../flamenco/snapshot/fd_snapshot_base.h"
 #include "../../util/tile/fd_tile_private.h"
 
@@ -77,6 +79,20 @@ setup_topo_txncache( fd_topo_t *  topo,
   return obj;
 }
 
+static fd_topo_obj_t *
+setup_topo_progcache( fd_topo_t *  topo,
+                      char const * wksp_name,
+                      ulong        set_cnt,
+                      ulong        data_max ) {
+  fd_topo_obj_t * obj = fd_topob_obj( topo, "progcache", wksp_name );
+
+  FD_TEST( fd_pod_insertf_ulong( topo->props, set_cnt,                       "obj.%lu.set_cnt",  obj->id ) );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, data_max,                      "obj.%lu.data_max", obj->id ) );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, FD_PROGCACHE_DEFAULT_WKSP_TAG, "obj.%lu.wksp_tag", obj->id ) );
+
+  return obj;
+}
+
 static int
 resolve_gossip_entrypoint( char const *    host_port,
                           fd_ip4_port_t * ip4_port ) {
@@ -291,6 +307,7 @@ fd_topo_initialize( config_t * config ) {
   fd_topob_wksp( topo, "writer"      );
   fd_topob_wksp( topo, "bstore"      );
   fd_topob_wksp( topo, "tcache"      );
+  fd_topob_wksp( topo, "progcache"   );
   fd_topob_wksp( topo, "pohi"        );
   fd_topob_wksp( topo, "voter"       );
   fd_topob_wksp( topo, "poh_slot"    );
@@ -304,6 +321,7 @@ fd_topo_initialize( config_t * config ) {
   fd_topob_wksp( topo, "writer_fseq" );
 
   if( enable_rpc ) fd_topob_wksp( topo, "rpcsrv" );
+  if( FD_UNLIKELY( config->firedancer.development.sbpf_profiler.enabled ) ) fd_topob_wksp( topo, "vm_prof" );
 
   #define FOR(cnt) for( ulong i=0UL; i<cnt; i++ )
 
@@ -313,7 +331,7 @@ fd_topo_initialize( config_t * config ) {
   FOR(quic_tile_cnt)   fd_topob_link( topo, "quic_net",     "net_quic",     config->net.ingress_buffer_size,          FD_NET_MTU,                    1UL );
   FOR(shred_tile_cnt)  fd_topob_link( topo, "shred_net",    "net_shred",    config->net.ingress_buffer_size,          FD_NET_MTU,                    1UL );
   FOR(quic_tile_cnt)   fd_topob_link( topo, "quic_verify",  "quic_verify",  config->tiles.verify.receive_buffer_size, FD_TPU_REASM_MTU,              config->tiles.quic.txn_reassembly_count );
-  FOR(verify_tile_cnt) fd_topob_link( topo, "verify_dedup", "verify_dedup", config->tiles.verify.receive_buffer_size, FD_TPU_PARSED_MTU,             1UL );
+  FOR(verify_tile_cnt) fd_topob_link( topo, "verify_dedup", "verify_dedup", config->tiles.verify.receive_buffer_size, FD_TPU_PARSED_MTU,             FD_TXN_VERIFY_BATCH_MAX );
   /**/                 fd_topob_link( topo, "dedup_pack",   "dedup_pack",   config->tiles.verify.receive_buffer_size, FD_TPU_PARSED_MTU,             1UL );
 
   /**/                 fd_topob_link( topo, "stake_out",    "stake_out",    128UL,                                    40UL + 40200UL * 40UL,         1UL );
@@ -471,6 +489,14 @@ fd_topo_initialize( config_t * config ) {
   FOR(writer_tile_cnt) fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "writer", i ) ], runtime_pub_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
   FD_TEST( fd_pod_insertf_ulong( topo->props, runtime_pub_obj->id, "runtime_pub" ) );
 
+  /* Create the accumulator of the accounts lthash change of the slot
+     being replayed, one shard per writer tile. */
+  fd_topo_obj_t * lthash_delta_obj = fd_topob_obj( topo, "lthash_delta", "runtime_pub" );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, writer_tile_cnt, "obj.%lu.shard_cnt", lthash_delta_obj->id ) );
+  fd_topob_tile_uses( topo, replay_tile, lthash_delta_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+  FOR(writer_tile_cnt) fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "writer", i ) ], lthash_delta_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, lthash_delta_obj->id, "lthash_delta" ) );
+
   /* Create a txncache to be used by replay. */
   fd_topo_obj_t * txncache_obj = setup_topo_txncache( topo, "tcache", FD_TXNCACHE_DEFAULT_MAX_ROOTED_SLOTS, FD_TXNCACHE_DEFAULT_MAX_LIVE_SLOTS, MAX_CACHE_TXNS_PER_SLOT );
   fd_topob_tile_uses( topo, replay_tile, txncache_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
@@ -478,6 +504,16 @@ fd_topo_initialize( config_t * config ) {
 
   FD_TEST( fd_pod_insertf_ulong( topo->props, txncache_obj->id, "txncache" ) );
 
+  /* Create a cache of validated programs.  Exec tiles fill it (they
+     load and validate programs found by the snapshot scan and written
+     by transactions) and replay copies from it when it creates the
+     funk program cache entries exec tiles use. */
+  fd_topo_obj_t * progcache_obj = setup_topo_progcache( topo, "progcache", FD_PROGCACHE_DEFAULT_SET_CNT, FD_PROGCACHE_DEFAULT_DATA_MAX );
+  fd_topob_tile_uses( topo, replay_tile, progcache_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+  FOR(exec_tile_cnt) fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "exec", i ) ], progcache_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+
+  FD_TEST( fd_pod_insertf_ulong( topo->props, progcache_obj->id, "progcache" ) );
+
   for( ulong i=0UL; i<bank_tile_cnt; i++ ) {
     fd_topo_obj_t * busy_obj = fd_topob_obj( topo, "fseq", "bank_busy" );
 
@@ -497,6 +533,17 @@ fd_topo_initialize( config_t * config ) {
     FD_TEST( fd_pod_insertf_ulong( topo->props, exec_spad_obj->id, "exec_spad.%lu", i ) );
   }
 
+  if( FD_UNLIKELY( config->firedancer.development.sbpf_profiler.enabled ) ) {
+    for( ulong i=0UL; i<exec_tile_cnt; i++ ) {
+      fd_topo_obj_t * vm_prof_obj = fd_topob_obj( topo, "vm_prof", "vm_prof" );
+      fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "exec", i ) ], vm_prof_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+      FD_TEST( fd_pod_insertf_ulong( topo->props, config->firedancer.development.sbpf_profiler.node_max,      "obj.%lu.node_max",      vm_prof_obj->id ) );
+      FD_TEST( fd_pod_insertf_ulong( topo->props, config->firedancer.development.sbpf_profiler.bucket_max,    "obj.%lu.bucket_max",    vm_prof_obj->id ) );
+      FD_TEST( fd_pod_insertf_ulong( topo->props, config->firedancer.development.sbpf_profiler.sample_period, "obj.%lu.sample_period", vm_prof_obj->id ) );
+      FD_TEST( fd_pod_insertf_ulong( topo->props, vm_prof_obj->id, "vm_prof.%lu", i ) );
+    }
+  }
+
   for( ulong i=0UL; i<exec_tile_cnt; i++ ) {
     fd_topo_obj_t * exec_fseq_obj = fd_topob_obj( topo, "fseq", "exec_fseq" );
     fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "exec", i ) ], exec_fseq_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
@@ -929,6 +976,10 @@ fd_topo_initialize( config_t * config ) {
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "exec" ) ) ) {
       strncpy( tile->exec.funk_file, config->tiles.replay.funk_file, sizeof(tile->exec.funk_file) );
+      if( FD_UNLIKELY( config->firedancer.development.sbpf_jit.enabled ) ) {
+        tile->exec.sbpf_jit_program_max = config->firedancer.development.sbpf_jit.program_max;
+        tile->exec.sbpf_jit_code_sz      = config->firedancer.development.sbpf_jit.code_size_mib<<20;
+      }
     } else if( FD_UNLIKELY( !strcmp( tile->name, "writer" ) ) ) {
       strncpy( tile->writer.funk_file, config->tiles.replay.funk_file, sizeof(tile->writer.funk_file) );
     } else if( FD_UNLIKELY( !strcmp( tile->name, "rstart" ) ) ) {
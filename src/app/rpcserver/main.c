@@ -76,6 +76,11 @@ init_args( int * argc, char *** argv, fd_rpcserver_args_t * args ) {
   args->params.max_ws_send_frame_cnt = fd_env_strip_cmdline_ulong( argc, argv, "--max-ws-send-frame-cnt", NULL, 100 );
   args->params.outgoing_buffer_sz    = fd_env_strip_cmdline_ulong( argc, argv, "--max-send-buf",          NULL, 100U<<20U );
 
+  args->acct_index_max = fd_env_strip_cmdline_ulong( argc, argv, "--acct-index-max", NULL, FD_RPC_ACCT_INDEX_MAX_DEFAULT );
+  args->ws_sub_max     = fd_env_strip_cmdline_ulong( argc, argv, "--ws-sub-max",     NULL, FD_RPC_WS_SUBS_MAX_DEFAULT    );
+  args->cache_ent_max  = fd_env_strip_cmdline_ulong( argc, argv, "--cache-ent-max",  NULL, FD_RPC_CACHE_ENT_MAX_DEFAULT  );
+  args->cache_byte_max = fd_env_strip_cmdline_ulong( argc, argv, "--cache-byte-max", NULL, FD_RPC_CACHE_BYTE_MAX_DEFAULT );
+
   const char * tpu_host = fd_env_strip_cmdline_cstr ( argc, argv, "--local-tpu-host", NULL, "127.0.0.1" );
   ulong tpu_port = fd_env_strip_cmdline_ulong( argc, argv, "--local-tpu-port", NULL, 9001U );
   memset( &args->tpu_addr, 0, sizeof(args->tpu_addr) );
@@ -154,6 +159,12 @@ init_args_offline( int * argc, char *** argv, fd_rpcserver_args_t * args ) {
   args->params.max_ws_recv_frame_len = fd_env_strip_cmdline_ulong( argc, argv, "--max-ws-recv-frame-len", NULL, 2048 );
   args->params.max_ws_send_frame_cnt = fd_env_strip_cmdline_ulong( argc, argv, "--max-ws-send-frame-cnt", NULL, 100 );
   args->params.outgoing_buffer_sz    = fd_env_strip_cmdline_ulong( argc, argv, "--max-send-buf",          NULL, 100U<<20U );
+
+  args->acct_index_max  = fd_env_strip_cmdline_ulong( argc, argv, "--acct-index-max",  NULL, FD_RPC_ACCT_INDEX_MAX_DEFAULT );
+  args->ws_sub_max      = fd_env_strip_cmdline_ulong( argc, argv, "--ws-sub-max",      NULL, FD_RPC_WS_SUBS_MAX_DEFAULT    );
+  args->cache_ent_max   = fd_env_strip_cmdline_ulong( argc, argv, "--cache-ent-max",   NULL, FD_RPC_CACHE_ENT_MAX_DEFAULT  );
+  args->cache_byte_max  = fd_env_strip_cmdline_ulong( argc, argv, "--cache-byte-max",  NULL, FD_RPC_CACHE_BYTE_MAX_DEFAULT );
+  args->acct_index_scan = 1;
 }
 
 static int stopflag = 0;
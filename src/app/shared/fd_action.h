@@ -67,6 +67,10 @@ union fdctl_args {
     char name[ 13UL ];
   } flame;
 
+  struct {
+    int metric;
+  } sbpf_prof;
+
   struct {
     char    affinity[ AFFINITY_SZ ];
     uint    tpu_ip;
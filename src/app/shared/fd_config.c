@@ -217,6 +217,20 @@ fd_config_fill_net( fd_config_t * config ) {
     if( FD_UNLIKELY( -1==fd_net_util_if_addr( config->net.interface, &iface_ip ) ) )
       FD_LOG_ERR(( "could not get IP address for interface `%s`", config->net.interface ));
 
+    if( FD_LIKELY( !strcmp( config->net.provider, "xdp" ) ) ) {
+      /* The XDP net tile receives every packet into a single FD_NET_MTU
+         sized frame and passes at most that much downstream, with or
+         without multi-buffer.  Larger (jumbo) frames are unsupported. */
+      uint iface_mtu;
+      if( FD_UNLIKELY( -1==fd_net_util_if_mtu( config->net.interface, &iface_mtu ) ) )
+        FD_LOG_ERR(( "could not get MTU for interface `%s`", config->net.interface ));
+      if( FD_UNLIKELY( iface_mtu+sizeof(fd_eth_hdr_t)>FD_NET_MTU ) )
+        FD_LOG_ERR(( "network interface `%s` has an MTU of %u, but [net.provider] \"xdp\" supports "
+                     "an MTU of at most %lu.  Lower the MTU of the interface or use the \"socket\" "
+                     "net provider.",
+                     config->net.interface, iface_mtu, FD_NET_MTU-sizeof(fd_eth_hdr_t) ));
+    }
+
     if( FD_UNLIKELY( !config->is_firedancer ) ) {
       if( FD_UNLIKELY( strcmp( config->frankendancer.gossip.host, "" ) ) ) {
         uint gossip_ip_addr = iface_ip;
@@ -433,7 +447,15 @@ fd_config_fill( fd_config_t * config,
 
 static void
 fd_config_validatef( fd_configf_t const * config ) {
-  (void)config;
+  if( FD_UNLIKELY( config->development.sbpf_profiler.enabled ) ) {
+    CFG_HAS_NON_ZERO( development.sbpf_profiler.sample_period );
+    CFG_HAS_POW2    ( development.sbpf_profiler.node_max      );
+    CFG_HAS_POW2    ( development.sbpf_profiler.bucket_max    );
+  }
+  if( FD_UNLIKELY( config->development.sbpf_jit.enabled ) ) {
+    CFG_HAS_POW2    ( development.sbpf_jit.program_max        );
+    CFG_HAS_NON_ZERO( development.sbpf_jit.code_size_mib      );
+  }
 }
 
 static void
@@ -110,6 +110,21 @@ struct fd_configf {
     uint exec_tile_count; /* TODO: redundant ish with bank tile cnt */
     uint writer_tile_count;
   } layout;
+
+  struct {
+    struct {
+      int   enabled;
+      ulong sample_period;
+      ulong node_max;
+      ulong bucket_max;
+    } sbpf_profiler;
+
+    struct {
+      int   enabled;
+      ulong program_max;
+      ulong code_size_mib;
+    } sbpf_jit;
+  } development;
 };
 
 typedef struct fd_configf fd_configf_t;
@@ -127,6 +142,7 @@ struct fd_config_net {
   struct {
     char xdp_mode[ 8 ];
     int  xdp_zero_copy;
+    int  xdp_multi_buffer;
 
     uint xdp_rx_queue_size;
     uint xdp_tx_queue_size;
@@ -136,6 +152,9 @@ struct fd_config_net {
   struct {
     uint receive_buffer_size;
     uint send_buffer_size;
+    int  udp_gso;
+    int  udp_gro;
+    int  io_uring;
   } socket;
 };
 typedef struct fd_config_net fd_config_net_t;
@@ -323,6 +323,15 @@ fd_config_extract_podf( uchar *        pod,
 
   CFG_POP      ( bool,   consensus.vote                                   );
 
+  CFG_POP      ( bool,   development.sbpf_profiler.enabled                );
+  CFG_POP      ( ulong,  development.sbpf_profiler.sample_period          );
+  CFG_POP      ( ulong,  development.sbpf_profiler.node_max               );
+  CFG_POP      ( ulong,  development.sbpf_profiler.bucket_max             );
+
+  CFG_POP      ( bool,   development.sbpf_jit.enabled                     );
+  CFG_POP      ( ulong,  development.sbpf_jit.program_max                 );
+  CFG_POP      ( ulong,  development.sbpf_jit.code_size_mib               );
+
   return config;
 }
 
@@ -376,11 +385,15 @@ fd_config_extract_pod( uchar *       pod,
   CFG_POP      ( uint,   net.ingress_buffer_size                          );
   CFG_POP      ( cstr,   net.xdp.xdp_mode                                 );
   CFG_POP      ( bool,   net.xdp.xdp_zero_copy                            );
+  CFG_POP      ( bool,   net.xdp.xdp_multi_buffer                         );
   CFG_POP      ( uint,   net.xdp.xdp_rx_queue_size                        );
   CFG_POP      ( uint,   net.xdp.xdp_tx_queue_size                        );
   CFG_POP      ( uint,   net.xdp.flush_timeout_micros                     );
   CFG_POP      ( uint,   net.socket.receive_buffer_size                   );
   CFG_POP      ( uint,   net.socket.send_buffer_size                      );
+  CFG_POP      ( bool,   net.socket.udp_gso                               );
+  CFG_POP      ( bool,   net.socket.udp_gro                               );
+  CFG_POP      ( bool,   net.socket.io_uring                              );
 
   CFG_POP      ( ulong,  tiles.netlink.max_routes                         );
   CFG_POP      ( ulong,  tiles.netlink.max_neighbors                      );
@@ -152,3 +152,20 @@ fd_net_util_if_addr( const char * interface,
   *addr = ((struct sockaddr_in *)fd_type_pun( &ifr.ifr_addr ))->sin_addr.s_addr;
   return 0;
 }
+
+int
+fd_net_util_if_mtu( const char * interface,
+                    uint *       mtu ) {
+  int fd = socket( AF_INET, SOCK_DGRAM, 0 );
+  if( FD_UNLIKELY( -1==fd ) ) return -1;
+
+  struct ifreq ifr = {0};
+  strncpy( ifr.ifr_name, interface, IFNAMSIZ );
+  ifr.ifr_name[ IFNAMSIZ-1 ] = '\0';
+
+  if( FD_UNLIKELY( -1==ioctl( fd, SIOCGIFMTU, &ifr ) ) ) return -1;
+  if( FD_UNLIKELY( -1==close( fd ) ) ) return -1;
+
+  *mtu = (uint)ifr.ifr_mtu;
+  return 0;
+}
@@ -72,4 +72,15 @@ int
 fd_net_util_if_addr( const char * interface,
                      uint *       addr );
 
+/* fd_net_util_if_mtu() attempts to get the MTU of the provided
+   interface.
+
+   Returns zero on success, and the MTU is written to the provided
+   pointer.  On failure, -1 is returned and errno is set appropriately,
+   the value of mtu is undefined. */
+
+int
+fd_net_util_if_mtu( const char * interface,
+                    uint *       mtu );
+
 #endif /* HEADER_fd_src_app_shared_fd_net_util_h */
@@ -496,6 +496,7 @@ unprivileged_init( fd_topo_t *      topo,
     quic->config.idle_timeout               = quic_idle_timeout_millis * 1000000UL;
     quic->config.initial_rx_max_stream_data = 0;
     quic->config.retry                      = 0; /* unused on clients */
+    quic->config.net.tx_batch               = FD_QUIC_TX_BATCH_MAX; /* one sendmmsg per batch */
 
     quic->cb.conn_new         = quic_conn_new;
     quic->cb.conn_hs_complete = handshake_complete;
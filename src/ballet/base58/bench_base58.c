@@ -0,0 +1,84 @@
+/* bench_base58 measures the cost of encoding arrays of account
+   addresses (32 bytes) and signatures (64 bytes) to base58, one value
+   at a time (fd_base58_encode_{32,64}) and in one call
+   (fd_base58_encode_{32,64}_batch). */
+
+#include "fd_base58.h"
+
+#define VAL_MAX   (1UL<<12)
+#define TRIAL_CNT (100UL)
+
+static uchar bytes[ VAL_MAX*64UL ];
+static char  out_one  [ VAL_MAX*FD_BASE58_ENCODED_64_SZ ];
+static char  out_batch[ VAL_MAX*FD_BASE58_ENCODED_64_SZ ];
+static ulong len      [ VAL_MAX ];
+
+typedef char * (*encode_fn_t)      ( uchar const *, ulong *, char * );
+typedef char * (*encode_batch_fn_t)( uchar const *, ulong, ulong *, char * );
+
+__attribute__((noinline)) static void
+bench_one( encode_fn_t fn,
+           ulong       n,
+           ulong       enc_sz,
+           ulong       cnt ) {
+  for( ulong i=0UL; i<cnt; i++ ) fn( bytes+i*n, len+i, out_one+i*enc_sz );
+}
+
+static void
+bench( char const *      name,
+       encode_fn_t       one_fn,
+       encode_batch_fn_t batch_fn,
+       ulong             n,
+       ulong             enc_sz,
+       ulong             cnt,
+       ulong             iter_cnt ) {
+
+  bench_one( one_fn, n, enc_sz, cnt );
+  batch_fn( bytes, cnt, len, out_batch );
+  FD_TEST( !memcmp( out_one, out_batch, cnt*enc_sz ) );
+
+  /* Best of several trials to reduce scheduling noise */
+
+  long dt_one   = LONG_MAX;
+  long dt_batch = LONG_MAX;
+  for( ulong trial=0UL; trial<TRIAL_CNT; trial++ ) {
+    long dt = -fd_log_wallclock();
+    for( ulong iter=0UL; iter<iter_cnt; iter++ ) bench_one( one_fn, n, enc_sz, cnt );
+    dt += fd_log_wallclock();
+    dt_one = fd_long_min( dt_one, dt );
+
+    dt = -fd_log_wallclock();
+    for( ulong iter=0UL; iter<iter_cnt; iter++ ) batch_fn( bytes, cnt, len, out_batch );
+    dt += fd_log_wallclock();
+    dt_batch = fd_long_min( dt_batch, dt );
+  }
+
+  double one_ns   = (double)dt_one  /(double)(iter_cnt*cnt);
+  double batch_ns = (double)dt_batch/(double)(iter_cnt*cnt);
+  FD_LOG_NOTICE(( "%s: %6.1f ns per value one at a time, %6.1f ns per value batched (%.2fx)",
+                  name, one_ns, batch_ns, one_ns/batch_ns ));
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong cnt      = fd_env_strip_cmdline_ulong( &argc, &argv, "--cnt",      NULL,   256UL );
+  ulong iter_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter",     NULL,    20UL );
+  uint  rng_seed = fd_env_strip_cmdline_uint ( &argc, &argv, "--rng-seed", NULL,   1234U  );
+
+  if( FD_UNLIKELY( !cnt || cnt>VAL_MAX ) ) FD_LOG_ERR(( "--cnt must be in [1,%lu]", VAL_MAX ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, rng_seed, 0UL ) );
+  for( ulong i=0UL; i<VAL_MAX*64UL; i++ ) bytes[ i ] = fd_rng_uchar( rng );
+
+  FD_LOG_NOTICE(( "%lu values per call", cnt ));
+  bench( "32 byte", fd_base58_encode_32, fd_base58_encode_32_batch, 32UL, FD_BASE58_ENCODED_32_SZ, cnt, iter_cnt );
+  bench( "64 byte", fd_base58_encode_64, fd_base58_encode_64_batch, 64UL, FD_BASE58_ENCODED_64_SZ, cnt, iter_cnt );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -53,6 +53,21 @@ FD_PROTOTYPES_BEGIN
 char * fd_base58_encode_32( uchar const * bytes, ulong * opt_len, char * out );
 char * fd_base58_encode_64( uchar const * bytes, ulong * opt_len, char * out );
 
+/* fd_base58_encode_{32,64}_batch encode cnt values stored contiguously
+   at bytes (cnt*32 or cnt*64 bytes).  The encoding of value i is
+   written as a nul-terminated cstr to out+i*FD_BASE58_ENCODED_{32,64}_SZ
+   (i.e. out is a char[cnt][FD_BASE58_ENCODED_{32,64}_SZ]).  If opt_len
+   is non-NULL, opt_len[i] is set to its length.  Returns out.
+
+   The output is the same as encoding each value individually.  With
+   AVX, values are converted 4 at a time, which is substantially faster
+   than individual conversions when encoding many account addresses or
+   signatures at once (e.g. the accounts and signatures of a
+   transaction). */
+
+char * fd_base58_encode_32_batch( uchar const * bytes, ulong cnt, ulong * opt_len, char * out );
+char * fd_base58_encode_64_batch( uchar const * bytes, ulong cnt, ulong * opt_len, char * out );
+
 /* fd_base58_decode_{32, 64}: Converts the base58 encoded number stored
    in the cstr `encoded` to a 32 or 64 byte number, which is written to
    out in big endian.  out must have room for 32 and 64 bytes respective
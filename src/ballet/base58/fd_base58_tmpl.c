@@ -21,6 +21,7 @@
 
 #define BYTE_CNT     ((ulong) N)
 #define SUFFIX(s)    FD_EXPAND_THEN_CONCAT3(s,_,N)
+#define BATCH_SUFFIX(s) FD_EXPAND_THEN_CONCAT4(s,_,N,_batch)
 #define ENCODED_SZ() FD_EXPAND_THEN_CONCAT3(FD_BASE58_ENCODED_, N, _SZ)
 #define RAW58_SZ     (INTERMEDIATE_SZ*5UL)
 
@@ -30,104 +31,15 @@
 #define INTERMEDIATE_SZ_W_PADDING INTERMEDIATE_SZ
 #endif
 
-char *
-SUFFIX(fd_base58_encode)( uchar const * bytes,
-                          ulong       * opt_len,
-                          char        * out    ){
-
-  /* Count leading zeros (needed for final output) */
-#if FD_HAS_AVX
-# if N==32
-  wuc_t _bytes = wuc_ldu( bytes );
-  ulong in_leading_0s = count_leading_zeros_32( _bytes );
-# elif N==64
-  wuc_t bytes_0 = wuc_ldu( bytes      );
-  wuc_t bytes_1 = wuc_ldu( bytes+32UL );
-  ulong in_leading_0s = count_leading_zeros_64( bytes_0, bytes_1 );
-# endif
-#else
-
-  ulong in_leading_0s = 0UL;
-  for( ; in_leading_0s<BYTE_CNT; in_leading_0s++ ) if( bytes[ in_leading_0s ] ) break;
-#endif
-
-  /* X = sum_i bytes[i] * 2^(8*(BYTE_CNT-1-i)) */
-
-  /* Convert N to 32-bit limbs:
-     X = sum_i binary[i] * 2^(32*(BINARY_SZ-1-i)) */
-  uint binary[ BINARY_SZ ];
-  for( ulong i=0UL; i<BINARY_SZ; i++ ) binary[ i ] = fd_uint_bswap( fd_uint_load_4( &bytes[ i*sizeof(uint) ] ) );
-
-  ulong R1div = 656356768UL; /* = 58^5 */
-
-  /* Convert to the intermediate format:
-       X = sum_i intermediate[i] * 58^(5*(INTERMEDIATE_SZ-1-i))
-     Initially, we don't require intermediate[i] < 58^5, but we do want
-     to make sure the sums don't overflow. */
-
-#if FD_HAS_AVX
-  ulong W_ATTR intermediate[ INTERMEDIATE_SZ_W_PADDING ];
-#else
-  ulong intermediate[ INTERMEDIATE_SZ_W_PADDING ];
-#endif
-
-  fd_memset( intermediate, 0, INTERMEDIATE_SZ_W_PADDING * sizeof(ulong) );
-
-# if N==32
-
-  /* The worst case is if binary[7] is (2^32)-1. In that case
-     intermediate[8] will be just over 2^63, which is fine. */
-
-  for( ulong i=0UL; i < BINARY_SZ; i++ )
-    for( ulong j=0UL; j < INTERMEDIATE_SZ-1UL; j++ )
-      intermediate[ j+1UL ] += (ulong)binary[ i ] * (ulong)SUFFIX(enc_table)[ i ][ j ];
+/* fd_base58_encode_finish converts the reduced intermediate form
+   (every term less than 58^5) of a value with in_leading_0s leading
+   zero bytes to the final string. */
 
-# elif N==64
-
-  /* If we do it the same way as the 32B conversion, intermediate[16]
-     can overflow when the input is sufficiently large.  We'll do a
-     mini-reduction after the first 8 steps.  After the first 8 terms,
-     the largest intermediate[16] can be is 2^63.87.  Then, after
-     reduction it'll be at most 58^5, and after adding the last terms,
-     it won't exceed 2^63.1.  We do need to be cautious that the
-     mini-reduction doesn't cause overflow in intermediate[15] though.
-     Pre-mini-reduction, it's at most 2^63.05.  The mini-reduction adds
-     at most 2^64/58^5, which is negligible.  With the final terms, it
-     won't exceed 2^63.69, which is fine. Other terms are less than
-     2^63.76, so no problems there. */
-
-  for( ulong i=0UL; i < 8UL; i++ )
-    for( ulong j=0UL; j < INTERMEDIATE_SZ-1UL; j++ )
-      intermediate[ j+1UL ] += (ulong)binary[ i ] * (ulong)SUFFIX(enc_table)[ i ][ j ];
-  /* Mini-reduction */
-  intermediate[ 15 ] += intermediate[ 16 ]/R1div;
-  intermediate[ 16 ] %= R1div;
-  /* Finish iterations */
-  for( ulong i=8UL; i < BINARY_SZ; i++ )
-    for( ulong j=0UL; j < INTERMEDIATE_SZ-1UL; j++ )
-      intermediate[ j+1UL ] += (ulong)binary[ i ] * (ulong)SUFFIX(enc_table)[ i ][ j ];
-
-# else
-# error "Add support for this N"
-# endif
-
-  /* Now we make sure each term is less than 58^5. Again, we have to be
-     a bit careful of overflow.
-
-     For N==32, in the worst case, as before, intermediate[8] will be
-     just over 2^63 and intermediate[7] will be just over 2^62.6.  In
-     the first step, we'll add floor(intermediate[8]/58^5) to
-     intermediate[7].  58^5 is pretty big though, so intermediate[7]
-     barely budges, and this is still fine.
-
-     For N==64, in the worst case, the biggest entry in intermediate at
-     this point is 2^63.87, and in the worst case, we add (2^64-1)/58^5,
-     which is still about 2^63.87. */
-
-  for( ulong i=INTERMEDIATE_SZ-1UL; i>0UL; i-- ) {
-    intermediate[ i-1UL ] += (intermediate[ i ]/R1div);
-    intermediate[ i     ] %= R1div;
-  }
+static inline char *
+SUFFIX(fd_base58_encode_finish)( ulong const * intermediate,
+                                 ulong         in_leading_0s,
+                                 ulong       * opt_len,
+                                 char        * out ) {
 
 #if !FD_HAS_AVX
   /* Convert intermediate form to base 58.  This form of conversion
@@ -183,9 +95,9 @@ SUFFIX(fd_base58_encode)( uchar const * bytes,
 
 #else /* FD_HAS_AVX */
 # if N==32
-  wl_t intermediate0 = wl_ld( (long*)intermediate     );
-  wl_t intermediate1 = wl_ld( (long*)intermediate+4UL );
-  wl_t intermediate2 = wl_ld( (long*)intermediate+8UL );
+  wl_t intermediate0 = wl_ld( (long const *)intermediate     );
+  wl_t intermediate1 = wl_ld( (long const *)intermediate+4UL );
+  wl_t intermediate2 = wl_ld( (long const *)intermediate+8UL );
   wuc_t raw0 = intermediate_to_raw( intermediate0 );
   wuc_t raw1 = intermediate_to_raw( intermediate1 );
   wuc_t raw2 = intermediate_to_raw( intermediate2 );
@@ -248,11 +160,11 @@ SUFFIX(fd_base58_encode)( uchar const * bytes,
   _mm256_maskstore_epi64(  (long long int*)(out - skip), mask2, base58_0 );
 
 # elif N==64
-  wuc_t raw0 = intermediate_to_raw( wl_ld( (long*)intermediate      ) );
-  wuc_t raw1 = intermediate_to_raw( wl_ld( (long*)intermediate+4UL  ) );
-  wuc_t raw2 = intermediate_to_raw( wl_ld( (long*)intermediate+8UL  ) );
-  wuc_t raw3 = intermediate_to_raw( wl_ld( (long*)intermediate+12UL ) );
-  wuc_t raw4 = intermediate_to_raw( wl_ld( (long*)intermediate+16UL ) );
+  wuc_t raw0 = intermediate_to_raw( wl_ld( (long const *)intermediate      ) );
+  wuc_t raw1 = intermediate_to_raw( wl_ld( (long const *)intermediate+4UL  ) );
+  wuc_t raw2 = intermediate_to_raw( wl_ld( (long const *)intermediate+8UL  ) );
+  wuc_t raw3 = intermediate_to_raw( wl_ld( (long const *)intermediate+12UL ) );
+  wuc_t raw4 = intermediate_to_raw( wl_ld( (long const *)intermediate+16UL ) );
 
   wuc_t compact0, compact1, compact2;
   ten_per_slot_down_64( raw0, raw1, raw2, raw3, raw4, compact0, compact1, compact2 );
@@ -296,6 +208,200 @@ SUFFIX(fd_base58_encode)( uchar const * bytes,
   return out;
 }
 
+/* fd_base58_reduce makes sure each term of the intermediate form is
+   less than 58^5.  Again, we have to be a bit careful of overflow.
+
+   For N==32, in the worst case, as before, intermediate[8] will be
+   just over 2^63 and intermediate[7] will be just over 2^62.6.  In the
+   first step, we'll add floor(intermediate[8]/58^5) to
+   intermediate[7].  58^5 is pretty big though, so intermediate[7]
+   barely budges, and this is still fine.
+
+   For N==64, in the worst case, the biggest entry in intermediate at
+   this point is 2^63.87, and in the worst case, we add (2^64-1)/58^5,
+   which is still about 2^63.87. */
+
+static inline void
+SUFFIX(fd_base58_reduce)( ulong * intermediate ) {
+  ulong R1div = 656356768UL; /* = 58^5 */
+  for( ulong i=INTERMEDIATE_SZ-1UL; i>0UL; i-- ) {
+    intermediate[ i-1UL ] += (intermediate[ i ]/R1div);
+    intermediate[ i     ] %= R1div;
+  }
+}
+
+/* fd_base58_in_leading_0s returns the number of leading zero bytes of
+   the value (needed for final output) */
+
+static inline ulong
+SUFFIX(fd_base58_in_leading_0s)( uchar const * bytes ) {
+#if FD_HAS_AVX
+# if N==32
+  wuc_t _bytes = wuc_ldu( bytes );
+  return count_leading_zeros_32( _bytes );
+# elif N==64
+  wuc_t bytes_0 = wuc_ldu( bytes      );
+  wuc_t bytes_1 = wuc_ldu( bytes+32UL );
+  return count_leading_zeros_64( bytes_0, bytes_1 );
+# endif
+#else
+  ulong in_leading_0s = 0UL;
+  for( ; in_leading_0s<BYTE_CNT; in_leading_0s++ ) if( bytes[ in_leading_0s ] ) break;
+  return in_leading_0s;
+#endif
+}
+
+char *
+SUFFIX(fd_base58_encode)( uchar const * bytes,
+                          ulong       * opt_len,
+                          char        * out    ){
+
+  ulong in_leading_0s = SUFFIX(fd_base58_in_leading_0s)( bytes );
+
+  /* X = sum_i bytes[i] * 2^(8*(BYTE_CNT-1-i)) */
+
+  /* Convert N to 32-bit limbs:
+     X = sum_i binary[i] * 2^(32*(BINARY_SZ-1-i)) */
+  uint binary[ BINARY_SZ ];
+  for( ulong i=0UL; i<BINARY_SZ; i++ ) binary[ i ] = fd_uint_bswap( fd_uint_load_4( &bytes[ i*sizeof(uint) ] ) );
+
+  /* Convert to the intermediate format:
+       X = sum_i intermediate[i] * 58^(5*(INTERMEDIATE_SZ-1-i))
+     Initially, we don't require intermediate[i] < 58^5, but we do want
+     to make sure the sums don't overflow. */
+
+#if FD_HAS_AVX
+  ulong W_ATTR intermediate[ INTERMEDIATE_SZ_W_PADDING ];
+#else
+  ulong intermediate[ INTERMEDIATE_SZ_W_PADDING ];
+#endif
+
+  fd_memset( intermediate, 0, INTERMEDIATE_SZ_W_PADDING * sizeof(ulong) );
+
+# if N==32
+
+  /* The worst case is if binary[7] is (2^32)-1. In that case
+     intermediate[8] will be just over 2^63, which is fine. */
+
+  for( ulong i=0UL; i < BINARY_SZ; i++ )
+    for( ulong j=0UL; j < INTERMEDIATE_SZ-1UL; j++ )
+      intermediate[ j+1UL ] += (ulong)binary[ i ] * (ulong)SUFFIX(enc_table)[ i ][ j ];
+
+# elif N==64
+
+  /* If we do it the same way as the 32B conversion, intermediate[16]
+     can overflow when the input is sufficiently large.  We'll do a
+     mini-reduction after the first 8 steps.  After the first 8 terms,
+     the largest intermediate[16] can be is 2^63.87.  Then, after
+     reduction it'll be at most 58^5, and after adding the last terms,
+     it won't exceed 2^63.1.  We do need to be cautious that the
+     mini-reduction doesn't cause overflow in intermediate[15] though.
+     Pre-mini-reduction, it's at most 2^63.05.  The mini-reduction adds
+     at most 2^64/58^5, which is negligible.  With the final terms, it
+     won't exceed 2^63.69, which is fine. Other terms are less than
+     2^63.76, so no problems there. */
+
+  for( ulong i=0UL; i < 8UL; i++ )
+    for( ulong j=0UL; j < INTERMEDIATE_SZ-1UL; j++ )
+      intermediate[ j+1UL ] += (ulong)binary[ i ] * (ulong)SUFFIX(enc_table)[ i ][ j ];
+  /* Mini-reduction */
+  ulong R1div = 656356768UL; /* = 58^5 */
+  intermediate[ 15 ] += intermediate[ 16 ]/R1div;
+  intermediate[ 16 ] %= R1div;
+  /* Finish iterations */
+  for( ulong i=8UL; i < BINARY_SZ; i++ )
+    for( ulong j=0UL; j < INTERMEDIATE_SZ-1UL; j++ )
+      intermediate[ j+1UL ] += (ulong)binary[ i ] * (ulong)SUFFIX(enc_table)[ i ][ j ];
+
+# else
+# error "Add support for this N"
+# endif
+
+  SUFFIX(fd_base58_reduce)( intermediate );
+
+  return SUFFIX(fd_base58_encode_finish)( intermediate, in_leading_0s, opt_len, out );
+}
+
+char *
+BATCH_SUFFIX(fd_base58_encode)( uchar const * bytes,
+                                ulong         cnt,
+                                ulong       * opt_len,
+                                char        * out    ) {
+
+  ulong i = 0UL;
+
+#if FD_HAS_AVX
+  /* Convert 4 values at a time.  The intermediate forms are kept
+     transposed (term j of value k in lane k of inter[ j ]) so that the
+     conversion to the intermediate format is done with 32x32->64 bit
+     vector multiplies and the 4 reductions can be interleaved.  The
+     final conversion is the same as for a single value. */
+
+  ulong R1div = 656356768UL; /* = 58^5 */
+
+  for( ; i+4UL<=cnt; i+=4UL ) {
+    uchar const * b = bytes + i*BYTE_CNT;
+
+    wl_t binary[ BINARY_SZ ];
+    for( ulong k=0UL; k<BINARY_SZ; k++ )
+      binary[ k ] = wl( (long)fd_uint_bswap( fd_uint_load_4( b+         k*sizeof(uint) ) ),
+                        (long)fd_uint_bswap( fd_uint_load_4( b+  BYTE_CNT+k*sizeof(uint) ) ),
+                        (long)fd_uint_bswap( fd_uint_load_4( b+2*BYTE_CNT+k*sizeof(uint) ) ),
+                        (long)fd_uint_bswap( fd_uint_load_4( b+3*BYTE_CNT+k*sizeof(uint) ) ) );
+
+    wl_t acc[ INTERMEDIATE_SZ ];
+    for( ulong j=0UL; j<INTERMEDIATE_SZ; j++ ) acc[ j ] = wl_zero();
+    for( ulong k=0UL; k<BINARY_SZ; k++ ) {
+      for( ulong j=1UL; j<INTERMEDIATE_SZ; j++ )
+        acc[ j ] = wl_add( acc[ j ], _mm256_mul_epu32( binary[ k ], _mm256_set1_epi32( (int)SUFFIX(enc_table)[ k ][ j-1UL ] ) ) );
+# if N==64
+      if( k==7UL ) {
+        ulong W_ATTR t[ 4 ];
+        wl_st( (long *)t, acc[ 16 ] );
+        acc[ 15 ] = wl_add( acc[ 15 ], wl( (long)(t[0]/R1div), (long)(t[1]/R1div), (long)(t[2]/R1div), (long)(t[3]/R1div) ) );
+        acc[ 16 ] = wl(                    (long)(t[0]%R1div), (long)(t[1]%R1div), (long)(t[2]%R1div), (long)(t[3]%R1div) );
+      }
+# endif
+    }
+    ulong W_ATTR soa[ INTERMEDIATE_SZ_W_PADDING ][ 4 ];
+    for( ulong j=0UL; j<INTERMEDIATE_SZ; j++ ) wl_st( (long *)soa[ j ], acc[ j ] );
+    for( ulong j=INTERMEDIATE_SZ; j<INTERMEDIATE_SZ_W_PADDING; j++ ) wl_st( (long *)soa[ j ], wl_zero() );
+
+    /* Same as fd_base58_reduce, with the 4 chains of dependent
+       divisions interleaved */
+
+    ulong carry[ 4 ] = { 0UL, 0UL, 0UL, 0UL };
+    for( ulong j=INTERMEDIATE_SZ-1UL; j>0UL; j-- ) {
+      for( ulong l=0UL; l<4UL; l++ ) {
+        ulong v = soa[ j ][ l ] + carry[ l ];
+        carry[ l ]    = v/R1div;
+        soa[ j ][ l ] = v - carry[ l ]*R1div;
+      }
+    }
+    for( ulong l=0UL; l<4UL; l++ ) soa[ 0 ][ l ] += carry[ l ];
+
+    /* Transpose back.  The final conversion loads the intermediate
+       form as vectors, so it is stored as vectors (a vector load of
+       recent scalar stores would stall store forwarding). */
+
+    ulong W_ATTR intermediate[ 4 ][ INTERMEDIATE_SZ_W_PADDING ];
+    for( ulong l=0UL; l<4UL; l++ )
+      for( ulong j=0UL; j<INTERMEDIATE_SZ_W_PADDING; j+=4UL )
+        wl_st( (long *)intermediate[ l ]+j, wl( (long)soa[ j     ][ l ], (long)soa[ j+1UL ][ l ],
+                                                (long)soa[ j+2UL ][ l ], (long)soa[ j+3UL ][ l ] ) );
+
+    for( ulong l=0UL; l<4UL; l++ )
+      SUFFIX(fd_base58_encode_finish)( intermediate[ l ], SUFFIX(fd_base58_in_leading_0s)( b+l*BYTE_CNT ),
+                                       opt_len ? opt_len+i+l : NULL, out+(i+l)*ENCODED_SZ() );
+  }
+#endif
+
+  for( ; i<cnt; i++ )
+    SUFFIX(fd_base58_encode)( bytes+i*BYTE_CNT, opt_len ? opt_len+i : NULL, out+i*ENCODED_SZ() );
+
+  return out;
+}
+
 uchar *
 SUFFIX(fd_base58_decode)( char const * encoded,
                           uchar      * out      ) {
@@ -395,6 +501,7 @@ SUFFIX(fd_base58_decode)( char const * encoded,
 #undef RAW58_SZ
 #undef ENCODED_SZ
 #undef SUFFIX
+#undef BATCH_SUFFIX
 
 #undef BINARY_SZ
 #undef BYTE_CNT
@@ -486,6 +486,37 @@ battery_performance( encode_func_t encode_func,
                   (double)(encode_decode - encode  )/(double)test_count  ));
 }
 
+typedef char * (*encode_batch_func_t)( uchar const * bytes, ulong cnt, ulong * opt_len, char * out );
+
+/* battery_batch checks that batch encoding matches encoding each value
+   individually for all batch sizes up to 13 (partial vector batches),
+   with a mix of leading zero bytes. */
+
+static void
+battery_batch( encode_func_t       encode_func,
+               encode_batch_func_t batch_func,
+               ulong               n,
+               ulong               encode_sz,
+               fd_rng_t *          rng ) {
+  uchar bytes[ 13UL*64UL ];
+  char  buf  [ 13UL*FD_BASE58_ENCODED_64_SZ ];
+  ulong len  [ 13UL ];
+  for( ulong iter=0UL; iter<1000UL; iter++ ) {
+    ulong cnt = iter % 14UL;
+    for( ulong i=0UL; i<cnt*n; i++ ) bytes[ i ] = fd_rng_uchar( rng );
+    for( ulong i=0UL; i<cnt; i++ ) fd_memset( bytes+i*n, 0, fd_rng_ulong_roll( rng, n+1UL ) * !fd_rng_uint_roll( rng, 3U ) );
+    fd_memset( buf, 0xff, sizeof(buf) );
+    FD_TEST( batch_func( bytes, cnt, (iter&1UL) ? len : NULL, buf )==buf );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      char  ref[ FD_BASE58_ENCODED_64_SZ ];
+      ulong ref_len;
+      encode_func( bytes+i*n, &ref_len, ref );
+      FD_TEST( !strcmp( buf+i*encode_sz, ref ) );
+      if( iter&1UL ) FD_TEST( len[ i ]==ref_len );
+    }
+  }
+}
+
 #define MAKE_TESTS(n,name)                                                                     \
 static inline void                                                                             \
 test_encode_basic##name( void ) {                                                              \
@@ -727,6 +758,10 @@ main( int     argc,
   test_match64_ref( rng, cnt );
   test_performance64_ref( rng );
 
+  FD_LOG_NOTICE(( "Testing batch conversion" ));
+  battery_batch( fd_base58_encode_32, fd_base58_encode_32_batch, 32UL, FD_BASE58_ENCODED_32_SZ, rng );
+  battery_batch( fd_base58_encode_64, fd_base58_encode_64_batch, 64UL, FD_BASE58_ENCODED_64_SZ, rng );
+
   FD_LOG_NOTICE(( "Testing 256-bit conversion" ));
   test_encode_basic32();
   test_encode_bounds32();
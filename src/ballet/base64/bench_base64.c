@@ -0,0 +1,79 @@
+/* bench_base64 measures the throughput of Base64 encoding and decoding
+   with the vectorized codec (fd_base64_{encode,decode}) and the scalar
+   reference (fd_base64_{encode,decode}_ref) for a range of input sizes,
+   from token account data (165 bytes) to large program accounts. */
+
+#include "fd_base64.h"
+
+#define DATA_MAX (1UL<<20)
+
+static uchar raw[ DATA_MAX ];
+static char  enc[ FD_BASE64_ENC_SZ( DATA_MAX ) ];
+static uchar dec[ DATA_MAX ];
+
+typedef ulong (*encode_fn_t)( char *, void const *, ulong );
+typedef long  (*decode_fn_t)( uchar *, char const *, ulong );
+
+__attribute__((noinline)) static double
+bench_encode( encode_fn_t fn,
+              ulong       sz,
+              ulong       iter_cnt ) {
+  fn( enc, raw, sz ); /* warmup */
+  long dt = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    fn( enc, raw, sz );
+    FD_COMPILER_MFENCE();
+  }
+  dt += fd_log_wallclock();
+  return (double)(8UL*sz*iter_cnt) / (double)dt;
+}
+
+__attribute__((noinline)) static double
+bench_decode( decode_fn_t fn,
+              ulong       enc_sz,
+              ulong       iter_cnt ) {
+  FD_TEST( fn( dec, enc, enc_sz )>=0L ); /* warmup */
+  ulong sz = 0UL;
+  long dt = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    sz += (ulong)fn( dec, enc, enc_sz );
+    FD_COMPILER_MFENCE();
+  }
+  dt += fd_log_wallclock();
+  return (double)(8UL*sz) / (double)dt;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong byte_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--bytes",    NULL, 1UL<<30 );
+  uint  rng_seed = fd_env_strip_cmdline_uint ( &argc, &argv, "--rng-seed", NULL,   1234U );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, rng_seed, 0UL ) );
+  for( ulong i=0UL; i<DATA_MAX; i++ ) raw[ i ] = fd_rng_uchar( rng );
+
+  static ulong const sz_tbl[] = { 32UL, 64UL, 165UL, 1024UL, 10240UL, DATA_MAX };
+
+  for( ulong j=0UL; j<sizeof(sz_tbl)/sizeof(sz_tbl[0]); j++ ) {
+    ulong sz       = sz_tbl[ j ];
+    ulong iter_cnt = fd_ulong_max( byte_cnt/sz, 1UL );
+
+    ulong enc_sz = fd_base64_encode( enc, raw, sz );
+    FD_TEST( fd_base64_decode( dec, enc, enc_sz )==(long)sz && !memcmp( dec, raw, sz ) );
+
+    double enc_ref  = bench_encode( fd_base64_encode_ref, sz,     iter_cnt );
+    double enc_fast = bench_encode( fd_base64_encode,     sz,     iter_cnt );
+    double dec_ref  = bench_decode( fd_base64_decode_ref, enc_sz, iter_cnt );
+    double dec_fast = bench_decode( fd_base64_decode,     enc_sz, iter_cnt );
+
+    FD_LOG_NOTICE(( "%7lu bytes: encode %6.2f Gbps (scalar %5.2f Gbps, %4.1fx)  decode %6.2f Gbps (scalar %5.2f Gbps, %4.1fx)",
+                    sz, enc_fast, enc_ref, enc_fast/enc_ref, dec_fast, dec_ref, dec_fast/dec_ref ));
+  }
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -1,5 +1,12 @@
 #include "fd_base64.h"
 
+#if FD_HAS_AVX512
+#include "../../util/simd/fd_avx512.h"
+#endif
+#if FD_HAS_AVX
+#include "../../util/simd/fd_avx.h"
+#endif
+
 static const char base64_alphabet[] =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
@@ -45,16 +52,15 @@ static uchar const invlut[ 0x100 ] = {
              0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
 };
 
-long
-fd_base64_decode( uchar *      out,
-                  char const * in,
-                  ulong        in_len ) {
+/* base64_unpad returns the number of characters of the non-empty
+   Base64 string [in,in+in_len) without the trailing padding, or
+   ULONG_MAX if the length or padding is invalid. */
 
-  uchar * const out_orig = out;
-
-  if( in_len==0UL ) return 0UL;
+static ulong
+base64_unpad( char const * in,
+              ulong        in_len ) {
 
-  if( FD_UNLIKELY( !fd_ulong_is_aligned( in_len, 4UL ) ) ) return -1L;
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( in_len, 4UL ) ) ) return ULONG_MAX;
 
   ulong pad_cnt = 0UL;
   if( in[ in_len-2UL ]=='=' ) pad_cnt++;
@@ -62,7 +68,20 @@ fd_base64_decode( uchar *      out,
   in_len -= pad_cnt;
 
   /* 3 char padding is invalid */
-  if( FD_UNLIKELY( (in_len%4UL)==1UL ) ) return -1L;
+  if( FD_UNLIKELY( (in_len%4UL)==1UL ) ) return ULONG_MAX;
+
+  return in_len;
+}
+
+/* base64_decode_scalar decodes [in,in+in_len) where in_len excludes
+   the trailing padding. */
+
+static long
+base64_decode_scalar( uchar *      out,
+                      char const * in,
+                      ulong        in_len ) {
+
+  uchar * const out_orig = out;
 
   /* "Fast" decode */
 
@@ -117,14 +136,15 @@ fd_base64_decode( uchar *      out,
   return out - out_orig;
 }
 
-ulong
-fd_base64_encode( char *       encoded,
-                  void const * _data,
-                  ulong        data_len ) {
+/* base64_encode_scalar encodes [data,data+data_len) to encoded, which
+   already holds encoded_len characters (a multiple of 4). */
 
-  uchar const * data = fd_type_pun_const( _data );
+static ulong
+base64_encode_scalar( char *        encoded,
+                      ulong         encoded_len,
+                      uchar const * data,
+                      ulong         data_len ) {
 
-  uint encoded_len = 0;
   uint accumulator = 0;
   int bits_collected = 0;
 
@@ -151,3 +171,194 @@ fd_base64_encode( char *       encoded,
 
   return encoded_len;
 }
+
+#if FD_HAS_AVX
+
+/* The vectorized codecs below follow W. Mula and D. Lemire, "Faster
+   Base64 Encoding and Decoding Using AVX2 Instructions" (2018).  They
+   only handle whole groups of 3 bytes / 4 characters in the middle of
+   the input; the scalar code handles the tail (and padding).
+
+   Encoding: each 128-bit lane holds 12 input bytes at byte offsets
+   [4,16).  A shuffle spreads every 3 byte group over a 32-bit word, two
+   16-bit multiplies move the 4 sextets to the low bits of each byte and
+   a 16 entry LUT indexed by a coarse range of the sextet gives the
+   ASCII offset. */
+
+static inline __m256i
+base64_enc_avx( __m256i in ) {
+  in = _mm256_permutevar8x32_epi32( in, _mm256_setr_epi32( 0, 0, 1, 2, 2, 3, 4, 5 ) );
+  in = _mm256_shuffle_epi8( in, _mm256_setr_epi8(  5,  4,  6,  5,  8,  7,  9,  8, 11, 10, 12, 11, 14, 13, 15, 14,
+                                                   5,  4,  6,  5,  8,  7,  9,  8, 11, 10, 12, 11, 14, 13, 15, 14 ) );
+  __m256i t0 = _mm256_mulhi_epu16( _mm256_and_si256( in, _mm256_set1_epi32( 0x0fc0fc00 ) ), _mm256_set1_epi32( 0x04000040 ) );
+  __m256i t1 = _mm256_mullo_epi16( _mm256_and_si256( in, _mm256_set1_epi32( 0x003f03f0 ) ), _mm256_set1_epi32( 0x01000010 ) );
+  __m256i v  = _mm256_or_si256( t0, t1 );
+
+  __m256i idx = _mm256_subs_epu8( v, _mm256_set1_epi8( 51 ) );
+          idx = _mm256_sub_epi8 ( idx, _mm256_cmpgt_epi8( v, _mm256_set1_epi8( 25 ) ) );
+  __m256i lut = _mm256_setr_epi8( 65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+                                  65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0 );
+  return _mm256_add_epi8( v, _mm256_shuffle_epi8( lut, idx ) );
+}
+
+/* Decoding: the high and low nibble of each character index two LUTs
+   of character class bits; a character is valid iff its two class
+   masks are disjoint.  A third LUT indexed by the high nibble (with
+   '/' special cased) gives the offset from ASCII to sextet.  Two
+   multiply-adds pack 4 sextets into 3 bytes per 32-bit word. */
+
+#define BASE64_DEC_LUT_LO  0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a
+#define BASE64_DEC_LUT_HI  0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+#define BASE64_DEC_LUT_ROLL   0,   16,   19,    4,  -65,  -65,  -71,  -71,    0,    0,    0,    0,    0,    0,    0,    0
+#define BASE64_DEC_PACK       2,    1,    0,    6,    5,    4,   10,    9,    8,   14,   13,   12,   -1,   -1,   -1,   -1
+
+/* base64_dec_avx decodes 32 characters into the low 24 bytes of *out.
+   Returns 0 if any character is invalid (*out is not modified). */
+
+static inline int
+base64_dec_avx( __m256i   in,
+                __m256i * out ) {
+  __m256i mask_2f = _mm256_set1_epi8( 0x2f );
+  __m256i hi_nib  = _mm256_and_si256( _mm256_srli_epi32( in, 4 ), mask_2f );
+  __m256i lo_nib  = _mm256_and_si256( in, mask_2f );
+  __m256i hi      = _mm256_shuffle_epi8( _mm256_setr_epi8( BASE64_DEC_LUT_HI, BASE64_DEC_LUT_HI ), hi_nib );
+  __m256i lo      = _mm256_shuffle_epi8( _mm256_setr_epi8( BASE64_DEC_LUT_LO, BASE64_DEC_LUT_LO ), lo_nib );
+  if( FD_UNLIKELY( !_mm256_testz_si256( lo, hi ) ) ) return 0;
+
+  __m256i roll = _mm256_shuffle_epi8( _mm256_setr_epi8( BASE64_DEC_LUT_ROLL, BASE64_DEC_LUT_ROLL ),
+                                      _mm256_add_epi8( _mm256_cmpeq_epi8( in, mask_2f ), hi_nib ) );
+  __m256i v = _mm256_add_epi8( in, roll );
+  v = _mm256_maddubs_epi16( v, _mm256_set1_epi32( 0x01400140 ) );
+  v = _mm256_madd_epi16   ( v, _mm256_set1_epi32( 0x00011000 ) );
+  v = _mm256_shuffle_epi8 ( v, _mm256_setr_epi8( BASE64_DEC_PACK, BASE64_DEC_PACK ) );
+  *out = _mm256_permutevar8x32_epi32( v, _mm256_setr_epi32( 0, 1, 2, 4, 5, 6, 3, 7 ) );
+  return 1;
+}
+
+#endif /* FD_HAS_AVX */
+
+#if FD_HAS_AVX512
+
+/* Same as above with 4 lanes of 12 bytes / 16 characters. */
+
+static inline __m512i
+base64_enc_avx512( __m512i in ) {
+  in = _mm512_permutexvar_epi32( _mm512_setr_epi32( 0, 0, 1, 2, 3, 3, 4, 5, 6, 6, 7, 8, 9, 9, 10, 11 ), in );
+  in = _mm512_shuffle_epi8( in, _mm512_broadcast_i32x4( _mm_setr_epi8( 5, 4, 6, 5, 8, 7, 9, 8, 11, 10, 12, 11, 14, 13, 15, 14 ) ) );
+  __m512i t0 = _mm512_mulhi_epu16( _mm512_and_si512( in, _mm512_set1_epi32( 0x0fc0fc00 ) ), _mm512_set1_epi32( 0x04000040 ) );
+  __m512i t1 = _mm512_mullo_epi16( _mm512_and_si512( in, _mm512_set1_epi32( 0x003f03f0 ) ), _mm512_set1_epi32( 0x01000010 ) );
+  __m512i v  = _mm512_or_si512( t0, t1 );
+
+  __m512i idx = _mm512_subs_epu8( v, _mm512_set1_epi8( 51 ) );
+          idx = _mm512_mask_add_epi8( idx, _mm512_cmpgt_epi8_mask( v, _mm512_set1_epi8( 25 ) ), idx, _mm512_set1_epi8( 1 ) );
+  __m512i lut = _mm512_broadcast_i32x4( _mm_setr_epi8( 65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0 ) );
+  return _mm512_add_epi8( v, _mm512_shuffle_epi8( lut, idx ) );
+}
+
+static inline int
+base64_dec_avx512( __m512i   in,
+                   __m512i * out ) {
+  __m512i mask_2f = _mm512_set1_epi8( 0x2f );
+  __m512i hi_nib  = _mm512_and_si512( _mm512_srli_epi32( in, 4 ), mask_2f );
+  __m512i lo_nib  = _mm512_and_si512( in, mask_2f );
+  __m512i hi      = _mm512_shuffle_epi8( _mm512_broadcast_i32x4( _mm_setr_epi8( BASE64_DEC_LUT_HI ) ), hi_nib );
+  __m512i lo      = _mm512_shuffle_epi8( _mm512_broadcast_i32x4( _mm_setr_epi8( BASE64_DEC_LUT_LO ) ), lo_nib );
+  if( FD_UNLIKELY( _mm512_test_epi8_mask( lo, hi ) ) ) return 0;
+
+  __m512i roll_idx = _mm512_mask_sub_epi8( hi_nib, _mm512_cmpeq_epi8_mask( in, mask_2f ), hi_nib, _mm512_set1_epi8( 1 ) );
+  __m512i roll     = _mm512_shuffle_epi8( _mm512_broadcast_i32x4( _mm_setr_epi8( BASE64_DEC_LUT_ROLL ) ), roll_idx );
+  __m512i v = _mm512_add_epi8( in, roll );
+  v = _mm512_maddubs_epi16( v, _mm512_set1_epi32( 0x01400140 ) );
+  v = _mm512_madd_epi16   ( v, _mm512_set1_epi32( 0x00011000 ) );
+  v = _mm512_shuffle_epi8 ( v, _mm512_broadcast_i32x4( _mm_setr_epi8( BASE64_DEC_PACK ) ) );
+  *out = _mm512_permutexvar_epi32( _mm512_setr_epi32( 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 3, 7, 11, 15 ), v );
+  return 1;
+}
+
+#endif /* FD_HAS_AVX512 */
+
+long
+fd_base64_decode( uchar *      out,
+                  char const * in,
+                  ulong        in_len ) {
+
+  if( in_len==0UL ) return 0UL;
+
+  in_len = base64_unpad( in, in_len );
+  if( FD_UNLIKELY( in_len==ULONG_MAX ) ) return -1L;
+
+  ulong out_sz = 0UL;
+
+  /* Vector loops stop at the first block containing an invalid
+     character and leave it to the scalar loop to report the error.
+     The AVX2 loop stores 32 bytes for 24 decoded, so it only runs while
+     at least 45 characters (33 output bytes) remain. */
+
+#if FD_HAS_AVX512
+  while( in_len>=64UL ) {
+    __m512i v;
+    if( FD_UNLIKELY( !base64_dec_avx512( _mm512_loadu_si512( in ), &v ) ) ) break;
+    _mm512_mask_storeu_epi8( out+out_sz, 0x0000ffffffffffffUL, v );
+    in += 64UL; in_len -= 64UL; out_sz += 48UL;
+  }
+#endif
+#if FD_HAS_AVX
+  while( in_len>=45UL ) {
+    __m256i v;
+    if( FD_UNLIKELY( !base64_dec_avx( _mm256_loadu_si256( (__m256i const *)in ), &v ) ) ) break;
+    _mm256_storeu_si256( (__m256i *)(out+out_sz), v );
+    in += 32UL; in_len -= 32UL; out_sz += 24UL;
+  }
+#endif
+
+  long res = base64_decode_scalar( out+out_sz, in, in_len );
+  if( FD_UNLIKELY( res<0L ) ) return res;
+  return (long)out_sz + res;
+}
+
+ulong
+fd_base64_encode( char *       encoded,
+                  void const * _data,
+                  ulong        data_len ) {
+
+  uchar const * data = fd_type_pun_const( _data );
+
+  ulong encoded_len = 0UL;
+
+#if FD_HAS_AVX512
+  while( data_len>=48UL ) {
+    __m512i v = _mm512_maskz_loadu_epi8( 0x0000ffffffffffffUL, data );
+    _mm512_storeu_si512( encoded+encoded_len, base64_enc_avx512( v ) );
+    data += 48UL; data_len -= 48UL; encoded_len += 64UL;
+  }
+#endif
+#if FD_HAS_AVX
+  while( data_len>=32UL ) {
+    __m256i v = _mm256_loadu_si256( (__m256i const *)data );
+    _mm256_storeu_si256( (__m256i *)(encoded+encoded_len), base64_enc_avx( v ) );
+    data += 24UL; data_len -= 24UL; encoded_len += 32UL;
+  }
+#endif
+
+  return base64_encode_scalar( encoded, encoded_len, data, data_len );
+}
+
+long
+fd_base64_decode_ref( uchar *      out,
+                      char const * in,
+                      ulong        in_len ) {
+
+  if( in_len==0UL ) return 0UL;
+
+  in_len = base64_unpad( in, in_len );
+  if( FD_UNLIKELY( in_len==ULONG_MAX ) ) return -1L;
+
+  return base64_decode_scalar( out, in, in_len );
+}
+
+ulong
+fd_base64_encode_ref( char *       encoded,
+                      void const * data,
+                      ulong        data_len ) {
+  return base64_encode_scalar( encoded, 0UL, fd_type_pun_const( data ), data_len );
+}
@@ -59,6 +59,20 @@ fd_base64_decode( uchar *      out,
                   char const * in,
                   ulong        in_sz );
 
+/* fd_base64_{encode,decode} use AVX2 / AVX-512 when available.
+   fd_base64_{encode,decode}_ref are the portable scalar versions with
+   identical semantics, for testing and benchmarking. */
+
+ulong
+fd_base64_encode_ref( char *       out,
+                      void const * in,
+                      ulong        in_sz );
+
+long
+fd_base64_decode_ref( uchar *      out,
+                      char const * in,
+                      ulong        in_sz );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_ballet_base64_fd_base64_h */
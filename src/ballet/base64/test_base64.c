@@ -105,6 +105,38 @@ main( int     argc,
     if( FD_UNLIKELY( raw_sz>=0L ) ) FD_LOG_ERR(( "decode should have failed but didn't: \"%s\"", *corrupt ));
   }
 
+  /* Compare against the scalar reference for all sizes that hit the
+     vector paths and their tails */
+
+  for( ulong sz=0UL; sz<400UL; sz++ ) {
+    uchar raw [ 400UL ];
+    char  enc [ FD_BASE64_ENC_SZ( 400UL ) ];
+    char  ref [ FD_BASE64_ENC_SZ( 400UL ) ];
+    uchar dec [ 400UL ];
+    for( ulong i=0UL; i<sz; i++ ) raw[ i ] = fd_rng_uchar( rng );
+
+    ulong enc_sz = fd_base64_encode    ( enc, raw, sz );
+    ulong ref_sz = fd_base64_encode_ref( ref, raw, sz );
+    FD_TEST( enc_sz==FD_BASE64_ENC_SZ( sz ) );
+    FD_TEST( enc_sz==ref_sz && !memcmp( enc, ref, enc_sz ) );
+
+    FD_TEST( fd_base64_decode( dec, enc, enc_sz )==(long)sz );
+    FD_TEST( !memcmp( dec, raw, sz ) );
+
+    /* A single invalid character anywhere is rejected */
+
+    if( sz ) {
+      ulong pos  = fd_rng_ulong_roll( rng, enc_sz - (ulong)( enc[ enc_sz-1UL ]=='=' ) - (ulong)( enc[ enc_sz-2UL ]=='=' ) );
+      char  orig = enc[ pos ];
+      static char const bad[] = "!\"#$%&'()*,-.:;<>?@[\\]^_`{|}~ \n=";
+      enc[ pos ] = bad[ fd_rng_ulong_roll( rng, sizeof(bad)-1UL ) ];
+      FD_TEST( fd_base64_decode    ( dec, enc, enc_sz )<0L );
+      FD_TEST( fd_base64_decode_ref( dec, enc, enc_sz )<0L );
+      enc[ pos ] = (char)( orig | 0x80 );
+      FD_TEST( fd_base64_decode    ( dec, enc, enc_sz )<0L );
+    }
+  }
+
   /* Throughput test */
 
   static uchar raw[ 32768UL ];
@@ -94,24 +94,37 @@ INLINE void output_chaining_value(const output_t *self, uint8_t cv[32]) {
 
 INLINE void output_root_bytes(const output_t *self, uint64_t seek, uint8_t *out,
                               size_t out_len) {
+  if (out_len == 0) {
+    return;
+  }
   uint64_t output_block_counter = seek / 64;
   size_t offset_within_block = seek % 64;
   uint8_t wide_buf[64];
-  while (out_len > 0) {
+  if (offset_within_block) {
     fd_blake3_compress_xof(self->input_cv, self->block, self->block_len,
                            output_block_counter, self->flags | ROOT, wide_buf);
     size_t available_bytes = 64 - offset_within_block;
-    size_t fd_memcpy_len;
-    if (out_len > available_bytes) {
-      fd_memcpy_len = available_bytes;
-    } else {
-      fd_memcpy_len = out_len;
-    }
+    size_t fd_memcpy_len = out_len > available_bytes ? available_bytes : out_len;
     fd_memcpy(out, wide_buf + offset_within_block, fd_memcpy_len);
     out += fd_memcpy_len;
     out_len -= fd_memcpy_len;
     output_block_counter += 1;
-    offset_within_block = 0;
+  }
+  // Whole output blocks are independent of each other and are computed
+  // several at a time.
+  size_t full_blocks = out_len / 64;
+  if (full_blocks > 0) {
+    fd_blake3_xof_many(self->input_cv, self->block, self->block_len,
+                       output_block_counter, self->flags | ROOT, out,
+                       full_blocks);
+    out += full_blocks * 64;
+    out_len -= full_blocks * 64;
+    output_block_counter += full_blocks;
+  }
+  if (out_len > 0) {
+    fd_blake3_compress_xof(self->input_cv, self->block, self->block_len,
+                           output_block_counter, self->flags | ROOT, wide_buf);
+    fd_memcpy(out, wide_buf, out_len);
   }
 }
 
@@ -328,3 +328,61 @@ void fd_blake3_hash_many_avx2(const uint8_t *const *inputs, size_t num_inputs,
                                out);
 #endif
 }
+
+// Computes 8 consecutive output blocks (counter .. counter+7) of the same
+// root node in parallel.
+static
+void fd_blake3_xof8_avx2(const uint32_t cv[8],
+                         const uint8_t block[BLAKE3_BLOCK_LEN],
+                         uint8_t block_len, uint64_t counter, uint8_t flags,
+                         uint8_t out[8 * 64]) {
+  __m256i msg_vecs[16];
+  for (size_t i = 0; i < 16; i++) {
+    msg_vecs[i] = set1(load32(&block[4 * i]));
+  }
+  __m256i counter_low_vec, counter_high_vec;
+  load_counters(counter, true, &counter_low_vec, &counter_high_vec);
+  __m256i v[16] = {
+      set1(cv[0]),     set1(cv[1]),      set1(cv[2]),     set1(cv[3]),
+      set1(cv[4]),     set1(cv[5]),      set1(cv[6]),     set1(cv[7]),
+      set1(IV[0]),     set1(IV[1]),      set1(IV[2]),     set1(IV[3]),
+      counter_low_vec, counter_high_vec, set1(block_len), set1(flags),
+  };
+  round_fn(v, msg_vecs, 0);
+  round_fn(v, msg_vecs, 1);
+  round_fn(v, msg_vecs, 2);
+  round_fn(v, msg_vecs, 3);
+  round_fn(v, msg_vecs, 4);
+  round_fn(v, msg_vecs, 5);
+  round_fn(v, msg_vecs, 6);
+  for (size_t i = 0; i < 8; i++) {
+    v[i]     = xorv(v[i], v[i + 8]);
+    v[i + 8] = xorv(v[i + 8], set1(cv[i]));
+  }
+  // After transposition, v[j] and v[j+8] hold the low and high output
+  // words of lane j.
+  transpose_vecs(&v[0]);
+  transpose_vecs(&v[8]);
+  for (size_t j = 0; j < DEGREE; j++) {
+    storeu(v[j],     &out[j * 64]);
+    storeu(v[j + 8], &out[j * 64 + 32]);
+  }
+}
+
+void fd_blake3_xof_many_avx2(const uint32_t cv[8],
+                             const uint8_t block[BLAKE3_BLOCK_LEN],
+                             uint8_t block_len, uint64_t counter,
+                             uint8_t flags, uint8_t *out, size_t outblocks) {
+  while (outblocks >= DEGREE) {
+    fd_blake3_xof8_avx2(cv, block, block_len, counter, flags, out);
+    counter += DEGREE;
+    outblocks -= DEGREE;
+    out = &out[DEGREE * 64];
+  }
+  while (outblocks > 0) {
+    fd_blake3_compress_xof_sse41(cv, block, block_len, counter, flags, out);
+    counter += 1;
+    outblocks -= 1;
+    out = &out[64];
+  }
+}
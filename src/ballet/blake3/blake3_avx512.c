@@ -1222,3 +1222,131 @@ void fd_blake3_hash_many_avx512(const uint8_t *const *inputs, size_t num_inputs,
     out = &out[BLAKE3_OUT_LEN];
   }
 }
+
+/*
+ * ----------------------------------------------------------------------------
+ * xof_many_avx512
+ * ----------------------------------------------------------------------------
+ */
+
+// Computes 16 consecutive output blocks (counter .. counter+15) of the same
+// root node in parallel.  All lanes share the same message block and chaining
+// value and only differ in the block counter.
+static
+void fd_blake3_xof16_avx512(const uint32_t cv[8],
+                            const uint8_t block[BLAKE3_BLOCK_LEN],
+                            uint8_t block_len, uint64_t counter,
+                            uint8_t flags, uint8_t out[16 * 64]) {
+  __m512i msg_vecs[16];
+  for (size_t i = 0; i < 16; i++) {
+    msg_vecs[i] = set1_512(load32(&block[4 * i]));
+  }
+  __m512i counter_low_vec, counter_high_vec;
+  load_counters16(counter, true, &counter_low_vec, &counter_high_vec);
+  __m512i v[16] = {
+      set1_512(cv[0]),  set1_512(cv[1]),   set1_512(cv[2]),    set1_512(cv[3]),
+      set1_512(cv[4]),  set1_512(cv[5]),   set1_512(cv[6]),    set1_512(cv[7]),
+      set1_512(IV[0]),  set1_512(IV[1]),   set1_512(IV[2]),    set1_512(IV[3]),
+      counter_low_vec,  counter_high_vec,  set1_512(block_len), set1_512(flags),
+  };
+  round_fn16(v, msg_vecs, 0);
+  round_fn16(v, msg_vecs, 1);
+  round_fn16(v, msg_vecs, 2);
+  round_fn16(v, msg_vecs, 3);
+  round_fn16(v, msg_vecs, 4);
+  round_fn16(v, msg_vecs, 5);
+  round_fn16(v, msg_vecs, 6);
+  for (size_t i = 0; i < 8; i++) {
+    v[i]     = xor_512(v[i], v[i + 8]);
+    v[i + 8] = xor_512(v[i + 8], set1_512(cv[i]));
+  }
+  // After transposition, v[j] holds the 16 output words of lane j.
+  transpose_vecs_512(v);
+  for (size_t j = 0; j < 16; j++) {
+    _mm512_storeu_si512((__m512i *)&out[j * 64], v[j]);
+  }
+}
+
+void fd_blake3_xof_many_avx512(const uint32_t cv[8],
+                               const uint8_t block[BLAKE3_BLOCK_LEN],
+                               uint8_t block_len, uint64_t counter,
+                               uint8_t flags, uint8_t *out, size_t outblocks) {
+  while (outblocks >= 16) {
+    fd_blake3_xof16_avx512(cv, block, block_len, counter, flags, out);
+    counter += 16;
+    outblocks -= 16;
+    out = &out[16 * 64];
+  }
+  while (outblocks > 0) {
+    fd_blake3_compress_xof_avx512(cv, block, block_len, counter, flags, out);
+    counter += 1;
+    outblocks -= 1;
+    out = &out[64];
+  }
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * chunk_cv_many_avx512
+ * ----------------------------------------------------------------------------
+ */
+
+void fd_blake3_chunk_cv_many_avx512(const uint8_t *const inputs[16],
+                                    const size_t blocks[16], uint8_t *out) {
+  static const uint8_t zero_block[BLAKE3_BLOCK_LEN] = {0};
+
+  size_t max_blocks = 0;
+  for (size_t i = 0; i < 16; i++) {
+    max_blocks = blocks[i] > max_blocks ? blocks[i] : max_blocks;
+  }
+
+  __m512i h_vecs[8] = {
+      set1_512(IV[0]), set1_512(IV[1]), set1_512(IV[2]), set1_512(IV[3]),
+      set1_512(IV[4]), set1_512(IV[5]), set1_512(IV[6]), set1_512(IV[7]),
+  };
+  __m512i block_len_vec = set1_512(BLAKE3_BLOCK_LEN);
+  __m512i zero_vec = set1_512(0);
+
+  for (size_t block = 0; block < max_blocks; block++) {
+    // Lanes that ran out of blocks compress a zero block and discard the
+    // result, so inputs are never read past their end.
+    const uint8_t *ptrs[16];
+    __mmask16 active = 0;
+    for (size_t i = 0; i < 16; i++) {
+      int live = block < blocks[i];
+      ptrs[i] = live ? &inputs[i][block * BLAKE3_BLOCK_LEN] : zero_block;
+      active = (__mmask16)(active | (live << i));
+    }
+    __m512i msg_vecs[16];
+    transpose_msg_vecs16(ptrs, 0, msg_vecs);
+
+    __m512i v[16] = {
+        h_vecs[0],       h_vecs[1],       h_vecs[2],       h_vecs[3],
+        h_vecs[4],       h_vecs[5],       h_vecs[6],       h_vecs[7],
+        set1_512(IV[0]), set1_512(IV[1]), set1_512(IV[2]), set1_512(IV[3]),
+        zero_vec,        zero_vec,        block_len_vec,
+        set1_512(block == 0 ? CHUNK_START : 0),
+    };
+    round_fn16(v, msg_vecs, 0);
+    round_fn16(v, msg_vecs, 1);
+    round_fn16(v, msg_vecs, 2);
+    round_fn16(v, msg_vecs, 3);
+    round_fn16(v, msg_vecs, 4);
+    round_fn16(v, msg_vecs, 5);
+    round_fn16(v, msg_vecs, 6);
+    for (size_t i = 0; i < 8; i++) {
+      h_vecs[i] = _mm512_mask_mov_epi32(h_vecs[i], active, xor_512(v[i], v[i + 8]));
+    }
+  }
+
+  __m512i padded[16] = {
+      h_vecs[0], h_vecs[1], h_vecs[2], h_vecs[3],
+      h_vecs[4], h_vecs[5], h_vecs[6], h_vecs[7],
+      zero_vec,  zero_vec,  zero_vec,  zero_vec,
+      zero_vec,  zero_vec,  zero_vec,  zero_vec,
+  };
+  transpose_vecs_512(padded);
+  for (size_t j = 0; j < 16; j++) {
+    _mm256_mask_storeu_epi32(&out[j * BLAKE3_OUT_LEN], (__mmask8)-1, _mm512_castsi512_si256(padded[j]));
+  }
+}
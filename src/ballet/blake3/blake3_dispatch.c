@@ -73,6 +73,24 @@ void fd_blake3_hash_many(const uint8_t *const *inputs, size_t num_inputs,
 #endif
 }
 
+void fd_blake3_xof_many(const uint32_t cv[8],
+                        const uint8_t block[BLAKE3_BLOCK_LEN],
+                        uint8_t block_len, uint64_t counter, uint8_t flags,
+                        uint8_t *out, size_t outblocks) {
+#if FD_HAS_AVX512
+  fd_blake3_xof_many_avx512(cv, block, block_len, counter, flags, out,
+                            outblocks);
+#elif FD_HAS_AVX
+  fd_blake3_xof_many_avx2(cv, block, block_len, counter, flags, out,
+                          outblocks);
+#else
+  for (size_t i = 0; i < outblocks; i++) {
+    fd_blake3_compress_xof(cv, block, block_len, counter + i, flags,
+                           &out[i * 64]);
+  }
+#endif
+}
+
 // The dynamically detected SIMD degree of the current platform.
 size_t fd_blake3_simd_degree(void) {
 #if FD_HAS_AVX
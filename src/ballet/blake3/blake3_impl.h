@@ -162,6 +162,11 @@ void fd_blake3_hash_many(const uint8_t *const *inputs, size_t num_inputs,
                          bool increment_counter, uint8_t flags,
                          uint8_t flags_start, uint8_t flags_end, uint8_t *out);
 
+void fd_blake3_xof_many(const uint32_t cv[8],
+                        const uint8_t block[BLAKE3_BLOCK_LEN],
+                        uint8_t block_len, uint64_t counter, uint8_t flags,
+                        uint8_t *out, size_t outblocks);
+
 size_t fd_blake3_simd_degree(void);
 
 
@@ -212,6 +217,11 @@ void fd_blake3_hash_many_sse41(const uint8_t *const *inputs, size_t num_inputs,
                                uint64_t counter, bool increment_counter,
                                uint8_t flags, uint8_t flags_start,
                                uint8_t flags_end, uint8_t *out);
+void fd_blake3_xof_many_avx2(const uint32_t cv[8],
+                             const uint8_t block[BLAKE3_BLOCK_LEN],
+                             uint8_t block_len, uint64_t counter,
+                             uint8_t flags, uint8_t *out, size_t outblocks);
+
 void fd_blake3_hash_many_avx2(const uint8_t *const *inputs, size_t num_inputs,
                               size_t blocks, const uint32_t key[8],
                               uint64_t counter, bool increment_counter,
@@ -234,6 +244,18 @@ void fd_blake3_hash_many_avx512(const uint8_t *const *inputs, size_t num_inputs,
                                 uint64_t counter, bool increment_counter,
                                 uint8_t flags, uint8_t flags_start,
                                 uint8_t flags_end, uint8_t *out);
+
+void fd_blake3_xof_many_avx512(const uint32_t cv[8],
+                               const uint8_t block[BLAKE3_BLOCK_LEN],
+                               uint8_t block_len, uint64_t counter,
+                               uint8_t flags, uint8_t *out, size_t outblocks);
+
+// Compresses all but the last block of 16 independent single chunk
+// inputs in parallel.  Lane i compresses blocks[i] full blocks of
+// inputs[i] (blocks[i] may be 0 and may differ between lanes) and writes
+// the resulting chaining value to out[i * BLAKE3_OUT_LEN].
+void fd_blake3_chunk_cv_many_avx512(const uint8_t *const inputs[16],
+                                    const size_t blocks[16], uint8_t *out);
 #endif /* FD_HAS_AVX512 */
 #endif /* FD_HAS_X86 */
 
@@ -151,3 +151,69 @@ fd_blake3_fini_varlen( fd_blake3_t * sha,
   fd_blake3_hasher_finalize( &sha->hasher, (uchar *) hash, hash_len );
   return hash;
 }
+
+#if FD_HAS_AVX512
+
+/* fd_blake3_batch_xof16 hashes cnt<=16 messages.  Unused lanes and
+   messages larger than a single chunk are not absorbed in parallel
+   (blocks[i]==0); the latter are hashed one at a time. */
+
+static void
+fd_blake3_batch_xof16( uchar const * const * msg,
+                       ulong const *         msg_sz,
+                       ulong                 cnt,
+                       uchar *               out,
+                       ulong                 hash_len ) {
+  uchar const * inputs[ 16 ];
+  size_t        blocks[ 16 ];
+  for( ulong i=0UL; i<16UL; i++ ) {
+    ulong sz    = i<cnt ? msg_sz[ i ] : 0UL;
+    inputs[ i ] = i<cnt ? msg[ i ] : NULL;
+    blocks[ i ] = ( sz && sz<=BLAKE3_CHUNK_LEN ) ? (sz-1UL)/BLAKE3_BLOCK_LEN : 0UL;
+  }
+
+  uchar cvs[ 16*BLAKE3_OUT_LEN ] __attribute__((aligned(64)));
+  fd_blake3_chunk_cv_many_avx512( inputs, blocks, cvs );
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    ulong sz = msg_sz[ i ];
+    if( FD_UNLIKELY( sz>BLAKE3_CHUNK_LEN ) ) {
+      fd_blake3_t sha[1];
+      fd_blake3_fini_varlen( fd_blake3_append( fd_blake3_init( sha ), msg[ i ], sz ), out + i*hash_len, hash_len );
+      continue;
+    }
+
+    /* The last (possibly partial or empty) block of the chunk is the
+       root node. */
+
+    ulong   off = blocks[ i ]*BLAKE3_BLOCK_LEN;
+    uint8_t last[ BLAKE3_BLOCK_LEN ] = {0};
+    fd_memcpy( last, msg[ i ]+off, sz-off );
+    uint32_t cv[ 8 ];
+    fd_memcpy( cv, cvs + i*BLAKE3_OUT_LEN, BLAKE3_OUT_LEN );
+    uint8_t flags = (uint8_t)( CHUNK_END | ( blocks[ i ] ? 0 : CHUNK_START ) );
+    output_t output = make_output( cv, last, (uint8_t)(sz-off), 0UL, flags );
+    output_root_bytes( &output, 0UL, out + i*hash_len, hash_len );
+  }
+}
+
+#endif /* FD_HAS_AVX512 */
+
+void
+fd_blake3_batch_xof( void const * const * msg,
+                     ulong const *        msg_sz,
+                     ulong                cnt,
+                     void *               out,
+                     ulong                hash_len ) {
+  uchar * out_ = (uchar *)out;
+# if FD_HAS_AVX512
+  for( ulong i=0UL; i<cnt; i+=16UL ) {
+    fd_blake3_batch_xof16( (uchar const * const *)( msg+i ), msg_sz+i, fd_ulong_min( cnt-i, 16UL ), out_ + i*hash_len, hash_len );
+  }
+# else
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_blake3_t sha[1];
+    fd_blake3_fini_varlen( fd_blake3_append( fd_blake3_init( sha ), msg[ i ], msg_sz[ i ] ), out_ + i*hash_len, hash_len );
+  }
+# endif
+}
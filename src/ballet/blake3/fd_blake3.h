@@ -113,6 +113,20 @@ fd_blake3_fini_varlen( fd_blake3_t * sha,
                        void *        hash, 
                        ulong         hash_len );
 
+/* fd_blake3_batch_xof computes the hash_len byte BLAKE3 XOF output of
+   each of the cnt messages msg[i] (msg_sz[i] bytes) and stores it at
+   out + i*hash_len.  The result is identical to hashing each message
+   with fd_blake3_{init,append,fini_varlen}.  On AVX-512 targets, the
+   messages that fit in a single BLAKE3 chunk (1024 bytes) are absorbed
+   16 at a time in parallel; others are hashed one at a time. */
+
+void
+fd_blake3_batch_xof( void const * const * msg,
+                     ulong const *        msg_sz,
+                     ulong                cnt,
+                     void *               out,
+                     ulong                hash_len );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_ballet_blake3_fd_blake3_h */
@@ -77,6 +77,46 @@ main( int     argc,
                    FD_LOG_HEX16_FMT_ARGS( expected    ), FD_LOG_HEX16_FMT_ARGS( expected+16 ) ));
   }
 
+  /* test long XOF outputs.  Every output block k is checked against a
+     (64k+63)-byte output whose last bytes are computed one block at a
+     time. */
+
+  static uchar xof[ 4096 ];
+  static uchar xof_chk[ 4096 ];
+  for( ulong sz=0UL; sz<2200UL; sz+=97UL ) {
+    uchar msg[ 2200 ];
+    for( ulong b=0UL; b<sz; b++ ) msg[b] = fd_rng_uchar( rng );
+    fd_blake3_fini_varlen( fd_blake3_append( fd_blake3_init( sha ), msg, sz ), xof, sizeof(xof) );
+    for( ulong k=0UL; k<64UL; k++ ) {
+      ulong len = 64UL*k+63UL;
+      fd_blake3_fini_varlen( fd_blake3_append( fd_blake3_init( sha ), msg, sz ), xof_chk, len );
+      FD_TEST( !memcmp( xof, xof_chk, len ) );
+    }
+  }
+
+  /* test batch XOF against one at a time */
+
+  do {
+    static uchar msg_mem[ 40 ][ 1500 ];
+    void const * msg   [ 40 ];
+    ulong        msg_sz[ 40 ];
+    for( ulong i=0UL; i<40UL; i++ ) {
+      for( ulong b=0UL; b<1500UL; b++ ) msg_mem[i][b] = fd_rng_uchar( rng );
+      msg   [i] = msg_mem[i];
+      msg_sz[i] = fd_rng_ulong_roll( rng, 1500UL );
+    }
+    msg_sz[0] = 0UL; msg_sz[1] = 1UL; msg_sz[2] = 64UL; msg_sz[3] = 65UL; msg_sz[4] = 1024UL; msg_sz[5] = 1025UL;
+
+    static uchar out[ 40 ][ 200 ];
+    for( ulong cnt=0UL; cnt<=40UL; cnt+=5UL ) {
+      fd_blake3_batch_xof( msg, msg_sz, cnt, out, 200UL );
+      for( ulong i=0UL; i<cnt; i++ ) {
+        fd_blake3_fini_varlen( fd_blake3_append( fd_blake3_init( sha ), msg[i], msg_sz[i] ), xof_chk, 200UL );
+        FD_TEST( !memcmp( out[i], xof_chk, 200UL ) );
+      }
+    }
+  } while(0);
+
   static uchar buf[ 1<<24 ] __attribute__((aligned(32)));
   for( ulong b=0UL; b<sizeof(buf); b++ ) buf[b] = fd_rng_uchar( rng );
 
@@ -119,3 +119,94 @@ fd_chacha20rng_refill_avx( fd_chacha20rng_t * rng ) {
 
   rng->buf_fill += 8*FD_CHACHA20_BLOCK_SZ;
 }
+
+void
+fd_chacha20rng_block0_batch( uchar               out[][ FD_CHACHA20_BLOCK_SZ ],
+                             uchar const * const keys[],
+                             ulong               cnt ) {
+
+  if( FD_UNLIKELY( !cnt ) ) return;
+
+  /* Same as fd_chacha20rng_refill_avx, except that each lane uses its
+     own key (at block index 0) rather than its own block index.  Unused
+     lanes repeat the first key. */
+
+  wu_t iv0  = wu_bcast( 0x61707865U );
+  wu_t iv1  = wu_bcast( 0x3320646eU );
+  wu_t iv2  = wu_bcast( 0x79622d32U );
+  wu_t iv3  = wu_bcast( 0x6b206574U );
+  wu_t zero = wu_zero();
+
+  /* Transpose the keys such that kj holds word j of the key of each
+     lane */
+
+  uchar const * lane_key[ 8 ];
+  for( ulong i=0UL; i<8UL; i++ ) lane_key[ i ] = keys[ fd_ulong_if( i<cnt, i, 0UL ) ];
+
+  wu_t k0 = wu_ldu( lane_key[ 0 ] );
+  wu_t k1 = wu_ldu( lane_key[ 1 ] );
+  wu_t k2 = wu_ldu( lane_key[ 2 ] );
+  wu_t k3 = wu_ldu( lane_key[ 3 ] );
+  wu_t k4 = wu_ldu( lane_key[ 4 ] );
+  wu_t k5 = wu_ldu( lane_key[ 5 ] );
+  wu_t k6 = wu_ldu( lane_key[ 6 ] );
+  wu_t k7 = wu_ldu( lane_key[ 7 ] );
+  wu_transpose_8x8( k0, k1, k2, k3, k4, k5, k6, k7,
+                    k0, k1, k2, k3, k4, k5, k6, k7 );
+
+  /* Run through the round function */
+
+  wu_t c0 = iv0;   wu_t c1 = iv1;   wu_t c2 = iv2;   wu_t c3 = iv3;
+  wu_t c4 = k0;    wu_t c5 = k1;    wu_t c6 = k2;    wu_t c7 = k3;
+  wu_t c8 = k4;    wu_t c9 = k5;    wu_t cA = k6;    wu_t cB = k7;
+  wu_t cC = zero;  wu_t cD = zero;  wu_t cE = zero;  wu_t cF = zero;
+
+# define QUARTER_ROUND(a,b,c,d)                                        \
+  do {                                                                 \
+    a = wu_add( a, b ); d = wu_xor( d, a ); d = wu_rol16( d );         \
+    c = wu_add( c, d ); b = wu_xor( b, c ); b = wu_rol12( b );         \
+    a = wu_add( a, b ); d = wu_xor( d, a ); d = wu_rol8( d );          \
+    c = wu_add( c, d ); b = wu_xor( b, c ); b = wu_rol7( b );          \
+  } while(0)
+
+  for( ulong i=0UL; i<10UL; i++ ) {
+    QUARTER_ROUND( c0, c4, c8, cC );
+    QUARTER_ROUND( c1, c5, c9, cD );
+    QUARTER_ROUND( c2, c6, cA, cE );
+    QUARTER_ROUND( c3, c7, cB, cF );
+    QUARTER_ROUND( c0, c5, cA, cF );
+    QUARTER_ROUND( c1, c6, cB, cC );
+    QUARTER_ROUND( c2, c7, c8, cD );
+    QUARTER_ROUND( c3, c4, c9, cE );
+  }
+# undef QUARTER_ROUND
+
+  /* Finalize (the block index and nonce are zero) */
+
+  c0 = wu_add( c0, iv0 );
+  c1 = wu_add( c1, iv1 );
+  c2 = wu_add( c2, iv2 );
+  c3 = wu_add( c3, iv3 );
+  c4 = wu_add( c4, k0  );
+  c5 = wu_add( c5, k1  );
+  c6 = wu_add( c6, k2  );
+  c7 = wu_add( c7, k3  );
+  c8 = wu_add( c8, k4  );
+  c9 = wu_add( c9, k5  );
+  cA = wu_add( cA, k6  );
+  cB = wu_add( cB, k7  );
+
+  /* Transpose matrix to get the output block of each lane */
+
+  wu_transpose_8x8( c0, c1, c2, c3, c4, c5, c6, c7,
+                    c0, c1, c2, c3, c4, c5, c6, c7 );
+  wu_transpose_8x8( c8, c9, cA, cB, cC, cD, cE, cF,
+                    c8, c9, cA, cB, cC, cD, cE, cF );
+
+  wu_t lo[ 8 ] = { c0, c1, c2, c3, c4, c5, c6, c7 };
+  wu_t hi[ 8 ] = { c8, c9, cA, cB, cC, cD, cE, cF };
+  for( ulong i=0UL; i<cnt; i++ ) {
+    wu_stu( out[ i ],      lo[ i ] );
+    wu_stu( out[ i ]+32UL, hi[ i ] );
+  }
+}
@@ -91,4 +91,18 @@ fd_chacha20rng_refill_seq( fd_chacha20rng_t * rng ) {
   }
 }
 
+void
+fd_chacha20rng_block0_batch( uchar               out[][ FD_CHACHA20_BLOCK_SZ ],
+                             uchar const * const keys[],
+                             ulong               cnt ) {
+  uint  idx_nonce[4] __attribute__((aligned(16))) = { 0U, 0U, 0U, 0U };
+  uchar key  [ FD_CHACHA20_KEY_SZ   ] __attribute__((aligned(32)));
+  uchar block[ FD_CHACHA20_BLOCK_SZ ] __attribute__((aligned(32)));
+  for( ulong i=0UL; i<cnt; i++ ) {
+    memcpy( key, keys[ i ], FD_CHACHA20_KEY_SZ );
+    fd_chacha20_block( block, key, idx_nonce );
+    memcpy( out[ i ], block, FD_CHACHA20_BLOCK_SZ );
+  }
+}
+
 #endif
@@ -149,6 +149,44 @@ fd_chacha20rng_ulong( fd_chacha20rng_t * rng ) {
   return x;
 }
 
+/* fd_chacha20rng_private_zone returns the largest accepted value of
+   the low half of v*n in the rejection sampling done by
+   fd_chacha20rng_ulong_roll for the given mode.  See the note in
+   fd_chacha20rng_ulong_roll for details. */
+
+FD_FN_CONST static inline ulong
+fd_chacha20rng_private_zone( int   mode,
+                             ulong n ) {
+  return fd_ulong_if( mode==FD_CHACHA20RNG_MODE_MOD,
+                      ULONG_MAX - (ULONG_MAX-n+1UL)%n,
+                      (n << (63 - fd_ulong_find_msb( n ) )) - 1UL );
+}
+
+/* fd_chacha20rng_private_roll1 maps the random ulong v to [0,n) as one
+   attempt of fd_chacha20rng_ulong_roll.  Returns 1 and stores the
+   result in *out if v is accepted, returns 0 if v is rejected. */
+
+static inline int
+fd_chacha20rng_private_roll1( ulong   v,
+                              ulong   n,
+                              ulong   zone,
+                              ulong * out ) {
+#if FD_HAS_INT128
+  /* Compiles to one mulx instruction */
+  uint128 res = (uint128)v * (uint128)n;
+  ulong   hi  = (ulong)(res>>64);
+  ulong   lo  = (ulong) res;
+#else
+  ulong hi, lo;
+  fd_uwide_mul( &hi, &lo, v, n );
+#endif
+# if FD_CHACHA20RNG_DEBUG
+  FD_LOG_DEBUG(( "roll: n=%016lx zone: %016lx v=%016lx lo=%016lx hi=%016lx", n, zone, v, lo, hi ));
+# endif /* FD_CHACHA20RNG_DEBUG */
+  *out = hi;
+  return lo<=zone;
+}
+
 /* fd_chacha20rng_ulong_roll returns an uniform IID rand in [0,n)
    analogous to fd_rng_ulong_roll.  Rejection method based using
    fd_chacha20rng_ulong.
@@ -199,31 +237,31 @@ fd_chacha20rng_ulong_roll( fd_chacha20rng_t * rng,
      k*n<=2^64 unless n is a power of two.  This approach eliminates the
      mod calculation but increases the expected number of samples
      required. */
-  ulong const zone = fd_ulong_if( rng->mode==FD_CHACHA20RNG_MODE_MOD,
-                                  ULONG_MAX - (ULONG_MAX-n+1UL)%n,
-                                  (n << (63 - fd_ulong_find_msb( n ) )) - 1UL );
+  ulong const zone = fd_chacha20rng_private_zone( rng->mode, n );
+  for(;;) {
+    ulong hi;
+    if( FD_LIKELY( fd_chacha20rng_private_roll1( fd_chacha20rng_ulong( rng ), n, zone, &hi ) ) ) return hi;
+  }
+}
 
-  for( int i=0; 1; i++ ) {
-    ulong   v   = fd_chacha20rng_ulong( rng );
-#if FD_HAS_INT128
-    /* Compiles to one mulx instruction */
-    uint128 res = (uint128)v * (uint128)n;
-    ulong   hi  = (ulong)(res>>64);
-    ulong   lo  = (ulong) res;
-#else
-    ulong hi, lo;
-    fd_uwide_mul( &hi, &lo, v, n );
-#endif
+/* FD_CHACHA20RNG_BATCH_MAX is the max number of streams processed by
+   fd_chacha20rng_block0_batch. */
 
-#   if FD_CHACHA20RNG_DEBUG
-    FD_LOG_DEBUG(( "roll (attempt %d): n=%016lx zone: %016lx v=%016lx lo=%016lx hi=%016lx", i, n, zone, v, lo, hi ));
-#   else
-    (void)i;
-#   endif /* FD_CHACHA20RNG_DEBUG */
+#define FD_CHACHA20RNG_BATCH_MAX (8UL)
 
-    if( FD_LIKELY( lo<=zone ) ) return hi;
-  }
-}
+/* fd_chacha20rng_block0_batch computes the first FD_CHACHA20_BLOCK_SZ
+   bytes of the RNG streams for cnt keys, i.e. the bytes returned by the
+   first 8 calls to fd_chacha20rng_ulong after fd_chacha20rng_init( rng,
+   keys[i] ), and stores them at out[i] for i in [0,cnt).  cnt in [0,
+   FD_CHACHA20RNG_BATCH_MAX].  keys and out have no alignment
+   requirements.  With AVX, the streams are generated in parallel (one
+   stream per vector lane).  This is useful when many streams only need
+   a few random numbers each. */
+
+void
+fd_chacha20rng_block0_batch( uchar               out[][ FD_CHACHA20_BLOCK_SZ ],
+                             uchar const * const keys[],
+                             ulong               cnt );
 
 FD_PROTOTYPES_END
 
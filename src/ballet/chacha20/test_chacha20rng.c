@@ -34,6 +34,23 @@ main( int     argc,
     fd_chacha20rng_ulong( rng );
   FD_TEST( fd_chacha20rng_ulong( rng )==0xf4682b7e28eae4a7UL );
 
+  /* Batched first blocks match the streams of fd_chacha20rng_init */
+
+  for( ulong cnt=0UL; cnt<=FD_CHACHA20RNG_BATCH_MAX; cnt++ ) {
+    uchar         keys[ FD_CHACHA20RNG_BATCH_MAX ][ 33 ]; /* odd size, keys[i]+1 is misaligned */
+    uchar const * key_ptr[ FD_CHACHA20RNG_BATCH_MAX ];
+    uchar         out[ FD_CHACHA20RNG_BATCH_MAX ][ FD_CHACHA20_BLOCK_SZ ];
+    for( ulong i=0UL; i<cnt; i++ ) {
+      for( ulong j=0UL; j<33UL; j++ ) keys[ i ][ j ] = (uchar)( 7UL*i + 3UL*j*cnt );
+      key_ptr[ i ] = keys[ i ]+1;
+    }
+    fd_chacha20rng_block0_batch( out, key_ptr, cnt );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      FD_TEST( fd_chacha20rng_init( rng, key_ptr[ i ] ) );
+      for( ulong j=0UL; j<8UL; j++ ) FD_TEST( FD_LOAD( ulong, out[ i ]+8UL*j )==fd_chacha20rng_ulong( rng ) );
+    }
+  }
+
   do {
     FD_LOG_NOTICE(( "Benchmarking fd_chacha20rng_ulong" ));
     key[ 0 ]++;
@@ -129,6 +129,42 @@ fd_ed25519_verify_batch_single_msg( uchar const   msg[], /* msg_sz */
                                     fd_sha512_t * shas[ 1 ],               /* batch_sz */
                                     uchar const   batch_sz );
 
+/* fd_ed25519_verify_batch_multi_msg verifies a batch of batch_sz
+   independent signatures, each over its own message and with its own
+   public key, according to the ED25519 standard.  Unlike
+   fd_ed25519_verify_batch_single_msg, the result of each signature is
+   reported separately such that a bad signature only affects its own
+   entry.
+
+   For j in [0,batch_sz), msgs[j] / msg_szs[j] / sigs[j] / pubkeys[j]
+   have the same meaning as msg / msg_sz / sig / public_key in
+   fd_ed25519_verify.  On return, errs[j] holds FD_ED25519_SUCCESS (0)
+   or the FD_ED25519_ERR_* code fd_ed25519_verify would have returned
+   for the j-th signature.  batch_sz must be in
+   [1,FD_ED25519_VERIFY_BATCH_MAX].
+
+   This does exactly the same per signature checks as
+   fd_ed25519_verify (in particular, each signature is checked with the
+   cofactorless equation, so results are identical to verifying one at
+   a time).  The speedup comes from computing the SHA-512 challenges of
+   the whole batch in parallel with fd_sha512_batch.  Messages up to
+   FD_ED25519_VERIFY_BATCH_MSG_MAX bytes take the batched hashing path,
+   longer ones are hashed individually.
+
+   Returns FD_ED25519_SUCCESS if all signatures verified successfully
+   and the first (lowest index) error code in errs otherwise. */
+
+#define FD_ED25519_VERIFY_BATCH_MAX     (16UL)
+#define FD_ED25519_VERIFY_BATCH_MSG_MAX (1280UL)
+
+int
+fd_ed25519_verify_batch_multi_msg( uchar const * const msgs[],    /* batch_sz */
+                                   ulong const         msg_szs[], /* batch_sz */
+                                   uchar const * const sigs[],    /* batch_sz, each 64 bytes */
+                                   uchar const * const pubkeys[], /* batch_sz, each 32 bytes */
+                                   int                 errs[],    /* batch_sz */
+                                   ulong               batch_sz );
+
 /* fd_ed25519_strerror converts an FD_ED25519_SUCCESS / FD_ED25519_ERR_*
    code into a human readable cstr.  The lifetime of the returned
    pointer is infinite.  The returned pointer is always to a non-NULL
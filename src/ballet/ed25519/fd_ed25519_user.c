@@ -309,6 +309,88 @@ int fd_ed25519_verify_batch_single_msg( uchar const   msg[], /* msg_sz */
 #undef MAX
 }
 
+int
+fd_ed25519_verify_batch_multi_msg( uchar const * const msgs[],
+                                   ulong const         msg_szs[],
+                                   uchar const * const sigs[],
+                                   uchar const * const pubkeys[],
+                                   int                 errs[],
+                                   ulong               batch_sz ) {
+#define MAX FD_ED25519_VERIFY_BATCH_MAX
+  if( FD_UNLIKELY( batch_sz==0UL || batch_sz>MAX ) ) {
+    return FD_ED25519_ERR_SIG;
+  }
+
+  fd_ed25519_point_t R     [MAX];
+  fd_ed25519_point_t Aprime[MAX];
+  uchar              k     [MAX][64];
+
+  /* First, validate scalars, decompress public keys and points R_j and
+     check low order points (see fd_ed25519_verify for details). */
+  for( ulong j=0UL; j<batch_sz; j++ ) {
+    errs[j] = FD_ED25519_SUCCESS;
+    if( FD_UNLIKELY( !fd_curve25519_scalar_validate( sigs[j]+32 ) ) ) {
+      errs[j] = FD_ED25519_ERR_SIG;
+      continue;
+    }
+    int res = fd_ed25519_point_frombytes_2x( &Aprime[j], pubkeys[j], &R[j], sigs[j] );
+    if( FD_UNLIKELY( res ) ) {
+      errs[j] = res == 1 ? FD_ED25519_ERR_PUBKEY : FD_ED25519_ERR_SIG;
+      continue;
+    }
+    if( FD_UNLIKELY( fd_ed25519_affine_is_small_order(&Aprime[j]) ) ) {
+      errs[j] = FD_ED25519_ERR_PUBKEY;
+      continue;
+    }
+    if( FD_UNLIKELY( fd_ed25519_affine_is_small_order(&R[j]) ) ) {
+      errs[j] = FD_ED25519_ERR_SIG;
+      continue;
+    }
+  }
+
+  /* Compute k_j = SHA512(R_j || A_j || M_j) for all the remaining
+     signatures.  The batch hasher wants each input contiguous, so
+     R || A || M is staged in a scratch slot.  The batch hashes (and so
+     frees up all slots) every time it fills up, so FD_SHA512_BATCH_MAX
+     slots are enough. */
+  uchar __attribute__((aligned(64))) scratch[ FD_SHA512_BATCH_MAX ][ 64UL+FD_ED25519_VERIFY_BATCH_MSG_MAX ];
+  uchar __attribute__((aligned(FD_SHA512_BATCH_ALIGN))) _batch[ FD_SHA512_BATCH_FOOTPRINT ];
+  fd_sha512_batch_t * batch = fd_sha512_batch_init( _batch );
+  ulong slot = 0UL;
+  for( ulong j=0UL; j<batch_sz; j++ ) {
+    if( FD_UNLIKELY( errs[j] ) ) continue;
+    ulong msg_sz = msg_szs[j];
+    if( FD_LIKELY( msg_sz<=FD_ED25519_VERIFY_BATCH_MSG_MAX ) ) {
+      uchar * buf = scratch[ slot ];
+      fd_memcpy( buf,      sigs[j],    32UL   );
+      fd_memcpy( buf+32UL, pubkeys[j], 32UL   );
+      fd_memcpy( buf+64UL, msgs[j],    msg_sz );
+      fd_sha512_batch_add( batch, buf, 64UL+msg_sz, k[j] );
+      slot = (slot+1UL) % FD_SHA512_BATCH_MAX;
+    } else {
+      fd_sha512_t sha[1];
+      fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ),
+                      sigs[j], 32UL ), pubkeys[j], 32UL ), msgs[j], msg_sz ), k[j] );
+    }
+  }
+  fd_sha512_batch_fini( batch );
+
+  /* Finally, check the group equation of each signature. */
+  int err = FD_ED25519_SUCCESS;
+  for( ulong j=0UL; j<batch_sz; j++ ) {
+    if( FD_LIKELY( !errs[j] ) ) {
+      fd_ed25519_point_t Rcmp[1];
+      fd_curve25519_scalar_reduce( k[j], k[j] );
+      fd_ed25519_point_neg( &Aprime[j], &Aprime[j] );
+      fd_ed25519_double_scalar_mul_base( Rcmp, k[j], &Aprime[j], sigs[j]+32 );
+      if( FD_UNLIKELY( !fd_ed25519_point_eq_z1( Rcmp, &R[j] ) ) ) errs[j] = FD_ED25519_ERR_MSG;
+    }
+    if( FD_UNLIKELY( errs[j] && !err ) ) err = errs[j];
+  }
+  return err;
+#undef MAX
+}
+
 char const *
 fd_ed25519_strerror( int err ) {
   switch( err ) {
@@ -1141,6 +1141,92 @@ test_cctv_batch( fd_rng_t * rng, fd_sha512_t * sha ) {
   FD_LOG_NOTICE(( "fd_ed25519_verify_cctv_batch: ok" ));
 }
 
+void
+test_verify_batch_multi_msg( fd_rng_t * rng, fd_sha512_t * sha ) {
+# define BATCH FD_ED25519_VERIFY_BATCH_MAX
+# define SZ    (FD_ED25519_VERIFY_BATCH_MSG_MAX+256UL)
+  static uchar _msgs[ BATCH ][ SZ ];
+  uchar        _sigs[ BATCH ][ 64 ];
+  uchar        _pubs[ BATCH ][ 32 ];
+  uchar        prv[ 32 ];
+
+  uchar const * msgs   [ BATCH ];
+  ulong         msg_szs[ BATCH ];
+  uchar const * sigs   [ BATCH ];
+  uchar const * pubs   [ BATCH ];
+  int           errs   [ BATCH ];
+
+  for( ulong iter=0UL; iter<256UL; iter++ ) {
+    ulong batch_sz = 1UL + fd_rng_ulong_roll( rng, BATCH );
+    for( ulong j=0UL; j<batch_sz; j++ ) {
+      /* Mostly small messages, sometimes ones that take the unbatched
+         hashing path */
+      ulong sz = fd_rng_uint_roll( rng, 8U ) ? fd_rng_ulong_roll( rng, 1233UL ) : fd_rng_ulong_roll( rng, SZ+1UL );
+      for( ulong b=0UL; b<sz; b++ ) _msgs[j][b] = fd_rng_uchar( rng );
+      fd_ed25519_public_from_private( _pubs[j], fd_rng_b256( rng, prv ), sha );
+      fd_ed25519_sign( _sigs[j], _msgs[j], sz, _pubs[j], prv, sha );
+
+      /* Corrupt some */
+      uint r = fd_rng_uint( rng );
+      if( !(r & 7U) ) { ulong idx = fd_rng_ulong_roll( rng, 512UL ); _sigs[j][ idx>>3 ] = (uchar)( _sigs[j][ idx>>3 ] ^ (1U<<(idx&7UL)) ); }
+      r >>= 3;
+      if( !(r & 7U) ) { ulong idx = fd_rng_ulong_roll( rng, 256UL ); _pubs[j][ idx>>3 ] = (uchar)( _pubs[j][ idx>>3 ] ^ (1U<<(idx&7UL)) ); }
+      r >>= 3;
+      if( !(r & 7U) && sz ) { ulong idx = fd_rng_ulong_roll( rng, 8UL*sz ); _msgs[j][ idx>>3 ] = (uchar)( _msgs[j][ idx>>3 ] ^ (1U<<(idx&7UL)) ); }
+
+      msgs[j] = _msgs[j]; msg_szs[j] = sz; sigs[j] = _sigs[j]; pubs[j] = _pubs[j];
+    }
+
+    int err = fd_ed25519_verify_batch_multi_msg( msgs, msg_szs, sigs, pubs, errs, batch_sz );
+    int exp_err = FD_ED25519_SUCCESS;
+    for( ulong j=0UL; j<batch_sz; j++ ) {
+      int exp = fd_ed25519_verify( msgs[j], msg_szs[j], sigs[j], pubs[j], sha );
+      FD_TEST( errs[j]==exp );
+      if( exp && !exp_err ) exp_err = exp;
+    }
+    FD_TEST( err==exp_err );
+  }
+
+  /* Verify the batch against the cctv vectors, one bad apple at a time */
+  for( fd_ed25519_verify_cctv_t const * proof = ed25519_verify_cctvs;
+       proof->msg;
+       proof++ ) {
+    ulong idx = fd_rng_ulong_roll( rng, BATCH );
+    for( ulong j=0UL; j<BATCH; j++ ) {
+      ulong sz = fd_rng_ulong_roll( rng, 256UL );
+      for( ulong b=0UL; b<sz; b++ ) _msgs[j][b] = fd_rng_uchar( rng );
+      fd_ed25519_public_from_private( _pubs[j], fd_rng_b256( rng, prv ), sha );
+      fd_ed25519_sign( _sigs[j], _msgs[j], sz, _pubs[j], prv, sha );
+      msgs[j] = _msgs[j]; msg_szs[j] = sz; sigs[j] = _sigs[j]; pubs[j] = _pubs[j];
+    }
+    msgs[idx] = proof->msg; msg_szs[idx] = proof->msg_sz; sigs[idx] = proof->sig; pubs[idx] = proof->pub;
+
+    fd_ed25519_verify_batch_multi_msg( msgs, msg_szs, sigs, pubs, errs, BATCH );
+    for( ulong j=0UL; j<BATCH; j++ ) FD_TEST( j==idx ? ((errs[j]==FD_ED25519_SUCCESS)==proof->ok) : errs[j]==FD_ED25519_SUCCESS );
+  }
+
+  /* Bench vs one at a time */
+  for( ulong j=0UL; j<BATCH; j++ ) {
+    ulong sz = 256UL;
+    for( ulong b=0UL; b<sz; b++ ) _msgs[j][b] = fd_rng_uchar( rng );
+    fd_ed25519_public_from_private( _pubs[j], fd_rng_b256( rng, prv ), sha );
+    fd_ed25519_sign( _sigs[j], _msgs[j], sz, _pubs[j], prv, sha );
+    msgs[j] = _msgs[j]; msg_szs[j] = sz; sigs[j] = _sigs[j]; pubs[j] = _pubs[j];
+  }
+  ulong iter = 1000UL;
+  long dt = fd_log_wallclock();
+  for( ulong rem=iter; rem; rem-- ) {
+    FD_COMPILER_MFENCE();
+    fd_ed25519_verify_batch_multi_msg( msgs, msg_szs, sigs, pubs, errs, BATCH );
+  }
+  dt = fd_log_wallclock() - dt;
+  log_bench( "fd_ed25519_verify_batch_multi_msg(256 / 16)", iter, dt );
+
+  FD_LOG_NOTICE(( "fd_ed25519_verify_batch_multi_msg: ok" ));
+# undef SZ
+# undef BATCH
+}
+
 /**********************************************************************/
 
 int
@@ -1181,6 +1267,8 @@ main( int     argc,
   test_cctv       ( sha );
   test_cctv_batch ( rng, sha );
 
+  test_verify_batch_multi_msg( rng, sha );
+
   fd_sha512_delete( fd_sha512_leave( sha ) );
   fd_rng_delete( fd_rng_leave( rng ) );
   FD_LOG_NOTICE(( "pass" ));
@@ -1,2 +1,4 @@
 $(call add-hdrs,fd_lthash.h)
+$(call add-objs,fd_lthash,fd_ballet)
 $(call make-unit-test,test_lthash,test_lthash,fd_ballet fd_util)
+$(call make-unit-test,bench_lthash,bench_lthash,fd_ballet fd_util)
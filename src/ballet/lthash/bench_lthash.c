@@ -0,0 +1,101 @@
+/* bench_lthash measures the throughput of folding account lthashes into
+   an accumulator, one account at a time (fd_lthash_{init,append,fini,
+   add}) and in batches (fd_lthash_batch_add).  Accounts are modeled as
+   the bytes hashed by the accounts lthash (lamports, data, executable,
+   owner, pubkey), i.e. 73 bytes plus the account data. */
+
+#include "fd_lthash.h"
+
+#define ACC_MAX  (1UL<<16)
+#define DATA_MAX (1024UL)
+
+static uchar        msg_mem[ ACC_MAX ][ 73UL+DATA_MAX ];
+static void const * msg_tbl[ ACC_MAX ];
+static ulong        sz_tbl [ ACC_MAX ];
+
+__attribute__((noinline)) static void
+bench_one( fd_lthash_value_t *  acc,
+           void const * const * msg,
+           ulong const *        msg_sz,
+           ulong                cnt ) {
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_lthash_t       h[1];
+    fd_lthash_value_t v[1];
+    fd_lthash_fini( fd_lthash_append( fd_lthash_init( h ), msg[ i ], msg_sz[ i ] ), v );
+    fd_lthash_add( acc, v );
+  }
+}
+
+__attribute__((noinline)) static void
+bench_batch( fd_lthash_value_t *  acc,
+             void const * const * msg,
+             ulong const *        msg_sz,
+             ulong                cnt ) {
+  fd_lthash_batch_add( acc, msg, msg_sz, cnt );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong acc_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--accounts", NULL, ACC_MAX );
+  ulong data_max = fd_env_strip_cmdline_ulong( &argc, &argv, "--data-max", NULL,   200UL );
+  ulong iter_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter",     NULL,    10UL );
+  uint  rng_seed = fd_env_strip_cmdline_uint ( &argc, &argv, "--rng-seed", NULL,  1234U  );
+
+  if( FD_UNLIKELY( !acc_cnt || acc_cnt>ACC_MAX ) ) FD_LOG_ERR(( "--accounts must be in [1,%lu]", ACC_MAX ));
+  if( FD_UNLIKELY( data_max>DATA_MAX           ) ) FD_LOG_ERR(( "--data-max must be at most %lu", DATA_MAX ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, rng_seed, 0UL ) );
+
+  ulong byte_cnt = 0UL;
+  for( ulong i=0UL; i<acc_cnt; i++ ) {
+    msg_tbl[ i ] = msg_mem[ i ];
+    sz_tbl [ i ] = 73UL + fd_rng_ulong_roll( rng, data_max+1UL );
+    for( ulong j=0UL; j<sz_tbl[ i ]; j++ ) msg_mem[ i ][ j ] = fd_rng_uchar( rng );
+    byte_cnt += sz_tbl[ i ];
+  }
+
+  FD_LOG_NOTICE(( "accounts %lu, data 0..%lu bytes (%.1f bytes hashed per account)",
+                  acc_cnt, data_max, (double)byte_cnt/(double)acc_cnt ));
+
+  fd_lthash_value_t acc_one  [1]; fd_lthash_zero( acc_one   );
+  fd_lthash_value_t acc_batch[1]; fd_lthash_zero( acc_batch );
+
+  /* warmup */
+
+  bench_one  ( acc_one,   msg_tbl, sz_tbl, acc_cnt );
+  bench_batch( acc_batch, msg_tbl, sz_tbl, acc_cnt );
+  FD_TEST( !memcmp( acc_one, acc_batch, FD_LTHASH_LEN_BYTES ) );
+
+  /* for real */
+
+  long dt_one = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) bench_one( acc_one, msg_tbl, sz_tbl, acc_cnt );
+  dt_one += fd_log_wallclock();
+
+  long dt_batch = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) bench_batch( acc_batch, msg_tbl, sz_tbl, acc_cnt );
+  dt_batch += fd_log_wallclock();
+
+  FD_TEST( !memcmp( acc_one, acc_batch, FD_LTHASH_LEN_BYTES ) );
+
+  double tot = (double)( acc_cnt*iter_cnt );
+  FD_LOG_NOTICE(( "one at a time: %.3e accounts/s per core (%.1f ns per account)", tot*1e9/(double)dt_one,   (double)dt_one  /tot ));
+  FD_LOG_NOTICE(( "batch:         %.3e accounts/s per core (%.1f ns per account)", tot*1e9/(double)dt_batch, (double)dt_batch/tot ));
+
+  /* add / sub only */
+
+  fd_lthash_value_t tmp[1]; fd_lthash_zero( tmp );
+  ulong add_cnt = 1UL<<20;
+  long dt_add = -fd_log_wallclock();
+  for( ulong i=0UL; i<add_cnt; i++ ) { fd_lthash_add( acc_one, tmp ); FD_COMPILER_MFENCE(); }
+  dt_add += fd_log_wallclock();
+  FD_LOG_NOTICE(( "fd_lthash_add: %.1f ns", (double)dt_add/(double)add_cnt ));
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
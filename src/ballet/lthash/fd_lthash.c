@@ -0,0 +1,33 @@
+#include "fd_lthash.h"
+
+static fd_lthash_value_t *
+fd_lthash_batch( fd_lthash_value_t *  r,
+                 void const * const * msg,
+                 ulong const *        msg_sz,
+                 ulong                cnt,
+                 int                  sub ) {
+  fd_lthash_value_t tmp[ FD_LTHASH_BATCH_MAX ];
+  for( ulong i=0UL; i<cnt; i+=FD_LTHASH_BATCH_MAX ) {
+    ulong n = fd_ulong_min( cnt-i, FD_LTHASH_BATCH_MAX );
+    fd_blake3_batch_xof( msg+i, msg_sz+i, n, tmp, FD_LTHASH_LEN_BYTES );
+    if( sub ) for( ulong j=0UL; j<n; j++ ) fd_lthash_sub( r, tmp+j );
+    else      for( ulong j=0UL; j<n; j++ ) fd_lthash_add( r, tmp+j );
+  }
+  return r;
+}
+
+fd_lthash_value_t *
+fd_lthash_batch_add( fd_lthash_value_t *  r,
+                     void const * const * msg,
+                     ulong const *        msg_sz,
+                     ulong                cnt ) {
+  return fd_lthash_batch( r, msg, msg_sz, cnt, 0 );
+}
+
+fd_lthash_value_t *
+fd_lthash_batch_sub( fd_lthash_value_t *  r,
+                     void const * const * msg,
+                     ulong const *        msg_sz,
+                     ulong                cnt ) {
+  return fd_lthash_batch( r, msg, msg_sz, cnt, 1 );
+}
@@ -7,6 +7,12 @@
 
 #include "../fd_ballet_base.h"
 #include "../blake3/fd_blake3.h"
+#if FD_HAS_AVX512
+#include "../../util/simd/fd_avx512.h"
+#endif
+#if FD_HAS_AVX
+#include "../../util/simd/fd_avx.h"
+#endif
 
 #define FD_LTHASH_ALIGN     (FD_BLAKE3_ALIGN)
 #define FD_LTHASH_LEN_BYTES (2048UL)
@@ -39,24 +45,79 @@ fd_lthash_zero( fd_lthash_value_t * r ) {
   return fd_memset( r->bytes, 0, FD_LTHASH_LEN_BYTES );
 }
 
+/* fd_lthash_{add,sub} do r += a and r -= a (element-wise mod 2^16)
+   and return r.  r and a need not be aligned (values are frequently
+   embedded in packed structures). */
+
 static inline fd_lthash_value_t *
 fd_lthash_add( fd_lthash_value_t * restrict       r,
                fd_lthash_value_t const * restrict a ) {
+# if FD_HAS_AVX512
+  for( ulong i=0UL; i<FD_LTHASH_LEN_BYTES; i+=64UL ) {
+    __m512i x = _mm512_loadu_si512( r->bytes+i );
+    __m512i y = _mm512_loadu_si512( a->bytes+i );
+    _mm512_storeu_si512( r->bytes+i, _mm512_add_epi16( x, y ) );
+  }
+# elif FD_HAS_AVX
+  for( ulong i=0UL; i<FD_LTHASH_LEN_BYTES; i+=32UL ) {
+    wh_stu( r->bytes+i, wh_add( wh_ldu( r->bytes+i ), wh_ldu( a->bytes+i ) ) );
+  }
+# else
   for ( ulong i=0; i<FD_LTHASH_LEN_ELEMS; i++ ) {
     r->words[i] = (ushort)( r->words[i] + a->words[i] );
   }
+# endif
   return r;
 }
 
 static inline fd_lthash_value_t *
 fd_lthash_sub( fd_lthash_value_t * restrict       r,
                fd_lthash_value_t const * restrict a ) {
+# if FD_HAS_AVX512
+  for( ulong i=0UL; i<FD_LTHASH_LEN_BYTES; i+=64UL ) {
+    __m512i x = _mm512_loadu_si512( r->bytes+i );
+    __m512i y = _mm512_loadu_si512( a->bytes+i );
+    _mm512_storeu_si512( r->bytes+i, _mm512_sub_epi16( x, y ) );
+  }
+# elif FD_HAS_AVX
+  for( ulong i=0UL; i<FD_LTHASH_LEN_BYTES; i+=32UL ) {
+    wh_stu( r->bytes+i, wh_sub( wh_ldu( r->bytes+i ), wh_ldu( a->bytes+i ) ) );
+  }
+# else
   for ( ulong i=0; i<FD_LTHASH_LEN_ELEMS; i++ ) {
     r->words[i] = (ushort)( r->words[i] - a->words[i] );
   }
+# endif
   return r;
 }
 
+/* FD_LTHASH_BATCH_MAX is the number of messages fd_lthash_batch_{add,sub}
+   hash in parallel. */
+
+#define FD_LTHASH_BATCH_MAX (16UL)
+
+/* fd_lthash_batch_add computes the lthash of each of the cnt messages
+   msg[i] (msg_sz[i] bytes) and adds them all to r.  Equivalent to (but
+   on AVX-512 targets substantially faster than) doing for each message:
+
+     fd_lthash_init( h ); fd_lthash_append( h, msg[i], msg_sz[i] );
+     fd_lthash_fini( h, tmp ); fd_lthash_add( r, tmp );
+
+   Messages up to 1024 bytes benefit the most.  fd_lthash_batch_sub is
+   the same but subtracts.  Returns r. */
+
+fd_lthash_value_t *
+fd_lthash_batch_add( fd_lthash_value_t *  r,
+                     void const * const * msg,
+                     ulong const *        msg_sz,
+                     ulong                cnt );
+
+fd_lthash_value_t *
+fd_lthash_batch_sub( fd_lthash_value_t *  r,
+                     void const * const * msg,
+                     ulong const *        msg_sz,
+                     ulong                cnt );
+
 static inline void
 fd_lthash_hash( fd_lthash_value_t const *  r, uchar hash[ static 32] ) {
   ulong *p = (ulong *) r->bytes;
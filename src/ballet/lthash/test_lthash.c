@@ -136,6 +136,68 @@ static ushort const lthash_world[1024] = {
   0x8b70, 0x1be3, 0xa39d, 0xbf82, 0x6e04, 0x3bd2, 0xdf31, 0x0741, 0xaab8, 0xd398, 0x01f4, 0xdd3a, 0x2f9d, 0x2b55, 0x6811, 0x171f,
 };
 
+/* test_batch checks fd_lthash_{add,sub} and fd_lthash_batch_{add,sub}
+   against a scalar reference for messages of assorted sizes (including
+   ones spanning multiple blake3 chunks). */
+
+static void
+test_batch( fd_rng_t * rng ) {
+# define MSG_CNT (37UL)
+  static uchar msg_mem[ MSG_CNT ][ 3000 ];
+  void const * msg   [ MSG_CNT ];
+  ulong        msg_sz[ MSG_CNT ];
+  for( ulong i=0UL; i<MSG_CNT; i++ ) {
+    for( ulong j=0UL; j<3000UL; j++ ) msg_mem[ i ][ j ] = fd_rng_uchar( rng );
+    msg   [ i ] = msg_mem[ i ];
+    msg_sz[ i ] = (i<18UL) ? i*59UL : fd_rng_ulong_roll( rng, 3000UL );
+  }
+  msg_sz[ 20 ] = 1024UL; msg_sz[ 21 ] = 1025UL; msg_sz[ 22 ] = 64UL; msg_sz[ 23 ] = 65UL;
+
+  fd_lthash_value_t ref[1]; ushort ref_words[ FD_LTHASH_LEN_ELEMS ];
+  fd_lthash_zero( ref );
+  memset( ref_words, 0, sizeof(ref_words) );
+  for( ulong i=0UL; i<MSG_CNT; i++ ) {
+    fd_lthash_t       h[1];
+    fd_lthash_value_t v[1];
+    fd_lthash_fini( fd_lthash_append( fd_lthash_init( h ), msg[ i ], msg_sz[ i ] ), v );
+    fd_lthash_add( ref, v );
+    for( ulong j=0UL; j<FD_LTHASH_LEN_ELEMS; j++ ) ref_words[ j ] = (ushort)( ref_words[ j ] + v->words[ j ] );
+  }
+  FD_TEST( !memcmp( ref->words, ref_words, sizeof(ref_words) ) );
+
+  /* Unaligned add / sub */
+
+  static uchar unaligned[ 1UL+FD_LTHASH_LEN_BYTES ];
+  fd_lthash_value_t * u = (fd_lthash_value_t *)( unaligned+1UL );
+  fd_lthash_zero( u );
+  FD_TEST( fd_lthash_add( u, ref )==u );
+  FD_TEST( !memcmp( u->bytes, ref->bytes, FD_LTHASH_LEN_BYTES ) );
+  FD_TEST( fd_lthash_sub( u, ref )==u );
+  for( ulong j=0UL; j<FD_LTHASH_LEN_ELEMS; j++ ) FD_TEST( !u->words[ j ] );
+
+  /* Batch add in one call and in pieces, then batch sub back to zero */
+
+  fd_lthash_value_t acc[1];
+  fd_lthash_zero( acc );
+  FD_TEST( fd_lthash_batch_add( acc, msg, msg_sz, MSG_CNT )==acc );
+  FD_TEST( !memcmp( acc->bytes, ref->bytes, FD_LTHASH_LEN_BYTES ) );
+
+  fd_lthash_zero( acc );
+  for( ulong i=0UL; i<MSG_CNT; ) {
+    ulong n = fd_ulong_min( MSG_CNT-i, 1UL+fd_rng_ulong_roll( rng, 20UL ) );
+    fd_lthash_batch_add( acc, msg+i, msg_sz+i, n );
+    i += n;
+  }
+  FD_TEST( !memcmp( acc->bytes, ref->bytes, FD_LTHASH_LEN_BYTES ) );
+
+  FD_TEST( fd_lthash_batch_sub( acc, msg, msg_sz, MSG_CNT )==acc );
+  for( ulong j=0UL; j<FD_LTHASH_LEN_ELEMS; j++ ) FD_TEST( !acc->words[ j ] );
+
+  FD_TEST( fd_lthash_batch_add( acc, msg, msg_sz, 0UL )==acc );
+  for( ulong j=0UL; j<FD_LTHASH_LEN_ELEMS; j++ ) FD_TEST( !acc->words[ j ] );
+# undef MSG_CNT
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -204,6 +266,8 @@ main( int     argc,
     FD_LOG_ERR(( "FAIL fd_lthash_zero()" ));
   }
 
+  test_batch( rng );
+
   fd_rng_delete( fd_rng_leave( rng ) );
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
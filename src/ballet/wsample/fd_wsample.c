@@ -428,51 +428,63 @@ fd_wsample_restore_all( fd_wsample_t * sampler ) {
 /* Helper methods for sampling functions */
 typedef struct { ulong idx; ulong weight; } idxw_pair_t; /* idx in [0, total_cnt) */
 
-/* Assumes query in [0, unremoved_weight), which implies
-   unremoved_weight>0, so the tree can't be empty. */
-static inline idxw_pair_t
-fd_wsample_map_sample_i( fd_wsample_t const * sampler,
-                         ulong                query ) {
-  tree_ele_t const * tree = sampler->tree;
-
-  ulong cursor = 0UL;
-  ulong S      = sampler->unremoved_weight;
-  for( ulong h=0UL; h<sampler->height; h++ ) {
-    tree_ele_t const * e = tree+cursor;
-    ulong x = query;
-    ulong child_idx = 0UL;
+/* fd_wsample_map_step descends one level of the tree from node
+   *cursor, updating the query, the subtree weight, and the cursor. */
+static inline void
+fd_wsample_map_step( tree_ele_t const * tree,
+                     ulong *            _query,
+                     ulong *            _S,
+                     ulong *            _cursor ) {
+  ulong query  = *_query;
+  ulong S      = *_S;
+  ulong cursor = *_cursor;
+
+  tree_ele_t const * e = tree+cursor;
+  ulong x = query;
+  ulong child_idx = 0UL;
 
 #if FD_HAS_AVX512 && R==9
-    __mmask8 mask = _mm512_cmple_epu64_mask( wwv_ld( e->left_sum ), wwv_bcast( x ) );
-    child_idx = (ulong)fd_uchar_popcnt( mask );
+  __mmask8 mask = _mm512_cmple_epu64_mask( wwv_ld( e->left_sum ), wwv_bcast( x ) );
+  child_idx = (ulong)fd_uchar_popcnt( mask );
 #else
-    for( ulong i=0UL; i<R-1UL; i++ ) child_idx += (ulong)(e->left_sum[ i ]<=x);
+  for( ulong i=0UL; i<R-1UL; i++ ) child_idx += (ulong)(e->left_sum[ i ]<=x);
 #endif
 
-    /* See the note at the top of this file for the explanation of l[i]
-       and l[i-1].  Because this is fd_ulong_if and not a ternary, these
-       can read/write out of what you would think the appropriate bounds
-       are.  The dummy elements, as described along with tree makes this
-       safe. */
+  /* See the note at the top of this file for the explanation of l[i]
+     and l[i-1].  Because this is fd_ulong_if and not a ternary, these
+     can read/write out of what you would think the appropriate bounds
+     are.  The dummy elements, as described along with tree makes this
+     safe. */
 #if 0
-    ulong li  = fd_ulong_if( child_idx<R-1UL, e->left_sum[ child_idx     ], S   );
-    ulong lm1 = fd_ulong_if( child_idx>0UL,   e->left_sum[ child_idx-1UL ], 0UL );
+  ulong li  = fd_ulong_if( child_idx<R-1UL, e->left_sum[ child_idx     ], S   );
+  ulong lm1 = fd_ulong_if( child_idx>0UL,   e->left_sum[ child_idx-1UL ], 0UL );
 #elif 0
-    ulong li  = fd_ulong_if_force( child_idx<R-1UL, e->left_sum[ child_idx     ], S   );
-    ulong lm1 = fd_ulong_if_force( child_idx>0UL,   e->left_sum[ child_idx-1UL ], 0UL );
+  ulong li  = fd_ulong_if_force( child_idx<R-1UL, e->left_sum[ child_idx     ], S   );
+  ulong lm1 = fd_ulong_if_force( child_idx>0UL,   e->left_sum[ child_idx-1UL ], 0UL );
 #else
-    ulong * temp = (ulong *)e->left_sum;
-    ulong orig_m1 = temp[ -1 ];    ulong orig_Rm1 = temp[ R-1UL ];
-    temp[ -1 ] = 0UL;              temp[ R-1UL ] = S;
-    ulong li  = temp[ child_idx     ];
-    ulong lm1 = temp[ child_idx-1UL ];
-    temp[ -1 ] = orig_m1;          temp[ R-1UL ] = orig_Rm1;
+  ulong * temp = (ulong *)e->left_sum;
+  ulong orig_m1 = temp[ -1 ];    ulong orig_Rm1 = temp[ R-1UL ];
+  temp[ -1 ] = 0UL;              temp[ R-1UL ] = S;
+  ulong li  = temp[ child_idx     ];
+  ulong lm1 = temp[ child_idx-1UL ];
+  temp[ -1 ] = orig_m1;          temp[ R-1UL ] = orig_Rm1;
 #endif
 
-    query -= lm1;
-    S = li - lm1;
-    cursor = R*cursor + child_idx + 1UL;
-  }
+  *_query  = query - lm1;
+  *_S      = li - lm1;
+  *_cursor = R*cursor + child_idx + 1UL;
+}
+
+/* Assumes query in [0, unremoved_weight), which implies
+   unremoved_weight>0, so the tree can't be empty. */
+static inline idxw_pair_t
+fd_wsample_map_sample_i( fd_wsample_t const * sampler,
+                         ulong                query ) {
+  tree_ele_t const * tree = sampler->tree;
+
+  ulong cursor = 0UL;
+  ulong S      = sampler->unremoved_weight;
+  for( ulong h=0UL; h<sampler->height; h++ ) fd_wsample_map_step( tree, &query, &S, &cursor );
   idxw_pair_t to_return = { .idx = cursor - sampler->internal_node_cnt, .weight = S };
   return to_return;
 }
@@ -619,3 +631,59 @@ fd_wsample_sample_and_remove( fd_wsample_t * sampler ) {
   fd_wsample_remove( sampler, p );
   return p.idx;
 }
+
+void
+fd_wsample_sample_batch( fd_wsample_t *      sampler,
+                         uchar const * const seeds[],
+                         ulong *             idxs,
+                         ulong               cnt ) {
+  if( FD_UNLIKELY( !sampler->unremoved_weight ) ) { for( ulong i=0UL; i<cnt; i++ ) idxs[ i ] = FD_WSAMPLE_EMPTY;         return; }
+  if( FD_UNLIKELY(  sampler->poisoned_mode    ) ) { for( ulong i=0UL; i<cnt; i++ ) idxs[ i ] = FD_WSAMPLE_INDETERMINATE; return; }
+
+  tree_ele_t const * tree = sampler->tree;
+  ulong n    = sampler->unremoved_weight+sampler->poisoned_weight;
+  ulong zone = fd_chacha20rng_private_zone( sampler->rng->mode, n );
+
+  for( ulong i0=0UL; i0<cnt; i0+=FD_CHACHA20RNG_BATCH_MAX ) {
+    ulong batch_cnt = fd_ulong_min( cnt-i0, FD_CHACHA20RNG_BATCH_MAX );
+
+    /* A sample almost always only needs the first few random numbers of
+       its stream, so generate the first block of all the streams in
+       parallel.  If all of them are rejected, fall back to the full
+       stream. */
+
+    uchar block[ FD_CHACHA20RNG_BATCH_MAX ][ FD_CHACHA20_BLOCK_SZ ];
+    fd_chacha20rng_block0_batch( block, seeds+i0, batch_cnt );
+
+    ulong query [ FD_CHACHA20RNG_BATCH_MAX ];
+    ulong S     [ FD_CHACHA20RNG_BATCH_MAX ];
+    ulong cursor[ FD_CHACHA20RNG_BATCH_MAX ];
+    int   poison[ FD_CHACHA20RNG_BATCH_MAX ];
+    for( ulong j=0UL; j<batch_cnt; j++ ) {
+      ulong unif = 0UL;
+      int   done = 0;
+      for( ulong k=0UL; (k<FD_CHACHA20_BLOCK_SZ/sizeof(ulong)) & !done; k++ ) {
+        done = fd_chacha20rng_private_roll1( FD_LOAD( ulong, block[ j ]+k*sizeof(ulong) ), n, zone, &unif );
+      }
+      if( FD_UNLIKELY( !done ) ) {
+        fd_chacha20rng_init( sampler->rng, seeds[ i0+j ] );
+        unif = fd_chacha20rng_ulong_roll( sampler->rng, n );
+      }
+      poison[ j ] = unif>=sampler->unremoved_weight;
+      query [ j ] = fd_ulong_if( poison[ j ], 0UL, unif );
+      S     [ j ] = sampler->unremoved_weight;
+      cursor[ j ] = 0UL;
+    }
+
+    /* Descend the tree with all the samples of the batch level by level
+       so that their (independent) loads overlap. */
+
+    for( ulong h=0UL; h<sampler->height; h++ ) {
+      for( ulong j=0UL; j<batch_cnt; j++ ) fd_wsample_map_step( tree, query+j, S+j, cursor+j );
+    }
+
+    for( ulong j=0UL; j<batch_cnt; j++ ) {
+      idxs[ i0+j ] = fd_ulong_if( poison[ j ], FD_WSAMPLE_INDETERMINATE, cursor[ j ] - sampler->internal_node_cnt );
+    }
+  }
+}
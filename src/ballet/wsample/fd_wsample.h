@@ -174,6 +174,18 @@ ulong fd_wsample_sample_and_remove     ( fd_wsample_t * sampler );
 void  fd_wsample_sample_many           ( fd_wsample_t * sampler, ulong * idxs, ulong cnt );
 void  fd_wsample_sample_and_remove_many( fd_wsample_t * sampler, ulong * idxs, ulong cnt );
 
+/* fd_wsample_sample_batch draws one sample (with replacement) for each
+   of cnt RNG seeds.  It stores in idxs[i] the value that
+   fd_wsample_seed_rng( fd_wsample_get_rng( sampler ), seeds[i] )
+   followed by fd_wsample_sample( sampler ) would return, for i in [0,
+   cnt).  seeds[i] points to 32 bytes (no alignment requirement).  The
+   streams of several seeds are generated in parallel and the tree
+   searches of several samples are interleaved, which is much faster
+   than reseeding and sampling one at a time when each seed is only
+   used for a single sample.  The state of the sampler's RNG is
+   unspecified on return. */
+void fd_wsample_sample_batch( fd_wsample_t * sampler, uchar const * const seeds[], ulong * idxs, ulong cnt );
+
 /* fd_wsample_remove_idx removes an element by index as if it had been selected
    for sampling without replacement.  Unless restore_all is called, this
    index will no longer be returned by any of the sample methods, and
@@ -245,6 +245,66 @@ test_matches_solana( void ) {
   fd_chacha20rng_delete( fd_chacha20rng_leave( rng ) );
 }
 
+static void
+test_sample_batch( void ) {
+  fd_chacha20rng_t _rng[1];
+  fd_rng_t _r[1]; fd_rng_t * r = fd_rng_join( fd_rng_new( _r, 7U, 0UL ) );
+
+# define BATCH_SEED_CNT 2000UL
+  static uchar         seeds   [ BATCH_SEED_CNT ][ 32 ];
+  static uchar const * seed_ptr[ BATCH_SEED_CNT ];
+  static ulong         idxs    [ BATCH_SEED_CNT ];
+  for( ulong i=0UL; i<BATCH_SEED_CNT; i++ ) {
+    for( ulong j=0UL; j<32UL; j++ ) seeds[ i ][ j ] = fd_rng_uchar( r );
+    seed_ptr[ i ] = seeds[ i ];
+  }
+
+  for( int mode=FD_CHACHA20RNG_MODE_MOD; mode<=FD_CHACHA20RNG_MODE_SHIFT; mode++ ) {
+    for( ulong poisoned=0UL; poisoned<2UL; poisoned++ ) {
+      /* The total weight is just above a power of two, which maximizes
+         the rejection rate in MODE_SHIFT, so that some of the streams
+         need more than their first block. */
+      ulong cnt = 1000UL;
+      fd_chacha20rng_t * rng = fd_chacha20rng_join( fd_chacha20rng_new( _rng, mode ) );
+      void * partial = fd_wsample_new_init( _shmem, rng, cnt, 1, FD_WSAMPLE_HINT_POWERLAW_REMOVE );
+      for( ulong i=0UL; i<cnt; i++ ) partial = fd_wsample_new_add( partial, 1UL + (i<25UL) );
+      fd_wsample_t * tree = fd_wsample_join( fd_wsample_new_fini( partial, poisoned*200UL ) );
+
+      for( ulong remove=0UL; remove<2UL; remove++ ) {
+        if( remove ) fd_wsample_remove_idx( tree, 3UL );
+
+        for( ulong batch_cnt=0UL; batch_cnt<=BATCH_SEED_CNT; batch_cnt+=fd_ulong_if( batch_cnt<20UL, 1UL, 997UL ) ) {
+          fd_wsample_sample_batch( tree, seed_ptr, idxs, batch_cnt );
+          for( ulong i=0UL; i<batch_cnt; i++ ) {
+            fd_wsample_seed_rng( fd_wsample_get_rng( tree ), seeds[ i ] );
+            FD_TEST( idxs[ i ]==fd_wsample_sample( tree ) );
+            FD_TEST( idxs[ i ]!=3UL || !remove );
+          }
+        }
+      }
+
+      /* Samplers in poisoned mode and empty samplers */
+
+      if( poisoned ) {
+        fd_wsample_restore_all( tree );
+        while( fd_wsample_sample_and_remove( tree )!=FD_WSAMPLE_INDETERMINATE );
+        fd_wsample_sample_batch( tree, seed_ptr, idxs, 10UL );
+        for( ulong i=0UL; i<10UL; i++ ) FD_TEST( idxs[ i ]==FD_WSAMPLE_INDETERMINATE );
+      }
+
+      fd_wsample_restore_all( tree );
+      for( ulong i=0UL; i<cnt; i++ ) fd_wsample_remove_idx( tree, i );
+      fd_wsample_sample_batch( tree, seed_ptr, idxs, 10UL );
+      for( ulong i=0UL; i<10UL; i++ ) FD_TEST( idxs[ i ]==FD_WSAMPLE_EMPTY );
+
+      fd_wsample_delete( fd_wsample_leave( tree ) );
+      fd_chacha20rng_delete( fd_chacha20rng_leave( rng ) );
+    }
+  }
+# undef BATCH_SEED_CNT
+  fd_rng_delete( fd_rng_leave( r ) );
+}
+
 static void
 test_sharing( void ) {
   fd_chacha20rng_t _rng[1];
@@ -479,6 +539,7 @@ main( int     argc,
   test_empty();
   test_footprint();
   test_poison();
+  test_sample_batch();
 
   test_probability_dist_replacement();
   test_probability_dist_noreplacement();
@@ -25,6 +25,10 @@ const fd_metrics_meta_t FD_METRICS_GOSSIP[FD_METRICS_GOSSIP_TOTAL] = {
     DECLARE_METRIC_ENUM( GOSSIP_RECEIVED_GOSSIP_MESSAGES, COUNTER, GOSSIP_MESSAGE, PING ),
     DECLARE_METRIC_ENUM( GOSSIP_RECEIVED_GOSSIP_MESSAGES, COUNTER, GOSSIP_MESSAGE, PONG ),
     DECLARE_METRIC( GOSSIP_RECEIVED_UNKNOWN_MESSAGE, COUNTER ),
+    DECLARE_METRIC( GOSSIP_VERIFY_BACKLOG, GAUGE ),
+    DECLARE_METRIC( GOSSIP_VERIFY_BATCHES, COUNTER ),
+    DECLARE_METRIC( GOSSIP_VERIFY_SIGNATURES, COUNTER ),
+    DECLARE_METRIC( GOSSIP_VERIFY_FAILURES, COUNTER ),
     DECLARE_METRIC_ENUM( GOSSIP_RECEIVED_CRDS_PUSH, COUNTER, CRDS_VALUE, CONTACT_INFO_V1 ),
     DECLARE_METRIC_ENUM( GOSSIP_RECEIVED_CRDS_PUSH, COUNTER, CRDS_VALUE, VOTE ),
     DECLARE_METRIC_ENUM( GOSSIP_RECEIVED_CRDS_PUSH, COUNTER, CRDS_VALUE, LOWEST_SLOT ),
@@ -5,6 +5,8 @@ const fd_metrics_meta_t FD_METRICS_NET[FD_METRICS_NET_TOTAL] = {
     DECLARE_METRIC( NET_RX_PKT_CNT, COUNTER ),
     DECLARE_METRIC( NET_RX_BYTES_TOTAL, COUNTER ),
     DECLARE_METRIC( NET_RX_UNDERSZ_CNT, COUNTER ),
+    DECLARE_METRIC( NET_RX_OVERSZ_CNT, COUNTER ),
+    DECLARE_METRIC( NET_RX_MULTI_BUF_CNT, COUNTER ),
     DECLARE_METRIC( NET_RX_FILL_BLOCKED_CNT, COUNTER ),
     DECLARE_METRIC( NET_RX_BACKPRESSURE_CNT, COUNTER ),
     DECLARE_METRIC( NET_RX_BUSY_CNT, GAUGE ),
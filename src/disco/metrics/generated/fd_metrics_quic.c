@@ -20,6 +20,7 @@ const fd_metrics_meta_t FD_METRICS_QUIC[FD_METRICS_QUIC_TOTAL] = {
     DECLARE_METRIC( QUIC_RECEIVED_BYTES, COUNTER ),
     DECLARE_METRIC( QUIC_SENT_PACKETS, COUNTER ),
     DECLARE_METRIC( QUIC_SENT_BYTES, COUNTER ),
+    DECLARE_METRIC( QUIC_SENT_BATCHES, COUNTER ),
     DECLARE_METRIC( QUIC_CONNECTIONS_ACTIVE, GAUGE ),
     DECLARE_METRIC( QUIC_CONNECTIONS_CREATED, COUNTER ),
     DECLARE_METRIC( QUIC_CONNECTIONS_CLOSED, COUNTER ),
@@ -4,4 +4,15 @@
 const fd_metrics_meta_t FD_METRICS_REPLAY[FD_METRICS_REPLAY_TOTAL] = {
     DECLARE_METRIC( REPLAY_SLOT, GAUGE ),
     DECLARE_METRIC( REPLAY_LAST_VOTED_SLOT, GAUGE ),
+    DECLARE_METRIC( REPLAY_PROGCACHE_HIT, COUNTER ),
+    DECLARE_METRIC( REPLAY_PROGCACHE_MISS, COUNTER ),
+    DECLARE_METRIC( REPLAY_PROGCACHE_INSERT, COUNTER ),
+    DECLARE_METRIC( REPLAY_PROGCACHE_EVICT, COUNTER ),
+    DECLARE_METRIC( REPLAY_PROGCACHE_INVALIDATE, COUNTER ),
+    DECLARE_METRIC( REPLAY_PROGCACHE_DATA_SZ, GAUGE ),
+    DECLARE_METRIC( REPLAY_FUNK_DEMOTE, COUNTER ),
+    DECLARE_METRIC( REPLAY_FUNK_DEMOTE_BYTES, COUNTER ),
+    DECLARE_METRIC( REPLAY_FUNK_PROMOTE, COUNTER ),
+    DECLARE_METRIC( REPLAY_FUNK_PROMOTE_BYTES, COUNTER ),
+    DECLARE_METRIC( REPLAY_FUNK_COLD_RECORDS, GAUGE ),
 };
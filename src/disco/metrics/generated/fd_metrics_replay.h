@@ -15,5 +15,71 @@
 #define FD_METRICS_GAUGE_REPLAY_LAST_VOTED_SLOT_DESC ""
 #define FD_METRICS_GAUGE_REPLAY_LAST_VOTED_SLOT_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_REPLAY_TOTAL (2UL)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_HIT_OFF  (18UL)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_HIT_NAME "replay_progcache_hit"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_HIT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_HIT_DESC "The number of times a validated program was found in the program cache"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_HIT_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_MISS_OFF  (19UL)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_MISS_NAME "replay_progcache_miss"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_MISS_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_MISS_DESC "The number of times a program had to be loaded and validated because it was not in the program cache"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_MISS_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INSERT_OFF  (20UL)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INSERT_NAME "replay_progcache_insert"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INSERT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INSERT_DESC "The number of validated programs inserted into the program cache"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INSERT_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_EVICT_OFF  (21UL)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_EVICT_NAME "replay_progcache_evict"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_EVICT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_EVICT_DESC "The number of programs evicted from the program cache to make room for others"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_EVICT_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INVALIDATE_OFF  (22UL)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INVALIDATE_NAME "replay_progcache_invalidate"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INVALIDATE_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INVALIDATE_DESC "The number of programs removed from the program cache because their program data account was modified"
+#define FD_METRICS_COUNTER_REPLAY_PROGCACHE_INVALIDATE_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_GAUGE_REPLAY_PROGCACHE_DATA_SZ_OFF  (23UL)
+#define FD_METRICS_GAUGE_REPLAY_PROGCACHE_DATA_SZ_NAME "replay_progcache_data_sz"
+#define FD_METRICS_GAUGE_REPLAY_PROGCACHE_DATA_SZ_TYPE (FD_METRICS_TYPE_GAUGE)
+#define FD_METRICS_GAUGE_REPLAY_PROGCACHE_DATA_SZ_DESC "The number of bytes of validated programs currently held in the program cache"
+#define FD_METRICS_GAUGE_REPLAY_PROGCACHE_DATA_SZ_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_REPLAY_FUNK_DEMOTE_OFF  (24UL)
+#define FD_METRICS_COUNTER_REPLAY_FUNK_DEMOTE_NAME "replay_funk_demote"
+#define FD_METRICS_COUNTER_REPLAY_FUNK_DEMOTE_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_REPLAY_FUNK_DEMOTE_DESC "The number of account records moved out of funk into the cold tier"
+#define FD_METRICS_COUNTER_REPLAY_FUNK_DEMOTE_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_REPLAY_FUNK_DEMOTE_BYTES_OFF  (25UL)
+#define FD_METRICS_COUNTER_REPLAY_FUNK_DEMOTE_BYTES_NAME "replay_funk_demote_bytes"
+#define FD_METRICS_COUNTER_REPLAY_FUNK_DEMOTE_BYTES_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_REPLAY_FUNK_DEMOTE_BYTES_DESC "The number of account data bytes moved out of funk into the cold tier"
+#define FD_METRICS_COUNTER_REPLAY_FUNK_DEMOTE_BYTES_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_REPLAY_FUNK_PROMOTE_OFF  (26UL)
+#define FD_METRICS_COUNTER_REPLAY_FUNK_PROMOTE_NAME "replay_funk_promote"
+#define FD_METRICS_COUNTER_REPLAY_FUNK_PROMOTE_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_REPLAY_FUNK_PROMOTE_DESC "The number of account records moved back into funk from the cold tier"
+#define FD_METRICS_COUNTER_REPLAY_FUNK_PROMOTE_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_REPLAY_FUNK_PROMOTE_BYTES_OFF  (27UL)
+#define FD_METRICS_COUNTER_REPLAY_FUNK_PROMOTE_BYTES_NAME "replay_funk_promote_bytes"
+#define FD_METRICS_COUNTER_REPLAY_FUNK_PROMOTE_BYTES_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_REPLAY_FUNK_PROMOTE_BYTES_DESC "The number of account data bytes moved back into funk from the cold tier"
+#define FD_METRICS_COUNTER_REPLAY_FUNK_PROMOTE_BYTES_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_GAUGE_REPLAY_FUNK_COLD_RECORDS_OFF  (28UL)
+#define FD_METRICS_GAUGE_REPLAY_FUNK_COLD_RECORDS_NAME "replay_funk_cold_records"
+#define FD_METRICS_GAUGE_REPLAY_FUNK_COLD_RECORDS_TYPE (FD_METRICS_TYPE_GAUGE)
+#define FD_METRICS_GAUGE_REPLAY_FUNK_COLD_RECORDS_DESC "The number of account records currently held in the cold tier"
+#define FD_METRICS_GAUGE_REPLAY_FUNK_COLD_RECORDS_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_REPLAY_TOTAL (13UL)
 extern const fd_metrics_meta_t FD_METRICS_REPLAY[FD_METRICS_REPLAY_TOTAL];
@@ -18,6 +18,8 @@ const fd_metrics_meta_t FD_METRICS_SHRED[FD_METRICS_SHRED_TOTAL] = {
     DECLARE_METRIC( SHRED_FEC_SET_SPILLED, COUNTER ),
     DECLARE_METRIC( SHRED_SHRED_REJECTED_INITIAL, COUNTER ),
     DECLARE_METRIC( SHRED_FEC_REJECTED_FATAL, COUNTER ),
+    DECLARE_METRIC( SHRED_FEC_SET_ENCODED, COUNTER ),
+    DECLARE_METRIC( SHRED_FEC_SET_RECOVERED, COUNTER ),
     DECLARE_METRIC( SHRED_FORCE_COMPLETE_REQUEST, COUNTER ),
     DECLARE_METRIC( SHRED_FORCE_COMPLETE_FAILURE, COUNTER ),
     DECLARE_METRIC( SHRED_FORCE_COMPLETE_SUCCESS, COUNTER ),
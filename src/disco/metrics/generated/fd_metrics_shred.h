@@ -87,23 +87,35 @@
 #define FD_METRICS_COUNTER_SHRED_FEC_REJECTED_FATAL_DESC "The number of FEC sets that were rejected for reasons that cause the whole FEC set to become invalid"
 #define FD_METRICS_COUNTER_SHRED_FEC_REJECTED_FATAL_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_REQUEST_OFF  (112UL)
+#define FD_METRICS_COUNTER_SHRED_FEC_SET_ENCODED_OFF  (112UL)
+#define FD_METRICS_COUNTER_SHRED_FEC_SET_ENCODED_NAME "shred_fec_set_encoded"
+#define FD_METRICS_COUNTER_SHRED_FEC_SET_ENCODED_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_SHRED_FEC_SET_ENCODED_DESC "The number of FEC sets that completed with every data shred received, whose missing parity shreds were regenerated with the encoder"
+#define FD_METRICS_COUNTER_SHRED_FEC_SET_ENCODED_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_SHRED_FEC_SET_RECOVERED_OFF  (113UL)
+#define FD_METRICS_COUNTER_SHRED_FEC_SET_RECOVERED_NAME "shred_fec_set_recovered"
+#define FD_METRICS_COUNTER_SHRED_FEC_SET_RECOVERED_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_SHRED_FEC_SET_RECOVERED_DESC "The number of FEC sets that completed with missing data shreds, which were recovered with the Reed-Solomon decoder"
+#define FD_METRICS_COUNTER_SHRED_FEC_SET_RECOVERED_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_REQUEST_OFF  (114UL)
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_REQUEST_NAME "shred_force_complete_request"
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_REQUEST_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_REQUEST_DESC "The number of times we recieved a FEC force complete message"
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_REQUEST_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_FAILURE_OFF  (113UL)
+#define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_FAILURE_OFF  (115UL)
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_FAILURE_NAME "shred_force_complete_failure"
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_FAILURE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_FAILURE_DESC "The number of times we failed to force complete a FEC set on request"
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_FAILURE_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_SUCCESS_OFF  (114UL)
+#define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_SUCCESS_OFF  (116UL)
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_SUCCESS_NAME "shred_force_complete_success"
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_SUCCESS_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_SUCCESS_DESC "The number of times we successfully forced completed a FEC set on request"
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_SUCCESS_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_SHRED_TOTAL (19UL)
+#define FD_METRICS_SHRED_TOTAL (21UL)
 extern const fd_metrics_meta_t FD_METRICS_SHRED[FD_METRICS_SHRED_TOTAL];
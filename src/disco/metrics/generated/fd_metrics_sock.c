@@ -10,4 +10,10 @@ const fd_metrics_meta_t FD_METRICS_SOCK[FD_METRICS_SOCK_TOTAL] = {
     DECLARE_METRIC( SOCK_TX_BYTES_TOTAL, COUNTER ),
     DECLARE_METRIC( SOCK_RX_BYTES_TOTAL, COUNTER ),
     DECLARE_METRIC( SOCK_TX_PERMISSION_ERROR_CNT, COUNTER ),
+    DECLARE_METRIC( SOCK_TX_GSO_CNT, COUNTER ),
+    DECLARE_METRIC( SOCK_RX_GRO_CNT, COUNTER ),
+    DECLARE_METRIC( SOCK_SYSCALLS_IO_URING_ENTER, COUNTER ),
+    DECLARE_METRIC( SOCK_RX_URING_REARM_CNT, COUNTER ),
+    DECLARE_METRIC_HISTOGRAM_NONE( SOCK_TX_PKTS_PER_SYSCALL ),
+    DECLARE_METRIC_HISTOGRAM_NONE( SOCK_RX_PKTS_PER_SYSCALL ),
 };
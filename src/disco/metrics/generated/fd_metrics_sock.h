@@ -51,5 +51,45 @@
 #define FD_METRICS_COUNTER_SOCK_TX_PERMISSION_ERROR_CNT_DESC "Number of send attempts that failed with EPERM (e.g. due to nftables)"
 #define FD_METRICS_COUNTER_SOCK_TX_PERMISSION_ERROR_CNT_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_SOCK_TOTAL (8UL)
+#define FD_METRICS_COUNTER_SOCK_TX_GSO_CNT_OFF  (24UL)
+#define FD_METRICS_COUNTER_SOCK_TX_GSO_CNT_NAME "sock_tx_gso_cnt"
+#define FD_METRICS_COUNTER_SOCK_TX_GSO_CNT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_SOCK_TX_GSO_CNT_DESC "Number of datagrams sent with UDP generic segmentation offload (carrying more than one packet)"
+#define FD_METRICS_COUNTER_SOCK_TX_GSO_CNT_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_SOCK_RX_GRO_CNT_OFF  (25UL)
+#define FD_METRICS_COUNTER_SOCK_RX_GRO_CNT_NAME "sock_rx_gro_cnt"
+#define FD_METRICS_COUNTER_SOCK_RX_GRO_CNT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_SOCK_RX_GRO_CNT_DESC "Number of datagrams received with UDP generic receive offload (carrying more than one packet)"
+#define FD_METRICS_COUNTER_SOCK_RX_GRO_CNT_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_SOCK_SYSCALLS_IO_URING_ENTER_OFF  (26UL)
+#define FD_METRICS_COUNTER_SOCK_SYSCALLS_IO_URING_ENTER_NAME "sock_syscalls_io_uring_enter"
+#define FD_METRICS_COUNTER_SOCK_SYSCALLS_IO_URING_ENTER_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_SOCK_SYSCALLS_IO_URING_ENTER_DESC "Number of io_uring_enter syscalls dispatched (if io_uring is enabled)"
+#define FD_METRICS_COUNTER_SOCK_SYSCALLS_IO_URING_ENTER_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_SOCK_RX_URING_REARM_CNT_OFF  (27UL)
+#define FD_METRICS_COUNTER_SOCK_RX_URING_REARM_CNT_NAME "sock_rx_uring_rearm_cnt"
+#define FD_METRICS_COUNTER_SOCK_RX_URING_REARM_CNT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_SOCK_RX_URING_REARM_CNT_DESC "Number of times a multishot receive was re-armed (e.g. after running out of receive buffers)"
+#define FD_METRICS_COUNTER_SOCK_RX_URING_REARM_CNT_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_HISTOGRAM_SOCK_TX_PKTS_PER_SYSCALL_OFF  (28UL)
+#define FD_METRICS_HISTOGRAM_SOCK_TX_PKTS_PER_SYSCALL_NAME "sock_tx_pkts_per_syscall"
+#define FD_METRICS_HISTOGRAM_SOCK_TX_PKTS_PER_SYSCALL_TYPE (FD_METRICS_TYPE_HISTOGRAM)
+#define FD_METRICS_HISTOGRAM_SOCK_TX_PKTS_PER_SYSCALL_DESC "Number of packets sent per sendmmsg (or io_uring_enter) syscall"
+#define FD_METRICS_HISTOGRAM_SOCK_TX_PKTS_PER_SYSCALL_CVT  (FD_METRICS_CONVERTER_NONE)
+#define FD_METRICS_HISTOGRAM_SOCK_TX_PKTS_PER_SYSCALL_MIN  (1UL)
+#define FD_METRICS_HISTOGRAM_SOCK_TX_PKTS_PER_SYSCALL_MAX  (64UL)
+
+#define FD_METRICS_HISTOGRAM_SOCK_RX_PKTS_PER_SYSCALL_OFF  (45UL)
+#define FD_METRICS_HISTOGRAM_SOCK_RX_PKTS_PER_SYSCALL_NAME "sock_rx_pkts_per_syscall"
+#define FD_METRICS_HISTOGRAM_SOCK_RX_PKTS_PER_SYSCALL_TYPE (FD_METRICS_TYPE_HISTOGRAM)
+#define FD_METRICS_HISTOGRAM_SOCK_RX_PKTS_PER_SYSCALL_DESC "Number of packets received per recvmmsg (or io_uring_enter) syscall"
+#define FD_METRICS_HISTOGRAM_SOCK_RX_PKTS_PER_SYSCALL_CVT  (FD_METRICS_CONVERTER_NONE)
+#define FD_METRICS_HISTOGRAM_SOCK_RX_PKTS_PER_SYSCALL_MIN  (1UL)
+#define FD_METRICS_HISTOGRAM_SOCK_RX_PKTS_PER_SYSCALL_MAX  (512UL)
+
+#define FD_METRICS_SOCK_TOTAL (14UL)
 extern const fd_metrics_meta_t FD_METRICS_SOCK[FD_METRICS_SOCK_TOTAL];
@@ -1,6 +1,7 @@
 /* Topology support routines for the net tile */
 
 #include "fd_net_tile.h"
+#include "sock/fd_sock_tile.h"
 #include "../topo/fd_topob.h"
 #include "../topo/fd_pod_format.h"
 #include "../netlink/fd_netlink_tile.h"
@@ -32,6 +33,7 @@ setup_xdp_tile( fd_topo_t *             topo,
   tile->net.xdp_rx_queue_size = net_cfg->xdp.xdp_rx_queue_size;
   tile->net.xdp_tx_queue_size = net_cfg->xdp.xdp_tx_queue_size;
   tile->net.zero_copy         = net_cfg->xdp.xdp_zero_copy;
+  tile->net.multi_buffer      = net_cfg->xdp.xdp_multi_buffer;
   fd_memset( tile->net.xdp_mode, 0, 4 );
   fd_memcpy( tile->net.xdp_mode, net_cfg->xdp.xdp_mode, strnlen( net_cfg->xdp.xdp_mode, 3 ) );  /* GCC complains about strncpy */
 
@@ -62,6 +64,12 @@ setup_sock_tile( fd_topo_t *             topo,
   if( FD_UNLIKELY( net_cfg->socket.send_buffer_size   >INT_MAX ) ) FD_LOG_ERR(( "invalid [net.socket.send_buffer_size]" ));
   tile->net.so_rcvbuf = (int)net_cfg->socket.receive_buffer_size;
   tile->net.so_sndbuf = (int)net_cfg->socket.send_buffer_size   ;
+  tile->net.udp_gso   = net_cfg->socket.udp_gso;
+  tile->net.udp_gro   = net_cfg->socket.udp_gro;
+  tile->net.io_uring  = net_cfg->socket.io_uring;
+  if( FD_UNLIKELY( tile->net.io_uring && tile->net.udp_gro ) ) {
+    FD_LOG_ERR(( "[net.socket.io_uring] and [net.socket.udp_gro] cannot be enabled at the same time" ));
+  }
 }
 
 void
@@ -160,7 +168,13 @@ fd_topos_net_rx_link( fd_topo_t *  topo,
     add_xdp_rx_link( topo, link_name, net_kind_id, depth );
     fd_topob_tile_out( topo, "net", net_kind_id, link_name, net_kind_id );
   } else {
-    fd_topob_link( topo, link_name, "net_umem", depth, FD_NET_MTU, 64 );
+    /* With io_uring, the kernel owns up to FD_SOCK_TILE_URING_RX_DEPTH
+       dcache slots at any time in addition to the usual burst */
+    ulong sock_tile_idx = fd_topo_find_tile( topo, "sock", net_kind_id );
+    if( FD_UNLIKELY( sock_tile_idx==ULONG_MAX ) ) FD_LOG_ERR(( "sock tile %lu not found", net_kind_id ));
+    fd_topo_tile_t const * sock_tile = &topo->tiles[ sock_tile_idx ];
+    ulong burst = 64UL + fd_ulong_if( sock_tile->net.io_uring, FD_SOCK_TILE_URING_RX_DEPTH, 0UL );
+    fd_topob_link( topo, link_name, "net_umem", depth, FD_NET_MTU, burst );
     fd_topob_tile_out( topo, "sock", net_kind_id, link_name, net_kind_id );
   }
 }
@@ -3,3 +3,9 @@ ifdef FD_HAS_ALLOCA
 $(call add-objs,fd_sock_tile,fd_disco)
 endif
 endif
+
+ifdef FD_HAS_HOSTED
+ifdef FD_HAS_LINUX
+$(call make-unit-test,bench_sock_uring,bench_sock_uring,fd_waltz fd_util)
+endif
+endif
@@ -0,0 +1,273 @@
+#define _GNU_SOURCE /* sendmmsg, recvmmsg, in_pktinfo */
+
+/* bench_sock_uring compares the two ways the sock tile drives its UDP
+   sockets over loopback:
+
+   - mmsg:     sendmmsg batches on the sender, poll and recvmmsg on the
+               receiver (the default sock tile loop)
+   - io_uring: SENDMSG requests submitted in batches on the sender, a
+               multishot recvmsg with a provided buffer ring on the
+               receiver, drained with one io_uring_enter per poll
+               ([net.socket.io_uring])
+
+   Each iteration sends a batch of packets and then polls until the
+   whole batch was received, like a sock tile serving both directions.
+   Reports throughput and syscalls per packet. */
+
+#include "../../../waltz/uring/fd_io_uring.h"
+#include "../../../util/fd_util.h"
+#include "../../../util/net/fd_ip4.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#define BATCH_MAX   (64UL)
+#define SLOT_SZ     (2048UL)
+#define SLOT_CNT    (1024UL)
+#define CMSG_MAX    (64UL)
+
+static uchar tx_buf  [ BATCH_MAX ][ SLOT_SZ ];
+static uchar rx_slots[ SLOT_CNT  ][ SLOT_SZ ] __attribute__((aligned(64)));
+static uchar rx_cmsg [ BATCH_MAX ][ CMSG_MAX ] __attribute__((aligned(8)));
+static uchar buf_ring_mem[ 16384 ] __attribute__((aligned(FD_IO_URING_BUF_RING_ALIGN)));
+
+static struct sockaddr_in dst;
+static struct iovec       tx_iov[ BATCH_MAX ];
+static struct mmsghdr     tx_msg[ BATCH_MAX ];
+static struct iovec       rx_iov[ BATCH_MAX ];
+static struct sockaddr_in rx_sa [ BATCH_MAX ];
+static struct mmsghdr     rx_msg[ BATCH_MAX ];
+
+/* rx_hdr describes the multishot recvmsg buffer layout (only the name
+   and control lengths are used by the kernel) */
+
+static struct msghdr rx_hdr = {
+  .msg_namelen    = sizeof(struct sockaddr_in),
+  .msg_controllen = CMSG_SPACE( sizeof(struct in_pktinfo) )
+};
+
+static int
+udp_socket_loopback( ushort * port,
+                     int      rcvbuf ) {
+  int fd = socket( AF_INET, SOCK_DGRAM, IPPROTO_UDP );
+  FD_TEST( fd>=0 );
+  int one = 1;
+  FD_TEST( 0==setsockopt( fd, IPPROTO_IP, IP_PKTINFO, &one, sizeof(int) ) );
+  FD_TEST( 0==setsockopt( fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(int) ) );
+  struct sockaddr_in sa = {
+    .sin_family      = AF_INET,
+    .sin_addr.s_addr = FD_IP4_ADDR( 127,0,0,1 ),
+  };
+  FD_TEST( 0==bind( fd, fd_type_pun_const( &sa ), sizeof(struct sockaddr_in) ) );
+  socklen_t sa_sz = sizeof(struct sockaddr_in);
+  FD_TEST( 0==getsockname( fd, fd_type_pun( &sa ), &sa_sz ) );
+  *port = sa.sin_port;
+  return fd;
+}
+
+static void
+tx_msg_init( ulong batch,
+             ulong pkt_sz ) {
+  for( ulong j=0UL; j<batch; j++ ) {
+    tx_iov[ j ] = (struct iovec) { .iov_base = tx_buf[ j ], .iov_len = pkt_sz };
+    tx_msg[ j ].msg_hdr = (struct msghdr) {
+      .msg_name    = &dst,
+      .msg_namelen = sizeof(struct sockaddr_in),
+      .msg_iov     = tx_iov+j,
+      .msg_iovlen  = 1
+    };
+  }
+}
+
+/* bench_mmsg returns the number of packets received */
+
+static ulong
+bench_mmsg( int     tx_fd,
+            int     rx_fd,
+            ulong   iter_cnt,
+            ulong   batch,
+            ulong * syscall_cnt ) {
+  struct pollfd pfd = { .fd = rx_fd, .events = POLLIN };
+  ulong rx_cnt = 0UL;
+  ulong sys    = 0UL;
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    int sent = sendmmsg( tx_fd, tx_msg, (uint)batch, MSG_DONTWAIT ); sys++;
+    FD_TEST( sent==(int)batch );
+
+    ulong got = 0UL;
+    while( got<batch ) {
+      FD_TEST( poll( &pfd, 1, 0 )>=0 ); sys++;
+      if( !( pfd.revents & POLLIN ) ) continue;
+      for( ulong j=0UL; j<BATCH_MAX; j++ ) {
+        uchar * slot = rx_slots[ ( rx_cnt+got+j ) % SLOT_CNT ];
+        rx_iov[ j ] = (struct iovec) { .iov_base = slot+64UL, .iov_len = SLOT_SZ-64UL };
+        rx_msg[ j ].msg_hdr = (struct msghdr) {
+          .msg_iov        = rx_iov+j,
+          .msg_iovlen     = 1,
+          .msg_name       = rx_sa+j,
+          .msg_namelen    = sizeof(struct sockaddr_in),
+          .msg_control    = rx_cmsg[ j ],
+          .msg_controllen = CMSG_MAX
+        };
+      }
+      int msg_cnt = recvmmsg( rx_fd, rx_msg, BATCH_MAX, MSG_DONTWAIT, NULL ); sys++;
+      if( msg_cnt<0 ) { FD_TEST( errno==EAGAIN ); continue; }
+      got += (ulong)msg_cnt;
+    }
+    rx_cnt += got;
+  }
+  *syscall_cnt = sys;
+  return rx_cnt;
+}
+
+static void
+rx_provide( fd_io_uring_buf_ring_t * br,
+            ulong *                  slot_next,
+            uint                     cnt ) {
+  for( uint j=0U; j<cnt; j++ ) {
+    ulong slot = (*slot_next)++ % SLOT_CNT;
+    fd_io_uring_buf_ring_add( br, rx_slots[ slot ], (uint)SLOT_SZ, (ushort)slot, j );
+  }
+  fd_io_uring_buf_ring_advance( br, cnt );
+}
+
+static void
+rx_arm( fd_io_uring_t *       ring,
+        int                   rx_fd,
+        struct msghdr const * msg ) {
+  struct io_uring_sqe * sqe = fd_io_uring_sqe_acquire( ring );
+  FD_TEST( sqe );
+  sqe->opcode    = IORING_OP_RECVMSG;
+  sqe->fd        = rx_fd;
+  sqe->addr      = (ulong)msg;
+  sqe->len       = 1U;
+  sqe->ioprio    = IORING_RECV_MULTISHOT;
+  sqe->flags     = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = 0;
+}
+
+static ulong
+bench_uring( fd_io_uring_t *          tx_ring,
+             fd_io_uring_t *          rx_ring,
+             fd_io_uring_buf_ring_t * br,
+             ulong *                  slot_next,
+             int                      tx_fd,
+             int                      rx_fd,
+             ulong                    iter_cnt,
+             ulong                    batch,
+             ulong *                  syscall_cnt ) {
+  ulong rx_cnt = 0UL;
+  ulong sys    = 0UL;
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    for( ulong j=0UL; j<batch; j++ ) {
+      struct io_uring_sqe * sqe = fd_io_uring_sqe_acquire( tx_ring );
+      FD_TEST( sqe );
+      sqe->opcode    = IORING_OP_SENDMSG;
+      sqe->fd        = tx_fd;
+      sqe->addr      = (ulong)&tx_msg[ j ].msg_hdr;
+      sqe->len       = 1U;
+      sqe->msg_flags = MSG_DONTWAIT;
+    }
+    FD_TEST( fd_io_uring_submit( tx_ring, (uint)batch )==(int)batch ); sys++;
+    uint tx_cqe_cnt = fd_io_uring_cq_ready( tx_ring );
+    for( uint j=0U; j<tx_cqe_cnt; j++ ) FD_TEST( fd_io_uring_cqe( tx_ring, j )->res>0 );
+    fd_io_uring_cq_advance( tx_ring, tx_cqe_cnt );
+
+    ulong got = 0UL;
+    while( got<batch ) {
+      if( !fd_io_uring_cq_ready( rx_ring ) ) {
+        FD_TEST( fd_io_uring_submit( rx_ring, 0U )>=0 );
+        FD_TEST( fd_io_uring_enter( rx_ring, 0U, 0U, IORING_ENTER_GETEVENTS )>=0 ); sys++;
+      }
+      uint cqe_cnt = fd_io_uring_cq_ready( rx_ring );
+      uint buf_cnt = 0U;
+      for( uint j=0U; j<cqe_cnt; j++ ) {
+        struct io_uring_cqe const * cqe = fd_io_uring_cqe( rx_ring, j );
+        if( cqe->flags & IORING_CQE_F_BUFFER ) {
+          buf_cnt++;
+          if( cqe->res>0 ) got++;
+        }
+        if( !( cqe->flags & IORING_CQE_F_MORE ) ) rx_arm( rx_ring, rx_fd, &rx_hdr );
+      }
+      fd_io_uring_cq_advance( rx_ring, cqe_cnt );
+      if( buf_cnt ) rx_provide( br, slot_next, buf_cnt );
+    }
+    rx_cnt += got;
+  }
+  *syscall_cnt = sys;
+  return rx_cnt;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong iter_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter",    NULL, 20000UL );
+  ulong batch    = fd_env_strip_cmdline_ulong( &argc, &argv, "--batch",   NULL,    64UL );
+  ulong pkt_sz   = fd_env_strip_cmdline_ulong( &argc, &argv, "--pkt-sz",  NULL,  1200UL );
+
+  if( FD_UNLIKELY( !batch || batch>BATCH_MAX           ) ) FD_LOG_ERR(( "--batch must be in [1,%lu]", BATCH_MAX ));
+  if( FD_UNLIKELY( !pkt_sz || pkt_sz>SLOT_SZ-64UL      ) ) FD_LOG_ERR(( "--pkt-sz must be in [1,%lu]", SLOT_SZ-64UL ));
+
+  ushort tx_port; int tx_fd = udp_socket_loopback( &tx_port, 1<<20 );
+  ushort rx_port; int rx_fd = udp_socket_loopback( &rx_port, 1<<24 );
+  dst = (struct sockaddr_in) {
+    .sin_family      = AF_INET,
+    .sin_addr.s_addr = FD_IP4_ADDR( 127,0,0,1 ),
+    .sin_port        = rx_port
+  };
+  tx_msg_init( batch, pkt_sz );
+
+  FD_LOG_NOTICE(( "%lu iterations of %lu packets of %lu bytes", iter_cnt, batch, pkt_sz ));
+
+  /* mmsg */
+
+  ulong sys_cnt;
+  bench_mmsg( tx_fd, rx_fd, iter_cnt/10UL+1UL, batch, &sys_cnt ); /* warmup */
+  long  dt_mmsg  = -fd_log_wallclock();
+  ulong pkt_mmsg = bench_mmsg( tx_fd, rx_fd, iter_cnt, batch, &sys_cnt );
+  dt_mmsg += fd_log_wallclock();
+  FD_LOG_NOTICE(( "mmsg:     %8.3f Mpkt/s  %7.1f ns/pkt  %.3f syscalls/pkt",
+                  (double)pkt_mmsg*1e3/(double)dt_mmsg, (double)dt_mmsg/(double)pkt_mmsg,
+                  (double)sys_cnt/(double)pkt_mmsg ));
+
+  /* io_uring */
+
+  uint setup_flags = IORING_SETUP_SUBMIT_ALL | IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+  fd_io_uring_params_t tx_params = { .sq_depth = (uint)BATCH_MAX, .cq_depth = 2U*(uint)BATCH_MAX, .flags = setup_flags };
+  fd_io_uring_params_t rx_params = { .sq_depth = 8U,              .cq_depth = (uint)SLOT_CNT,     .flags = setup_flags };
+  fd_io_uring_t tx_ring[1];
+  fd_io_uring_t rx_ring[1];
+  if( FD_UNLIKELY( !fd_io_uring_init( tx_ring, &tx_params ) || !fd_io_uring_init( rx_ring, &rx_params ) ) ) {
+    FD_LOG_WARNING(( "skip: io_uring unavailable" ));
+    fd_halt();
+    return 0;
+  }
+  fd_io_uring_buf_ring_t br[1];
+  FD_TEST( fd_io_uring_buf_ring_footprint( SLOT_CNT )<=sizeof(buf_ring_mem) );
+  FD_TEST( fd_io_uring_buf_ring_register( rx_ring, br, buf_ring_mem, SLOT_CNT, 0 ) );
+  ulong slot_next = 0UL;
+  rx_provide( br, &slot_next, (uint)SLOT_CNT );
+  rx_arm( rx_ring, rx_fd, &rx_hdr );
+
+  bench_uring( tx_ring, rx_ring, br, &slot_next, tx_fd, rx_fd, iter_cnt/10UL+1UL, batch, &sys_cnt ); /* warmup */
+  long  dt_uring  = -fd_log_wallclock();
+  ulong pkt_uring = bench_uring( tx_ring, rx_ring, br, &slot_next, tx_fd, rx_fd, iter_cnt, batch, &sys_cnt );
+  dt_uring += fd_log_wallclock();
+  FD_LOG_NOTICE(( "io_uring: %8.3f Mpkt/s  %7.1f ns/pkt  %.3f syscalls/pkt",
+                  (double)pkt_uring*1e3/(double)dt_uring, (double)dt_uring/(double)pkt_uring,
+                  (double)sys_cnt/(double)pkt_uring ));
+
+  fd_io_uring_fini( rx_ring );
+  fd_io_uring_fini( tx_ring );
+  FD_TEST( 0==close( rx_fd ) );
+  FD_TEST( 0==close( tx_fd ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
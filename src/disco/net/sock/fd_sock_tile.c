@@ -1,4 +1,5 @@
 #define _GNU_SOURCE /* dup3 */
+#include "fd_sock_tile.h"
 #include "fd_sock_tile_private.h"
 #include "../../topo/fd_topo.h"
 #include "../../../util/net/fd_eth.h"
@@ -11,6 +12,7 @@
 #include <fcntl.h> /* fcntl */
 #include <unistd.h> /* dup3, close */
 #include <netinet/in.h> /* sockaddr_in */
+#include <netinet/udp.h> /* UDP_SEGMENT, UDP_GRO */
 #include <sys/socket.h> /* socket */
 #include "generated/sock_seccomp.h"
 #include "../../metrics/fd_metrics.h"
@@ -23,9 +25,16 @@
 /* Place RX socket file descriptors in contiguous integer range. */
 #define RX_SOCK_FD_MIN (128)
 
-/* Controls max ancillary data size.
-   Must be aligned by alignof(struct cmsghdr) */
-#define FD_SOCK_CMSG_MAX (64UL)
+/* Max number of UDP segments in a GSO datagram (UDP_MAX_SEGMENTS of
+   older kernels) */
+#define FD_SOCK_GSO_SEG_MAX (64UL)
+
+/* Max UDP payload size of a GSO datagram */
+#define FD_SOCK_UDP_PAYLOAD_MAX (65507UL)
+
+/* Number of chunks spanned by an RX dcache slot (see
+   fd_dcache_compact_next) */
+#define RX_SLOT_CHUNK_CNT ( ( ( FD_NET_MTU+2UL*FD_CHUNK_SZ-1UL ) >> (1+FD_CHUNK_LG_SZ) ) << 1 )
 
 static ulong
 populate_allowed_seccomp( fd_topo_t const *      topo,
@@ -34,7 +43,8 @@ populate_allowed_seccomp( fd_topo_t const *      topo,
                           struct sock_filter *   out ) {
   FD_SCRATCH_ALLOC_INIT( l, fd_topo_obj_laddr( topo, tile->tile_obj_id ) );
   fd_sock_tile_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_sock_tile_t), sizeof(fd_sock_tile_t) );
-  populate_sock_filter_policy_sock( out_cnt, out, (uint)fd_log_private_logfile_fd(), (uint)ctx->tx_sock, RX_SOCK_FD_MIN, RX_SOCK_FD_MIN+(uint)ctx->sock_cnt );
+  populate_sock_filter_policy_sock( out_cnt, out, (uint)fd_log_private_logfile_fd(), (uint)ctx->tx_sock, RX_SOCK_FD_MIN, RX_SOCK_FD_MIN+(uint)ctx->sock_cnt,
+                                    (uint)ctx->rx_ring->ring_fd, (uint)ctx->tx_ring->ring_fd );
   return sock_filter_policy_sock_instr_cnt;
 }
 
@@ -48,7 +58,7 @@ populate_allowed_fds( fd_topo_t const *      topo,
   fd_sock_tile_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_sock_tile_t), sizeof(fd_sock_tile_t) );
 
   ulong sock_cnt = ctx->sock_cnt;
-  if( FD_UNLIKELY( out_fds_cnt<sock_cnt+3UL ) ) {
+  if( FD_UNLIKELY( out_fds_cnt<sock_cnt+5UL ) ) {
     FD_LOG_ERR(( "out_fds_cnt %lu", out_fds_cnt ));
   }
 
@@ -62,6 +72,10 @@ populate_allowed_fds( fd_topo_t const *      topo,
   for( ulong j=0UL; j<sock_cnt; j++ ) {
     out_fds[ out_cnt++ ] = ctx->pollfd[ j ].fd;
   }
+  if( ctx->uring_enabled ) {
+    out_fds[ out_cnt++ ] = ctx->rx_ring->ring_fd;
+    out_fds[ out_cnt++ ] = ctx->tx_ring->ring_fd;
+  }
   return out_cnt;
 }
 
@@ -76,7 +90,7 @@ scratch_align( void ) {
 }
 
 FD_FN_PURE static inline ulong
-scratch_footprint( fd_topo_tile_t const * tile FD_PARAM_UNUSED ) {
+scratch_footprint( fd_topo_tile_t const * tile ) {
   ulong l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, alignof(fd_sock_tile_t),     sizeof(fd_sock_tile_t)                );
   l = FD_LAYOUT_APPEND( l, alignof(struct iovec),       STEM_BURST*sizeof(struct iovec)       );
@@ -84,6 +98,13 @@ scratch_footprint( fd_topo_tile_t const * tile FD_PARAM_UNUSED ) {
   l = FD_LAYOUT_APPEND( l, alignof(struct sockaddr_in), STEM_BURST*sizeof(struct sockaddr_in) );
   l = FD_LAYOUT_APPEND( l, alignof(struct mmsghdr),     STEM_BURST*sizeof(struct mmsghdr)     );
   l = FD_LAYOUT_APPEND( l, FD_CHUNK_ALIGN,              tx_scratch_footprint()                );
+  l = FD_LAYOUT_APPEND( l, alignof(struct iovec),       STEM_BURST*sizeof(struct iovec)       );
+  if( tile->net.udp_gro ) {
+    l = FD_LAYOUT_APPEND( l, FD_CHUNK_ALIGN, FD_SOCK_GRO_MSG_MAX*FD_SOCK_GRO_BUF_SZ );
+  }
+  if( tile->net.io_uring ) {
+    l = FD_LAYOUT_APPEND( l, FD_IO_URING_BUF_RING_ALIGN, MAX_NET_OUTS*fd_io_uring_buf_ring_footprint( FD_SOCK_TILE_URING_RX_DEPTH ) );
+  }
   return FD_LAYOUT_FINI( l, scratch_align() );
 }
 
@@ -94,7 +115,10 @@ static void
 create_udp_socket( int    sock_fd,
                    uint   bind_addr,
                    ushort udp_port,
-                   int    so_rcvbuf ) {
+                   int    so_rcvbuf,
+                   int    so_sndbuf,
+                   int    udp_gso,
+                   int    udp_gro ) {
 
   if( fcntl( sock_fd, F_GETFD, 0 )!=-1 ) {
     FD_LOG_ERR(( "file descriptor %d already exists", sock_fd ));
@@ -121,6 +145,26 @@ create_udp_socket( int    sock_fd,
     FD_LOG_ERR(( "setsockopt(SOL_SOCKET,SO_RCVBUF,%i) failed (%i-%s)", so_rcvbuf, errno, fd_io_strerror( errno ) ));
   }
 
+  if( udp_gso ) {
+    /* With GSO, packets are sent through this socket.  The segment size
+       is set per datagram, setting the default to 0 (no segmentation)
+       checks that the kernel supports UDP_SEGMENT. */
+    if( FD_UNLIKELY( 0!=setsockopt( orig_fd, SOL_SOCKET, SO_SNDBUF, &so_sndbuf, sizeof(int) ) ) ) {
+      FD_LOG_ERR(( "setsockopt(SOL_SOCKET,SO_SNDBUF,%i) failed (%i-%s)", so_sndbuf, errno, fd_io_strerror( errno ) ));
+    }
+    int gso_size = 0;
+    if( FD_UNLIKELY( 0!=setsockopt( orig_fd, SOL_UDP, UDP_SEGMENT, &gso_size, sizeof(int) ) ) ) {
+      FD_LOG_ERR(( "setsockopt(SOL_UDP,UDP_SEGMENT,0) failed (%i-%s), disable [net.socket.udp_gso]", errno, fd_io_strerror( errno ) ));
+    }
+  }
+
+  if( udp_gro ) {
+    int gro = 1;
+    if( FD_UNLIKELY( 0!=setsockopt( orig_fd, SOL_UDP, UDP_GRO, &gro, sizeof(int) ) ) ) {
+      FD_LOG_ERR(( "setsockopt(SOL_UDP,UDP_GRO,1) failed (%i-%s), disable [net.socket.udp_gro]", errno, fd_io_strerror( errno ) ));
+    }
+  }
+
   struct sockaddr_in saddr = {
     .sin_family      = AF_INET,
     .sin_addr.s_addr = bind_addr,
@@ -145,6 +189,76 @@ create_udp_socket( int    sock_fd,
 
 }
 
+/* privileged_init_uring creates the RX and TX io_uring instances and
+   registers an (empty) provided buffer ring for each RX link.  Buffer
+   group IDs are RX link indexes.
+
+   The sandbox allows io_uring_enter on both rings, which would
+   otherwise run any request (open, connect, ...) the tile writes into
+   the SQ.  The rings are therefore created disabled, restricted to the
+   requests the tile actually submits, and only then enabled:
+
+   - RX ring: IORING_OP_RECVMSG with IOSQE_BUFFER_SELECT
+   - TX ring: IORING_OP_SENDMSG without flags
+   - no io_uring_register opcodes (buffer rings are registered here,
+     buffers are provided through shared memory afterwards) */
+
+static void
+privileged_init_uring( fd_sock_tile_t *       ctx,
+                       fd_topo_tile_t const * tile,
+                       uchar *                buf_ring_mem ) {
+  if( FD_UNLIKELY( tile->out_cnt > MAX_NET_OUTS ) ) {
+    FD_LOG_ERR(( "sock tile has %lu out links which exceeds the max (%lu)", tile->out_cnt, MAX_NET_OUTS ));
+  }
+
+  /* Receives and sends are only processed when the tile calls
+     io_uring_enter (IORING_SETUP_DEFER_TASKRUN), so the kernel never
+     interrupts the tile to post completions. */
+  uint setup_flags = IORING_SETUP_SUBMIT_ALL | IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN | IORING_SETUP_R_DISABLED;
+
+  fd_io_uring_params_t rx_params = {
+    .sq_depth = 2U*FD_SOCK_TILE_MAX_SOCKETS,
+    .cq_depth = (uint)( MAX_NET_OUTS*FD_SOCK_TILE_URING_RX_DEPTH ),
+    .flags    = setup_flags
+  };
+  fd_io_uring_params_t tx_params = {
+    .sq_depth = (uint)STEM_BURST,
+    .cq_depth = (uint)( 2UL*STEM_BURST ),
+    .flags    = setup_flags
+  };
+  if( FD_UNLIKELY( !fd_io_uring_init( ctx->rx_ring, &rx_params ) ||
+                   !fd_io_uring_init( ctx->tx_ring, &tx_params ) ) ) {
+    FD_LOG_ERR(( "failed to create io_uring instance, disable [net.socket.io_uring]" ));
+  }
+
+  ulong buf_ring_footprint = fd_io_uring_buf_ring_footprint( FD_SOCK_TILE_URING_RX_DEPTH );
+  for( ulong j=0UL; j<(tile->out_cnt); j++ ) {
+    if( FD_UNLIKELY( !fd_io_uring_buf_ring_register( ctx->rx_ring, ctx->rx_buf_ring+j, buf_ring_mem + j*buf_ring_footprint,
+                                                     FD_SOCK_TILE_URING_RX_DEPTH, (ushort)j ) ) ) {
+      FD_LOG_ERR(( "failed to register io_uring buffer ring, disable [net.socket.io_uring]" ));
+    }
+  }
+
+  uchar const rx_op[1] = { IORING_OP_RECVMSG };
+  uchar const tx_op[1] = { IORING_OP_SENDMSG };
+  if( FD_UNLIKELY( !fd_io_uring_restrict( ctx->rx_ring, rx_op, 1UL, IOSQE_BUFFER_SELECT, NULL, 0UL ) ||
+                   !fd_io_uring_restrict( ctx->tx_ring, tx_op, 1UL, 0,                   NULL, 0UL ) ||
+                   !fd_io_uring_enable  ( ctx->rx_ring ) ||
+                   !fd_io_uring_enable  ( ctx->tx_ring ) ) ) {
+    FD_LOG_ERR(( "failed to restrict io_uring instance, disable [net.socket.io_uring]" ));
+  }
+
+  /* Datagrams are received as io_uring_recvmsg_out, source address,
+     IP_PKTINFO, payload */
+  FD_STATIC_ASSERT( sizeof(struct io_uring_recvmsg_out)+sizeof(struct sockaddr_in)+CMSG_SPACE( sizeof(struct in_pktinfo) )==FD_SOCK_URING_RX_HDR_SZ, layout );
+  ctx->rx_uring_msg = (struct msghdr) {
+    .msg_namelen    = sizeof(struct sockaddr_in),
+    .msg_controllen = CMSG_SPACE( sizeof(struct in_pktinfo) )
+  };
+
+  ctx->uring_enabled = 1;
+}
+
 static void
 privileged_init( fd_topo_t *      topo,
                  fd_topo_tile_t * tile ) {
@@ -156,6 +270,15 @@ privileged_init( fd_topo_t *      topo,
   struct sockaddr_in * batch_sa   = FD_SCRATCH_ALLOC_APPEND( l, alignof(struct sockaddr_in), STEM_BURST*sizeof(struct sockaddr_in) );
   struct mmsghdr *     batch_msg  = FD_SCRATCH_ALLOC_APPEND( l, alignof(struct mmsghdr),     STEM_BURST*sizeof(struct mmsghdr)     );
   uchar *              tx_scratch = FD_SCRATCH_ALLOC_APPEND( l, FD_CHUNK_ALIGN,              tx_scratch_footprint()                );
+  struct iovec   *     gso_iov    = FD_SCRATCH_ALLOC_APPEND( l, alignof(struct iovec),       STEM_BURST*sizeof(struct iovec)       );
+  uchar *              gro_buf    = NULL;
+  if( tile->net.udp_gro ) {
+    gro_buf = FD_SCRATCH_ALLOC_APPEND( l, FD_CHUNK_ALIGN, FD_SOCK_GRO_MSG_MAX*FD_SOCK_GRO_BUF_SZ );
+  }
+  uchar *              buf_ring_mem = NULL;
+  if( tile->net.io_uring ) {
+    buf_ring_mem = FD_SCRATCH_ALLOC_APPEND( l, FD_IO_URING_BUF_RING_ALIGN, MAX_NET_OUTS*fd_io_uring_buf_ring_footprint( FD_SOCK_TILE_URING_RX_DEPTH ) );
+  }
 
   assert( scratch==ctx );
 
@@ -172,6 +295,17 @@ privileged_init( fd_topo_t *      topo,
   ctx->tx_scratch0 = tx_scratch;
   ctx->tx_scratch1 = tx_scratch + tx_scratch_footprint();
   ctx->tx_ptr      = tx_scratch;
+  ctx->gso_enabled = tile->net.udp_gso;
+  ctx->gso_iov     = gso_iov;
+  ctx->gro_enabled = tile->net.udp_gro;
+  ctx->gro_buf     = gro_buf;
+  ctx->rx_ring->ring_fd = -1;
+  ctx->tx_ring->ring_fd = -1;
+
+  fd_histf_join( fd_histf_new( ctx->metrics.tx_pkts_per_syscall, FD_MHIST_MIN( SOCK, TX_PKTS_PER_SYSCALL ),
+                                                                  FD_MHIST_MAX( SOCK, TX_PKTS_PER_SYSCALL ) ) );
+  fd_histf_join( fd_histf_new( ctx->metrics.rx_pkts_per_syscall, FD_MHIST_MIN( SOCK, RX_PKTS_PER_SYSCALL ),
+                                                                  FD_MHIST_MAX( SOCK, RX_PKTS_PER_SYSCALL ) ) );
 
   /* Create receive sockets.  Incrementally assign them to file
      descriptors starting at sock_fd_min. */
@@ -222,7 +356,8 @@ privileged_init( fd_topo_t *      topo,
     }
 
     int sock_fd = sock_fd_min + (int)sock_idx;
-    create_udp_socket( sock_fd, tile->net.bind_address, port, tile->net.so_rcvbuf );
+    create_udp_socket( sock_fd, tile->net.bind_address, port, tile->net.so_rcvbuf,
+                       tile->net.so_sndbuf, tile->net.udp_gso, tile->net.udp_gro );
     ctx->pollfd[ sock_idx ].fd     = sock_fd;
     ctx->pollfd[ sock_idx ].events = POLLIN;
     ctx->sock_cnt++;
@@ -242,6 +377,63 @@ privileged_init( fd_topo_t *      topo,
   ctx->tx_sock      = tx_sock;
   ctx->bind_address = tile->net.bind_address;
 
+  if( tile->net.io_uring ) {
+    privileged_init_uring( ctx, tile, buf_ring_mem );
+  }
+
+}
+
+/* rx_uring_provide hands the next cnt dcache slots of RX link rx_link
+   to the kernel.  Slots are provided in dcache order, and the kernel
+   consumes them in the order provided, so RX frags are written into
+   the dcache in the usual compact ring order.  The buffer ID of a slot
+   is its index in the dcache. */
+
+static void
+rx_uring_provide( fd_sock_tile_t * ctx,
+                  ulong            rx_link,
+                  uint             cnt ) {
+  fd_sock_link_rx_t *      link     = ctx->link_rx     + rx_link;
+  fd_io_uring_buf_ring_t * buf_ring = ctx->rx_buf_ring + rx_link;
+  ulong chunk = link->chunk;
+  for( uint j=0U; j<cnt; j++ ) {
+    ushort bid = (ushort)( ( chunk - link->chunk0 ) / RX_SLOT_CHUNK_CNT );
+    fd_io_uring_buf_ring_add( buf_ring, fd_chunk_to_laddr( link->base, chunk ), (uint)FD_NET_MTU, bid, j );
+    chunk = fd_dcache_compact_next( chunk, FD_NET_MTU, link->chunk0, link->wmark );
+  }
+  fd_io_uring_buf_ring_advance( buf_ring, cnt );
+  link->chunk = chunk;
+}
+
+/* rx_uring_arm submits a multishot recvmsg request for every socket
+   in the rx_uring_rearm set.  A multishot request terminates when it
+   runs out of provided buffers, so this is also called after buffers
+   were handed back to the kernel. */
+
+static void
+rx_uring_arm( fd_sock_tile_t * ctx ) {
+  uint rearm = ctx->rx_uring_rearm;
+  while( rearm ) {
+    uint sock_idx = (uint)fd_uint_find_lsb( rearm );
+    rearm = fd_uint_pop_lsb( rearm );
+    struct io_uring_sqe * sqe = fd_io_uring_sqe_acquire( ctx->rx_ring );
+    if( FD_UNLIKELY( !sqe ) ) break; /* retried on next poll */
+    sqe->opcode    = IORING_OP_RECVMSG;
+    sqe->fd        = ctx->pollfd[ sock_idx ].fd;
+    sqe->addr      = (ulong)&ctx->rx_uring_msg;
+    sqe->len       = 1U;
+    sqe->ioprio    = IORING_RECV_MULTISHOT;
+    sqe->flags     = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = ctx->rx_buf_ring[ ctx->link_rx_map[ sock_idx ] ].bgid;
+    sqe->user_data = sock_idx;
+    ctx->rx_uring_rearm &= ~( 1U<<sock_idx );
+    ctx->metrics.rx_uring_rearm_cnt++;
+  }
+  int res = fd_io_uring_submit( ctx->rx_ring, 0U );
+  ctx->metrics.sys_io_uring_enter_cnt++;
+  if( FD_UNLIKELY( res<0 ) ) {
+    FD_LOG_ERR(( "io_uring_enter failed (%i-%s)", -res, fd_io_strerror( -res ) ));
+  }
 }
 
 static void
@@ -266,6 +458,28 @@ unprivileged_init( fd_topo_t *      topo,
       FD_LOG_ERR(( "link %lu dcache burst is too low (%lu<%lu)",
                    tile->out_link_id[ i ], link->burst, STEM_BURST ));
     }
+
+    if( ctx->uring_enabled ) {
+      /* Frames received with io_uring start at a small offset into the
+         slot (published via ctl), so the last slot is not used to keep
+         frames within the bounds expected by consumers. */
+      ctx->link_rx[ i ].wmark -= RX_SLOT_CHUNK_CNT;
+      ulong slot_cnt = ( ctx->link_rx[ i ].wmark - ctx->link_rx[ i ].chunk0 ) / RX_SLOT_CHUNK_CNT + 1UL;
+      if( FD_UNLIKELY( link->burst < STEM_BURST+FD_SOCK_TILE_URING_RX_DEPTH ) ) {
+        FD_LOG_ERR(( "link %lu dcache burst is too low for io_uring (%lu<%lu)",
+                     tile->out_link_id[ i ], link->burst, STEM_BURST+FD_SOCK_TILE_URING_RX_DEPTH ));
+      }
+      if( FD_UNLIKELY( slot_cnt > USHORT_MAX+1UL ) ) {
+        FD_LOG_ERR(( "link %lu dcache is too large for io_uring (%lu slots)", tile->out_link_id[ i ], slot_cnt ));
+      }
+      rx_uring_provide( ctx, i, (uint)FD_SOCK_TILE_URING_RX_DEPTH );
+    }
+  }
+
+  if( ctx->uring_enabled ) {
+    ctx->rx_uring_rearm = (uint)fd_uint_mask_lsb( (int)ctx->sock_cnt );
+    rx_uring_arm( ctx );
+    ctx->metrics.rx_uring_rearm_cnt = 0UL;
   }
 
   for( ulong i=0UL; i<(tile->in_cnt); i++ ) {
@@ -285,6 +499,40 @@ unprivileged_init( fd_topo_t *      topo,
 /* FIXME Pace RX polling and interleave it with TX jobs to reduce TX
          tail latency */
 
+/* rx_frame_hdr_init writes the Ethernet, IPv4 and UDP headers in front
+   of a received UDP payload, such that consumers see the same frame
+   layout as with the XDP tile.  Returns a pointer to the first byte of
+   the frame. */
+
+static inline uchar *
+rx_frame_hdr_init( uchar *                    payload,
+                   ulong                      payload_sz,
+                   struct sockaddr_in const * sa,
+                   uint                       daddr,
+                   ushort                     dport ) {
+  fd_eth_hdr_t * eth_hdr = (fd_eth_hdr_t *)( payload-42UL );
+  fd_ip4_hdr_t * ip_hdr  = (fd_ip4_hdr_t *)( payload-28UL );
+  fd_udp_hdr_t * udp_hdr = (fd_udp_hdr_t *)( payload- 8UL );
+  memset( eth_hdr->dst, 0, 6 );
+  memset( eth_hdr->src, 0, 6 );
+  eth_hdr->net_type = fd_ushort_bswap( FD_ETH_HDR_TYPE_IP );
+  *ip_hdr = (fd_ip4_hdr_t) {
+    .verihl      = FD_IP4_VERIHL( 4, 5 ),
+    .net_tot_len = fd_ushort_bswap( (ushort)( payload_sz+28UL ) ),
+    .ttl         = 1,
+    .protocol    = FD_IP4_HDR_PROTOCOL_UDP,
+  };
+  memcpy( ip_hdr->saddr_c, &sa->sin_addr.s_addr, 4 );
+  memcpy( ip_hdr->daddr_c, &daddr,               4 );
+  *udp_hdr = (fd_udp_hdr_t) {
+    .net_sport = sa->sin_port,
+    .net_dport = (ushort)fd_ushort_bswap( (ushort)dport ),
+    .net_len   = (ushort)fd_ushort_bswap( (ushort)( payload_sz+8UL ) ),
+    .check     = 0
+  };
+  return (uchar *)eth_hdr;
+}
+
 /* poll_rx_socket does one recvmmsg batch receive on the given socket
    index.  Returns the number of packets returned by recvmmsg. */
 
@@ -334,6 +582,7 @@ poll_rx_socket( fd_sock_tile_t *    ctx,
   ctx->metrics.sys_recvmmsg_cnt++;
 
   if( FD_UNLIKELY( msg_cnt==0 ) ) return 0UL;
+  fd_histf_sample( ctx->metrics.rx_pkts_per_syscall, (ulong)msg_cnt );
 
   /* Track the chunk index of the last frag populated, so we can derive
      the chunk indexes for the next poll_rx_socket call.
@@ -369,30 +618,10 @@ poll_rx_socket( fd_sock_tile_t *    ctx,
       FD_LOG_ERR(( "Missing IP_PKTINFO on incoming packet" ));
     }
 
-    fd_eth_hdr_t * eth_hdr    = (fd_eth_hdr_t *)( payload-42UL );
-    fd_ip4_hdr_t * ip_hdr     = (fd_ip4_hdr_t *)( payload-28UL );
-    fd_udp_hdr_t * udp_hdr    = (fd_udp_hdr_t *)( payload- 8UL );
-    memset( eth_hdr->dst, 0, 6 );
-    memset( eth_hdr->src, 0, 6 );
-    eth_hdr->net_type = fd_ushort_bswap( FD_ETH_HDR_TYPE_IP );
-    *ip_hdr = (fd_ip4_hdr_t) {
-      .verihl      = FD_IP4_VERIHL( 4, 5 ),
-      .net_tot_len = fd_ushort_bswap( (ushort)( payload_sz+28UL ) ),
-      .ttl         = 1,
-      .protocol    = FD_IP4_HDR_PROTOCOL_UDP,
-    };
-    uint daddr_ = (uint)(ulong)daddr;
-    memcpy( ip_hdr->saddr_c, &sa->sin_addr.s_addr, 4 );
-    memcpy( ip_hdr->daddr_c, &daddr_,              4 );
-    *udp_hdr = (fd_udp_hdr_t) {
-      .net_sport = sa->sin_port,
-      .net_dport = (ushort)fd_ushort_bswap( (ushort)dport ),
-      .net_len   = (ushort)fd_ushort_bswap( (ushort)( payload_sz+8UL ) ),
-      .check     = 0
-    };
+    uchar * frame = rx_frame_hdr_init( payload, payload_sz, sa, (uint)(ulong)daddr, dport );
 
     ctx->metrics.rx_pkt_cnt++;
-    ulong chunk = fd_laddr_to_chunk( base, eth_hdr );
+    ulong chunk = fd_laddr_to_chunk( base, frame );
     ulong sig   = fd_disco_netmux_sig( sa->sin_addr.s_addr, fd_ushort_bswap( sa->sin_port ), 0U, proto, hdr_sz );
     ulong tspub = fd_frag_meta_ts_comp( ts );
     fd_stem_publish( stem, rx_link, sig, chunk, frame_sz, 0UL, 0UL, tspub );
@@ -404,6 +633,268 @@ poll_rx_socket( fd_sock_tile_t *    ctx,
   return (ulong)msg_cnt;
 }
 
+/* poll_rx_gro_publish publishes up to burst_max frags from the pending
+   batch of GRO datagrams, splitting coalesced datagrams into individual
+   UDP segments.  Returns the number of frags published. */
+
+static ulong
+poll_rx_gro_publish( fd_sock_tile_t *    ctx,
+                     fd_stem_context_t * stem,
+                     ulong               burst_max ) {
+  ulong  hdr_sz      = sizeof(fd_eth_hdr_t) + sizeof(fd_ip4_hdr_t) + sizeof(fd_udp_hdr_t);
+  ulong  payload_max = FD_NET_MTU-hdr_sz;
+  uint   sock_idx    = ctx->gro_sock_idx;
+  uchar  rx_link     = ctx->link_rx_map [ sock_idx ];
+  ushort dport       = ctx->rx_sock_port[ sock_idx ];
+  ushort proto       = ctx->proto_id    [ sock_idx ];
+
+  fd_sock_link_rx_t * link = ctx->link_rx + rx_link;
+  long ts = fd_tickcount();
+
+  ulong pub_cnt = 0UL;
+  while( pub_cnt<burst_max && ctx->gro_msg_idx<ctx->gro_msg_cnt ) {
+    uint  j      = ctx->gro_msg_idx;
+    ulong msg_sz = ctx->gro_msg[ j ].msg_len;
+    ulong seg_sz = fd_ulong_if( !!ctx->gro_seg_sz[ j ], ctx->gro_seg_sz[ j ], msg_sz );
+    ulong off    = ctx->gro_msg_off;
+    ulong sz     = fd_ulong_min( seg_sz, msg_sz-off );
+    uchar const * seg = ctx->gro_buf + j*FD_SOCK_GRO_BUF_SZ + off;
+
+    off += sz;
+    if( off>=msg_sz ) {
+      ctx->gro_msg_idx++;
+      ctx->gro_msg_off = 0UL;
+    } else {
+      ctx->gro_msg_off = off;
+    }
+
+    /* Oversize datagrams are truncated like recvmmsg would */
+    ulong   payload_sz = fd_ulong_min( sz, payload_max );
+    uchar * payload    = (uchar *)fd_chunk_to_laddr( link->base, link->chunk ) + hdr_sz;
+    fd_memcpy( payload, seg, payload_sz );
+    struct sockaddr_in const * sa = ctx->gro_sa + j;
+    uchar * frame    = rx_frame_hdr_init( payload, payload_sz, sa, ctx->gro_daddr[ j ], dport );
+    ulong   frame_sz = payload_sz + hdr_sz;
+
+    ctx->metrics.rx_pkt_cnt++;
+    ctx->metrics.rx_bytes_total += frame_sz;
+    ulong chunk = fd_laddr_to_chunk( link->base, frame );
+    ulong sig   = fd_disco_netmux_sig( sa->sin_addr.s_addr, fd_ushort_bswap( sa->sin_port ), 0U, proto, hdr_sz );
+    ulong tspub = fd_frag_meta_ts_comp( ts );
+    fd_stem_publish( stem, rx_link, sig, chunk, frame_sz, 0UL, 0UL, tspub );
+    link->chunk = fd_dcache_compact_next( chunk, FD_NET_MTU, link->chunk0, link->wmark );
+    pub_cnt++;
+  }
+  return pub_cnt;
+}
+
+/* poll_rx_socket_gro is the UDP GRO variant of poll_rx_socket.  With
+   GRO, a datagram returned by the kernel may carry many coalesced UDP
+   segments of a flow, so datagrams are received into scratch buffers
+   and copied out segment by segment.  Publishes up to burst_max frags,
+   the remaining segments are published by subsequent after_credit
+   calls before the socket is read again.  Returns the number of frags
+   published. */
+
+static ulong
+poll_rx_socket_gro( fd_sock_tile_t *    ctx,
+                    fd_stem_context_t * stem,
+                    uint                sock_idx,
+                    int                 sock_fd,
+                    ulong               burst_max ) {
+  for( ulong j=0UL; j<FD_SOCK_GRO_MSG_MAX; j++ ) {
+    ctx->gro_iov[ j ].iov_base = ctx->gro_buf + j*FD_SOCK_GRO_BUF_SZ;
+    ctx->gro_iov[ j ].iov_len  = FD_SOCK_GRO_BUF_SZ;
+    ctx->gro_msg[ j ].msg_hdr  = (struct msghdr) {
+      .msg_iov        = ctx->gro_iov+j,
+      .msg_iovlen     = 1,
+      .msg_name       = ctx->gro_sa+j,
+      .msg_namelen    = sizeof(struct sockaddr_in),
+      .msg_control    = ctx->gro_cmsg[ j ],
+      .msg_controllen = FD_SOCK_CMSG_MAX,
+    };
+  }
+
+  int msg_cnt = recvmmsg( sock_fd, ctx->gro_msg, FD_SOCK_GRO_MSG_MAX, MSG_DONTWAIT, NULL );
+  if( FD_UNLIKELY( msg_cnt<0 ) ) {
+    if( FD_LIKELY( errno==EAGAIN ) ) return 0UL;
+    /* unreachable if socket is in a valid state */
+    FD_LOG_ERR(( "recvmmsg failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  }
+  ctx->metrics.sys_recvmmsg_cnt++;
+
+  if( FD_UNLIKELY( msg_cnt==0 ) ) return 0UL;
+
+  ulong seg_cnt = 0UL;
+  for( ulong j=0; j<(ulong)msg_cnt; j++ ) {
+    struct sockaddr_in * sa = ctx->gro_msg[ j ].msg_hdr.msg_name;
+    if( FD_UNLIKELY( sa->sin_family!=AF_INET ) ) {
+      /* unreachable */
+      FD_LOG_ERR(( "Received packet with unexpected sin_family %i", sa->sin_family ));
+    }
+
+    long  daddr  = -1;
+    ulong seg_sz = 0UL;
+    struct cmsghdr * cmsg = CMSG_FIRSTHDR( &ctx->gro_msg[ j ].msg_hdr );
+    while( cmsg ) {
+      if( (cmsg->cmsg_level==IPPROTO_IP) & (cmsg->cmsg_type==IP_PKTINFO) ) {
+        struct in_pktinfo const * pi = (struct in_pktinfo const *)CMSG_DATA( cmsg );
+        daddr = pi->ipi_addr.s_addr;
+      } else if( (cmsg->cmsg_level==SOL_UDP) & (cmsg->cmsg_type==UDP_GRO) ) {
+        seg_sz = (ulong)FD_LOAD( int, CMSG_DATA( cmsg ) );
+      }
+      cmsg = CMSG_NXTHDR( &ctx->gro_msg[ j ].msg_hdr, cmsg );
+    }
+    if( FD_UNLIKELY( daddr<0L ) ) {
+      /* unreachable because IP_PKTINFO was set */
+      FD_LOG_ERR(( "Missing IP_PKTINFO on incoming packet" ));
+    }
+
+    ulong msg_sz = ctx->gro_msg[ j ].msg_len;
+    if( seg_sz>=msg_sz ) seg_sz = 0UL; /* not coalesced */
+    ctx->gro_daddr [ j ] = (uint)(ulong)daddr;
+    ctx->gro_seg_sz[ j ] = (ushort)seg_sz;
+    if( seg_sz ) {
+      ctx->metrics.rx_gro_cnt++;
+      seg_cnt += (msg_sz+seg_sz-1UL)/seg_sz;
+    } else {
+      seg_cnt++;
+    }
+  }
+  fd_histf_sample( ctx->metrics.rx_pkts_per_syscall, seg_cnt );
+
+  ctx->gro_sock_idx = sock_idx;
+  ctx->gro_msg_cnt  = (uint)msg_cnt;
+  ctx->gro_msg_idx  = 0U;
+  ctx->gro_msg_off  = 0UL;
+  return poll_rx_gro_publish( ctx, stem, burst_max );
+}
+
+/* rx_uring_publish publishes a datagram that the kernel received into
+   the dcache slot at chunk.  The slot holds res bytes: the recvmsg
+   header (FD_SOCK_URING_RX_HDR_SZ bytes) followed by the payload.  The
+   Ethernet, IPv4 and UDP headers are written over the tail of the
+   recvmsg header, such that the frame ends at the end of the payload.
+   The frame offset into the slot is published via ctl. */
+
+static void
+rx_uring_publish( fd_sock_tile_t *    ctx,
+                  fd_stem_context_t * stem,
+                  uint                sock_idx,
+                  ulong               chunk,
+                  ulong               res,
+                  long                ts ) {
+  ulong  hdr_sz  = sizeof(fd_eth_hdr_t) + sizeof(fd_ip4_hdr_t) + sizeof(fd_udp_hdr_t);
+  uchar  rx_link = ctx->link_rx_map [ sock_idx ];
+  ushort dport   = ctx->rx_sock_port[ sock_idx ];
+  ushort proto   = ctx->proto_id    [ sock_idx ];
+
+  fd_sock_link_rx_t * link = ctx->link_rx + rx_link;
+  uchar * slot = fd_chunk_to_laddr( link->base, chunk );
+  if( FD_UNLIKELY( res<FD_SOCK_URING_RX_HDR_SZ ) ) {
+    /* unreachable */
+    FD_LOG_ERR(( "multishot recvmsg returned %lu bytes", res ));
+  }
+
+  /* The frame headers overwrite the source address and ancillary data,
+     so read them first.  Datagrams larger than the slot are truncated
+     like recvmmsg would. */
+
+  struct io_uring_recvmsg_out const * out = (struct io_uring_recvmsg_out const *)slot;
+  struct sockaddr_in sa = FD_LOAD( struct sockaddr_in, slot+sizeof(struct io_uring_recvmsg_out) );
+  if( FD_UNLIKELY( sa.sin_family!=AF_INET ) ) {
+    /* unreachable */
+    FD_LOG_ERR(( "Received packet with unexpected sin_family %i", sa.sin_family ));
+  }
+
+  struct msghdr msg = {
+    .msg_control    = slot + sizeof(struct io_uring_recvmsg_out) + sizeof(struct sockaddr_in),
+    .msg_controllen = out->controllen
+  };
+  long daddr = -1;
+  for( struct cmsghdr * cmsg = CMSG_FIRSTHDR( &msg ); cmsg; cmsg = CMSG_NXTHDR( &msg, cmsg ) ) {
+    if( FD_LIKELY( (cmsg->cmsg_level==IPPROTO_IP) &
+                   (cmsg->cmsg_type ==IP_PKTINFO) ) ) {
+      struct in_pktinfo const * pi = (struct in_pktinfo const *)CMSG_DATA( cmsg );
+      daddr = pi->ipi_addr.s_addr;
+    }
+  }
+  if( FD_UNLIKELY( daddr<0L ) ) {
+    /* unreachable because IP_PKTINFO was set */
+    FD_LOG_ERR(( "Missing IP_PKTINFO on incoming packet" ));
+  }
+
+  ulong   payload_sz = res - FD_SOCK_URING_RX_HDR_SZ;
+  uchar * frame      = rx_frame_hdr_init( slot+FD_SOCK_URING_RX_HDR_SZ, payload_sz, &sa, (uint)(ulong)daddr, dport );
+  ulong   frame_sz   = payload_sz + hdr_sz;
+
+  ctx->metrics.rx_pkt_cnt++;
+  ctx->metrics.rx_bytes_total += frame_sz;
+  ulong sig   = fd_disco_netmux_sig( sa.sin_addr.s_addr, fd_ushort_bswap( sa.sin_port ), 0U, proto, hdr_sz );
+  ulong ctl   = (ulong)frame - (ulong)slot;
+  ulong tspub = fd_frag_meta_ts_comp( ts );
+  fd_stem_publish( stem, rx_link, sig, chunk, frame_sz, ctl, 0UL, tspub );
+}
+
+/* poll_rx_uring is the io_uring variant of poll_rx.  Runs the pending
+   receives of all sockets with one io_uring_enter call (unless there
+   is still a backlog of completions) and publishes up to STEM_BURST
+   received datagrams.  The consumed dcache slots are then handed back
+   to the kernel.  Returns the number of frags published. */
+
+static ulong
+poll_rx_uring( fd_sock_tile_t *    ctx,
+               fd_stem_context_t * stem ) {
+  fd_io_uring_t * ring = ctx->rx_ring;
+
+  if( !fd_io_uring_cq_ready( ring ) ) {
+    int res = fd_io_uring_enter( ring, 0U, 0U, IORING_ENTER_GETEVENTS );
+    ctx->metrics.sys_io_uring_enter_cnt++;
+    if( FD_UNLIKELY( res<0 && res!=-EINTR ) ) {
+      FD_LOG_ERR(( "io_uring_enter failed (%i-%s)", -res, fd_io_strerror( -res ) ));
+    }
+  }
+
+  long  ts        = fd_tickcount();
+  uint  cqe_cnt   = fd_io_uring_cq_ready( ring );
+  uint  cqe_idx   = 0U;
+  ulong pub_cnt   = 0UL;
+  uint  buf_cnt[ MAX_NET_OUTS ] = {0};
+  for( ; cqe_idx<cqe_cnt && pub_cnt<STEM_BURST; cqe_idx++ ) {
+    struct io_uring_cqe const * cqe = fd_io_uring_cqe( ring, cqe_idx );
+    uint sock_idx = (uint)cqe->user_data;
+    uint flags    = cqe->flags;
+    int  res      = cqe->res;
+
+    if( FD_UNLIKELY( !( flags & IORING_CQE_F_MORE ) ) ) {
+      /* Request terminated, typically with ENOBUFS */
+      ctx->rx_uring_rearm |= 1U<<sock_idx;
+    }
+    if( FD_UNLIKELY( !( flags & IORING_CQE_F_BUFFER ) ) ) {
+      if( FD_UNLIKELY( res<0 && res!=-ENOBUFS && res!=-EINTR ) ) {
+        FD_LOG_ERR(( "multishot recvmsg failed (%i-%s)", -res, fd_io_strerror( -res ) ));
+      }
+      continue;
+    }
+
+    ulong rx_link = ctx->link_rx_map[ sock_idx ];
+    ulong chunk   = ctx->link_rx[ rx_link ].chunk0 + ( flags >> IORING_CQE_BUFFER_SHIFT )*RX_SLOT_CHUNK_CNT;
+    buf_cnt[ rx_link ]++;
+    if( FD_UNLIKELY( res<0 ) ) continue;
+    rx_uring_publish( ctx, stem, sock_idx, chunk, (ulong)res, ts );
+    pub_cnt++;
+  }
+  fd_io_uring_cq_advance( ring, cqe_idx );
+
+  for( ulong j=0UL; j<MAX_NET_OUTS; j++ ) {
+    if( buf_cnt[ j ] ) rx_uring_provide( ctx, j, buf_cnt[ j ] );
+  }
+  if( FD_UNLIKELY( ctx->rx_uring_rearm ) ) rx_uring_arm( ctx );
+
+  if( pub_cnt ) fd_histf_sample( ctx->metrics.rx_pkts_per_syscall, pub_cnt );
+  return pub_cnt;
+}
+
 static ulong
 poll_rx( fd_sock_tile_t *    ctx,
          fd_stem_context_t * stem ) {
@@ -412,18 +903,27 @@ poll_rx( fd_sock_tile_t *    ctx,
     FD_LOG_ERR(( "Batch is not clean" ));
   }
   ctx->tx_idle_cnt = 0; /* restart TX polling */
+  if( ctx->uring_enabled ) return poll_rx_uring( ctx, stem );
   if( FD_UNLIKELY( poll( ctx->pollfd, ctx->sock_cnt, 0 )<0 ) ) {
     FD_LOG_ERR(( "poll failed (%i-%s)", errno, fd_io_strerror( errno ) ));
   }
   for( uint j=0UL; j<ctx->sock_cnt; j++ ) {
     if( ctx->pollfd[ j ].revents & (POLLIN|POLLERR) ) {
-      pkt_cnt += poll_rx_socket(
-        ctx,
-        stem,
-        j,
-        ctx->pollfd[ j ].fd,
-        ctx->proto_id[ j ]
-      );
+      if( ctx->gro_enabled ) {
+        /* Sockets not read because the burst is exhausted remain
+           readable and are picked up by the next poll */
+        if( pkt_cnt<STEM_BURST && ctx->gro_msg_idx>=ctx->gro_msg_cnt ) {
+          pkt_cnt += poll_rx_socket_gro( ctx, stem, j, ctx->pollfd[ j ].fd, STEM_BURST-pkt_cnt );
+        }
+      } else {
+        pkt_cnt += poll_rx_socket(
+          ctx,
+          stem,
+          j,
+          ctx->pollfd[ j ].fd,
+          ctx->proto_id[ j ]
+        );
+      }
     }
     ctx->pollfd[ j ].revents = 0;
   }
@@ -432,51 +932,293 @@ poll_rx( fd_sock_tile_t *    ctx,
 
 /* TX PATH (tango->socket) ********************************************/
 
+/* msg_pkt_cnt returns the number of packets carried by messages
+   [j0,j1).  seg_cnt is NULL if every message carries one packet. */
+
+static inline ulong
+msg_pkt_cnt( uchar const * seg_cnt,
+             ulong         j0,
+             ulong         j1 ) {
+  if( !seg_cnt ) return j1-j0;
+  ulong cnt = 0UL;
+  for( ulong j=j0; j<j1; j++ ) cnt += seg_cnt[ j ];
+  return cnt;
+}
+
+/* tx_error handles a message carrying drop_cnt packets that failed to
+   send with error err.  Terminates the application if the error is not
+   recoverable. */
+
 static void
-flush_tx_batch( fd_sock_tile_t * ctx ) {
-  ulong batch_cnt = ctx->batch_cnt;
-  for( int j = 0; j < (int)batch_cnt; /* incremented in loop */ ) {
+tx_error( fd_sock_tile_t * ctx,
+          int              err,
+          ulong            drop_cnt ) {
+  switch( err ) {
+    case EAGAIN:
+    case ENOBUFS:
+      ctx->metrics.tx_drop_cnt += drop_cnt;
+      break;
+
+    case EPERM:
+      ctx->metrics.tx_permission_error_cnt++;
+      break;
+
+    case EIO:
+    case EINVAL:
+      /* The kernel rejects GSO datagrams if the egress device does not
+         support checksum offload or the segment size exceeds the path
+         MTU.  Fall back to plain sends. */
+      if( drop_cnt>1UL ) {
+        FD_LOG_WARNING(( "sendmmsg with UDP_SEGMENT failed (%i-%s), disabling UDP GSO", err, fd_io_strerror( err ) ));
+        ctx->gso_enabled = 0;
+        ctx->metrics.tx_drop_cnt += drop_cnt;
+        break;
+      }
+      __attribute__((fallthrough));
+    default:
+      FD_LOG_ERR(( "sendmmsg failed (%i-%s)", err, fd_io_strerror( err ) ));
+  }
+}
+
+/* sendmmsg_batch sends msg_cnt messages on sock_fd.  seg_cnt[j] is the
+   number of packets carried by message j (NULL if one each).  Messages
+   that fail to send are dropped. */
+
+static void
+sendmmsg_batch( fd_sock_tile_t * ctx,
+                int              sock_fd,
+                struct mmsghdr * msg,
+                ulong            msg_cnt,
+                uchar const *    seg_cnt ) {
+  for( int j = 0; j < (int)msg_cnt; /* incremented in loop */ ) {
     ctx->metrics.sys_sendmmsg_cnt++;
 
-    int remain   = (int)batch_cnt - j;
-    int send_cnt = sendmmsg( ctx->tx_sock, ctx->batch_msg + j, (uint)remain, MSG_DONTWAIT );
+    int remain   = (int)msg_cnt - j;
+    int send_cnt = sendmmsg( sock_fd, msg + j, (uint)remain, MSG_DONTWAIT );
     if( FD_UNLIKELY( send_cnt < remain ) ) {
       if( FD_UNLIKELY( send_cnt < 0 ) ) {
-        switch( errno ) {
-          case EAGAIN:
-          case ENOBUFS:
-            ctx->metrics.tx_drop_cnt++;
-            break;
-
-          case EPERM:
-            ctx->metrics.tx_permission_error_cnt++;
-            break;
-
-          default:
-            FD_LOG_ERR(( "sendmmsg failed (%i-%s)", errno, fd_io_strerror( errno ) ));
-        }
+        tx_error( ctx, errno, msg_pkt_cnt( seg_cnt, (ulong)j, (ulong)j+1UL ) );
 
         /* first message failed, so skip failing message and continue */
         j++;
       } else {
-        /* sent at least one, and error on ctx->batch_msg[send_cnt] is lost
+        /* sent at least one, and error on msg[send_cnt] is lost
            so assume recoverable and continue */
-        ctx->metrics.tx_drop_cnt++;
+        ctx->metrics.tx_drop_cnt += msg_pkt_cnt( seg_cnt, (ulong)(j+send_cnt), (ulong)(j+send_cnt+1) );
+
+        /* add the successful count */
+        ulong pkt_cnt = msg_pkt_cnt( seg_cnt, (ulong)j, (ulong)(j+send_cnt) );
+        ctx->metrics.tx_pkt_cnt += pkt_cnt;
+        fd_histf_sample( ctx->metrics.tx_pkts_per_syscall, pkt_cnt );
 
         /* send_cnt succeeded, so skip those and also the failing message */
         j += send_cnt + 1;
-
-        /* add the successful count */
-        ctx->metrics.tx_pkt_cnt += (ulong)send_cnt;
       }
 
       continue;
     }
 
-    /* send_cnt == batch_cnt, so we sent everything */
-    ctx->metrics.tx_pkt_cnt += (ulong)send_cnt;
+    /* send_cnt == remain, so we sent everything */
+    ulong pkt_cnt = msg_pkt_cnt( seg_cnt, (ulong)j, msg_cnt );
+    ctx->metrics.tx_pkt_cnt += pkt_cnt;
+    fd_histf_sample( ctx->metrics.tx_pkts_per_syscall, pkt_cnt );
     break;
   }
+}
+
+/* sendmsg_batch_uring is the io_uring variant of sendmmsg_batch.  Sends
+   msg_cnt messages with one io_uring_enter call.  Message j is sent on
+   msg_fd[j] if non-negative, or on the raw TX socket otherwise (msg_fd
+   NULL if all go to the raw socket). */
+
+static void
+sendmsg_batch_uring( fd_sock_tile_t * ctx,
+                     struct mmsghdr * msg,
+                     int const *      msg_fd,
+                     ulong            msg_cnt,
+                     uchar const *    seg_cnt ) {
+  fd_io_uring_t * ring = ctx->tx_ring;
+  for( ulong j=0UL; j<msg_cnt; j++ ) {
+    struct io_uring_sqe * sqe = fd_io_uring_sqe_acquire( ring );
+    if( FD_UNLIKELY( !sqe ) ) FD_LOG_CRIT(( "io_uring submission queue overrun" ));
+    int sock_fd = ( msg_fd && msg_fd[ j ]>=0 ) ? msg_fd[ j ] : ctx->tx_sock;
+    sqe->opcode    = IORING_OP_SENDMSG;
+    sqe->fd        = sock_fd;
+    sqe->addr      = (ulong)&msg[ j ].msg_hdr;
+    sqe->len       = 1U;
+    sqe->msg_flags = MSG_DONTWAIT;
+    sqe->user_data = j;
+  }
+
+  /* Requests with MSG_DONTWAIT complete during submission, so waiting
+     for all completions does not block.  It also guarantees that the
+     kernel is done with the batch buffers on return. */
+  int res = fd_io_uring_submit( ring, (uint)msg_cnt );
+  ctx->metrics.sys_io_uring_enter_cnt++;
+  if( FD_UNLIKELY( res!=(int)msg_cnt ) ) {
+    FD_LOG_ERR(( "io_uring_enter failed (%i-%s)", -res, fd_io_strerror( -res ) ));
+  }
+
+  ulong pkt_cnt = 0UL;
+  uint  cqe_cnt = fd_io_uring_cq_ready( ring );
+  for( uint j=0U; j<cqe_cnt; j++ ) {
+    struct io_uring_cqe const * cqe = fd_io_uring_cqe( ring, j );
+    ulong segs = msg_pkt_cnt( seg_cnt, cqe->user_data, cqe->user_data+1UL );
+    if( FD_LIKELY( cqe->res>=0 ) ) pkt_cnt += segs;
+    else                           tx_error( ctx, -cqe->res, segs );
+  }
+  fd_io_uring_cq_advance( ring, cqe_cnt );
+
+  ctx->metrics.tx_pkt_cnt += pkt_cnt;
+  if( pkt_cnt ) fd_histf_sample( ctx->metrics.tx_pkts_per_syscall, pkt_cnt );
+}
+
+/* sock_fd_for_port returns the file descriptor of the RX socket bound
+   to the given UDP port, or -1 if there is none. */
+
+static inline int
+sock_fd_for_port( fd_sock_tile_t const * ctx,
+                  ushort                 port ) {
+  for( uint j=0U; j<ctx->sock_cnt; j++ ) {
+    if( ctx->rx_sock_port[ j ]==port ) return ctx->pollfd[ j ].fd;
+  }
+  return -1;
+}
+
+/* flush_tx_batch_gso sends the batch using UDP generic segmentation
+   offload.  Packets of the same flow (source and destination address
+   and port) are coalesced into a single datagram carrying a UDP_SEGMENT
+   option, which the kernel (or NIC) splits back into packets.  All but
+   the last segment of a datagram need to be of the same size, so a run
+   ends with the first shorter packet.  Packets of a flow stay in order,
+   packets of different flows may be reordered within the batch.
+
+   The raw TX socket does not support GSO, so datagrams are sent through
+   the RX socket bound to their source port.  Packets from ports without
+   such a socket are sent through the raw socket as usual. */
+
+static void
+flush_tx_batch_gso( fd_sock_tile_t * ctx ) {
+  FD_STATIC_ASSERT( CMSG_SPACE( sizeof(struct in_pktinfo) )+CMSG_SPACE( sizeof(ushort) )<=FD_SOCK_CMSG_MAX, cmsg );
+
+  ulong batch_cnt = ctx->batch_cnt;
+
+  ulong flow_dst[ STEM_BURST ];
+  ulong flow_src[ STEM_BURST ];
+  int   flow_fd [ STEM_BURST ];
+  uchar done    [ STEM_BURST ];
+  for( ulong j=0UL; j<batch_cnt; j++ ) {
+    fd_udp_hdr_t const *      udp  = ctx->batch_iov[ j ].iov_base;
+    struct cmsghdr const *    cmsg = (struct cmsghdr const *)( (ulong)ctx->batch_cmsg + j*FD_SOCK_CMSG_MAX );
+    struct in_pktinfo const * pi   = (struct in_pktinfo const *)CMSG_DATA( cmsg );
+    flow_dst[ j ] = ( (ulong)ctx->batch_sa[ j ].sin_addr.s_addr<<16 ) | udp->net_dport;
+    flow_src[ j ] = ( (ulong)pi->ipi_spec_dst.s_addr           <<16 ) | udp->net_sport;
+    flow_fd [ j ] = sock_fd_for_port( ctx, fd_ushort_bswap( udp->net_sport ) );
+    done    [ j ] = 0;
+  }
+
+  /* Build one message per datagram, in order of their first packet.
+     A message reuses the sockaddr and ancillary data buffers of its
+     first packet (batch_msg itself is not read here). */
+
+  struct mmsghdr * msg     = ctx->batch_msg;
+  uchar            seg_cnt[ STEM_BURST ];
+  int              msg_fd [ STEM_BURST ];
+  ulong            msg_cnt = 0UL;
+  ulong            iov_cnt = 0UL;
+  for( ulong j=0UL; j<batch_cnt; j++ ) {
+    if( done[ j ] ) continue;
+    done[ j ] = 1;
+
+    ulong                m    = msg_cnt++;
+    struct sockaddr_in * sa   = ctx->batch_sa + j;
+    struct cmsghdr *     cmsg = (struct cmsghdr *)( (ulong)ctx->batch_cmsg + j*FD_SOCK_CMSG_MAX );
+    msg_fd[ m ] = flow_fd[ j ];
+
+    if( flow_fd[ j ]<0 ) {
+      msg[ m ] = (struct mmsghdr) {
+        .msg_hdr = {
+          .msg_name       = sa,
+          .msg_namelen    = sizeof(struct sockaddr_in),
+          .msg_iov        = ctx->batch_iov + j,
+          .msg_iovlen     = 1,
+          .msg_control    = cmsg,
+          .msg_controllen = CMSG_LEN( sizeof(struct in_pktinfo) )
+        }
+      };
+      seg_cnt[ m ] = 1;
+      continue;
+    }
+
+    /* Gather the run of packets of this flow.  The SOCK_DGRAM socket
+       adds the UDP header itself. */
+    struct iovec * iov    = ctx->gso_iov + iov_cnt;
+    ulong          gso_sz = ctx->batch_iov[ j ].iov_len - sizeof(fd_udp_hdr_t);
+    ulong          tot_sz = 0UL;
+    ulong          segs   = 0UL;
+    for( ulong k=j; k<batch_cnt; k++ ) {
+      if( k>j && ( done[ k ] | (flow_fd[ k ]!=flow_fd[ j ]) | (flow_dst[ k ]!=flow_dst[ j ]) | (flow_src[ k ]!=flow_src[ j ]) ) ) continue;
+      ulong sz = ctx->batch_iov[ k ].iov_len - sizeof(fd_udp_hdr_t);
+      if( sz>gso_sz || tot_sz+sz>FD_SOCK_UDP_PAYLOAD_MAX ) break;
+      done[ k ] = 1;
+      ctx->gso_iov[ iov_cnt++ ] = (struct iovec) {
+        .iov_base = (uchar *)ctx->batch_iov[ k ].iov_base + sizeof(fd_udp_hdr_t),
+        .iov_len  = sz
+      };
+      tot_sz += sz;
+      segs++;
+      if( sz<gso_sz || !gso_sz || segs==FD_SOCK_GSO_SEG_MAX ) break;
+    }
+
+    sa->sin_port = (ushort)flow_dst[ j ];
+    ulong controllen = CMSG_SPACE( sizeof(struct in_pktinfo) );
+    if( segs>1UL ) {
+      struct cmsghdr * gso_cmsg = (struct cmsghdr *)( (ulong)cmsg + controllen );
+      gso_cmsg->cmsg_level = SOL_UDP;
+      gso_cmsg->cmsg_type  = UDP_SEGMENT;
+      gso_cmsg->cmsg_len   = CMSG_LEN( sizeof(ushort) );
+      FD_STORE( ushort, CMSG_DATA( gso_cmsg ), (ushort)gso_sz );
+      controllen += CMSG_SPACE( sizeof(ushort) );
+      ctx->metrics.tx_gso_cnt++;
+    }
+    msg[ m ] = (struct mmsghdr) {
+      .msg_hdr = {
+        .msg_name       = sa,
+        .msg_namelen    = sizeof(struct sockaddr_in),
+        .msg_iov        = iov,
+        .msg_iovlen     = segs,
+        .msg_control    = cmsg,
+        .msg_controllen = controllen
+      }
+    };
+    seg_cnt[ m ] = (uchar)segs;
+  }
+
+  if( ctx->uring_enabled ) {
+    sendmsg_batch_uring( ctx, msg, msg_fd, msg_cnt, seg_cnt );
+    return;
+  }
+
+  /* Send consecutive messages on the same socket with one sendmmsg */
+
+  for( ulong m0=0UL; m0<msg_cnt; ) {
+    ulong m1 = m0+1UL;
+    while( m1<msg_cnt && msg_fd[ m1 ]==msg_fd[ m0 ] ) m1++;
+    int sock_fd = msg_fd[ m0 ]<0 ? ctx->tx_sock : msg_fd[ m0 ];
+    sendmmsg_batch( ctx, sock_fd, msg+m0, m1-m0, seg_cnt+m0 );
+    m0 = m1;
+  }
+}
+
+static void
+flush_tx_batch( fd_sock_tile_t * ctx ) {
+  if( ctx->gso_enabled ) {
+    flush_tx_batch_gso( ctx );
+  } else if( ctx->uring_enabled ) {
+    sendmsg_batch_uring( ctx, ctx->batch_msg, NULL, ctx->batch_cnt, NULL );
+  } else {
+    sendmmsg_batch( ctx, ctx->tx_sock, ctx->batch_msg, ctx->batch_cnt, NULL );
+  }
 
   ctx->tx_ptr = ctx->tx_scratch0;
   ctx->batch_cnt = 0;
@@ -611,6 +1353,10 @@ after_credit( fd_sock_tile_t *    ctx,
               fd_stem_context_t * stem,
               int *               poll_in FD_PARAM_UNUSED,
               int *               charge_busy ) {
+  if( FD_UNLIKELY( ctx->gro_msg_idx<ctx->gro_msg_cnt ) ) {
+    /* Publish segments left over from the last GRO receive */
+    *charge_busy = !!poll_rx_gro_publish( ctx, stem, STEM_BURST );
+  }
   if( ctx->tx_idle_cnt > 512 ) {
     if( ctx->batch_cnt ) {
       flush_tx_batch( ctx );
@@ -631,6 +1377,12 @@ metrics_write( fd_sock_tile_t * ctx ) {
   FD_MCNT_SET( SOCK, TX_BYTES_TOTAL,          ctx->metrics.tx_bytes_total       );
   FD_MCNT_SET( SOCK, RX_BYTES_TOTAL,          ctx->metrics.rx_bytes_total       );
   FD_MCNT_SET( SOCK, TX_PERMISSION_ERROR_CNT, ctx->metrics.tx_permission_error_cnt );
+  FD_MCNT_SET( SOCK, TX_GSO_CNT,              ctx->metrics.tx_gso_cnt           );
+  FD_MCNT_SET( SOCK, RX_GRO_CNT,              ctx->metrics.rx_gro_cnt           );
+  FD_MCNT_SET( SOCK, SYSCALLS_IO_URING_ENTER, ctx->metrics.sys_io_uring_enter_cnt );
+  FD_MCNT_SET( SOCK, RX_URING_REARM_CNT,      ctx->metrics.rx_uring_rearm_cnt   );
+  FD_MHIST_COPY( SOCK, TX_PKTS_PER_SYSCALL,   ctx->metrics.tx_pkts_per_syscall  );
+  FD_MHIST_COPY( SOCK, RX_PKTS_PER_SYSCALL,   ctx->metrics.rx_pkts_per_syscall  );
 }
 
 static ulong
@@ -1,3 +1,9 @@
 #include "../../topo/fd_topo.h"
 
+/* FD_SOCK_TILE_URING_RX_DEPTH is the number of dcache slots per RX link
+   that are handed to the kernel for receives if [net.socket.io_uring]
+   is enabled. */
+
+#define FD_SOCK_TILE_URING_RX_DEPTH (1024UL)
+
 extern fd_topo_run_tile_t fd_tile_sock;
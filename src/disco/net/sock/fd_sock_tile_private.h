@@ -4,7 +4,10 @@
 #if FD_HAS_HOSTED
 
 #include "../../../util/fd_util_base.h"
+#include "../../../util/hist/fd_histf.h"
+#include "../../../waltz/uring/fd_io_uring.h"
 #include <poll.h>
+#include <netinet/in.h>
 #include <sys/socket.h>
 
 /* FD_SOCK_TILE_MAX_SOCKETS controls the max number of UDP ports that a
@@ -22,6 +25,29 @@
 
 #define MAX_NET_OUTS (4UL)
 
+/* FD_SOCK_GRO_MSG_MAX controls the max number of datagrams received per
+   recvmmsg call if UDP GRO is enabled.  Each datagram may carry up to
+   64 coalesced UDP segments. */
+
+#define FD_SOCK_GRO_MSG_MAX (8UL)
+
+/* FD_SOCK_GRO_BUF_SZ is the receive buffer size of a GRO datagram.
+   Large enough to hold the largest possible UDP payload. */
+
+#define FD_SOCK_GRO_BUF_SZ (65536UL)
+
+/* Controls max ancillary data size.
+   Must be aligned by alignof(struct cmsghdr) */
+
+#define FD_SOCK_CMSG_MAX (64UL)
+
+/* FD_SOCK_URING_RX_HDR_SZ is the number of bytes the kernel writes in
+   front of the payload of a datagram received with a multishot recvmsg
+   (struct io_uring_recvmsg_out, source address, IP_PKTINFO control
+   message). */
+
+#define FD_SOCK_URING_RX_HDR_SZ (64UL)
+
 /* Local metrics.  Periodically copied to the metric_in shm region. */
 
 struct fd_sock_tile_metrics {
@@ -33,6 +59,12 @@ struct fd_sock_tile_metrics {
   ulong rx_bytes_total;
   ulong tx_bytes_total;
   ulong tx_permission_error_cnt;
+  ulong tx_gso_cnt;
+  ulong rx_gro_cnt;
+  ulong sys_io_uring_enter_cnt;
+  ulong rx_uring_rearm_cnt;
+  fd_histf_t tx_pkts_per_syscall[1];
+  fd_histf_t rx_pkts_per_syscall[1];
 };
 
 typedef struct fd_sock_tile_metrics fd_sock_tile_metrics_t;
@@ -88,6 +120,40 @@ struct fd_sock_tile {
   uchar * tx_scratch1;
   uchar * tx_ptr; /* in [tx_scratch0,tx_scratch1) */
 
+  /* UDP GSO: If enabled, batched packets are coalesced by flow and sent
+     through the RX socket bound to their source port.  gso_iov holds
+     the payload iovecs of the coalesced datagrams. */
+  int            gso_enabled;
+  struct iovec * gso_iov;
+
+  /* UDP GRO: If enabled, datagrams are received into gro_buf and split
+     into frags.  Segments that did not fit into the current burst are
+     published on subsequent polls (gro_msg_idx<gro_msg_cnt). */
+  int                gro_enabled;
+  uchar *            gro_buf; /* FD_SOCK_GRO_MSG_MAX buffers of FD_SOCK_GRO_BUF_SZ bytes */
+  uint               gro_sock_idx;
+  uint               gro_msg_cnt;
+  uint               gro_msg_idx;
+  ulong              gro_msg_off;
+  struct mmsghdr     gro_msg [ FD_SOCK_GRO_MSG_MAX ];
+  struct iovec       gro_iov [ FD_SOCK_GRO_MSG_MAX ];
+  struct sockaddr_in gro_sa  [ FD_SOCK_GRO_MSG_MAX ];
+  uint               gro_daddr [ FD_SOCK_GRO_MSG_MAX ];
+  ushort             gro_seg_sz[ FD_SOCK_GRO_MSG_MAX ]; /* 0 if not coalesced */
+  uchar              gro_cmsg[ FD_SOCK_GRO_MSG_MAX ][ FD_SOCK_CMSG_MAX ] __attribute__((aligned(8)));
+
+  /* io_uring: If enabled, each RX socket has a multishot recvmsg
+     request on rx_ring that receives directly into dcache slots of its
+     RX link, provided through the link's buffer ring.  link_rx[].chunk
+     is the next slot to provide.  TX batches are submitted as SENDMSG
+     requests on tx_ring. */
+  int                    uring_enabled;
+  fd_io_uring_t          rx_ring[1];
+  fd_io_uring_t          tx_ring[1];
+  fd_io_uring_buf_ring_t rx_buf_ring[ MAX_NET_OUTS ];
+  struct msghdr          rx_uring_msg;
+  uint                   rx_uring_rearm; /* bit set of sockets to re-arm */
+
   fd_sock_tile_metrics_t metrics;
 };
 
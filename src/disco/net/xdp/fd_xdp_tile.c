@@ -227,6 +227,8 @@ typedef struct {
     ulong rx_pkt_cnt;
     ulong rx_bytes_total;
     ulong rx_undersz_cnt;
+    ulong rx_oversz_cnt;
+    ulong rx_multi_buf_cnt;
     ulong rx_fill_blocked_cnt;
     ulong rx_backp_cnt;
     long  rx_busy_cnt;
@@ -265,6 +267,8 @@ metrics_write( fd_net_ctx_t * ctx ) {
   FD_MCNT_SET(   NET, RX_PKT_CNT,          ctx->metrics.rx_pkt_cnt          );
   FD_MCNT_SET(   NET, RX_BYTES_TOTAL,      ctx->metrics.rx_bytes_total      );
   FD_MCNT_SET(   NET, RX_UNDERSZ_CNT,      ctx->metrics.rx_undersz_cnt      );
+  FD_MCNT_SET(   NET, RX_OVERSZ_CNT,       ctx->metrics.rx_oversz_cnt       );
+  FD_MCNT_SET(   NET, RX_MULTI_BUF_CNT,    ctx->metrics.rx_multi_buf_cnt    );
   FD_MCNT_SET(   NET, RX_FILL_BLOCKED_CNT, ctx->metrics.rx_fill_blocked_cnt );
   FD_MCNT_SET(   NET, RX_BACKPRESSURE_CNT, ctx->metrics.rx_backp_cnt        );
   FD_MGAUGE_SET( NET, RX_BUSY_CNT, (ulong)fd_long_max( ctx->metrics.rx_busy_cnt, 0L ) );
@@ -829,6 +833,100 @@ net_comp_event( fd_net_ctx_t * ctx,
 
 }
 
+/* net_rx_chain_event is called when the XDP RX frame at rx_seq is the
+   head of a multi-buffer chain (XSK bound with XDP_USE_SG).  Waits until
+   the whole chain is visible in [rx_seq,rx_prod).  Reassembles the
+   packet into the head frame and calls net_rx_packet.  Returns all
+   other frames of the chain back to the kernel via the fill ring.
+   Chains larger than FD_NET_MTU (only possible if the interface MTU was
+   raised after startup, see fd_config.c) are dropped. */
+
+static void
+net_rx_chain_event( fd_net_ctx_t *      ctx,
+                    fd_stem_context_t * stem,
+                    fd_xsk_t *          xsk,
+                    uint                rx_seq,
+                    uint                rx_prod ) {
+
+  fd_xdp_ring_t * rx_ring = &xsk->ring_rx;
+  uint            rx_mask = rx_ring->depth - 1U;
+
+  ulong pkt_sz   = 0UL;
+  uint  desc_cnt = fd_xsk_rx_pkt_desc_cnt( rx_ring, rx_seq, rx_prod, &pkt_sz );
+  if( FD_UNLIKELY( !desc_cnt ) ) return; /* chain incomplete */
+
+  /* Check if we have space in the fill ring to free all frames */
+
+  fd_xdp_ring_t * fill_ring  = &xsk->ring_fr;
+  uint            fill_depth = fill_ring->depth;
+  uint            fill_mask  = fill_depth-1U;
+  ulong           frame_mask = FD_NET_MTU - 1UL;
+  uint            fill_prod  = FD_VOLATILE_CONST( *fill_ring->prod );
+  uint            fill_cons  = FD_VOLATILE_CONST( *fill_ring->cons );
+
+  if( FD_UNLIKELY( (int)(fill_prod-fill_cons) > (int)(fill_depth-desc_cnt) ) ) {
+    ctx->metrics.rx_fill_blocked_cnt++;
+    return; /* blocked */
+  }
+
+  struct xdp_desc head     = FD_VOLATILE_CONST( rx_ring->packet_ring[ rx_seq&rx_mask ] );
+  ulong           head_off = head.addr & (~frame_mask);
+  uint            fill_seq = fill_prod;
+  uint            freed_chunk = UINT_MAX;
+
+  if( FD_LIKELY( pkt_sz<=FD_NET_MTU ) ) {
+
+    /* Gather the chain into the head frame.  The head fragment might
+       be preceded by headroom. */
+
+    uchar * pkt = (uchar *)ctx->umem_frame0 + head_off;
+    memmove( pkt, (uchar const *)ctx->umem_frame0 + head.addr, head.len );
+    ulong pkt_off = head.len;
+    for( uint j=1U; j<desc_cnt; j++ ) {
+      struct xdp_desc frag = FD_VOLATILE_CONST( rx_ring->packet_ring[ (rx_seq+j)&rx_mask ] );
+      fd_memcpy( pkt+pkt_off, (uchar const *)ctx->umem_frame0 + frag.addr, frag.len );
+      pkt_off += frag.len;
+      fill_ring->frame_ring[ (fill_seq++)&fill_mask ] = frag.addr & (~frame_mask);
+    }
+
+    ctx->metrics.rx_multi_buf_cnt++;
+    net_rx_packet( ctx, stem, head_off, pkt_sz, &freed_chunk );
+
+    /* If the packet was not published, the head frame is still ours */
+    if( FD_UNLIKELY( freed_chunk==UINT_MAX ) ) {
+      fill_ring->frame_ring[ (fill_seq++)&fill_mask ] = head_off;
+    }
+
+  } else {
+
+    ctx->metrics.rx_oversz_cnt++;
+    for( uint j=0U; j<desc_cnt; j++ ) {
+      struct xdp_desc frag = FD_VOLATILE_CONST( rx_ring->packet_ring[ (rx_seq+j)&rx_mask ] );
+      fill_ring->frame_ring[ (fill_seq++)&fill_mask ] = frag.addr & (~frame_mask);
+    }
+
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( *rx_ring->cons ) = rx_ring->cached_cons = rx_seq+desc_cnt;
+
+  /* If this mcache publish shadowed a previous publish, mark the old
+     frame as free. */
+
+  if( FD_LIKELY( freed_chunk!=UINT_MAX ) ) {
+    if( FD_UNLIKELY( ( freed_chunk < ctx->umem_chunk0 ) |
+                     ( freed_chunk > ctx->umem_wmark ) ) ) {
+      FD_LOG_ERR(( "mcache corruption detected: chunk=%u chunk0=%u wmark=%u",
+                   freed_chunk, ctx->umem_chunk0, ctx->umem_wmark ));
+    }
+    ulong freed_off = (freed_chunk - ctx->umem_chunk0)<<FD_CHUNK_LG_SZ;
+    fill_ring->frame_ring[ (fill_seq++)&fill_mask ] = freed_off & (~frame_mask);
+  }
+
+  FD_VOLATILE( *fill_ring->prod ) = fill_ring->cached_prod = fill_seq;
+
+}
+
 /* net_rx_event is called when a new XDP RX frame is available.  Calls
    net_rx_packet, then returns the packet back to the kernel via the fill
    ring.  */
@@ -837,7 +935,8 @@ static void
 net_rx_event( fd_net_ctx_t *      ctx,
               fd_stem_context_t * stem,
               fd_xsk_t *          xsk,
-              uint                rx_seq ) {
+              uint                rx_seq,
+              uint                rx_prod ) {
 
   // FIXME(topointon): Temporarily disabling backpressure feature because it triggers even with FD_TOPOB_UNRELIABLE
   //if( FD_UNLIKELY( *stem->cr_avail < stem->cr_decrement_amount ) ) {
@@ -851,6 +950,11 @@ net_rx_event( fd_net_ctx_t *      ctx,
   uint            rx_mask = rx_ring->depth - 1U;
   struct xdp_desc frame   = FD_VOLATILE_CONST( rx_ring->packet_ring[ rx_seq&rx_mask ] );
 
+  if( FD_UNLIKELY( frame.options & XDP_PKT_CONTD ) ) {
+    net_rx_chain_event( ctx, stem, xsk, rx_seq, rx_prod );
+    return;
+  }
+
   if( FD_UNLIKELY( frame.len>FD_NET_MTU ) )
     FD_LOG_ERR(( "received a UDP packet with a too large payload (%u)", frame.len ));
 
@@ -926,7 +1030,7 @@ before_credit( fd_net_ctx_t *      ctx,
   if( rx_cons!=rx_prod ) {
     *charge_busy = 1;
     rr_xsk->ring_rx.cached_prod = rx_prod;
-    net_rx_event( ctx, stem, rr_xsk, rx_cons );
+    net_rx_event( ctx, stem, rr_xsk, rx_cons, rx_prod );
   } else {
     net_rx_wakeup( ctx, rr_xsk, charge_busy );
   }
@@ -1064,7 +1168,8 @@ privileged_init( fd_topo_t *      topo,
     /* Some kernels produce EOPNOTSUP errors on sendto calls when
        starting up without either XDP_ZEROCOPY or XDP_COPY
        (e.g. 5.14.0-503.23.1.el9_5 with i40e) */
-    .bind_flags  = tile->net.zero_copy ? XDP_ZEROCOPY : XDP_COPY,
+    .bind_flags  = ( tile->net.zero_copy    ? XDP_ZEROCOPY : XDP_COPY ) |
+                   ( tile->net.multi_buffer ? XDP_USE_SG   : 0U       ),
 
     .fr_depth  = tile->net.xdp_rx_queue_size*2,
     .rx_depth  = tile->net.xdp_rx_queue_size,
@@ -1112,14 +1217,15 @@ privileged_init( fd_topo_t *      topo,
                                           tile->net.bind_address,
                                           sizeof(udp_port_candidates)/sizeof(udp_port_candidates[0]),
                                           udp_port_candidates,
-                                          "skb" );
+                                          "skb",
+                                          tile->net.multi_buffer );
 
     ctx->prog_link_fds[ 1 ] = lo_fds.prog_link_fd;
     /* init xsk 1 */
     fd_xsk_params_t params1 = params0;
     params1.if_idx      = lo_idx; /* probably always 1 */
     params1.if_queue_id = 0;
-    params1.bind_flags  = 0;
+    params1.bind_flags  = tile->net.multi_buffer ? XDP_USE_SG : 0U;
     if( FD_UNLIKELY( !fd_xsk_init( &ctx->xsk[ 1 ], &params1 ) ) )              FD_LOG_ERR(( "failed to bind lo_xsk" ));
     if( FD_UNLIKELY( !fd_xsk_activate( &ctx->xsk[ 1 ], lo_fds.xsk_map_fd ) ) ) FD_LOG_ERR(( "failed to activate lo_xsk" ));
     if( FD_UNLIKELY( -1==close( lo_fds.xsk_map_fd ) ) )                        FD_LOG_ERR(( "close(%d) failed (%d-%s)", xsk_map_fd, errno, fd_io_strerror( errno ) ));
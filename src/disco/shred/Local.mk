@@ -7,7 +7,9 @@ ifdef FD_HAS_SSE
 $(call add-objs,fd_shred_tile,fd_disco)
 endif
 $(call make-unit-test,test_shred_dest,test_shred_dest,fd_disco fd_flamenco fd_ballet fd_util)
+$(call make-unit-test,bench_shred_dest,bench_shred_dest,fd_disco fd_flamenco fd_ballet fd_util)
 $(call make-unit-test,test_fec_resolver,test_fec_resolver,fd_flamenco fd_disco fd_ballet fd_util fd_tango fd_reedsol)
+$(call make-unit-test,bench_fec_resolver,bench_fec_resolver,fd_disco fd_flamenco fd_tango fd_reedsol fd_ballet fd_util)
 $(call make-unit-test,test_stake_ci,test_stake_ci,fd_disco fd_flamenco fd_ballet fd_util fd_tango fd_reedsol)
 $(call run-unit-test,test_shred_dest,)
 $(call run-unit-test,test_fec_resolver,)
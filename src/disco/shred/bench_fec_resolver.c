@@ -0,0 +1,230 @@
+/* bench_fec_resolver measures the latency of fd_fec_resolver_add_shred,
+   the per shred work the shred tile does on shreds received from the
+   network, as a function of the packet loss rate.
+
+   A leader shreds --sets FEC sets of 32 data and 32 parity chained
+   Merkle shreds.  The shreds are delivered in order (data shreds then
+   parity shreds of each FEC set, as the leader sends them) and each one
+   is dropped with probability --loss percent.  If --loss is not given,
+   a range of loss rates is swept.
+
+   For each loss rate, reports latency percentiles over all shreds and
+   over the shreds that complete a FEC set, split by whether the set
+   had every data shred (missing parity shreds are regenerated by the
+   encoder) or was missing data shreds (general Reed-Solomon recovery).
+   The completing shreds are where the tile stalls: the latency of the
+   whole FEC set after them waits for the regeneration, the Merkle
+   checks and the reconstruction of the missing shreds.
+
+   This measures fd_fec_resolver_add_shred in isolation, on one core.
+   It does not include the rest of the shred tile's per shred work
+   (publishing completed sets, retransmission). */
+
+#include "fd_shredder.h"
+#include "fd_fec_resolver.h"
+#include "../../ballet/shred/fd_shred.h"
+#include "../../disco/metrics/fd_metrics.h"
+#include "../../tango/tempo/fd_tempo.h"
+#include <stdlib.h>
+
+#define SORT_NAME        sort_lat
+#define SORT_KEY_T       long
+#define SORT_BEFORE(a,b) ((a)<(b))
+#include "../../util/tmpl/fd_sort.c"
+
+#define SHRED_VER   ((ushort)6051)
+#define SHRED_STRIDE (FD_SHRED_MAX_SZ)
+
+uchar metrics_scratch[ FD_METRICS_FOOTPRINT( 0, 0 ) ] __attribute__((aligned(FD_METRICS_ALIGN)));
+
+struct signer_ctx {
+  fd_sha512_t sha512[ 1 ];
+  uchar       public_key [ 32 ];
+  uchar       private_key[ 32 ];
+};
+typedef struct signer_ctx signer_ctx_t;
+
+static void
+bench_signer( void *        _ctx,
+              uchar *       signature,
+              uchar const * merkle_root ) {
+  signer_ctx_t * ctx = (signer_ctx_t *)_ctx;
+  fd_ed25519_sign( signature, merkle_root, 32UL, ctx->public_key, ctx->private_key, ctx->sha512 );
+}
+
+static uchar *
+allocate_fec_set( fd_fec_set_t * set,
+                  uchar *        ptr ) {
+  for( ulong j=0UL; j<FD_REEDSOL_DATA_SHREDS_MAX;   j++ ) { set->data_shreds  [ j ] = ptr; ptr += SHRED_STRIDE; }
+  for( ulong j=0UL; j<FD_REEDSOL_PARITY_SHREDS_MAX; j++ ) { set->parity_shreds[ j ] = ptr; ptr += SHRED_STRIDE; }
+  return ptr;
+}
+
+#define FEC_SET_MEM_SZ ((FD_REEDSOL_DATA_SHREDS_MAX+FD_REEDSOL_PARITY_SHREDS_MAX)*SHRED_STRIDE)
+
+static void
+report( char const * name,
+        long *       lat,
+        ulong        cnt,
+        double       ns_per_tick ) {
+  if( !cnt ) { FD_LOG_NOTICE(( "  %-20s %7lu shreds", name, cnt )); return; }
+  sort_lat_inplace( lat, cnt );
+# define PCT(p) ((double)lat[ ((cnt-1UL)*(p))/1000UL ]*ns_per_tick)
+  FD_LOG_NOTICE(( "  %-20s %7lu shreds, p50 %8.0f  p90 %8.0f  p99 %8.0f  p99.9 %8.0f  max %8.0f ns",
+                  name, cnt, PCT(500UL), PCT(900UL), PCT(990UL), PCT(999UL), PCT(1000UL) ));
+# undef PCT
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  fd_metrics_register( (ulong *)fd_metrics_new( metrics_scratch, 0UL, 0UL ) );
+
+  ulong  set_cnt  = fd_env_strip_cmdline_ulong ( &argc, &argv, "--sets",     NULL,  256UL );
+  float  loss     = fd_env_strip_cmdline_float ( &argc, &argv, "--loss",     NULL,  -1.f  );
+  ulong  depth    = fd_env_strip_cmdline_ulong ( &argc, &argv, "--depth",    NULL,   64UL );
+  uint   rng_seed = fd_env_strip_cmdline_uint  ( &argc, &argv, "--rng-seed", NULL, 1234U  );
+
+  if( FD_UNLIKELY( !set_cnt || !depth || loss>100.f ) ) FD_LOG_ERR(( "bad arguments" ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, rng_seed, 0UL ) );
+
+  signer_ctx_t signer_ctx[1];
+  FD_TEST( fd_sha512_join( fd_sha512_new( signer_ctx->sha512 ) ) );
+  for( ulong i=0UL; i<32UL; i++ ) signer_ctx->private_key[ i ] = fd_rng_uchar( rng );
+  FD_TEST( fd_ed25519_public_from_private( signer_ctx->public_key, signer_ctx->private_key, signer_ctx->sha512 ) );
+
+  /* Shred one entry batch that fills set_cnt FEC sets exactly */
+
+  ulong  batch_sz = set_cnt*FD_SHREDDER_CHAINED_FEC_SET_PAYLOAD_SZ;
+  uchar * batch   = aligned_alloc( 128UL, fd_ulong_align_up( batch_sz, 128UL ) );
+  FD_TEST( batch );
+  for( ulong i=0UL; i<batch_sz; i++ ) batch[ i ] = fd_rng_uchar( rng );
+  FD_TEST( fd_shredder_count_fec_sets( batch_sz, FD_SHRED_TYPE_MERKLE_DATA_CHAINED )==set_cnt );
+
+  fd_fec_set_t * sets    = aligned_alloc( alignof(fd_fec_set_t), set_cnt*sizeof(fd_fec_set_t) );
+  uchar *        set_mem = aligned_alloc( 128UL, set_cnt*FEC_SET_MEM_SZ );
+  FD_TEST( sets && set_mem );
+
+  static fd_shredder_t _shredder[1];
+  fd_shredder_t * shredder = fd_shredder_join( fd_shredder_new( _shredder, bench_signer, signer_ctx, SHRED_VER ) );
+  FD_TEST( shredder );
+
+  fd_entry_batch_meta_t meta[1];
+  fd_memset( meta, 0, sizeof(fd_entry_batch_meta_t) );
+  meta->parent_offset  = 1UL;
+  meta->block_complete = 0; /* would make all the shreds resigned */
+
+  uchar chained_root[ 32 ] = { 0 };
+  FD_TEST( fd_shredder_init_batch( shredder, batch, batch_sz, 2UL, meta ) );
+  for( ulong s=0UL; s<set_cnt; s++ ) {
+    allocate_fec_set( sets+s, set_mem + s*FEC_SET_MEM_SZ );
+    FD_TEST( fd_shredder_next_fec_set( shredder, sets+s, chained_root ) );
+    FD_TEST( sets[ s ].data_shred_cnt==32UL && sets[ s ].parity_shred_cnt==32UL );
+  }
+  FD_TEST( fd_shredder_fini_batch( shredder ) );
+
+  /* Resolver, sized like in the shred tile */
+
+  ulong partial_depth  = 1UL;
+  ulong complete_depth = 8UL;
+  ulong done_depth     = 128UL*depth;
+  ulong res_set_cnt    = depth+partial_depth+complete_depth;
+  ulong footprint      = fd_fec_resolver_footprint( depth, partial_depth, complete_depth, done_depth );
+  FD_TEST( footprint );
+  void *         res_mem     = aligned_alloc( fd_fec_resolver_align(), footprint );
+  fd_fec_set_t * res_sets    = aligned_alloc( alignof(fd_fec_set_t), res_set_cnt*sizeof(fd_fec_set_t) );
+  uchar *        res_set_mem = aligned_alloc( 128UL, res_set_cnt*FEC_SET_MEM_SZ );
+  FD_TEST( res_mem && res_sets && res_set_mem );
+  for( ulong s=0UL; s<res_set_cnt; s++ ) allocate_fec_set( res_sets+s, res_set_mem + s*FEC_SET_MEM_SZ );
+
+  ulong shred_max = set_cnt*64UL;
+  long * lat_all       = aligned_alloc( alignof(long), shred_max*sizeof(long) );
+  long * lat_encoded   = aligned_alloc( alignof(long), set_cnt  *sizeof(long) );
+  long * lat_recovered = aligned_alloc( alignof(long), set_cnt  *sizeof(long) );
+  FD_TEST( lat_all && lat_encoded && lat_recovered );
+
+  double ns_per_tick = 1./fd_tempo_tick_per_ns( NULL );
+
+  static float const sweep[] = { 0.f, 0.5f, 2.f, 5.f, 10.f, 20.f, 40.f };
+  ulong  loss_cnt = loss<0.f ? sizeof(sweep)/sizeof(sweep[0]) : 1UL;
+
+  FD_LOG_NOTICE(( "%lu FEC sets of 32:32 chained Merkle shreds, resolver depth %lu", set_cnt, depth ));
+
+  for( ulong l=0UL; l<loss_cnt; l++ ) {
+    float loss_pct = loss<0.f ? sweep[ l ] : loss;
+    uint  drop_thresh = (uint)( (double)loss_pct*1e4 ); /* in parts per million */
+
+    /* A fresh resolver for each loss rate, so that no FEC set is known
+       to be done already */
+
+    fd_fec_resolver_t * resolver = fd_fec_resolver_join( fd_fec_resolver_new( res_mem, NULL, NULL, depth, partial_depth,
+                                                                              complete_depth, done_depth, res_sets, SHRED_VER, (ulong)UINT_MAX ) );
+    FD_TEST( resolver );
+
+    ulong encoded0   = FD_MCNT_GET( SHRED, FEC_SET_ENCODED   );
+    ulong recovered0 = FD_MCNT_GET( SHRED, FEC_SET_RECOVERED );
+
+    ulong all_cnt = 0UL, encoded_cnt = 0UL, recovered_cnt = 0UL, dropped_cnt = 0UL;
+    for( ulong s=0UL; s<set_cnt; s++ ) {
+      fd_fec_set_t const * set = sets+s;
+      ulong data_dropped = 0UL;
+      for( ulong j=0UL; j<64UL; j++ ) {
+        int     is_data = j<32UL;
+        uchar * raw     = is_data ? set->data_shreds[ j ] : set->parity_shreds[ j-32UL ];
+        if( fd_rng_uint_roll( rng, 1000000U )<drop_thresh ) {
+          dropped_cnt++;
+          data_dropped += (ulong)is_data;
+          continue;
+        }
+
+        fd_shred_t const * shred = fd_shred_parse( raw, FD_SHRED_MAX_SZ );
+        FD_TEST( shred );
+        fd_fec_set_t const * out_fec_set[1];
+        fd_shred_t const *   out_shred[1];
+        fd_bmtree_node_t     out_merkle_root[1];
+
+        long dt = -fd_tickcount();
+        int rv = fd_fec_resolver_add_shred( resolver, shred, FD_SHRED_MAX_SZ, signer_ctx->public_key, out_fec_set, out_shred, out_merkle_root );
+        dt += fd_tickcount();
+
+        FD_TEST( rv!=FD_FEC_RESOLVER_SHRED_REJECTED );
+        lat_all[ all_cnt++ ] = dt;
+        if( rv==FD_FEC_RESOLVER_SHRED_COMPLETES ) {
+          if( data_dropped ) lat_recovered[ recovered_cnt++ ] = dt;
+          else               lat_encoded  [ encoded_cnt++   ] = dt;
+        }
+      }
+    }
+
+    /* The resolver took the path we expected */
+
+    FD_TEST( FD_MCNT_GET( SHRED, FEC_SET_ENCODED   )-encoded0  ==encoded_cnt   );
+    FD_TEST( FD_MCNT_GET( SHRED, FEC_SET_RECOVERED )-recovered0==recovered_cnt );
+
+    FD_LOG_NOTICE(( "loss %5.1f%%: %lu shreds dropped, %lu of %lu FEC sets completed (%lu encoded, %lu recovered)",
+                    (double)loss_pct, dropped_cnt, encoded_cnt+recovered_cnt, set_cnt, encoded_cnt, recovered_cnt ));
+    report( "all shreds",           lat_all,       all_cnt,       ns_per_tick );
+    report( "completes, encoded",   lat_encoded,   encoded_cnt,   ns_per_tick );
+    report( "completes, recovered", lat_recovered, recovered_cnt, ns_per_tick );
+
+    fd_fec_resolver_delete( fd_fec_resolver_leave( resolver ) );
+  }
+
+  free( lat_recovered );
+  free( lat_encoded );
+  free( lat_all );
+  free( res_set_mem );
+  free( res_sets );
+  free( res_mem );
+  fd_shredder_delete( fd_shredder_leave( shredder ) );
+  free( set_mem );
+  free( sets );
+  free( batch );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -0,0 +1,181 @@
+/* bench_shred_dest measures the throughput of Turbine destination
+   computation for the shreds of an FEC set (32 data and 32 parity
+   shreds by default) on a synthetic cluster of --staked staked and
+   --unstaked unstaked validators with power law stake weights.
+
+   For the leader, compares computing the root of the tree for the
+   whole FEC set in one call (sampled as a batch) to computing it one
+   shred at a time.  The sampling step alone is also compared against
+   reseeding the sampler and sampling once per shred, which is what the
+   leader did for each shred before batching.  For a non-leader,
+   reports computing the children of the FEC set in one call. */
+
+#include "fd_shred_dest.h"
+#include <stdlib.h>
+
+#define FEC_SHRED_MAX (FD_SHRED_DEST_MAX_SHRED_CNT)
+
+static void
+fec_set_init( fd_shred_t * shreds,
+              ulong        data_cnt,
+              ulong        code_cnt,
+              ulong        slot,
+              ulong        fec_set_idx ) {
+  for( ulong i=0UL; i<data_cnt+code_cnt; i++ ) {
+    shreds[ i ].slot    = slot;
+    shreds[ i ].variant = fd_shred_variant( i<data_cnt ? FD_SHRED_TYPE_MERKLE_DATA : FD_SHRED_TYPE_MERKLE_CODE, 6 );
+    shreds[ i ].idx     = (uint)( fec_set_idx + fd_ulong_if( i<data_cnt, i, i-data_cnt ) );
+  }
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong staked_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--staked",   NULL, 4096UL );
+  ulong unstaked_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--unstaked", NULL, 1000UL );
+  ulong data_cnt     = fd_env_strip_cmdline_ulong( &argc, &argv, "--data",     NULL,   32UL );
+  ulong code_cnt     = fd_env_strip_cmdline_ulong( &argc, &argv, "--code",     NULL,   32UL );
+  ulong fanout       = fd_env_strip_cmdline_ulong( &argc, &argv, "--fanout",   NULL,  200UL );
+  ulong iter         = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter",     NULL, 1000UL );
+
+  ulong cnt       = staked_cnt + unstaked_cnt;
+  ulong shred_cnt = data_cnt + code_cnt;
+  if( FD_UNLIKELY( staked_cnt<2UL || shred_cnt>FEC_SHRED_MAX || !shred_cnt || fanout>FD_SHRED_DEST_MAX_FANOUT || !iter ) ) FD_LOG_ERR(( "bad arguments" ));
+
+  /* Synthetic cluster: stakes decay as 1/rank, staked before unstaked */
+
+  fd_shred_dest_weighted_t * info   = aligned_alloc( alignof(fd_shred_dest_weighted_t), cnt*sizeof(fd_shred_dest_weighted_t) );
+  fd_stake_weight_t        * stakes = aligned_alloc( alignof(fd_stake_weight_t),        staked_cnt*sizeof(fd_stake_weight_t)  );
+  FD_TEST( info && stakes );
+  fd_memset( info, 0, cnt*sizeof(fd_shred_dest_weighted_t) );
+  for( ulong i=0UL; i<cnt; i++ ) {
+    info[ i ].pubkey.ul[ 0 ]  = cnt-i;
+    info[ i ].pubkey.ul[ 1 ]  = fd_ulong_hash( i );
+    info[ i ].stake_lamports = i<staked_cnt ? 1000000000000000UL/(i+1UL) : 0UL;
+    info[ i ].ip4            = (uint)( i+1UL );
+    if( i<staked_cnt ) {
+      stakes[ i ].key   = info[ i ].pubkey;
+      stakes[ i ].stake = info[ i ].stake_lamports;
+    }
+  }
+
+  ulong slot_cnt = 1000UL;
+  void * lsched_mem = aligned_alloc( fd_epoch_leaders_align(), fd_epoch_leaders_footprint( staked_cnt, slot_cnt ) );
+  FD_TEST( lsched_mem );
+  fd_epoch_leaders_t * lsched = fd_epoch_leaders_join( fd_epoch_leaders_new( lsched_mem, 0UL, 0UL, slot_cnt, staked_cnt, stakes, 0UL ) );
+  FD_TEST( lsched );
+
+  /* The leader of slot 0 computes first, a validator ranked in the
+     middle of the staked ones computes children for slot 0. */
+
+  ulong               slot   = 0UL;
+  fd_pubkey_t const * leader = fd_epoch_leaders_get( lsched, slot );
+  ulong               mid    = staked_cnt/2UL;
+  if( !memcmp( leader, &info[ mid ].pubkey, 32UL ) ) mid++;
+
+  ulong footprint = fd_shred_dest_footprint( staked_cnt, unstaked_cnt );
+  void * leader_mem = aligned_alloc( fd_shred_dest_align(), footprint );
+  void * child_mem  = aligned_alloc( fd_shred_dest_align(), footprint );
+  FD_TEST( leader_mem && child_mem );
+  fd_shred_dest_t * sdest_leader = fd_shred_dest_join( fd_shred_dest_new( leader_mem, info, cnt, lsched, leader,            0UL ) );
+  fd_shred_dest_t * sdest_child  = fd_shred_dest_join( fd_shred_dest_new( child_mem,  info, cnt, lsched, &info[ mid ].pubkey, 0UL ) );
+  FD_TEST( sdest_leader && sdest_child );
+
+  static fd_shred_t          shreds   [ FEC_SHRED_MAX ];
+  static fd_shred_t const *  shred_ptr[ FEC_SHRED_MAX ];
+  static fd_shred_dest_idx_t out_batch[ FEC_SHRED_MAX ];
+  static fd_shred_dest_idx_t out_one  [ FEC_SHRED_MAX ];
+  for( ulong i=0UL; i<shred_cnt; i++ ) shred_ptr[ i ] = shreds+i;
+  fd_shred_dest_idx_t * out_children = aligned_alloc( alignof(fd_shred_dest_idx_t), fanout*shred_cnt*sizeof(fd_shred_dest_idx_t) );
+  FD_TEST( out_children );
+
+  FD_LOG_NOTICE(( "%lu staked, %lu unstaked validators, FEC set of %lu:%lu shreds, fanout %lu",
+                  staked_cnt, unstaked_cnt, data_cnt, code_cnt, fanout ));
+
+  /* Check that both ways agree, and warm up */
+
+  for( ulong j=0UL; j<16UL; j++ ) {
+    fec_set_init( shreds, data_cnt, code_cnt, slot, j*data_cnt );
+    FD_TEST( fd_shred_dest_compute_first( sdest_leader, shred_ptr, shred_cnt, out_batch ) );
+    for( ulong i=0UL; i<shred_cnt; i++ ) FD_TEST( fd_shred_dest_compute_first( sdest_leader, shred_ptr+i, 1UL, out_one+i ) );
+    for( ulong i=0UL; i<shred_cnt; i++ ) FD_TEST( out_batch[ i ]==out_one[ i ] );
+  }
+
+  long dt = -fd_log_wallclock();
+  for( ulong j=0UL; j<iter; j++ ) {
+    fec_set_init( shreds, data_cnt, code_cnt, slot, j*data_cnt );
+    FD_TEST( fd_shred_dest_compute_first( sdest_leader, shred_ptr, shred_cnt, out_batch ) );
+  }
+  dt += fd_log_wallclock();
+  double batch_ns = (double)dt / (double)(iter*shred_cnt);
+  FD_LOG_NOTICE(( "compute_first, FEC set per call: %8.1f ns/shred (%.2f Mshred/s)", batch_ns, 1e3/batch_ns ));
+
+  dt = -fd_log_wallclock();
+  for( ulong j=0UL; j<iter; j++ ) {
+    fec_set_init( shreds, data_cnt, code_cnt, slot, j*data_cnt );
+    for( ulong i=0UL; i<shred_cnt; i++ ) FD_TEST( fd_shred_dest_compute_first( sdest_leader, shred_ptr+i, 1UL, out_one+i ) );
+  }
+  dt += fd_log_wallclock();
+  double one_ns = (double)dt / (double)(iter*shred_cnt);
+  FD_LOG_NOTICE(( "compute_first, shred per call:   %8.1f ns/shred (%.2f Mshred/s), batch speedup %.2fx", one_ns, 1e3/one_ns, one_ns/batch_ns ));
+
+  /* Sampling step only, on the staked sampler of the leader (same tree
+     and weights) */
+
+  fd_wsample_t * staked = sdest_leader->staked;
+  static uchar         seeds   [ FEC_SHRED_MAX ][ 32 ];
+  static uchar const * seed_ptr[ FEC_SHRED_MAX ];
+  static ulong         idxs    [ FEC_SHRED_MAX ];
+  ulong sink = 0UL;
+  for( ulong i=0UL; i<shred_cnt; i++ ) seed_ptr[ i ] = seeds[ i ];
+
+  dt = -fd_log_wallclock();
+  for( ulong j=0UL; j<iter; j++ ) {
+    for( ulong i=0UL; i<shred_cnt; i++ ) FD_STORE( ulong, seeds[ i ], j*shred_cnt+i );
+    for( ulong i=0UL; i<shred_cnt; i++ ) {
+      fd_wsample_seed_rng( fd_wsample_get_rng( staked ), seeds[ i ] );
+      sink += fd_wsample_sample( staked );
+    }
+  }
+  dt += fd_log_wallclock();
+  double seq_ns = (double)dt / (double)(iter*shred_cnt);
+
+  dt = -fd_log_wallclock();
+  for( ulong j=0UL; j<iter; j++ ) {
+    for( ulong i=0UL; i<shred_cnt; i++ ) FD_STORE( ulong, seeds[ i ], j*shred_cnt+i );
+    fd_wsample_sample_batch( staked, seed_ptr, idxs, shred_cnt );
+    for( ulong i=0UL; i<shred_cnt; i++ ) sink -= idxs[ i ];
+  }
+  dt += fd_log_wallclock();
+  double wbatch_ns = (double)dt / (double)(iter*shred_cnt);
+  FD_TEST( !sink );
+  FD_LOG_NOTICE(( "sampling, reseed per shred:      %8.1f ns/shred", seq_ns ));
+  FD_LOG_NOTICE(( "sampling, batched:               %8.1f ns/shred, speedup %.2fx", wbatch_ns, seq_ns/wbatch_ns ));
+
+  ulong child_iter = fd_ulong_max( iter/20UL, 1UL );
+  ulong max_dest_cnt = 0UL;
+  dt = -fd_log_wallclock();
+  for( ulong j=0UL; j<child_iter; j++ ) {
+    fec_set_init( shreds, data_cnt, code_cnt, slot, j*data_cnt );
+    FD_TEST( fd_shred_dest_compute_children( sdest_child, shred_ptr, shred_cnt, out_children, shred_cnt, fanout, fanout, &max_dest_cnt ) );
+  }
+  dt += fd_log_wallclock();
+  double child_ns = (double)dt / (double)(child_iter*shred_cnt);
+  FD_LOG_NOTICE(( "compute_children (rank %lu):     %8.1f ns/shred (%.2f Mshred/s)", mid, child_ns, 1e3/child_ns ));
+
+  free( out_children );
+  fd_shred_dest_delete( fd_shred_dest_leave( sdest_child  ) );
+  fd_shred_dest_delete( fd_shred_dest_leave( sdest_leader ) );
+  free( child_mem );
+  free( leader_mem );
+  fd_epoch_leaders_delete( fd_epoch_leaders_leave( lsched ) );
+  free( lsched_mem );
+  free( stakes );
+  free( info );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
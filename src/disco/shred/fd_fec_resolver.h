@@ -189,7 +189,15 @@ fd_fec_resolver_t * fd_fec_resolver_join( void * shmem );
 
    This function returns SHRED_COMPLETES when the received shred is the
    last one and completes the FEC set.  In this case, the function
-   populates any missing shreds in the FEC set stored in out_fec_set. */
+   populates any missing shreds in the FEC set stored in out_fec_set.
+   This is done synchronously, before the call returns, and is the most
+   expensive part of the resolver.  If every data shred and exactly one
+   parity shred were received (the common case without packet loss),
+   the missing parity shreds are regenerated with the Reed-Solomon
+   encoder and the received one is checked against its re-encoding.
+   Otherwise, the missing shreds are reconstructed with the general
+   Reed-Solomon recovery.  There is no batching across FEC sets and
+   no offload to other tiles. */
 int fd_fec_resolver_add_shred( fd_fec_resolver_t    * resolver,
                                fd_shred_t const     * shred,
                                ulong                  shred_sz,
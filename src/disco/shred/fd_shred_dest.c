@@ -283,11 +283,20 @@ fd_shred_dest_compute_first( fd_shred_dest_t          * sdest,
     fd_wsample_remove_idx( sdest->staked, sdest->source_validator_orig_idx );
 
   int any_staked_candidates = sdest->staked_cnt > (ulong)source_validator_is_staked;
-  for( ulong i=0UL; i<shred_cnt; i++ ) {
-    fd_wsample_seed_rng( fd_wsample_get_rng( sdest->staked ), dest_hash_outputs[ i ] );
+  if( FD_LIKELY( any_staked_candidates ) ) {
+    /* Each shred only needs one sample from its own stream, so sample
+       the whole batch at once. */
+    uchar const * seeds[ FD_SHRED_DEST_MAX_SHRED_CNT ];
+    ulong         idxs [ FD_SHRED_DEST_MAX_SHRED_CNT ];
+    for( ulong i=0UL; i<shred_cnt; i++ ) seeds[ i ] = dest_hash_outputs[ i ];
+    fd_wsample_sample_batch( sdest->staked, seeds, idxs, shred_cnt );
     /* Map FD_WSAMPLE_INDETERMINATE to FD_SHRED_DEST_NO_DEST */
-    if( FD_LIKELY( any_staked_candidates ) ) out[i] = (fd_shred_dest_idx_t)fd_ulong_min( fd_wsample_sample( sdest->staked ), FD_SHRED_DEST_NO_DEST );
-    else                                     out[i] = (fd_shred_dest_idx_t)sample_unstaked_noprepare( sdest, sdest->source_validator_orig_idx );
+    for( ulong i=0UL; i<shred_cnt; i++ ) out[i] = (fd_shred_dest_idx_t)fd_ulong_min( idxs[ i ], FD_SHRED_DEST_NO_DEST );
+  } else {
+    for( ulong i=0UL; i<shred_cnt; i++ ) {
+      fd_wsample_seed_rng( fd_wsample_get_rng( sdest->staked ), dest_hash_outputs[ i ] );
+      out[i] = (fd_shred_dest_idx_t)sample_unstaked_noprepare( sdest, sdest->source_validator_orig_idx );
+    }
   }
   fd_wsample_restore_all( sdest->staked );
 
@@ -154,9 +154,10 @@ static inline ulong fd_shred_dest_cnt_all     ( fd_shred_dest_t * sdest ) { retu
    67].  The destination index for input_shreds[i] is stored at out[i].
    input_shreds==NULL is fine if shred_cnt==0, in which case this
    function is a no-op.  Returns out on success and NULL on failure.
-   This function uses the sha256 batch API internally for performance,
-   which is why it operates on several shreds at the same time as
-   opposed to one at a time. */
+   This function uses the sha256 batch API and batched weighted sampling
+   (fd_wsample_sample_batch) internally for performance, which is why it
+   operates on several shreds at the same time as opposed to one at a
+   time.  Passing all the shreds of an FEC set at once is best. */
 fd_shred_dest_idx_t *
 fd_shred_dest_compute_first( fd_shred_dest_t          * sdest,
                              fd_shred_t const * const * input_shreds,
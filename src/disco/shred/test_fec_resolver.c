@@ -130,6 +130,9 @@ test_one_batch( void ) {
       int retval = fd_fec_resolver_add_shred( resolver, __parsed, 2048UL, pubkey, out_fec, out_shred, out_merkle_root ); \
       FD_TEST( retval==FD_FEC_RESOLVER_SHRED_ ## expected );                                                                  \
       } while( 0 )
+  ulong encoded0   = FD_MCNT_GET( SHRED, FEC_SET_ENCODED   );
+  ulong recovered0 = FD_MCNT_GET( SHRED, FEC_SET_RECOVERED );
+
   /* To complete an FEC set, you need at least (# of data shreds) total
      shreds and at least one parity shred. */
   for( ulong i=0UL; i<7UL; i++ ) {
@@ -153,6 +156,10 @@ test_one_batch( void ) {
   }
   FD_TEST( fd_shredder_fini_batch( shredder ) );
 
+  /* r1 had every data shred, so it only had to encode the parity */
+  FD_TEST( FD_MCNT_GET( SHRED, FEC_SET_ENCODED   )-encoded0  == 7UL );
+  FD_TEST( FD_MCNT_GET( SHRED, FEC_SET_RECOVERED )-recovered0==14UL );
+
   fd_fec_resolver_delete( fd_fec_resolver_leave( r3 ) );
   fd_fec_resolver_delete( fd_fec_resolver_leave( r2 ) );
   fd_fec_resolver_delete( fd_fec_resolver_leave( r1 ) );
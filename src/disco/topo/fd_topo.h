@@ -142,10 +142,14 @@ typedef struct {
       long   tx_flush_timeout_ns;
       char   xdp_mode[8];
       int    zero_copy;
+      int    multi_buffer;
 
       /* sock specific options */
       int so_sndbuf;
       int so_rcvbuf;
+      int udp_gso;
+      int udp_gro;
+      int io_uring;
 
       ushort shred_listen_port;
       ushort quic_transaction_listen_port;
@@ -321,7 +325,9 @@ typedef struct {
     } restart;
 
     struct {
-      char funk_file[ PATH_MAX ];
+      char  funk_file[ PATH_MAX ];
+      ulong sbpf_jit_program_max; /* 0 if the sBPF JIT is disabled */
+      ulong sbpf_jit_code_sz;
     } exec;
 
     struct {
@@ -2,4 +2,5 @@ ifdef FD_HAS_SSE
 $(call add-objs,fd_verify_tile,fd_disco)
 $(call make-unit-test,test_tiles_verify,test_verify,fd_ballet fd_tango fd_util)
 $(call run-unit-test,test_tiles_verify)
+$(call make-unit-test,bench_verify,bench_verify,fd_ballet fd_tango fd_util)
 endif
@@ -0,0 +1,150 @@
+/* bench_verify measures the signature verification throughput of a
+   single verify tile core under the synthetic load of
+   verify_synth_load.c: each packet is public_key(32) | sig(64) |
+   msg(msg_sz) with one valid signature, and packet sizes follow the
+   same burst model (bursts of exponentially distributed byte counts
+   with mean --burst-avg, chopped into packets of at most --msg-max
+   bytes).  The load is verified one signature at a time
+   (fd_ed25519_verify, what the verify tile did per transaction
+   before) and in batches of up to FD_TXN_VERIFY_BATCH_MAX signatures
+   (fd_ed25519_verify_batch_multi_msg, what the verify tile does now).
+
+   A --errsv-frac fraction of the packets have a corrupted signature to
+   check that a bad signature only fails its own packet. */
+
+#include "fd_verify_tile.h"
+
+#define MSG_SZ_MIN (0UL)
+#define MSG_SZ_MAX (1232UL-64UL-32UL)
+#define PKT_MAX    (1UL<<14)
+
+/* Reference packet for each possible size, as in verify_synth_load */
+
+static uchar ref_msg[ MSG_SZ_MAX-MSG_SZ_MIN+1UL ][ 96UL+MSG_SZ_MAX ] __attribute__((aligned(128)));
+
+/* The synthetic load */
+
+static uchar const * pkt_tbl   [ PKT_MAX ];
+static ulong         pkt_sz_tbl[ PKT_MAX ];
+static uchar         pkt_bad   [ PKT_MAX ];
+static uchar         bad_mem   [ PKT_MAX ][ 64 ];
+
+__attribute__((noinline)) static ulong
+bench_one( ulong pkt_cnt ) {
+  fd_sha512_t _sha[1]; fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( _sha ) );
+  ulong fail_cnt = 0UL;
+  for( ulong i=0UL; i<pkt_cnt; i++ ) {
+    uchar const * pkt = pkt_tbl[ i ];
+    uchar const * sig = pkt_bad[ i ] ? bad_mem[ i ] : pkt+32UL;
+    fail_cnt += !!fd_ed25519_verify( pkt+96UL, pkt_sz_tbl[ i ], sig, pkt, sha );
+  }
+  fd_sha512_delete( fd_sha512_leave( sha ) );
+  return fail_cnt;
+}
+
+__attribute__((noinline)) static ulong
+bench_batch( ulong pkt_cnt ) {
+  uchar const * msg   [ FD_TXN_VERIFY_BATCH_MAX ];
+  ulong         msg_sz[ FD_TXN_VERIFY_BATCH_MAX ];
+  uchar const * sig   [ FD_TXN_VERIFY_BATCH_MAX ];
+  uchar const * pub   [ FD_TXN_VERIFY_BATCH_MAX ];
+  int           err   [ FD_TXN_VERIFY_BATCH_MAX ];
+  ulong fail_cnt = 0UL;
+  for( ulong i=0UL; i<pkt_cnt; i+=FD_TXN_VERIFY_BATCH_MAX ) {
+    ulong batch_sz = fd_ulong_min( FD_TXN_VERIFY_BATCH_MAX, pkt_cnt-i );
+    for( ulong j=0UL; j<batch_sz; j++ ) {
+      uchar const * pkt = pkt_tbl[ i+j ];
+      pub   [ j ] = pkt;
+      sig   [ j ] = pkt_bad[ i+j ] ? bad_mem[ i+j ] : pkt+32UL;
+      msg   [ j ] = pkt+96UL;
+      msg_sz[ j ] = pkt_sz_tbl[ i+j ];
+    }
+    fd_ed25519_verify_batch_multi_msg( msg, msg_sz, sig, pub, err, batch_sz );
+    for( ulong j=0UL; j<batch_sz; j++ ) {
+      FD_TEST( !err[ j ]==!pkt_bad[ i+j ] );
+      fail_cnt += !!err[ j ];
+    }
+  }
+  return fail_cnt;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong pkt_cnt    = fd_env_strip_cmdline_ulong( &argc, &argv, "--pkt-cnt",    NULL, 4096UL     );
+  float burst_avg  = fd_env_strip_cmdline_float( &argc, &argv, "--burst-avg",  NULL, 324.f      );
+  ulong msg_max    = fd_env_strip_cmdline_ulong( &argc, &argv, "--msg-max",    NULL, MSG_SZ_MAX );
+  float errsv_frac = fd_env_strip_cmdline_float( &argc, &argv, "--errsv-frac", NULL, 1e-3f      );
+  ulong iter_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter",       NULL, 4UL        );
+  uint  rng_seed   = fd_env_strip_cmdline_uint ( &argc, &argv, "--rng-seed",   NULL, 1234U      );
+
+  if( FD_UNLIKELY( !pkt_cnt || pkt_cnt>PKT_MAX ) ) FD_LOG_ERR(( "--pkt-cnt must be in [1,%lu]", PKT_MAX ));
+  if( FD_UNLIKELY( msg_max>MSG_SZ_MAX          ) ) FD_LOG_ERR(( "--msg-max must be at most %lu", MSG_SZ_MAX ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, rng_seed, 0UL ) );
+  fd_sha512_t _sha[1]; fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( _sha ) );
+
+  FD_LOG_NOTICE(( "signing reference packets" ));
+  for( ulong msg_sz=MSG_SZ_MIN; msg_sz<=MSG_SZ_MAX; msg_sz++ ) {
+    uchar * public_key = ref_msg[ msg_sz-MSG_SZ_MIN ];
+    uchar * sig        = public_key + 32UL;
+    uchar * msg        = sig        + 64UL;
+    uchar private_key[ 32 ];
+    for( ulong b=0UL; b<32UL;   b++ ) private_key[ b ] = fd_rng_uchar( rng );
+    for( ulong b=0UL; b<msg_sz; b++ ) msg        [ b ] = fd_rng_uchar( rng );
+    fd_ed25519_public_from_private( public_key, private_key, sha );
+    fd_ed25519_sign( sig, msg, msg_sz, public_key, private_key, sha );
+  }
+
+  /* Generate the load with the burst model of verify_synth_load */
+
+  uint  errsv_thresh = (uint)(0.5f + errsv_frac*(float)(1UL<<32));
+  ulong burst_rem    = 0UL;
+  ulong byte_cnt     = 0UL;
+  ulong bad_cnt      = 0UL;
+  for( ulong i=0UL; i<pkt_cnt; i++ ) {
+    while( FD_UNLIKELY( !burst_rem ) ) burst_rem = (ulong)(long)(0.5f + burst_avg*fd_rng_float_exp( rng ));
+    ulong msg_sz = fd_ulong_min( burst_rem, msg_max );
+    burst_rem -= msg_sz;
+
+    pkt_tbl   [ i ] = ref_msg[ msg_sz-MSG_SZ_MIN ];
+    pkt_sz_tbl[ i ] = msg_sz;
+    pkt_bad   [ i ] = fd_rng_uint( rng )<errsv_thresh;
+    if( pkt_bad[ i ] ) {
+      fd_memcpy( bad_mem[ i ], pkt_tbl[ i ]+32UL, 64UL );
+      bad_mem[ i ][ fd_rng_ulong_roll( rng, 32UL ) ] ^= (uchar)1;
+      bad_cnt++;
+    }
+    byte_cnt += msg_sz;
+  }
+  FD_LOG_NOTICE(( "%lu packets, %.1f msg bytes per packet avg, %lu bad signatures",
+                  pkt_cnt, (double)byte_cnt/(double)pkt_cnt, bad_cnt ));
+
+  /* warmup */
+
+  FD_TEST( bench_one  ( pkt_cnt )==bad_cnt );
+  FD_TEST( bench_batch( pkt_cnt )==bad_cnt );
+
+  /* for real */
+
+  long dt_one = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) bench_one( pkt_cnt );
+  dt_one += fd_log_wallclock();
+
+  long dt_batch = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) bench_batch( pkt_cnt );
+  dt_batch += fd_log_wallclock();
+
+  double tot = (double)( pkt_cnt*iter_cnt );
+  FD_LOG_NOTICE(( "one at a time: %.3e sigs/s per core (%.1f ns per sig)", tot*1e9/(double)dt_one,   (double)dt_one  /tot ));
+  FD_LOG_NOTICE(( "batch of %2lu:   %.3e sigs/s per core (%.1f ns per sig)", FD_TXN_VERIFY_BATCH_MAX,
+                  tot*1e9/(double)dt_batch, (double)dt_batch/tot ));
+
+  fd_sha512_delete( fd_sha512_leave( sha ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
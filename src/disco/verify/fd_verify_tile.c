@@ -41,6 +41,8 @@ before_frag( fd_verify_ctx_t * ctx,
              ulong             in_idx,
              ulong             seq,
              ulong             sig ) {
+  ctx->idle_cnt = 0UL;
+
   /* Bundle tile can produce both "bundles" and "packets", a packet is a
      regular transaction and should be round-robined between verify
      tiles, while bundles need to go through verify:0 currently to
@@ -94,6 +96,48 @@ during_frag( fd_verify_ctx_t * ctx,
   }
 }
 
+/* flush_batch verifies all pending transactions and publishes the
+   ones that passed, in the order they were received. */
+
+static void
+flush_batch( fd_verify_ctx_t *   ctx,
+             fd_stem_context_t * stem ) {
+  if( FD_UNLIKELY( !ctx->batch.txn_cnt ) ) return;
+
+  fd_txn_verify_batch_exec( ctx );
+
+  ulong tspub = (ulong)fd_frag_meta_ts_comp( fd_tickcount() );
+  for( ulong i=0UL; i<ctx->batch.txn_cnt; i++ ) {
+    int res = ctx->batch.txn[ i ].res;
+    if( FD_LIKELY( res==FD_TXN_VERIFY_SUCCESS ) ) {
+      fd_stem_publish( stem, 0UL, 0UL, ctx->batch.txn[ i ].chunk, ctx->batch.txn[ i ].sz, 0UL, ctx->batch.txn[ i ].tsorig, tspub );
+    } else if( FD_LIKELY( res==FD_TXN_VERIFY_DEDUP ) ) {
+      ctx->metrics.dedup_fail_cnt++;
+    } else {
+      ctx->metrics.verify_fail_cnt++;
+    }
+  }
+  fd_txn_verify_batch_reset( ctx );
+}
+
+/* Pending transactions are flushed when the batch is full or at the
+   end of a burst, which is when all ins were polled once without
+   finding a new frag. */
+
+static inline void
+after_credit( fd_verify_ctx_t *   ctx,
+              fd_stem_context_t * stem,
+              int *               opt_poll_in,
+              int *               charge_busy ) {
+  (void)opt_poll_in;
+
+  if( FD_LIKELY( !ctx->batch.txn_cnt ) ) return;
+  if( FD_UNLIKELY( ctx->idle_cnt++>=ctx->in_cnt ) ) {
+    flush_batch( ctx, stem );
+    *charge_busy = 1;
+  }
+}
+
 static inline void
 after_frag( fd_verify_ctx_t *   ctx,
             ulong               in_idx,
@@ -115,18 +159,50 @@ after_frag( fd_verify_ctx_t *   ctx,
 
   int is_bundle = !!txnm->block_engine.bundle_id;
 
-  if( FD_UNLIKELY( is_bundle & (txnm->block_engine.bundle_id!=ctx->bundle_id) ) ) {
+  if( FD_LIKELY( !is_bundle ) ) {
+    if( FD_UNLIKELY( !txnm->txn_t_sz ) ) {
+      ctx->metrics.parse_fail_cnt++;
+      return;
+    }
+
+    if( FD_UNLIKELY( !fd_txn_verify_batch_room( ctx, txnt ) ) ) flush_batch( ctx, stem );
+
+    int res = fd_txn_verify_batch_add( ctx, fd_txn_m_payload( txnm ), txnm->payload_sz, txnt, 1 );
+    if( FD_UNLIKELY( res!=FD_TXN_VERIFY_SUCCESS ) ) {
+      ctx->metrics.dedup_fail_cnt++;
+      return;
+    }
+
+    ulong realized_sz = fd_txn_m_realized_footprint( txnm, 1, 0 );
+    ulong txn_idx = ctx->batch.txn_cnt-1UL;
+    ctx->batch.txn[ txn_idx ].chunk  = ctx->out_chunk;
+    ctx->batch.txn[ txn_idx ].sz     = realized_sz;
+    ctx->batch.txn[ txn_idx ].tsorig = tsorig;
+    ctx->out_chunk = fd_dcache_compact_next( ctx->out_chunk, realized_sz, ctx->out_chunk0, ctx->out_wmark );
+
+    if( FD_UNLIKELY( ctx->batch.sig_cnt==FD_TXN_VERIFY_BATCH_MAX ) ) flush_batch( ctx, stem );
+    return;
+  }
+
+  /* Bundles are rare and whether a bundle transaction is dropped
+     depends on the result of the previous transactions of the bundle,
+     so they are verified one at a time.  Anything pending is flushed
+     first to preserve the order of the stream. */
+
+  flush_batch( ctx, stem );
+
+  if( FD_UNLIKELY( txnm->block_engine.bundle_id!=ctx->bundle_id ) ) {
     ctx->bundle_failed = 0;
     ctx->bundle_id     = txnm->block_engine.bundle_id;
   }
 
-  if( FD_UNLIKELY( is_bundle & (!!ctx->bundle_failed) ) ) {
+  if( FD_UNLIKELY( ctx->bundle_failed ) ) {
     ctx->metrics.bundle_peer_fail_cnt++;
     return;
   }
 
   if( FD_UNLIKELY( !txnm->txn_t_sz ) ) {
-    if( FD_UNLIKELY( is_bundle ) ) ctx->bundle_failed = 1;
+    ctx->bundle_failed = 1;
     ctx->metrics.parse_fail_cnt++;
     return;
   }
@@ -138,13 +214,10 @@ after_frag( fd_verify_ctx_t *   ctx,
      will still do a full-bundle dedup check to make sure to drop any
      identical bundles. */
   ulong _txn_sig;
-  int res = fd_txn_verify( ctx, fd_txn_m_payload( txnm ), txnm->payload_sz, txnt, !is_bundle, &_txn_sig );
+  int res = fd_txn_verify( ctx, fd_txn_m_payload( txnm ), txnm->payload_sz, txnt, 0, &_txn_sig );
   if( FD_UNLIKELY( res!=FD_TXN_VERIFY_SUCCESS ) ) {
-    if( FD_UNLIKELY( is_bundle ) ) ctx->bundle_failed = 1;
-
-    if( FD_LIKELY( res==FD_TXN_VERIFY_DEDUP ) ) ctx->metrics.dedup_fail_cnt++;
-    else                                        ctx->metrics.verify_fail_cnt++;
-
+    ctx->bundle_failed = 1;
+    ctx->metrics.verify_fail_cnt++;
     return;
   }
 
@@ -186,6 +259,10 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->bundle_failed = 0;
   ctx->bundle_id     = 0UL;
 
+  fd_txn_verify_batch_reset( ctx );
+  ctx->in_cnt   = tile->in_cnt;
+  ctx->idle_cnt = 0UL;
+
   memset( &ctx->metrics, 0, sizeof( ctx->metrics ) );
 
   ctx->tcache_depth   = fd_tcache_depth       ( tcache );
@@ -247,12 +324,15 @@ populate_allowed_fds( fd_topo_t const *      topo,
   return out_cnt;
 }
 
-#define STEM_BURST (1UL)
+/* A flush can publish every transaction of a full batch, see
+   FD_TXN_VERIFY_BATCH_MAX. */
+#define STEM_BURST FD_TXN_VERIFY_BATCH_MAX
 
 #define STEM_CALLBACK_CONTEXT_TYPE  fd_verify_ctx_t
 #define STEM_CALLBACK_CONTEXT_ALIGN alignof(fd_verify_ctx_t)
 
 #define STEM_CALLBACK_METRICS_WRITE metrics_write
+#define STEM_CALLBACK_AFTER_CREDIT  after_credit
 #define STEM_CALLBACK_BEFORE_FRAG   before_frag
 #define STEM_CALLBACK_DURING_FRAG   during_frag
 #define STEM_CALLBACK_AFTER_FRAG    after_frag
@@ -7,6 +7,14 @@
 #define FD_TXN_VERIFY_FAILED  -1
 #define FD_TXN_VERIFY_DEDUP   -2
 
+/* FD_TXN_VERIFY_BATCH_MAX is the max number of signatures the verify
+   tile checks together (see fd_txn_verify_batch_add below).  A batch
+   always holds at least one transaction per FD_TXN_ACTUAL_SIG_MAX
+   signatures, so it holds at most FD_TXN_VERIFY_BATCH_MAX
+   transactions. */
+
+#define FD_TXN_VERIFY_BATCH_MAX FD_ED25519_VERIFY_BATCH_MAX
+
 extern fd_topo_run_tile_t fd_tile_verify;
 
 /* fd_verify_in_ctx_t is a context object for each in (producer) mcache
@@ -19,7 +27,8 @@ typedef struct {
 } fd_verify_in_ctx_t;
 
 typedef struct {
-  /* TODO switch to fd_sha512_batch_t? */
+  /* Used by fd_txn_verify only, the batched path hashes with
+     fd_sha512_batch (see fd_ed25519_verify_batch_multi_msg). */
   fd_sha512_t * sha[ FD_TXN_ACTUAL_SIG_MAX ];
 
   int   bundle_failed;
@@ -36,6 +45,8 @@ typedef struct {
 
   ulong              in_kind[ 32 ];
   fd_verify_in_ctx_t in[ 32 ];
+  ulong              in_cnt;
+  ulong              idle_cnt; /* in polls since the last frag, used to detect the end of a burst */
 
   fd_wksp_t * out_mem;
   ulong       out_chunk0;
@@ -44,6 +55,30 @@ typedef struct {
 
   ulong       hashmap_seed;
 
+  /* Transactions whose signatures are pending verification.  Each
+     pending transaction already owns its own chunk in the out dcache
+     (out_chunk is advanced past it when it gets added) and is published
+     (or dropped) when the batch gets flushed. */
+
+  struct {
+    ulong         txn_cnt;
+    ulong         sig_cnt;
+    uchar const * msg   [ FD_TXN_VERIFY_BATCH_MAX ];
+    ulong         msg_sz[ FD_TXN_VERIFY_BATCH_MAX ];
+    uchar const * sig   [ FD_TXN_VERIFY_BATCH_MAX ];
+    uchar const * pubkey[ FD_TXN_VERIFY_BATCH_MAX ];
+    int           err   [ FD_TXN_VERIFY_BATCH_MAX ];
+    struct {
+      ulong tag;     /* ha dedup tag */
+      ulong sig_cnt;
+      int   dedup;
+      int   res;     /* FD_TXN_VERIFY_{SUCCESS,FAILED,DEDUP}, set by fd_txn_verify_batch_exec */
+      ulong chunk;   /* out chunk, owned by the tile */
+      ulong sz;
+      ulong tsorig;
+    } txn[ FD_TXN_VERIFY_BATCH_MAX ];
+  } batch;
+
   struct {
     ulong parse_fail_cnt;
     ulong verify_fail_cnt;
@@ -103,4 +138,104 @@ fd_txn_verify( fd_verify_ctx_t * ctx,
   return FD_TXN_VERIFY_SUCCESS;
 }
 
+/* fd_txn_verify_batch_room returns 1 if the signatures of txn fit in
+   the pending batch and 0 otherwise. */
+
+static inline int
+fd_txn_verify_batch_room( fd_verify_ctx_t const * ctx,
+                          fd_txn_t const *        txn ) {
+  return ctx->batch.sig_cnt + txn->signature_cnt <= FD_TXN_VERIFY_BATCH_MAX;
+}
+
+/* fd_txn_verify_batch_add is the batched version of fd_txn_verify.  It
+   does the HA dedup query of fd_txn_verify right away and, if the
+   transaction is not a duplicate, queues its signatures for
+   verification and returns FD_TXN_VERIFY_SUCCESS (the transaction is
+   then batch.txn[ batch.txn_cnt-1 ]).  Returns FD_TXN_VERIFY_DEDUP
+   otherwise (nothing is queued).  The caller must ensure the batch has
+   room for the transaction's signatures (fd_txn_verify_batch_room) and
+   that udp_payload stays valid until the batch is executed. */
+
+static inline int
+fd_txn_verify_batch_add( fd_verify_ctx_t * ctx,
+                         uchar const *     udp_payload,
+                         ushort const      payload_sz,
+                         fd_txn_t const *  txn,
+                         int               dedup ) {
+
+  uchar  signature_cnt = txn->signature_cnt;
+  ushort signature_off = txn->signature_off;
+  ushort acct_addr_off = txn->acct_addr_off;
+  ushort message_off   = txn->message_off;
+
+  uchar const * signatures = udp_payload + signature_off;
+  uchar const * pubkeys = udp_payload + acct_addr_off;
+  uchar const * msg = udp_payload + message_off;
+  ulong msg_sz = (ulong)payload_sz - message_off;
+
+  ulong ha_dedup_tag = fd_hash( ctx->hashmap_seed, signatures, 64UL );
+  if( FD_LIKELY( dedup ) ) {
+    int ha_dup = 0;
+    FD_FN_UNUSED ulong tcache_map_idx = 0; /* ignored */
+    FD_TCACHE_QUERY( ha_dup, tcache_map_idx, ctx->tcache_map, ctx->tcache_map_cnt, ha_dedup_tag );
+    if( FD_UNLIKELY( ha_dup ) ) {
+      return FD_TXN_VERIFY_DEDUP;
+    }
+  }
+
+  ulong sig_cnt = ctx->batch.sig_cnt;
+  for( ulong j=0UL; j<signature_cnt; j++ ) {
+    ctx->batch.msg   [ sig_cnt+j ] = msg;
+    ctx->batch.msg_sz[ sig_cnt+j ] = msg_sz;
+    ctx->batch.sig   [ sig_cnt+j ] = signatures + 64UL*j;
+    ctx->batch.pubkey[ sig_cnt+j ] = pubkeys    + 32UL*j;
+  }
+  ctx->batch.sig_cnt = sig_cnt + signature_cnt;
+
+  ulong txn_idx = ctx->batch.txn_cnt++;
+  ctx->batch.txn[ txn_idx ].tag     = ha_dedup_tag;
+  ctx->batch.txn[ txn_idx ].sig_cnt = signature_cnt;
+  ctx->batch.txn[ txn_idx ].dedup   = dedup;
+  return FD_TXN_VERIFY_SUCCESS;
+}
+
+/* fd_txn_verify_batch_exec verifies all the signatures queued in the
+   batch and sets batch.txn[i].res for all queued transactions to the
+   value fd_txn_verify would have returned for them (in particular, a
+   bad signature only fails its own transaction).  Successful
+   transactions are inserted into the HA dedup tcache in queue order.
+   The caller is expected to consume the results and then empty the
+   batch with fd_txn_verify_batch_reset. */
+
+static inline void
+fd_txn_verify_batch_exec( fd_verify_ctx_t * ctx ) {
+  ulong txn_cnt = ctx->batch.txn_cnt;
+  if( FD_UNLIKELY( !txn_cnt ) ) return;
+
+  fd_ed25519_verify_batch_multi_msg( ctx->batch.msg, ctx->batch.msg_sz, ctx->batch.sig, ctx->batch.pubkey,
+                                     ctx->batch.err, ctx->batch.sig_cnt );
+
+  int const * err = ctx->batch.err;
+  for( ulong i=0UL; i<txn_cnt; i++ ) {
+    ulong sig_cnt = ctx->batch.txn[ i ].sig_cnt;
+    int   ok      = 1;
+    for( ulong j=0UL; j<sig_cnt; j++ ) ok &= !err[ j ];
+    err += sig_cnt;
+
+    int res = ok ? FD_TXN_VERIFY_SUCCESS : FD_TXN_VERIFY_FAILED;
+    if( FD_LIKELY( ok && ctx->batch.txn[ i ].dedup ) ) {
+      int ha_dup;
+      FD_TCACHE_INSERT( ha_dup, *ctx->tcache_sync, ctx->tcache_ring, ctx->tcache_depth, ctx->tcache_map, ctx->tcache_map_cnt, ctx->batch.txn[ i ].tag );
+      if( FD_UNLIKELY( ha_dup ) ) res = FD_TXN_VERIFY_DEDUP;
+    }
+    ctx->batch.txn[ i ].res = res;
+  }
+}
+
+static inline void
+fd_txn_verify_batch_reset( fd_verify_ctx_t * ctx ) {
+  ctx->batch.txn_cnt = 0UL;
+  ctx->batch.sig_cnt = 0UL;
+}
+
 #endif /* HEADER_fd_src_disco_verify_fd_verify_tile_h */
@@ -345,6 +345,65 @@ test_verify_invalid_dedup_with_collision_success( void ) {
   free_verify_ctx( ctx, mem );
 }
 
+static void
+test_verify_batch( void ) {
+  fd_verify_ctx_t ctx[1];
+  void *          mem = NULL;
+  uchar           out_buf[4][FD_TXN_MAX_SZ];
+  uchar *         payload[4];
+  ulong           payload_sz[4];
+
+  FD_LOG_NOTICE(( "test_verify_batch" ));
+  setup_verify_ctx( ctx, &mem );
+
+  payload[0] = load_test_txn( valid_txn_2sigs,   sizeof(valid_txn_2sigs),   &payload_sz[0] );
+  payload[1] = load_test_txn( invalid_txn_2sigs, sizeof(invalid_txn_2sigs), &payload_sz[1] );
+  payload[2] = load_test_txn( valid_txn_1sig,    sizeof(valid_txn_1sig),    &payload_sz[2] );
+  payload[3] = load_test_txn( valid_txn_1sig,    sizeof(valid_txn_1sig),    &payload_sz[3] );
+  for( ulong i=0UL; i<4UL; i++ ) FD_TEST( fd_txn_parse( payload[i], payload_sz[i], out_buf[i], NULL ) );
+
+  /* A bad transaction in the middle of the batch only fails itself and
+     a duplicate within the same batch is caught when executing. */
+  for( ulong i=0UL; i<4UL; i++ ) {
+    FD_TEST( fd_txn_verify_batch_room( ctx, (fd_txn_t *)out_buf[i] ) );
+    FD_TEST( fd_txn_verify_batch_add( ctx, payload[i], (ushort)payload_sz[i], (fd_txn_t *)out_buf[i], 1 )==FD_TXN_VERIFY_SUCCESS );
+  }
+  FD_TEST( ctx->batch.txn_cnt==4UL && ctx->batch.sig_cnt==6UL );
+  fd_txn_verify_batch_exec( ctx );
+  FD_TEST( ctx->batch.txn[0].res==FD_TXN_VERIFY_SUCCESS );
+  FD_TEST( ctx->batch.txn[1].res==FD_TXN_VERIFY_FAILED  );
+  FD_TEST( ctx->batch.txn[2].res==FD_TXN_VERIFY_SUCCESS );
+  FD_TEST( ctx->batch.txn[3].res==FD_TXN_VERIFY_DEDUP   );
+  fd_txn_verify_batch_reset( ctx );
+
+  /* Already verified transactions are deduped when added (including
+     bad ones with the same first signature), unless dedup is
+     disabled */
+  FD_TEST( fd_txn_verify_batch_add( ctx, payload[0], (ushort)payload_sz[0], (fd_txn_t *)out_buf[0], 1 )==FD_TXN_VERIFY_DEDUP   );
+  FD_TEST( fd_txn_verify_batch_add( ctx, payload[1], (ushort)payload_sz[1], (fd_txn_t *)out_buf[1], 1 )==FD_TXN_VERIFY_DEDUP   );
+  FD_TEST( ctx->batch.txn_cnt==0UL );
+  FD_TEST( fd_txn_verify_batch_add( ctx, payload[1], (ushort)payload_sz[1], (fd_txn_t *)out_buf[1], 0 )==FD_TXN_VERIFY_SUCCESS );
+  FD_TEST( fd_txn_verify_batch_add( ctx, payload[2], (ushort)payload_sz[2], (fd_txn_t *)out_buf[2], 0 )==FD_TXN_VERIFY_SUCCESS );
+  fd_txn_verify_batch_exec( ctx );
+  FD_TEST( ctx->batch.txn[0].res==FD_TXN_VERIFY_FAILED  );
+  FD_TEST( ctx->batch.txn[1].res==FD_TXN_VERIFY_SUCCESS );
+  fd_txn_verify_batch_reset( ctx );
+
+  /* Fill the batch up */
+  ulong txn_cnt = 0UL;
+  while( fd_txn_verify_batch_room( ctx, (fd_txn_t *)out_buf[2] ) ) {
+    FD_TEST( fd_txn_verify_batch_add( ctx, payload[2], (ushort)payload_sz[2], (fd_txn_t *)out_buf[2], 0 )==FD_TXN_VERIFY_SUCCESS );
+    txn_cnt++;
+  }
+  FD_TEST( txn_cnt==FD_TXN_VERIFY_BATCH_MAX );
+  fd_txn_verify_batch_exec( ctx );
+  for( ulong i=0UL; i<txn_cnt; i++ ) FD_TEST( ctx->batch.txn[i].res==FD_TXN_VERIFY_SUCCESS );
+  fd_txn_verify_batch_reset( ctx );
+
+  for( ulong i=0UL; i<4UL; i++ ) free( payload[i] );
+  free_verify_ctx( ctx, mem );
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -354,6 +413,7 @@ main( int     argc,
   test_verify_invalid_sigs_success();
   test_verify_invalid_dedup_success();
   test_verify_invalid_dedup_with_collision_success();
+  test_verify_batch();
 
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
@@ -10,6 +10,8 @@
 #include "../../flamenco/runtime/fd_executor.h"
 #include "../../flamenco/runtime/fd_hashes.h"
 #include "../../flamenco/runtime/program/fd_bpf_program_util.h"
+#include "../../flamenco/vm/fd_vm_base.h"
+#include "../../flamenco/vm/jit/fd_vm_jit_cache.h"
 
 #include "../../funk/fd_funk.h"
 #include "../../funk/fd_funk_filemap.h"
@@ -132,6 +134,17 @@ struct fd_exec_tile_ctx {
   fd_exec_txn_ctx_t *   txn_ctx;
   int                   exec_res;
 
+  /* Shared cache of validated programs.  Exec tiles fill it with the
+     programs they see (snapshot scan, deploys and upgrades) so that
+     replay only has to copy them into funk.  NULL if the topology has
+     no program cache. */
+  fd_progcache_t *      progcache;
+
+  /* The sBPF JIT code arena ([development.sbpf_jit]), mapped in
+     privileged_init.  NULL if the JIT is disabled. */
+  uchar *               jit_code_rw;
+  uchar *               jit_code_rx;
+
   /* The txn/bpf id are sequence numbers. */
   /* The txn id is a value that is monotonically increased after
      executing a transaction. It is used to prevent race conditions in
@@ -154,10 +167,17 @@ scratch_align( void ) {
 }
 
 FD_FN_PURE static inline ulong
-scratch_footprint( fd_topo_tile_t const * tile FD_PARAM_UNUSED ) {
+scratch_footprint( fd_topo_tile_t const * tile ) {
   /* clang-format off */
   ulong l = FD_LAYOUT_INIT;
   l       = FD_LAYOUT_APPEND( l, alignof(fd_exec_tile_ctx_t),  sizeof(fd_exec_tile_ctx_t) );
+#if FD_HAS_X86
+  if( FD_UNLIKELY( tile->exec.sbpf_jit_program_max ) ) {
+    l     = FD_LAYOUT_APPEND( l, fd_vm_jit_cache_align(),      fd_vm_jit_cache_footprint( tile->exec.sbpf_jit_program_max ) );
+  }
+#else
+  (void)tile;
+#endif
   return FD_LAYOUT_FINI( l, scratch_align() );
   /* clang-format on */
 }
@@ -236,12 +256,12 @@ prepare_new_slot_execution( fd_exec_tile_ctx_t *           ctx,
     FD_LOG_ERR(( "Could not find valid funk transaction map" ));
   }
   fd_funk_txn_xid_t xid = { .ul = { slot_msg->slot, slot_msg->slot } };
-  fd_funk_txn_start_read( ctx->funk );
+  fd_funk_read_begin( ctx->funk );
   fd_funk_txn_t * funk_txn = fd_funk_txn_query( &xid, txn_map );
   if( FD_UNLIKELY( !funk_txn ) ) {
     FD_LOG_ERR(( "Could not find valid funk transaction" ));
   }
-  fd_funk_txn_end_read( ctx->funk );
+  fd_funk_read_end( ctx->funk );
   ctx->txn_ctx->funk_txn = funk_txn;
 
   ctx->txn_ctx->slot                        = slot_msg->slot;
@@ -376,6 +396,48 @@ bpf_scan_accounts( fd_exec_tile_ctx_t *               ctx,
   for( ulong i=start_idx; i<=end_idx; i++ ) {
     fd_funk_rec_t const * rec = recs[ i ];
     fd_bpf_is_bpf_program( rec, wksp, &is_bpf[ i ] );
+
+    /* Load and validate here rather than on replay, which creates the
+       funk program cache entries from these once all exec tiles are
+       done. */
+    if( ctx->progcache && is_bpf[ i ] ) {
+      fd_account_meta_t const * meta = fd_funk_val_const( rec, wksp );
+      if( FD_UNLIKELY( !meta || meta->magic!=FD_ACCOUNT_META_MAGIC ) ) continue;
+      fd_bpf_progcache_warm( ctx->progcache,
+                             fd_type_pun_const( rec->pair.key[0].uc ),
+                             (fd_pubkey_t const *)meta->info.owner,
+                             (uchar const *)meta + meta->hlen,
+                             meta->dlen,
+                             msg->slot,
+                             &ctx->runtime_public->features,
+                             ctx->exec_spad );
+    }
+  }
+}
+
+/* warm_programs warms the program cache with the programs written by
+   the transaction that just executed (deploys, upgrades, extends), so
+   that replay finds them there when it updates the funk program cache
+   at the end of the slot.  Runs after the transaction result has been
+   handed to the writer tile. */
+
+static void
+warm_programs( fd_exec_tile_ctx_t * ctx ) {
+  fd_exec_txn_ctx_t * txn_ctx = ctx->txn_ctx;
+  if( !ctx->progcache || ctx->exec_res!=FD_EXECUTOR_INSTR_SUCCESS || txn_ctx->exec_err ) return;
+
+  for( ushort i=0; i<txn_ctx->accounts_cnt; i++ ) {
+    if( !fd_exec_txn_ctx_account_is_writable_idx( txn_ctx, i ) ) continue;
+    fd_txn_account_t * acc = &txn_ctx->accounts[ i ];
+    if( !acc->vt->get_meta( acc ) ) continue;
+    fd_bpf_progcache_warm( ctx->progcache,
+                           acc->pubkey,
+                           acc->vt->get_owner( acc ),
+                           acc->vt->get_data( acc ),
+                           acc->vt->get_data_len( acc ),
+                           txn_ctx->slot,
+                           &txn_ctx->features,
+                           ctx->exec_spad );
   }
 }
 
@@ -427,7 +489,9 @@ during_frag( fd_exec_tile_ctx_t * ctx,
     if( FD_LIKELY( sig==EXEC_NEW_TXN_SIG ) ) {
       fd_runtime_public_txn_msg_t * txn = (fd_runtime_public_txn_msg_t *)fd_chunk_to_laddr( ctx->replay_in_mem, chunk );
       ctx->txn = txn->txn;
+      fd_funk_read_begin( ctx->funk );
       execute_txn( ctx );
+      fd_funk_read_end( ctx->funk );
       return;
     } else if( sig==EXEC_NEW_SLOT_SIG ) {
       fd_runtime_public_slot_msg_t * msg = fd_chunk_to_laddr( ctx->replay_in_mem, chunk );
@@ -442,12 +506,16 @@ during_frag( fd_exec_tile_ctx_t * ctx,
     } else if( sig==EXEC_HASH_ACCS_SIG ) {
       fd_runtime_public_hash_bank_msg_t * msg = fd_chunk_to_laddr( ctx->replay_in_mem, chunk );
       FD_LOG_DEBUG(( "hash accs=%lu msg recvd", msg->end_idx - msg->start_idx ));
+      fd_funk_read_begin( ctx->funk );
       hash_accounts( ctx, msg );
+      fd_funk_read_end( ctx->funk );
       return;
     } else if( sig==EXEC_BPF_SCAN_SIG ) {
       fd_runtime_public_bpf_scan_msg_t * msg = fd_chunk_to_laddr( ctx->replay_in_mem, chunk );
       FD_LOG_DEBUG(( "bpf scan=%lu msg recvd", msg->end_idx - msg->start_idx ));
+      fd_funk_read_begin( ctx->funk );
       bpf_scan_accounts( ctx, msg );
+      fd_funk_read_end( ctx->funk );
       return;
     } else if( sig==EXEC_SNAP_HASH_ACCS_CNT_SIG ) {
       FD_LOG_DEBUG(( "snap hash count msg recvd" ));
@@ -509,6 +577,10 @@ after_frag( fd_exec_tile_ctx_t * ctx,
     if( FD_UNLIKELY( ctx->txn_id==FD_EXEC_ID_SENTINEL ) ) {
       ctx->txn_id = 0U;
     }
+
+    fd_funk_read_begin( ctx->funk );
+    warm_programs( ctx );
+    fd_funk_read_end( ctx->funk );
   } else if( sig==EXEC_HASH_ACCS_SIG ) {
     FD_LOG_DEBUG(( "Sending ack for hash accs msg" ));
     fd_fseq_update( ctx->exec_fseq, fd_exec_fseq_set_hash_done() );
@@ -530,8 +602,27 @@ after_frag( fd_exec_tile_ctx_t * ctx,
 }
 
 static void
-privileged_init( fd_topo_t *      topo FD_PARAM_UNUSED,
-                 fd_topo_tile_t * tile FD_PARAM_UNUSED ) {
+privileged_init( fd_topo_t *      topo,
+                 fd_topo_tile_t * tile ) {
+  void * scratch = fd_topo_obj_laddr( topo, tile->tile_obj_id );
+
+  FD_SCRATCH_ALLOC_INIT( l, scratch );
+  fd_exec_tile_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_exec_tile_ctx_t), sizeof(fd_exec_tile_ctx_t) );
+  ctx->jit_code_rw = NULL;
+  ctx->jit_code_rx = NULL;
+
+  /* The JIT code arena is mapped executable here as the sandbox does
+     not allow creating executable mappings later. */
+
+  if( FD_UNLIKELY( tile->exec.sbpf_jit_program_max ) ) {
+#if FD_HAS_X86
+    if( FD_UNLIKELY( fd_vm_jit_code_map( tile->exec.sbpf_jit_code_sz, &ctx->jit_code_rw, &ctx->jit_code_rx ) ) ) {
+      FD_LOG_ERR(( "Failed to map %lu MiB sBPF JIT code arena", tile->exec.sbpf_jit_code_sz>>20 ));
+    }
+#else
+    FD_LOG_ERR(( "[development.sbpf_jit] is only supported on x86-64" ));
+#endif
+  }
 }
 
 static void
@@ -546,6 +637,12 @@ unprivileged_init( fd_topo_t *      topo,
 
   FD_SCRATCH_ALLOC_INIT( l, scratch );
   fd_exec_tile_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_exec_tile_ctx_t), sizeof(fd_exec_tile_ctx_t) );
+#if FD_HAS_X86
+  void * jit_cache_mem = NULL;
+  if( FD_UNLIKELY( tile->exec.sbpf_jit_program_max ) ) {
+    jit_cache_mem = FD_SCRATCH_ALLOC_APPEND( l, fd_vm_jit_cache_align(), fd_vm_jit_cache_footprint( tile->exec.sbpf_jit_program_max ) );
+  }
+#endif
   ulong scratch_alloc_mem = FD_SCRATCH_ALLOC_FINI( l, scratch_align() );
   if( FD_UNLIKELY( scratch_alloc_mem - (ulong)scratch  - scratch_footprint( tile ) ) ) {
     FD_LOG_ERR( ( "Scratch_alloc_mem did not match scratch_footprint diff: %lu alloc: %lu footprint: %lu",
@@ -676,6 +773,39 @@ unprivileged_init( fd_topo_t *      topo,
     FD_LOG_ERR(( "Failed to find public wksp" ));
   }
 
+  /* The sBPF profiler is optional ([development.sbpf_profiler]) */
+
+  ulong vm_prof_obj_id = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "vm_prof.%lu", ctx->tile_idx );
+  if( FD_UNLIKELY( vm_prof_obj_id!=ULONG_MAX ) ) {
+    ctx->txn_ctx->vm_prof = fd_vm_prof_join( fd_topo_obj_laddr( topo, vm_prof_obj_id ) );
+    if( FD_UNLIKELY( !ctx->txn_ctx->vm_prof ) ) {
+      FD_LOG_ERR(( "Failed to join vm prof" ));
+    }
+  }
+
+  /* The program cache is optional */
+
+  ctx->progcache = NULL;
+  ulong progcache_obj_id = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "progcache" );
+  if( FD_LIKELY( progcache_obj_id!=ULONG_MAX ) ) {
+    ctx->progcache = fd_progcache_join( fd_topo_obj_laddr( topo, progcache_obj_id ) );
+    if( FD_UNLIKELY( !ctx->progcache ) ) {
+      FD_LOG_ERR(( "Failed to join program cache" ));
+    }
+  }
+
+  /* The sBPF JIT is optional ([development.sbpf_jit]) */
+
+#if FD_HAS_X86
+  if( FD_UNLIKELY( jit_cache_mem ) ) {
+    ctx->txn_ctx->vm_jit = fd_vm_jit_cache_join( fd_vm_jit_cache_new( jit_cache_mem, tile->exec.sbpf_jit_program_max,
+                                                                      ctx->jit_code_rw, ctx->jit_code_rx, tile->exec.sbpf_jit_code_sz ) );
+    if( FD_UNLIKELY( !ctx->txn_ctx->vm_jit ) ) {
+      FD_LOG_ERR(( "Failed to create sBPF JIT cache" ));
+    }
+  }
+#endif
+
   /********************************************************************/
   /* setup exec fseq                                                  */
   /********************************************************************/
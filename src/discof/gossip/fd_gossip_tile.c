@@ -183,8 +183,16 @@ struct fd_gossip_tile_ctx {
   uchar         identity_private_key[32];
   fd_pubkey_t   identity_public_key;
 
-  /* Includes Ethernet, IP, UDP headers */
-  uchar gossip_buffer[ FD_NET_MTU ];
+  /* Received packets queued for fd_gossip_recv_packet_batch, so that
+     their signatures are verified together.  during_frag copies the
+     frame (including Ethernet, IP, UDP headers) into the next free
+     buffer, after_frag queues its UDP payload.  The queue is flushed
+     when full or when the input links are idle. */
+  uchar                recv_buf[ FD_GOSSIP_RECV_BATCH_MAX ][ FD_NET_MTU ];
+  fd_gossip_recv_pkt_t recv_q  [ FD_GOSSIP_RECV_BATCH_MAX ];
+  ulong                recv_q_cnt;
+  ulong                idle_cnt;
+  ulong                in_cnt;
 
   ushort net_id;
   fd_ip4_udp_hdrs_t hdr[1];
@@ -399,11 +407,21 @@ during_housekeeping( fd_gossip_tile_ctx_t * ctx ) {
   fd_gossip_settime( ctx->gossip, fd_log_wallclock() );
 }
 
+static void
+recv_flush( fd_gossip_tile_ctx_t * ctx,
+            fd_stem_context_t *    stem ) {
+  if( !ctx->recv_q_cnt ) return;
+  ctx->stem = stem;
+  fd_gossip_recv_packet_batch( ctx->gossip, ctx->recv_q, ctx->recv_q_cnt );
+  ctx->recv_q_cnt = 0UL;
+}
+
 static inline int
 before_frag( fd_gossip_tile_ctx_t * ctx,
              ulong                  in_idx,
              ulong                  seq FD_PARAM_UNUSED,
              ulong                  sig ) {
+  ctx->idle_cnt = 0UL;
   uint in_kind = ctx->in_kind[ in_idx ];
   return in_kind != IN_KIND_VOTER && in_kind != IN_KIND_RESTART && fd_disco_netmux_sig_proto( sig ) != DST_PROTO_GOSSIP;
 }
@@ -459,7 +477,7 @@ during_frag( fd_gossip_tile_ctx_t * ctx,
   if( in_kind!=IN_KIND_NET ) return;
 
   void const * src = fd_net_rx_translate_frag( &ctx->in_links[ in_idx ].net_rx, chunk, ctl, sz );
-  fd_memcpy( ctx->gossip_buffer, src, sz );
+  fd_memcpy( ctx->recv_buf[ ctx->recv_q_cnt ], src, sz );
 }
 
 static void
@@ -496,8 +514,7 @@ after_frag( fd_gossip_tile_ctx_t * ctx,
 
   if( FD_UNLIKELY( sz<42 ) ) return;
 
-  ctx->stem = stem;
-  fd_eth_hdr_t const * eth  = (fd_eth_hdr_t const *)ctx->gossip_buffer;
+  fd_eth_hdr_t const * eth  = (fd_eth_hdr_t const *)ctx->recv_buf[ ctx->recv_q_cnt ];
   fd_ip4_hdr_t const * ip4  = (fd_ip4_hdr_t const *)( (ulong)eth + sizeof(fd_eth_hdr_t) );
   fd_udp_hdr_t const * udp  = (fd_udp_hdr_t const *)( (ulong)ip4 + FD_IP4_GET_LEN( *ip4 ) );
   uchar const *        data = (uchar        const *)( (ulong)udp + sizeof(fd_udp_hdr_t) );
@@ -507,8 +524,13 @@ after_frag( fd_gossip_tile_ctx_t * ctx,
   ulong data_sz = udp_sz-sizeof(fd_udp_hdr_t);
   if( FD_UNLIKELY( (ulong)data+data_sz > (ulong)eth+sz ) ) return;
 
-  fd_gossip_peer_addr_t peer_addr = { .addr=ip4->saddr, .port=udp->net_sport };
-  fd_gossip_recv_packet( ctx->gossip, data, data_sz, &peer_addr );
+  fd_gossip_recv_pkt_t * pkt = &ctx->recv_q[ ctx->recv_q_cnt++ ];
+  pkt->data      = data;
+  pkt->data_sz   = data_sz;
+  pkt->from.addr = ip4->saddr;
+  pkt->from.port = udp->net_sport;
+
+  if( FD_UNLIKELY( ctx->recv_q_cnt==FD_GOSSIP_RECV_BATCH_MAX ) ) recv_flush( ctx, stem );
 }
 
 static void
@@ -577,6 +599,9 @@ after_credit( fd_gossip_tile_ctx_t * ctx,
      doing any work. */
   *charge_busy = 1;
 
+  /* Process the queued packets once the input links are idle */
+  if( ctx->recv_q_cnt && ctx->idle_cnt++>=ctx->in_cnt ) recv_flush( ctx, stem );
+
   ctx->stem = stem;
   ulong tsorig = fd_frag_meta_ts_comp( fd_tickcount() );
 
@@ -796,6 +821,9 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->contact_info_table = fd_contact_info_table_join( fd_contact_info_table_new( FD_SCRATCH_ALLOC_APPEND( l, fd_contact_info_table_align(), fd_contact_info_table_footprint( FD_PEER_KEY_MAX ) ), FD_PEER_KEY_MAX, 0 ) );
 
   if( FD_UNLIKELY( tile->in_cnt > MAX_IN_LINKS ) ) FD_LOG_ERR(( "gossip tile has too many input links" ));
+  ctx->in_cnt     = tile->in_cnt;
+  ctx->recv_q_cnt = 0UL;
+  ctx->idle_cnt   = 0UL;
 
   uint sign_link_in_idx = UINT_MAX;
   memset( ctx->in_kind, 0, sizeof(ctx->in_kind) );
@@ -1062,6 +1090,10 @@ fd_gossip_update_gossip_metrics( fd_gossip_metrics_t * metrics ) {
   FD_MCNT_ENUM_COPY( GOSSIP, RECEIVED_GOSSIP_MESSAGES, metrics->recv_message );
   FD_MCNT_SET( GOSSIP, RECEIVED_UNKNOWN_MESSAGE, metrics->recv_unknown_message );
 
+  FD_MCNT_SET( GOSSIP, VERIFY_BATCHES,    metrics->recv_verify_batch_cnt );
+  FD_MCNT_SET( GOSSIP, VERIFY_SIGNATURES, metrics->recv_verify_sig_cnt   );
+  FD_MCNT_SET( GOSSIP, VERIFY_FAILURES,   metrics->recv_verify_fail_cnt  );
+
   FD_MCNT_ENUM_COPY( GOSSIP, RECEIVED_CRDS_PUSH, metrics->recv_crds[ FD_GOSSIP_CRDS_ROUTE_PUSH ] );
   FD_MCNT_ENUM_COPY( GOSSIP, RECEIVED_CRDS_PULL, metrics->recv_crds[ FD_GOSSIP_CRDS_ROUTE_PULL_RESP ] );
   FD_MCNT_ENUM_COPY( GOSSIP, RECEIVED_CRDS_DUPLICATE_MESSAGE_PUSH, metrics->recv_crds_duplicate_message[ FD_GOSSIP_CRDS_ROUTE_PUSH ] );
@@ -1112,6 +1144,7 @@ metrics_write( fd_gossip_tile_ctx_t * ctx ) {
   FD_MCNT_ENUM_COPY( GOSSIP, ZERO_IPV4_CONTACT_INFO, ctx->metrics.zero_ipv4_contact_info );
   FD_MGAUGE_ENUM_COPY( GOSSIP, PEER_COUNTS, ctx->metrics.peer_counts );
   FD_MCNT_SET( GOSSIP, SHRED_VERSION_ZERO, ctx->metrics.shred_version_zero );
+  FD_MGAUGE_SET( GOSSIP, VERIFY_BACKLOG, ctx->recv_q_cnt );
 
   /* Gossip-protocol-specific metrics */
   fd_gossip_update_gossip_metrics( fd_gossip_get_metrics( ctx->gossip ) );
@@ -1,6 +1,8 @@
 ifdef FD_HAS_INT128
-$(call add-hdrs,fd_replay.h)
-$(call add-objs,fd_replay,fd_discof)
+$(call add-hdrs,fd_replay.h fd_replay_sched.h)
+$(call add-objs,fd_replay fd_replay_sched,fd_discof)
+$(call make-unit-test,test_replay_sched,test_replay_sched,fd_discof fd_util)
+$(call run-unit-test,test_replay_sched)
 ifdef FD_HAS_SSE
 ifdef FD_HAS_ZSTD # required to load snapshot
 $(call add-objs,fd_replay_tile,fd_discof)
@@ -0,0 +1,360 @@
+#include "fd_replay_sched.h"
+#include "../../flamenco/runtime/fd_system_ids_pp.h"
+#include "../../disco/pack/fd_pack_bitset.h"
+#include "../../disco/pack/fd_pack_unwritable.h"
+
+#define FD_REPLAY_SCHED_MAGIC (0xf17eda2ce5c4ed00UL) /* firedancer replay sched version 0 */
+
+#define FD_REPLAY_SCHED_STATE_FREE      (0)
+#define FD_REPLAY_SCHED_STATE_PENDING   (1) /* in window, not handed out yet */
+#define FD_REPLAY_SCHED_STATE_EXECUTING (2) /* in window, handed out */
+#define FD_REPLAY_SCHED_STATE_DONE      (3) /* completed, waiting for the window head to pass */
+
+/* fd_replay_sched_acct_t is an element of an fd_map_dynamic that maps an
+   account address to the bit reserved for it and the number of
+   references to it by transactions in the window. */
+
+struct fd_replay_sched_acct {
+  fd_acct_addr_t key;
+  ulong          ref_cnt;
+  ushort         bit;
+};
+typedef struct fd_replay_sched_acct fd_replay_sched_acct_t;
+
+static const fd_acct_addr_t null_addr = { 0 };
+
+/* The null address is the system program, which is unwritable and thus
+   never inserted. */
+
+#define MAP_NAME              acct_map
+#define MAP_T                 fd_replay_sched_acct_t
+#define MAP_KEY_T             fd_acct_addr_t
+#define MAP_KEY_NULL          null_addr
+#define MAP_KEY_INVAL(k)      MAP_KEY_EQUAL(k, null_addr)
+#define MAP_KEY_EQUAL(k0,k1)  (!memcmp((k0).b,(k1).b, FD_TXN_ACCT_ADDR_SZ))
+#define MAP_KEY_EQUAL_IS_SLOW 1
+#define MAP_MEMOIZE           0
+#define MAP_KEY_HASH(key)     ((uint)fd_ulong_hash( fd_ulong_load_8( (key).b ) ))
+#include "../../util/tmpl/fd_map_dynamic.c"
+
+/* A map twice as large as the number of bits is at most half full */
+
+#define ACCT_MAP_LG_SLOT_CNT (fd_ulong_find_msb( FD_PACK_BITSET_MAX )+1)
+
+struct __attribute__((aligned(FD_REPLAY_SCHED_ALIGN))) fd_replay_sched_txn {
+  FD_PACK_BITSET_DECLARE( rw_bitset ); /* all accts this txn references */
+  FD_PACK_BITSET_DECLARE(  w_bitset ); /* accts this txn write-locks    */
+
+  uchar  state;
+  uchar  barrier;
+  ushort bit_cnt;
+  ushort bit[ FD_TXN_ACCT_ADDR_MAX ]; /* bits referenced (with multiplicity) */
+
+  fd_txn_p_t txn[1];
+};
+typedef struct fd_replay_sched_txn fd_replay_sched_txn_t;
+
+struct __attribute__((aligned(FD_REPLAY_SCHED_ALIGN))) fd_replay_sched {
+  ulong magic;
+  ulong depth;
+
+  ulong head; /* seq of the oldest txn in the window */
+  ulong tail; /* seq of the next txn to insert */
+  ulong txn_cnt;
+  ulong pending_cnt;
+
+  fd_replay_sched_acct_t * acct_map;
+
+  /* bit_avail is a stack of the bits not currently reserved, indexed
+     [0,bit_avail_cnt). */
+
+  ulong  bit_avail_cnt;
+  ushort bit_avail[ FD_PACK_BITSET_MAX ];
+
+  /* bit_acct[ bit ] is the account address a reserved bit is mapped
+     to, such that bits can be released without the txn's (possibly
+     lookup table) account list. */
+
+  fd_acct_addr_t bit_acct[ FD_PACK_BITSET_MAX ];
+
+  /* Followed by the acct_map region, then depth
+     fd_replay_sched_txn_t */
+};
+
+FD_FN_CONST ulong
+fd_replay_sched_align( void ) {
+  return FD_REPLAY_SCHED_ALIGN;
+}
+
+FD_FN_CONST ulong
+fd_replay_sched_footprint( ulong depth ) {
+  if( FD_UNLIKELY( (!depth) | (depth>(1UL<<16)) | (!fd_ulong_is_pow2( depth )) ) ) return 0UL;
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, FD_REPLAY_SCHED_ALIGN,         sizeof(fd_replay_sched_t)                   );
+  l = FD_LAYOUT_APPEND( l, acct_map_align(),              acct_map_footprint( ACCT_MAP_LG_SLOT_CNT ) );
+  l = FD_LAYOUT_APPEND( l, alignof(fd_replay_sched_txn_t), depth*sizeof(fd_replay_sched_txn_t)         );
+  return FD_LAYOUT_FINI( l, FD_REPLAY_SCHED_ALIGN );
+}
+
+static inline fd_replay_sched_txn_t *
+fd_replay_sched_private_txns( fd_replay_sched_t * sched ) {
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, FD_REPLAY_SCHED_ALIGN, sizeof(fd_replay_sched_t)                   );
+  l = FD_LAYOUT_APPEND( l, acct_map_align(),      acct_map_footprint( ACCT_MAP_LG_SLOT_CNT ) );
+  l = fd_ulong_align_up( l, alignof(fd_replay_sched_txn_t) );
+  return (fd_replay_sched_txn_t *)( (ulong)sched + l );
+}
+
+void *
+fd_replay_sched_new( void * shmem,
+                     ulong  depth ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_replay_sched_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_replay_sched_footprint( depth );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad depth" ));
+    return NULL;
+  }
+
+  fd_memset( shmem, 0, footprint );
+
+  FD_SCRATCH_ALLOC_INIT( l, shmem );
+  fd_replay_sched_t * sched    = FD_SCRATCH_ALLOC_APPEND( l, FD_REPLAY_SCHED_ALIGN, sizeof(fd_replay_sched_t)                   );
+  void *              _acct_map = FD_SCRATCH_ALLOC_APPEND( l, acct_map_align(),     acct_map_footprint( ACCT_MAP_LG_SLOT_CNT ) );
+
+  sched->depth = depth;
+  acct_map_new( _acct_map, ACCT_MAP_LG_SLOT_CNT );
+
+  sched->bit_avail_cnt = FD_PACK_BITSET_MAX;
+  for( ulong i=0UL; i<FD_PACK_BITSET_MAX; i++ ) sched->bit_avail[ i ] = (ushort)(FD_PACK_BITSET_MAX-1UL-i);
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( sched->magic ) = FD_REPLAY_SCHED_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return sched;
+}
+
+fd_replay_sched_t *
+fd_replay_sched_join( void * shsched ) {
+  fd_replay_sched_t * sched = (fd_replay_sched_t *)shsched;
+
+  if( FD_UNLIKELY( !sched ) ) {
+    FD_LOG_WARNING(( "NULL shsched" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shsched, fd_replay_sched_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shsched" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( sched->magic!=FD_REPLAY_SCHED_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_SCRATCH_ALLOC_INIT( l, shsched );
+  /*                */ FD_SCRATCH_ALLOC_APPEND( l, FD_REPLAY_SCHED_ALIGN, sizeof(fd_replay_sched_t)                   );
+  void * _acct_map =   FD_SCRATCH_ALLOC_APPEND( l, acct_map_align(),      acct_map_footprint( ACCT_MAP_LG_SLOT_CNT ) );
+  sched->acct_map = acct_map_join( _acct_map );
+
+  return sched;
+}
+
+void *
+fd_replay_sched_leave( fd_replay_sched_t * sched ) {
+
+  if( FD_UNLIKELY( !sched ) ) {
+    FD_LOG_WARNING(( "NULL sched" ));
+    return NULL;
+  }
+
+  acct_map_leave( sched->acct_map );
+
+  return (void *)sched;
+}
+
+void *
+fd_replay_sched_delete( void * shsched ) {
+  fd_replay_sched_t * sched = (fd_replay_sched_t *)shsched;
+
+  if( FD_UNLIKELY( !sched ) ) {
+    FD_LOG_WARNING(( "NULL shsched" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shsched, fd_replay_sched_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shsched" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( sched->magic!=FD_REPLAY_SCHED_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( sched->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return (void *)sched;
+}
+
+FD_FN_PURE ulong fd_replay_sched_txn_cnt    ( fd_replay_sched_t const * sched ) { return sched->txn_cnt;     }
+FD_FN_PURE ulong fd_replay_sched_pending_cnt( fd_replay_sched_t const * sched ) { return sched->pending_cnt; }
+
+ulong
+fd_replay_sched_insert( fd_replay_sched_t *    sched,
+                        fd_txn_p_t const *     txn_p,
+                        fd_acct_addr_t const * alt_accts ) {
+
+  if( FD_UNLIKELY( sched->tail-sched->head>=sched->depth ) ) return FD_REPLAY_SCHED_IDX_NULL;
+
+  fd_txn_t const *       txn      = TXN(txn_p);
+  fd_acct_addr_t const * accts    = fd_txn_get_acct_addrs( txn, txn_p->payload );
+  ulong                  imm_cnt  = fd_txn_account_cnt( txn, FD_TXN_ACCT_CAT_IMM );
+  ulong                  acct_cnt = imm_cnt;
+  int                    barrier  = 0;
+  if( FD_UNLIKELY( txn->transaction_version==FD_TXN_V0 && txn->addr_table_adtl_cnt ) ) {
+    if( FD_LIKELY( alt_accts ) ) acct_cnt += txn->addr_table_adtl_cnt;
+    else                         barrier   = 1;
+  }
+
+  /* Make sure there are enough bits for the accounts not yet in the
+     window before touching anything.  This overestimates if the txn
+     references an account more than once, which is fine. */
+
+  ulong new_cnt = 0UL;
+  for( ulong i=0UL; i<acct_cnt; i++ ) {
+    fd_acct_addr_t const * acct = i<imm_cnt ? accts+i : alt_accts+(i-imm_cnt);
+    if( FD_UNLIKELY( fd_pack_unwritable_contains( acct ) ) ) continue;
+    new_cnt += !acct_map_query( sched->acct_map, *acct, NULL );
+  }
+  if( FD_UNLIKELY( new_cnt>sched->bit_avail_cnt ) ) return FD_REPLAY_SCHED_IDX_NULL;
+
+  ulong                   idx = sched->tail & (sched->depth-1UL);
+  fd_replay_sched_txn_t * ele = fd_replay_sched_private_txns( sched ) + idx;
+
+  FD_PACK_BITSET_CLEAR( ele->rw_bitset );
+  FD_PACK_BITSET_CLEAR( ele->w_bitset  );
+  ele->bit_cnt = 0;
+
+  for( ulong i=0UL; i<acct_cnt; i++ ) {
+    fd_acct_addr_t const * acct = i<imm_cnt ? accts+i : alt_accts+(i-imm_cnt);
+    if( FD_UNLIKELY( fd_pack_unwritable_contains( acct ) ) ) continue;
+
+    fd_replay_sched_acct_t * q = acct_map_query( sched->acct_map, *acct, NULL );
+    if( FD_LIKELY( !q ) ) {
+      q          = acct_map_insert( sched->acct_map, *acct );
+      q->ref_cnt = 0UL;
+      q->bit     = sched->bit_avail[ --sched->bit_avail_cnt ];
+      sched->bit_acct[ q->bit ] = *acct;
+    }
+    q->ref_cnt++;
+    ele->bit[ ele->bit_cnt++ ] = q->bit;
+
+    FD_PACK_BITSET_SETN( ele->rw_bitset, q->bit );
+    if( fd_txn_is_writable( txn, (ushort)i ) ) FD_PACK_BITSET_SETN( ele->w_bitset, q->bit );
+  }
+
+  ele->state   = FD_REPLAY_SCHED_STATE_PENDING;
+  ele->barrier = (uchar)barrier;
+  *ele->txn    = *txn_p;
+
+  sched->tail++;
+  sched->txn_cnt++;
+  sched->pending_cnt++;
+  return idx;
+}
+
+ulong
+fd_replay_sched_next( fd_replay_sched_t * sched ) {
+
+  if( FD_UNLIKELY( !sched->pending_cnt ) ) return FD_REPLAY_SCHED_IDX_NULL;
+
+  fd_replay_sched_txn_t * txns = fd_replay_sched_private_txns( sched );
+  ulong                   mask = sched->depth-1UL;
+
+  /* Walk the window in block order accumulating the accounts used by
+     transactions that have not completed yet.  The first pending
+     transaction that does not intersect them is ready. */
+
+  FD_PACK_BITSET_DECLARE( rw_in_use );
+  FD_PACK_BITSET_DECLARE(  w_in_use );
+  FD_PACK_BITSET_CLEAR( rw_in_use );
+  FD_PACK_BITSET_CLEAR(  w_in_use );
+  ulong in_use_cnt = 0UL;
+
+  for( ulong seq=sched->head; seq<sched->tail; seq++ ) {
+    fd_replay_sched_txn_t * ele = txns + (seq & mask);
+    if( ele->state==FD_REPLAY_SCHED_STATE_DONE ) continue;
+
+    if( ele->state==FD_REPLAY_SCHED_STATE_PENDING ) {
+      int ready = ele->barrier ? !in_use_cnt : FD_PACK_BITSET_INTERSECT4_EMPTY( ele->w_bitset, ele->rw_bitset, rw_in_use, w_in_use );
+      if( ready ) {
+        ele->state = FD_REPLAY_SCHED_STATE_EXECUTING;
+        sched->pending_cnt--;
+        return seq & mask;
+      }
+    }
+
+    /* Nothing can be reordered around a barrier */
+    if( FD_UNLIKELY( ele->barrier ) ) break;
+
+    FD_PACK_BITSET_OR( rw_in_use, ele->rw_bitset );
+    FD_PACK_BITSET_OR(  w_in_use, ele->w_bitset  );
+    in_use_cnt++;
+  }
+
+  return FD_REPLAY_SCHED_IDX_NULL;
+}
+
+fd_txn_p_t *
+fd_replay_sched_txn( fd_replay_sched_t * sched,
+                     ulong               idx ) {
+  return fd_replay_sched_private_txns( sched )[ idx ].txn;
+}
+
+void
+fd_replay_sched_complete( fd_replay_sched_t * sched,
+                          ulong               idx ) {
+
+  fd_replay_sched_txn_t * txns = fd_replay_sched_private_txns( sched );
+  fd_replay_sched_txn_t * ele  = txns + idx;
+
+  if( FD_UNLIKELY( ele->state!=FD_REPLAY_SCHED_STATE_EXECUTING ) ) {
+    FD_LOG_CRIT(( "txn %lu is not executing (state %u)", idx, (uint)ele->state ));
+  }
+
+  /* Release the account bits.  Any bit whose reference count drops to
+     zero is not in the bitset of any transaction in the window. */
+
+  for( ulong i=0UL; i<ele->bit_cnt; i++ ) {
+    ushort                   bit = ele->bit[ i ];
+    fd_replay_sched_acct_t * q   = acct_map_query( sched->acct_map, sched->bit_acct[ bit ], NULL );
+    if( FD_UNLIKELY( !q ) ) FD_LOG_CRIT(( "no account for bit %u", (uint)bit ));
+    if( !--q->ref_cnt ) {
+      acct_map_remove( sched->acct_map, q );
+      sched->bit_avail[ sched->bit_avail_cnt++ ] = bit;
+    }
+  }
+
+  ele->state = FD_REPLAY_SCHED_STATE_DONE;
+  sched->txn_cnt--;
+
+  ulong mask = sched->depth-1UL;
+  while( sched->head<sched->tail && txns[ sched->head & mask ].state==FD_REPLAY_SCHED_STATE_DONE ) {
+    txns[ sched->head & mask ].state = FD_REPLAY_SCHED_STATE_FREE;
+    sched->head++;
+  }
+}
@@ -0,0 +1,131 @@
+#ifndef HEADER_fd_src_discof_replay_fd_replay_sched_h
+#define HEADER_fd_src_discof_replay_fd_replay_sched_h
+
+/* fd_replay_sched is a dependency-aware transaction scheduler for
+   replay.  Transactions are inserted in block order (across microblock
+   and slice boundaries) into a bounded window.  The scheduler hands
+   out, in block order, any transaction in the window that does not
+   have an account conflict (write-write, write-read or read-write) with
+   an earlier transaction in the window that has not completed yet.
+
+   Because two transactions are only ever executed concurrently (or out
+   of order) when they touch disjoint sets of writable accounts, the
+   resulting state is identical to executing the block serially.  This
+   is the same locking model the block producer uses to build entries,
+   so in the common case transactions from consecutive microblocks can
+   execute concurrently instead of synchronizing on every microblock
+   boundary.
+
+   Conflicts are tracked with the fd_pack bitset representation (see
+   fd_pack_bitset.h): every account referenced by a transaction in the
+   window is assigned a bit for as long as some transaction in the
+   window references it.  Unlike fd_pack, the representation here is
+   exact; a transaction is not admitted into the window if there are
+   not enough free bits to represent all of its accounts.  Since a
+   transaction references at most FD_TXN_ACCT_ADDR_MAX accounts, an
+   empty window can always admit a transaction.  Accounts which can
+   never be written (sysvars, builtin programs, see
+   fd_pack_unwritable.h) are not tracked.
+
+   Transactions using address lookup tables must be inserted with the
+   lookup table accounts resolved.  If they could not be resolved (e.g.
+   a lookup table account is missing), the transaction is inserted as a
+   barrier: it only runs once all earlier transactions completed, and
+   no later transaction runs before it completes.  This is always
+   correct, just slower. */
+
+#include "../../disco/pack/fd_microblock.h"
+
+#define FD_REPLAY_SCHED_ALIGN    (128UL)
+#define FD_REPLAY_SCHED_IDX_NULL (ULONG_MAX)
+
+struct fd_replay_sched;
+typedef struct fd_replay_sched fd_replay_sched_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_replay_sched_{align,footprint} return the required alignment and
+   footprint of a memory region suitable for use as a scheduler with a
+   window of depth transactions.  depth must be a power of 2 in
+   [1,2^16].  footprint returns 0 for an invalid depth. */
+
+FD_FN_CONST ulong
+fd_replay_sched_align( void );
+
+FD_FN_CONST ulong
+fd_replay_sched_footprint( ulong depth );
+
+/* fd_replay_sched_new formats a memory region as an empty scheduler.
+   fd_replay_sched_join joins the caller to the scheduler.
+   fd_replay_sched_leave and fd_replay_sched_delete are the inverses.
+   These follow the usual conventions. */
+
+void *
+fd_replay_sched_new( void * shmem,
+                     ulong  depth );
+
+fd_replay_sched_t *
+fd_replay_sched_join( void * shsched );
+
+void *
+fd_replay_sched_leave( fd_replay_sched_t * sched );
+
+void *
+fd_replay_sched_delete( void * shsched );
+
+/* fd_replay_sched_txn_cnt returns the number of transactions in the
+   window (inserted but not completed).  fd_replay_sched_pending_cnt
+   returns the number of transactions in the window that have not been
+   handed out by fd_replay_sched_next yet. */
+
+FD_FN_PURE ulong fd_replay_sched_txn_cnt    ( fd_replay_sched_t const * sched );
+FD_FN_PURE ulong fd_replay_sched_pending_cnt( fd_replay_sched_t const * sched );
+
+/* fd_replay_sched_insert appends txn to the window.  If txn uses
+   address lookup tables, alt_accts should point to the resolved lookup
+   table accounts (addr_table_adtl_writable_cnt writable accounts
+   followed by the readonly ones, as produced by
+   fd_runtime_load_txn_address_lookup_tables) or be NULL if they could
+   not be resolved.  alt_accts is ignored for transactions without
+   lookup tables.  The transaction (and alt_accts) are copied, so the
+   caller is free to reuse its memory on return.
+
+   Returns the index of the transaction in the window on success.
+   Returns FD_REPLAY_SCHED_IDX_NULL if the window is full or does not
+   have enough free account bits for txn, in which case the caller
+   should retry after some transactions complete. */
+
+ulong
+fd_replay_sched_insert( fd_replay_sched_t *    sched,
+                        fd_txn_p_t const *     txn,
+                        fd_acct_addr_t const * alt_accts );
+
+/* fd_replay_sched_next returns the index of the earliest transaction
+   in the window that has not been handed out yet and can execute now,
+   i.e. it does not conflict with any earlier transaction that has not
+   completed.  The transaction is marked as executing.  Returns
+   FD_REPLAY_SCHED_IDX_NULL if there is no such transaction. */
+
+ulong
+fd_replay_sched_next( fd_replay_sched_t * sched );
+
+/* fd_replay_sched_txn returns the transaction at index idx.  idx must
+   be a transaction in the window.  The lifetime of the returned pointer
+   is until the transaction completes. */
+
+fd_txn_p_t *
+fd_replay_sched_txn( fd_replay_sched_t * sched,
+                     ulong               idx );
+
+/* fd_replay_sched_complete marks the executing transaction at idx as
+   completed, i.e. its effects are visible to transactions executed
+   after this call.  It is removed from the window, which may unblock
+   later transactions. */
+
+void
+fd_replay_sched_complete( fd_replay_sched_t * sched,
+                          ulong               idx );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_discof_replay_fd_replay_sched_h */
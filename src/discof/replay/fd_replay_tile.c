@@ -2,6 +2,7 @@
 #include "../../disco/tiles.h"
 #include "generated/fd_replay_tile_seccomp.h"
 
+#include "fd_replay_sched.h"
 #include "../geyser/fd_replay_notif.h"
 #include "../restart/fd_restart.h"
 #include "../store/fd_epoch_forks.h"
@@ -9,6 +10,7 @@
 #include "../../disco/keyguard/fd_keyload.h"
 #include "../../disco/topo/fd_pod_format.h"
 #include "../../flamenco/runtime/fd_txncache.h"
+#include "../../flamenco/runtime/fd_progcache.h"
 #include "../../flamenco/runtime/context/fd_capture_ctx.h"
 #include "../../flamenco/runtime/context/fd_exec_epoch_ctx.h"
 #include "../../flamenco/runtime/context/fd_exec_slot_ctx.h"
@@ -46,6 +48,11 @@
 #define DEQUE_MAX  USHORT_MAX + 1
 #include "../../util/tmpl/fd_deque.c"
 
+/* The number of transactions the replay scheduler looks ahead of the
+   earliest incomplete transaction to find ones that can execute
+   concurrently (see fd_replay_sched.h). */
+#define REPLAY_SCHED_DEPTH (128UL)
+
 /* An estimate of the max number of transactions in a block.  If there are more
    transactions, they must be split into multiple sets. */
 #define MAX_TXNS_PER_REPLAY ( ( FD_SHRED_BLK_MAX * FD_SHRED_MAX_SZ) / FD_TXN_MIN_SERIALIZED_SZ )
@@ -300,6 +307,11 @@ struct fd_replay_tile_ctx {
   fd_pubkey_t vote_acct_addr[ 1 ];
 
   fd_txncache_t * status_cache;
+  fd_progcache_t * progcache; /* NULL if the topology has no program cache */
+
+  /* Accounts lthash change accumulated by the writer tiles, NULL if the
+     topology has none (see fd_lthash_delta.h) */
+  fd_lthash_delta_t * lthash_delta;
   void * bmtree[ FD_PACK_MAX_BANK_TILES ];
 
   fd_epoch_forks_t epoch_forks[1];
@@ -330,7 +342,9 @@ struct fd_replay_tile_ctx {
 
   int is_caught_up;
 
-  int blocked_on_mblock; /* Flag used for synchronizing on mblock boundaries. */
+  /* Dependency-aware dispatch of transactions to the exec tiles */
+  fd_replay_sched_t * sched;
+  ulong               exec_sched_idx[ FD_PACK_MAX_BANK_TILES ]; /* Txn executing on the tile, FD_REPLAY_SCHED_IDX_NULL if none */
 
   /* Metrics */
   fd_replay_tile_metrics_t metrics;
@@ -366,6 +380,7 @@ scratch_footprint( fd_topo_tile_t const * tile FD_PARAM_UNUSED ) {
     l = FD_LAYOUT_APPEND( l, FD_BMTREE_COMMIT_ALIGN, FD_BMTREE_COMMIT_FOOTPRINT(0) );
   }
   l = FD_LAYOUT_APPEND( l, 128UL, FD_SLICE_MAX );
+  l = FD_LAYOUT_APPEND( l, fd_replay_sched_align(), fd_replay_sched_footprint( REPLAY_SCHED_DEPTH ) );
   l = FD_LAYOUT_FINI  ( l, scratch_align() );
   return l;
 }
@@ -533,12 +548,17 @@ bpf_tiles_cb( void * para_arg_1,
               void * fn_arg_1,
               void * fn_arg_2,
               void * fn_arg_3,
-              void * fn_arg_4 FD_PARAM_UNUSED ) {
+              void * fn_arg_4 ) {
   fd_replay_tile_ctx_t *  ctx            = (fd_replay_tile_ctx_t *)para_arg_1;
   fd_stem_context_t *     stem           = (fd_stem_context_t *)para_arg_2;
   fd_funk_rec_t const * * recs           = (fd_funk_rec_t const **)fn_arg_1;
   uchar *                 is_bpf_program = (uchar *)fn_arg_2;
   ulong                   rec_cnt        = (ulong)fn_arg_3;
+  fd_exec_slot_ctx_t *    slot_ctx       = (fd_exec_slot_ctx_t *)fn_arg_4;
+
+  /* Exec tiles warm the program cache with the programs they find,
+     under the feature set of slot_ctx. */
+  fd_memcpy( &ctx->runtime_public->features, &slot_ctx->epoch_ctx->features, sizeof(ctx->runtime_public->features) );
 
   ulong cnt_per_worker = rec_cnt / ctx->exec_cnt;
 
@@ -580,6 +600,7 @@ bpf_tiles_cb( void * para_arg_1,
     scan_msg->end_idx         = end_idx;
     scan_msg->recs_gaddr      = recs_gaddr;
     scan_msg->is_bpf_gaddr    = is_bpf_gaddr;
+    scan_msg->slot            = slot_ctx->slot_bank.slot;
 
     ulong tspub = fd_frag_meta_ts_comp( fd_tickcount() );
     fd_stem_publish( stem,
@@ -873,6 +894,12 @@ funk_publish( fd_replay_tile_ctx_t * ctx,
               ulong                  wmk,
               uchar                  is_constipated ) {
 
+  /* The exec and writer tiles do their funk lookups inside funk read
+     sections (fd_funk_read_begin) and keep executing while this
+     publishes; anything the publish removes is only released once
+     their read sections are done.  The txn write lock only excludes
+     users of fd_funk_txn_start_read. */
+
   fd_funk_txn_start_write( ctx->funk );
 
   fd_epoch_bank_t * epoch_bank = fd_exec_epoch_ctx_epoch_bank( ctx->slot_ctx->epoch_ctx );
@@ -1489,6 +1516,8 @@ prepare_new_block_execution( fd_replay_tile_ctx_t * ctx,
   // }
 
   fork->slot_ctx->status_cache = ctx->status_cache;
+  fork->slot_ctx->progcache    = ctx->progcache;
+  fork->slot_ctx->lthash_delta = ctx->lthash_delta;
 
   fd_funk_txn_xid_t xid = { 0 };
 
@@ -1622,19 +1651,49 @@ prepare_first_batch_execution( fd_replay_tile_ctx_t * ctx, fd_stem_context_t * s
 
 }
 
+/* replay_resolve_alts resolves the address lookup table accounts of a
+   v0 txn into out for the scheduler.  Lookup table entries only become
+   usable in the slot after they were added, and a table can only be
+   closed after it has been deactivated for the duration of the slot
+   hashes sysvar, so resolving at parse time gives the same accounts as
+   resolving at execution time.  Returns NULL if the lookup tables could
+   not be resolved, in which case the txn (which will then fail to
+   execute) is scheduled as a barrier. */
+
+static fd_acct_addr_t const *
+replay_resolve_alts( fd_replay_tile_ctx_t * ctx,
+                     fd_fork_t *            fork,
+                     fd_txn_p_t const *     txn_p,
+                     fd_acct_addr_t *       out ) {
+  fd_exec_slot_ctx_t * slot_ctx = fork->slot_ctx;
+  fd_slot_hashes_global_t const * slot_hashes_global = fd_sysvar_cache_slot_hashes( slot_ctx->sysvar_cache, ctx->runtime_public_wksp );
+  if( FD_UNLIKELY( !slot_hashes_global ) ) return NULL;
+
+  fd_slot_hash_t * slot_hash = deq_fd_slot_hash_t_join( (uchar *)slot_hashes_global + slot_hashes_global->hashes_offset );
+  int err = fd_runtime_load_txn_address_lookup_tables( TXN( txn_p ),
+                                                       txn_p->payload,
+                                                       slot_ctx->funk,
+                                                       slot_ctx->funk_txn,
+                                                       slot_ctx->slot_bank.slot,
+                                                       slot_hash,
+                                                       out );
+  return err==FD_RUNTIME_EXECUTE_SUCCESS ? out : NULL;
+}
+
 static void
 exec_slice( fd_replay_tile_ctx_t * ctx,
              fd_stem_context_t *   stem,
              ulong                 slot ) {
-  /* Buffer up to a certain number of slices (configurable?). Then, for
-     each microblock, round robin dispatch the transactions in that
-     microblock to the exec tile. Once exec tile signifies with a
-     retcode, we can continue dispatching transactions. Have to
-     synchronize at the boundary of every microblock. After we dispatch
-     one to each exec tile, we watermark (ctx->mbatch_wmark) where we
-     are, and then continue on the following after_credit. If we still
-     have txns to execute, start from wmark, pausing everytime we hit
-     the microblock boundaries. */
+  /* Transactions of the slice are parsed in block order into the
+     replay scheduler's window (see fd_replay_sched.h), which hands
+     out any transaction that does not conflict with an earlier
+     incomplete one.  Transactions from consecutive microblocks (and
+     slices) can therefore execute concurrently on the exec tiles,
+     instead of synchronizing at the boundary of every microblock.  A
+     transaction is complete once a writer tile finalized it, see
+     handle_writer_state_updates.  If the window is full, we watermark
+     (ctx->slice_exec_ctx.wmark) where we are and continue on the
+     following after_credit. */
 
   /* Manual population of the slice deque occurs currently when we are:
       1. Repairing and catching up. All shreds in this case come through
@@ -1643,141 +1702,131 @@ exec_slice( fd_replay_tile_ctx_t * ctx,
          be added to the slice_deque through SHRED, but missing shreds
          are still received through repair, and aren't processed in  */
 
-  /* First we will count the number of free exec tiles. If we are
-     currently blocked on other transactions on the mblock boundary */
-
-  uchar to_exec[ FD_PACK_MAX_BANK_TILES ];
-  uchar num_free_exec_tiles = 0UL;
-  for( uchar i=0; i<ctx->exec_cnt; i++ ) {
-    if( ctx->exec_ready[ i ]==EXEC_TXN_READY ) {
-      to_exec[ num_free_exec_tiles++ ] = i;
-    }
-  }
-
-  if( ctx->blocked_on_mblock ) {
-    if( num_free_exec_tiles==ctx->exec_cnt ) {
-      ctx->blocked_on_mblock = 0;
-    } else {
-      return;
-    }
+  fd_fork_t * fork = fd_fork_frontier_ele_query( ctx->forks->frontier,
+                                                 &slot,
+                                                 NULL,
+                                                 ctx->forks->pool );
+  if( FD_UNLIKELY( !fork ) ) {
+    FD_LOG_ERR(( "Unable to select a fork" ));
   }
 
-  uchar start_num_free_exec_tiles = (uchar)ctx->exec_cnt;
-  while( num_free_exec_tiles>0 ) {
-
-    /* change to whatever condition handles if(ex ec free). */
-    if( ctx->slice_exec_ctx.txns_rem > 0 && num_free_exec_tiles > 0 ) {
-
-      ulong tsorig = fd_frag_meta_ts_comp( fd_tickcount() );
-
-      uchar exec_idx = to_exec[ num_free_exec_tiles-1 ];
-      //FD_LOG_WARNING(( "[%s] executing txn", __func__ ));
-      ulong                             pay_sz   = 0UL;
-      fd_replay_out_ctx_t *             exec_out = &ctx->exec_out[ exec_idx ];
-      fd_txn_p_t txn_p;
-      ulong txn_sz = fd_txn_parse_core( ctx->mbatch + ctx->slice_exec_ctx.wmark,
-                                        fd_ulong_min( FD_TXN_MTU, ctx->slice_exec_ctx.sz - ctx->slice_exec_ctx.wmark ),
-                                        TXN( &txn_p ),
-                                        NULL,
-                                        &pay_sz );
-
-      if( FD_UNLIKELY( !pay_sz || !txn_sz || txn_sz > FD_TXN_MTU ) ) {
-        FD_LOG_ERR(( "failed to parse transaction in replay" ));
-      }
-      fd_memcpy( txn_p.payload, ctx->mbatch + ctx->slice_exec_ctx.wmark, pay_sz );
-      txn_p.payload_sz           = pay_sz;
-      ctx->slice_exec_ctx.wmark += pay_sz;
-
-      fd_runtime_public_txn_msg_t * exec_msg = (fd_runtime_public_txn_msg_t *)fd_chunk_to_laddr( exec_out->mem, exec_out->chunk );
-      memcpy( &exec_msg->txn, &txn_p, sizeof(fd_txn_p_t) );
-
-      fd_fork_t * fork = fd_fork_frontier_ele_query( ctx->forks->frontier,
-                                                     &slot,
-                                                     NULL,
-                                                     ctx->forks->pool );
-      if( FD_UNLIKELY( !fork ) ) {
-        FD_LOG_ERR(( "Unable to select a fork" ));
-      }
-
-      publish_account_notifications( ctx, fork, ctx->curr_slot, &txn_p, 1 );
-
-      /* dispatch dcache */
-      ctx->exec_ready[ exec_idx ] = EXEC_TXN_BUSY;
-      ulong tspub = fd_frag_meta_ts_comp( fd_tickcount() );
-      fd_stem_publish( stem, exec_out->idx, EXEC_NEW_TXN_SIG, exec_out->chunk, sizeof(fd_runtime_public_txn_msg_t), 0UL, tsorig, tspub );
-      exec_out->chunk = fd_dcache_compact_next( exec_out->chunk, sizeof(fd_runtime_public_txn_msg_t), exec_out->chunk0, exec_out->wmark );
+  /* Fill the scheduler window from the slice */
 
-      ctx->slice_exec_ctx.txns_rem--;
-      num_free_exec_tiles--;
-      fork->slot_ctx->txn_count++;
-      continue;
-    }
+  for(;;) {
 
     /* If the current microblock is complete, and we still have mblks
        to read, then advance to the next microblock */
 
-    if( ctx->slice_exec_ctx.txns_rem == 0 && ctx->slice_exec_ctx.mblks_rem > 0 ){
+    if( ctx->slice_exec_ctx.txns_rem==0 ) {
+      if( ctx->slice_exec_ctx.mblks_rem==0 ) break;
       fd_microblock_hdr_t * hdr = (fd_microblock_hdr_t *)fd_type_pun( ctx->mbatch + ctx->slice_exec_ctx.wmark );
       FD_LOG_DEBUG(( "[%s] reading microblock with %lu txns", __func__, hdr->txn_cnt ));
-      ctx->blocked_on_mblock            = 1;
       ctx->slice_exec_ctx.txns_rem      = hdr->txn_cnt;
       ctx->slice_exec_ctx.last_mblk_off = ctx->slice_exec_ctx.wmark;
       ctx->slice_exec_ctx.wmark        += sizeof(fd_microblock_hdr_t);
       ctx->slice_exec_ctx.mblks_rem--;
-      break; /* have to synchronize & wait for exec tiles to finish the prev microblock */
+      continue;
     }
 
-    if( ctx->slice_exec_ctx.txns_rem == 0 && ctx->slice_exec_ctx.mblks_rem == 0 ){
-      /* If we reach this point, we have finished executing all the
-         microblocks in the slice. */
-      ctx->flags = EXEC_FLAG_READY_NEW;
-      break;
+    ulong      pay_sz = 0UL;
+    fd_txn_p_t txn_p;
+    ulong txn_sz = fd_txn_parse_core( ctx->mbatch + ctx->slice_exec_ctx.wmark,
+                                      fd_ulong_min( FD_TXN_MTU, ctx->slice_exec_ctx.sz - ctx->slice_exec_ctx.wmark ),
+                                      TXN( &txn_p ),
+                                      NULL,
+                                      &pay_sz );
+
+    if( FD_UNLIKELY( !pay_sz || !txn_sz || txn_sz > FD_TXN_MTU ) ) {
+      FD_LOG_ERR(( "failed to parse transaction in replay" ));
     }
-  }
+    fd_memcpy( txn_p.payload, ctx->mbatch + ctx->slice_exec_ctx.wmark, pay_sz );
+    txn_p.payload_sz = pay_sz;
 
-  if( ctx->slice_exec_ctx.last_batch && ctx->slice_exec_ctx.mblks_rem == 0 && ctx->slice_exec_ctx.txns_rem == 0 ){
+    fd_acct_addr_t         alt_accts[ FD_TXN_ACCT_ADDR_MAX ];
+    fd_acct_addr_t const * alt = NULL;
+    if( TXN( &txn_p )->transaction_version==FD_TXN_V0 ) {
+      alt = replay_resolve_alts( ctx, fork, &txn_p, alt_accts );
+    }
 
-    if( num_free_exec_tiles != start_num_free_exec_tiles ) {
-      FD_LOG_DEBUG(( "blocked on exec tiles completing" ));
-      return;
+    if( fd_replay_sched_insert( ctx->sched, &txn_p, alt )==FD_REPLAY_SCHED_IDX_NULL ) {
+      break; /* window is full, retry once some txns complete */
     }
+    ctx->slice_exec_ctx.wmark += pay_sz;
+    ctx->slice_exec_ctx.txns_rem--;
+  }
 
-    FD_LOG_DEBUG(( "[%s] BLOCK EXECUTION COMPLETE", __func__ ));
+  /* Dispatch ready txns to free exec tiles */
 
-     /* At this point, the entire block has been executed. */
-     fd_fork_t * fork = fd_fork_frontier_ele_query( ctx->forks->frontier,
-                                                    &slot,
-                                                    NULL,
-                                                    ctx->forks->pool );
-     if( FD_UNLIKELY( !fork ) ) {
-       FD_LOG_ERR(( "Unable to select a fork" ));
-     }
+  for( uchar exec_idx=0; exec_idx<ctx->exec_cnt; exec_idx++ ) {
+    if( ctx->exec_ready[ exec_idx ]!=EXEC_TXN_READY ) continue;
 
-     fd_microblock_hdr_t * hdr = (fd_microblock_hdr_t*)fd_type_pun( ctx->mbatch + ctx->slice_exec_ctx.last_mblk_off );
+    ulong sched_idx = fd_replay_sched_next( ctx->sched );
+    if( sched_idx==FD_REPLAY_SCHED_IDX_NULL ) break;
+
+    ulong tsorig = fd_frag_meta_ts_comp( fd_tickcount() );
 
-     // Copy block hash to slot_bank poh for updating the sysvars
-     fd_block_map_query_t query[1] = { 0 };
-     fd_block_map_prepare( ctx->blockstore->block_map, &ctx->curr_slot, NULL, query, FD_MAP_FLAG_BLOCKING );
-     fd_block_info_t * block_info = fd_block_map_query_ele( query );
+    fd_replay_out_ctx_t * exec_out = &ctx->exec_out[ exec_idx ];
+    fd_txn_p_t *          txn_p    = fd_replay_sched_txn( ctx->sched, sched_idx );
 
-     memcpy( fork->slot_ctx->slot_bank.poh.uc, hdr->hash, sizeof(fd_hash_t) );
-     block_info->flags = fd_uchar_set_bit( block_info->flags, FD_BLOCK_FLAG_PROCESSED );
-     FD_COMPILER_MFENCE();
-     block_info->flags = fd_uchar_clear_bit( block_info->flags, FD_BLOCK_FLAG_REPLAYING );
-     memcpy( &block_info->block_hash, hdr->hash, sizeof(fd_hash_t) );
-     memcpy( &block_info->bank_hash, &fork->slot_ctx->slot_bank.banks_hash, sizeof(fd_hash_t) );
+    fd_runtime_public_txn_msg_t * exec_msg = (fd_runtime_public_txn_msg_t *)fd_chunk_to_laddr( exec_out->mem, exec_out->chunk );
+    memcpy( &exec_msg->txn, txn_p, sizeof(fd_txn_p_t) );
 
-     fd_block_map_publish( query );
-     ctx->flags = EXEC_FLAG_FINISHED_SLOT;
+    publish_account_notifications( ctx, fork, ctx->curr_slot, txn_p, 1 );
 
-     ctx->slice_exec_ctx.last_batch = 0;
-     ctx->slice_exec_ctx.txns_rem = 0;
-     ctx->slice_exec_ctx.mblks_rem = 0;
-     ctx->slice_exec_ctx.sz = 0;
-     ctx->slice_exec_ctx.wmark = 0;
-     ctx->slice_exec_ctx.last_mblk_off = 0;
+    /* dispatch dcache */
+    ctx->exec_ready[ exec_idx ]     = EXEC_TXN_BUSY;
+    ctx->exec_sched_idx[ exec_idx ] = sched_idx;
+    ulong tspub = fd_frag_meta_ts_comp( fd_tickcount() );
+    fd_stem_publish( stem, exec_out->idx, EXEC_NEW_TXN_SIG, exec_out->chunk, sizeof(fd_runtime_public_txn_msg_t), 0UL, tsorig, tspub );
+    exec_out->chunk = fd_dcache_compact_next( exec_out->chunk, sizeof(fd_runtime_public_txn_msg_t), exec_out->chunk0, exec_out->wmark );
+
+    fork->slot_ctx->txn_count++;
   }
 
+  /* The slice is done once all of its txns have been handed out.  The
+     next slice of the same block can be loaded while they are still
+     executing, since the scheduler holds copies of them. */
+
+  if( ctx->slice_exec_ctx.txns_rem || ctx->slice_exec_ctx.mblks_rem || fd_replay_sched_pending_cnt( ctx->sched ) ) {
+    return;
+  }
+
+  if( !ctx->slice_exec_ctx.last_batch ) {
+    ctx->flags = EXEC_FLAG_READY_NEW;
+    return;
+  }
+
+  if( fd_replay_sched_txn_cnt( ctx->sched ) ) {
+    FD_LOG_DEBUG(( "blocked on exec tiles completing" ));
+    return;
+  }
+
+  FD_LOG_DEBUG(( "[%s] BLOCK EXECUTION COMPLETE", __func__ ));
+
+  /* At this point, the entire block has been executed. */
+  fd_microblock_hdr_t * hdr = (fd_microblock_hdr_t*)fd_type_pun( ctx->mbatch + ctx->slice_exec_ctx.last_mblk_off );
+
+  // Copy block hash to slot_bank poh for updating the sysvars
+  fd_block_map_query_t query[1] = { 0 };
+  fd_block_map_prepare( ctx->blockstore->block_map, &ctx->curr_slot, NULL, query, FD_MAP_FLAG_BLOCKING );
+  fd_block_info_t * block_info = fd_block_map_query_ele( query );
+
+  memcpy( fork->slot_ctx->slot_bank.poh.uc, hdr->hash, sizeof(fd_hash_t) );
+  block_info->flags = fd_uchar_set_bit( block_info->flags, FD_BLOCK_FLAG_PROCESSED );
+  FD_COMPILER_MFENCE();
+  block_info->flags = fd_uchar_clear_bit( block_info->flags, FD_BLOCK_FLAG_REPLAYING );
+  memcpy( &block_info->block_hash, hdr->hash, sizeof(fd_hash_t) );
+  memcpy( &block_info->bank_hash, &fork->slot_ctx->slot_bank.banks_hash, sizeof(fd_hash_t) );
+
+  fd_block_map_publish( query );
+  ctx->flags = EXEC_FLAG_FINISHED_SLOT;
+
+  ctx->slice_exec_ctx.last_batch = 0;
+  ctx->slice_exec_ctx.txns_rem = 0;
+  ctx->slice_exec_ctx.mblks_rem = 0;
+  ctx->slice_exec_ctx.sz = 0;
+  ctx->slice_exec_ctx.wmark = 0;
+  ctx->slice_exec_ctx.last_mblk_off = 0;
 }
 
 static void
@@ -1789,7 +1838,15 @@ handle_slice( fd_replay_tile_ctx_t * ctx,
     return;
   }
 
-  ulong sig = fd_exec_slice_pop_head( ctx->exec_slice_deque );
+  ulong sig = *fd_exec_slice_peek_head( ctx->exec_slice_deque );
+
+  /* Txns of previous slices of the current slot may still be executing.
+     Wait for them to complete before switching to a different slot. */
+  if( FD_UNLIKELY( fd_disco_repair_replay_sig_slot( sig )!=ctx->curr_slot && fd_replay_sched_txn_cnt( ctx->sched ) ) ) {
+    FD_LOG_DEBUG(( "blocked on exec tiles completing before switching slots" ));
+    return;
+  }
+  fd_exec_slice_pop_head( ctx->exec_slice_deque );
 
   if( FD_UNLIKELY( ctx->flags!=EXEC_FLAG_READY_NEW ) ) {
     FD_LOG_ERR(( "Replay is in unexpected state" ));
@@ -2166,6 +2223,8 @@ init_snapshot( fd_replay_tile_ctx_t * ctx,
   ctx->slot_ctx->blockstore   = ctx->blockstore;
   ctx->slot_ctx->epoch_ctx    = ctx->epoch_ctx;
   ctx->slot_ctx->status_cache = ctx->status_cache;
+  ctx->slot_ctx->progcache    = ctx->progcache;
+  ctx->slot_ctx->lthash_delta = ctx->lthash_delta;
   fd_runtime_update_slots_per_epoch( ctx->slot_ctx, FD_DEFAULT_SLOTS_PER_EPOCH );
 
   uchar is_snapshot = strlen( ctx->snapshot ) > 0;
@@ -2429,6 +2488,12 @@ handle_writer_state_updates( fd_replay_tile_ctx_t * ctx ) {
           FD_LOG_DEBUG(( "Ack that exec tile idx=%lu txn id=%u has been finalized by writer tile %lu", exec_tile_id, txn_id, i ));
           ctx->exec_ready[ exec_tile_id ] = EXEC_TXN_READY;
           ctx->prev_ids[ exec_tile_id ]   = txn_id;
+          /* The txn's effects are now visible, which may unblock
+             later txns that conflict with it. */
+          if( ctx->exec_sched_idx[ exec_tile_id ]!=FD_REPLAY_SCHED_IDX_NULL ) {
+            fd_replay_sched_complete( ctx->sched, ctx->exec_sched_idx[ exec_tile_id ] );
+            ctx->exec_sched_idx[ exec_tile_id ] = FD_REPLAY_SCHED_IDX_NULL;
+          }
           fd_fseq_update( ctx->writer_fseq[ i ], FD_WRITER_STATE_READY );
         }
         break;
@@ -2821,6 +2886,7 @@ unprivileged_init( fd_topo_t *      topo,
     ctx->bmtree[i]           = FD_SCRATCH_ALLOC_APPEND( l, FD_BMTREE_COMMIT_ALIGN, FD_BMTREE_COMMIT_FOOTPRINT(0) );
   }
   void * mbatch_mem          = FD_SCRATCH_ALLOC_APPEND( l, 128UL, FD_SLICE_MAX );
+  void * sched_mem           = FD_SCRATCH_ALLOC_APPEND( l, fd_replay_sched_align(), fd_replay_sched_footprint( REPLAY_SCHED_DEPTH ) );
   ulong  scratch_alloc_mem   = FD_SCRATCH_ALLOC_FINI  ( l, scratch_align() );
 
   if( FD_UNLIKELY( scratch_alloc_mem != ( (ulong)scratch + scratch_footprint( tile ) ) ) ) {
@@ -2978,6 +3044,32 @@ unprivileged_init( fd_topo_t *      topo,
     }
   }
 
+  /**********************************************************************/
+  /* program cache                                                      */
+  /**********************************************************************/
+
+  ctx->progcache = NULL;
+  ulong progcache_obj_id = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "progcache" );
+  if( FD_LIKELY( progcache_obj_id!=ULONG_MAX ) ) {
+    ctx->progcache = fd_progcache_join( fd_topo_obj_laddr( topo, progcache_obj_id ) );
+    if( FD_UNLIKELY( !ctx->progcache ) ) {
+      FD_LOG_ERR(( "failed to join program cache" ));
+    }
+  }
+
+  /**********************************************************************/
+  /* accounts lthash delta                                              */
+  /**********************************************************************/
+
+  ctx->lthash_delta = NULL;
+  ulong lthash_delta_obj_id = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "lthash_delta" );
+  if( FD_LIKELY( lthash_delta_obj_id!=ULONG_MAX ) ) {
+    ctx->lthash_delta = fd_lthash_delta_join( fd_topo_obj_laddr( topo, lthash_delta_obj_id ) );
+    if( FD_UNLIKELY( !ctx->lthash_delta ) ) {
+      FD_LOG_ERR(( "failed to join lthash delta" ));
+    }
+  }
+
   /**********************************************************************/
   /* spad                                                               */
   /**********************************************************************/
@@ -3061,6 +3153,11 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->mbatch = mbatch_mem;
   memset( &ctx->slice_exec_ctx, 0, sizeof(fd_slice_exec_ctx_t) );
 
+  ctx->sched = fd_replay_sched_join( fd_replay_sched_new( sched_mem, REPLAY_SCHED_DEPTH ) );
+  if( FD_UNLIKELY( !ctx->sched ) ) {
+    FD_LOG_ERR(( "failed to create replay scheduler" ));
+  }
+
   /**********************************************************************/
   /* capture                                                            */
   /**********************************************************************/
@@ -3118,9 +3215,10 @@ unprivileged_init( fd_topo_t *      topo,
 
   for( ulong i = 0UL; i < ctx->exec_cnt; i++ ) {
     /* Mark all initial state as not being ready. */
-    ctx->exec_ready[ i ]    = EXEC_BOOT_WAIT;
-    ctx->prev_ids[ i ]      = FD_EXEC_ID_SENTINEL;
-    ctx->exec_txn_ctxs[ i ] = NULL;
+    ctx->exec_ready[ i ]     = EXEC_BOOT_WAIT;
+    ctx->prev_ids[ i ]       = FD_EXEC_ID_SENTINEL;
+    ctx->exec_txn_ctxs[ i ]  = NULL;
+    ctx->exec_sched_idx[ i ] = FD_REPLAY_SCHED_IDX_NULL;
 
     ulong exec_fseq_id = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "exec_fseq.%lu", i );
     if( FD_UNLIKELY( exec_fseq_id==ULONG_MAX ) ) {
@@ -3329,6 +3427,24 @@ static inline void
 metrics_write( fd_replay_tile_ctx_t * ctx ) {
   FD_MGAUGE_SET( REPLAY, LAST_VOTED_SLOT, ctx->metrics.last_voted_slot );
   FD_MGAUGE_SET( REPLAY, SLOT, ctx->metrics.slot );
+
+  if( FD_LIKELY( ctx->progcache ) ) {
+    fd_progcache_metrics_t progcache_metrics[1];
+    fd_progcache_metrics_snap( ctx->progcache, progcache_metrics );
+    FD_MCNT_SET(   REPLAY, PROGCACHE_HIT,        progcache_metrics->hit_cnt        );
+    FD_MCNT_SET(   REPLAY, PROGCACHE_MISS,       progcache_metrics->miss_cnt       );
+    FD_MCNT_SET(   REPLAY, PROGCACHE_INSERT,     progcache_metrics->insert_cnt     );
+    FD_MCNT_SET(   REPLAY, PROGCACHE_EVICT,      progcache_metrics->evict_cnt      );
+    FD_MCNT_SET(   REPLAY, PROGCACHE_INVALIDATE, progcache_metrics->invalidate_cnt );
+    FD_MGAUGE_SET( REPLAY, PROGCACHE_DATA_SZ,    progcache_metrics->data_sz        );
+  }
+
+  fd_funk_cold_metrics_t const * cold = fd_funk_cold_metrics( ctx->funk );
+  FD_MCNT_SET(   REPLAY, FUNK_DEMOTE,        cold->demote_cnt       );
+  FD_MCNT_SET(   REPLAY, FUNK_DEMOTE_BYTES,  cold->demote_byte_cnt  );
+  FD_MCNT_SET(   REPLAY, FUNK_PROMOTE,       cold->promote_cnt      );
+  FD_MCNT_SET(   REPLAY, FUNK_PROMOTE_BYTES, cold->promote_byte_cnt );
+  FD_MGAUGE_SET( REPLAY, FUNK_COLD_RECORDS,  cold->rec_cnt          );
 }
 
 /* TODO: This needs to get sized out correctly. */
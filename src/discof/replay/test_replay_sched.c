@@ -0,0 +1,285 @@
+#include "fd_replay_sched.h"
+
+#define DEPTH    (64UL)
+#define ACCT_CNT (48UL)
+#define TXN_CNT  (4096UL)
+
+static uchar _sched[ 1UL<<24 ] __attribute__((aligned(FD_REPLAY_SCHED_ALIGN)));
+
+/* make_txn builds a legacy txn referencing acct_cnt accounts from the
+   set of test accounts.  The first writable_cnt accounts are writable.
+   Only the fields the scheduler looks at are populated. */
+
+static void
+make_txn_ex( fd_txn_p_t *  txn_p,
+             uchar const * acct_idx,
+             ulong         acct_cnt,
+             ulong         writable_cnt,
+             uchar         acct_hi ) {
+  fd_memset( txn_p, 0, sizeof(fd_txn_p_t) );
+  fd_txn_t * txn = TXN(txn_p);
+  txn->transaction_version   = FD_TXN_VLEGACY;
+  txn->signature_cnt         = 1;
+  txn->readonly_signed_cnt   = (uchar)!writable_cnt; /* the fee payer is only readonly in a txn without writable accounts */
+  txn->acct_addr_cnt         = (ushort)acct_cnt;
+  txn->readonly_unsigned_cnt = (uchar)(acct_cnt-fd_ulong_max( writable_cnt, 1UL ));
+  txn->acct_addr_off         = 0;
+  for( ulong i=0UL; i<acct_cnt; i++ ) {
+    fd_acct_addr_t * acct = (fd_acct_addr_t *)txn_p->payload + i;
+    fd_memset( acct->b, 0, 32UL );
+    acct->b[ 0 ] = 0xa5;
+    acct->b[ 1 ] = acct_idx[ i ];
+    acct->b[ 2 ] = acct_hi;
+  }
+  txn_p->payload_sz = 32UL*acct_cnt;
+}
+
+static void
+make_txn( fd_txn_p_t *  txn_p,
+          uchar const * acct_idx,
+          ulong         acct_cnt,
+          ulong         writable_cnt ) {
+  make_txn_ex( txn_p, acct_idx, acct_cnt, writable_cnt, 0 );
+}
+
+/* acct_writes/acct_reads track, per test account, how many executing
+   txns currently write/read it.  Any overlap between a writer and
+   another user is a scheduling bug. */
+
+static ulong acct_writes[ 256 ];
+static ulong acct_reads [ 256 ];
+
+static void
+exec_begin( fd_txn_p_t const * txn_p ) {
+  fd_txn_t const * txn = TXN(txn_p);
+  for( ushort i=0; i<txn->acct_addr_cnt; i++ ) {
+    uchar a = txn_p->payload[ 32UL*i+1UL ];
+    if( fd_txn_is_writable( txn, i ) ) { FD_TEST( !acct_writes[ a ] && !acct_reads[ a ] ); acct_writes[ a ]++; }
+    else                               { FD_TEST( !acct_writes[ a ]                      ); acct_reads [ a ]++; }
+  }
+}
+
+static void
+exec_end( fd_txn_p_t const * txn_p ) {
+  fd_txn_t const * txn = TXN(txn_p);
+  for( ushort i=0; i<txn->acct_addr_cnt; i++ ) {
+    uchar a = txn_p->payload[ 32UL*i+1UL ];
+    if( fd_txn_is_writable( txn, i ) ) acct_writes[ a ]--;
+    else                               acct_reads [ a ]--;
+  }
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_TEST( fd_replay_sched_align()==FD_REPLAY_SCHED_ALIGN );
+  FD_TEST( !fd_replay_sched_footprint( 0UL         ) );
+  FD_TEST( !fd_replay_sched_footprint( 3UL         ) );
+  FD_TEST( !fd_replay_sched_footprint( 1UL<<17     ) );
+  ulong footprint = fd_replay_sched_footprint( DEPTH );
+  FD_TEST( footprint && footprint<=sizeof(_sched) );
+
+  FD_TEST( !fd_replay_sched_new( NULL,        DEPTH ) );
+  FD_TEST( !fd_replay_sched_new( _sched+1UL,  DEPTH ) );
+  FD_TEST( !fd_replay_sched_new( _sched,      3UL   ) );
+  void * shsched = fd_replay_sched_new( _sched, DEPTH ); FD_TEST( shsched==_sched );
+
+  FD_TEST( !fd_replay_sched_join( NULL       ) );
+  FD_TEST( !fd_replay_sched_join( _sched+1UL ) );
+  fd_replay_sched_t * sched = fd_replay_sched_join( shsched ); FD_TEST( sched );
+
+  FD_TEST( fd_replay_sched_next( sched )==FD_REPLAY_SCHED_IDX_NULL );
+
+  fd_txn_p_t txn[1];
+
+  /* Independent txns in separate "microblocks" run concurrently,
+     conflicting ones are serialized in block order. */
+
+  uchar a01[2] = { 0, 1 }; uchar a23[2] = { 2, 3 }; uchar a1[1] = { 1 };
+  make_txn( txn, a01, 2UL, 1UL ); ulong t0 = fd_replay_sched_insert( sched, txn, NULL ); /* w0 r1 */
+  make_txn( txn, a23, 2UL, 2UL ); ulong t1 = fd_replay_sched_insert( sched, txn, NULL ); /* w2 w3 */
+  make_txn( txn, a1,  1UL, 0UL ); ulong t2 = fd_replay_sched_insert( sched, txn, NULL ); /* r1    */
+  make_txn( txn, a1,  1UL, 1UL ); ulong t3 = fd_replay_sched_insert( sched, txn, NULL ); /* w1    */
+  make_txn( txn, a23, 1UL, 0UL ); ulong t4 = fd_replay_sched_insert( sched, txn, NULL ); /* r2    */
+  FD_TEST( t0!=FD_REPLAY_SCHED_IDX_NULL && t1!=FD_REPLAY_SCHED_IDX_NULL && t2!=FD_REPLAY_SCHED_IDX_NULL &&
+           t3!=FD_REPLAY_SCHED_IDX_NULL && t4!=FD_REPLAY_SCHED_IDX_NULL );
+  FD_TEST( fd_replay_sched_txn_cnt    ( sched )==5UL );
+  FD_TEST( fd_replay_sched_pending_cnt( sched )==5UL );
+
+  FD_TEST( fd_replay_sched_next( sched )==t0 );
+  FD_TEST( fd_replay_sched_next( sched )==t1 );
+  FD_TEST( fd_replay_sched_next( sched )==t2 ); /* read-read */
+  FD_TEST( fd_replay_sched_next( sched )==FD_REPLAY_SCHED_IDX_NULL ); /* t3 waits on t0 and t2, t4 on t1 */
+  fd_replay_sched_complete( sched, t1 );
+  FD_TEST( fd_replay_sched_next( sched )==t4 );
+  fd_replay_sched_complete( sched, t2 );
+  FD_TEST( fd_replay_sched_next( sched )==FD_REPLAY_SCHED_IDX_NULL ); /* t3 still waits on t0 */
+  fd_replay_sched_complete( sched, t0 );
+  FD_TEST( fd_replay_sched_next( sched )==t3 );
+  fd_replay_sched_complete( sched, t3 );
+  fd_replay_sched_complete( sched, t4 );
+  FD_TEST( !fd_replay_sched_txn_cnt( sched ) && !fd_replay_sched_pending_cnt( sched ) );
+
+  /* A v0 txn whose lookup tables were not resolved is a barrier */
+
+  make_txn( txn, a01, 1UL, 1UL ); t0 = fd_replay_sched_insert( sched, txn, NULL );
+  make_txn( txn, a23, 1UL, 1UL );
+  TXN(txn)->transaction_version = FD_TXN_V0;
+  TXN(txn)->addr_table_lookup_cnt = 1;
+  TXN(txn)->addr_table_adtl_cnt   = 1;
+  t1 = fd_replay_sched_insert( sched, txn, NULL );
+  make_txn( txn, a23+1, 1UL, 1UL ); t2 = fd_replay_sched_insert( sched, txn, NULL );
+  FD_TEST( fd_replay_sched_next( sched )==t0 );
+  FD_TEST( fd_replay_sched_next( sched )==FD_REPLAY_SCHED_IDX_NULL );
+  fd_replay_sched_complete( sched, t0 );
+  FD_TEST( fd_replay_sched_next( sched )==t1 );
+  FD_TEST( fd_replay_sched_next( sched )==FD_REPLAY_SCHED_IDX_NULL );
+  fd_replay_sched_complete( sched, t1 );
+  FD_TEST( fd_replay_sched_next( sched )==t2 );
+  fd_replay_sched_complete( sched, t2 );
+
+  /* With the lookup tables resolved, the lookup table accounts count */
+
+  fd_acct_addr_t alt[1]; fd_memset( alt, 0, sizeof(alt) ); alt->b[ 0 ] = 0xa5; alt->b[ 1 ] = 0;
+  make_txn( txn, a01, 1UL, 1UL ); t0 = fd_replay_sched_insert( sched, txn, NULL ); /* w0 */
+  make_txn( txn, a23, 1UL, 1UL );
+  TXN(txn)->transaction_version          = FD_TXN_V0;
+  TXN(txn)->addr_table_lookup_cnt        = 1;
+  TXN(txn)->addr_table_adtl_cnt          = 1;
+  TXN(txn)->addr_table_adtl_writable_cnt = 0;
+  t1 = fd_replay_sched_insert( sched, txn, alt ); /* w2 r0 (via lookup table) */
+  make_txn( txn, a23+1, 1UL, 1UL ); t2 = fd_replay_sched_insert( sched, txn, NULL ); /* w3 */
+  FD_TEST( fd_replay_sched_next( sched )==t0 );
+  FD_TEST( fd_replay_sched_next( sched )==t2 );
+  FD_TEST( fd_replay_sched_next( sched )==FD_REPLAY_SCHED_IDX_NULL );
+  fd_replay_sched_complete( sched, t0 );
+  FD_TEST( fd_replay_sched_next( sched )==t1 );
+  fd_replay_sched_complete( sched, t1 );
+  fd_replay_sched_complete( sched, t2 );
+
+  /* The window is bounded */
+
+  for( ulong i=0UL; i<DEPTH; i++ ) {
+    uchar a = (uchar)(i%ACCT_CNT);
+    make_txn( txn, &a, 1UL, 0UL );
+    FD_TEST( fd_replay_sched_insert( sched, txn, NULL )!=FD_REPLAY_SCHED_IDX_NULL );
+  }
+  FD_TEST( fd_replay_sched_insert( sched, txn, NULL )==FD_REPLAY_SCHED_IDX_NULL );
+  for( ulong i=0UL; i<DEPTH; i++ ) {
+    ulong idx = fd_replay_sched_next( sched );
+    FD_TEST( idx!=FD_REPLAY_SCHED_IDX_NULL );
+    fd_replay_sched_complete( sched, idx );
+  }
+  FD_TEST( !fd_replay_sched_txn_cnt( sched ) );
+
+  /* Every account in the window needs a bit, txns that don't fit wait
+     for bits to be released */
+
+  ulong bit_txn_cnt = 0UL;
+  for( ulong i=0UL; i<DEPTH; i++ ) {
+    uchar acct[ 32 ];
+    for( ulong j=0UL; j<32UL; j++ ) acct[ j ] = (uchar)j;
+    make_txn_ex( txn, acct, 32UL, 32UL, (uchar)(1UL+i) );
+    if( fd_replay_sched_insert( sched, txn, NULL )==FD_REPLAY_SCHED_IDX_NULL ) break;
+    bit_txn_cnt++;
+  }
+  FD_TEST( bit_txn_cnt && bit_txn_cnt<DEPTH );
+  ulong first = fd_replay_sched_next( sched );
+  FD_TEST( first!=FD_REPLAY_SCHED_IDX_NULL );
+  fd_replay_sched_complete( sched, first );
+  FD_TEST( fd_replay_sched_insert( sched, txn, NULL )!=FD_REPLAY_SCHED_IDX_NULL );
+  for( ulong i=0UL; i<bit_txn_cnt; i++ ) {
+    ulong idx = fd_replay_sched_next( sched );
+    FD_TEST( idx!=FD_REPLAY_SCHED_IDX_NULL );
+    fd_replay_sched_complete( sched, idx );
+  }
+  FD_TEST( !fd_replay_sched_txn_cnt( sched ) );
+
+  /* Randomized: txns are inserted in block order and completed in a
+     random order by a simulated set of exec tiles.  Check that no two
+     conflicting txns ever execute concurrently, that conflicting txns
+     execute in block order and that everything drains. */
+
+  ulong exec_idx[ 8 ];
+  ulong exec_seq[ 8 ];
+  for( ulong i=0UL; i<8UL; i++ ) exec_idx[ i ] = FD_REPLAY_SCHED_IDX_NULL;
+  ulong last_write_seq[ 256 ]; for( ulong i=0UL; i<256UL; i++ ) last_write_seq[ i ] = ULONG_MAX;
+  ulong idx_seq[ DEPTH ];
+
+  ulong inserted = 0UL;
+  ulong executed = 0UL;
+  ulong max_conc = 0UL;
+  while( executed<TXN_CNT ) {
+    /* Insert as many txns as fit */
+    while( inserted<TXN_CNT ) {
+      uchar acct[ 8 ];
+      ulong acct_cnt = 1UL + fd_rng_ulong_roll( rng, 8UL );
+      for( ulong i=0UL; i<acct_cnt; i++ ) {
+        for(;;) {
+          acct[ i ] = (uchar)fd_rng_ulong_roll( rng, ACCT_CNT );
+          int dup = 0;
+          for( ulong j=0UL; j<i; j++ ) dup |= acct[ j ]==acct[ i ];
+          if( !dup ) break;
+        }
+      }
+      ulong writable_cnt = 1UL + fd_rng_ulong_roll( rng, acct_cnt );
+      make_txn( txn, acct, acct_cnt, writable_cnt );
+      ulong idx = fd_replay_sched_insert( sched, txn, NULL );
+      if( idx==FD_REPLAY_SCHED_IDX_NULL ) break;
+      idx_seq[ idx ] = inserted++;
+    }
+
+    /* Dispatch to idle tiles */
+    ulong conc = 0UL;
+    for( ulong t=0UL; t<8UL; t++ ) {
+      if( exec_idx[ t ]==FD_REPLAY_SCHED_IDX_NULL ) {
+        ulong idx = fd_replay_sched_next( sched );
+        if( idx==FD_REPLAY_SCHED_IDX_NULL ) continue;
+        fd_txn_p_t * t_p = fd_replay_sched_txn( sched, idx );
+        exec_begin( t_p );
+        /* Any earlier writer of an account this txn uses has completed */
+        fd_txn_t const * tx = TXN(t_p);
+        for( ushort i=0; i<tx->acct_addr_cnt; i++ ) {
+          ulong ws = last_write_seq[ t_p->payload[ 32UL*i+1UL ] ];
+          FD_TEST( ws==ULONG_MAX || ws<idx_seq[ idx ] );
+        }
+        exec_idx[ t ] = idx;
+        exec_seq[ t ] = idx_seq[ idx ];
+      }
+      conc += exec_idx[ t ]!=FD_REPLAY_SCHED_IDX_NULL;
+    }
+    max_conc = fd_ulong_max( max_conc, conc );
+    FD_TEST( conc ); /* never deadlocks */
+
+    /* Complete a random subset */
+    for( ulong t=0UL; t<8UL; t++ ) {
+      if( exec_idx[ t ]==FD_REPLAY_SCHED_IDX_NULL || fd_rng_uint_roll( rng, 2U ) ) continue;
+      fd_txn_p_t * t_p = fd_replay_sched_txn( sched, exec_idx[ t ] );
+      exec_end( t_p );
+      fd_txn_t const * tx = TXN(t_p);
+      for( ushort i=0; i<tx->acct_addr_cnt; i++ ) {
+        if( fd_txn_is_writable( tx, i ) ) last_write_seq[ t_p->payload[ 32UL*i+1UL ] ] = exec_seq[ t ];
+      }
+      fd_replay_sched_complete( sched, exec_idx[ t ] );
+      exec_idx[ t ] = FD_REPLAY_SCHED_IDX_NULL;
+      executed++;
+    }
+  }
+  FD_TEST( !fd_replay_sched_txn_cnt( sched ) && !fd_replay_sched_pending_cnt( sched ) );
+  FD_TEST( max_conc>1UL );
+  FD_LOG_NOTICE(( "max concurrency %lu", max_conc ));
+
+  FD_TEST( fd_replay_sched_leave( sched )==shsched );
+  FD_TEST( fd_replay_sched_delete( shsched )==shsched );
+  FD_TEST( !fd_replay_sched_join( shsched ) );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -1,9 +1,16 @@
 ifdef FD_HAS_INT128
 ifdef FD_HAS_SSE
-$(call add-hdrs,fd_rpc_service.h)
-$(call add-objs,fd_block_to_json fd_methods fd_rpc_service fd_webserver json_lex keywords fd_stub_to_json base_enc,fd_discof)
+$(call add-hdrs,fd_rpc_service.h fd_rpc_acct_index.h fd_rpc_ws_subs.h fd_rpc_cache.h)
+$(call add-objs,fd_block_to_json fd_methods fd_rpc_service fd_rpc_acct_index fd_rpc_ws_subs fd_rpc_cache fd_webserver json_lex keywords fd_stub_to_json base_enc,fd_discof)
 
 $(call make-unit-test,test_rpc_keywords,test_keywords keywords,fd_util)
+$(call make-unit-test,test_rpc_acct_index,test_rpc_acct_index fd_rpc_acct_index,fd_util)
+$(call run-unit-test,test_rpc_acct_index)
+$(call make-unit-test,test_rpc_ws_subs,test_rpc_ws_subs fd_rpc_ws_subs,fd_util)
+$(call run-unit-test,test_rpc_ws_subs)
+$(call make-unit-test,test_rpc_cache,test_rpc_cache fd_rpc_cache,fd_util)
+$(call run-unit-test,test_rpc_cache)
+$(call make-unit-test,bench_rpc_ws_subs,bench_rpc_ws_subs fd_rpc_ws_subs,fd_ballet fd_util)
 $(call make-fuzz-test,fuzz_json_lex,fuzz_json_lex json_lex,fd_util)
 endif
 endif
@@ -0,0 +1,208 @@
+/* bench_rpc_ws_subs measures the cost of dispatching account write
+   notifications to websocket accountSubscribe subscribers.  Compares the
+   original layout (a flat subscription array matched by memcmp on every
+   account write, with the account encoded for every subscriber) with
+   fd_rpc_ws_subs (lookup by account, account encoded once per distinct
+   encoding and copied into each subscriber's message).
+
+   The synthetic load has --subs subscriptions spread over --accts
+   accounts, with a few hot accounts (a popular token mint, an AMM
+   pool, ...) that have many subscribers each.  Each replay notification
+   writes --writes accounts, a quarter of which have subscribers. */
+
+#include "fd_rpc_ws_subs.h"
+#include "../../ballet/base64/fd_base64.h"
+#include <stdlib.h>
+
+#define DATA_SZ  (512UL)
+#define MSG_MAX  (FD_BASE64_ENC_SZ( DATA_SZ )+128UL)
+#define HOT_CNT  (  8UL)
+
+struct flat_sub {
+  ulong       conn_id;
+  long        meth_id;
+  char        call_id[64];
+  ulong       subsc_id;
+  fd_pubkey_t acct;
+  int         enc;
+  long        off;
+  long        len;
+};
+typedef struct flat_sub flat_sub_t;
+
+static uchar acct_data[ DATA_SZ ];
+static char  msg_buf  [ MSG_MAX ];
+static char  enc_buf  [ 2 ][ MSG_MAX ];
+
+static fd_pubkey_t
+bench_key( ulong i ) {
+  fd_pubkey_t key = {0};
+  key.ul[0] = fd_ulong_hash( i );
+  key.ul[3] = i;
+  return key;
+}
+
+/* encode mimics rendering an account for one encoding, returns the
+   number of bytes written to out */
+
+static ulong
+encode( char * out,
+        int    enc ) {
+  ulong sz = fd_base64_encode( out, acct_data, enc ? DATA_SZ : DATA_SZ/2UL );
+  FD_COMPILER_MFENCE();
+  return sz;
+}
+
+__attribute__((noinline)) static ulong
+bench_flat( flat_sub_t const *  subs,
+            ulong               sub_cnt,
+            fd_pubkey_t const * writes,
+            ulong               write_cnt,
+            ulong *             out_bytes ) {
+  ulong hit = 0UL;
+  ulong bytes = 0UL;
+  for( ulong w=0UL; w<write_cnt; w++ ) {
+    for( ulong j=0UL; j<sub_cnt; j++ ) {
+      flat_sub_t const * sub = subs + j;
+      if( sub->meth_id==1L && !memcmp( &writes[ w ], &sub->acct, sizeof(fd_pubkey_t) ) ) {
+        bytes += encode( msg_buf, sub->enc );
+        hit++;
+      }
+    }
+  }
+  *out_bytes = bytes;
+  return hit;
+}
+
+__attribute__((noinline)) static ulong
+bench_index( fd_rpc_ws_subs_t const * subs,
+             fd_pubkey_t const *      writes,
+             ulong                    write_cnt,
+             ulong *                  out_bytes ) {
+  ulong hit = 0UL;
+  ulong bytes = 0UL;
+  for( ulong w=0UL; w<write_cnt; w++ ) {
+    ulong enc_sz[ 2 ] = { 0UL, 0UL };
+    for( fd_rpc_ws_sub_t const * sub = fd_rpc_ws_subs_acct_first( subs, &writes[ w ] );
+         sub;
+         sub = fd_rpc_ws_subs_acct_next( subs, sub ) ) {
+      int enc = sub->enc;
+      if( !enc_sz[ enc ] ) enc_sz[ enc ] = encode( enc_buf[ enc ], enc );
+      fd_memcpy( msg_buf, enc_buf[ enc ], enc_sz[ enc ] );
+      FD_COMPILER_MFENCE();
+      bytes += enc_sz[ enc ];
+      hit++;
+    }
+  }
+  *out_bytes = bytes;
+  return hit;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong sub_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--subs",     NULL, 100000UL );
+  ulong acct_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--accts",    NULL,  20000UL );
+  ulong write_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--writes",   NULL,    256UL );
+  ulong iter_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter",     NULL,      4UL );
+  uint  rng_seed  = fd_env_strip_cmdline_uint ( &argc, &argv, "--rng-seed", NULL,   1234U  );
+
+  if( FD_UNLIKELY( acct_cnt<=HOT_CNT || !sub_cnt || !write_cnt ) ) FD_LOG_ERR(( "bad arguments" ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, rng_seed, 0UL ) );
+  for( ulong i=0UL; i<DATA_SZ; i++ ) acct_data[ i ] = fd_rng_uchar( rng );
+
+  flat_sub_t * flat = aligned_alloc( 128UL, fd_ulong_align_up( sub_cnt*sizeof(flat_sub_t), 128UL ) );
+  FD_TEST( flat );
+
+  ulong footprint = fd_rpc_ws_subs_footprint( sub_cnt );
+  FD_TEST( footprint );
+  void * mem = aligned_alloc( fd_rpc_ws_subs_align(), footprint );
+  FD_TEST( mem );
+  fd_rpc_ws_subs_t * subs = fd_rpc_ws_subs_join( fd_rpc_ws_subs_new( mem, sub_cnt, (ulong)rng_seed ) );
+  FD_TEST( subs );
+
+  /* Half of the subscriptions go to the hot accounts, the rest are
+     spread uniformly.  Every 64th subscription is a slot
+     subscription. */
+
+  for( ulong i=0UL; i<sub_cnt; i++ ) {
+    int   slot = !(i&63UL);
+    ulong a    = (i&1UL) ? fd_rng_ulong_roll( rng, HOT_CNT ) : fd_rng_ulong_roll( rng, acct_cnt );
+    flat_sub_t * f = flat + i;
+    memset( f, 0, sizeof(flat_sub_t) );
+    f->conn_id  = i/4UL;
+    f->meth_id  = slot ? 2L : 1L;
+    f->subsc_id = i;
+    f->acct     = bench_key( a );
+    f->enc      = (int)fd_rng_uint_roll( rng, 2U );
+
+    fd_rpc_ws_sub_t * sub = fd_rpc_ws_subs_acquire( subs );
+    FD_TEST( sub );
+    sub->conn_id  = f->conn_id;
+    sub->meth_id  = f->meth_id;
+    sub->subsc_id = f->subsc_id;
+    sub->acct     = f->acct;
+    sub->enc      = f->enc;
+    fd_rpc_ws_subs_insert( subs, sub, slot ? FD_RPC_WS_SUB_KIND_SLOT : FD_RPC_WS_SUB_KIND_ACCT );
+  }
+  FD_TEST( fd_rpc_ws_subs_cnt( subs )==sub_cnt );
+  FD_TEST( !fd_rpc_ws_subs_acquire( subs ) );
+
+  /* A quarter of the written accounts have subscribers, one of them
+     hot */
+
+  fd_pubkey_t * writes = aligned_alloc( 128UL, fd_ulong_align_up( write_cnt*sizeof(fd_pubkey_t), 128UL ) );
+  FD_TEST( writes );
+  for( ulong w=0UL; w<write_cnt; w++ ) {
+    if     ( !w       ) writes[ w ] = bench_key( fd_rng_ulong_roll( rng, HOT_CNT ) );
+    else if( !(w&3UL) ) writes[ w ] = bench_key( fd_rng_ulong_roll( rng, acct_cnt ) );
+    else                writes[ w ] = bench_key( acct_cnt+w );
+  }
+
+  FD_LOG_NOTICE(( "%lu subscriptions over %lu accounts (%lu hot), %lu account writes per notification",
+                  sub_cnt, acct_cnt, HOT_CNT, write_cnt ));
+
+  ulong flat_bytes = 0UL;
+  ulong flat_hit   = 0UL;
+  long dt = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) flat_hit = bench_flat( flat, sub_cnt, writes, write_cnt, &flat_bytes );
+  dt += fd_log_wallclock();
+  double flat_ns = (double)dt / (double)iter_cnt;
+  FD_LOG_NOTICE(( "flat array:     %10.1f us per notification (%lu messages, %lu bytes encoded)",
+                  flat_ns*1e-3, flat_hit, flat_bytes ));
+
+  ulong index_bytes = 0UL;
+  ulong index_hit   = 0UL;
+  dt = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt*100UL; iter++ ) index_hit = bench_index( subs, writes, write_cnt, &index_bytes );
+  dt += fd_log_wallclock();
+  double index_ns = (double)dt / (double)( iter_cnt*100UL );
+  FD_LOG_NOTICE(( "fd_rpc_ws_subs: %10.1f us per notification (%lu messages, %lu bytes copied)",
+                  index_ns*1e-3, index_hit, index_bytes ));
+
+  FD_TEST( index_hit==flat_hit );
+  FD_TEST( index_bytes==flat_bytes );
+  FD_LOG_NOTICE(( "speedup: %.1fx", flat_ns/index_ns ));
+
+  /* Closing every connection empties the registry */
+
+  dt = -fd_log_wallclock();
+  ulong removed = 0UL;
+  for( ulong c=0UL; c<=(sub_cnt-1UL)/4UL; c++ ) removed += fd_rpc_ws_subs_remove_conn( subs, c );
+  dt += fd_log_wallclock();
+  FD_TEST( removed==sub_cnt );
+  FD_TEST( !fd_rpc_ws_subs_cnt( subs ) );
+  FD_TEST( !fd_rpc_ws_subs_slot_first( subs ) );
+  FD_LOG_NOTICE(( "remove_conn:    %10.1f ns per subscription", (double)dt/(double)sub_cnt ));
+
+  free( writes );
+  free( fd_rpc_ws_subs_delete( fd_rpc_ws_subs_leave( subs ) ) );
+  free( flat );
+  fd_rng_delete( fd_rng_leave( rng ) );
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
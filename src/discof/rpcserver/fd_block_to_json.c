@@ -21,6 +21,27 @@
 
 #define EMIT_SIMPLE(_str_) fd_web_reply_append(ws, _str_, sizeof(_str_)-1)
 
+/* emit_sigs emits the signatures of a transaction as a list of quoted
+   base58 strings, preceded by a comma unless first.  The signatures
+   are encoded together with the batched encoder. */
+
+static void
+emit_sigs( fd_webserver_t *         ws,
+           fd_ed25519_sig_t const * sigs,
+           ulong                    sig_cnt,
+           int                      first ) {
+  char  b58[ FD_TXN_SIG_MAX ][ FD_BASE58_ENCODED_64_SZ ];
+  ulong len[ FD_TXN_SIG_MAX ];
+  sig_cnt = fd_ulong_min( sig_cnt, FD_TXN_SIG_MAX );
+  fd_base58_encode_64_batch( (uchar const *)sigs, sig_cnt, len, b58[0] );
+  for( ulong j=0UL; j<sig_cnt; j++ ) {
+    if( !first || j ) EMIT_SIMPLE(",");
+    EMIT_SIMPLE("\"");
+    fd_web_reply_append( ws, b58[j], len[j] );
+    EMIT_SIMPLE("\"");
+  }
+}
+
 void
 fd_tokenbalance_to_json( fd_webserver_t * ws, struct _fd_solblock_TokenBalance * b ) {
   fd_web_reply_sprintf(ws, "{\"accountIndex\":%u,\"mint\":\"%s\",\"owner\":\"%s\",\"programId\":\"%s\",\"uiTokenAmount\":{",
@@ -528,20 +549,20 @@ fd_txn_to_json_full( fd_webserver_t * ws,
   ushort acct_cnt = txn->acct_addr_cnt;
   const fd_pubkey_t * accts = (const fd_pubkey_t *)(raw + txn->acct_addr_off);
   char buf32[FD_BASE58_ENCODED_32_SZ];
+  char acct_b58[FD_TXN_ACCT_ADDR_MAX][FD_BASE58_ENCODED_32_SZ];
+  fd_base58_encode_32_batch( accts[0].uc, acct_cnt, NULL, acct_b58[0] );
 
   if( encoding == FD_ENC_JSON ) {
     for (ushort idx = 0; idx < acct_cnt; idx++) {
-      fd_base58_encode_32(accts[idx].uc, NULL, buf32);
-      fd_web_reply_sprintf(ws, "%s\"%s\"", (idx == 0 ? "" : ","), buf32);
+      fd_web_reply_sprintf(ws, "%s\"%s\"", (idx == 0 ? "" : ","), acct_b58[idx]);
     }
   } else if( encoding == FD_ENC_JSON_PARSED ) {
     for (ushort idx = 0; idx < acct_cnt; idx++) {
-      fd_base58_encode_32(accts[idx].uc, NULL, buf32);
       bool signer = (idx < txn->signature_cnt);
       bool writable = ((idx < txn->signature_cnt - txn->readonly_signed_cnt) ||
                        ((idx >= txn->signature_cnt) && (idx < acct_cnt - txn->readonly_unsigned_cnt)));
       fd_web_reply_sprintf(ws, "%s{\"pubkey\":\"%s\",\"signer\":%s,\"source\":\"transaction\",\"writable\":%s}",
-                           (idx == 0 ? "" : ","), buf32, (signer ? "true" : "false"), (writable ? "true" : "false"));
+                           (idx == 0 ? "" : ","), acct_b58[idx], (signer ? "true" : "false"), (writable ? "true" : "false"));
     }
   }
 
@@ -587,11 +608,7 @@ fd_txn_to_json_full( fd_webserver_t * ws,
   fd_web_reply_sprintf(ws, "],\"recentBlockhash\":\"%s\"},\"signatures\":[", buf32);
 
   fd_ed25519_sig_t const * sigs = (fd_ed25519_sig_t const *)(raw + txn->signature_off);
-  for ( uchar j = 0; j < txn->signature_cnt; j++ ) {
-    char buf64[FD_BASE58_ENCODED_64_SZ];
-    fd_base58_encode_64((const uchar*)&sigs[j], NULL, buf64);
-    fd_web_reply_sprintf(ws, "%s\"%s\"", (j == 0 ? "" : ","), buf64);
-  }
+  emit_sigs( ws, sigs, txn->signature_cnt, 1 );
 
   const char* vers;
   switch (txn->transaction_version) {
@@ -618,23 +635,19 @@ fd_txn_to_json_accts( fd_webserver_t * ws,
 
   ushort acct_cnt = txn->acct_addr_cnt;
   const fd_pubkey_t * accts = (const fd_pubkey_t *)(raw + txn->acct_addr_off);
-  char buf32[FD_BASE58_ENCODED_32_SZ];
+  char acct_b58[FD_TXN_ACCT_ADDR_MAX][FD_BASE58_ENCODED_32_SZ];
+  fd_base58_encode_32_batch( accts[0].uc, acct_cnt, NULL, acct_b58[0] );
   for (ushort idx = 0; idx < acct_cnt; idx++) {
-    fd_base58_encode_32(accts[idx].uc, NULL, buf32);
     bool signer = (idx < txn->signature_cnt);
     bool writable = ((idx < txn->signature_cnt - txn->readonly_signed_cnt) ||
                      ((idx >= txn->signature_cnt) && (idx < acct_cnt - txn->readonly_unsigned_cnt)));
     fd_web_reply_sprintf(ws, "%s{\"pubkey\":\"%s\",\"signer\":%s,\"source\":\"transaction\",\"writable\":%s}",
-                         (idx == 0 ? "" : ","), buf32, (signer ? "true" : "false"), (writable ? "true" : "false"));
+                         (idx == 0 ? "" : ","), acct_b58[idx], (signer ? "true" : "false"), (writable ? "true" : "false"));
   }
 
   fd_web_reply_sprintf(ws, "],\"signatures\":[");
   fd_ed25519_sig_t const * sigs = (fd_ed25519_sig_t const *)(raw + txn->signature_off);
-  for ( uchar j = 0; j < txn->signature_cnt; j++ ) {
-    char buf64[FD_BASE58_ENCODED_64_SZ];
-    fd_base58_encode_64((const uchar*)&sigs[j], NULL, buf64);
-    fd_web_reply_sprintf(ws, "%s\"%s\"", (j == 0 ? "" : ","), buf64);
-  }
+  emit_sigs( ws, sigs, txn->signature_cnt, 1 );
   EMIT_SIMPLE("]}");
 
   return NULL;
@@ -726,12 +739,8 @@ fd_block_to_json( fd_webserver_t * ws,
 
           /* Loop across signatures */
           fd_ed25519_sig_t const * sigs = (fd_ed25519_sig_t const *)(raw + txn->signature_off);
-          for ( uchar j = 0; j < txn->signature_cnt; j++ ) {
-            char buf64[FD_BASE58_ENCODED_64_SZ];
-            fd_base58_encode_64((const uchar*)&sigs[j], NULL, buf64);
-            fd_web_reply_sprintf(ws, "%s\"%s\"", (first_sig ? "" : ","), buf64);
-            first_sig = 0;
-          }
+          emit_sigs( ws, sigs, txn->signature_cnt, first_sig );
+          if( txn->signature_cnt ) first_sig = 0;
 
           blockoff += pay_sz;
         }
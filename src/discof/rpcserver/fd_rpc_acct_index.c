@@ -0,0 +1,502 @@
+#include "fd_rpc_acct_index.h"
+
+static inline int
+pubkey_eq( fd_pubkey_t const * k0,
+           fd_pubkey_t const * k1 ) {
+  return !memcmp( k0->uc, k1->uc, sizeof(fd_pubkey_t) );
+}
+
+#define POOL_NAME fd_rpc_acct_index_pool
+#define POOL_T    fd_rpc_acct_index_ele_t
+#define POOL_NEXT pool_next
+#include "../../util/tmpl/fd_pool.c"
+
+#define MAP_NAME  fd_rpc_acct_index_addr
+#define MAP_KEY_T fd_pubkey_t
+#define MAP_ELE_T fd_rpc_acct_index_ele_t
+#define MAP_KEY   addr
+#define MAP_NEXT  addr_next
+#define MAP_KEY_HASH(key,seed) fd_hash( seed, key, sizeof(fd_pubkey_t) )
+#define MAP_KEY_EQ(k0,k1)      pubkey_eq( k0, k1 )
+#include "../../util/tmpl/fd_map_chain.c"
+
+/* The secondary maps allow duplicate keys and O(1) removal of an
+   arbitrary element (an account leaves its owner/mint/... chain when it
+   is updated). */
+
+#define MAP_NAME  fd_rpc_acct_index_owner
+#define MAP_KEY_T fd_pubkey_t
+#define MAP_ELE_T fd_rpc_acct_index_ele_t
+#define MAP_KEY   owner
+#define MAP_NEXT  owner_next
+#define MAP_PREV  owner_prev
+#define MAP_KEY_HASH(key,seed) fd_hash( seed, key, sizeof(fd_pubkey_t) )
+#define MAP_KEY_EQ(k0,k1)      pubkey_eq( k0, k1 )
+#define MAP_MULTI 1
+#define MAP_OPTIMIZE_RANDOM_ACCESS_REMOVAL 1
+#include "../../util/tmpl/fd_map_chain.c"
+
+#define MAP_NAME  fd_rpc_acct_index_mint
+#define MAP_KEY_T fd_pubkey_t
+#define MAP_ELE_T fd_rpc_acct_index_ele_t
+#define MAP_KEY   mint
+#define MAP_NEXT  mint_next
+#define MAP_PREV  mint_prev
+#define MAP_KEY_HASH(key,seed) fd_hash( seed, key, sizeof(fd_pubkey_t) )
+#define MAP_KEY_EQ(k0,k1)      pubkey_eq( k0, k1 )
+#define MAP_MULTI 1
+#define MAP_OPTIMIZE_RANDOM_ACCESS_REMOVAL 1
+#include "../../util/tmpl/fd_map_chain.c"
+
+#define MAP_NAME  fd_rpc_acct_index_tok_owner
+#define MAP_KEY_T fd_pubkey_t
+#define MAP_ELE_T fd_rpc_acct_index_ele_t
+#define MAP_KEY   tok_owner
+#define MAP_NEXT  tok_owner_next
+#define MAP_PREV  tok_owner_prev
+#define MAP_KEY_HASH(key,seed) fd_hash( seed, key, sizeof(fd_pubkey_t) )
+#define MAP_KEY_EQ(k0,k1)      pubkey_eq( k0, k1 )
+#define MAP_MULTI 1
+#define MAP_OPTIMIZE_RANDOM_ACCESS_REMOVAL 1
+#include "../../util/tmpl/fd_map_chain.c"
+
+#define MAP_NAME  fd_rpc_acct_index_delegate
+#define MAP_KEY_T fd_pubkey_t
+#define MAP_ELE_T fd_rpc_acct_index_ele_t
+#define MAP_KEY   delegate
+#define MAP_NEXT  delegate_next
+#define MAP_PREV  delegate_prev
+#define MAP_KEY_HASH(key,seed) fd_hash( seed, key, sizeof(fd_pubkey_t) )
+#define MAP_KEY_EQ(k0,k1)      pubkey_eq( k0, k1 )
+#define MAP_MULTI 1
+#define MAP_OPTIMIZE_RANDOM_ACCESS_REMOVAL 1
+#include "../../util/tmpl/fd_map_chain.c"
+
+#define FD_RPC_ACCT_INDEX_MAGIC (0xf17eda2ce7acc1d0UL) /* firedancer rpc acct index version 0 */
+
+struct __attribute__((aligned(128UL))) fd_rpc_acct_index {
+  ulong magic;
+  ulong ele_max;
+  ulong chain_cnt;
+  ulong cnt;
+
+  /* Offsets from the start of the index (persistent) */
+
+  ulong pool_off;
+  ulong addr_off;
+  ulong owner_off;
+  ulong mint_off;
+  ulong tok_owner_off;
+  ulong delegate_off;
+
+  /* Local joins (valid after fd_rpc_acct_index_join) */
+
+  fd_rpc_acct_index_ele_t *         pool;
+  fd_rpc_acct_index_addr_t *        addr;
+  fd_rpc_acct_index_owner_t *       owner;
+  fd_rpc_acct_index_mint_t *        mint;
+  fd_rpc_acct_index_tok_owner_t *   tok_owner;
+  fd_rpc_acct_index_delegate_t *    delegate;
+};
+
+/* Program ids of the SPL token program and of Token-2022 */
+
+static const fd_pubkey_t fd_rpc_acct_index_token_id = { .uc = {
+  0x06,0xdd,0xf6,0xe1,0xd7,0x65,0xa1,0x93,0xd9,0xcb,0xe1,0x46,0xce,0xeb,0x79,0xac,
+  0x1c,0xb4,0x85,0xed,0x5f,0x5b,0x37,0x91,0x3a,0x8c,0xf5,0x85,0x7e,0xff,0x00,0xa9 } };
+
+static const fd_pubkey_t fd_rpc_acct_index_token_2022_id = { .uc = {
+  0x06,0xdd,0xf6,0xe1,0xee,0x75,0x8f,0xde,0x18,0x42,0x5d,0xbc,0xe4,0x6c,0xcd,0xda,
+  0xb6,0x1a,0xfc,0x4d,0x83,0xb9,0x0d,0x27,0xfe,0xbd,0xf9,0x28,0xd8,0xa1,0x8b,0xfc } };
+
+FD_FN_CONST ulong
+fd_rpc_acct_index_align( void ) {
+  return alignof(fd_rpc_acct_index_t);
+}
+
+FD_FN_CONST ulong
+fd_rpc_acct_index_footprint( ulong ele_max ) {
+  if( FD_UNLIKELY( !ele_max || ele_max>fd_rpc_acct_index_addr_ele_max() ) ) return 0UL;
+  ulong chain_cnt = fd_rpc_acct_index_addr_chain_cnt_est( ele_max );
+  return FD_LAYOUT_FINI(
+    FD_LAYOUT_APPEND(
+    FD_LAYOUT_APPEND(
+    FD_LAYOUT_APPEND(
+    FD_LAYOUT_APPEND(
+    FD_LAYOUT_APPEND(
+    FD_LAYOUT_APPEND(
+    FD_LAYOUT_APPEND(
+    FD_LAYOUT_INIT,
+      alignof(fd_rpc_acct_index_t),            sizeof(fd_rpc_acct_index_t)                           ),
+      fd_rpc_acct_index_pool_align(),          fd_rpc_acct_index_pool_footprint( ele_max )           ),
+      fd_rpc_acct_index_addr_align(),          fd_rpc_acct_index_addr_footprint( chain_cnt )         ),
+      fd_rpc_acct_index_owner_align(),         fd_rpc_acct_index_owner_footprint( chain_cnt )        ),
+      fd_rpc_acct_index_mint_align(),          fd_rpc_acct_index_mint_footprint( chain_cnt )         ),
+      fd_rpc_acct_index_tok_owner_align(),     fd_rpc_acct_index_tok_owner_footprint( chain_cnt )    ),
+      fd_rpc_acct_index_delegate_align(),      fd_rpc_acct_index_delegate_footprint( chain_cnt )     ),
+    fd_rpc_acct_index_align() );
+}
+
+void *
+fd_rpc_acct_index_new( void * shmem,
+                       ulong  ele_max,
+                       ulong  seed ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_rpc_acct_index_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned mem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_rpc_acct_index_footprint( ele_max );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad ele_max (%lu)", ele_max ));
+    return NULL;
+  }
+
+  ulong chain_cnt = fd_rpc_acct_index_addr_chain_cnt_est( ele_max );
+
+  FD_SCRATCH_ALLOC_INIT( l, shmem );
+  fd_rpc_acct_index_t * index = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_rpc_acct_index_t),        sizeof(fd_rpc_acct_index_t)                        );
+  void * pool                 = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_acct_index_pool_align(),      fd_rpc_acct_index_pool_footprint( ele_max )        );
+  void * addr                 = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_acct_index_addr_align(),      fd_rpc_acct_index_addr_footprint( chain_cnt )      );
+  void * owner                = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_acct_index_owner_align(),     fd_rpc_acct_index_owner_footprint( chain_cnt )     );
+  void * mint                 = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_acct_index_mint_align(),      fd_rpc_acct_index_mint_footprint( chain_cnt )      );
+  void * tok_owner            = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_acct_index_tok_owner_align(), fd_rpc_acct_index_tok_owner_footprint( chain_cnt ) );
+  void * delegate             = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_acct_index_delegate_align(),  fd_rpc_acct_index_delegate_footprint( chain_cnt )  );
+  FD_TEST( FD_SCRATCH_ALLOC_FINI( l, fd_rpc_acct_index_align() ) == (ulong)shmem + footprint );
+
+  fd_memset( index, 0, sizeof(fd_rpc_acct_index_t) );
+  index->ele_max   = ele_max;
+  index->chain_cnt = chain_cnt;
+
+  FD_TEST( fd_rpc_acct_index_pool_new     ( pool,      ele_max         ) );
+  FD_TEST( fd_rpc_acct_index_addr_new     ( addr,      chain_cnt, seed ) );
+  FD_TEST( fd_rpc_acct_index_owner_new    ( owner,     chain_cnt, seed ) );
+  FD_TEST( fd_rpc_acct_index_mint_new     ( mint,      chain_cnt, seed ) );
+  FD_TEST( fd_rpc_acct_index_tok_owner_new( tok_owner, chain_cnt, seed ) );
+  FD_TEST( fd_rpc_acct_index_delegate_new ( delegate,  chain_cnt, seed ) );
+
+  index->pool_off      = (ulong)pool      - (ulong)shmem;
+  index->addr_off      = (ulong)addr      - (ulong)shmem;
+  index->owner_off     = (ulong)owner     - (ulong)shmem;
+  index->mint_off      = (ulong)mint      - (ulong)shmem;
+  index->tok_owner_off = (ulong)tok_owner - (ulong)shmem;
+  index->delegate_off  = (ulong)delegate  - (ulong)shmem;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( index->magic ) = FD_RPC_ACCT_INDEX_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_rpc_acct_index_t *
+fd_rpc_acct_index_join( void * shindex ) {
+  fd_rpc_acct_index_t * index = (fd_rpc_acct_index_t *)shindex;
+
+  if( FD_UNLIKELY( !index ) ) {
+    FD_LOG_WARNING(( "NULL index" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)index, fd_rpc_acct_index_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned index" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( index->magic!=FD_RPC_ACCT_INDEX_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  ulong base = (ulong)shindex;
+  index->pool      = fd_rpc_acct_index_pool_join     ( (void *)( base + index->pool_off      ) );
+  index->addr      = fd_rpc_acct_index_addr_join     ( (void *)( base + index->addr_off      ) );
+  index->owner     = fd_rpc_acct_index_owner_join    ( (void *)( base + index->owner_off     ) );
+  index->mint      = fd_rpc_acct_index_mint_join     ( (void *)( base + index->mint_off      ) );
+  index->tok_owner = fd_rpc_acct_index_tok_owner_join( (void *)( base + index->tok_owner_off ) );
+  index->delegate  = fd_rpc_acct_index_delegate_join ( (void *)( base + index->delegate_off  ) );
+  if( FD_UNLIKELY( !index->pool || !index->addr || !index->owner || !index->mint || !index->tok_owner || !index->delegate ) ) {
+    FD_LOG_WARNING(( "failed to join index" ));
+    return NULL;
+  }
+
+  return index;
+}
+
+void *
+fd_rpc_acct_index_leave( fd_rpc_acct_index_t * index ) {
+
+  if( FD_UNLIKELY( !index ) ) {
+    FD_LOG_WARNING(( "NULL index" ));
+    return NULL;
+  }
+
+  fd_rpc_acct_index_pool_leave     ( index->pool      );
+  fd_rpc_acct_index_addr_leave     ( index->addr      );
+  fd_rpc_acct_index_owner_leave    ( index->owner     );
+  fd_rpc_acct_index_mint_leave     ( index->mint      );
+  fd_rpc_acct_index_tok_owner_leave( index->tok_owner );
+  fd_rpc_acct_index_delegate_leave ( index->delegate  );
+
+  return (void *)index;
+}
+
+void *
+fd_rpc_acct_index_delete( void * shindex ) {
+  fd_rpc_acct_index_t * index = (fd_rpc_acct_index_t *)shindex;
+
+  if( FD_UNLIKELY( !index ) ) {
+    FD_LOG_WARNING(( "NULL index" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( index->magic!=FD_RPC_ACCT_INDEX_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( index->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shindex;
+}
+
+FD_FN_PURE ulong fd_rpc_acct_index_cnt( fd_rpc_acct_index_t const * index ) { return index->cnt;     }
+FD_FN_PURE ulong fd_rpc_acct_index_max( fd_rpc_acct_index_t const * index ) { return index->ele_max; }
+
+FD_FN_PURE int
+fd_rpc_acct_index_is_token_program( fd_pubkey_t const * owner ) {
+  return pubkey_eq( owner, &fd_rpc_acct_index_token_id ) ||
+         pubkey_eq( owner, &fd_rpc_acct_index_token_2022_id );
+}
+
+/* parse_token fills in the token fields of ele (flags, mint, tok_owner,
+   delegate, amount, decimals) from the account data.  Token-2022
+   accounts larger than the base layout carry an account type byte right
+   after the base token account (1 for mints, 2 for token accounts). */
+
+static void
+parse_token( fd_rpc_acct_index_ele_t * ele,
+             uchar const *             data,
+             ulong                     data_sz ) {
+  ele->flags    = 0U;
+  ele->amount   = 0UL;
+  ele->decimals = 0;
+  if( !fd_rpc_acct_index_is_token_program( &ele->owner ) ) return;
+
+  int is_acct = ( data_sz==FD_RPC_ACCT_INDEX_TOKEN_ACCT_SZ ) |
+                ( ( data_sz>FD_RPC_ACCT_INDEX_TOKEN_ACCT_SZ ) && data[ FD_RPC_ACCT_INDEX_TOKEN_ACCT_SZ ]==2 );
+  int is_mint = ( data_sz==FD_RPC_ACCT_INDEX_TOKEN_MINT_SZ ) |
+                ( ( data_sz>FD_RPC_ACCT_INDEX_TOKEN_ACCT_SZ ) && data[ FD_RPC_ACCT_INDEX_TOKEN_ACCT_SZ ]==1 );
+
+  if( is_acct ) {
+    /* mint (32) | owner (32) | amount (8) | delegate (4+32) | state (1) | ... */
+    if( FD_UNLIKELY( !data[ 108 ] ) ) return; /* uninitialized */
+    memcpy( ele->mint.uc,      data + FD_RPC_ACCT_INDEX_TOKEN_MINT_OFF,  sizeof(fd_pubkey_t) );
+    memcpy( ele->tok_owner.uc, data + FD_RPC_ACCT_INDEX_TOKEN_OWNER_OFF, sizeof(fd_pubkey_t) );
+    ele->amount = FD_LOAD( ulong, data + 64 );
+    ele->flags  = FD_RPC_ACCT_INDEX_FLAG_TOKEN;
+    if( FD_LOAD( uint, data + FD_RPC_ACCT_INDEX_TOKEN_DELEGATE_OFF )==1U ) {
+      memcpy( ele->delegate.uc, data + FD_RPC_ACCT_INDEX_TOKEN_DELEGATE_OFF + 4UL, sizeof(fd_pubkey_t) );
+      ele->flags |= FD_RPC_ACCT_INDEX_FLAG_DELEGATE;
+    }
+  } else if( is_mint ) {
+    /* mint_authority (4+32) | supply (8) | decimals (1) | is_initialized (1) | ... */
+    if( FD_UNLIKELY( !data[ 45 ] ) ) return; /* uninitialized */
+    ele->amount   = FD_LOAD( ulong, data + 36 );
+    ele->decimals = data[ 44 ];
+    ele->flags    = FD_RPC_ACCT_INDEX_FLAG_MINT;
+  }
+}
+
+static void
+unchain_token( fd_rpc_acct_index_t * index,
+               ulong                 idx ) {
+  fd_rpc_acct_index_ele_t * ele = index->pool + idx;
+  if( ele->flags & FD_RPC_ACCT_INDEX_FLAG_TOKEN ) {
+    fd_rpc_acct_index_mint_idx_remove_fast     ( index->mint,      idx, index->pool );
+    fd_rpc_acct_index_tok_owner_idx_remove_fast( index->tok_owner, idx, index->pool );
+  }
+  if( ele->flags & FD_RPC_ACCT_INDEX_FLAG_DELEGATE ) {
+    fd_rpc_acct_index_delegate_idx_remove_fast ( index->delegate,  idx, index->pool );
+  }
+}
+
+static void
+chain_token( fd_rpc_acct_index_t * index,
+             ulong                 idx ) {
+  fd_rpc_acct_index_ele_t * ele = index->pool + idx;
+  if( ele->flags & FD_RPC_ACCT_INDEX_FLAG_TOKEN ) {
+    fd_rpc_acct_index_mint_idx_insert     ( index->mint,      idx, index->pool );
+    fd_rpc_acct_index_tok_owner_idx_insert( index->tok_owner, idx, index->pool );
+  }
+  if( ele->flags & FD_RPC_ACCT_INDEX_FLAG_DELEGATE ) {
+    fd_rpc_acct_index_delegate_idx_insert ( index->delegate,  idx, index->pool );
+  }
+}
+
+int
+fd_rpc_acct_index_update( fd_rpc_acct_index_t * index,
+                          fd_pubkey_t const *   addr,
+                          fd_pubkey_t const *   owner,
+                          ulong                 lamports,
+                          uchar const *         data,
+                          ulong                 data_sz,
+                          ulong                 slot ) {
+  if( !lamports ) {
+    fd_rpc_acct_index_remove( index, addr );
+    return FD_RPC_ACCT_INDEX_SUCCESS;
+  }
+
+  fd_rpc_acct_index_ele_t * pool = index->pool;
+  ulong idx = fd_rpc_acct_index_addr_idx_query( index->addr, addr, ULONG_MAX, pool );
+
+  if( FD_LIKELY( idx!=ULONG_MAX ) ) {
+
+    /* Existing account.  The token chains are keyed by fields of the
+       account data, so unchain with the old state and rechain with the
+       new.  Both are no-ops for accounts not owned by a token program. */
+
+    fd_rpc_acct_index_ele_t * ele = pool + idx;
+    unchain_token( index, idx );
+
+    if( !pubkey_eq( &ele->owner, owner ) ) {
+      fd_rpc_acct_index_owner_idx_remove_fast( index->owner, idx, pool );
+      ele->owner = *owner;
+      fd_rpc_acct_index_owner_idx_insert( index->owner, idx, pool );
+    }
+
+    ele->lamports = lamports;
+    ele->data_sz  = data_sz;
+    ele->slot     = slot;
+    parse_token( ele, data, data_sz );
+    chain_token( index, idx );
+    return FD_RPC_ACCT_INDEX_SUCCESS;
+  }
+
+  if( FD_UNLIKELY( !fd_rpc_acct_index_pool_free( pool ) ) ) return FD_RPC_ACCT_INDEX_ERR_FULL;
+
+  idx = fd_rpc_acct_index_pool_idx_acquire( pool );
+  fd_rpc_acct_index_ele_t * ele = pool + idx;
+  ele->addr     = *addr;
+  ele->owner    = *owner;
+  ele->lamports = lamports;
+  ele->data_sz  = data_sz;
+  ele->slot     = slot;
+  parse_token( ele, data, data_sz );
+
+  fd_rpc_acct_index_addr_idx_insert ( index->addr,  idx, pool );
+  fd_rpc_acct_index_owner_idx_insert( index->owner, idx, pool );
+  chain_token( index, idx );
+  index->cnt++;
+
+  return FD_RPC_ACCT_INDEX_SUCCESS;
+}
+
+void
+fd_rpc_acct_index_remove( fd_rpc_acct_index_t * index,
+                          fd_pubkey_t const *   addr ) {
+  fd_rpc_acct_index_ele_t * pool = index->pool;
+  ulong idx = fd_rpc_acct_index_addr_idx_remove( index->addr, addr, ULONG_MAX, pool );
+  if( idx==ULONG_MAX ) return;
+
+  fd_rpc_acct_index_owner_idx_remove_fast( index->owner, idx, pool );
+  unchain_token( index, idx );
+  fd_rpc_acct_index_pool_idx_release( pool, idx );
+  index->cnt--;
+}
+
+FD_FN_PURE fd_rpc_acct_index_ele_t const *
+fd_rpc_acct_index_query( fd_rpc_acct_index_t const * index,
+                         fd_pubkey_t const *         addr ) {
+  return fd_rpc_acct_index_addr_ele_query_const( index->addr, addr, NULL, index->pool );
+}
+
+FD_FN_PURE fd_rpc_acct_index_ele_t const *
+fd_rpc_acct_index_first( fd_rpc_acct_index_t const * index,
+                         int                         by,
+                         fd_pubkey_t const *         key ) {
+  fd_rpc_acct_index_ele_t const * pool = index->pool;
+  switch( by ) {
+  case FD_RPC_ACCT_INDEX_BY_OWNER:       return fd_rpc_acct_index_owner_ele_query_const    ( index->owner,     key, NULL, pool );
+  case FD_RPC_ACCT_INDEX_BY_MINT:        return fd_rpc_acct_index_mint_ele_query_const     ( index->mint,      key, NULL, pool );
+  case FD_RPC_ACCT_INDEX_BY_TOKEN_OWNER: return fd_rpc_acct_index_tok_owner_ele_query_const( index->tok_owner, key, NULL, pool );
+  case FD_RPC_ACCT_INDEX_BY_DELEGATE:    return fd_rpc_acct_index_delegate_ele_query_const ( index->delegate,  key, NULL, pool );
+  default:                               return NULL;
+  }
+}
+
+FD_FN_PURE fd_rpc_acct_index_ele_t const *
+fd_rpc_acct_index_next( fd_rpc_acct_index_t const *     index,
+                        int                             by,
+                        fd_rpc_acct_index_ele_t const * prev ) {
+  fd_rpc_acct_index_ele_t const * pool = index->pool;
+  switch( by ) {
+  case FD_RPC_ACCT_INDEX_BY_OWNER:       return fd_rpc_acct_index_owner_ele_next_const    ( prev, NULL, pool );
+  case FD_RPC_ACCT_INDEX_BY_MINT:        return fd_rpc_acct_index_mint_ele_next_const     ( prev, NULL, pool );
+  case FD_RPC_ACCT_INDEX_BY_TOKEN_OWNER: return fd_rpc_acct_index_tok_owner_ele_next_const( prev, NULL, pool );
+  case FD_RPC_ACCT_INDEX_BY_DELEGATE:    return fd_rpc_acct_index_delegate_ele_next_const ( prev, NULL, pool );
+  default:                               return NULL;
+  }
+}
+
+/* largest_insert inserts ele into the descending top-max list out[0,cnt)
+   ranked by rank.  Returns the new count. */
+
+static inline ulong
+largest_insert( fd_rpc_acct_index_ele_t const ** out,
+                ulong                            cnt,
+                ulong                            max,
+                fd_rpc_acct_index_ele_t const *  ele,
+                int                              by_amount ) {
+  ulong rank = by_amount ? ele->amount : ele->lamports;
+  if( cnt==max ) {
+    ulong min = by_amount ? out[ cnt-1UL ]->amount : out[ cnt-1UL ]->lamports;
+    if( FD_LIKELY( rank<=min ) ) return cnt;
+    cnt--;
+  }
+  ulong i = cnt;
+  while( i ) {
+    ulong r = by_amount ? out[ i-1UL ]->amount : out[ i-1UL ]->lamports;
+    if( r>=rank ) break;
+    out[ i ] = out[ i-1UL ];
+    i--;
+  }
+  out[ i ] = ele;
+  return cnt+1UL;
+}
+
+ulong
+fd_rpc_acct_index_largest( fd_rpc_acct_index_t const *      index,
+                           int                              by,
+                           fd_pubkey_t const *              key,
+                           fd_rpc_acct_index_ele_t const ** out,
+                           ulong                            max ) {
+  if( FD_UNLIKELY( !max ) ) return 0UL;
+  ulong cnt = 0UL;
+
+  if( by==FD_RPC_ACCT_INDEX_BY_ALL ) {
+    fd_rpc_acct_index_ele_t const * pool = index->pool;
+    for( fd_rpc_acct_index_addr_iter_t iter = fd_rpc_acct_index_addr_iter_init( index->addr, pool );
+         !fd_rpc_acct_index_addr_iter_done( iter, index->addr, pool );
+         iter = fd_rpc_acct_index_addr_iter_next( iter, index->addr, pool ) ) {
+      cnt = largest_insert( out, cnt, max, fd_rpc_acct_index_addr_iter_ele_const( iter, index->addr, pool ), 0 );
+    }
+    return cnt;
+  }
+
+  int by_amount = by!=FD_RPC_ACCT_INDEX_BY_OWNER;
+  for( fd_rpc_acct_index_ele_t const * ele = fd_rpc_acct_index_first( index, by, key );
+       ele;
+       ele = fd_rpc_acct_index_next( index, by, ele ) ) {
+    cnt = largest_insert( out, cnt, max, ele, by_amount );
+  }
+  return cnt;
+}
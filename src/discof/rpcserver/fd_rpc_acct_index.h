@@ -0,0 +1,192 @@
+#ifndef HEADER_fd_src_discof_rpcserver_fd_rpc_acct_index_h
+#define HEADER_fd_src_discof_rpcserver_fd_rpc_acct_index_h
+
+/* fd_rpc_acct_index is a secondary index over accounts used by the RPC
+   server to answer getProgramAccounts, getLargestAccounts and the SPL
+   token queries (getTokenAccountsByOwner, getTokenAccountsByDelegate,
+   getTokenAccountBalance, getTokenLargestAccounts) without scanning
+   funk.
+
+   Every indexed account has one element, keyed by address.  Elements
+   are additionally chained by owning program and, for SPL token (and
+   Token-2022) token accounts, by mint, by token owner and by delegate.
+   Each element caches the small amount of account state the queries
+   filter or sort on (lamports, data size, token amount) so that most
+   queries only touch funk for the accounts that are actually returned.
+
+   The index is maintained incrementally: the caller feeds it every
+   account write (typically from replay notifications) via
+   fd_rpc_acct_index_update.  Accounts closed to zero lamports are
+   dropped.  The index is single threaded and is not persistent across
+   restarts; it does not need to be part of a workspace. */
+
+#include "../../flamenco/types/fd_types_custom.h"
+
+/* FD_RPC_ACCT_INDEX_BY_* select which secondary chain to iterate. */
+
+#define FD_RPC_ACCT_INDEX_BY_OWNER       (0) /* accounts owned by a program */
+#define FD_RPC_ACCT_INDEX_BY_MINT        (1) /* token accounts of a mint */
+#define FD_RPC_ACCT_INDEX_BY_TOKEN_OWNER (2) /* token accounts of a wallet */
+#define FD_RPC_ACCT_INDEX_BY_DELEGATE    (3) /* token accounts with a delegate */
+#define FD_RPC_ACCT_INDEX_BY_ALL         (4) /* every indexed account (largest only) */
+
+/* FD_RPC_ACCT_INDEX_FLAG_* describe what was parsed out of an account */
+
+#define FD_RPC_ACCT_INDEX_FLAG_TOKEN    (1U) /* initialized SPL token account */
+#define FD_RPC_ACCT_INDEX_FLAG_DELEGATE (2U) /* token account with a delegate */
+#define FD_RPC_ACCT_INDEX_FLAG_MINT     (4U) /* SPL token mint */
+
+#define FD_RPC_ACCT_INDEX_SUCCESS  ( 0)
+#define FD_RPC_ACCT_INDEX_ERR_FULL (-1) /* no free elements */
+
+/* SPL token account layout (shared by Token-2022 for the base fields) */
+
+#define FD_RPC_ACCT_INDEX_TOKEN_ACCT_SZ (165UL)
+#define FD_RPC_ACCT_INDEX_TOKEN_MINT_SZ ( 82UL)
+
+#define FD_RPC_ACCT_INDEX_TOKEN_MINT_OFF     ( 0UL)
+#define FD_RPC_ACCT_INDEX_TOKEN_OWNER_OFF    (32UL)
+#define FD_RPC_ACCT_INDEX_TOKEN_DELEGATE_OFF (72UL) /* COption: tag (uint, 1 if set) | pubkey */
+
+struct fd_rpc_acct_index_ele {
+  fd_pubkey_t addr;      /* account address */
+  fd_pubkey_t owner;     /* owning program */
+  fd_pubkey_t mint;      /* valid if FLAG_TOKEN */
+  fd_pubkey_t tok_owner; /* valid if FLAG_TOKEN */
+  fd_pubkey_t delegate;  /* valid if FLAG_DELEGATE */
+
+  ulong lamports;
+  ulong data_sz;
+  ulong amount;          /* token amount if FLAG_TOKEN, supply if FLAG_MINT */
+  ulong slot;            /* slot of the last update */
+  uint  flags;
+  uchar decimals;        /* valid if FLAG_MINT */
+
+  /* Private */
+
+  ulong pool_next;
+  ulong addr_next;
+  ulong owner_next;
+  ulong owner_prev;
+  ulong mint_next;
+  ulong mint_prev;
+  ulong tok_owner_next;
+  ulong tok_owner_prev;
+  ulong delegate_next;
+  ulong delegate_prev;
+};
+typedef struct fd_rpc_acct_index_ele fd_rpc_acct_index_ele_t;
+
+struct fd_rpc_acct_index;
+typedef struct fd_rpc_acct_index fd_rpc_acct_index_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_rpc_acct_index_{align,footprint} return the required alignment
+   and footprint of a memory region suitable for use as an account index
+   with room for up to ele_max accounts.  footprint returns 0 if ele_max
+   is invalid. */
+
+FD_FN_CONST ulong
+fd_rpc_acct_index_align( void );
+
+FD_FN_CONST ulong
+fd_rpc_acct_index_footprint( ulong ele_max );
+
+/* fd_rpc_acct_index_new formats an unused memory region for use as an
+   account index.  fd_rpc_acct_index_join joins the caller to it.  leave
+   and delete are the usual inverses. */
+
+void *
+fd_rpc_acct_index_new( void * shmem,
+                       ulong  ele_max,
+                       ulong  seed );
+
+fd_rpc_acct_index_t *
+fd_rpc_acct_index_join( void * shindex );
+
+void *
+fd_rpc_acct_index_leave( fd_rpc_acct_index_t * index );
+
+void *
+fd_rpc_acct_index_delete( void * shindex );
+
+/* fd_rpc_acct_index_{cnt,max} return the number of indexed accounts
+   and the capacity. */
+
+FD_FN_PURE ulong fd_rpc_acct_index_cnt( fd_rpc_acct_index_t const * index );
+FD_FN_PURE ulong fd_rpc_acct_index_max( fd_rpc_acct_index_t const * index );
+
+/* fd_rpc_acct_index_is_token_program returns 1 if owner is the SPL
+   token program or the Token-2022 program and 0 otherwise. */
+
+FD_FN_PURE int
+fd_rpc_acct_index_is_token_program( fd_pubkey_t const * owner );
+
+/* fd_rpc_acct_index_update records the current state of the account at
+   addr, as written in the given slot.  data points to the account data
+   (data_sz bytes, not including the account meta).  Inserts the account
+   if not already indexed and re-chains it if its owner or token fields
+   changed.  An account with zero lamports is removed.  Returns SUCCESS
+   or ERR_FULL (the account is then not indexed). */
+
+int
+fd_rpc_acct_index_update( fd_rpc_acct_index_t * index,
+                          fd_pubkey_t const *   addr,
+                          fd_pubkey_t const *   owner,
+                          ulong                 lamports,
+                          uchar const *         data,
+                          ulong                 data_sz,
+                          ulong                 slot );
+
+/* fd_rpc_acct_index_remove removes addr from the index.  No-op if addr
+   is not indexed. */
+
+void
+fd_rpc_acct_index_remove( fd_rpc_acct_index_t * index,
+                          fd_pubkey_t const *   addr );
+
+/* fd_rpc_acct_index_query returns the element for addr or NULL if addr
+   is not indexed.  The returned element is valid until the next update
+   or remove. */
+
+FD_FN_PURE fd_rpc_acct_index_ele_t const *
+fd_rpc_acct_index_query( fd_rpc_acct_index_t const * index,
+                         fd_pubkey_t const *         addr );
+
+/* fd_rpc_acct_index_{first,next} iterate over all accounts whose by
+   field (FD_RPC_ACCT_INDEX_BY_{OWNER,MINT,TOKEN_OWNER,DELEGATE}) equals
+   key.  Returns NULL when done.  Iteration order is arbitrary.  The
+   index must not be modified during iteration.  Typical usage:
+
+     for( fd_rpc_acct_index_ele_t const * ele = fd_rpc_acct_index_first( index, by, key );
+          ele;
+          ele = fd_rpc_acct_index_next( index, by, ele ) ) {
+       ...
+     } */
+
+FD_FN_PURE fd_rpc_acct_index_ele_t const *
+fd_rpc_acct_index_first( fd_rpc_acct_index_t const * index,
+                         int                         by,
+                         fd_pubkey_t const *         key );
+
+FD_FN_PURE fd_rpc_acct_index_ele_t const *
+fd_rpc_acct_index_next( fd_rpc_acct_index_t const *     index,
+                        int                             by,
+                        fd_rpc_acct_index_ele_t const * prev );
+
+/* fd_rpc_acct_index_largest finds the (up to) max largest accounts
+   whose by field equals key and stores them into out in descending
+   order.  Owner and BY_ALL (key ignored) rank by lamports, the token
+   chains rank by token amount.  Returns the number stored. */
+
+ulong
+fd_rpc_acct_index_largest( fd_rpc_acct_index_t const *      index,
+                           int                              by,
+                           fd_pubkey_t const *              key,
+                           fd_rpc_acct_index_ele_t const ** out,
+                           ulong                            max );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_discof_rpcserver_fd_rpc_acct_index_h */
@@ -0,0 +1,250 @@
+#include "fd_rpc_cache.h"
+
+#define FD_RPC_CACHE_MAGIC (0xf17eda2ce7cac4e0UL) /* firedancer rpc cache version 0 */
+
+#define DLIST_NAME  vol_list
+#define DLIST_ELE_T fd_rpc_cache_ent_t
+#include "../../util/tmpl/fd_dlist.c"
+
+struct __attribute__((aligned(128UL))) fd_rpc_cache {
+  ulong                  magic;
+  ulong                  ent_max;
+  ulong                  byte_max;
+  ulong                  byte_cnt;
+  ulong                  ent_cnt;
+  ulong                  gen;      /* incremented by invalidate */
+  vol_list_t *           vol;      /* volatile entries, oldest first */
+  vol_list_t             _vol[1];
+  fd_valloc_t            valloc;
+  fd_rpc_cache_metrics_t metrics;
+  fd_rpc_cache_ent_t     ent[];
+};
+
+FD_FN_CONST ulong
+fd_rpc_cache_align( void ) {
+  return alignof(fd_rpc_cache_t);
+}
+
+FD_FN_CONST ulong
+fd_rpc_cache_footprint( ulong ent_max ) {
+  if( FD_UNLIKELY( !ent_max || !fd_ulong_is_pow2( ent_max ) || ent_max>(1UL<<20) ) ) return 0UL;
+  return fd_ulong_align_up( sizeof(fd_rpc_cache_t) + ent_max*sizeof(fd_rpc_cache_ent_t), fd_rpc_cache_align() );
+}
+
+void *
+fd_rpc_cache_new( void *      shmem,
+                  ulong       ent_max,
+                  ulong       byte_max,
+                  fd_valloc_t valloc ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_rpc_cache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned mem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_rpc_cache_footprint( ent_max );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad ent_max (%lu)", ent_max ));
+    return NULL;
+  }
+
+  fd_rpc_cache_t * cache = (fd_rpc_cache_t *)shmem;
+  fd_memset( cache, 0, footprint );
+  cache->ent_max  = ent_max;
+  cache->byte_max = byte_max;
+  cache->valloc   = valloc;
+  cache->vol      = vol_list_join( vol_list_new( cache->_vol ) );
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = FD_RPC_CACHE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_rpc_cache_t *
+fd_rpc_cache_join( void * shcache ) {
+  fd_rpc_cache_t * cache = (fd_rpc_cache_t *)shcache;
+
+  if( FD_UNLIKELY( !cache ) ) {
+    FD_LOG_WARNING(( "NULL cache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)cache, fd_rpc_cache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned cache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( cache->magic!=FD_RPC_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return cache;
+}
+
+void *
+fd_rpc_cache_leave( fd_rpc_cache_t * cache ) {
+
+  if( FD_UNLIKELY( !cache ) ) {
+    FD_LOG_WARNING(( "NULL cache" ));
+    return NULL;
+  }
+
+  return (void *)cache;
+}
+
+static void
+ent_free( fd_rpc_cache_t *     cache,
+          fd_rpc_cache_ent_t * ent ) {
+  if( !ent->meth_id ) return;
+  if( !ent->immutable ) vol_list_ele_remove( cache->vol, ent, cache->ent );
+  fd_valloc_free( cache->valloc, ent->body );
+  cache->byte_cnt -= ent->body_sz;
+  cache->ent_cnt--;
+  ent->meth_id = 0L;
+  ent->body    = NULL;
+  ent->body_sz = 0UL;
+}
+
+void *
+fd_rpc_cache_delete( void * shcache ) {
+  fd_rpc_cache_t * cache = (fd_rpc_cache_t *)shcache;
+
+  if( FD_UNLIKELY( !cache ) ) {
+    FD_LOG_WARNING(( "NULL cache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( cache->magic!=FD_RPC_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  for( ulong i=0UL; i<cache->ent_max; i++ ) ent_free( cache, cache->ent + i );
+  vol_list_delete( vol_list_leave( cache->vol ) );
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shcache;
+}
+
+static inline ulong
+key_hash( long          meth_id,
+          uchar const * key,
+          ulong         key_sz ) {
+  return fd_hash( (ulong)meth_id, key, key_sz );
+}
+
+/* ent_reclaim frees ent if it is a volatile entry from before the last
+   invalidate.  Returns 1 if it did. */
+
+static int
+ent_reclaim( fd_rpc_cache_t *     cache,
+             fd_rpc_cache_ent_t * ent ) {
+  if( !ent->meth_id || ent->immutable || ent->gen==cache->gen ) return 0;
+  ent_free( cache, ent );
+  cache->metrics.invalidate_cnt++;
+  return 1;
+}
+
+fd_rpc_cache_ent_t const *
+fd_rpc_cache_query( fd_rpc_cache_t * cache,
+                    long             meth_id,
+                    uchar const *    key,
+                    ulong            key_sz ) {
+  if( FD_UNLIKELY( key_sz>FD_RPC_CACHE_KEY_MAX ) ) {
+    cache->metrics.miss_cnt++;
+    return NULL;
+  }
+  ulong hash = key_hash( meth_id, key, key_sz );
+  fd_rpc_cache_ent_t * ent = cache->ent + ( hash & (cache->ent_max-1UL) );
+  ent_reclaim( cache, ent );
+  if( ent->meth_id==meth_id && ent->key_hash==hash && ent->key_sz==key_sz && !memcmp( ent->key, key, key_sz ) ) {
+    cache->metrics.hit_cnt++;
+    return ent;
+  }
+  cache->metrics.miss_cnt++;
+  return NULL;
+}
+
+int
+fd_rpc_cache_insert( fd_rpc_cache_t * cache,
+                     long             meth_id,
+                     uchar const *    key,
+                     ulong            key_sz,
+                     int              immutable,
+                     char const *     body,
+                     ulong            body_sz,
+                     char const *     tail ) {
+  ulong hash = key_hash( meth_id, key, key_sz );
+  fd_rpc_cache_ent_t * ent = cache->ent + ( hash & (cache->ent_max-1UL) );
+
+  if( FD_UNLIKELY( !meth_id || key_sz>FD_RPC_CACHE_KEY_MAX || strlen( tail )>=sizeof(ent->tail) ) ) {
+    cache->metrics.skip_cnt++;
+    return 0;
+  }
+
+  ent_reclaim( cache, ent );
+  ulong old_sz = ( ent->meth_id ? ent->body_sz : 0UL );
+
+  /* Free invalidated entries (oldest first) until the body fits */
+  while( cache->byte_cnt - old_sz + body_sz > cache->byte_max ) {
+    if( vol_list_is_empty( cache->vol, cache->ent ) ) break;
+    if( !ent_reclaim( cache, vol_list_ele_peek_head( cache->vol, cache->ent ) ) ) break;
+  }
+
+  if( FD_UNLIKELY( cache->byte_cnt - old_sz + body_sz > cache->byte_max ) ) {
+    cache->metrics.skip_cnt++;
+    return 0;
+  }
+
+  char * copy = fd_valloc_malloc( cache->valloc, 1UL, fd_ulong_max( body_sz, 1UL ) );
+  if( FD_UNLIKELY( !copy ) ) {
+    cache->metrics.skip_cnt++;
+    return 0;
+  }
+  fd_memcpy( copy, body, body_sz );
+
+  if( ent->meth_id ) {
+    ent_free( cache, ent );
+    cache->metrics.evict_cnt++;
+  }
+
+  ent->meth_id   = meth_id;
+  ent->key_hash  = hash;
+  ent->key_sz    = key_sz;
+  fd_memcpy( ent->key, key, key_sz );
+  ent->immutable = immutable;
+  ent->gen       = cache->gen;
+  ent->body      = copy;
+  ent->body_sz   = body_sz;
+  strcpy( ent->tail, tail );
+  if( !immutable ) vol_list_ele_push_tail( cache->vol, ent, cache->ent );
+
+  cache->byte_cnt += body_sz;
+  cache->ent_cnt++;
+  cache->metrics.insert_cnt++;
+  return 1;
+}
+
+void
+fd_rpc_cache_invalidate( fd_rpc_cache_t * cache ) {
+  cache->gen++;
+}
+
+FD_FN_PURE ulong fd_rpc_cache_cnt  ( fd_rpc_cache_t const * cache ) { return cache->ent_cnt;  }
+FD_FN_PURE ulong fd_rpc_cache_bytes( fd_rpc_cache_t const * cache ) { return cache->byte_cnt; }
+
+FD_FN_PURE fd_rpc_cache_metrics_t const *
+fd_rpc_cache_metrics( fd_rpc_cache_t const * cache ) {
+  return &cache->metrics;
+}
@@ -0,0 +1,141 @@
+#ifndef HEADER_fd_src_discof_rpcserver_fd_rpc_cache_h
+#define HEADER_fd_src_discof_rpcserver_fd_rpc_cache_h
+
+/* fd_rpc_cache caches the encoded JSON responses of hot read-only RPC
+   methods (getLatestBlockhash, getEpochInfo, ...) so that repeated
+   requests with the same parameters are answered with a copy of the
+   previous response instead of recomputing it.
+
+   An entry is keyed by the method and a canonical encoding of the
+   request parameters (the caller builds it from the parsed request).
+   The stored body is the response up to, but not including, the
+   request id, which differs between requests.
+
+   Entries are either volatile (the response depends on the current
+   slot, e.g. getLatestBlockhash) or immutable (e.g. getBlock of a
+   rooted slot).  fd_rpc_cache_invalidate drops all volatile entries
+   and is called whenever the state they were computed from changes
+   (every slot).  It only advances a generation counter.  Volatile
+   entries remember the generation they were inserted in and are freed
+   lazily: when looked up or replaced, or when an insert needs their
+   bytes (volatile entries are kept in insertion order, so invalidated
+   ones are found at the head of that list).
+
+   The table is direct mapped: an insert replaces whatever entry
+   occupied the slot.  Bodies are allocated from the given valloc, up
+   to byte_max bytes in total.  The cache is single threaded and does
+   not need to be part of a workspace. */
+
+#include "../../util/fd_util.h"
+
+/* FD_RPC_CACHE_KEY_MAX is the max size of a canonical parameter
+   encoding.  Requests with larger parameters are not cached. */
+
+#define FD_RPC_CACHE_KEY_MAX (256UL)
+
+struct fd_rpc_cache_metrics {
+  ulong hit_cnt;        /* queries answered from the cache */
+  ulong miss_cnt;       /* queries not in the cache */
+  ulong insert_cnt;     /* responses stored */
+  ulong evict_cnt;      /* entries replaced by an insert */
+  ulong invalidate_cnt; /* volatile entries dropped by invalidate */
+  ulong skip_cnt;       /* responses not stored (too large) */
+};
+typedef struct fd_rpc_cache_metrics fd_rpc_cache_metrics_t;
+
+struct fd_rpc_cache_ent {
+  long   meth_id;  /* 0 if the entry is unused */
+  ulong  key_hash;
+  ulong  key_sz;
+  uchar  key[ FD_RPC_CACHE_KEY_MAX ];
+  int    immutable;
+  ulong  gen;      /* cache generation at insert (volatile only) */
+  ulong  prev;     /* volatile entry list, private */
+  ulong  next;
+  char * body;
+  ulong  body_sz;
+  char   tail[ 4 ]; /* emitted after the request id (cstr) */
+};
+typedef struct fd_rpc_cache_ent fd_rpc_cache_ent_t;
+
+struct fd_rpc_cache;
+typedef struct fd_rpc_cache fd_rpc_cache_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_rpc_cache_{align,footprint} return the required alignment and
+   footprint of a memory region suitable for use as a cache with ent_max
+   entries.  ent_max must be a power of 2.  footprint returns 0 if
+   ent_max is invalid. */
+
+FD_FN_CONST ulong
+fd_rpc_cache_align( void );
+
+FD_FN_CONST ulong
+fd_rpc_cache_footprint( ulong ent_max );
+
+/* fd_rpc_cache_new formats an unused memory region for use as a
+   response cache.  Bodies are allocated from valloc, at most byte_max
+   bytes in total.  fd_rpc_cache_join joins the caller to it.  leave is
+   the usual inverse.  delete frees all bodies. */
+
+void *
+fd_rpc_cache_new( void *      shmem,
+                  ulong       ent_max,
+                  ulong       byte_max,
+                  fd_valloc_t valloc );
+
+fd_rpc_cache_t *
+fd_rpc_cache_join( void * shcache );
+
+void *
+fd_rpc_cache_leave( fd_rpc_cache_t * cache );
+
+void *
+fd_rpc_cache_delete( void * shcache );
+
+/* fd_rpc_cache_query returns the entry for the method meth_id (non-zero)
+   with the canonical parameters [key,key+key_sz) or NULL if not cached.
+   Updates the hit and miss counters.  The returned entry is valid until
+   the next insert or invalidate. */
+
+fd_rpc_cache_ent_t const *
+fd_rpc_cache_query( fd_rpc_cache_t * cache,
+                    long             meth_id,
+                    uchar const *    key,
+                    ulong            key_sz );
+
+/* fd_rpc_cache_insert stores the response body [body,body+body_sz)
+   followed by the request id and tail (a cstr of at most 3 chars) for
+   the given method and parameters.  Returns 1 if stored and 0 if not
+   (body too large or key_sz too large). */
+
+int
+fd_rpc_cache_insert( fd_rpc_cache_t * cache,
+                     long             meth_id,
+                     uchar const *    key,
+                     ulong            key_sz,
+                     int              immutable,
+                     char const *     body,
+                     ulong            body_sz,
+                     char const *     tail );
+
+/* fd_rpc_cache_invalidate drops all volatile entries.  O(1), see
+   above. */
+
+void
+fd_rpc_cache_invalidate( fd_rpc_cache_t * cache );
+
+/* fd_rpc_cache_{cnt,bytes} return the number of entries and the total
+   body size held, including invalidated entries that were not freed
+   yet. */
+
+FD_FN_PURE ulong fd_rpc_cache_cnt  ( fd_rpc_cache_t const * cache );
+FD_FN_PURE ulong fd_rpc_cache_bytes( fd_rpc_cache_t const * cache );
+
+FD_FN_PURE fd_rpc_cache_metrics_t const *
+fd_rpc_cache_metrics( fd_rpc_cache_t const * cache );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_discof_rpcserver_fd_rpc_cache_h */
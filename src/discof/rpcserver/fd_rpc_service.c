@@ -1,4 +1,7 @@
 #include "fd_rpc_service.h"
+#include "fd_rpc_acct_index.h"
+#include "fd_rpc_ws_subs.h"
+#include "fd_rpc_cache.h"
 #include "fd_methods.h"
 #include "fd_webserver.h"
 #include "base_enc.h"
@@ -39,23 +42,6 @@ static const uint PATH_COMMITMENT[4] = { ( JSON_TOKEN_LBRACE << 16 ) | KEYW_JSON
                                          ( JSON_TOKEN_LBRACE << 16 ) | KEYW_JSON_COMMITMENT,
                                          ( JSON_TOKEN_STRING << 16 ) };
 
-struct fd_ws_subscription {
-  ulong conn_id;
-  long meth_id;
-  char call_id[64];
-  ulong subsc_id;
-  union {
-    struct {
-      fd_pubkey_t acct;
-      fd_rpc_encoding_t enc;
-      long off;
-      long len;
-    } acct_subscribe;
-  };
-};
-
-#define FD_WS_MAX_SUBS 1024
-
 typedef struct fd_stats_snapshot fd_stats_snapshot_t;
 
 struct fd_perf_sample {
@@ -97,8 +83,8 @@ struct fd_rpc_global_ctx {
   fd_funk_t * funk;
   fd_blockstore_t blockstore[1];
   int blockstore_fd;
-  struct fd_ws_subscription sub_list[FD_WS_MAX_SUBS];
-  ulong sub_cnt;
+  fd_rpc_ws_subs_t * ws_subs;
+  fd_rpc_cache_t * cache;
   ulong last_subsc_id;
   fd_epoch_bank_t * epoch_bank;
   ulong epoch_bank_epoch;
@@ -113,6 +99,9 @@ struct fd_rpc_global_ctx {
   fd_rpc_acct_map_t * acct_map;
   fd_rpc_acct_map_elem_t * acct_pool;
   ulong acct_age;
+  fd_rpc_acct_index_t * acct_index;
+  int acct_index_full;
+  int acct_index_complete; /* index holds every account in funk */
 };
 typedef struct fd_rpc_global_ctx fd_rpc_global_ctx_t;
 
@@ -256,6 +245,204 @@ read_slot_bank( fd_rpc_ctx_t * ctx, ulong slot ) {
   return slot_bank;
 }
 
+/* Secondary account index ********************************************/
+
+/* acct_index_update refreshes the secondary account index with the
+   account record val as of slot (val==NULL if the account is gone). */
+
+static void
+acct_index_update( fd_rpc_global_ctx_t * glob, fd_pubkey_t const * addr, void const * val, ulong val_sz, ulong slot ) {
+  fd_rpc_acct_index_t * index = glob->acct_index;
+  if( FD_UNLIKELY( !index ) ) return;
+
+  fd_account_meta_t const * meta = (fd_account_meta_t const *)val;
+  if( val == NULL || val_sz < sizeof(fd_account_meta_t) || meta->hlen + meta->dlen > val_sz ) {
+    fd_rpc_acct_index_remove( index, addr );
+    return;
+  }
+
+  fd_pubkey_t owner;
+  memcpy( owner.uc, meta->info.owner, sizeof(fd_pubkey_t) );
+  int err = fd_rpc_acct_index_update( index, addr, &owner, meta->info.lamports,
+                                      (uchar const *)val + meta->hlen, meta->dlen, slot );
+  if( FD_UNLIKELY( err && !glob->acct_index_full ) ) {
+    FD_LOG_WARNING(( "account index full (%lu accounts), program and token queries are disabled", fd_rpc_acct_index_max( index ) ));
+  }
+  glob->acct_index_full = !!err;
+  /* A dropped account is never re-added unless written again */
+  if( FD_UNLIKELY( err ) ) glob->acct_index_complete = 0;
+}
+
+/* acct_index_scan populates the secondary account index from the
+   accounts in the root of funk.  Only safe if nobody is writing to
+   funk. */
+
+static void
+acct_index_scan( fd_rpc_global_ctx_t * glob ) {
+  fd_funk_t * funk = glob->funk;
+  fd_wksp_t * wksp = fd_funk_wksp( funk );
+  ulong       slot = glob->last_slot_notify.slot_exec.root;
+  glob->acct_index_complete = 1;
+  fd_funk_all_iter_t iter[1];
+  for( fd_funk_all_iter_new( funk, iter ); !fd_funk_all_iter_done( iter ); fd_funk_all_iter_next( iter ) ) {
+    fd_funk_rec_t const * rec = fd_funk_all_iter_ele_const( iter );
+    if( !fd_funk_txn_xid_eq_root( fd_funk_rec_xid( rec ) ) || !fd_funk_key_is_acc( fd_funk_rec_key( rec ) ) ) continue;
+    fd_pubkey_t addr;
+    memcpy( addr.uc, fd_funk_rec_key( rec )->uc, sizeof(fd_pubkey_t) );
+    acct_index_update( glob, &addr, fd_funk_val_const( rec, wksp ), fd_funk_val_sz( rec ), slot );
+  }
+  FD_LOG_NOTICE(( "account index has %lu accounts", fd_rpc_acct_index_cnt( glob->acct_index ) ));
+}
+
+/* acct_index_ready returns the account index if it holds every
+   account, otherwise replies with an error and returns NULL.  With
+   replay running, funk can't be scanned at startup and the index only
+   sees the accounts written since, so answering from it would silently
+   leave out accounts. */
+
+static fd_rpc_acct_index_t *
+acct_index_ready( fd_rpc_ctx_t * ctx, const char * method ) {
+  fd_rpc_global_ctx_t * glob = ctx->global;
+  if( FD_UNLIKELY( !glob->acct_index ) ) {
+    fd_method_error(ctx, -1, "%s requires the account index", method);
+    return NULL;
+  }
+  if( FD_UNLIKELY( !glob->acct_index_complete ) ) {
+    fd_method_error(ctx, -1, "%s unavailable: the account index is incomplete (%s)", method,
+                    ( glob->acct_index_full ? "index full, increase --acct-index-max" : "not scanned at startup" ));
+    return NULL;
+  }
+  return glob->acct_index;
+}
+
+/* parse_pubkey_param decodes the base58 pubkey at params[idx].  Returns
+   0 (after replying with an error) on failure. */
+
+static int
+parse_pubkey_param( struct json_values * values, fd_rpc_ctx_t * ctx, uint idx, const char * method, fd_pubkey_t * out ) {
+  uint path[3];
+  path[0] = (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_PARAMS;
+  path[1] = (JSON_TOKEN_LBRACKET<<16) | idx;
+  path[2] = (JSON_TOKEN_STRING<<16);
+  ulong arg_sz = 0;
+  const void * arg = json_get_value(values, path, 3, &arg_sz);
+  if( arg == NULL ) {
+    fd_method_error(ctx, -1, "%s requires a string as parameter %u", method, idx);
+    return 0;
+  }
+  if( fd_base58_decode_32((const char *)arg, out->uc) == NULL ) {
+    fd_method_error(ctx, -1, "invalid base58 encoding");
+    return 0;
+  }
+  return 1;
+}
+
+/* parse_account_config parses the optional encoding and dataSlice of
+   the config object at params[idx].  Returns 0 (after replying with an
+   error) on failure. */
+
+static int
+parse_account_config( struct json_values * values, fd_rpc_ctx_t * ctx, uint idx, fd_rpc_encoding_t * enc, long * off, long * len ) {
+  uint path[5];
+  path[0] = (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_PARAMS;
+  path[1] = (JSON_TOKEN_LBRACKET<<16) | idx;
+  path[2] = (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_ENCODING;
+  path[3] = (JSON_TOKEN_STRING<<16);
+  ulong enc_str_sz = 0;
+  const void* enc_str = json_get_value(values, path, 4, &enc_str_sz);
+  if (enc_str == NULL || MATCH_STRING(enc_str, enc_str_sz, "base58"))
+    *enc = FD_ENC_BASE58;
+  else if (MATCH_STRING(enc_str, enc_str_sz, "base64"))
+    *enc = FD_ENC_BASE64;
+  else if (MATCH_STRING(enc_str, enc_str_sz, "base64+zstd"))
+    *enc = FD_ENC_BASE64_ZSTD;
+  else if (MATCH_STRING(enc_str, enc_str_sz, "jsonParsed"))
+    *enc = FD_ENC_JSON;
+  else {
+    fd_method_error(ctx, -1, "invalid data encoding %s", (const char*)enc_str);
+    return 0;
+  }
+
+  path[2] = (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_DATASLICE;
+  path[3] = (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_OFFSET;
+  path[4] = (JSON_TOKEN_INTEGER<<16);
+  ulong sz = 0;
+  const void * off_ptr = json_get_value(values, path, 5, &sz);
+  path[3] = (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_LENGTH;
+  const void * len_ptr = json_get_value(values, path, 5, &sz);
+  *off = (off_ptr ? *(long *)off_ptr : FD_LONG_UNSET);
+  *len = (len_ptr ? *(long *)len_ptr : FD_LONG_UNSET);
+  return 1;
+}
+
+/* keyed_account_to_json appends {"account":{...},"pubkey":"..."} */
+
+static const char *
+keyed_account_to_json( fd_webserver_t * ws, fd_pubkey_t const * addr, fd_rpc_encoding_t enc, const void * val, ulong val_sz, long off, long len ) {
+  fd_web_reply_sprintf(ws, "{\"account\":");
+  const char * err = fd_account_to_json( ws, *addr, enc, val, val_sz, off, len );
+  if( err ) return err;
+  char pubkey[50];
+  fd_base58_encode_32(addr->uc, 0, pubkey);
+  fd_web_reply_sprintf(ws, ",\"pubkey\":\"%s\"}", pubkey);
+  return NULL;
+}
+
+/* token_amount_to_json appends the SPL token amount fields (amount,
+   decimals, uiAmount, uiAmountString) of a raw token amount */
+
+static void
+token_amount_to_json( fd_webserver_t * ws, ulong amount, uint decimals ) {
+  char raw[32];
+  int raw_len = snprintf( raw, sizeof(raw), "%lu", amount );
+  char ui[320];
+  if( decimals == 0U ) {
+    memcpy( ui, raw, (ulong)raw_len+1UL );
+  } else {
+    /* Left pad with zeros so that there is at least one integer digit,
+       insert the decimal point and trim trailing zeros */
+    ulong digits = fd_ulong_max( (ulong)raw_len, decimals+1UL );
+    ulong pad    = digits - (ulong)raw_len;
+    ulong int_sz = digits - decimals;
+    ulong j      = 0UL;
+    for( ulong i=0UL; i<digits; i++ ) {
+      if( i == int_sz ) ui[ j++ ] = '.';
+      ui[ j++ ] = ( i<pad ? '0' : raw[ i-pad ] );
+    }
+    while( ui[ j-1UL ] == '0' ) j--;
+    if( ui[ j-1UL ] == '.' ) j--;
+    ui[ j ] = '\0';
+  }
+  fd_web_reply_sprintf(ws, "\"amount\":\"%s\",\"decimals\":%u,\"uiAmount\":%s,\"uiAmountString\":\"%s\"",
+                       raw, decimals, ui, ui);
+}
+
+/* read_token_decimals returns the decimals of the SPL token mint at
+   addr or -1 if addr is not a mint */
+
+static int
+read_token_decimals( fd_rpc_ctx_t * ctx, fd_pubkey_t const * mint ) {
+  fd_rpc_acct_index_ele_t const * ele = ctx->global->acct_index ? fd_rpc_acct_index_query( ctx->global->acct_index, mint ) : NULL;
+  if( ele && ( ele->flags & FD_RPC_ACCT_INDEX_FLAG_MINT ) ) return ele->decimals;
+
+  int decimals = -1;
+  FD_SCRATCH_SCOPE_BEGIN {
+    ulong val_sz;
+    fd_funk_rec_key_t recid = fd_funk_acc_key(mint);
+    const void * val        = read_account(ctx, &recid, &val_sz);
+    if( val != NULL ) {
+      fd_account_meta_t const * meta = (fd_account_meta_t const *)val;
+      fd_pubkey_t owner;
+      memcpy( owner.uc, meta->info.owner, sizeof(fd_pubkey_t) );
+      if( fd_rpc_acct_index_is_token_program( &owner ) && meta->dlen >= FD_RPC_ACCT_INDEX_TOKEN_MINT_SZ &&
+          meta->hlen + meta->dlen <= val_sz ) {
+        decimals = ((uchar const *)val + meta->hlen)[ 44 ];
+      }
+    }
+  } FD_SCRATCH_SCOPE_END;
+  return decimals;
+}
+
 static const char *
 block_flags_to_confirmation_status( uchar flags ) {
   if( flags & (1U << FD_BLOCK_FLAG_FINALIZED) ) return "\"finalized\"";
@@ -962,12 +1149,28 @@ method_getInflationReward(struct json_values* values, fd_rpc_ctx_t * ctx) {
 }
 
 // Implementation of the "getLargestAccounts" methods
+// curl http://localhost:8123 -X POST -H "Content-Type: application/json" -d '{"jsonrpc":"2.0","id":1, "method":"getLargestAccounts"}'
+
+#define FD_RPC_LARGEST_ACCOUNTS_MAX 20UL
+
 static int
 method_getLargestAccounts(struct json_values* values, fd_rpc_ctx_t * ctx) {
   (void)values;
-  (void)ctx;
-  FD_LOG_WARNING(( "getLargestAccounts is not implemented" ));
-  fd_method_error(ctx, -1, "getLargestAccounts is not implemented");
+  fd_webserver_t * ws = &ctx->global->ws;
+  fd_rpc_acct_index_t * index = acct_index_ready( ctx, "getLargestAccounts" );
+  if( FD_UNLIKELY( !index ) ) return 0;
+
+  fd_rpc_acct_index_ele_t const * top[ FD_RPC_LARGEST_ACCOUNTS_MAX ];
+  ulong cnt = fd_rpc_acct_index_largest( index, FD_RPC_ACCT_INDEX_BY_ALL, NULL, top, FD_RPC_LARGEST_ACCOUNTS_MAX );
+
+  fd_web_reply_sprintf(ws, "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"apiVersion\":\"" FIREDANCER_VERSION "\",\"slot\":%lu},\"value\":[",
+                       ctx->global->last_slot_notify.slot_exec.slot);
+  for( ulong i = 0; i < cnt; ++i ) {
+    char addr[50];
+    fd_base58_encode_32(top[i]->addr.uc, 0, addr);
+    fd_web_reply_sprintf(ws, "%s{\"address\":\"%s\",\"lamports\":%lu}", (i ? "," : ""), addr, top[i]->lamports);
+  }
+  fd_web_reply_sprintf(ws, "]},\"id\":%s}" CRLF, ctx->call_id);
   return 0;
 }
 
@@ -1198,12 +1401,163 @@ method_getMultipleAccounts(struct json_values* values, fd_rpc_ctx_t * ctx) {
 }
 
 // Implementation of the "getProgramAccounts" methods
+// curl http://localhost:8123 -X POST -H "Content-Type: application/json" -d '{"jsonrpc":"2.0","id":1, "method":"getProgramAccounts", "params":["TokenkegQfeZyiNwAJbNbGKPFXCWuBvf9Ss623VQ5DA", {"encoding":"base64", "filters":[{"dataSize":165},{"memcmp":{"offset":32,"bytes":"6s5gDyLyfNXP6WHUEn4YSMQJVcGETpKze7FCPeg9wxYT"}}]}]}'
+
+#define FD_RPC_FILTER_MAX        4UL
+#define FD_RPC_FILTER_MEMCMP_MAX 128UL
+
+struct fd_rpc_memcmp_filter {
+  ulong off;
+  ulong sz;
+  uchar bytes[FD_RPC_FILTER_MEMCMP_MAX];
+};
+typedef struct fd_rpc_memcmp_filter fd_rpc_memcmp_filter_t;
+
 static int
 method_getProgramAccounts(struct json_values* values, fd_rpc_ctx_t * ctx) {
-  (void)values;
-  (void)ctx;
-  FD_LOG_WARNING(( "getProgramAccounts is not implemented" ));
-  fd_method_error(ctx, -1, "getProgramAccounts is not implemented");
+  fd_webserver_t * ws = &ctx->global->ws;
+  fd_rpc_acct_index_t * index = acct_index_ready( ctx, "getProgramAccounts" );
+  if( FD_UNLIKELY( !index ) ) return 0;
+
+  fd_pubkey_t prog;
+  if( !parse_pubkey_param( values, ctx, 0, "getProgramAccounts", &prog ) ) return 0;
+  fd_rpc_encoding_t enc;
+  long off, len;
+  if( !parse_account_config( values, ctx, 1, &enc, &off, &len ) ) return 0;
+
+  /* Parse filters */
+
+  ulong data_sz = ULONG_MAX;
+  fd_rpc_memcmp_filter_t memcmps[FD_RPC_FILTER_MAX];
+  ulong memcmp_cnt = 0;
+  for( uint i = 0; ; ++i ) {
+    uint path[7];
+    path[0] = (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_PARAMS;
+    path[1] = (JSON_TOKEN_LBRACKET<<16) | 1;
+    path[2] = (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_FILTERS;
+    path[3] = (JSON_TOKEN_LBRACKET<<16) | i;
+    path[4] = (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_DATASIZE;
+    path[5] = (JSON_TOKEN_INTEGER<<16);
+    ulong sz = 0;
+    const void * size_ptr = json_get_value(values, path, 6, &sz);
+    if( size_ptr ) {
+      if( *(long *)size_ptr < 0 ) {
+        fd_method_error(ctx, -1, "invalid dataSize filter");
+        return 0;
+      }
+      data_sz = (ulong)*(long *)size_ptr;
+      continue;
+    }
+
+    path[4] = (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_MEMCMP;
+    path[5] = (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_BYTES;
+    path[6] = (JSON_TOKEN_STRING<<16);
+    ulong bytes_sz = 0;
+    const void * bytes = json_get_value(values, path, 7, &bytes_sz);
+    if( bytes == NULL ) break; /* End of list */
+    if( memcmp_cnt == FD_RPC_FILTER_MAX ) {
+      fd_method_error(ctx, -1, "too many filters provided; max %lu", FD_RPC_FILTER_MAX);
+      return 0;
+    }
+    fd_rpc_memcmp_filter_t * f = &memcmps[memcmp_cnt++];
+
+    path[5] = (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_OFFSET;
+    path[6] = (JSON_TOKEN_INTEGER<<16);
+    const void * off_ptr = json_get_value(values, path, 7, &sz);
+    if( off_ptr == NULL || *(long *)off_ptr < 0 ) {
+      fd_method_error(ctx, -1, "memcmp filter requires an offset");
+      return 0;
+    }
+    f->off = (ulong)*(long *)off_ptr;
+
+    path[5] = (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_ENCODING;
+    path[6] = (JSON_TOKEN_STRING<<16);
+    ulong enc_str_sz = 0;
+    const void * enc_str = json_get_value(values, path, 7, &enc_str_sz);
+    if( enc_str == NULL || MATCH_STRING(enc_str, enc_str_sz, "base58") ) {
+      uchar buf[FD_RPC_FILTER_MEMCMP_MAX];
+      ulong buf_sz = sizeof(buf);
+      if( b58tobin( buf, &buf_sz, (const char *)bytes, bytes_sz ) ) {
+        fd_method_error(ctx, -1, "failed to decode base58 memcmp bytes");
+        return 0;
+      }
+      /* b58tobin right aligns the result */
+      memcpy( f->bytes, buf + sizeof(buf) - buf_sz, buf_sz );
+      f->sz = buf_sz;
+    } else if( MATCH_STRING(enc_str, enc_str_sz, "base64") ) {
+      if( FD_BASE64_DEC_SZ( bytes_sz ) > FD_RPC_FILTER_MEMCMP_MAX ) {
+        fd_method_error(ctx, -1, "memcmp bytes too long");
+        return 0;
+      }
+      long res = fd_base64_decode( f->bytes, (const char *)bytes, bytes_sz );
+      if( res < 0 ) {
+        fd_method_error(ctx, -1, "failed to decode base64 memcmp bytes");
+        return 0;
+      }
+      f->sz = (ulong)res;
+    } else {
+      fd_method_error(ctx, -1, "invalid memcmp encoding %s", (const char *)enc_str);
+      return 0;
+    }
+  }
+
+  /* Pick the narrowest chain.  Token accounts are chained by mint and
+     by owner, so a 32 byte memcmp at either offset avoids walking every
+     account of the token program. */
+
+  int by = FD_RPC_ACCT_INDEX_BY_OWNER;
+  fd_pubkey_t const * key = &prog;
+  fd_pubkey_t tok_key;
+  if( fd_rpc_acct_index_is_token_program( &prog ) ) {
+    for( ulong i = 0; i < memcmp_cnt; ++i ) {
+      if( memcmps[i].sz != sizeof(fd_pubkey_t) ) continue;
+      if( memcmps[i].off == FD_RPC_ACCT_INDEX_TOKEN_MINT_OFF ) {
+        by = FD_RPC_ACCT_INDEX_BY_MINT;
+      } else if( memcmps[i].off == FD_RPC_ACCT_INDEX_TOKEN_OWNER_OFF ) {
+        by = FD_RPC_ACCT_INDEX_BY_TOKEN_OWNER;
+      } else {
+        continue;
+      }
+      memcpy( tok_key.uc, memcmps[i].bytes, sizeof(fd_pubkey_t) );
+      key = &tok_key;
+      break;
+    }
+  }
+
+  fd_web_reply_sprintf(ws, "{\"jsonrpc\":\"2.0\",\"result\":[");
+  ulong cnt = 0;
+  for( fd_rpc_acct_index_ele_t const * ele = fd_rpc_acct_index_first( index, by, key );
+       ele;
+       ele = fd_rpc_acct_index_next( index, by, ele ) ) {
+    /* Cheap checks against the index before touching funk */
+    if( !fd_memeq( ele->owner.uc, prog.uc, sizeof(fd_pubkey_t) ) ) continue;
+    if( data_sz != ULONG_MAX && ele->data_sz != data_sz ) continue;
+
+    FD_SCRATCH_SCOPE_BEGIN {
+      ulong val_sz;
+      fd_funk_rec_key_t recid = fd_funk_acc_key(&ele->addr);
+      const void * val        = read_account(ctx, &recid, &val_sz);
+      if( val == NULL ) continue;
+      fd_account_meta_t const * meta = (fd_account_meta_t const *)val;
+      uchar const * data = (uchar const *)val + meta->hlen;
+      if( !fd_memeq( meta->info.owner, prog.uc, sizeof(fd_pubkey_t) ) ) continue;
+      if( data_sz != ULONG_MAX && meta->dlen != data_sz ) continue;
+      int match = 1;
+      for( ulong i = 0; i < memcmp_cnt && match; ++i ) {
+        match = ( memcmps[i].off <= meta->dlen && memcmps[i].sz <= meta->dlen - memcmps[i].off &&
+                  fd_memeq( data + memcmps[i].off, memcmps[i].bytes, memcmps[i].sz ) );
+      }
+      if( !match ) continue;
+
+      if( cnt++ ) fd_web_reply_append(ws, ",", 1);
+      const char * err = keyed_account_to_json( ws, &ele->addr, enc, val, val_sz, off, len );
+      if( err ) {
+        fd_method_error(ctx, -1, "%s", err);
+        return 0;
+      }
+    } FD_SCRATCH_SCOPE_END;
+  }
+  fd_web_reply_sprintf(ws, "],\"id\":%s}" CRLF, ctx->call_id);
   return 0;
 }
 
@@ -1488,42 +1842,186 @@ method_getSupply(struct json_values* values, fd_rpc_ctx_t * ctx) {
 }
 
 // Implementation of the "getTokenAccountBalance" methods
+// curl http://localhost:8123 -X POST -H "Content-Type: application/json" -d '{"jsonrpc":"2.0","id":1, "method":"getTokenAccountBalance", "params":["6s5gDyLyfNXP6WHUEn4YSMQJVcGETpKze7FCPeg9wxYT"]}'
+
 static int
 method_getTokenAccountBalance(struct json_values* values, fd_rpc_ctx_t * ctx) {
-  (void)values;
-  (void)ctx;
-  FD_LOG_WARNING(( "getTokenAccountBalance is not implemented" ));
-  fd_method_error(ctx, -1, "getTokenAccountBalance is not implemented");
+  fd_webserver_t * ws = &ctx->global->ws;
+  fd_pubkey_t acct;
+  if( !parse_pubkey_param( values, ctx, 0, "getTokenAccountBalance", &acct ) ) return 0;
+
+  FD_SCRATCH_SCOPE_BEGIN {
+    ulong val_sz;
+    fd_funk_rec_key_t recid = fd_funk_acc_key(&acct);
+    const void * val        = read_account(ctx, &recid, &val_sz);
+    fd_account_meta_t const * meta = (fd_account_meta_t const *)val;
+    fd_pubkey_t owner;
+    if( val != NULL ) memcpy( owner.uc, meta->info.owner, sizeof(fd_pubkey_t) );
+    if( val == NULL || !fd_rpc_acct_index_is_token_program( &owner ) || meta->dlen < FD_RPC_ACCT_INDEX_TOKEN_ACCT_SZ ) {
+      fd_method_error(ctx, -1, "Invalid param: not a Token account");
+      return 0;
+    }
+    uchar const * data = (uchar const *)val + meta->hlen;
+    fd_pubkey_t mint;
+    memcpy( mint.uc, data + FD_RPC_ACCT_INDEX_TOKEN_MINT_OFF, sizeof(fd_pubkey_t) );
+    ulong amount = FD_LOAD( ulong, data + 64 );
+
+    int decimals = read_token_decimals( ctx, &mint );
+    if( decimals < 0 ) {
+      fd_method_error(ctx, -1, "Invalid param: could not find mint");
+      return 0;
+    }
+
+    fd_web_reply_sprintf(ws, "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"apiVersion\":\"" FIREDANCER_VERSION "\",\"slot\":%lu},\"value\":{",
+                         ctx->global->last_slot_notify.slot_exec.slot);
+    token_amount_to_json( ws, amount, (uint)decimals );
+    fd_web_reply_sprintf(ws, "}},\"id\":%s}" CRLF, ctx->call_id);
+  } FD_SCRATCH_SCOPE_END;
+  return 0;
+}
+
+/* token_accounts_by implements getTokenAccountsByOwner and
+   getTokenAccountsByDelegate: walk the token owner or delegate chain of
+   params[0] and keep the accounts matching the {mint} or {programId}
+   filter in params[1]. */
+
+static int
+token_accounts_by( struct json_values * values, fd_rpc_ctx_t * ctx, int by, const char * method ) {
+  fd_webserver_t * ws = &ctx->global->ws;
+  fd_rpc_acct_index_t * index = acct_index_ready( ctx, method );
+  if( FD_UNLIKELY( !index ) ) return 0;
+
+  fd_pubkey_t key;
+  if( !parse_pubkey_param( values, ctx, 0, method, &key ) ) return 0;
+
+  static const uint PATH_MINT[4] = {
+    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_PARAMS,
+    (JSON_TOKEN_LBRACKET<<16) | 1,
+    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_MINT,
+    (JSON_TOKEN_STRING<<16)
+  };
+  static const uint PATH_PROG[4] = {
+    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_PARAMS,
+    (JSON_TOKEN_LBRACKET<<16) | 1,
+    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_PROGRAMID,
+    (JSON_TOKEN_STRING<<16)
+  };
+  ulong arg_sz = 0;
+  const void * mint_str = json_get_value(values, PATH_MINT, 4, &arg_sz);
+  const void * prog_str = json_get_value(values, PATH_PROG, 4, &arg_sz);
+  fd_pubkey_t filter;
+  if( mint_str != NULL ) {
+    if( fd_base58_decode_32((const char *)mint_str, filter.uc) == NULL ) {
+      fd_method_error(ctx, -1, "invalid base58 encoding");
+      return 0;
+    }
+  } else if( prog_str != NULL ) {
+    if( fd_base58_decode_32((const char *)prog_str, filter.uc) == NULL ) {
+      fd_method_error(ctx, -1, "invalid base58 encoding");
+      return 0;
+    }
+    if( !fd_rpc_acct_index_is_token_program( &filter ) ) {
+      fd_method_error(ctx, -1, "Invalid param: unrecognized Token program id");
+      return 0;
+    }
+  } else {
+    fd_method_error(ctx, -1, "%s requires a mint or programId filter", method);
+    return 0;
+  }
+
+  fd_rpc_encoding_t enc;
+  long off, len;
+  if( !parse_account_config( values, ctx, 2, &enc, &off, &len ) ) return 0;
+
+  fd_web_reply_sprintf(ws, "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"apiVersion\":\"" FIREDANCER_VERSION "\",\"slot\":%lu},\"value\":[",
+                       ctx->global->last_slot_notify.slot_exec.slot);
+  ulong cnt = 0;
+  for( fd_rpc_acct_index_ele_t const * ele = fd_rpc_acct_index_first( index, by, &key );
+       ele;
+       ele = fd_rpc_acct_index_next( index, by, ele ) ) {
+    if( !fd_memeq( ( mint_str != NULL ? ele->mint.uc : ele->owner.uc ), filter.uc, sizeof(fd_pubkey_t) ) ) continue;
+
+    FD_SCRATCH_SCOPE_BEGIN {
+      ulong val_sz;
+      fd_funk_rec_key_t recid = fd_funk_acc_key(&ele->addr);
+      const void * val        = read_account(ctx, &recid, &val_sz);
+      if( val == NULL ) continue;
+
+      /* The index entry can be behind funk, check the account itself */
+      fd_account_meta_t const * meta = (fd_account_meta_t const *)val;
+      if( val_sz < sizeof(fd_account_meta_t) || meta->hlen + meta->dlen > val_sz ) continue;
+      fd_pubkey_t owner;
+      memcpy( owner.uc, meta->info.owner, sizeof(fd_pubkey_t) );
+      if( !fd_rpc_acct_index_is_token_program( &owner ) || meta->dlen < FD_RPC_ACCT_INDEX_TOKEN_ACCT_SZ ) continue;
+      uchar const * data = (uchar const *)val + meta->hlen;
+      uchar const * field;
+      if( by == FD_RPC_ACCT_INDEX_BY_DELEGATE ) {
+        if( FD_LOAD( uint, data + FD_RPC_ACCT_INDEX_TOKEN_DELEGATE_OFF ) != 1U ) continue;
+        field = data + FD_RPC_ACCT_INDEX_TOKEN_DELEGATE_OFF + 4UL;
+      } else {
+        field = data + FD_RPC_ACCT_INDEX_TOKEN_OWNER_OFF;
+      }
+      if( !fd_memeq( field, key.uc, sizeof(fd_pubkey_t) ) ) continue;
+      if( !fd_memeq( ( mint_str != NULL ? data + FD_RPC_ACCT_INDEX_TOKEN_MINT_OFF : owner.uc ), filter.uc, sizeof(fd_pubkey_t) ) ) continue;
+
+      if( cnt++ ) fd_web_reply_append(ws, ",", 1);
+      const char * err = keyed_account_to_json( ws, &ele->addr, enc, val, val_sz, off, len );
+      if( err ) {
+        fd_method_error(ctx, -1, "%s", err);
+        return 0;
+      }
+    } FD_SCRATCH_SCOPE_END;
+  }
+  fd_web_reply_sprintf(ws, "]},\"id\":%s}" CRLF, ctx->call_id);
   return 0;
 }
 
 // Implementation of the "getTokenAccountsByDelegate" methods
+// curl http://localhost:8123 -X POST -H "Content-Type: application/json" -d '{"jsonrpc":"2.0","id":1, "method":"getTokenAccountsByDelegate", "params":["6s5gDyLyfNXP6WHUEn4YSMQJVcGETpKze7FCPeg9wxYT", {"programId":"TokenkegQfeZyiNwAJbNbGKPFXCWuBvf9Ss623VQ5DA"}, {"encoding":"base64"}]}'
+
 static int
 method_getTokenAccountsByDelegate(struct json_values* values, fd_rpc_ctx_t * ctx) {
-  (void)values;
-  (void)ctx;
-  FD_LOG_WARNING(( "getTokenAccountsByDelegate is not implemented" ));
-  fd_method_error(ctx, -1, "getTokenAccountsByDelegate is not implemented");
-  return 0;
+  return token_accounts_by( values, ctx, FD_RPC_ACCT_INDEX_BY_DELEGATE, "getTokenAccountsByDelegate" );
 }
 
 // Implementation of the "getTokenAccountsByOwner" methods
+// curl http://localhost:8123 -X POST -H "Content-Type: application/json" -d '{"jsonrpc":"2.0","id":1, "method":"getTokenAccountsByOwner", "params":["6s5gDyLyfNXP6WHUEn4YSMQJVcGETpKze7FCPeg9wxYT", {"programId":"TokenkegQfeZyiNwAJbNbGKPFXCWuBvf9Ss623VQ5DA"}, {"encoding":"base64"}]}'
+
 static int
 method_getTokenAccountsByOwner(struct json_values* values, fd_rpc_ctx_t * ctx) {
-  (void)values;
-  (void)ctx;
-  FD_LOG_WARNING(( "getTokenAccountsByOwner is not implemented" ));
-  fd_method_error(ctx, -1, "getTokenAccountsByOwner is not implemented");
-  return 0;
+  return token_accounts_by( values, ctx, FD_RPC_ACCT_INDEX_BY_TOKEN_OWNER, "getTokenAccountsByOwner" );
 }
 
 // Implementation of the "getTokenLargestAccounts" methods
+// curl http://localhost:8123 -X POST -H "Content-Type: application/json" -d '{"jsonrpc":"2.0","id":1, "method":"getTokenLargestAccounts", "params":["EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v"]}'
+
 static int
 method_getTokenLargestAccounts(struct json_values* values, fd_rpc_ctx_t * ctx) {
-  (void)values;
-  (void)ctx;
-  FD_LOG_WARNING(( "getTokenLargestAccounts is not implemented" ));
-  fd_method_error(ctx, -1, "getTokenLargestAccounts is not implemented");
+  fd_webserver_t * ws = &ctx->global->ws;
+  fd_rpc_acct_index_t * index = acct_index_ready( ctx, "getTokenLargestAccounts" );
+  if( FD_UNLIKELY( !index ) ) return 0;
+
+  fd_pubkey_t mint;
+  if( !parse_pubkey_param( values, ctx, 0, "getTokenLargestAccounts", &mint ) ) return 0;
+  int decimals = read_token_decimals( ctx, &mint );
+  if( decimals < 0 ) {
+    fd_method_error(ctx, -1, "Invalid param: not a Token mint");
+    return 0;
+  }
+
+  fd_rpc_acct_index_ele_t const * top[ FD_RPC_LARGEST_ACCOUNTS_MAX ];
+  ulong cnt = fd_rpc_acct_index_largest( index, FD_RPC_ACCT_INDEX_BY_MINT, &mint, top, FD_RPC_LARGEST_ACCOUNTS_MAX );
+
+  fd_web_reply_sprintf(ws, "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"apiVersion\":\"" FIREDANCER_VERSION "\",\"slot\":%lu},\"value\":[",
+                       ctx->global->last_slot_notify.slot_exec.slot);
+  for( ulong i = 0; i < cnt; ++i ) {
+    char addr[50];
+    fd_base58_encode_32(top[i]->addr.uc, 0, addr);
+    fd_web_reply_sprintf(ws, "%s{\"address\":\"%s\",", (i ? "," : ""), addr);
+    token_amount_to_json( ws, top[i]->amount, (uint)decimals );
+    fd_web_reply_append(ws, "}", 1);
+  }
+  fd_web_reply_sprintf(ws, "]},\"id\":%s}" CRLF, ctx->call_id);
   return 0;
 }
 
@@ -1911,63 +2409,9 @@ method_simulateTransaction(struct json_values* values, fd_rpc_ctx_t * ctx) {
   return 0;
 }
 
-// Top level method dispatch function
-void
-fd_webserver_method_generic(struct json_values* values, void * cb_arg) {
-  fd_rpc_ctx_t ctx = *( fd_rpc_ctx_t *)cb_arg;
-
-  snprintf(ctx.call_id, sizeof(ctx.call_id)-1, "null");
-
-  static const uint PATH[2] = {
-    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_JSONRPC,
-    (JSON_TOKEN_STRING<<16)
-  };
-  ulong arg_sz = 0;
-  const void* arg = json_get_value(values, PATH, 2, &arg_sz);
-  if (arg == NULL) {
-    fd_method_error(&ctx, -1, "missing jsonrpc member");
-    return;
-  }
-  if (!MATCH_STRING(arg, arg_sz, "2.0")) {
-    fd_method_error(&ctx, -1, "jsonrpc value must be 2.0");
-    return;
-  }
-
-  static const uint PATH3[2] = {
-    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_ID,
-    (JSON_TOKEN_INTEGER<<16)
-  };
-  arg_sz = 0;
-  arg = json_get_value(values, PATH3, 2, &arg_sz);
-  if (arg != NULL) {
-    snprintf(ctx.call_id, sizeof(ctx.call_id)-1, "%lu", *(ulong*)arg); /* TODO check signedness of arg */
-  } else {
-    static const uint PATH4[2] = {
-      (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_ID,
-      (JSON_TOKEN_STRING<<16)
-    };
-    arg_sz = 0;
-    arg = json_get_value(values, PATH4, 2, &arg_sz);
-    if (arg != NULL) {
-      snprintf(ctx.call_id, sizeof(ctx.call_id)-1, "\"%s\"", (const char *)arg);
-    } else {
-      fd_method_error(&ctx, -1, "missing id member");
-      return;
-    }
-  }
-
-  static const uint PATH2[2] = {
-    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_METHOD,
-    (JSON_TOKEN_STRING<<16)
-  };
-  arg_sz = 0;
-  arg = json_get_value(values, PATH2, 2, &arg_sz);
-  if (arg == NULL) {
-    fd_method_error(&ctx, -1, "missing method member");
-    return;
-  }
-  long meth_id = fd_webserver_json_keyword((const char*)arg, arg_sz);
-
+// Dispatch to the method implementations
+static void
+fd_rpc_method_dispatch(struct json_values* values, fd_rpc_ctx_t ctx, long meth_id, const void * arg) {
   switch (meth_id) {
   case KEYW_RPCMETHOD_GETACCOUNTINFO:
     if (!method_getAccountInfo(values, &ctx))
@@ -2187,6 +2631,163 @@ fd_webserver_method_generic(struct json_values* values, void * cb_arg) {
   }
 }
 
+/* rpc_cache_key builds the response cache key of a request into key
+   (the method's parameters, in request order, with their paths).
+   Returns 0 if the response of the request must not be cached.
+   *immutable is set if the response never changes (a block of a rooted
+   slot). */
+
+static int
+rpc_cache_key( fd_rpc_ctx_t * ctx, long meth_id, struct json_values * values,
+               uchar key[ FD_RPC_CACHE_KEY_MAX ], ulong * key_sz, int * immutable ) {
+  *immutable = 0;
+  switch (meth_id) {
+  case KEYW_RPCMETHOD_GETLATESTBLOCKHASH:
+  case KEYW_RPCMETHOD_GETEPOCHINFO:
+  case KEYW_RPCMETHOD_GETVOTEACCOUNTS:
+  case KEYW_RPCMETHOD_GETLEADERSCHEDULE:
+    break;
+  case KEYW_RPCMETHOD_GETBLOCK: {
+    static const uint PATH_SLOT[3] = {
+      (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_PARAMS,
+      (JSON_TOKEN_LBRACKET<<16) | 0,
+      (JSON_TOKEN_INTEGER<<16)
+    };
+    ulong slot_sz = 0;
+    const void * slot = json_get_value(values, PATH_SLOT, 3, &slot_sz);
+    /* Blocks are only final once rooted */
+    if( slot == NULL || (ulong)(*(long*)slot) > ctx->global->last_slot_notify.slot_exec.root ) return 0;
+    *immutable = 1;
+    break;
+  }
+  default:
+    return 0;
+  }
+
+  ulong sz = 0;
+  for( uint i = 0; i < values->num_values; ++i ) {
+    struct json_path const * path = &values->values[i].path;
+    if( path->len == 0 || path->elems[0] != ((JSON_TOKEN_LBRACE<<16) | KEYW_JSON_PARAMS) ) continue;
+    ulong data_sz = values->values[i].data_sz;
+    ulong ent_sz = sizeof(uint) + path->len*sizeof(uint) + sizeof(ulong) + data_sz;
+    if( sz + ent_sz > FD_RPC_CACHE_KEY_MAX ) return 0;
+    FD_STORE( uint, key + sz, path->len );                                 sz += sizeof(uint);
+    fd_memcpy( key + sz, path->elems, path->len*sizeof(uint) );           sz += path->len*sizeof(uint);
+    FD_STORE( ulong, key + sz, data_sz );                                  sz += sizeof(ulong);
+    fd_memcpy( key + sz, values->buf + values->values[i].data_offset, data_sz ); sz += data_sz;
+  }
+  *key_sz = sz;
+  return 1;
+}
+
+/* rpc_cache_store saves the response just generated for the current
+   request, which starts at ws->prev_reply_len in the staged reply.
+   Only successful responses ending with the request id are stored. */
+
+static void
+rpc_cache_store( fd_rpc_ctx_t * ctx, long meth_id, uchar const * key, ulong key_sz, int immutable ) {
+  static const char RESULT[] = "{\"jsonrpc\":\"2.0\",\"result\":";
+  static const char ID[] = "\"id\":";
+  fd_webserver_t * ws = &ctx->global->ws;
+
+  ulong staged_sz = 0;
+  const char * staged = fd_web_reply_staged( ws, &staged_sz );
+  if( staged == NULL || staged_sz < ws->prev_reply_len ) return;
+  const char * reply = staged + ws->prev_reply_len;
+  ulong reply_sz = staged_sz - ws->prev_reply_len;
+  if( reply_sz < sizeof(RESULT)-1 || memcmp( reply, RESULT, sizeof(RESULT)-1 ) ) return;
+
+  /* Strip the id and whatever follows it */
+  const char * tail = ( reply_sz >= 2 && !memcmp( reply + reply_sz - 2, CRLF, 2 ) ? "}" CRLF : "}" );
+  ulong tail_sz = strlen( tail );
+  ulong id_sz = strlen( ctx->call_id );
+  ulong suffix_sz = id_sz + tail_sz;
+  if( reply_sz < suffix_sz + sizeof(ID)-1 ) return;
+  const char * suffix = reply + reply_sz - suffix_sz;
+  if( memcmp( suffix, ctx->call_id, id_sz ) || memcmp( suffix + id_sz, tail, tail_sz ) ||
+      memcmp( suffix - (sizeof(ID)-1), ID, sizeof(ID)-1 ) ) return;
+
+  fd_rpc_cache_insert( ctx->global->cache, meth_id, key, key_sz, immutable, reply, reply_sz - suffix_sz, tail );
+}
+
+// Top level method dispatch function
+void
+fd_webserver_method_generic(struct json_values* values, void * cb_arg) {
+  fd_rpc_ctx_t ctx = *( fd_rpc_ctx_t *)cb_arg;
+
+  snprintf(ctx.call_id, sizeof(ctx.call_id)-1, "null");
+
+  static const uint PATH[2] = {
+    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_JSONRPC,
+    (JSON_TOKEN_STRING<<16)
+  };
+  ulong arg_sz = 0;
+  const void* arg = json_get_value(values, PATH, 2, &arg_sz);
+  if (arg == NULL) {
+    fd_method_error(&ctx, -1, "missing jsonrpc member");
+    return;
+  }
+  if (!MATCH_STRING(arg, arg_sz, "2.0")) {
+    fd_method_error(&ctx, -1, "jsonrpc value must be 2.0");
+    return;
+  }
+
+  static const uint PATH3[2] = {
+    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_ID,
+    (JSON_TOKEN_INTEGER<<16)
+  };
+  arg_sz = 0;
+  arg = json_get_value(values, PATH3, 2, &arg_sz);
+  if (arg != NULL) {
+    snprintf(ctx.call_id, sizeof(ctx.call_id)-1, "%lu", *(ulong*)arg); /* TODO check signedness of arg */
+  } else {
+    static const uint PATH4[2] = {
+      (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_ID,
+      (JSON_TOKEN_STRING<<16)
+    };
+    arg_sz = 0;
+    arg = json_get_value(values, PATH4, 2, &arg_sz);
+    if (arg != NULL) {
+      snprintf(ctx.call_id, sizeof(ctx.call_id)-1, "\"%s\"", (const char *)arg);
+    } else {
+      fd_method_error(&ctx, -1, "missing id member");
+      return;
+    }
+  }
+
+  static const uint PATH2[2] = {
+    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_METHOD,
+    (JSON_TOKEN_STRING<<16)
+  };
+  arg_sz = 0;
+  arg = json_get_value(values, PATH2, 2, &arg_sz);
+  if (arg == NULL) {
+    fd_method_error(&ctx, -1, "missing method member");
+    return;
+  }
+  long meth_id = fd_webserver_json_keyword((const char*)arg, arg_sz);
+
+  /* Hot read-only methods are answered from the response cache if the
+     same request was seen since the last slot */
+  uchar cache_key[ FD_RPC_CACHE_KEY_MAX ];
+  ulong cache_key_sz = 0;
+  int   cache_immutable = 0;
+  int   cacheable = rpc_cache_key( &ctx, meth_id, values, cache_key, &cache_key_sz, &cache_immutable );
+  if( cacheable ) {
+    fd_rpc_cache_ent_t const * ent = fd_rpc_cache_query( ctx.global->cache, meth_id, cache_key, cache_key_sz );
+    if( ent ) {
+      fd_webserver_t * ws = &ctx.global->ws;
+      fd_web_reply_append( ws, ent->body, ent->body_sz );
+      fd_web_reply_sprintf( ws, "%s%s", ctx.call_id, ent->tail );
+      return;
+    }
+  }
+
+  fd_rpc_method_dispatch( values, ctx, meth_id, arg );
+
+  if( cacheable ) rpc_cache_store( &ctx, meth_id, cache_key, cache_key_sz, cache_immutable );
+}
+
 static int
 ws_method_accountSubscribe(ulong conn_id, struct json_values * values, fd_rpc_ctx_t * ctx) {
   fd_webserver_t * ws = &ctx->global->ws;
@@ -2258,19 +2859,20 @@ ws_method_accountSubscribe(ulong conn_id, struct json_values * values, fd_rpc_ct
     }
 
     fd_rpc_global_ctx_t * subs = ctx->global;
-    if( subs->sub_cnt >= FD_WS_MAX_SUBS ) {
+    fd_rpc_ws_sub_t * sub = fd_rpc_ws_subs_acquire( subs->ws_subs );
+    if( sub == NULL ) {
       fd_method_simple_error(ctx, -1, "too many subscriptions");
       return 0;
     }
-    struct fd_ws_subscription * sub = &subs->sub_list[ subs->sub_cnt++ ];
     sub->conn_id = conn_id;
     sub->meth_id = KEYW_WS_METHOD_ACCOUNTSUBSCRIBE;
     strncpy(sub->call_id, ctx->call_id, sizeof(sub->call_id));
     ulong subid = sub->subsc_id = ++(subs->last_subsc_id);
-    sub->acct_subscribe.acct = acct;
-    sub->acct_subscribe.enc = enc;
-    sub->acct_subscribe.off = (off_ptr ? *(long*)off_ptr : FD_LONG_UNSET);
-    sub->acct_subscribe.len = (len_ptr ? *(long*)len_ptr : FD_LONG_UNSET);
+    sub->acct = acct;
+    sub->enc = (int)enc;
+    sub->off = (off_ptr ? *(long*)off_ptr : FD_LONG_UNSET);
+    sub->len = (len_ptr ? *(long*)len_ptr : FD_LONG_UNSET);
+    fd_rpc_ws_subs_insert( subs->ws_subs, sub, FD_RPC_WS_SUB_KIND_ACCT );
 
     fd_web_reply_sprintf(ws, "{\"jsonrpc\":\"2.0\",\"result\":%lu,\"id\":%s}" CRLF,
                          subid, sub->call_id);
@@ -2280,32 +2882,98 @@ ws_method_accountSubscribe(ulong conn_id, struct json_values * values, fd_rpc_ct
   return 1;
 }
 
+/* ws_account_notif_prefix renders the part of an accountNotification
+   that does not depend on the subscription into a new reply. */
+
 static int
-ws_method_accountSubscribe_update(fd_rpc_ctx_t * ctx, fd_replay_notif_msg_t * msg, struct fd_ws_subscription * sub) {
-  fd_webserver_t * ws = &ctx->global->ws;
+ws_account_notif_prefix( fd_webserver_t * ws, fd_replay_notif_msg_t * msg, fd_rpc_ws_sub_t const * sub,
+                         const void * val, ulong val_sz ) {
   fd_web_reply_new( ws );
+  fd_web_reply_sprintf(ws, "{\"jsonrpc\":\"2.0\",\"method\":\"accountNotification\",\"params\":{\"result\":{\"context\":{\"apiVersion\":\"" FIREDANCER_VERSION "\",\"slot\":%lu},\"value\":",
+                       msg->accts.funk_xid.ul[0]);
+  if (val == NULL) {
+    EMIT_SIMPLE("null");
+    return 1;
+  }
+  const char * err = fd_account_to_json( ws, sub->acct, (fd_rpc_encoding_t)sub->enc, val, val_sz, sub->off, sub->len );
+  if( err ) {
+    FD_LOG_WARNING(( "error converting account to json: %s", err ));
+    return 0;
+  }
+  return 1;
+}
 
-  FD_SCRATCH_SCOPE_BEGIN {
-    ulong val_sz;
-    fd_funk_rec_key_t recid = fd_funk_acc_key(&sub->acct_subscribe.acct);
-    const void * val = read_account_with_xid(ctx, &recid, &msg->accts.funk_xid, &val_sz);
-    if (val == NULL) {
-      fd_web_reply_sprintf(ws, "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"apiVersion\":\"" FIREDANCER_VERSION "\",\"slot\":%lu},\"value\":null},\"subscription\":%lu}" CRLF,
-                           msg->accts.funk_xid.ul[0], sub->subsc_id);
-      return 1;
+/* Maximum number of distinct (encoding, data slice) combinations whose
+   rendering is shared across the subscribers of one account write.
+   Subscribers beyond that get their notification rendered
+   individually. */
+#define FD_RPC_WS_NOTIF_CACHE_MAX 8UL
+
+struct fd_rpc_ws_notif_cache {
+  int          enc;
+  long         off;
+  long         len;
+  const char * prefix; /* NULL if rendering failed */
+  ulong        prefix_sz;
+};
+
+/* ws_method_accountSubscribe_notify sends an accountNotification for
+   the account id, whose new value is val (NULL if the account no longer
+   exists), to every subscriber of id.  The account is encoded once per
+   distinct (encoding, data slice) and the encoding is copied into each
+   subscriber's message.  Must be called from within a scratch scope. */
+
+static void
+ws_method_accountSubscribe_notify( fd_rpc_ctx_t * ctx, fd_replay_notif_msg_t * msg, fd_pubkey_t const * id,
+                                   const void * val, ulong val_sz ) {
+  fd_rpc_global_ctx_t * glob = ctx->global;
+  fd_webserver_t * ws = &glob->ws;
+
+  struct fd_rpc_ws_notif_cache cache[ FD_RPC_WS_NOTIF_CACHE_MAX ];
+  ulong cache_cnt = 0;
+
+  for( fd_rpc_ws_sub_t const * sub = fd_rpc_ws_subs_acct_first( glob->ws_subs, id );
+       sub;
+       sub = fd_rpc_ws_subs_acct_next( glob->ws_subs, sub ) ) {
+    struct fd_rpc_ws_notif_cache * ent = NULL;
+    for( ulong k = 0; k < cache_cnt; ++k ) {
+      if( cache[k].enc == sub->enc && cache[k].off == sub->off && cache[k].len == sub->len ) {
+        ent = &cache[k];
+        break;
+      }
     }
 
-    fd_web_reply_sprintf(ws, "{\"jsonrpc\":\"2.0\",\"method\":\"accountNotification\",\"params\":{\"result\":{\"context\":{\"apiVersion\":\"" FIREDANCER_VERSION "\",\"slot\":%lu},\"value\":",
-                         msg->accts.funk_xid.ul[0]);
-    const char * err = fd_account_to_json( ws, sub->acct_subscribe.acct, sub->acct_subscribe.enc, val, val_sz, sub->acct_subscribe.off, sub->acct_subscribe.len );
-    if( err ) {
-      FD_LOG_WARNING(( "error converting account to json: %s", err ));
-      return 0;
+    if( ent == NULL ) {
+      int ok = ws_account_notif_prefix( ws, msg, sub, val, val_sz );
+      if( cache_cnt < FD_RPC_WS_NOTIF_CACHE_MAX ) {
+        ulong sz = 0;
+        const char * staged = ( ok ? fd_web_reply_staged( ws, &sz ) : NULL );
+        if( staged && fd_scratch_alloc_is_safe( 1UL, sz ) ) {
+          char * prefix = fd_scratch_alloc( 1UL, sz );
+          fd_memcpy( prefix, staged, sz );
+          ent = &cache[ cache_cnt++ ];
+          *ent = (struct fd_rpc_ws_notif_cache){ .enc = sub->enc, .off = sub->off, .len = sub->len, .prefix = prefix, .prefix_sz = sz };
+        } else if( !ok ) {
+          ent = &cache[ cache_cnt++ ];
+          *ent = (struct fd_rpc_ws_notif_cache){ .enc = sub->enc, .off = sub->off, .len = sub->len, .prefix = NULL, .prefix_sz = 0 };
+        }
+      }
+      if( ent == NULL ) {
+        /* Not shared, send what was just rendered */
+        if( ok ) {
+          fd_web_reply_sprintf(ws, "},\"subscription\":%lu}}" CRLF, sub->subsc_id);
+          fd_web_ws_send( ws, sub->conn_id );
+        }
+        continue;
+      }
     }
-    fd_web_reply_sprintf(ws, "},\"subscription\":%lu}}" CRLF, sub->subsc_id);
-  } FD_SCRATCH_SCOPE_END;
 
-  return 1;
+    if( ent->prefix == NULL ) continue;
+    fd_web_reply_new( ws );
+    fd_web_reply_append( ws, ent->prefix, ent->prefix_sz );
+    fd_web_reply_sprintf(ws, "},\"subscription\":%lu}}" CRLF, sub->subsc_id);
+    fd_web_ws_send( ws, sub->conn_id );
+  }
 }
 
 static int
@@ -2314,15 +2982,16 @@ ws_method_slotSubscribe(ulong conn_id, struct json_values * values, fd_rpc_ctx_t
   fd_webserver_t * ws = &ctx->global->ws;
 
   fd_rpc_global_ctx_t * subs = ctx->global;
-  if( subs->sub_cnt >= FD_WS_MAX_SUBS ) {
+  fd_rpc_ws_sub_t * sub = fd_rpc_ws_subs_acquire( subs->ws_subs );
+  if( sub == NULL ) {
     fd_method_simple_error(ctx, -1, "too many subscriptions");
     return 0;
   }
-  struct fd_ws_subscription * sub = &subs->sub_list[ subs->sub_cnt++ ];
   sub->conn_id = conn_id;
   sub->meth_id = KEYW_WS_METHOD_SLOTSUBSCRIBE;
   strncpy(sub->call_id, ctx->call_id, sizeof(sub->call_id));
   ulong subid = sub->subsc_id = ++(subs->last_subsc_id);
+  fd_rpc_ws_subs_insert( subs->ws_subs, sub, FD_RPC_WS_SUB_KIND_SLOT );
 
   fd_web_reply_sprintf(ws, "{\"jsonrpc\":\"2.0\",\"result\":%lu,\"id\":%s}" CRLF,
                        subid, sub->call_id);
@@ -2331,7 +3000,7 @@ ws_method_slotSubscribe(ulong conn_id, struct json_values * values, fd_rpc_ctx_t
 }
 
 static int
-ws_method_slotSubscribe_update(fd_rpc_ctx_t * ctx, fd_replay_notif_msg_t * msg, struct fd_ws_subscription * sub) {
+ws_method_slotSubscribe_update(fd_rpc_ctx_t * ctx, fd_replay_notif_msg_t * msg, fd_rpc_ws_sub_t const * sub) {
   fd_webserver_t * ws = &ctx->global->ws;
   fd_web_reply_new( ws );
 
@@ -2452,7 +3121,23 @@ fd_rpc_create_ctx(fd_rpcserver_args_t * args, fd_rpc_ctx_t ** ctx_p) {
     gctx->tpu_socket = -1;
   }
 
-  void * mem = fd_valloc_malloc( valloc, fd_perf_sample_deque_align(), fd_perf_sample_deque_footprint() );
+  ulong acct_index_max = ( args->acct_index_max ? args->acct_index_max : FD_RPC_ACCT_INDEX_MAX_DEFAULT );
+  void * mem = fd_valloc_malloc( valloc, fd_rpc_acct_index_align(), fd_rpc_acct_index_footprint( acct_index_max ) );
+  gctx->acct_index = fd_rpc_acct_index_join( fd_rpc_acct_index_new( mem, acct_index_max, 0UL ) );
+  FD_TEST( gctx->acct_index );
+
+  ulong ws_sub_max = ( args->ws_sub_max ? args->ws_sub_max : FD_RPC_WS_SUBS_MAX_DEFAULT );
+  mem = fd_valloc_malloc( valloc, fd_rpc_ws_subs_align(), fd_rpc_ws_subs_footprint( ws_sub_max ) );
+  gctx->ws_subs = fd_rpc_ws_subs_join( fd_rpc_ws_subs_new( mem, ws_sub_max, 0UL ) );
+  FD_TEST( gctx->ws_subs );
+
+  ulong cache_ent_max  = ( args->cache_ent_max  ? args->cache_ent_max  : FD_RPC_CACHE_ENT_MAX_DEFAULT  );
+  ulong cache_byte_max = ( args->cache_byte_max ? args->cache_byte_max : FD_RPC_CACHE_BYTE_MAX_DEFAULT );
+  mem = fd_valloc_malloc( valloc, fd_rpc_cache_align(), fd_rpc_cache_footprint( cache_ent_max ) );
+  gctx->cache = fd_rpc_cache_join( fd_rpc_cache_new( mem, cache_ent_max, cache_byte_max, valloc ) );
+  FD_TEST( gctx->cache );
+
+  mem = fd_valloc_malloc( valloc, fd_perf_sample_deque_align(), fd_perf_sample_deque_footprint() );
   gctx->perf_samples = fd_perf_sample_deque_join( fd_perf_sample_deque_new( mem ) );
   FD_TEST( gctx->perf_samples );
 
@@ -2475,6 +3160,11 @@ fd_rpc_start_service(fd_rpcserver_args_t * args, fd_rpc_ctx_t * ctx) {
   msg->type = FD_REPLAY_SLOT_TYPE;
   msg->slot_exec.slot = args->blockstore->shmem->wmk;
   msg->slot_exec.root = args->blockstore->shmem->wmk;
+
+  /* With replay running, scanning would race with replay writing funk.
+     The index then only tracks the accounts replay writes, and the
+     methods that need a complete index return an error. */
+  if( args->acct_index_scan ) acct_index_scan( gctx );
 }
 
 void
@@ -2491,6 +3181,15 @@ fd_rpc_stop_service(fd_rpc_ctx_t * ctx) {
   if ( FD_LIKELY( glob->perf_samples ) ) {
     fd_valloc_free( valloc, fd_perf_sample_deque_delete( fd_perf_sample_deque_leave( glob->perf_samples ) ) );
   }
+  if( FD_LIKELY( glob->acct_index ) ) {
+    fd_valloc_free( valloc, fd_rpc_acct_index_delete( fd_rpc_acct_index_leave( glob->acct_index ) ) );
+  }
+  if( FD_LIKELY( glob->ws_subs ) ) {
+    fd_valloc_free( valloc, fd_rpc_ws_subs_delete( fd_rpc_ws_subs_leave( glob->ws_subs ) ) );
+  }
+  if( FD_LIKELY( glob->cache ) ) {
+    fd_valloc_free( valloc, fd_rpc_cache_delete( fd_rpc_cache_leave( glob->cache ) ) );
+  }
   fd_valloc_free( valloc, ctx->global );
   fd_valloc_free( valloc, ctx );
 }
@@ -2509,12 +3208,7 @@ void
 fd_webserver_ws_closed(ulong conn_id, void * cb_arg) {
   fd_rpc_ctx_t * ctx = ( fd_rpc_ctx_t *)cb_arg;
   fd_rpc_global_ctx_t * subs = ctx->global;
-  for( ulong i = 0; i < subs->sub_cnt; ++i ) {
-    if( subs->sub_list[i].conn_id == conn_id ) {
-      subs->sub_list[i] = subs->sub_list[--(subs->sub_cnt)];
-      --i;
-    }
-  }
+  fd_rpc_ws_subs_remove_conn( subs->ws_subs, conn_id );
 }
 
 static void
@@ -2579,22 +3273,28 @@ fd_rpc_replay_after_frag(fd_rpc_ctx_t * ctx, fd_replay_notif_msg_t * msg) {
       /* Update the timestamp for checking interval. */
 
       subs->perf_sample_ts = ts;
+
+      fd_rpc_cache_metrics_t const * m = fd_rpc_cache_metrics( subs->cache );
+      ulong lookups = m->hit_cnt + m->miss_cnt;
+      FD_LOG_INFO(( "response cache: %lu entries, %lu bytes, %lu hits, %lu misses (%.1f%% hit rate), %lu inserts, %lu evictions, %lu invalidations, %lu skipped",
+                    fd_rpc_cache_cnt( subs->cache ), fd_rpc_cache_bytes( subs->cache ), m->hit_cnt, m->miss_cnt,
+                    ( lookups ? 100.0 * (double)m->hit_cnt / (double)lookups : 0.0 ),
+                    m->insert_cnt, m->evict_cnt, m->invalidate_cnt, m->skip_cnt ));
     }
 
     subs->last_slot_notify = *msg;
+    fd_rpc_cache_invalidate( subs->cache );
     fd_hash_t * h = &subs->recent_blockhash[msg->slot_exec.slot % MAX_RECENT_BLOCKHASHES];
     fd_hash_copy( h, &msg->slot_exec.block_hash );
 
-    for( ulong j = 0; j < subs->sub_cnt; ++j ) {
-      struct fd_ws_subscription * sub = &subs->sub_list[ j ];
-      if( sub->meth_id == KEYW_WS_METHOD_SLOTSUBSCRIBE ) {
-        if( ws_method_slotSubscribe_update( ctx, msg, sub ) )
-          fd_web_ws_send( &subs->ws, sub->conn_id );
-      }
+    for( fd_rpc_ws_sub_t const * sub = fd_rpc_ws_subs_slot_first( subs->ws_subs );
+         sub;
+         sub = fd_rpc_ws_subs_slot_next( subs->ws_subs, sub ) ) {
+      if( ws_method_slotSubscribe_update( ctx, msg, sub ) )
+        fd_web_ws_send( &subs->ws, sub->conn_id );
     }
 
   } else if( msg->type == FD_REPLAY_ACCTS_TYPE ) {
-    /* TODO: replace with a hash table lookup? */
     for( uint i = 0; i < msg->accts.accts_cnt; ++i ) {
       fd_pubkey_t id;
       memcpy( &id, &msg->accts.accts[i].id, sizeof(id) );
@@ -2609,14 +3309,13 @@ fd_rpc_replay_after_frag(fd_rpc_ctx_t * ctx, fd_replay_notif_msg_t * msg) {
       fd_rpc_acct_map_ele_insert( subs->acct_map, ele, subs->acct_pool );
 
       if( ( msg->accts.accts[i].flags & FD_REPLAY_NOTIF_ACCT_WRITTEN ) ) {
-        for( ulong j = 0; j < subs->sub_cnt; ++j ) {
-          struct fd_ws_subscription * sub = &subs->sub_list[ j ];
-          if( sub->meth_id == KEYW_WS_METHOD_ACCOUNTSUBSCRIBE &&
-              !memcmp( &id, &sub->acct_subscribe.acct, sizeof(fd_pubkey_t) ) ) {
-            if( ws_method_accountSubscribe_update( ctx, msg, sub ) )
-              fd_web_ws_send( &subs->ws, sub->conn_id );
-          }
-        }
+        FD_SCRATCH_SCOPE_BEGIN {
+          ulong val_sz;
+          fd_funk_rec_key_t recid = fd_funk_acc_key(&id);
+          const void * val = read_account_with_xid(ctx, &recid, &msg->accts.funk_xid, &val_sz);
+          acct_index_update( subs, &id, val, val_sz, msg->accts.funk_xid.ul[0] );
+          ws_method_accountSubscribe_notify( ctx, msg, &id, val, val_sz );
+        } FD_SCRATCH_SCOPE_END;
       }
     }
   }
@@ -2630,6 +3329,7 @@ fd_rpc_stake_during_frag( fd_rpc_ctx_t * ctx, fd_stake_ci_t * state, void const
 
 void
 fd_rpc_stake_after_frag(fd_rpc_ctx_t * ctx, fd_stake_ci_t * state) {
-  (void)ctx;
   fd_stake_ci_stake_msg_fini( state );
+  /* Leader schedules may have changed */
+  fd_rpc_cache_invalidate( ctx->global->cache );
 }
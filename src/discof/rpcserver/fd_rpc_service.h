@@ -13,6 +13,18 @@
 
 typedef struct fd_rpc_ctx fd_rpc_ctx_t;
 
+/* Default capacity of the secondary account index used to answer
+   getProgramAccounts and the SPL token queries */
+#define FD_RPC_ACCT_INDEX_MAX_DEFAULT (1UL<<20)
+
+/* Default maximum number of concurrent websocket subscriptions */
+#define FD_RPC_WS_SUBS_MAX_DEFAULT (1UL<<17)
+
+/* Default number of entries (a power of 2) and total body size of the
+   response cache of hot read-only methods */
+#define FD_RPC_CACHE_ENT_MAX_DEFAULT  (1UL<<10)
+#define FD_RPC_CACHE_BYTE_MAX_DEFAULT (64UL<<20)
+
 struct fd_rpcserver_args {
   fd_valloc_t          valloc;
   int                  offline;
@@ -24,6 +36,11 @@ struct fd_rpcserver_args {
   ushort               port;
   fd_http_server_params_t params;
   struct sockaddr_in   tpu_addr;
+  ulong                acct_index_max;  /* 0 means FD_RPC_ACCT_INDEX_MAX_DEFAULT */
+  int                  acct_index_scan; /* populate the account index from funk at start (requires no concurrent funk writers), index based methods fail without it */
+  ulong                ws_sub_max;      /* 0 means FD_RPC_WS_SUBS_MAX_DEFAULT */
+  ulong                cache_ent_max;   /* 0 means FD_RPC_CACHE_ENT_MAX_DEFAULT */
+  ulong                cache_byte_max;  /* 0 means FD_RPC_CACHE_BYTE_MAX_DEFAULT */
 };
 typedef struct fd_rpcserver_args fd_rpcserver_args_t;
 
@@ -0,0 +1,285 @@
+#include "fd_rpc_ws_subs.h"
+
+static inline int
+pubkey_eq( fd_pubkey_t const * k0,
+           fd_pubkey_t const * k1 ) {
+  return !memcmp( k0->uc, k1->uc, sizeof(fd_pubkey_t) );
+}
+
+#define POOL_NAME fd_rpc_ws_subs_pool
+#define POOL_T    fd_rpc_ws_sub_t
+#define POOL_NEXT pool_next
+#include "../../util/tmpl/fd_pool.c"
+
+/* Many subscriptions can share an account (or a connection) and any of
+   them can be removed when its connection closes. */
+
+#define MAP_NAME  fd_rpc_ws_subs_acct
+#define MAP_KEY_T fd_pubkey_t
+#define MAP_ELE_T fd_rpc_ws_sub_t
+#define MAP_KEY   acct
+#define MAP_NEXT  acct_next
+#define MAP_PREV  acct_prev
+#define MAP_KEY_HASH(key,seed) fd_hash( seed, key, sizeof(fd_pubkey_t) )
+#define MAP_KEY_EQ(k0,k1)      pubkey_eq( k0, k1 )
+#define MAP_MULTI 1
+#define MAP_OPTIMIZE_RANDOM_ACCESS_REMOVAL 1
+#include "../../util/tmpl/fd_map_chain.c"
+
+#define MAP_NAME  fd_rpc_ws_subs_conn
+#define MAP_KEY_T ulong
+#define MAP_ELE_T fd_rpc_ws_sub_t
+#define MAP_KEY   conn_id
+#define MAP_NEXT  conn_next
+#define MAP_PREV  conn_prev
+#define MAP_MULTI 1
+#define MAP_OPTIMIZE_RANDOM_ACCESS_REMOVAL 1
+#include "../../util/tmpl/fd_map_chain.c"
+
+#define DLIST_NAME  fd_rpc_ws_subs_slot
+#define DLIST_ELE_T fd_rpc_ws_sub_t
+#define DLIST_NEXT  slot_next
+#define DLIST_PREV  slot_prev
+#include "../../util/tmpl/fd_dlist.c"
+
+#define FD_RPC_WS_SUBS_MAGIC (0xf17eda2ce75b5000UL) /* firedancer rpc ws subs version 0 */
+
+struct __attribute__((aligned(128UL))) fd_rpc_ws_subs {
+  ulong magic;
+  ulong sub_max;
+  ulong chain_cnt;
+  ulong cnt;
+
+  /* Offsets from the start of the registry (persistent) */
+
+  ulong pool_off;
+  ulong acct_off;
+  ulong conn_off;
+  ulong slot_off;
+
+  /* Local joins (valid after fd_rpc_ws_subs_join) */
+
+  fd_rpc_ws_sub_t *       pool;
+  fd_rpc_ws_subs_acct_t * acct;
+  fd_rpc_ws_subs_conn_t * conn;
+  fd_rpc_ws_subs_slot_t * slot;
+};
+
+FD_FN_CONST ulong
+fd_rpc_ws_subs_align( void ) {
+  return alignof(fd_rpc_ws_subs_t);
+}
+
+FD_FN_CONST ulong
+fd_rpc_ws_subs_footprint( ulong sub_max ) {
+  if( FD_UNLIKELY( !sub_max || sub_max>fd_rpc_ws_subs_acct_ele_max() ) ) return 0UL;
+  ulong chain_cnt = fd_rpc_ws_subs_acct_chain_cnt_est( sub_max );
+  return FD_LAYOUT_FINI(
+    FD_LAYOUT_APPEND(
+    FD_LAYOUT_APPEND(
+    FD_LAYOUT_APPEND(
+    FD_LAYOUT_APPEND(
+    FD_LAYOUT_APPEND(
+    FD_LAYOUT_INIT,
+      alignof(fd_rpc_ws_subs_t),      sizeof(fd_rpc_ws_subs_t)                    ),
+      fd_rpc_ws_subs_pool_align(),    fd_rpc_ws_subs_pool_footprint( sub_max )    ),
+      fd_rpc_ws_subs_acct_align(),    fd_rpc_ws_subs_acct_footprint( chain_cnt )  ),
+      fd_rpc_ws_subs_conn_align(),    fd_rpc_ws_subs_conn_footprint( chain_cnt )  ),
+      fd_rpc_ws_subs_slot_align(),    fd_rpc_ws_subs_slot_footprint()             ),
+    fd_rpc_ws_subs_align() );
+}
+
+void *
+fd_rpc_ws_subs_new( void * shmem,
+                    ulong  sub_max,
+                    ulong  seed ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_rpc_ws_subs_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned mem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_rpc_ws_subs_footprint( sub_max );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad sub_max (%lu)", sub_max ));
+    return NULL;
+  }
+
+  ulong chain_cnt = fd_rpc_ws_subs_acct_chain_cnt_est( sub_max );
+
+  FD_SCRATCH_ALLOC_INIT( l, shmem );
+  fd_rpc_ws_subs_t * subs = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_rpc_ws_subs_t),   sizeof(fd_rpc_ws_subs_t)                   );
+  void * pool             = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_ws_subs_pool_align(), fd_rpc_ws_subs_pool_footprint( sub_max )   );
+  void * acct             = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_ws_subs_acct_align(), fd_rpc_ws_subs_acct_footprint( chain_cnt ) );
+  void * conn             = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_ws_subs_conn_align(), fd_rpc_ws_subs_conn_footprint( chain_cnt ) );
+  void * slot             = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_ws_subs_slot_align(), fd_rpc_ws_subs_slot_footprint()            );
+  FD_TEST( FD_SCRATCH_ALLOC_FINI( l, fd_rpc_ws_subs_align() ) == (ulong)shmem + footprint );
+
+  fd_memset( subs, 0, sizeof(fd_rpc_ws_subs_t) );
+  subs->sub_max   = sub_max;
+  subs->chain_cnt = chain_cnt;
+
+  FD_TEST( fd_rpc_ws_subs_pool_new( pool, sub_max         ) );
+  FD_TEST( fd_rpc_ws_subs_acct_new( acct, chain_cnt, seed ) );
+  FD_TEST( fd_rpc_ws_subs_conn_new( conn, chain_cnt, seed ) );
+  FD_TEST( fd_rpc_ws_subs_slot_new( slot                  ) );
+
+  subs->pool_off = (ulong)pool - (ulong)shmem;
+  subs->acct_off = (ulong)acct - (ulong)shmem;
+  subs->conn_off = (ulong)conn - (ulong)shmem;
+  subs->slot_off = (ulong)slot - (ulong)shmem;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( subs->magic ) = FD_RPC_WS_SUBS_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_rpc_ws_subs_t *
+fd_rpc_ws_subs_join( void * shsubs ) {
+  fd_rpc_ws_subs_t * subs = (fd_rpc_ws_subs_t *)shsubs;
+
+  if( FD_UNLIKELY( !subs ) ) {
+    FD_LOG_WARNING(( "NULL subs" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)subs, fd_rpc_ws_subs_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned subs" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( subs->magic!=FD_RPC_WS_SUBS_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  ulong base = (ulong)shsubs;
+  subs->pool = fd_rpc_ws_subs_pool_join( (void *)( base + subs->pool_off ) );
+  subs->acct = fd_rpc_ws_subs_acct_join( (void *)( base + subs->acct_off ) );
+  subs->conn = fd_rpc_ws_subs_conn_join( (void *)( base + subs->conn_off ) );
+  subs->slot = fd_rpc_ws_subs_slot_join( (void *)( base + subs->slot_off ) );
+  if( FD_UNLIKELY( !subs->pool || !subs->acct || !subs->conn || !subs->slot ) ) {
+    FD_LOG_WARNING(( "failed to join subs" ));
+    return NULL;
+  }
+
+  return subs;
+}
+
+void *
+fd_rpc_ws_subs_leave( fd_rpc_ws_subs_t * subs ) {
+
+  if( FD_UNLIKELY( !subs ) ) {
+    FD_LOG_WARNING(( "NULL subs" ));
+    return NULL;
+  }
+
+  fd_rpc_ws_subs_pool_leave( subs->pool );
+  fd_rpc_ws_subs_acct_leave( subs->acct );
+  fd_rpc_ws_subs_conn_leave( subs->conn );
+  fd_rpc_ws_subs_slot_leave( subs->slot );
+
+  return (void *)subs;
+}
+
+void *
+fd_rpc_ws_subs_delete( void * shsubs ) {
+  fd_rpc_ws_subs_t * subs = (fd_rpc_ws_subs_t *)shsubs;
+
+  if( FD_UNLIKELY( !subs ) ) {
+    FD_LOG_WARNING(( "NULL subs" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( subs->magic!=FD_RPC_WS_SUBS_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( subs->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shsubs;
+}
+
+FD_FN_PURE ulong fd_rpc_ws_subs_cnt( fd_rpc_ws_subs_t const * subs ) { return subs->cnt;     }
+FD_FN_PURE ulong fd_rpc_ws_subs_max( fd_rpc_ws_subs_t const * subs ) { return subs->sub_max; }
+
+fd_rpc_ws_sub_t *
+fd_rpc_ws_subs_acquire( fd_rpc_ws_subs_t * subs ) {
+  if( FD_UNLIKELY( !fd_rpc_ws_subs_pool_free( subs->pool ) ) ) return NULL;
+  fd_rpc_ws_sub_t * sub = fd_rpc_ws_subs_pool_ele_acquire( subs->pool );
+  sub->kind = -1;
+  return sub;
+}
+
+void
+fd_rpc_ws_subs_release( fd_rpc_ws_subs_t * subs,
+                        fd_rpc_ws_sub_t *  sub ) {
+  fd_rpc_ws_subs_pool_ele_release( subs->pool, sub );
+}
+
+void
+fd_rpc_ws_subs_insert( fd_rpc_ws_subs_t * subs,
+                       fd_rpc_ws_sub_t *  sub,
+                       int                kind ) {
+  ulong idx = fd_rpc_ws_subs_pool_idx( subs->pool, sub );
+  sub->kind = kind;
+  if( kind==FD_RPC_WS_SUB_KIND_ACCT ) fd_rpc_ws_subs_acct_idx_insert( subs->acct, idx, subs->pool );
+  else                                fd_rpc_ws_subs_slot_idx_push_tail( subs->slot, idx, subs->pool );
+  fd_rpc_ws_subs_conn_idx_insert( subs->conn, idx, subs->pool );
+  subs->cnt++;
+}
+
+ulong
+fd_rpc_ws_subs_remove_conn( fd_rpc_ws_subs_t * subs,
+                            ulong              conn_id ) {
+  fd_rpc_ws_sub_t * pool = subs->pool;
+  ulong null = fd_rpc_ws_subs_pool_idx_null( pool );
+  ulong cnt  = 0UL;
+  for(;;) {
+    ulong idx = fd_rpc_ws_subs_conn_idx_query( subs->conn, &conn_id, null, pool );
+    if( idx==null ) break;
+    fd_rpc_ws_subs_conn_idx_remove_fast( subs->conn, idx, pool );
+    if( pool[ idx ].kind==FD_RPC_WS_SUB_KIND_ACCT ) fd_rpc_ws_subs_acct_idx_remove_fast( subs->acct, idx, pool );
+    else                                            fd_rpc_ws_subs_slot_idx_remove( subs->slot, idx, pool );
+    fd_rpc_ws_subs_pool_idx_release( pool, idx );
+    cnt++;
+  }
+  subs->cnt -= cnt;
+  return cnt;
+}
+
+FD_FN_PURE fd_rpc_ws_sub_t const *
+fd_rpc_ws_subs_acct_first( fd_rpc_ws_subs_t const * subs,
+                           fd_pubkey_t const *      acct ) {
+  return fd_rpc_ws_subs_acct_ele_query_const( subs->acct, acct, NULL, subs->pool );
+}
+
+FD_FN_PURE fd_rpc_ws_sub_t const *
+fd_rpc_ws_subs_acct_next( fd_rpc_ws_subs_t const * subs,
+                          fd_rpc_ws_sub_t const *  prev ) {
+  return fd_rpc_ws_subs_acct_ele_next_const( prev, NULL, subs->pool );
+}
+
+FD_FN_PURE fd_rpc_ws_sub_t const *
+fd_rpc_ws_subs_slot_first( fd_rpc_ws_subs_t const * subs ) {
+  if( fd_rpc_ws_subs_slot_is_empty( subs->slot, subs->pool ) ) return NULL;
+  return fd_rpc_ws_subs_slot_ele_peek_head_const( subs->slot, subs->pool );
+}
+
+FD_FN_PURE fd_rpc_ws_sub_t const *
+fd_rpc_ws_subs_slot_next( fd_rpc_ws_subs_t const * subs,
+                          fd_rpc_ws_sub_t const *  prev ) {
+  ulong idx = fd_rpc_ws_subs_slot_iter_fwd_next( fd_rpc_ws_subs_pool_idx( subs->pool, prev ), subs->slot, subs->pool );
+  if( fd_rpc_ws_subs_slot_iter_done( idx, subs->slot, subs->pool ) ) return NULL;
+  return subs->pool + idx;
+}
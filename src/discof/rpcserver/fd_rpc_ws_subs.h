@@ -0,0 +1,134 @@
+#ifndef HEADER_fd_src_discof_rpcserver_fd_rpc_ws_subs_h
+#define HEADER_fd_src_discof_rpcserver_fd_rpc_ws_subs_h
+
+/* fd_rpc_ws_subs is the registry of websocket subscriptions of the RPC
+   server.  Account subscriptions are indexed by the subscribed account
+   address so that a replay notification for an account only visits the
+   subscribers of that account.  Slot subscriptions are kept on a list.
+   Every subscription is also indexed by connection so that closing a
+   connection only visits the subscriptions of that connection.
+
+   The registry is single threaded and does not need to be part of a
+   workspace. */
+
+#include "../../flamenco/types/fd_types_custom.h"
+
+#define FD_RPC_WS_SUB_KIND_ACCT (0) /* accountSubscribe */
+#define FD_RPC_WS_SUB_KIND_SLOT (1) /* slotSubscribe */
+
+struct fd_rpc_ws_sub {
+  ulong       conn_id;
+  long        meth_id;
+  char        call_id[64];
+  ulong       subsc_id;
+
+  /* Valid for FD_RPC_WS_SUB_KIND_ACCT */
+
+  fd_pubkey_t acct;
+  int         enc;     /* fd_rpc_encoding_t */
+  long        off;     /* FD_LONG_UNSET if no data slice */
+  long        len;
+
+  /* Private */
+
+  int         kind;
+  ulong       pool_next;
+  ulong       acct_next;
+  ulong       acct_prev;
+  ulong       conn_next;
+  ulong       conn_prev;
+  ulong       slot_next;
+  ulong       slot_prev;
+};
+typedef struct fd_rpc_ws_sub fd_rpc_ws_sub_t;
+
+struct fd_rpc_ws_subs;
+typedef struct fd_rpc_ws_subs fd_rpc_ws_subs_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_rpc_ws_subs_{align,footprint} return the required alignment and
+   footprint of a memory region suitable for use as a registry of up to
+   sub_max subscriptions.  footprint returns 0 if sub_max is invalid. */
+
+FD_FN_CONST ulong
+fd_rpc_ws_subs_align( void );
+
+FD_FN_CONST ulong
+fd_rpc_ws_subs_footprint( ulong sub_max );
+
+/* fd_rpc_ws_subs_new formats an unused memory region for use as a
+   subscription registry.  fd_rpc_ws_subs_join joins the caller to it.
+   leave and delete are the usual inverses. */
+
+void *
+fd_rpc_ws_subs_new( void * shmem,
+                    ulong  sub_max,
+                    ulong  seed );
+
+fd_rpc_ws_subs_t *
+fd_rpc_ws_subs_join( void * shsubs );
+
+void *
+fd_rpc_ws_subs_leave( fd_rpc_ws_subs_t * subs );
+
+void *
+fd_rpc_ws_subs_delete( void * shsubs );
+
+/* fd_rpc_ws_subs_{cnt,max} return the number of subscriptions and the
+   capacity. */
+
+FD_FN_PURE ulong fd_rpc_ws_subs_cnt( fd_rpc_ws_subs_t const * subs );
+FD_FN_PURE ulong fd_rpc_ws_subs_max( fd_rpc_ws_subs_t const * subs );
+
+/* fd_rpc_ws_subs_acquire returns an unused subscription or NULL if the
+   registry is full.  The caller fills in the public fields and then
+   either inserts it with fd_rpc_ws_subs_insert or returns it with
+   fd_rpc_ws_subs_release. */
+
+fd_rpc_ws_sub_t *
+fd_rpc_ws_subs_acquire( fd_rpc_ws_subs_t * subs );
+
+void
+fd_rpc_ws_subs_release( fd_rpc_ws_subs_t * subs,
+                        fd_rpc_ws_sub_t *  sub );
+
+/* fd_rpc_ws_subs_insert makes an acquired subscription of the given
+   kind (FD_RPC_WS_SUB_KIND_*) visible.  conn_id (and acct for account
+   subscriptions) must not change while it is inserted. */
+
+void
+fd_rpc_ws_subs_insert( fd_rpc_ws_subs_t * subs,
+                       fd_rpc_ws_sub_t *  sub,
+                       int                kind );
+
+/* fd_rpc_ws_subs_remove_conn removes (and releases) every subscription
+   of conn_id.  Returns the number removed. */
+
+ulong
+fd_rpc_ws_subs_remove_conn( fd_rpc_ws_subs_t * subs,
+                            ulong              conn_id );
+
+/* fd_rpc_ws_subs_acct_{first,next} iterate over the subscriptions to
+   account acct.  fd_rpc_ws_subs_slot_{first,next} iterate over the
+   slot subscriptions.  Return NULL when done.  The registry must not be
+   modified during iteration. */
+
+FD_FN_PURE fd_rpc_ws_sub_t const *
+fd_rpc_ws_subs_acct_first( fd_rpc_ws_subs_t const * subs,
+                           fd_pubkey_t const *      acct );
+
+FD_FN_PURE fd_rpc_ws_sub_t const *
+fd_rpc_ws_subs_acct_next( fd_rpc_ws_subs_t const * subs,
+                          fd_rpc_ws_sub_t const *  prev );
+
+FD_FN_PURE fd_rpc_ws_sub_t const *
+fd_rpc_ws_subs_slot_first( fd_rpc_ws_subs_t const * subs );
+
+FD_FN_PURE fd_rpc_ws_sub_t const *
+fd_rpc_ws_subs_slot_next( fd_rpc_ws_subs_t const * subs,
+                          fd_rpc_ws_sub_t const *  prev );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_discof_rpcserver_fd_rpc_ws_subs_h */
@@ -284,6 +284,15 @@ void fd_web_ws_send( fd_webserver_t * ws, ulong conn_id ) {
   fd_http_server_ws_send( ws->server, conn_id );
 }
 
+const char *
+fd_web_reply_staged( fd_webserver_t * ws, ulong * sz ) {
+  fd_web_reply_flush( ws );
+  fd_http_server_t * http = ws->server;
+  if( FD_UNLIKELY( http->stage_err ) ) return NULL;
+  *sz = http->stage_len;
+  return (const char *)( http->oring + ( http->stage_off % http->oring_sz ) );
+}
+
 int fd_webserver_start( ushort portno, fd_http_server_params_t params, fd_valloc_t valloc, fd_webserver_t * ws, void * cb_arg ) {
   memset(ws, 0, sizeof(fd_webserver_t));
 
@@ -387,59 +396,21 @@ fd_web_reply_encode_base58( fd_webserver_t * ws,
   return fd_web_reply_append( ws, b58, out_sz );
 }
 
-static char base64_encoding_table[] = {
-  'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
-  'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
-  'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X',
-  'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
-  'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',
-  'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
-  'w', 'x', 'y', 'z', '0', '1', '2', '3',
-  '4', '5', '6', '7', '8', '9', '+', '/'
-};
-
 int
 fd_web_reply_encode_base64( fd_webserver_t * ws,
                             const void *     data,
                             ulong            data_sz ) {
-  for (ulong i = 0; i < data_sz; ) {
+  /* Encode directly into the quick buffer in chunks of whole 3 byte
+     groups, so only the last chunk can be padded */
+  uchar const * in = (uchar const *)data;
+  while( data_sz ) {
     if( FD_UNLIKELY( ws->quick_size + 4U > FD_WEBSERVER_QUICK_MAX ) ) {
       fd_web_reply_flush( ws );
     }
-    char * out_data = ws->quick_buf + ws->quick_size;
-    switch (data_sz - i) {
-    default: { /* 3 and above */
-      uint octet_a = ((uchar*)data)[i++];
-      uint octet_b = ((uchar*)data)[i++];
-      uint octet_c = ((uchar*)data)[i++];
-      uint triple = (octet_a << 0x10) + (octet_b << 0x08) + octet_c;
-      out_data[0] = base64_encoding_table[(triple >> 3 * 6) & 0x3F];
-      out_data[1] = base64_encoding_table[(triple >> 2 * 6) & 0x3F];
-      out_data[2] = base64_encoding_table[(triple >> 1 * 6) & 0x3F];
-      out_data[3] = base64_encoding_table[(triple >> 0 * 6) & 0x3F];
-      break;
-    }
-    case 2: {
-      uint octet_a = ((uchar*)data)[i++];
-      uint octet_b = ((uchar*)data)[i++];
-      uint triple = (octet_a << 0x10) + (octet_b << 0x08);
-      out_data[0] = base64_encoding_table[(triple >> 3 * 6) & 0x3F];
-      out_data[1] = base64_encoding_table[(triple >> 2 * 6) & 0x3F];
-      out_data[2] = base64_encoding_table[(triple >> 1 * 6) & 0x3F];
-      out_data[3] = '=';
-      break;
-    }
-    case 1: {
-      uint octet_a = ((uchar*)data)[i++];
-      uint triple = (octet_a << 0x10);
-      out_data[0] = base64_encoding_table[(triple >> 3 * 6) & 0x3F];
-      out_data[1] = base64_encoding_table[(triple >> 2 * 6) & 0x3F];
-      out_data[2] = '=';
-      out_data[3] = '=';
-      break;
-    }
-    }
-    ws->quick_size += 4U;
+    ulong chunk_sz = fd_ulong_min( data_sz, ( ( FD_WEBSERVER_QUICK_MAX - ws->quick_size )/4UL )*3UL );
+    ws->quick_size += fd_base64_encode( ws->quick_buf + ws->quick_size, in, chunk_sz );
+    in      += chunk_sz;
+    data_sz -= chunk_sz;
   }
   return 0;
 }
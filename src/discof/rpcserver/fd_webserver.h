@@ -41,6 +41,11 @@ void fd_web_ws_send( fd_webserver_t * ws, ulong conn_id );
 
 void fd_web_reply_new( fd_webserver_t * ws );
 
+/* fd_web_reply_staged returns the reply built so far (contiguous, *sz
+   bytes) or NULL if building it failed.  The returned buffer is valid
+   until the reply is modified, sent or a new reply is started. */
+const char * fd_web_reply_staged( fd_webserver_t * ws, ulong * sz );
+
 void fd_web_reply_error( fd_webserver_t * ws, int errcode, const char * text, const char * call_id );
 
 int fd_web_reply_append( fd_webserver_t * ws,
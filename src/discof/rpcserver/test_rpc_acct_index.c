@@ -0,0 +1,165 @@
+#include "fd_rpc_acct_index.h"
+
+#define ELE_MAX (1024UL)
+
+static uchar index_mem[ 1UL<<20 ] __attribute__((aligned(128)));
+
+static const fd_pubkey_t token_id = { .uc = {
+  0x06,0xdd,0xf6,0xe1,0xd7,0x65,0xa1,0x93,0xd9,0xcb,0xe1,0x46,0xce,0xeb,0x79,0xac,
+  0x1c,0xb4,0x85,0xed,0x5f,0x5b,0x37,0x91,0x3a,0x8c,0xf5,0x85,0x7e,0xff,0x00,0xa9 } };
+
+static fd_pubkey_t
+test_key( ulong i ) {
+  fd_pubkey_t key = {0};
+  key.ul[0] = i;
+  key.ul[3] = 0x1234UL;
+  return key;
+}
+
+static void
+token_acct( uchar               data[ 165 ],
+            fd_pubkey_t const * mint,
+            fd_pubkey_t const * owner,
+            ulong               amount,
+            fd_pubkey_t const * delegate ) {
+  fd_memset( data, 0, 165 );
+  memcpy( data,    mint,  32 );
+  memcpy( data+32, owner, 32 );
+  FD_STORE( ulong, data+64, amount );
+  if( delegate ) {
+    FD_STORE( uint, data+72, 1U );
+    memcpy( data+76, delegate, 32 );
+  }
+  data[ 108 ] = 1; /* initialized */
+}
+
+static ulong
+chain_cnt( fd_rpc_acct_index_t * index,
+           int                   by,
+           fd_pubkey_t const *   key ) {
+  ulong cnt = 0UL;
+  for( fd_rpc_acct_index_ele_t const * ele = fd_rpc_acct_index_first( index, by, key );
+       ele;
+       ele = fd_rpc_acct_index_next( index, by, ele ) ) cnt++;
+  return cnt;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  FD_TEST( !fd_rpc_acct_index_footprint( 0UL ) );
+  ulong footprint = fd_rpc_acct_index_footprint( ELE_MAX );
+  FD_TEST( footprint && footprint<=sizeof(index_mem) );
+
+  fd_rpc_acct_index_t * index = fd_rpc_acct_index_join( fd_rpc_acct_index_new( index_mem, ELE_MAX, 42UL ) );
+  FD_TEST( index );
+  FD_TEST( fd_rpc_acct_index_max( index )==ELE_MAX );
+  FD_TEST( fd_rpc_acct_index_cnt( index )==0UL );
+  FD_TEST( fd_rpc_acct_index_is_token_program( &token_id ) );
+
+  /* Plain program owned accounts */
+
+  fd_pubkey_t prog_a = test_key( 1000UL );
+  fd_pubkey_t prog_b = test_key( 1001UL );
+  uchar data[ 200 ] = {0};
+  for( ulong i=0UL; i<100UL; i++ ) {
+    fd_pubkey_t addr = test_key( i );
+    FD_TEST( fd_rpc_acct_index_update( index, &addr, (i&1UL) ? &prog_b : &prog_a, 1000UL+i, data, i, 1UL )==FD_RPC_ACCT_INDEX_SUCCESS );
+  }
+  FD_TEST( fd_rpc_acct_index_cnt( index )==100UL );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_OWNER, &prog_a )==50UL );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_OWNER, &prog_b )==50UL );
+
+  fd_pubkey_t addr = test_key( 7UL );
+  fd_rpc_acct_index_ele_t const * ele = fd_rpc_acct_index_query( index, &addr );
+  FD_TEST( ele && ele->lamports==1007UL && ele->data_sz==7UL && !ele->flags );
+
+  /* Owner change moves the account between chains, zero lamports
+     removes it */
+
+  FD_TEST( !fd_rpc_acct_index_update( index, &addr, &prog_a, 5UL, data, 7UL, 2UL ) );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_OWNER, &prog_a )==51UL );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_OWNER, &prog_b )==49UL );
+  FD_TEST( !fd_rpc_acct_index_update( index, &addr, &prog_a, 0UL, data, 7UL, 3UL ) );
+  FD_TEST( !fd_rpc_acct_index_query( index, &addr ) );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_OWNER, &prog_a )==50UL );
+  FD_TEST( fd_rpc_acct_index_cnt( index )==99UL );
+
+  /* Largest by lamports */
+
+  fd_rpc_acct_index_ele_t const * top[ 20 ];
+  FD_TEST( fd_rpc_acct_index_largest( index, FD_RPC_ACCT_INDEX_BY_ALL, NULL, top, 20UL )==20UL );
+  for( ulong i=0UL; i<20UL; i++ ) FD_TEST( top[ i ]->lamports==1099UL-i );
+  FD_TEST( fd_rpc_acct_index_largest( index, FD_RPC_ACCT_INDEX_BY_OWNER, &prog_a, top, 3UL )==3UL );
+  FD_TEST( top[ 0 ]->lamports==1098UL && top[ 1 ]->lamports==1096UL && top[ 2 ]->lamports==1094UL );
+
+  /* Token accounts */
+
+  fd_pubkey_t mint_a   = test_key( 2000UL );
+  fd_pubkey_t mint_b   = test_key( 2001UL );
+  fd_pubkey_t wallet_a = test_key( 3000UL );
+  fd_pubkey_t wallet_b = test_key( 3001UL );
+  fd_pubkey_t dlgt     = test_key( 4000UL );
+  uchar tok[ 165 ];
+  for( ulong i=0UL; i<40UL; i++ ) {
+    fd_pubkey_t acct = test_key( 500UL+i );
+    token_acct( tok, (i%4UL) ? &mint_a : &mint_b, (i&1UL) ? &wallet_b : &wallet_a, 10UL*i, (i%10UL) ? NULL : &dlgt );
+    FD_TEST( !fd_rpc_acct_index_update( index, &acct, &token_id, 2039280UL, tok, sizeof(tok), 4UL ) );
+  }
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_OWNER,       &token_id )==40UL );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_MINT,        &mint_a   )==30UL );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_MINT,        &mint_b   )==10UL );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_TOKEN_OWNER, &wallet_a )==20UL );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_TOKEN_OWNER, &wallet_b )==20UL );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_DELEGATE,    &dlgt     )==4UL  );
+
+  FD_TEST( fd_rpc_acct_index_largest( index, FD_RPC_ACCT_INDEX_BY_MINT, &mint_b, top, 20UL )==10UL );
+  FD_TEST( top[ 0 ]->amount==360UL && top[ 9 ]->amount==0UL );
+
+  /* Transfer ownership of a token account and revoke its delegate */
+
+  fd_pubkey_t acct = test_key( 500UL );
+  token_acct( tok, &mint_b, &wallet_b, 77UL, NULL );
+  FD_TEST( !fd_rpc_acct_index_update( index, &acct, &token_id, 2039280UL, tok, sizeof(tok), 5UL ) );
+  ele = fd_rpc_acct_index_query( index, &acct );
+  FD_TEST( ele->flags==FD_RPC_ACCT_INDEX_FLAG_TOKEN && ele->amount==77UL );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_TOKEN_OWNER, &wallet_a )==19UL );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_TOKEN_OWNER, &wallet_b )==21UL );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_DELEGATE,    &dlgt     )==3UL  );
+
+  /* Closing the account drops it from every chain */
+
+  FD_TEST( !fd_rpc_acct_index_update( index, &acct, &token_id, 0UL, tok, sizeof(tok), 6UL ) );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_MINT,        &mint_b   )==9UL  );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_TOKEN_OWNER, &wallet_b )==20UL );
+  FD_TEST( chain_cnt( index, FD_RPC_ACCT_INDEX_BY_OWNER,       &token_id )==39UL );
+
+  /* Mints */
+
+  uchar mint_data[ 82 ] = {0};
+  FD_STORE( ulong, mint_data+36, 123456UL );
+  mint_data[ 44 ] = 6;
+  mint_data[ 45 ] = 1;
+  FD_TEST( !fd_rpc_acct_index_update( index, &mint_a, &token_id, 1461600UL, mint_data, sizeof(mint_data), 7UL ) );
+  ele = fd_rpc_acct_index_query( index, &mint_a );
+  FD_TEST( ele->flags==FD_RPC_ACCT_INDEX_FLAG_MINT && ele->amount==123456UL && ele->decimals==6 );
+
+  /* Fill up */
+
+  ulong cnt = fd_rpc_acct_index_cnt( index );
+  for( ulong i=0UL; cnt<ELE_MAX; i++, cnt++ ) {
+    addr = test_key( 10000UL+i );
+    FD_TEST( !fd_rpc_acct_index_update( index, &addr, &prog_a, 1UL, data, 0UL, 8UL ) );
+  }
+  addr = test_key( 99999UL );
+  FD_TEST( fd_rpc_acct_index_update( index, &addr, &prog_a, 1UL, data, 0UL, 8UL )==FD_RPC_ACCT_INDEX_ERR_FULL );
+  FD_TEST( fd_rpc_acct_index_cnt( index )==ELE_MAX );
+
+  FD_TEST( fd_rpc_acct_index_delete( fd_rpc_acct_index_leave( index ) )==index_mem );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
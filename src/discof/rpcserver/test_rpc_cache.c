@@ -0,0 +1,96 @@
+#include "fd_rpc_cache.h"
+
+#define ENT_MAX (16UL)
+
+static uchar cache_mem[ 1UL<<14 ] __attribute__((aligned(128)));
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  FD_TEST( !fd_rpc_cache_footprint( 0UL  ) );
+  FD_TEST( !fd_rpc_cache_footprint( 12UL ) );
+  ulong footprint = fd_rpc_cache_footprint( ENT_MAX );
+  FD_TEST( footprint && footprint<=sizeof(cache_mem) );
+
+  fd_valloc_t valloc = fd_libc_alloc_virtual();
+  fd_rpc_cache_t * cache = fd_rpc_cache_join( fd_rpc_cache_new( cache_mem, ENT_MAX, 4096UL, valloc ) );
+  FD_TEST( cache );
+  fd_rpc_cache_metrics_t const * m = fd_rpc_cache_metrics( cache );
+
+  uchar key_a[ 8 ] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+  uchar key_b[ 8 ] = { 1, 2, 3, 4, 5, 6, 7, 9 };
+  static char const body[] = "{\"jsonrpc\":\"2.0\",\"result\":42,\"id\":";
+
+  FD_TEST( !fd_rpc_cache_query( cache, 10L, key_a, sizeof(key_a) ) );
+  FD_TEST( m->miss_cnt==1UL );
+
+  /* Volatile and immutable entries */
+
+  FD_TEST( fd_rpc_cache_insert( cache, 10L, key_a, sizeof(key_a), 0, body, sizeof(body)-1, "}\r\n" ) );
+  FD_TEST( fd_rpc_cache_insert( cache, 11L, key_a, sizeof(key_a), 1, body, sizeof(body)-1, "}"     ) );
+  FD_TEST( fd_rpc_cache_cnt( cache )==2UL );
+  FD_TEST( fd_rpc_cache_bytes( cache )==2UL*(sizeof(body)-1) );
+
+  fd_rpc_cache_ent_t const * ent = fd_rpc_cache_query( cache, 10L, key_a, sizeof(key_a) );
+  FD_TEST( ent && ent->body_sz==sizeof(body)-1 && !memcmp( ent->body, body, ent->body_sz ) && !strcmp( ent->tail, "}\r\n" ) );
+  FD_TEST( m->hit_cnt==1UL );
+  FD_TEST( !fd_rpc_cache_query( cache, 10L, key_b, sizeof(key_b) ) );
+  FD_TEST( !fd_rpc_cache_query( cache, 10L, key_a, 7UL ) );
+  FD_TEST( !fd_rpc_cache_query( cache, 12L, key_a, sizeof(key_a) ) );
+
+  fd_rpc_cache_invalidate( cache );
+  FD_TEST( !fd_rpc_cache_query( cache, 10L, key_a, sizeof(key_a) ) );
+  ent = fd_rpc_cache_query( cache, 11L, key_a, sizeof(key_a) );
+  FD_TEST( ent && !strcmp( ent->tail, "}" ) );
+  FD_TEST( fd_rpc_cache_cnt( cache )==1UL );
+  FD_TEST( m->invalidate_cnt==1UL );
+
+  /* Byte budget */
+
+  static char big[ 4096 ];
+  FD_TEST( !fd_rpc_cache_insert( cache, 13L, key_b, sizeof(key_b), 0, big, sizeof(big), "}" ) );
+  FD_TEST( m->skip_cnt==1UL );
+  FD_TEST( fd_rpc_cache_insert( cache, 13L, key_b, sizeof(key_b), 0, big, 1024UL, "}" ) );
+
+  /* Filling the table replaces entries */
+
+  for( ulong i=0UL; i<4UL*ENT_MAX; i++ ) {
+    uchar key[ 8 ]; FD_STORE( ulong, key, i );
+    FD_TEST( fd_rpc_cache_insert( cache, 14L, key, sizeof(key), 0, body, sizeof(body)-1, "}" ) );
+  }
+  FD_TEST( fd_rpc_cache_cnt( cache )<=ENT_MAX );
+  FD_TEST( m->evict_cnt>0UL );
+  FD_TEST( m->insert_cnt==3UL+4UL*ENT_MAX );
+
+  /* Invalidated entries are freed lazily, once their bytes are needed */
+
+  ulong bytes = fd_rpc_cache_bytes( cache );
+  ulong inval = m->invalidate_cnt;
+  fd_rpc_cache_invalidate( cache );
+  FD_TEST( fd_rpc_cache_bytes( cache )==bytes );
+  FD_TEST( fd_rpc_cache_insert( cache, 15L, key_a, sizeof(key_a), 1, big, 4096UL-64UL, "}" ) );
+  FD_TEST( fd_rpc_cache_cnt( cache )<=2UL );
+  FD_TEST( m->invalidate_cnt>inval );
+  for( ulong i=0UL; i<4UL*ENT_MAX; i++ ) {
+    uchar key[ 8 ]; FD_STORE( ulong, key, i );
+    FD_TEST( !fd_rpc_cache_query( cache, 14L, key, sizeof(key) ) );
+  }
+
+  /* Entries inserted after an invalidate survive until the next one */
+
+  fd_rpc_cache_invalidate( cache );
+  FD_TEST( fd_rpc_cache_insert( cache, 16L, key_b, sizeof(key_b), 0, body, sizeof(body)-1, "}" ) );
+  FD_TEST( fd_rpc_cache_query( cache, 16L, key_b, sizeof(key_b) ) );
+  fd_rpc_cache_invalidate( cache );
+  FD_TEST( !fd_rpc_cache_query( cache, 16L, key_b, sizeof(key_b) ) );
+  FD_TEST( fd_rpc_cache_query( cache, 15L, key_a, sizeof(key_a) ) );
+
+  FD_TEST( fd_rpc_cache_delete( fd_rpc_cache_leave( cache ) )==cache_mem );
+  FD_TEST( !fd_rpc_cache_join( cache_mem ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
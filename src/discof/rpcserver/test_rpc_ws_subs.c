@@ -0,0 +1,113 @@
+#include "fd_rpc_ws_subs.h"
+
+#define SUB_MAX (256UL)
+
+static uchar subs_mem[ 1UL<<18 ] __attribute__((aligned(128)));
+
+static fd_pubkey_t
+test_key( ulong i ) {
+  fd_pubkey_t key = {0};
+  key.ul[0] = i;
+  key.ul[2] = 0x5678UL;
+  return key;
+}
+
+static fd_rpc_ws_sub_t *
+add( fd_rpc_ws_subs_t * subs,
+     ulong              conn_id,
+     ulong              subsc_id,
+     ulong              acct,
+     int                kind ) {
+  fd_rpc_ws_sub_t * sub = fd_rpc_ws_subs_acquire( subs );
+  if( !sub ) return NULL;
+  sub->conn_id  = conn_id;
+  sub->subsc_id = subsc_id;
+  sub->acct     = test_key( acct );
+  fd_rpc_ws_subs_insert( subs, sub, kind );
+  return sub;
+}
+
+static ulong
+acct_cnt( fd_rpc_ws_subs_t * subs,
+          ulong              acct ) {
+  fd_pubkey_t key = test_key( acct );
+  ulong cnt = 0UL;
+  for( fd_rpc_ws_sub_t const * sub = fd_rpc_ws_subs_acct_first( subs, &key );
+       sub;
+       sub = fd_rpc_ws_subs_acct_next( subs, sub ) ) {
+    FD_TEST( !memcmp( &sub->acct, &key, sizeof(fd_pubkey_t) ) );
+    cnt++;
+  }
+  return cnt;
+}
+
+static ulong
+slot_cnt( fd_rpc_ws_subs_t * subs ) {
+  ulong cnt = 0UL;
+  for( fd_rpc_ws_sub_t const * sub = fd_rpc_ws_subs_slot_first( subs );
+       sub;
+       sub = fd_rpc_ws_subs_slot_next( subs, sub ) ) cnt++;
+  return cnt;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  FD_TEST( !fd_rpc_ws_subs_footprint( 0UL ) );
+  ulong footprint = fd_rpc_ws_subs_footprint( SUB_MAX );
+  FD_TEST( footprint && footprint<=sizeof(subs_mem) );
+
+  fd_rpc_ws_subs_t * subs = fd_rpc_ws_subs_join( fd_rpc_ws_subs_new( subs_mem, SUB_MAX, 7UL ) );
+  FD_TEST( subs );
+  FD_TEST( fd_rpc_ws_subs_max( subs )==SUB_MAX );
+  FD_TEST( !fd_rpc_ws_subs_cnt( subs ) );
+  FD_TEST( !fd_rpc_ws_subs_slot_first( subs ) );
+
+  /* 8 connections, each subscribed to accounts 0..3 (conn%4 of them
+     twice) and to slots */
+
+  ulong subsc_id = 0UL;
+  for( ulong conn=0UL; conn<8UL; conn++ ) {
+    for( ulong a=0UL; a<4UL; a++ ) FD_TEST( add( subs, conn, ++subsc_id, a, FD_RPC_WS_SUB_KIND_ACCT ) );
+    FD_TEST( add( subs, conn, ++subsc_id, conn%4UL, FD_RPC_WS_SUB_KIND_ACCT ) );
+    FD_TEST( add( subs, conn, ++subsc_id, 0UL,      FD_RPC_WS_SUB_KIND_SLOT ) );
+  }
+  FD_TEST( fd_rpc_ws_subs_cnt( subs )==48UL );
+  for( ulong a=0UL; a<4UL; a++ ) FD_TEST( acct_cnt( subs, a )==10UL );
+  FD_TEST( !acct_cnt( subs, 4UL ) );
+  FD_TEST( slot_cnt( subs )==8UL );
+
+  /* Closing a connection drops all of its subscriptions */
+
+  FD_TEST( fd_rpc_ws_subs_remove_conn( subs, 1UL )==6UL );
+  FD_TEST( !fd_rpc_ws_subs_remove_conn( subs, 1UL ) );
+  FD_TEST( !fd_rpc_ws_subs_remove_conn( subs, 99UL ) );
+  FD_TEST( fd_rpc_ws_subs_cnt( subs )==42UL );
+  FD_TEST( acct_cnt( subs, 0UL )== 9UL );
+  FD_TEST( acct_cnt( subs, 1UL )== 8UL );
+  FD_TEST( slot_cnt( subs )==7UL );
+
+  /* Fill up, released subscriptions are reusable */
+
+  while( add( subs, 100UL, ++subsc_id, 5UL, FD_RPC_WS_SUB_KIND_ACCT ) );
+  FD_TEST( fd_rpc_ws_subs_cnt( subs )==SUB_MAX );
+  FD_TEST( acct_cnt( subs, 5UL )==SUB_MAX-42UL );
+  fd_rpc_ws_sub_t * sub = NULL;
+  FD_TEST( !fd_rpc_ws_subs_acquire( subs ) );
+  FD_TEST( fd_rpc_ws_subs_remove_conn( subs, 100UL )==SUB_MAX-42UL );
+  FD_TEST( (sub = fd_rpc_ws_subs_acquire( subs )) );
+  fd_rpc_ws_subs_release( subs, sub );
+
+  for( ulong conn=0UL; conn<8UL; conn++ ) fd_rpc_ws_subs_remove_conn( subs, conn );
+  FD_TEST( !fd_rpc_ws_subs_cnt( subs ) );
+  FD_TEST( !slot_cnt( subs ) );
+  for( ulong a=0UL; a<4UL; a++ ) FD_TEST( !acct_cnt( subs, a ) );
+
+  FD_TEST( fd_rpc_ws_subs_delete( fd_rpc_ws_subs_leave( subs ) )==subs_mem );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
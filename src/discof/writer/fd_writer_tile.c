@@ -52,6 +52,10 @@ struct fd_writer_tile_ctx {
 
   /* Local joins of exec tile txn ctx.  Read-only. */
   fd_exec_txn_ctx_t *         txn_ctx[ FD_PACK_MAX_BANK_TILES ];
+
+  /* Local join of the accounts lthash delta, NULL if none.  This tile
+     owns shard tile_idx. */
+  fd_lthash_delta_t *         lthash_delta;
 };
 typedef struct fd_writer_tile_ctx fd_writer_tile_ctx_t;
 
@@ -179,8 +183,10 @@ during_frag( fd_writer_tile_ctx_t * ctx,
       FD_LOG_CRIT(( "exec_tile_id %u should be == in_idx %lu", msg->exec_tile_id, in_idx ));
     }
     fd_execute_txn_task_info_t info = {0};
-    info.txn_ctx  = ctx->txn_ctx[ in_idx ];
-    info.exec_res = info.txn_ctx->exec_err;
+    info.txn_ctx      = ctx->txn_ctx[ in_idx ];
+    info.exec_res     = info.txn_ctx->exec_err;
+    info.lthash_delta = ctx->lthash_delta;
+    info.lthash_shard = ctx->tile_idx;
 
     if( FD_LIKELY( info.txn_ctx->flags & FD_TXN_P_FLAGS_EXECUTE_SUCCESS ) ) {
       while( fd_writer_fseq_get_state( fd_fseq_query( ctx->fseq ) )!=FD_WRITER_STATE_READY ) {
@@ -188,9 +194,11 @@ during_frag( fd_writer_tile_ctx_t * ctx,
            done. */
         FD_SPIN_PAUSE();
       }
+      fd_funk_read_begin( ctx->funk );
       FD_SPAD_FRAME_BEGIN( ctx->spad ) {
         fd_runtime_finalize_txn( ctx->slot_ctx, NULL, &info, ctx->spad, ctx->wksp );
       } FD_SPAD_FRAME_END;
+      fd_funk_read_end( ctx->funk );
     }
     /* Notify the replay tile. */
     fd_fseq_update( ctx->fseq, fd_writer_fseq_set_txn_done( msg->txn_id, msg->exec_tile_id ) );
@@ -357,6 +365,21 @@ unprivileged_init( fd_topo_t *      topo,
   }
   FD_LOG_DEBUG(( "Just joined funk at file=%s", tile->writer.funk_file ));
 
+  /********************************************************************/
+  /* Accounts lthash delta                                            */
+  /********************************************************************/
+
+  ulong lthash_delta_obj_id = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "lthash_delta" );
+  if( FD_LIKELY( lthash_delta_obj_id!=ULONG_MAX ) ) {
+    ctx->lthash_delta = fd_lthash_delta_join( fd_topo_obj_laddr( topo, lthash_delta_obj_id ) );
+    if( FD_UNLIKELY( !ctx->lthash_delta ) ) {
+      FD_LOG_CRIT(( "Failed to join lthash delta" ));
+    }
+    if( FD_UNLIKELY( ctx->tile_idx>=fd_lthash_delta_shard_cnt( ctx->lthash_delta ) ) ) {
+      FD_LOG_CRIT(( "lthash delta has %lu shards but writer tile %lu needs one", fd_lthash_delta_shard_cnt( ctx->lthash_delta ), ctx->tile_idx ));
+    }
+  }
+
   /********************************************************************/
   /* Setup fseq                                                       */
   /********************************************************************/
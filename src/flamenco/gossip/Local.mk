@@ -1,7 +1,10 @@
 ifdef FD_HAS_HOSTED
 ifdef FD_HAS_INT128
-$(call add-hdrs,fd_gossip.h)
-$(call add-objs,fd_gossip,fd_flamenco)
+$(call add-hdrs,fd_gossip.h fd_crds_idx.h)
+$(call add-objs,fd_gossip fd_crds_idx,fd_flamenco)
+$(call make-unit-test,test_crds_idx,test_crds_idx,fd_flamenco fd_ballet fd_util)
+$(call make-unit-test,bench_crds_idx,bench_crds_idx,fd_flamenco fd_ballet fd_util)
+$(call run-unit-test,test_crds_idx)
 $(call make-bin,fd_gossip_spy,fd_gossip_spy,fd_flamenco fd_ballet fd_funk fd_util)
 endif
 endif
@@ -0,0 +1,158 @@
+/* bench_crds_idx measures the cost of selecting the values that match
+   the mask of a gossip pull request.  Compares the original scan of the
+   whole value table with the fd_crds_idx hash prefix index (plus the
+   scan of the unindexed tail).
+
+   The synthetic table has --vals values of --val-sz bytes with random
+   hashes, plus --tail values appended since the last index rebuild.
+   The mask_bits of the requests follow the mix seen on mainnet:
+   Agave peers split their filters by the size of their table (8 to 11
+   mask bits for a table of ~1M values), Firedancer peers use at most 5
+   mask bits and bootstrapping peers send few mask bits. */
+
+#include "fd_crds_idx.h"
+#include <stdlib.h>
+
+#define REQ_CNT (64UL)
+
+struct bench_val {
+  fd_hash_t key;
+  ulong     wallclock;
+};
+typedef struct bench_val bench_val_t;
+
+static uint
+bench_mask_bits( fd_rng_t * rng ) {
+  uint r = fd_rng_uint_roll( rng, 100U );
+  if( r< 5U ) return fd_rng_uint_roll( rng, 3U );      /* bootstrapping */
+  if( r<25U ) return 5U;                               /* Firedancer */
+  return 8U + fd_rng_uint_roll( rng, 4U );             /* Agave */
+}
+
+static inline bench_val_t const *
+val_at( uchar const * vals,
+        ulong         val_sz,
+        ulong         i ) {
+  return (bench_val_t const *)( vals + i*val_sz );
+}
+
+static inline int
+val_match( bench_val_t const * val,
+           ulong               mask,
+           uint                mask_bits,
+           ulong               expire ) {
+  if( val->wallclock<expire ) return 0;
+  if( mask_bits && (val->key.ul[0] | (~0UL>>mask_bits))!=mask ) return 0;
+  return 1;
+}
+
+__attribute__((noinline)) static ulong
+bench_scan( uchar const * vals,
+            ulong         val_sz,
+            ulong         val_cnt,
+            ulong const * mask,
+            uint const *  mask_bits,
+            ulong         expire ) {
+  ulong hit = 0UL;
+  for( ulong r=0UL; r<REQ_CNT; r++ ) {
+    for( ulong i=0UL; i<val_cnt; i++ ) hit += (ulong)val_match( val_at( vals, val_sz, i ), mask[ r ], mask_bits[ r ], expire );
+  }
+  return hit;
+}
+
+__attribute__((noinline)) static ulong
+bench_index( fd_crds_idx_t * idx,
+             uchar const *   vals,
+             ulong           val_sz,
+             ulong           val_cnt,
+             ulong const *   mask,
+             uint const *    mask_bits,
+             ulong           expire ) {
+  ulong hit = 0UL;
+  for( ulong r=0UL; r<REQ_CNT; r++ ) {
+    ulong idx_cnt = fd_crds_idx_update( idx, &val_at( vals, val_sz, 0UL )->key, val_sz, val_cnt );
+    ulong cand_cnt;
+    uint const * cand = fd_crds_idx_query( idx, mask[ r ], mask_bits[ r ], &cand_cnt );
+    for( ulong c=0UL; c<cand_cnt; c++ ) hit += (ulong)val_match( val_at( vals, val_sz, cand[ c ] ), mask[ r ], mask_bits[ r ], expire );
+    for( ulong i=idx_cnt; i<val_cnt; i++ ) hit += (ulong)val_match( val_at( vals, val_sz, i ), mask[ r ], mask_bits[ r ], expire );
+  }
+  return hit;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong base_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--vals",     NULL, 1000000UL );
+  ulong tail_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--tail",     NULL,    4096UL );
+  ulong val_sz   = fd_env_strip_cmdline_ulong( &argc, &argv, "--val-sz",   NULL,     256UL );
+  uint  rng_seed = fd_env_strip_cmdline_uint ( &argc, &argv, "--rng-seed", NULL,    1234U  );
+
+  ulong val_cnt = base_cnt + tail_cnt;
+  if( FD_UNLIKELY( !base_cnt || val_sz<sizeof(bench_val_t) || !fd_ulong_is_aligned( val_sz, 8UL ) ) ) FD_LOG_ERR(( "bad arguments" ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, rng_seed, 0UL ) );
+
+  /* 1/8 of the values are too old to be pulled */
+
+  ulong expire = 1000UL;
+  uchar * vals = aligned_alloc( 128UL, fd_ulong_align_up( val_cnt*val_sz, 128UL ) );
+  FD_TEST( vals );
+  for( ulong i=0UL; i<val_cnt; i++ ) {
+    bench_val_t * val = (bench_val_t *)( vals + i*val_sz );
+    for( ulong j=0UL; j<4UL; j++ ) val->key.ul[ j ] = fd_rng_ulong( rng );
+    val->wallclock = fd_rng_uint_roll( rng, 8U ) ? expire+i : expire-1UL;
+  }
+
+  ulong footprint = fd_crds_idx_footprint( val_cnt );
+  FD_TEST( footprint );
+  void * mem = aligned_alloc( fd_crds_idx_align(), footprint );
+  FD_TEST( mem );
+  fd_crds_idx_t * idx = fd_crds_idx_join( fd_crds_idx_new( mem, val_cnt ) );
+  FD_TEST( idx );
+
+  long dt = -fd_log_wallclock();
+  FD_TEST( fd_crds_idx_update( idx, &val_at( vals, val_sz, 0UL )->key, val_sz, base_cnt )==base_cnt );
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "rebuild of %lu values: %.1f ms", base_cnt, (double)dt*1e-6 ));
+
+  static ulong mask     [ REQ_CNT ];
+  static uint  mask_bits[ REQ_CNT ];
+  for( ulong r=0UL; r<REQ_CNT; r++ ) {
+    mask_bits[ r ] = bench_mask_bits( rng );
+    mask     [ r ] = fd_rng_ulong( rng ) | (mask_bits[ r ] ? (~0UL>>mask_bits[ r ]) : ~0UL);
+  }
+
+  FD_LOG_NOTICE(( "%lu indexed values, %lu in tail, %lu requests", base_cnt, tail_cnt, REQ_CNT ));
+
+  dt = -fd_log_wallclock();
+  ulong scan_hit = bench_scan( vals, val_sz, val_cnt, mask, mask_bits, expire );
+  dt += fd_log_wallclock();
+  double scan_ns = (double)dt/(double)REQ_CNT;
+  FD_LOG_NOTICE(( "full scan:   %10.1f us per request", scan_ns*1e-3 ));
+
+  dt = -fd_log_wallclock();
+  ulong index_hit = bench_index( idx, vals, val_sz, val_cnt, mask, mask_bits, expire );
+  dt += fd_log_wallclock();
+  double index_ns = (double)dt/(double)REQ_CNT;
+  FD_LOG_NOTICE(( "fd_crds_idx: %10.1f us per request", index_ns*1e-3 ));
+
+  FD_TEST( fd_crds_idx_cnt( idx )==base_cnt );
+  FD_TEST( index_hit==scan_hit );
+  FD_LOG_NOTICE(( "%lu values matched, speedup: %.1fx", scan_hit, scan_ns/index_ns ));
+
+  /* After a reset (compaction), the whole table is indexed again */
+
+  fd_crds_idx_reset( idx );
+  FD_TEST( !fd_crds_idx_cnt( idx ) );
+  FD_TEST( fd_crds_idx_update( idx, &val_at( vals, val_sz, 0UL )->key, val_sz, val_cnt )==val_cnt );
+  FD_TEST( bench_index( idx, vals, val_sz, val_cnt, mask, mask_bits, expire )==scan_hit );
+
+  free( fd_crds_idx_delete( fd_crds_idx_leave( idx ) ) );
+  free( vals );
+  fd_rng_delete( fd_rng_leave( rng ) );
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -0,0 +1,210 @@
+#include "fd_crds_idx.h"
+
+#define FD_CRDS_IDX_MAGIC (0xf17eda2ce7c2d500UL) /* firedancer crds idx version 0 */
+
+struct __attribute__((aligned(128UL))) fd_crds_idx {
+  ulong    magic;
+  ulong    val_max;
+  ulong    idx_cnt;      /* positions [0,idx_cnt) are indexed */
+  ushort * prefix;       /* prefix[i] is the top bits of the hash of value i, indexed by position */
+  uint   * pos;          /* positions of the indexed values, sorted by prefix */
+  uint     bkt[ FD_CRDS_IDX_BUCKET_CNT+1UL ]; /* bucket b is pos[bkt[b],bkt[b+1]) */
+};
+
+FD_FN_CONST ulong
+fd_crds_idx_align( void ) {
+  return alignof(fd_crds_idx_t);
+}
+
+FD_FN_CONST ulong
+fd_crds_idx_footprint( ulong val_max ) {
+  if( FD_UNLIKELY( !val_max || val_max>=(ulong)UINT_MAX ) ) return 0UL;
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, alignof(fd_crds_idx_t), sizeof(fd_crds_idx_t)  );
+  l = FD_LAYOUT_APPEND( l, alignof(ushort),        val_max*sizeof(ushort) );
+  l = FD_LAYOUT_APPEND( l, alignof(uint),          val_max*sizeof(uint)   );
+  return FD_LAYOUT_FINI( l, fd_crds_idx_align() );
+}
+
+void *
+fd_crds_idx_new( void * shmem,
+                 ulong  val_max ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_crds_idx_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned mem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_crds_idx_footprint( val_max ) ) ) {
+    FD_LOG_WARNING(( "bad val_max (%lu)", val_max ));
+    return NULL;
+  }
+
+  FD_SCRATCH_ALLOC_INIT( l, shmem );
+  fd_crds_idx_t * idx = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_crds_idx_t), sizeof(fd_crds_idx_t)  );
+  ushort *     prefix = FD_SCRATCH_ALLOC_APPEND( l, alignof(ushort),        val_max*sizeof(ushort) );
+  uint *          pos = FD_SCRATCH_ALLOC_APPEND( l, alignof(uint),          val_max*sizeof(uint)   );
+  FD_SCRATCH_ALLOC_FINI( l, fd_crds_idx_align() );
+
+  fd_memset( idx, 0, sizeof(fd_crds_idx_t) );
+  idx->val_max = val_max;
+  idx->idx_cnt = 0UL;
+  idx->prefix  = prefix;
+  idx->pos     = pos;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( idx->magic ) = FD_CRDS_IDX_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_crds_idx_t *
+fd_crds_idx_join( void * shidx ) {
+  fd_crds_idx_t * idx = (fd_crds_idx_t *)shidx;
+
+  if( FD_UNLIKELY( !idx ) ) {
+    FD_LOG_WARNING(( "NULL idx" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)idx, fd_crds_idx_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned idx" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( idx->magic!=FD_CRDS_IDX_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return idx;
+}
+
+void *
+fd_crds_idx_leave( fd_crds_idx_t * idx ) {
+
+  if( FD_UNLIKELY( !idx ) ) {
+    FD_LOG_WARNING(( "NULL idx" ));
+    return NULL;
+  }
+
+  return (void *)idx;
+}
+
+void *
+fd_crds_idx_delete( void * shidx ) {
+  fd_crds_idx_t * idx = (fd_crds_idx_t *)shidx;
+
+  if( FD_UNLIKELY( !idx ) ) {
+    FD_LOG_WARNING(( "NULL idx" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( idx->magic!=FD_CRDS_IDX_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( idx->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shidx;
+}
+
+void
+fd_crds_idx_reset( fd_crds_idx_t * idx ) {
+  /* Queries read the bucket bounds directly, stale ones would point at
+     positions that moved */
+  fd_memset( idx->bkt, 0, sizeof(idx->bkt) );
+  idx->idx_cnt = 0UL;
+}
+
+static inline ulong
+hash_prefix( fd_hash_t const * key ) {
+  return key->ul[0] >> (64-FD_CRDS_IDX_PREFIX_BITS);
+}
+
+/* rebuild counting sorts positions [0,cnt) by prefix */
+
+static void
+rebuild( fd_crds_idx_t * idx,
+         ulong           cnt ) {
+  ushort const * prefix = idx->prefix;
+  uint *         pos    = idx->pos;
+  uint *         bkt    = idx->bkt;
+
+  fd_memset( bkt, 0, sizeof(idx->bkt) );
+  for( ulong i=0UL; i<cnt; i++ ) bkt[ prefix[ i ]+1UL ]++;
+  for( ulong b=0UL; b<FD_CRDS_IDX_BUCKET_CNT; b++ ) bkt[ b+1UL ] += bkt[ b ];
+
+  /* bkt[b] is the start of bucket b.  Placing the values advances it
+     to the start of bucket b+1, shift back afterwards. */
+
+  for( ulong i=0UL; i<cnt; i++ ) pos[ bkt[ prefix[ i ] ]++ ] = (uint)i;
+  memmove( bkt+1, bkt, FD_CRDS_IDX_BUCKET_CNT*sizeof(uint) );
+  bkt[ 0 ] = 0U;
+
+  idx->idx_cnt = cnt;
+}
+
+ulong
+fd_crds_idx_update( fd_crds_idx_t *   idx,
+                    fd_hash_t const * key0,
+                    ulong             stride,
+                    ulong             val_cnt ) {
+  val_cnt = fd_ulong_min( val_cnt, idx->val_max );
+  ulong idx_cnt = idx->idx_cnt;
+
+  /* The table shrank without a compaction, the remaining values did
+     not move */
+
+  if( FD_UNLIKELY( val_cnt<idx_cnt ) ) {
+    rebuild( idx, val_cnt );
+    return val_cnt;
+  }
+
+  ulong tail_max = fd_ulong_max( FD_CRDS_IDX_TAIL_MIN, idx_cnt>>FD_CRDS_IDX_TAIL_SHIFT );
+  if( FD_LIKELY( val_cnt-idx_cnt<=tail_max ) ) return idx_cnt;
+
+  uchar const * key = (uchar const *)key0 + idx_cnt*stride;
+  for( ulong i=idx_cnt; i<val_cnt; i++, key+=stride ) {
+    idx->prefix[ i ] = (ushort)hash_prefix( (fd_hash_t const *)key );
+  }
+  rebuild( idx, val_cnt );
+  return val_cnt;
+}
+
+FD_FN_PURE ulong
+fd_crds_idx_cnt( fd_crds_idx_t const * idx ) {
+  return idx->idx_cnt;
+}
+
+uint const *
+fd_crds_idx_query( fd_crds_idx_t const * idx,
+                   ulong                 mask,
+                   uint                  mask_bits,
+                   ulong *               cnt ) {
+  if( !mask_bits ) {
+    *cnt = idx->idx_cnt;
+    return idx->pos;
+  }
+
+  ulong b    = mask >> (64-FD_CRDS_IDX_PREFIX_BITS);
+  ulong span = 1UL;
+  if( mask_bits<FD_CRDS_IDX_PREFIX_BITS ) {
+    span = 1UL<<(FD_CRDS_IDX_PREFIX_BITS-mask_bits);
+    b   &= ~(span-1UL);
+  }
+
+  uint lo = idx->bkt[ b      ];
+  uint hi = idx->bkt[ b+span ];
+  *cnt = (ulong)( hi-lo );
+  return idx->pos + lo;
+}
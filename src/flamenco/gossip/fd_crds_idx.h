@@ -0,0 +1,111 @@
+#ifndef HEADER_fd_src_flamenco_gossip_fd_crds_idx_h
+#define HEADER_fd_src_flamenco_gossip_fd_crds_idx_h
+
+/* fd_crds_idx indexes the gossip value table by the top bits of the
+   value hashes so that a pull request only has to visit the values in
+   its partition of the hash space.
+
+   A pull request carries a mask and a mask_bits count and is only
+   interested in values whose hash (first 8 bytes, as a little endian
+   ulong) has the same top mask_bits bits as the mask.  The index keeps
+   the positions of the values in the table bucketed (counting sorted)
+   by the top FD_CRDS_IDX_PREFIX_BITS bits of the hash.  A request with
+   mask_bits<=FD_CRDS_IDX_PREFIX_BITS maps to a contiguous range of
+   buckets that holds exactly the matching values.  A request with more
+   mask bits maps to a single bucket, a superset of the matching values.
+
+   The index does not own the value table.  It covers a prefix of the
+   table positions; values appended since the last rebuild (the tail)
+   are not indexed and have to be scanned by the caller.  The table is
+   assumed to only grow at the end, except for compactions, after which
+   the caller must call fd_crds_idx_reset.  fd_crds_idx_update rebuilds
+   the index once the tail is large relative to the indexed part, so
+   that the cost of a rebuild is amortized over the appended values and
+   the tail stays short.
+
+   The index keeps a copy of the hash prefix of every value, so a
+   rebuild reads the hash of each value in the table only once (when it
+   first joins the index). */
+
+#include "../types/fd_types_custom.h"
+
+#define FD_CRDS_IDX_PREFIX_BITS (16)
+#define FD_CRDS_IDX_BUCKET_CNT  (1UL<<FD_CRDS_IDX_PREFIX_BITS)
+
+/* FD_CRDS_IDX_TAIL_{MIN,SHIFT} determine when update rebuilds: when
+   the tail has more than max(FD_CRDS_IDX_TAIL_MIN,idx_cnt>>FD_CRDS_IDX_TAIL_SHIFT)
+   values. */
+
+#define FD_CRDS_IDX_TAIL_MIN   (256UL)
+#define FD_CRDS_IDX_TAIL_SHIFT (5)
+
+struct fd_crds_idx;
+typedef struct fd_crds_idx fd_crds_idx_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_crds_idx_{align,footprint} return the required alignment and
+   footprint of a memory region suitable for use as an index of a
+   table of at most val_max values.  val_max must be in (0,UINT_MAX).
+   footprint returns 0 if val_max is invalid. */
+
+FD_FN_CONST ulong
+fd_crds_idx_align( void );
+
+FD_FN_CONST ulong
+fd_crds_idx_footprint( ulong val_max );
+
+void *
+fd_crds_idx_new( void * shmem,
+                 ulong  val_max );
+
+fd_crds_idx_t *
+fd_crds_idx_join( void * shidx );
+
+void *
+fd_crds_idx_leave( fd_crds_idx_t * idx );
+
+void *
+fd_crds_idx_delete( void * shidx );
+
+/* fd_crds_idx_reset drops all indexed values.  Must be called whenever
+   values move within the table. */
+
+void
+fd_crds_idx_reset( fd_crds_idx_t * idx );
+
+/* fd_crds_idx_update brings the index up to date with a table of
+   val_cnt values.  The hash of the value at position i is at
+   (fd_hash_t const *)((uchar const *)key0 + i*stride).  Values at
+   positions already seen are assumed unchanged.  Rebuilds if the tail
+   would be too long.  Returns the number of indexed values (the
+   caller scans positions [fd_crds_idx_cnt(idx),val_cnt)). */
+
+ulong
+fd_crds_idx_update( fd_crds_idx_t *   idx,
+                    fd_hash_t const * key0,
+                    ulong             stride,
+                    ulong             val_cnt );
+
+/* fd_crds_idx_cnt returns the number of indexed values (positions
+   [0,cnt) of the table). */
+
+FD_FN_PURE ulong
+fd_crds_idx_cnt( fd_crds_idx_t const * idx );
+
+/* fd_crds_idx_query returns the positions of the indexed values that
+   can match a pull request with the given mask and mask_bits.  On
+   return, *cnt holds the number of positions.  If mask_bits is at most
+   FD_CRDS_IDX_PREFIX_BITS, these are exactly the matching indexed
+   values; otherwise the caller still has to check the mask.  The
+   returned array is valid until the next update or reset. */
+
+uint const *
+fd_crds_idx_query( fd_crds_idx_t const * idx,
+                   ulong                 mask,
+                   uint                  mask_bits,
+                   ulong *               cnt );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_gossip_fd_crds_idx_h */
@@ -1,4 +1,5 @@
 #include "fd_gossip.h"
+#include "fd_crds_idx.h"
 #include "../../ballet/base58/fd_base58.h"
 #include "../../disco/keyguard/fd_keyguard.h"
 #include <math.h>
@@ -63,6 +64,10 @@
    TODO: formally verify this */
 #define FD_GOSSIP_DECODE_BUFFER_MAX (1 << 16) /* 64k */
 
+/* The decode spad holds the decoded messages of a whole receive batch,
+   and the values being verified (see fd_gossip_recv_packet_batch). */
+#define FD_GOSSIP_RECV_SPAD_MAX (FD_GOSSIP_RECV_BATCH_MAX*FD_GOSSIP_DECODE_BUFFER_MAX + FD_ED25519_VERIFY_BATCH_MAX*sizeof(fd_value_t) + 128UL)
+
 /* Loose estimate of the maximum number of CRDS values a
    push/pullresp message can hold. For static allocation
    purposes. Derived by taking total packet size (1232b)
@@ -497,6 +502,7 @@ struct fd_gossip {
     /* Table of crds metadata, keyed by hash of the encoded data */
     fd_value_meta_t * value_metas;
     fd_value_t * values; /* Vector of full values */
+    fd_crds_idx_t * value_idx; /* Hash prefix index of values, used to answer pull requests */
     /* The last timestamp that we pushed our own contact info */
     long last_contact_time;
     fd_hash_t last_contact_info_v2_key;
@@ -553,12 +559,13 @@ FD_FN_CONST ulong
 fd_gossip_footprint( void ) {
   ulong l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, alignof(fd_gossip_t), sizeof(fd_gossip_t) );
-  l = FD_LAYOUT_APPEND( l, fd_spad_align(), fd_spad_footprint( FD_GOSSIP_DECODE_BUFFER_MAX ) );
+  l = FD_LAYOUT_APPEND( l, fd_spad_align(), fd_spad_footprint( FD_GOSSIP_RECV_SPAD_MAX ) );
   l = FD_LAYOUT_APPEND( l, fd_peer_table_align(), fd_peer_table_footprint(FD_PEER_KEY_MAX) );
   l = FD_LAYOUT_APPEND( l, fd_active_table_align(), fd_active_table_footprint(FD_ACTIVE_KEY_MAX) );
   l = FD_LAYOUT_APPEND( l, alignof(fd_gossip_peer_addr_t), INACTIVES_MAX*sizeof(fd_gossip_peer_addr_t) );
   l = FD_LAYOUT_APPEND( l, fd_value_meta_map_align(), fd_value_meta_map_footprint( FD_VALUE_KEY_MAX ) );
   l = FD_LAYOUT_APPEND( l, fd_value_vec_align(), fd_value_vec_footprint( FD_VALUE_DATA_MAX ) );
+  l = FD_LAYOUT_APPEND( l, fd_crds_idx_align(), fd_crds_idx_footprint( FD_VALUE_DATA_MAX ) );
   l = FD_LAYOUT_APPEND( l, fd_pending_heap_align(), fd_pending_heap_footprint(FD_PENDING_MAX) );
   l = FD_LAYOUT_APPEND( l, fd_stats_table_align(), fd_stats_table_footprint(FD_STATS_KEY_MAX) );
   l = FD_LAYOUT_APPEND( l, fd_weights_table_align(), fd_weights_table_footprint(MAX_STAKE_WEIGHTS) );
@@ -574,8 +581,8 @@ fd_gossip_new ( void * shmem, ulong seed ) {
   fd_memset(glob, 0, sizeof(fd_gossip_t));
   glob->seed = seed;
 
-  void * spad_mem = FD_SCRATCH_ALLOC_APPEND( l, fd_spad_align(), fd_spad_footprint( FD_GOSSIP_DECODE_BUFFER_MAX ) );
-  glob->decode_spad = fd_spad_join( fd_spad_new( spad_mem, FD_GOSSIP_DECODE_BUFFER_MAX ) );
+  void * spad_mem = FD_SCRATCH_ALLOC_APPEND( l, fd_spad_align(), fd_spad_footprint( FD_GOSSIP_RECV_SPAD_MAX ) );
+  glob->decode_spad = fd_spad_join( fd_spad_new( spad_mem, FD_GOSSIP_RECV_SPAD_MAX ) );
 
   void * shm = FD_SCRATCH_ALLOC_APPEND(l, fd_peer_table_align(), fd_peer_table_footprint(FD_PEER_KEY_MAX));
   glob->peers = fd_peer_table_join(fd_peer_table_new(shm, FD_PEER_KEY_MAX, seed));
@@ -592,6 +599,9 @@ fd_gossip_new ( void * shmem, ulong seed ) {
   glob->values = fd_value_vec_join( fd_value_vec_new( shm, FD_VALUE_DATA_MAX ) );
   glob->need_push_head = 0; // point to start of values
 
+  shm = FD_SCRATCH_ALLOC_APPEND( l, fd_crds_idx_align(), fd_crds_idx_footprint( FD_VALUE_DATA_MAX ) );
+  glob->value_idx = fd_crds_idx_join( fd_crds_idx_new( shm, FD_VALUE_DATA_MAX ) );
+
   glob->last_contact_time = 0;
 
   shm = FD_SCRATCH_ALLOC_APPEND(l, fd_pending_heap_align(), fd_pending_heap_footprint(FD_PENDING_MAX));
@@ -628,6 +638,7 @@ fd_gossip_delete ( void * shmap ) {
 
   fd_value_meta_map_delete( fd_value_meta_map_leave( glob->value_metas ) );
   fd_value_vec_delete( fd_value_vec_leave( glob->values ) );
+  fd_crds_idx_delete( fd_crds_idx_leave( glob->value_idx ) );
   fd_pending_heap_delete( fd_pending_heap_leave( glob->event_heap ) );
   fd_stats_table_delete( fd_stats_table_leave( glob->stats ) );
   fd_weights_table_delete( fd_weights_table_leave( glob->weights ) );
@@ -1073,16 +1084,25 @@ fd_gossip_make_ping( fd_gossip_t * glob, fd_pending_event_arg_t * arg ) {
   fd_gossip_send( glob, key, &gmsg );
 }
 
+/* Signature states of the signed parts of a received message, see
+   fd_gossip_recv_packet_batch.  Unchecked signatures are verified
+   inline when the message is processed. */
+#define FD_GOSSIP_SIG_UNCHECKED (0)
+#define FD_GOSSIP_SIG_VALID     (1)
+#define FD_GOSSIP_SIG_INVALID   (2)
+
 /* Respond to a ping from another validator */
 static void
-fd_gossip_handle_ping( fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_gossip_ping_t const * ping ) {
+fd_gossip_handle_ping( fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_gossip_ping_t const * ping, uchar sig_state ) {
   /* Verify the signature */
   fd_sha512_t sha2[1];
-  if (fd_ed25519_verify( /* msg */ ping->token.uc,
+  if( sig_state==FD_GOSSIP_SIG_UNCHECKED ?
+      fd_ed25519_verify( /* msg */ ping->token.uc,
                          /* sz */ 32UL,
                          /* sig */ ping->signature.uc,
                          /* public_key */ ping->from.uc,
-                         sha2 )) {
+                         sha2 ) :
+      sig_state==FD_GOSSIP_SIG_INVALID ) {
     glob->metrics.recv_ping_invalid_signature += 1UL;
     FD_LOG_WARNING(("received ping with invalid signature"));
     return;
@@ -1407,7 +1427,7 @@ fd_gossip_random_pull( fd_gossip_t * glob, fd_pending_event_arg_t * arg ) {
 
 /* Handle a pong response */
 static void
-fd_gossip_handle_pong( fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_gossip_ping_t const * pong ) {
+fd_gossip_handle_pong( fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_gossip_ping_t const * pong, uchar sig_state ) {
 #define INC_RECV_PONG_EVENT_CNT( REASON ) glob->metrics.recv_pong_events[ FD_CONCAT3( FD_METRICS_ENUM_RECV_PONG_EVENT_V_,  REASON, _IDX ) ] += 1UL
   fd_active_elem_t * val = fd_active_table_query(glob->actives, from, NULL);
   if (val == NULL) {
@@ -1440,11 +1460,13 @@ fd_gossip_handle_pong( fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, f
 
   /* Verify the signature */
   fd_sha512_t sha2[1];
-  if (fd_ed25519_verify( /* msg */ pong->token.uc,
+  if( sig_state==FD_GOSSIP_SIG_UNCHECKED ?
+      fd_ed25519_verify( /* msg */ pong->token.uc,
                          /* sz */ 32UL,
                          /* sig */ pong->signature.uc,
                          /* public_key */ pong->from.uc,
-                         sha2 )) {
+                         sha2 ) :
+      sig_state==FD_GOSSIP_SIG_INVALID ) {
     INC_RECV_PONG_EVENT_CNT( INVALID_SIGNATURE );
     FD_LOG_WARNING(("received pong with invalid signature"));
     return;
@@ -1593,7 +1615,7 @@ fd_crds_sigverify( uchar * crds_encoded_val, ulong crds_encoded_len, fd_pubkey_t
    This only fails on a crds value encode failure, which is impossible if
    the value was derived from a gossip message decode. */
 static void
-fd_gossip_recv_crds_array( fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_crds_value_t * crds, ulong crds_len, fd_gossip_crds_route_t route ) {
+fd_gossip_recv_crds_array( fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_crds_value_t * crds, ulong crds_len, fd_gossip_crds_route_t route, uchar const * sig_state ) {
   /* Sanity check */
   if( FD_UNLIKELY( crds_len > FD_GOSSIP_MAX_CRDS_VALS ) ) {
     FD_LOG_ERR(( "too many CRDS values, max %u vs %lu received", FD_GOSSIP_MAX_CRDS_VALS, crds_len ));
@@ -1650,7 +1672,9 @@ fd_gossip_recv_crds_array( fd_gossip_t * glob, const fd_gossip_peer_addr_t * fro
           traffic (~50%)
         - will be deprecated soon */
     if( crd->data.discriminant!=fd_crds_data_enum_epoch_slots &&
-        fd_crds_sigverify( val->data, val->datalen, &val->origin ) ) {
+        ( sig_state[ i ]==FD_GOSSIP_SIG_UNCHECKED ?
+          fd_crds_sigverify( val->data, val->datalen, &val->origin ) :
+          sig_state[ i ]==FD_GOSSIP_SIG_INVALID ) ) {
       INC_RECV_CRDS_DROP_METRIC( INVALID_SIGNATURE );
       /* drop full packet on bad signature
           https://github.com/anza-xyz/agave/commit/d68b5de6c0fc07d60cf9749ae82c2651a549e81b */
@@ -1923,8 +1947,16 @@ fd_gossip_handle_pull_req(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from
   ulong hits = 0;
   ulong misses = 0;
   uint npackets = 0;
-  for( ulong i = 0UL; i < fd_value_vec_cnt( glob->values ); ++i ) {
-    fd_value_t * ele = &glob->values[ i ];
+
+  /* Only visit the values in the requested partition of the hash
+     space: the indexed values with a matching hash prefix, followed by
+     the values appended since the index was last rebuilt */
+  ulong val_cnt = fd_value_vec_cnt( glob->values );
+  ulong idx_cnt = fd_crds_idx_update( glob->value_idx, &glob->values[0].key, sizeof(fd_value_t), val_cnt );
+  ulong cand_cnt;
+  uint const * cand = fd_crds_idx_query( glob->value_idx, filter->mask, filter->mask_bits, &cand_cnt );
+  for( ulong c = 0UL; c < cand_cnt + (val_cnt - idx_cnt); ++c ) {
+    fd_value_t * ele = &glob->values[ c < cand_cnt ? cand[ c ] : idx_cnt + (c - cand_cnt) ];
     fd_hash_t * hash = &(ele->key);
     if (ele->wallclock < expire)
       continue;
@@ -1993,7 +2025,7 @@ fd_gossip_handle_pull_req(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from
 
 /* Handle any gossip message */
 static void
-fd_gossip_recv(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_gossip_msg_t * gmsg) {
+fd_gossip_recv(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_gossip_msg_t * gmsg, uchar const * sig_state) {
   if ( FD_LIKELY( gmsg->discriminant < FD_METRICS_COUNTER_GOSSIP_RECEIVED_GOSSIP_MESSAGES_CNT ) ) {
     glob->metrics.recv_message[gmsg->discriminant] += 1UL;
   } else {
@@ -2005,22 +2037,22 @@ fd_gossip_recv(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_gossip
     break;
   case fd_gossip_msg_enum_pull_resp: {
     fd_gossip_pull_resp_t * pull_resp = &gmsg->inner.pull_resp;
-    fd_gossip_recv_crds_array( glob, NULL, pull_resp->crds, pull_resp->crds_len, FD_GOSSIP_CRDS_ROUTE_PULL_RESP );
+    fd_gossip_recv_crds_array( glob, NULL, pull_resp->crds, pull_resp->crds_len, FD_GOSSIP_CRDS_ROUTE_PULL_RESP, sig_state );
     break;
   }
   case fd_gossip_msg_enum_push_msg: {
     fd_gossip_push_msg_t * push_msg = &gmsg->inner.push_msg;
-    fd_gossip_recv_crds_array( glob, from, push_msg->crds, push_msg->crds_len, FD_GOSSIP_CRDS_ROUTE_PUSH );
+    fd_gossip_recv_crds_array( glob, from, push_msg->crds, push_msg->crds_len, FD_GOSSIP_CRDS_ROUTE_PUSH, sig_state );
     break;
   }
   case fd_gossip_msg_enum_prune_msg:
     fd_gossip_handle_prune(glob, from, &gmsg->inner.prune_msg);
     break;
   case fd_gossip_msg_enum_ping:
-    fd_gossip_handle_ping(glob, from, &gmsg->inner.ping);
+    fd_gossip_handle_ping(glob, from, &gmsg->inner.ping, sig_state[0]);
     break;
   case fd_gossip_msg_enum_pong:
-    fd_gossip_handle_pong(glob, from, &gmsg->inner.pong);
+    fd_gossip_handle_pong(glob, from, &gmsg->inner.pong, sig_state[0]);
     break;
   }
 }
@@ -2471,6 +2503,8 @@ fd_gossip_compact_values( fd_gossip_t * glob ) {
 
   glob->need_push_head -= fd_ulong_if( push_head_snapshot != ULONG_MAX, push_head_snapshot, num_deleted );
   fd_value_vec_contract( glob->values, num_deleted );
+  /* Values moved, the pull request index is rebuilt on demand */
+  if( num_deleted ) fd_crds_idx_reset( glob->value_idx );
   glob->metrics.value_vec_cnt = fd_value_vec_cnt( glob->values );
   FD_LOG_INFO(( "GOSSIP compacted %lu values", num_deleted ));
   return num_deleted;
@@ -2551,42 +2585,166 @@ fd_gossip_continue( fd_gossip_t * glob ) {
   return 0;
 }
 
-/* Pass a raw gossip packet into the protocol. msg_name is the unix socket address of the sender */
-int
-fd_gossip_recv_packet( fd_gossip_t * glob, uchar const * msg, ulong msglen, fd_gossip_peer_addr_t const * from ) {
+/* Batched signature verification of received packets.  The signed
+   parts of the decoded messages of a batch are collected into groups
+   of FD_ED25519_VERIFY_BATCH_MAX signatures, which are verified
+   together with fd_ed25519_verify_batch_multi_msg.  The results are
+   recorded in the signature state of each part and picked up when the
+   message is processed. */
+
+struct fd_gossip_verify_batch {
+  ulong         cnt;
+  uchar const * msg   [ FD_ED25519_VERIFY_BATCH_MAX ];
+  ulong         msg_sz[ FD_ED25519_VERIFY_BATCH_MAX ];
+  uchar const * sig   [ FD_ED25519_VERIFY_BATCH_MAX ];
+  uchar const * pubkey[ FD_ED25519_VERIFY_BATCH_MAX ];
+  uchar *       state [ FD_ED25519_VERIFY_BATCH_MAX ];
+  fd_value_t *  vals; /* Encoded CRDS values being verified, indexed like the above */
+};
+typedef struct fd_gossip_verify_batch fd_gossip_verify_batch_t;
+
+static void
+fd_gossip_verify_batch_flush( fd_gossip_t * glob, fd_gossip_verify_batch_t * batch ) {
+  if( !batch->cnt ) return;
+  int errs[ FD_ED25519_VERIFY_BATCH_MAX ];
+  fd_ed25519_verify_batch_multi_msg( batch->msg, batch->msg_sz, batch->sig, batch->pubkey, errs, batch->cnt );
+  for( ulong i = 0UL; i < batch->cnt; ++i ) {
+    int ok = errs[ i ]==FD_ED25519_SUCCESS;
+    *batch->state[ i ] = ok ? FD_GOSSIP_SIG_VALID : FD_GOSSIP_SIG_INVALID;
+    glob->metrics.recv_verify_fail_cnt += (ulong)!ok;
+  }
+  glob->metrics.recv_verify_batch_cnt++;
+  glob->metrics.recv_verify_sig_cnt += batch->cnt;
+  batch->cnt = 0UL;
+}
+
+static void
+fd_gossip_verify_batch_add( fd_gossip_t *              glob,
+                            fd_gossip_verify_batch_t * batch,
+                            uchar const *              msg,
+                            ulong                      msg_sz,
+                            uchar const *              sig,
+                            uchar const *              pubkey,
+                            uchar *                    state ) {
+  ulong i = batch->cnt++;
+  batch->msg   [ i ] = msg;
+  batch->msg_sz[ i ] = msg_sz;
+  batch->sig   [ i ] = sig;
+  batch->pubkey[ i ] = pubkey;
+  batch->state [ i ] = state;
+  if( batch->cnt==FD_ED25519_VERIFY_BATCH_MAX ) fd_gossip_verify_batch_flush( glob, batch );
+}
+
+/* fd_gossip_verify_prepare adds the signatures of a decoded message
+   that processing would verify to the batch.  CRDS values that are
+   dropped before verification (duplicates, own values, epoch slots)
+   are skipped.  This has no side effects on the gossip state, the
+   dedup statistics and metrics are updated by processing. */
+static void
+fd_gossip_verify_prepare( fd_gossip_t *                 glob,
+                          fd_gossip_verify_batch_t *    batch,
+                          fd_gossip_peer_addr_t const * from,
+                          fd_gossip_msg_t const *       gmsg,
+                          uchar *                       sig_state ) {
+  fd_crds_value_t * crds     = NULL;
+  ulong             crds_len = 0UL;
+  switch( gmsg->discriminant ) {
+  case fd_gossip_msg_enum_pull_resp:
+    crds     = gmsg->inner.pull_resp.crds;
+    crds_len = gmsg->inner.pull_resp.crds_len;
+    break;
+  case fd_gossip_msg_enum_push_msg:
+    crds     = gmsg->inner.push_msg.crds;
+    crds_len = gmsg->inner.push_msg.crds_len;
+    break;
+  case fd_gossip_msg_enum_ping: {
+    fd_gossip_ping_t const * ping = &gmsg->inner.ping;
+    fd_gossip_verify_batch_add( glob, batch, ping->token.uc, 32UL, ping->signature.uc, ping->from.uc, sig_state );
+    return;
+  }
+  case fd_gossip_msg_enum_pong: {
+    fd_gossip_ping_t const * pong = &gmsg->inner.pong;
+    if( fd_active_table_query( glob->actives, from, NULL )==NULL ) return;
+    fd_gossip_verify_batch_add( glob, batch, pong->token.uc, 32UL, pong->signature.uc, pong->from.uc, sig_state );
+    return;
+  }
+  default:
+    return;
+  }
+
+  if( FD_UNLIKELY( crds_len > FD_GOSSIP_MAX_CRDS_VALS ) ) return;
+  for( ulong i = 0UL; i < crds_len; ++i ) {
+    fd_crds_value_t * crd = &crds[ i ];
+    if( crd->data.discriminant==fd_crds_data_enum_epoch_slots ) continue;
+    fd_value_t * val = &batch->vals[ batch->cnt ];
+    if( FD_UNLIKELY( fd_value_from_crds( val, crd ) ) ) continue;
+    if( memcmp( val->origin.uc, glob->public_key->uc, 32U )==0 ) continue;
+    if( fd_value_meta_map_query( glob->value_metas, &val->key, NULL )!=NULL ) continue;
+    fd_gossip_verify_batch_add( glob, batch,
+                                val->data + sizeof(fd_signature_t), val->datalen - sizeof(fd_signature_t),
+                                val->data, val->origin.uc, &sig_state[ i ] );
+  }
+}
+
+ulong
+fd_gossip_recv_packet_batch( fd_gossip_t * glob, fd_gossip_recv_pkt_t const * pkts, ulong pkt_cnt ) {
+  if( FD_UNLIKELY( pkt_cnt > FD_GOSSIP_RECV_BATCH_MAX ) ) {
+    FD_LOG_ERR(( "too many packets in batch, max %lu vs %lu", FD_GOSSIP_RECV_BATCH_MAX, pkt_cnt ));
+  }
+
+  ulong bad_cnt = 0UL;
   fd_gossip_lock( glob );
   FD_SPAD_FRAME_BEGIN( glob->decode_spad ) {
-    glob->recv_pkt_cnt++;
-    glob->metrics.recv_pkt_cnt++;
-
-    ulong decoded_sz;
-    fd_gossip_msg_t * gmsg = fd_bincode_decode1_spad(
-        gossip_msg,
-        glob->decode_spad,
-        msg, msglen,
-        NULL,
-        &decoded_sz );
-    if( FD_UNLIKELY( !gmsg ) ) {
-      glob->metrics.recv_pkt_corrupted_msg += 1UL;
-      FD_LOG_WARNING(( "corrupt gossip message" ));
-      fd_gossip_unlock( glob );
-      return -1;
+    fd_gossip_msg_t * gmsgs[ FD_GOSSIP_RECV_BATCH_MAX ];
+    uchar sig_state[ FD_GOSSIP_RECV_BATCH_MAX ][ FD_GOSSIP_MAX_CRDS_VALS ];
+    fd_memset( sig_state, FD_GOSSIP_SIG_UNCHECKED, sizeof(sig_state) );
+
+    fd_gossip_verify_batch_t batch[1];
+    batch->cnt  = 0UL;
+    batch->vals = fd_spad_alloc( glob->decode_spad, alignof(fd_value_t), FD_ED25519_VERIFY_BATCH_MAX*sizeof(fd_value_t) );
+
+    /* Decode all packets and verify their signatures */
+    for( ulong p = 0UL; p < pkt_cnt; ++p ) {
+      fd_gossip_recv_pkt_t const * pkt = &pkts[ p ];
+      glob->recv_pkt_cnt++;
+      glob->metrics.recv_pkt_cnt++;
+
+      ulong decoded_sz;
+      fd_gossip_msg_t * gmsg = fd_bincode_decode1_spad(
+          gossip_msg,
+          glob->decode_spad,
+          pkt->data, pkt->data_sz,
+          NULL,
+          &decoded_sz );
+      if( FD_UNLIKELY( !gmsg || decoded_sz != pkt->data_sz ) ) {
+        glob->metrics.recv_pkt_corrupted_msg += 1UL;
+        FD_LOG_WARNING(( "corrupt gossip message" ));
+        gmsgs[ p ] = NULL;
+        bad_cnt++;
+        continue;
+      }
+      gmsgs[ p ] = gmsg;
+      fd_gossip_verify_prepare( glob, batch, &pkt->from, gmsg, sig_state[ p ] );
     }
-
-    if( FD_UNLIKELY( decoded_sz != msglen ) ) {
-      glob->metrics.recv_pkt_corrupted_msg += 1UL;
-      FD_LOG_WARNING(( "corrupt gossip message" ));
-      fd_gossip_unlock( glob );
-      return -1;
+    fd_gossip_verify_batch_flush( glob, batch );
+
+    /* Process them in order */
+    for( ulong p = 0UL; p < pkt_cnt; ++p ) {
+      if( FD_UNLIKELY( !gmsgs[ p ] ) ) continue;
+      FD_LOG_DEBUG(( "recv msg type %u from " GOSSIP_ADDR_FMT,
+                     gmsgs[ p ]->discriminant, GOSSIP_ADDR_FMT_ARGS( pkts[ p ].from ) ));
+      fd_gossip_recv( glob, &pkts[ p ].from, gmsgs[ p ], sig_state[ p ] );
     }
-
-    FD_LOG_DEBUG(( "recv msg type %u from " GOSSIP_ADDR_FMT,
-                   gmsg->discriminant, GOSSIP_ADDR_FMT_ARGS( *from ) ));
-    fd_gossip_recv( glob, from, gmsg );
-
-    fd_gossip_unlock( glob );
   } FD_SPAD_FRAME_END;
-  return 0;
+  fd_gossip_unlock( glob );
+  return bad_cnt;
+}
+
+/* Pass a raw gossip packet into the protocol. msg_name is the unix socket address of the sender */
+int
+fd_gossip_recv_packet( fd_gossip_t * glob, uchar const * msg, ulong msglen, fd_gossip_peer_addr_t const * from ) {
+  fd_gossip_recv_pkt_t pkt = { .data = msg, .data_sz = msglen, .from = *from };
+  return fd_gossip_recv_packet_batch( glob, &pkt, 1UL ) ? -1 : 0;
 }
 
 ushort
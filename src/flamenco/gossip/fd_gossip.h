@@ -139,6 +139,23 @@ int fd_gossip_continue( fd_gossip_t * glob );
 /* Pass a raw gossip packet into the protocol. addr is the address of the sender */
 int fd_gossip_recv_packet( fd_gossip_t * glob, uchar const * msg, ulong msglen, fd_gossip_peer_addr_t const * addr );
 
+/* Max number of packets passed to fd_gossip_recv_packet_batch */
+#define FD_GOSSIP_RECV_BATCH_MAX (16UL)
+
+struct fd_gossip_recv_pkt {
+  uchar const *         data;
+  ulong                 data_sz;
+  fd_gossip_peer_addr_t from;
+};
+typedef struct fd_gossip_recv_pkt fd_gossip_recv_pkt_t;
+
+/* Pass pkt_cnt (at most FD_GOSSIP_RECV_BATCH_MAX) raw gossip packets
+   into the protocol.  Same as calling fd_gossip_recv_packet for each
+   packet in order, except that the signatures of the CRDS values,
+   pings and pongs of the whole batch are verified together before the
+   packets are processed.  Returns the number of corrupt packets. */
+ulong fd_gossip_recv_packet_batch( fd_gossip_t * glob, fd_gossip_recv_pkt_t const * pkts, ulong pkt_cnt );
+
 const char * fd_gossip_addr_str( char * dst, ulong dstlen, fd_gossip_peer_addr_t const * src );
 
 ushort fd_gossip_get_shred_version( fd_gossip_t const * glob );
@@ -211,6 +228,11 @@ struct fd_gossip_metrics {
 
   ulong recv_pong_events[FD_METRICS_COUNTER_GOSSIP_RECV_PONG_EVENT_CNT];
 
+  /* Batched signature verification of received packets */
+  ulong recv_verify_batch_cnt;
+  ulong recv_verify_sig_cnt;
+  ulong recv_verify_fail_cnt;
+
   /* Peers (all known validators) */
   ulong gossip_peer_cnt[FD_METRICS_GAUGE_GOSSIP_GOSSIP_PEER_COUNTS_CNT];
   /* TODO: Lock metrics */
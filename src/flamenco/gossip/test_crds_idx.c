@@ -0,0 +1,165 @@
+#include "fd_crds_idx.h"
+
+#define VAL_MAX (8192UL)
+
+struct test_val {
+  fd_hash_t key;
+  ulong     pad;
+};
+typedef struct test_val test_val_t;
+
+static test_val_t vals[ VAL_MAX ];
+static uchar      seen[ VAL_MAX ];
+static uchar      idx_mem[ 1UL<<20 ] __attribute__((aligned(128)));
+
+static int
+key_match( fd_hash_t const * key,
+           ulong             mask,
+           uint              mask_bits ) {
+  return !mask_bits || (key->ul[0] | (~0UL>>mask_bits))==mask;
+}
+
+/* check_query compares the index against a brute force scan of the
+   indexed positions [0,fd_crds_idx_cnt(idx)) for one request. */
+
+static void
+check_query( fd_crds_idx_t const * idx,
+             ulong                 mask,
+             uint                  mask_bits ) {
+  ulong idx_cnt = fd_crds_idx_cnt( idx );
+
+  ulong cnt;
+  uint const * pos = fd_crds_idx_query( idx, mask, mask_bits, &cnt );
+  FD_TEST( cnt<=idx_cnt );
+
+  fd_memset( seen, 0, idx_cnt );
+  ulong hit = 0UL;
+  for( ulong i=0UL; i<cnt; i++ ) {
+    FD_TEST( pos[ i ]<idx_cnt );
+    FD_TEST( !seen[ pos[ i ] ] );
+    seen[ pos[ i ] ] = 1;
+    fd_hash_t const * key = &vals[ pos[ i ] ].key;
+    if( mask_bits<=FD_CRDS_IDX_PREFIX_BITS ) {
+      /* exact */
+      FD_TEST( key_match( key, mask, mask_bits ) );
+    } else {
+      /* superset, but within the bucket of the mask */
+      FD_TEST( (key->ul[0]>>(64-FD_CRDS_IDX_PREFIX_BITS))==(mask>>(64-FD_CRDS_IDX_PREFIX_BITS)) );
+    }
+    hit += (ulong)key_match( key, mask, mask_bits );
+  }
+
+  ulong expected = 0UL;
+  for( ulong i=0UL; i<idx_cnt; i++ ) {
+    int match = key_match( &vals[ i ].key, mask, mask_bits );
+    if( match ) FD_TEST( seen[ i ] );
+    expected += (ulong)match;
+  }
+  FD_TEST( hit==expected );
+}
+
+static void
+check_all( fd_crds_idx_t const * idx,
+           ulong                 val_cnt,
+           fd_rng_t *            rng ) {
+  static uint const bits[] = { 0U, 1U, 3U, 8U, 15U, 16U, 17U, 20U, 32U, 63U };
+  for( ulong b=0UL; b<sizeof(bits)/sizeof(bits[0]); b++ ) {
+    uint mask_bits = bits[ b ];
+    for( ulong r=0UL; r<32UL; r++ ) {
+      /* Half the requests are centered on an existing value so that
+         long masks have hits too */
+      ulong base = fd_rng_uint_roll( rng, 2U ) ? vals[ fd_rng_ulong_roll( rng, val_cnt ) ].key.ul[0] : fd_rng_ulong( rng );
+      ulong mask = base | (mask_bits ? (~0UL>>mask_bits) : ~0UL);
+      check_query( idx, mask, mask_bits );
+    }
+  }
+}
+
+static void
+fill( ulong      lo,
+      ulong      hi,
+      fd_rng_t * rng ) {
+  for( ulong i=lo; i<hi; i++ ) {
+    for( ulong j=0UL; j<4UL; j++ ) vals[ i ].key.ul[ j ] = fd_rng_ulong( rng );
+    /* A quarter of the values share a few 20 bit prefixes, so buckets
+       have several values and long masks split buckets */
+    if( !fd_rng_uint_roll( rng, 4U ) ) {
+      vals[ i ].key.ul[0] = (vals[ i ].key.ul[0]>>20) | ((ulong)fd_rng_uint_roll( rng, 4U )<<62) | (0xABCUL<<50);
+    }
+  }
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 1234U, 0UL ) );
+
+  FD_TEST( !fd_crds_idx_footprint( 0UL ) );
+  FD_TEST( fd_crds_idx_footprint( VAL_MAX )<=sizeof(idx_mem) );
+  fd_crds_idx_t * idx = fd_crds_idx_join( fd_crds_idx_new( idx_mem, VAL_MAX ) );
+  FD_TEST( idx );
+  FD_TEST( !fd_crds_idx_cnt( idx ) );
+
+  ulong stride = sizeof(test_val_t);
+  ulong n      = 6000UL;
+  fill( 0UL, VAL_MAX, rng );
+
+  /* Empty index, everything is tail */
+  check_query( idx, ~0UL, 0U );
+
+  /* Initial build */
+  FD_TEST( fd_crds_idx_update( idx, &vals[0].key, stride, n )==n );
+  FD_TEST( fd_crds_idx_cnt( idx )==n );
+  check_all( idx, n, rng );
+
+  /* Tail rebuild threshold: the tail may hold up to
+     max(FD_CRDS_IDX_TAIL_MIN,n>>FD_CRDS_IDX_TAIL_SHIFT) values */
+  ulong tail_max = fd_ulong_max( FD_CRDS_IDX_TAIL_MIN, n>>FD_CRDS_IDX_TAIL_SHIFT );
+  FD_TEST( fd_crds_idx_update( idx, &vals[0].key, stride, n+1UL      )==n );
+  FD_TEST( fd_crds_idx_update( idx, &vals[0].key, stride, n+tail_max )==n );
+  FD_TEST( fd_crds_idx_cnt( idx )==n );
+  check_all( idx, n, rng ); /* tail values are not returned */
+  FD_TEST( fd_crds_idx_update( idx, &vals[0].key, stride, n+tail_max+1UL )==n+tail_max+1UL );
+  n += tail_max+1UL;
+  FD_TEST( fd_crds_idx_cnt( idx )==n );
+  check_all( idx, n, rng );
+
+  /* Capped at val_max */
+  FD_TEST( fd_crds_idx_update( idx, &vals[0].key, stride, VAL_MAX+100UL )==VAL_MAX );
+  n = VAL_MAX;
+  check_all( idx, n, rng );
+
+  /* Shrink without compaction: the remaining values did not move */
+  n = 3000UL;
+  FD_TEST( fd_crds_idx_update( idx, &vals[0].key, stride, n )==n );
+  FD_TEST( fd_crds_idx_cnt( idx )==n );
+  check_all( idx, n, rng );
+
+  /* Compaction: values move, the index is reset and rebuilt from the
+     new table */
+  fill( 0UL, VAL_MAX, rng );
+  fd_crds_idx_reset( idx );
+  FD_TEST( !fd_crds_idx_cnt( idx ) );
+  ulong cnt;
+  fd_crds_idx_query( idx, ~0UL, 0U, &cnt );
+  FD_TEST( !cnt );
+  check_all( idx, n, rng );
+  FD_TEST( fd_crds_idx_update( idx, &vals[0].key, stride, n )==n );
+  check_all( idx, n, rng );
+
+  /* Small table, below FD_CRDS_IDX_TAIL_MIN: the whole table stays in
+     the tail until it grows past it */
+  fd_crds_idx_reset( idx );
+  FD_TEST( !fd_crds_idx_update( idx, &vals[0].key, stride, FD_CRDS_IDX_TAIL_MIN ) );
+  FD_TEST( fd_crds_idx_update( idx, &vals[0].key, stride, FD_CRDS_IDX_TAIL_MIN+1UL )==FD_CRDS_IDX_TAIL_MIN+1UL );
+  check_all( idx, FD_CRDS_IDX_TAIL_MIN+1UL, rng );
+
+  FD_TEST( fd_crds_idx_delete( fd_crds_idx_leave( idx ) )==idx_mem );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -21,12 +21,20 @@ $(call add-objs,fd_executor,fd_flamenco)
 $(call add-hdrs,fd_hashes.h)
 $(call add-objs,fd_hashes,fd_flamenco)
 
+$(call add-hdrs,fd_lthash_delta.h)
+$(call add-objs,fd_lthash_delta,fd_flamenco)
+
 $(call add-hdrs,fd_pubkey_utils.h)
 $(call add-objs,fd_pubkey_utils,fd_flamenco)
 
 $(call add-hdrs,fd_txncache.h)
 $(call add-objs,fd_txncache,fd_flamenco)
 
+$(call add-hdrs,fd_progcache.h)
+$(call add-objs,fd_progcache,fd_flamenco)
+$(call make-unit-test,test_progcache,test_progcache,fd_flamenco fd_ballet fd_util)
+$(call run-unit-test,test_progcache,)
+
 $(call add-hdrs,fd_cost_tracker.h)
 $(call add-objs,fd_cost_tracker,fd_flamenco)
 
@@ -42,6 +50,8 @@ $(call make-unit-test,test_txncache,test_txncache,fd_flamenco fd_ballet fd_util)
 
 ifdef FD_HAS_SECP256K1
 $(call make-unit-test,test_txn_rw_conflicts,test_txn_rw_conflicts,fd_flamenco fd_funk fd_ballet fd_util, $(SECP256K1_LIBS))
+$(call make-unit-test,test_lthash_delta,test_lthash_delta,fd_flamenco fd_funk fd_ballet fd_util, $(SECP256K1_LIBS))
+$(call run-unit-test,test_lthash_delta,)
 endif
 
 ifdef FD_HAS_ATOMIC
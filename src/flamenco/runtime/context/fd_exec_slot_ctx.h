@@ -9,6 +9,8 @@
 #include "../sysvar/fd_sysvar_cache.h"
 #include "../../types/fd_types.h"
 #include "../fd_txncache.h"
+#include "../fd_progcache.h"
+#include "../fd_lthash_delta.h"
 
 /* fd_exec_slot_ctx_t is the context that stays constant during all
    transactions in a block. */
@@ -47,6 +49,8 @@ struct __attribute__((aligned(8UL))) fd_exec_slot_ctx {
   fd_sysvar_cache_t *         sysvar_cache;
 
   fd_txncache_t *             status_cache;
+  fd_progcache_t *            progcache; /* Cache of validated programs shared across forks, NULL if disabled */
+  fd_lthash_delta_t *         lthash_delta; /* Accounts lthash change accumulated during txn finalization, NULL if disabled */
   fd_slot_history_global_t *  slot_history;
 
   int                         enable_exec_recording; /* Enable/disable execution metadata
@@ -19,6 +19,9 @@ fd_exec_txn_ctx_new( void * mem ) {
 
   fd_exec_txn_ctx_t * self = (fd_exec_txn_ctx_t *) mem;
 
+  self->vm_prof = NULL;
+  self->vm_jit  = NULL;
+
   FD_COMPILER_MFENCE();
   self->magic = FD_EXEC_TXN_CTX_MAGIC;
   FD_COMPILER_MFENCE();
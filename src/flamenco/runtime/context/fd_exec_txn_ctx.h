@@ -10,6 +10,12 @@
 #include "../fd_txncache.h"
 #include "../fd_bank_hash_cmp.h"
 
+/* Avoid circular include dependency with forward declaration */
+struct fd_vm_prof;
+typedef struct fd_vm_prof fd_vm_prof_t;
+struct fd_vm_jit_cache_private;
+typedef struct fd_vm_jit_cache_private fd_vm_jit_cache_t;
+
 /* Return data for syscalls */
 
 struct fd_txn_return_data {
@@ -137,6 +143,10 @@ struct __attribute__((aligned(8UL))) fd_exec_txn_ctx {
 
   fd_capture_ctx_t * capture_ctx;
 
+  fd_vm_prof_t * vm_prof; /* If non-NULL, sBPF program execution is sampled into this profile.  Persists across transactions. */
+
+  fd_vm_jit_cache_t * vm_jit; /* If non-NULL, sBPF programs are compiled into and run from this cache (x86 only).  Persists across transactions. */
+
   /* The instr_infos for the entire transaction are allocated at the start of
      the transaction. However, this must preserve a different counter because
      the top level instructions must get set up at once. The instruction
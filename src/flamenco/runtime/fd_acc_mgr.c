@@ -88,6 +88,10 @@ fd_funk_get_acc_meta_mutable( fd_funk_t *             funk,
         FD_LOG_ERR(( "fd_funk_rec_write_prepare(%s) failed (%i-%s)", FD_BASE58_ENC_32_ALLOCA( pubkey->key ), funk_err, fd_funk_strerror( funk_err ) ));
       }
     }
+  } else if( FD_UNLIKELY( rec->flags & FD_ACC_REC_FLAG_LTHASH ) ) {
+    /* The record is about to be modified in place, so the lthash change
+       accumulated when it was saved no longer holds. */
+    rec->flags = ( rec->flags & ~FD_ACC_REC_FLAG_LTHASH ) | FD_ACC_REC_FLAG_LTHASH_STALE;
   }
 
   ulong sz = sizeof(fd_account_meta_t)+min_data_sz;
@@ -34,6 +34,17 @@
 
 #define FD_ACC_NONCE_TOT_SZ_MAX (FD_ACC_NONCE_SZ_MAX + sizeof(fd_account_meta_t))
 
+/* FD_ACC_REC_FLAG_{LTHASH,LTHASH_STALE} are funk record flags (see
+   FD_FUNK_REC_FLAG_*) of account records in an in-preparation funk
+   transaction.  LTHASH indicates the lthash change of the account in
+   this funk transaction has been accumulated into an fd_lthash_delta_t
+   (see fd_account_save_lthash).  LTHASH_STALE indicates the record was
+   modified in place after that, so the accumulated change is wrong.
+   fd_funk_get_acc_meta_mutable turns LTHASH into LTHASH_STALE. */
+
+#define FD_ACC_REC_FLAG_LTHASH       (1UL<<1)
+#define FD_ACC_REC_FLAG_LTHASH_STALE (1UL<<2)
+
 FD_PROTOTYPES_BEGIN
 
 /* Account Management APIs **************************************************/
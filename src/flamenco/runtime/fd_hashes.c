@@ -314,8 +314,13 @@ fd_account_hash( fd_funk_t *                    funk,
     return;
   }
 
+  /* The lthash change of accounts saved by transactions has already
+     been accumulated (see fd_account_save_lthash) */
+
+  int lthash_done = !!task_info->lthash_done;
+
   fd_account_meta_t const * acc_meta_parent = NULL;
-  if( txn_out ) {
+  if( txn_out && !lthash_done ) {
     fd_funk_txn_pool_t * txn_pool = fd_funk_txn_pool( funk );
     txn_out = fd_funk_txn_parent( txn_out, txn_pool );
     acc_meta_parent = fd_funk_get_acc_meta_readonly( funk, txn_out, task_info->acc_pubkey, NULL, &err, NULL );
@@ -343,13 +348,13 @@ fd_account_hash( fd_funk_t *                    funk,
                              acc_meta,
                              task_info->acc_pubkey,
                              acc_data,
-                             FD_HASH_BOTH_HASHES,
+                             lthash_done ? FD_HASH_JUST_ACCOUNT_HASH : FD_HASH_BOTH_HASHES,
                              features );
 
     if( memcmp( task_info->acc_hash->hash, acc_meta->hash, sizeof(fd_hash_t) ) != 0 ) {
       task_info->hash_changed = 1;
       // char *prev_lthash = FD_LTHASH_ENC_32_ALLOCA( lt_hash );
-      fd_lthash_add( lt_hash, &new_lthash_value);
+      if( FD_LIKELY( !lthash_done ) ) fd_lthash_add( lt_hash, &new_lthash_value);
       // FD_LOG_NOTICE(( "lthash %s + %s = %s (%s)", prev_lthash, FD_LTHASH_ENC_32_ALLOCA( &new_lthash_value ), FD_LTHASH_ENC_32_ALLOCA( lt_hash ),
       //    FD_BASE58_ENC_32_ALLOCA( task_info->acc_pubkey )));
     }
@@ -407,6 +412,83 @@ fd_account_hash_task( void * tpool,
   }
 }
 
+/* fd_account_lthash computes the lthash of an account value as it is
+   accumulated into the accounts lthash, i.e. zero if the account does
+   not exist or has no lamports. */
+
+static void
+fd_account_lthash( fd_lthash_value_t *       lthash,
+                   fd_account_meta_t const * meta,
+                   uchar const *             data,
+                   fd_pubkey_t const *       pubkey ) {
+  if( !meta || !meta->info.lamports ) {
+    fd_lthash_zero( lthash );
+    return;
+  }
+  fd_hash_t hash[1];
+  fd_hash_account( hash->hash, lthash, meta, pubkey, data, FD_HASH_JUST_LTHASH, NULL );
+}
+
+int
+fd_account_save_lthash( fd_txn_account_t *  acct,
+                        fd_funk_t *         funk,
+                        fd_funk_txn_t *     txn,
+                        fd_wksp_t *         acc_data_wksp,
+                        fd_lthash_delta_t * delta,
+                        ulong               shard_idx ) {
+  if( !delta || !txn ||
+      FD_UNLIKELY( shard_idx>=fd_lthash_delta_shard_cnt( delta ) || !fd_lthash_delta_is_tracking( delta, &txn->xid ) ) ) {
+    return fd_txn_account_save( acct, funk, txn, acc_data_wksp );
+  }
+
+  fd_pubkey_t const * pubkey = acct->pubkey;
+  fd_wksp_t *         wksp   = fd_funk_wksp( funk );
+
+  /* The change is relative to the value at the start of the slot.  If
+     the account was already saved by a transaction of this slot, that
+     save accounted for the change up to the current value.  If it was
+     only written by the slot itself (e.g. sysvars or rewards at the
+     start of the slot), it was not accounted for yet, so rebase on the
+     value in the parent funk transaction.  If an accounted value was
+     modified in place since, the change can't be tracked anymore. */
+
+  fd_funk_rec_key_t     key = fd_funk_acc_key( pubkey );
+  fd_funk_rec_query_t   query[1];
+  fd_funk_rec_t const * cur   = fd_funk_rec_query_try( funk, txn, &key, query );
+  ulong                 flags = cur ? cur->flags : 0UL;
+
+  if( FD_UNLIKELY( flags & FD_ACC_REC_FLAG_LTHASH_STALE ) ) {
+    int err = fd_txn_account_save( acct, funk, txn, acc_data_wksp );
+    if( FD_LIKELY( !err ) ) acct->private_state.rec->flags |= FD_ACC_REC_FLAG_LTHASH_STALE;
+    return err;
+  }
+
+  fd_lthash_value_t old_lthash[1];
+  if( flags & FD_ACC_REC_FLAG_LTHASH ) {
+    fd_account_meta_t const * meta = fd_funk_val_const( cur, wksp );
+    fd_account_lthash( old_lthash, meta, fd_account_meta_get_data_const( meta ), pubkey );
+  } else {
+    int                       err  = FD_ACC_MGR_SUCCESS;
+    fd_funk_txn_t const *     par  = fd_funk_txn_parent( txn, fd_funk_txn_pool( funk ) );
+    fd_account_meta_t const * meta = fd_funk_get_acc_meta_readonly( funk, par, pubkey, NULL, &err, NULL );
+    if( err!=FD_ACC_MGR_SUCCESS ) meta = NULL;
+    fd_account_lthash( old_lthash, meta, meta ? fd_account_meta_get_data_const( meta ) : NULL, pubkey );
+  }
+
+  int err = fd_txn_account_save( acct, funk, txn, acc_data_wksp );
+  if( FD_UNLIKELY( err ) ) return err;
+
+  fd_lthash_value_t new_lthash[1];
+  fd_account_lthash( new_lthash, acct->private_state.const_meta, acct->private_state.const_data, pubkey );
+
+  fd_lthash_value_t * bucket = fd_lthash_delta_bucket( delta, shard_idx, fd_lthash_delta_bucket_idx( pubkey ) );
+  fd_lthash_add( bucket, new_lthash );
+  fd_lthash_sub( bucket, old_lthash );
+
+  acct->private_state.rec->flags |= FD_ACC_REC_FLAG_LTHASH;
+  return FD_ACC_MGR_SUCCESS;
+}
+
 void
 fd_collect_modified_accounts( fd_exec_slot_ctx_t *           slot_ctx,
                               fd_accounts_hash_task_data_t * task_data,
@@ -414,7 +496,11 @@ fd_collect_modified_accounts( fd_exec_slot_ctx_t *           slot_ctx,
   fd_funk_t *     funk = slot_ctx->funk;
   fd_funk_txn_t * txn  = slot_ctx->funk_txn;
 
-  ulong rec_cnt = 0;
+  fd_lthash_delta_t * delta    = slot_ctx->lthash_delta;
+  int                 tracking = delta && txn && fd_lthash_delta_is_tracking( delta, &txn->xid );
+
+  ulong rec_cnt    = 0;
+  ulong stale_mask = 0UL;
   for( fd_funk_rec_t const * rec = fd_funk_txn_first_rec( funk, txn );
        NULL != rec;
        rec = fd_funk_txn_next_rec( funk, rec ) ) {
@@ -428,9 +514,15 @@ fd_collect_modified_accounts( fd_exec_slot_ctx_t *           slot_ctx,
     if (((pubkey->ul[0] == 0) & (pubkey->ul[1] == 0) & (pubkey->ul[2] == 0) & (pubkey->ul[3] == 0)))
       FD_LOG_WARNING(( "null pubkey (system program?) showed up as modified" ));
 
+    if( FD_UNLIKELY( rec->flags & FD_ACC_REC_FLAG_LTHASH_STALE ) ) {
+      stale_mask |= 1UL<<fd_lthash_delta_bucket_idx( fd_type_pun_const( pubkey->uc ) );
+    }
+
     rec_cnt++;
   }
 
+  task_data->lthash_stale_mask = stale_mask;
+
   task_data->info    = fd_spad_alloc( runtime_spad, alignof(fd_accounts_hash_task_info_t), rec_cnt * sizeof(fd_accounts_hash_task_info_t) );
   task_data->info_sz = rec_cnt;
 
@@ -449,6 +541,9 @@ fd_collect_modified_accounts( fd_exec_slot_ctx_t *           slot_ctx,
     task_info->slot_ctx     = slot_ctx;
     task_info->hash_changed = 0;
     task_info->should_erase = 0;
+    task_info->lthash_done  = (uint)( tracking &&
+                                      !!( rec->flags & FD_ACC_REC_FLAG_LTHASH ) &&
+                                      !fd_ulong_extract_bit( stale_mask, (int)fd_lthash_delta_bucket_idx( task_info->acc_pubkey ) ) );
   }
 
   if( FD_UNLIKELY( recs_iterated!=task_data->info_sz ) ) {
@@ -477,6 +572,13 @@ fd_update_hash_bank_exec_hash( fd_exec_slot_ctx_t *           slot_ctx,
     fd_lthash_add( lt_hash, &lt_hashes[i] );
   }
 
+  // Apply the lthash changes accumulated while finalizing transactions
+  if( slot_ctx->lthash_delta && txn ) {
+    ulong stale_mask = 0UL;
+    for( ulong j=0UL; j<task_datas_cnt; j++ ) stale_mask |= task_datas[j].lthash_stale_mask;
+    fd_lthash_delta_merge( slot_ctx->lthash_delta, &txn->xid, stale_mask, lt_hash );
+  }
+
   for( ulong j=0UL; j<task_datas_cnt; j++ ) {
 
     fd_accounts_hash_task_data_t * task_data = &task_datas[j];
@@ -718,6 +820,57 @@ fd_hash_account_current( uchar                     hash[ static 32 ],
   return fd_hash_account( hash, lthash, account, pubkey, data, hash_needed, features );
 }
 
+/* fd_hash_account_batch_t accumulates the lthash of many accounts into
+   an lthash value, hashing up to FD_LTHASH_BATCH_MAX accounts at a time
+   (see fd_lthash_batch_add).  Accounts whose lthash input does not fit
+   in a single blake3 chunk are hashed immediately. */
+
+#define FD_HASH_ACCOUNT_BATCH_MSG_MAX (1024UL)
+
+struct fd_hash_account_batch {
+  fd_lthash_value_t * accum;
+  ulong               cnt;
+  void const *        msg   [ FD_LTHASH_BATCH_MAX ];
+  ulong               msg_sz[ FD_LTHASH_BATCH_MAX ];
+  uchar               msg_mem[ FD_LTHASH_BATCH_MAX ][ FD_HASH_ACCOUNT_BATCH_MSG_MAX ];
+};
+typedef struct fd_hash_account_batch fd_hash_account_batch_t;
+
+static void
+fd_hash_account_batch_flush( fd_hash_account_batch_t * batch ) {
+  fd_lthash_batch_add( batch->accum, batch->msg, batch->msg_sz, batch->cnt );
+  batch->cnt = 0UL;
+}
+
+static void
+fd_hash_account_batch_add( fd_hash_account_batch_t * batch,
+                           fd_account_meta_t const * m,
+                           fd_pubkey_t const *       pubkey,
+                           uchar const *             data,
+                           fd_features_t *           features ) {
+  ulong sz = sizeof(ulong) + m->dlen + 1UL + 32UL + 32UL;
+  if( FD_UNLIKELY( sz>FD_HASH_ACCOUNT_BATCH_MSG_MAX ) ) {
+    uchar             hash[ 32 ];
+    fd_lthash_value_t lthash[1];
+    fd_hash_account( hash, lthash, m, pubkey, data, FD_HASH_JUST_LTHASH, features );
+    fd_lthash_add( batch->accum, lthash );
+    return;
+  }
+
+  /* Same layout as the lthash input of fd_hash_account */
+
+  uchar * p = batch->msg_mem[ batch->cnt ];
+  batch->msg   [ batch->cnt ] = p;
+  batch->msg_sz[ batch->cnt ] = sz;
+  FD_STORE( ulong, p, m->info.lamports );            p += sizeof(ulong);
+  fd_memcpy( p, data, m->dlen );                     p += m->dlen;
+  *p = (uchar)( m->info.executable & 0x1 );          p += 1UL;
+  fd_memcpy( p, m->info.owner, 32UL );               p += 32UL;
+  fd_memcpy( p, pubkey, 32UL );
+
+  if( ++batch->cnt==FD_LTHASH_BATCH_MAX ) fd_hash_account_batch_flush( batch );
+}
+
 struct accounts_hash {
   fd_funk_rec_t * key;
   ulong  hash;
@@ -805,6 +958,10 @@ fd_accounts_sorted_subrange_gather( fd_funk_t *             funk,
 
   fd_lthash_value_t accum = {0};
 
+  fd_hash_account_batch_t batch[1];
+  batch->accum = &accum;
+  batch->cnt   = 0UL;
+
   fd_funk_all_iter_t iter[1];
   for( fd_funk_all_iter_new( funk, iter );
        !fd_funk_all_iter_done( iter );
@@ -828,10 +985,9 @@ fd_accounts_sorted_subrange_gather( fd_funk_t *             funk,
 
     /* FIXME: remove magic number */
     uchar hash[32];
-    fd_lthash_value_t new_lthash_value = {0};
 
-    fd_hash_account_current( (uchar *)hash, &new_lthash_value, metadata, fd_type_pun_const(rec->pair.key->uc), fd_account_meta_get_data( metadata ), FD_HASH_BOTH_HASHES, features  );
-    fd_lthash_add( &accum, &new_lthash_value );
+    fd_hash_account_current( (uchar *)hash, NULL, metadata, fd_type_pun_const(rec->pair.key->uc), fd_account_meta_get_data( metadata ), FD_HASH_JUST_ACCOUNT_HASH, features  );
+    fd_hash_account_batch_add( batch, metadata, fd_type_pun_const(rec->pair.key->uc), fd_account_meta_get_data( metadata ), features );
 
     fd_hash_t * h = (fd_hash_t *)metadata->hash;
     if( FD_LIKELY( (h->ul[0] | h->ul[1] | h->ul[2] | h->ul[3]) != 0 ) ) {
@@ -851,6 +1007,8 @@ fd_accounts_sorted_subrange_gather( fd_funk_t *             funk,
     pair->hash                   = (const fd_hash_t *)metadata->hash;
   }
 
+  fd_hash_account_batch_flush( batch );
+
   sort_pubkey_hash_pair_inplace( pairs, num_pairs );
 
   *num_pairs_out = num_pairs;
@@ -1320,6 +1478,10 @@ fd_accounts_check_lthash( fd_funk_t *      funk,
   fd_lthash_value_t acc_lthash;
   fd_lthash_zero( &acc_lthash );
 
+  fd_hash_account_batch_t batch[1];
+  batch->accum = &acc_lthash;
+  batch->cnt   = 0UL;
+
   ulong slot_cnt = accounts_hash_slot_cnt(hash_map);;
   for( ulong slot_idx=0UL; slot_idx<slot_cnt; slot_idx++ ) {
     accounts_hash_t *slot = &hash_map[slot_idx];
@@ -1329,10 +1491,8 @@ fd_accounts_check_lthash( fd_funk_t *      funk,
       if( FD_UNLIKELY(metadata->info.lamports != 0) ) {
         uchar * acc_data = fd_account_meta_get_data(metadata);
         uchar hash  [ 32 ];
-        fd_lthash_value_t new_lthash_value;
-        fd_lthash_zero(&new_lthash_value);
-        fd_hash_account_current( hash, &new_lthash_value, metadata, fd_type_pun_const(slot->key->pair.key[0].uc), acc_data, FD_HASH_BOTH_HASHES, features );
-        fd_lthash_add( &acc_lthash, &new_lthash_value );
+        fd_hash_account_current( hash, NULL, metadata, fd_type_pun_const(slot->key->pair.key[0].uc), acc_data, FD_HASH_JUST_ACCOUNT_HASH, features );
+        fd_hash_account_batch_add( batch, metadata, fd_type_pun_const(slot->key->pair.key[0].uc), acc_data, features );
 
         if (fd_account_meta_exists( metadata ) && memcmp( metadata->hash, &hash, 32 ) != 0 ) {
           FD_LOG_WARNING(( "snapshot hash (%s) doesn't match calculated hash (%s)", FD_BASE58_ENC_32_ALLOCA( metadata->hash ), FD_BASE58_ENC_32_ALLOCA( &hash ) ));
@@ -1341,6 +1501,8 @@ fd_accounts_check_lthash( fd_funk_t *      funk,
     }
   }
 
+  fd_hash_account_batch_flush( batch );
+
   // Compare the accumulator to the slot
   fd_lthash_value_t * acc = (fd_lthash_value_t *)fd_type_pun_const( slot_bank->lthash.lthash );
   if ( memcmp( acc, &acc_lthash, sizeof( fd_lthash_value_t ) ) == 0 ) {
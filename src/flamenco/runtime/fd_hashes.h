@@ -6,6 +6,8 @@
 #include "../../funk/fd_funk.h"
 #include "../../ballet/lthash/fd_lthash.h"
 #include "fd_runtime_public.h"
+#include "fd_lthash_delta.h"
+#include "fd_txn_account.h"
 
 #define FD_PUBKEY_HASH_PAIR_ALIGN (16UL)
 struct __attribute__((aligned(FD_PUBKEY_HASH_PAIR_ALIGN))) fd_pubkey_hash_pair {
@@ -36,6 +38,7 @@ struct fd_accounts_hash_task_info {
   fd_hash_t                acc_hash[1];
   uint                     should_erase;
   uint                     hash_changed;
+  uint                     lthash_done;  /* lthash change already in the slot's fd_lthash_delta_t */
 };
 typedef struct fd_accounts_hash_task_info fd_accounts_hash_task_info_t;
 
@@ -44,6 +47,7 @@ struct fd_accounts_hash_task_data {
   ulong                          info_sz;
   fd_lthash_value_t *            lthash_values;
   ulong                          num_recs;
+  ulong                          lthash_stale_mask; /* buckets of the slot's fd_lthash_delta_t not to merge */
 };
 typedef struct fd_accounts_hash_task_data fd_accounts_hash_task_data_t;
 
@@ -89,6 +93,15 @@ fd_update_hash_bank_exec_hash( fd_exec_slot_ctx_t *           slot_ctx,
                                ulong                          signature_cnt,
                                fd_spad_t *                    runtime_spad );
 
+/* fd_collect_modified_accounts gathers the accounts modified in the
+   slot's funk transaction into task_data.  If slot_ctx->lthash_delta
+   tracks the funk transaction, accounts whose lthash change was
+   accumulated at save time (see fd_account_save_lthash) are marked
+   lthash_done, unless another account in the same delta bucket was
+   modified in place afterwards.  Such buckets are recorded in
+   task_data->lthash_stale_mask and all of their accounts are hashed in
+   full.  fd_update_hash_bank_exec_hash merges the remaining buckets. */
+
 void
 fd_collect_modified_accounts( fd_exec_slot_ctx_t *           slot_ctx,
                               fd_accounts_hash_task_data_t * task_data,
@@ -102,6 +115,24 @@ fd_account_hash( fd_funk_t *                    funk,
                  ulong                          slot,
                  fd_features_t *                features );
 
+/* fd_account_save_lthash saves acct into the funk transaction txn
+   like fd_txn_account_save.  If delta is non-NULL and tracks txn, the
+   resulting change of the accounts lthash (the lthash of the saved
+   value minus the lthash of the value at the start of the slot) is
+   accumulated into shard shard_idx of delta and the account record is
+   flagged FD_ACC_REC_FLAG_LTHASH, such that bank hashing at the end of
+   the slot does not need to hash the account's old and new value
+   again.  The caller must own shard shard_idx.  Returns the result of
+   fd_txn_account_save. */
+
+int
+fd_account_save_lthash( fd_txn_account_t *  acct,
+                        fd_funk_t *         funk,
+                        fd_funk_txn_t *     txn,
+                        fd_wksp_t *         acc_data_wksp,
+                        fd_lthash_delta_t * delta,
+                        ulong               shard_idx );
+
 int
 fd_update_hash_bank_tpool( fd_exec_slot_ctx_t * slot_ctx,
                            fd_capture_ctx_t *   capture_ctx,
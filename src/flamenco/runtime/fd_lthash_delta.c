@@ -0,0 +1,160 @@
+#include "fd_lthash_delta.h"
+
+struct __attribute__((aligned(FD_LTHASH_DELTA_ALIGN))) fd_lthash_delta_private {
+  ulong             magic;
+  ulong             shard_cnt;
+  int               tracking; /* 1 if xid is valid */
+  fd_funk_txn_xid_t xid;      /* funk transaction accumulated into the buckets */
+
+  /* shard_cnt*FD_LTHASH_DELTA_BUCKET_CNT buckets follow, shard major */
+};
+
+FD_STATIC_ASSERT( FD_LTHASH_DELTA_BUCKET_CNT<=64UL, bucket_mask );
+FD_STATIC_ASSERT( !( FD_LTHASH_DELTA_BUCKET_CNT & (FD_LTHASH_DELTA_BUCKET_CNT-1UL) ), bucket_cnt );
+
+static inline fd_lthash_value_t *
+fd_lthash_delta_private_bucket( fd_lthash_delta_t const * delta ) {
+  return (fd_lthash_value_t *)( (ulong)delta + fd_ulong_align_up( sizeof(fd_lthash_delta_t), FD_LTHASH_VALUE_ALIGN ) );
+}
+
+ulong
+fd_lthash_delta_align( void ) {
+  return FD_LTHASH_DELTA_ALIGN;
+}
+
+ulong
+fd_lthash_delta_footprint( ulong shard_cnt ) {
+  if( FD_UNLIKELY( !shard_cnt || shard_cnt>(1UL<<16) ) ) return 0UL;
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, FD_LTHASH_DELTA_ALIGN, sizeof(fd_lthash_delta_t) );
+  l = FD_LAYOUT_APPEND( l, FD_LTHASH_VALUE_ALIGN, shard_cnt*FD_LTHASH_DELTA_BUCKET_CNT*sizeof(fd_lthash_value_t) );
+  return FD_LAYOUT_FINI( l, FD_LTHASH_DELTA_ALIGN );
+}
+
+void *
+fd_lthash_delta_new( void * shmem,
+                     ulong  shard_cnt ) {
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_lthash_delta_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_lthash_delta_footprint( shard_cnt );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad shard_cnt (%lu)", shard_cnt ));
+    return NULL;
+  }
+
+  fd_memset( shmem, 0, footprint );
+
+  fd_lthash_delta_t * delta = (fd_lthash_delta_t *)shmem;
+  delta->shard_cnt = shard_cnt;
+  delta->tracking  = 0;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( delta->magic ) = FD_LTHASH_DELTA_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_lthash_delta_t *
+fd_lthash_delta_join( void * shdelta ) {
+  if( FD_UNLIKELY( !shdelta ) ) {
+    FD_LOG_WARNING(( "NULL shdelta" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shdelta, fd_lthash_delta_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shdelta" ));
+    return NULL;
+  }
+
+  fd_lthash_delta_t * delta = (fd_lthash_delta_t *)shdelta;
+  if( FD_UNLIKELY( delta->magic!=FD_LTHASH_DELTA_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return delta;
+}
+
+void *
+fd_lthash_delta_leave( fd_lthash_delta_t * delta ) {
+  if( FD_UNLIKELY( !delta ) ) {
+    FD_LOG_WARNING(( "NULL delta" ));
+    return NULL;
+  }
+  return (void *)delta;
+}
+
+void *
+fd_lthash_delta_delete( void * shdelta ) {
+  if( FD_UNLIKELY( !shdelta ) ) {
+    FD_LOG_WARNING(( "NULL shdelta" ));
+    return NULL;
+  }
+
+  fd_lthash_delta_t * delta = (fd_lthash_delta_t *)shdelta;
+  if( FD_UNLIKELY( delta->magic!=FD_LTHASH_DELTA_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( delta->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shdelta;
+}
+
+ulong
+fd_lthash_delta_shard_cnt( fd_lthash_delta_t const * delta ) {
+  return delta->shard_cnt;
+}
+
+void
+fd_lthash_delta_begin( fd_lthash_delta_t *       delta,
+                       fd_funk_txn_xid_t const * xid ) {
+  fd_lthash_value_t * bucket = fd_lthash_delta_private_bucket( delta );
+  ulong               cnt    = delta->shard_cnt*FD_LTHASH_DELTA_BUCKET_CNT;
+  for( ulong i=0UL; i<cnt; i++ ) fd_lthash_zero( &bucket[ i ] );
+  fd_funk_txn_xid_copy( &delta->xid, xid );
+  delta->tracking = 1;
+  FD_COMPILER_MFENCE();
+}
+
+int
+fd_lthash_delta_is_tracking( fd_lthash_delta_t const * delta,
+                             fd_funk_txn_xid_t const * xid ) {
+  return delta->tracking && fd_funk_txn_xid_eq( &delta->xid, xid );
+}
+
+fd_lthash_value_t *
+fd_lthash_delta_bucket( fd_lthash_delta_t * delta,
+                        ulong               shard_idx,
+                        ulong               bucket_idx ) {
+  return fd_lthash_delta_private_bucket( delta ) + shard_idx*FD_LTHASH_DELTA_BUCKET_CNT + bucket_idx;
+}
+
+int
+fd_lthash_delta_merge( fd_lthash_delta_t const * delta,
+                       fd_funk_txn_xid_t const * xid,
+                       ulong                     stale_mask,
+                       fd_lthash_value_t *       out ) {
+  if( FD_UNLIKELY( !fd_lthash_delta_is_tracking( delta, xid ) ) ) return 0;
+
+  fd_lthash_value_t const * bucket = fd_lthash_delta_private_bucket( delta );
+  for( ulong shard_idx=0UL; shard_idx<delta->shard_cnt; shard_idx++ ) {
+    for( ulong bucket_idx=0UL; bucket_idx<FD_LTHASH_DELTA_BUCKET_CNT; bucket_idx++ ) {
+      if( FD_UNLIKELY( fd_ulong_extract_bit( stale_mask, (int)bucket_idx ) ) ) continue;
+      fd_lthash_add( out, &bucket[ shard_idx*FD_LTHASH_DELTA_BUCKET_CNT + bucket_idx ] );
+    }
+  }
+  return 1;
+}
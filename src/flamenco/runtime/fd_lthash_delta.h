@@ -0,0 +1,115 @@
+#ifndef HEADER_fd_src_flamenco_runtime_fd_lthash_delta_h
+#define HEADER_fd_src_flamenco_runtime_fd_lthash_delta_h
+
+/* fd_lthash_delta accumulates the change of the accounts lthash of the
+   slot being replayed while its transactions are finalized, so that
+   bank hashing at the end of the slot only has to merge the result
+   instead of rehashing the old and new value of every modified
+   account (see fd_account_save_lthash and fd_collect_modified_accounts
+   in fd_hashes.h).
+
+   A delta has shard_cnt shards and each shard has
+   FD_LTHASH_DELTA_BUCKET_CNT buckets.  A shard is owned by a single
+   writer (e.g. a writer tile), so accumulation is lock-free.  An
+   account always lands in the bucket given by its address.  Buckets
+   are the granularity at which the slot end falls back to the full
+   recompute when an account that was already accounted for is later
+   modified outside of transaction finalization (e.g. when the leader
+   collects fees).
+
+   A delta tracks a single funk transaction at a time.
+   fd_lthash_delta_begin starts tracking a new one and must not be
+   called while transactions of the previous one are being finalized.
+   Accounts saved into a funk transaction other than the tracked one
+   are not accounted for in the delta and are hashed at slot end as
+   before. */
+
+#include "../fd_flamenco_base.h"
+#include "../../ballet/lthash/fd_lthash.h"
+#include "../../funk/fd_funk_base.h"
+
+#define FD_LTHASH_DELTA_ALIGN      (128UL)
+#define FD_LTHASH_DELTA_BUCKET_CNT (16UL) /* must be at most 64 (bucket masks are a ulong) */
+#define FD_LTHASH_DELTA_MAGIC      (0xF17EDA2CE17D17A0UL) /* FIREDANCE LTHASH DELTA V0 */
+
+struct fd_lthash_delta_private;
+typedef struct fd_lthash_delta_private fd_lthash_delta_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_lthash_delta_{align,footprint} return the required alignment and
+   footprint of a memory region suitable for use as an lthash delta
+   with shard_cnt shards.  footprint returns 0 for shard_cnt==0. */
+
+FD_FN_CONST ulong
+fd_lthash_delta_align( void );
+
+FD_FN_CONST ulong
+fd_lthash_delta_footprint( ulong shard_cnt );
+
+/* fd_lthash_delta_new formats an unused memory region for use as an
+   lthash delta.  The delta does not track any funk transaction on
+   return.  Returns shmem on success and NULL on failure (logs
+   details). */
+
+void *
+fd_lthash_delta_new( void * shmem,
+                     ulong  shard_cnt );
+
+fd_lthash_delta_t *
+fd_lthash_delta_join( void * shdelta );
+
+void *
+fd_lthash_delta_leave( fd_lthash_delta_t * delta );
+
+void *
+fd_lthash_delta_delete( void * shdelta );
+
+FD_FN_PURE ulong
+fd_lthash_delta_shard_cnt( fd_lthash_delta_t const * delta );
+
+/* fd_lthash_delta_begin zeros all buckets of delta and starts tracking
+   the funk transaction xid. */
+
+void
+fd_lthash_delta_begin( fd_lthash_delta_t *       delta,
+                       fd_funk_txn_xid_t const * xid );
+
+/* fd_lthash_delta_is_tracking returns 1 if delta tracks the funk
+   transaction xid and 0 otherwise. */
+
+FD_FN_PURE int
+fd_lthash_delta_is_tracking( fd_lthash_delta_t const * delta,
+                             fd_funk_txn_xid_t const * xid );
+
+/* fd_lthash_delta_bucket_idx returns the bucket of the account at
+   address key, in [0,FD_LTHASH_DELTA_BUCKET_CNT). */
+
+FD_FN_PURE static inline ulong
+fd_lthash_delta_bucket_idx( fd_pubkey_t const * key ) {
+  return fd_ulong_hash( key->ul[0] ) & (FD_LTHASH_DELTA_BUCKET_CNT-1UL);
+}
+
+/* fd_lthash_delta_bucket returns the accumulator of bucket bucket_idx
+   of shard shard_idx.  Only the owner of the shard may modify it. */
+
+fd_lthash_value_t *
+fd_lthash_delta_bucket( fd_lthash_delta_t * delta,
+                        ulong               shard_idx,
+                        ulong               bucket_idx );
+
+/* fd_lthash_delta_merge adds the sum over all shards of the buckets
+   not in stale_mask (bit i set means bucket i is stale) to out.  If
+   delta does not track xid, out is not modified.  Returns 1 if delta
+   was merged and 0 otherwise.  Assumes no writers are accumulating
+   concurrently. */
+
+int
+fd_lthash_delta_merge( fd_lthash_delta_t const * delta,
+                       fd_funk_txn_xid_t const * xid,
+                       ulong                     stale_mask,
+                       fd_lthash_value_t *       out );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_runtime_fd_lthash_delta_h */
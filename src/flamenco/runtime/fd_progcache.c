@@ -0,0 +1,383 @@
+#include "fd_progcache.h"
+
+struct fd_progcache_entry {
+  ulong              ver;      /* sequence lock, odd while the entry is being updated */
+  ulong              gaddr;    /* wksp gaddr of the image, 0 if the entry is free */
+  ulong              sz;       /* image size in bytes */
+  ulong              last_use; /* value of the cache clock at last insert / hit */
+  fd_progcache_key_t key;
+  fd_pubkey_t        addr;
+};
+
+typedef struct fd_progcache_entry fd_progcache_entry_t;
+
+struct __attribute__((aligned(FD_PROGCACHE_ALIGN))) fd_progcache_private {
+  ulong magic;
+  ulong set_cnt;
+  ulong data_max;
+  ulong wksp_tag;
+
+  ulong lock;  /* serializes writers */
+  ulong clock; /* incremented on every insert / hit, orders entries for LRU */
+
+  fd_progcache_metrics_t metrics[1];
+
+  /* entry_cnt==set_cnt*FD_PROGCACHE_WAY_CNT entries follow */
+};
+
+static inline fd_progcache_entry_t *
+fd_progcache_private_entry( fd_progcache_t const * cache ) {
+  return (fd_progcache_entry_t *)( (ulong)cache + sizeof(fd_progcache_t) );
+}
+
+static inline ulong
+fd_progcache_private_entry_cnt( fd_progcache_t const * cache ) {
+  return cache->set_cnt*FD_PROGCACHE_WAY_CNT;
+}
+
+static inline ulong
+fd_progcache_private_set( fd_progcache_t const *     cache,
+                          fd_progcache_key_t const * key ) {
+  return fd_ulong_hash( FD_LOAD( ulong, key->hash ) ^ key->features ) & (cache->set_cnt-1UL);
+}
+
+static inline int
+fd_progcache_private_key_eq( fd_progcache_key_t const * a,
+                             fd_progcache_key_t const * b ) {
+  return ( a->features==b->features ) & !memcmp( a->hash, b->hash, 32UL );
+}
+
+static inline ulong
+fd_progcache_private_fetch_and_add( ulong * p,
+                                    ulong   v ) {
+# if FD_HAS_ATOMIC
+  return FD_ATOMIC_FETCH_AND_ADD( p, v );
+# else
+  ulong old = *p;
+  *p = old + v;
+  return old;
+# endif
+}
+
+static inline void
+fd_progcache_private_lock( fd_progcache_t * cache ) {
+# if FD_HAS_ATOMIC
+  for(;;) {
+    if( FD_LIKELY( !FD_ATOMIC_CAS( &cache->lock, 0UL, 1UL ) ) ) break;
+    FD_SPIN_PAUSE();
+  }
+# else
+  cache->lock = 1UL;
+# endif
+  FD_COMPILER_MFENCE();
+}
+
+static inline void
+fd_progcache_private_unlock( fd_progcache_t * cache ) {
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->lock ) = 0UL;
+}
+
+/* fd_progcache_private_evict removes entry e (which must be in use)
+   from the cache.  Assumes the caller holds the lock. */
+
+static void
+fd_progcache_private_evict( fd_progcache_t *       cache,
+                            fd_wksp_t *            wksp,
+                            fd_progcache_entry_t * e ) {
+  ulong gaddr = e->gaddr;
+  ulong sz    = e->sz;
+
+  FD_VOLATILE( e->ver ) = e->ver+1UL;
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( e->gaddr ) = 0UL;
+  FD_VOLATILE( e->sz    ) = 0UL;
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( e->ver ) = e->ver+1UL;
+
+  /* Concurrent readers that raced with the above are still reading
+     from wksp memory (and will see a miss) so freeing is fine. */
+
+  fd_wksp_free( wksp, gaddr );
+  cache->metrics->data_sz -= sz;
+}
+
+ulong
+fd_progcache_align( void ) {
+  return FD_PROGCACHE_ALIGN;
+}
+
+ulong
+fd_progcache_footprint( ulong set_cnt ) {
+  if( FD_UNLIKELY( !set_cnt || !fd_ulong_is_pow2( set_cnt ) ) ) return 0UL;
+  if( FD_UNLIKELY( set_cnt>(1UL<<32) ) ) return 0UL;
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, FD_PROGCACHE_ALIGN,             sizeof(fd_progcache_t)                               );
+  l = FD_LAYOUT_APPEND( l, alignof(fd_progcache_entry_t), set_cnt*FD_PROGCACHE_WAY_CNT*sizeof(fd_progcache_entry_t) );
+  return FD_LAYOUT_FINI( l, FD_PROGCACHE_ALIGN );
+}
+
+void *
+fd_progcache_new( void * shmem,
+                  ulong  set_cnt,
+                  ulong  data_max,
+                  ulong  wksp_tag ) {
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_progcache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_progcache_footprint( set_cnt );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad set_cnt (%lu)", set_cnt ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !wksp_tag ) ) {
+    FD_LOG_WARNING(( "bad wksp_tag" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_wksp_containing( shmem ) ) ) {
+    FD_LOG_WARNING(( "shmem must be part of a workspace" ));
+    return NULL;
+  }
+
+  fd_memset( shmem, 0, footprint );
+
+  fd_progcache_t * cache = (fd_progcache_t *)shmem;
+  cache->set_cnt  = set_cnt;
+  cache->data_max = data_max;
+  cache->wksp_tag = wksp_tag;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = FD_PROGCACHE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_progcache_t *
+fd_progcache_join( void * shcache ) {
+  if( FD_UNLIKELY( !shcache ) ) {
+    FD_LOG_WARNING(( "NULL shcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shcache, fd_progcache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shcache" ));
+    return NULL;
+  }
+
+  fd_progcache_t * cache = (fd_progcache_t *)shcache;
+
+  if( FD_UNLIKELY( cache->magic!=FD_PROGCACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return cache;
+}
+
+void *
+fd_progcache_leave( fd_progcache_t * cache ) {
+  if( FD_UNLIKELY( !cache ) ) {
+    FD_LOG_WARNING(( "NULL cache" ));
+    return NULL;
+  }
+
+  return (void *)cache;
+}
+
+void *
+fd_progcache_delete( void * shcache ) {
+  if( FD_UNLIKELY( !shcache ) ) {
+    FD_LOG_WARNING(( "NULL shcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shcache, fd_progcache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shcache" ));
+    return NULL;
+  }
+
+  fd_progcache_t * cache = (fd_progcache_t *)shcache;
+
+  if( FD_UNLIKELY( cache->magic!=FD_PROGCACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  fd_wksp_t *            wksp      = fd_wksp_containing( cache );
+  fd_progcache_entry_t * entry     = fd_progcache_private_entry( cache );
+  ulong                  entry_cnt = fd_progcache_private_entry_cnt( cache );
+  for( ulong i=0UL; i<entry_cnt; i++ ) {
+    if( entry[ i ].gaddr ) fd_progcache_private_evict( cache, wksp, &entry[ i ] );
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shcache;
+}
+
+int
+fd_progcache_query( fd_progcache_t *           cache,
+                    fd_progcache_key_t const * key,
+                    void *                     dst,
+                    ulong                      dst_sz ) {
+  fd_progcache_entry_t * set = fd_progcache_private_entry( cache ) + fd_progcache_private_set( cache, key )*FD_PROGCACHE_WAY_CNT;
+
+  for( ulong way=0UL; way<FD_PROGCACHE_WAY_CNT; way++ ) {
+    fd_progcache_entry_t * e = &set[ way ];
+
+    ulong ver0 = FD_VOLATILE_CONST( e->ver );
+    if( FD_UNLIKELY( ver0 & 1UL ) ) continue;
+    FD_COMPILER_MFENCE();
+
+    fd_progcache_key_t e_key = e->key;
+    ulong              gaddr = FD_VOLATILE_CONST( e->gaddr );
+    ulong              sz    = FD_VOLATILE_CONST( e->sz    );
+
+    /* Make sure gaddr and sz are consistent before touching the image
+       so that the copy below stays within an allocation (that might
+       have been freed since but is still wksp memory). */
+
+    FD_COMPILER_MFENCE();
+    if( FD_UNLIKELY( FD_VOLATILE_CONST( e->ver )!=ver0 ) ) continue;
+
+    if( !gaddr || !fd_progcache_private_key_eq( &e_key, key ) ) continue;
+
+    if( FD_UNLIKELY( sz!=dst_sz ) ) break;
+
+    fd_memcpy( dst, fd_wksp_laddr_fast( fd_wksp_containing( cache ), gaddr ), sz );
+
+    FD_COMPILER_MFENCE();
+    if( FD_UNLIKELY( FD_VOLATILE_CONST( e->ver )!=ver0 ) ) break;
+
+    FD_VOLATILE( e->last_use ) = fd_progcache_private_fetch_and_add( &cache->clock, 1UL );
+    fd_progcache_private_fetch_and_add( &cache->metrics->hit_cnt, 1UL );
+    return 1;
+  }
+
+  fd_progcache_private_fetch_and_add( &cache->metrics->miss_cnt, 1UL );
+  return 0;
+}
+
+int
+fd_progcache_insert( fd_progcache_t *           cache,
+                     fd_progcache_key_t const * key,
+                     fd_pubkey_t const *        addr,
+                     void const *               img,
+                     ulong                      img_sz ) {
+  if( FD_UNLIKELY( !img_sz || img_sz>cache->data_max ) ) return 0;
+
+  fd_wksp_t *            wksp      = fd_wksp_containing( cache );
+  fd_progcache_entry_t * entry     = fd_progcache_private_entry( cache );
+  ulong                  entry_cnt = fd_progcache_private_entry_cnt( cache );
+  fd_progcache_entry_t * set       = entry + fd_progcache_private_set( cache, key )*FD_PROGCACHE_WAY_CNT;
+
+  fd_progcache_private_lock( cache );
+
+  /* Pick the way to replace: the matching entry if already present
+     (just mark it used), else a free way, else the least recently used
+     way. */
+
+  fd_progcache_entry_t * victim = &set[ 0 ];
+  for( ulong way=0UL; way<FD_PROGCACHE_WAY_CNT; way++ ) {
+    fd_progcache_entry_t * e = &set[ way ];
+    if( e->gaddr && fd_progcache_private_key_eq( &e->key, key ) ) {
+      FD_VOLATILE( e->last_use ) = fd_progcache_private_fetch_and_add( &cache->clock, 1UL );
+      fd_progcache_private_unlock( cache );
+      return 1;
+    }
+    if( !victim->gaddr ) continue;
+    if( !e->gaddr || e->last_use<victim->last_use ) victim = e;
+  }
+
+  if( victim->gaddr ) {
+    fd_progcache_private_evict( cache, wksp, victim );
+    cache->metrics->evict_cnt++;
+  }
+
+  /* Evict globally least recently used entries until the new image
+     fits.  This is O(entry_cnt) per eviction but is only hit when the
+     cache is under memory pressure, and an insert follows a program
+     load / validate which is far more expensive. */
+
+  while( cache->metrics->data_sz + img_sz > cache->data_max ) {
+    fd_progcache_entry_t * lru = NULL;
+    for( ulong i=0UL; i<entry_cnt; i++ ) {
+      fd_progcache_entry_t * e = &entry[ i ];
+      if( e->gaddr && ( !lru || e->last_use<lru->last_use ) ) lru = e;
+    }
+    if( FD_UNLIKELY( !lru ) ) break; /* data_sz accounting broken, never happens */
+    fd_progcache_private_evict( cache, wksp, lru );
+    cache->metrics->evict_cnt++;
+  }
+
+  ulong gaddr = fd_wksp_alloc( wksp, 64UL, img_sz, cache->wksp_tag );
+  if( FD_UNLIKELY( !gaddr ) ) {
+    fd_progcache_private_unlock( cache );
+    return 0;
+  }
+  fd_memcpy( fd_wksp_laddr_fast( wksp, gaddr ), img, img_sz );
+
+  FD_VOLATILE( victim->ver ) = victim->ver+1UL;
+  FD_COMPILER_MFENCE();
+  victim->key      = *key;
+  victim->addr     = *addr;
+  victim->sz       = img_sz;
+  victim->last_use = fd_progcache_private_fetch_and_add( &cache->clock, 1UL );
+  victim->gaddr    = gaddr;
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( victim->ver ) = victim->ver+1UL;
+
+  cache->metrics->data_sz += img_sz;
+  cache->metrics->insert_cnt++;
+
+  fd_progcache_private_unlock( cache );
+  return 1;
+}
+
+ulong
+fd_progcache_invalidate( fd_progcache_t *    cache,
+                         fd_pubkey_t const * addr ) {
+  fd_wksp_t *            wksp      = fd_wksp_containing( cache );
+  fd_progcache_entry_t * entry     = fd_progcache_private_entry( cache );
+  ulong                  entry_cnt = fd_progcache_private_entry_cnt( cache );
+  ulong                  cnt       = 0UL;
+
+  fd_progcache_private_lock( cache );
+  for( ulong i=0UL; i<entry_cnt; i++ ) {
+    fd_progcache_entry_t * e = &entry[ i ];
+    if( e->gaddr && !memcmp( &e->addr, addr, sizeof(fd_pubkey_t) ) ) {
+      fd_progcache_private_evict( cache, wksp, e );
+      cnt++;
+    }
+  }
+  cache->metrics->invalidate_cnt += cnt;
+  fd_progcache_private_unlock( cache );
+
+  return cnt;
+}
+
+fd_progcache_metrics_t *
+fd_progcache_metrics_snap( fd_progcache_t const *   cache,
+                           fd_progcache_metrics_t * out ) {
+  FD_COMPILER_MFENCE();
+  out->hit_cnt        = FD_VOLATILE_CONST( cache->metrics->hit_cnt        );
+  out->miss_cnt       = FD_VOLATILE_CONST( cache->metrics->miss_cnt       );
+  out->insert_cnt     = FD_VOLATILE_CONST( cache->metrics->insert_cnt     );
+  out->evict_cnt      = FD_VOLATILE_CONST( cache->metrics->evict_cnt      );
+  out->invalidate_cnt = FD_VOLATILE_CONST( cache->metrics->invalidate_cnt );
+  out->data_sz        = FD_VOLATILE_CONST( cache->metrics->data_sz        );
+  FD_COMPILER_MFENCE();
+  return out;
+}
@@ -1502,6 +1502,12 @@ fd_runtime_block_execute_prepare( fd_exec_slot_ctx_t * slot_ctx,
   slot_ctx->nonvote_failed_txn_count           = 0UL;
   slot_ctx->total_compute_units_used           = 0UL;
 
+  /* Start accumulating the accounts lthash change of this slot's
+     transactions (see fd_account_save_lthash) */
+  if( slot_ctx->lthash_delta && slot_ctx->funk_txn ) {
+    fd_lthash_delta_begin( slot_ctx->lthash_delta, &slot_ctx->funk_txn->xid );
+  }
+
   int result = fd_runtime_block_sysvar_update_pre_execute( slot_ctx, runtime_spad );
   if( FD_UNLIKELY( result != 0 ) ) {
     FD_LOG_WARNING(("updating sysvars failed"));
@@ -1870,7 +1876,7 @@ fd_runtime_finalize_txn( fd_exec_slot_ctx_t *         slot_ctx,
 
     /* Rollback the nonce account first, as it could be the feepayer account, which will be updated next. */
     if( txn_ctx->nonce_account_idx_in_txn != ULONG_MAX ) {
-      fd_txn_account_save( &txn_ctx->rollback_nonce_account[0], slot_ctx->funk, slot_ctx->funk_txn, txn_ctx->spad_wksp );
+      fd_account_save_lthash( &txn_ctx->rollback_nonce_account[0], slot_ctx->funk, slot_ctx->funk_txn, txn_ctx->spad_wksp, task_info->lthash_delta, task_info->lthash_shard );
     }
 
     FD_SPAD_FRAME_BEGIN( finalize_spad ) {
@@ -1889,7 +1895,7 @@ fd_runtime_finalize_txn( fd_exec_slot_ctx_t *         slot_ctx,
         FD_LOG_CRIT(( "failed to deduct fees (%lu+%lu) from account %s in txn %s slot %lu", txn_ctx->execution_fee, txn_ctx->priority_fee, key_str, sig_str, txn_ctx->slot ));
       }
 
-      fd_txn_account_save( &txn_ctx->accounts[0], slot_ctx->funk, slot_ctx->funk_txn, finalize_spad_wksp );
+      fd_account_save_lthash( &txn_ctx->accounts[0], slot_ctx->funk, slot_ctx->funk_txn, finalize_spad_wksp, task_info->lthash_delta, task_info->lthash_shard );
     } FD_SPAD_FRAME_END;
   } else {
 
@@ -1946,7 +1952,7 @@ fd_runtime_finalize_txn( fd_exec_slot_ctx_t *         slot_ctx,
         fd_store_stake_delegation( slot_ctx, acc_rec );
       }
 
-      fd_txn_account_save( &txn_ctx->accounts[i], slot_ctx->funk, slot_ctx->funk_txn, txn_ctx->spad_wksp );
+      fd_account_save_lthash( &txn_ctx->accounts[i], slot_ctx->funk, slot_ctx->funk_txn, txn_ctx->spad_wksp, task_info->lthash_delta, task_info->lthash_shard );
       int fresh_account = acc_rec->vt->is_mutable( acc_rec ) &&
          acc_rec->vt->get_lamports( acc_rec ) && acc_rec->vt->get_rent_epoch( acc_rec ) != FD_RENT_EXEMPT_RENT_EPOCH;
       if( FD_UNLIKELY( fresh_account ) ) {
@@ -2132,8 +2138,10 @@ fd_runtime_process_txns_in_microblock_stream( fd_exec_slot_ctx_t * slot_ctx,
         continue;
       }
 
-      task_infos[ curr_exec_idx ].spad    = exec_spads[ worker_idx ];
-      task_infos[ curr_exec_idx ].txn     = &txns[ curr_exec_idx ];
+      task_infos[ curr_exec_idx ].spad         = exec_spads[ worker_idx ];
+      task_infos[ curr_exec_idx ].txn          = &txns[ curr_exec_idx ];
+      task_infos[ curr_exec_idx ].lthash_delta = slot_ctx->lthash_delta;
+      task_infos[ curr_exec_idx ].lthash_shard = worker_idx;
       task_infos[ curr_exec_idx ].txn_ctx = fd_spad_alloc( task_infos[ curr_exec_idx ].spad,
                                                            FD_EXEC_TXN_CTX_ALIGN,
                                                            FD_EXEC_TXN_CTX_FOOTPRINT );
@@ -79,6 +79,12 @@ struct fd_execute_txn_task_info {
   fd_exec_txn_ctx_t * txn_ctx;
   fd_txn_p_t *        txn;
   int                 exec_res;
+
+  /* Accumulator for the accounts lthash change of saved accounts and
+     the shard of it owned by the finalizing thread (see
+     fd_account_save_lthash).  NULL if not used. */
+  fd_lthash_delta_t * lthash_delta;
+  ulong               lthash_shard;
 };
 typedef struct fd_execute_txn_task_info fd_execute_txn_task_info_t;
 
@@ -241,6 +241,7 @@ struct fd_runtime_public_bpf_scan_msg {
   ulong cache_txn_gaddr;
   ulong start_idx;
   ulong end_idx;
+  ulong slot;  /* loader configuration programs are warmed under */
 };
 typedef struct fd_runtime_public_bpf_scan_msg fd_runtime_public_bpf_scan_msg_t;
 
@@ -10,6 +10,7 @@
 #include "../sysvar/fd_sysvar_cache.h"
 #include "../../vm/syscall/fd_vm_syscall.h"
 #include "../../vm/fd_vm.h"
+#include "../../vm/jit/fd_vm_jit_cache.h"
 #include "../fd_executor.h"
 #include "fd_bpf_loader_serialization.h"
 #include "fd_native_cpi.h"
@@ -400,6 +401,18 @@ common_close_account( fd_pubkey_t * authority_address,
 }
 
 
+/* fd_bpf_prof_node returns the profile call stack node of the program
+   invoked by instr_ctx, interning the nodes of its CPI callers as
+   necessary. */
+
+static ulong
+fd_bpf_prof_node( fd_vm_prof_t *              prof,
+                  fd_exec_instr_ctx_t const * instr_ctx ) {
+  ulong parent = instr_ctx->parent ? fd_bpf_prof_node( prof, instr_ctx->parent ) : FD_VM_PROF_NODE_ROOT;
+  fd_pubkey_t const * program_id = &instr_ctx->txn_ctx->account_keys[ instr_ctx->instr->program_id ];
+  return fd_vm_prof_node_insert( prof, parent, program_id->key );
+}
+
 /* Every loader-owned BPF program goes through this function, which goes into the VM.
 
    https://github.com/anza-xyz/agave/blob/574bae8fefc0ed256b55340b9d87b7689bcdf222/programs/bpf_loader/src/lib.rs#L1332-L1501 */
@@ -481,6 +494,12 @@ fd_bpf_execute( fd_exec_instr_ctx_t * instr_ctx, fd_sbpf_validated_program_t * p
     return FD_EXECUTOR_INSTR_ERR_PROGRAM_ENVIRONMENT_SETUP_FAILURE;
   }
 
+  fd_vm_prof_t * prof = instr_ctx->txn_ctx->vm_prof;
+  if( FD_UNLIKELY( prof ) ) {
+    vm->prof      = prof;
+    vm->prof_node = fd_bpf_prof_node( prof, instr_ctx );
+  }
+
 #ifdef FD_DEBUG_SBPF_TRACES
   uchar * signature = (uchar*)vm->instr_ctx->txn_ctx->_txn_raw->raw + vm->instr_ctx->txn_ctx->txn_descriptor->signature_off;
   uchar sig[64];
@@ -507,7 +526,23 @@ fd_bpf_execute( fd_exec_instr_ctx_t * instr_ctx, fd_sbpf_validated_program_t * p
 
   vm->cu -= heap_cost_result;
 
+#if FD_HAS_X86 && FD_HAS_HOSTED
+  /* If the sBPF JIT is enabled, run the program's compiled code (see
+     fd_vm_exec_jit for when it still interprets).  Programs that could
+     not be compiled are interpreted. */
+  fd_vm_jit_cache_t * jit_cache = instr_ctx->txn_ctx->vm_jit;
+  fd_vm_jit_t const * jit       = NULL;
+  if( FD_UNLIKELY( jit_cache ) ) {
+    fd_vm_jit_cache_key_t jit_key[1];
+    memcpy( jit_key->hash, prog->key.hash, sizeof(jit_key->hash) );
+    jit_key->tag = prog->key.features;
+    jit = fd_vm_jit_cache_acquire( jit_cache, jit_key, vm->text, vm->text_cnt, vm->entry_pc, vm->calldests, vm->sbpf_version );
+  }
+  int exec_err = jit ? fd_vm_exec_jit( vm, jit ) : fd_vm_exec( vm );
+  fd_vm_jit_cache_release( jit_cache, jit );
+#else
   int exec_err = fd_vm_exec( vm );
+#endif
   instr_ctx->txn_ctx->compute_meter = vm->cu;
 
   if( FD_UNLIKELY( vm->trace ) ) {
@@ -3,7 +3,9 @@
 #include "fd_loader_v4_program.h"
 #include "../fd_acc_mgr.h"
 #include "../context/fd_exec_slot_ctx.h"
+#include "../fd_progcache.h"
 #include "../../vm/syscall/fd_vm_syscall.h"
+#include "../../../ballet/sha256/fd_sha256.h"
 
 #include <assert.h>
 
@@ -83,6 +85,7 @@ fd_bpf_get_executable_program_content_for_upgradeable_loader( fd_exec_slot_ctx_t
                                                               fd_txn_account_t *      program_acc,
                                                               uchar const **          program_data,
                                                               ulong *                 program_data_len,
+                                                              fd_pubkey_t *           programdata_address_out,
                                                               fd_spad_t *             runtime_spad ) {
   FD_TXN_ACCOUNT_DECL( programdata_acc );
 
@@ -124,8 +127,9 @@ fd_bpf_get_executable_program_content_for_upgradeable_loader( fd_exec_slot_ctx_t
     return -1;
   }
 
-  *program_data     = programdata_acc->vt->get_data( programdata_acc ) + PROGRAMDATA_METADATA_SIZE;
-  *program_data_len = programdata_acc->vt->get_data_len( programdata_acc ) - PROGRAMDATA_METADATA_SIZE;
+  *program_data            = programdata_acc->vt->get_data( programdata_acc ) + PROGRAMDATA_METADATA_SIZE;
+  *program_data_len        = programdata_acc->vt->get_data_len( programdata_acc ) - PROGRAMDATA_METADATA_SIZE;
+  *programdata_address_out = *programdata_address;
   return 0;
 }
 
@@ -162,6 +166,118 @@ fd_bpf_get_sbpf_versions( uint *                sbpf_min_version,
   }
 }
 
+/* fd_bpf_progcache_key computes the fd_progcache key for a program:
+   the hash of its ELF bytes and a digest of the loader configuration
+   that influences the validated program (the enabled sbpf version
+   range, direct mapping and the set of registered syscalls, the latter
+   combined in an order independent way as the map is unordered). */
+
+static void
+fd_bpf_progcache_key( fd_progcache_key_t *       key,
+                      uchar const *              program_data,
+                      ulong                      program_data_len,
+                      uint                       min_sbpf_version,
+                      uint                       max_sbpf_version,
+                      int                        direct_mapping,
+                      fd_sbpf_syscalls_t const * syscalls ) {
+  fd_sha256_hash( program_data, program_data_len, key->hash );
+
+  ulong syscalls_digest = 0UL;
+  for( ulong i=0UL; i<fd_sbpf_syscalls_slot_cnt(); i++ ) {
+    if( fd_sbpf_syscalls_key_inval( syscalls[ i ].key ) ) continue;
+    syscalls_digest += fd_ulong_hash( syscalls[ i ].key );
+  }
+
+  key->features = fd_ulong_hash( syscalls_digest ^ ( (ulong)min_sbpf_version | ( (ulong)max_sbpf_version<<8 ) | ( (ulong)!!direct_mapping<<16 ) ) );
+}
+
+/* fd_bpf_load_and_validate loads the program
+   [program_data,program_data+program_data_len) into validated_prog
+   (formatted by fd_sbpf_validated_program_new for elf_info) and
+   validates its bytecode.  Returns validated_prog on success and NULL
+   if the program fails to load or validate.  Does not set
+   last_updated_slot and key.  Scratch memory is allocated from
+   runtime_spad in the caller's frame. */
+
+static fd_sbpf_validated_program_t *
+fd_bpf_load_and_validate( fd_sbpf_validated_program_t * validated_prog,
+                          fd_sbpf_elf_info_t const *    elf_info,
+                          uchar const *                 program_data,
+                          ulong                         program_data_len,
+                          fd_sbpf_syscalls_t *          syscalls,
+                          ulong                         slot,
+                          fd_features_t const *         features,
+                          int                           direct_mapping,
+                          fd_spad_t *                   runtime_spad ) {
+  ulong  prog_align     = fd_sbpf_program_align();
+  ulong  prog_footprint = fd_sbpf_program_footprint( elf_info );
+  fd_sbpf_program_t * prog = fd_sbpf_program_new(  fd_spad_alloc( runtime_spad, prog_align, prog_footprint ), elf_info, validated_prog->rodata );
+  if( FD_UNLIKELY( !prog ) ) {
+    return NULL;
+  }
+
+  /* Load program. */
+
+  if( FD_UNLIKELY( 0!=fd_sbpf_program_load( prog, program_data, program_data_len, syscalls, false ) ) ) {
+    FD_LOG_DEBUG(( "fd_sbpf_program_load() failed: %s", fd_sbpf_strerror() ));
+    return NULL;
+  }
+
+  /* Validate the program. */
+
+  fd_vm_t _vm[ 1UL ];
+  fd_vm_t * vm = fd_vm_join( fd_vm_new( _vm ) );
+  if( FD_UNLIKELY( !vm ) ) {
+    FD_LOG_ERR(( "fd_vm_new() or fd_vm_join() failed" ));
+  }
+  fd_exec_instr_ctx_t dummy_instr_ctx = {0};
+  fd_exec_txn_ctx_t   dummy_txn_ctx   = {0};
+  dummy_txn_ctx.slot      = slot;
+  dummy_txn_ctx.features  = *features;
+  dummy_instr_ctx.txn_ctx = &dummy_txn_ctx;
+  vm = fd_vm_init( vm,
+                   &dummy_instr_ctx,
+                   0UL,
+                   0UL,
+                   prog->rodata,
+                   prog->rodata_sz,
+                   prog->text,
+                   prog->text_cnt,
+                   prog->text_off,
+                   prog->text_sz,
+                   prog->entry_pc,
+                   prog->calldests,
+                   elf_info->sbpf_version,
+                   NULL,
+                   NULL,
+                   NULL,
+                   NULL,
+                   0U,
+                   NULL,
+                   0,
+                   direct_mapping );
+
+  if( FD_UNLIKELY( !vm ) ) {
+    FD_LOG_ERR(( "fd_vm_init() failed" ));
+  }
+
+  if( FD_UNLIKELY( fd_vm_validate( vm ) ) ) {
+    FD_LOG_DEBUG(( "fd_vm_validate() failed" ));
+    return NULL;
+  }
+
+  fd_memcpy( validated_prog->calldests_shmem, prog->calldests_shmem, fd_sbpf_calldests_footprint( prog->rodata_sz/8UL ) );
+  validated_prog->calldests = fd_sbpf_calldests_join( validated_prog->calldests_shmem );
+
+  validated_prog->entry_pc = prog->entry_pc;
+  validated_prog->text_off = prog->text_off;
+  validated_prog->text_cnt = prog->text_cnt;
+  validated_prog->text_sz = prog->text_sz;
+  validated_prog->rodata_sz = prog->rodata_sz;
+
+  return validated_prog;
+}
+
 static int
 fd_bpf_create_bpf_program_cache_entry( fd_exec_slot_ctx_t *    slot_ctx,
                                        fd_txn_account_t *      program_acc,
@@ -177,12 +293,17 @@ fd_bpf_create_bpf_program_cache_entry( fd_exec_slot_ctx_t *    slot_ctx,
     uchar const *     program_data     = NULL;
     ulong             program_data_len = 0UL;
 
+    /* The account holding the program bytes (the programdata account
+       for v3 programs).  Writes to it invalidate the progcache. */
+
+    fd_pubkey_t       progcache_addr[1] = { *program_pubkey };
+
     /* For v3 loaders, deserialize the program account and lookup the
        programdata account. Deserialize the programdata account. */
 
     int res;
     if( !memcmp( program_acc->vt->get_owner( program_acc ), fd_solana_bpf_loader_upgradeable_program_id.key, sizeof(fd_pubkey_t) ) ) {
-      res = fd_bpf_get_executable_program_content_for_upgradeable_loader( slot_ctx, program_acc, &program_data, &program_data_len, runtime_spad );
+      res = fd_bpf_get_executable_program_content_for_upgradeable_loader( slot_ctx, program_acc, &program_data, &program_data_len, progcache_addr, runtime_spad );
     } else if( !memcmp( program_acc->vt->get_owner( program_acc ), fd_solana_bpf_loader_v4_program_id.key, sizeof(fd_pubkey_t) ) ) {
       res = fd_bpf_get_executable_program_content_for_v4_loader( program_acc, &program_data, &program_data_len );
     } else {
@@ -212,17 +333,10 @@ fd_bpf_create_bpf_program_cache_entry( fd_exec_slot_ctx_t *    slot_ctx,
     }
 
     fd_wksp_t * wksp = fd_funk_wksp( funk );
-    void * val = fd_funk_val_truncate( rec, fd_sbpf_validated_program_footprint( &elf_info ), fd_funk_alloc( funk ), wksp, NULL );;
+    ulong  val_footprint = fd_sbpf_validated_program_footprint( &elf_info );
+    void * val = fd_funk_val_truncate( rec, val_footprint, fd_funk_alloc( funk ), wksp, NULL );;
     fd_sbpf_validated_program_t * validated_prog = fd_sbpf_validated_program_new( val, &elf_info );
 
-    ulong  prog_align     = fd_sbpf_program_align();
-    ulong  prog_footprint = fd_sbpf_program_footprint( &elf_info );
-    fd_sbpf_program_t * prog = fd_sbpf_program_new(  fd_spad_alloc( runtime_spad, prog_align, prog_footprint ), &elf_info, validated_prog->rodata );
-    if( FD_UNLIKELY( !prog ) ) {
-      fd_funk_rec_cancel( funk, prepare );
-      return -1;
-    }
-
     /* Allocate syscalls */
 
     fd_sbpf_syscalls_t * syscalls = fd_sbpf_syscalls_new( fd_spad_alloc( runtime_spad, fd_sbpf_syscalls_align(), fd_sbpf_syscalls_footprint() ) );
@@ -235,70 +349,45 @@ fd_bpf_create_bpf_program_cache_entry( fd_exec_slot_ctx_t *    slot_ctx,
                                  &slot_ctx->epoch_ctx->features,
                                  0 );
 
-    /* Load program. */
-
-    if( FD_UNLIKELY( 0!=fd_sbpf_program_load( prog, program_data, program_data_len, syscalls, false ) ) ) {
-      /* Remove pending funk record */
-      FD_LOG_DEBUG(( "fd_sbpf_program_load() failed: %s", fd_sbpf_strerror() ));
-      fd_funk_rec_cancel( funk, prepare );
-      return -1;
-    }
+    int direct_mapping = FD_FEATURE_ACTIVE( slot_ctx->slot_bank.slot, slot_ctx->epoch_ctx->features, bpf_account_data_direct_mapping );
+
+    /* If this exact program was already loaded and validated under the
+       same loader configuration (e.g. on another fork or before a
+       lamport transfer to the program account), reuse that result.
+       The cached image was copied from a funk record with the same
+       layout so only the interior pointers need to be fixed up. */
+
+    fd_progcache_key_t progcache_key[1];
+    fd_bpf_progcache_key( progcache_key, program_data, program_data_len, min_sbpf_version, max_sbpf_version, direct_mapping, syscalls );
+    if( slot_ctx->progcache ) {
+      if( fd_progcache_query( slot_ctx->progcache, progcache_key, val, val_footprint ) ) {
+        validated_prog = fd_sbpf_validated_program_new( val, &elf_info );
+        validated_prog->calldests         = fd_sbpf_calldests_join( validated_prog->calldests_shmem );
+        validated_prog->last_updated_slot = slot_ctx->slot_bank.slot;
+        fd_funk_rec_publish( funk, prepare );
+        return 0;
+      }
 
-    /* Validate the program. */
+      /* A miss that raced with an update can leave val partially
+         overwritten. */
 
-    fd_vm_t _vm[ 1UL ];
-    fd_vm_t * vm = fd_vm_join( fd_vm_new( _vm ) );
-    if( FD_UNLIKELY( !vm ) ) {
-      FD_LOG_ERR(( "fd_vm_new() or fd_vm_join() failed" ));
-    }
-    fd_exec_instr_ctx_t dummy_instr_ctx = {0};
-    fd_exec_txn_ctx_t   dummy_txn_ctx   = {0};
-    dummy_txn_ctx.slot      = slot_ctx->slot_bank.slot;
-    dummy_txn_ctx.features  = slot_ctx->epoch_ctx->features;
-    dummy_instr_ctx.txn_ctx = &dummy_txn_ctx;
-    vm = fd_vm_init( vm,
-                     &dummy_instr_ctx,
-                     0UL,
-                     0UL,
-                     prog->rodata,
-                     prog->rodata_sz,
-                     prog->text,
-                     prog->text_cnt,
-                     prog->text_off,
-                     prog->text_sz,
-                     prog->entry_pc,
-                     prog->calldests,
-                     elf_info.sbpf_version,
-                     NULL,
-                     NULL,
-                     NULL,
-                     NULL,
-                     0U,
-                     NULL,
-                     0,
-                     FD_FEATURE_ACTIVE( slot_ctx->slot_bank.slot, slot_ctx->epoch_ctx->features, bpf_account_data_direct_mapping ) );
-
-    if( FD_UNLIKELY( !vm ) ) {
-      FD_LOG_ERR(( "fd_vm_init() failed" ));
+      validated_prog = fd_sbpf_validated_program_new( val, &elf_info );
     }
 
-    res = fd_vm_validate( vm );
-    if( FD_UNLIKELY( res ) ) {
+    if( FD_UNLIKELY( !fd_bpf_load_and_validate( validated_prog, &elf_info, program_data, program_data_len, syscalls,
+                                                slot_ctx->slot_bank.slot, &slot_ctx->epoch_ctx->features, direct_mapping,
+                                                runtime_spad ) ) ) {
       /* Remove pending funk record */
-      FD_LOG_DEBUG(( "fd_vm_validate() failed" ));
       fd_funk_rec_cancel( funk, prepare );
       return -1;
     }
 
-    fd_memcpy( validated_prog->calldests_shmem, prog->calldests_shmem, fd_sbpf_calldests_footprint( prog->rodata_sz/8UL ) );
-    validated_prog->calldests = fd_sbpf_calldests_join( validated_prog->calldests_shmem );
-
-    validated_prog->entry_pc = prog->entry_pc;
     validated_prog->last_updated_slot = slot_ctx->slot_bank.slot;
-    validated_prog->text_off = prog->text_off;
-    validated_prog->text_cnt = prog->text_cnt;
-    validated_prog->text_sz = prog->text_sz;
-    validated_prog->rodata_sz = prog->rodata_sz;
+    validated_prog->key = *progcache_key;
+
+    if( slot_ctx->progcache ) {
+      fd_progcache_insert( slot_ctx->progcache, progcache_key, progcache_addr, val, val_footprint );
+    }
 
     fd_funk_rec_publish( funk, prepare );
 
@@ -323,12 +412,97 @@ fd_bpf_check_and_create_bpf_program_cache_entry( fd_exec_slot_ctx_t * slot_ctx,
   }
 
   if( fd_bpf_create_bpf_program_cache_entry( slot_ctx, exec_rec, runtime_spad ) != 0 ) {
+    /* A modified upgradeable loader account that is not a program is a
+       programdata account being deployed, upgraded, extended or closed.
+       Entries loaded from it can no longer be hit (the progcache is
+       content addressed) so drop them now rather than waiting for them
+       to age out. */
+    if( slot_ctx->progcache &&
+        !memcmp( exec_rec->vt->get_owner( exec_rec ), fd_solana_bpf_loader_upgradeable_program_id.key, sizeof(fd_pubkey_t) ) ) {
+      fd_progcache_invalidate( slot_ctx->progcache, pubkey );
+    }
     return -1;
   }
 
   return 0;
 }
 
+int
+fd_bpf_progcache_warm( fd_progcache_t *      progcache,
+                       fd_pubkey_t const *   addr,
+                       fd_pubkey_t const *   owner,
+                       uchar const *         data,
+                       ulong                 data_len,
+                       ulong                 slot,
+                       fd_features_t *       features,
+                       fd_spad_t *           runtime_spad ) {
+
+  /* Find the program bytes.  Program accounts of the upgradeable loader
+     hold no bytes, their programdata account is warmed instead. */
+
+  uchar const * program_data     = data;
+  ulong         program_data_len = data_len;
+  if( !memcmp( owner, fd_solana_bpf_loader_upgradeable_program_id.key, sizeof(fd_pubkey_t) ) ) {
+    if( data_len<PROGRAMDATA_METADATA_SIZE || FD_LOAD( uint, data )!=fd_bpf_upgradeable_loader_state_enum_program_data ) return -1;
+    program_data     += PROGRAMDATA_METADATA_SIZE;
+    program_data_len -= PROGRAMDATA_METADATA_SIZE;
+  } else if( !memcmp( owner, fd_solana_bpf_loader_v4_program_id.key, sizeof(fd_pubkey_t) ) ) {
+    if( data_len<LOADER_V4_PROGRAM_DATA_OFFSET ) return -1;
+    program_data     += LOADER_V4_PROGRAM_DATA_OFFSET;
+    program_data_len -= LOADER_V4_PROGRAM_DATA_OFFSET;
+  } else if( memcmp( owner, fd_solana_bpf_loader_deprecated_program_id.key, sizeof(fd_pubkey_t) ) &&
+             memcmp( owner, fd_solana_bpf_loader_program_id.key,            sizeof(fd_pubkey_t) ) ) {
+    return -1;
+  }
+
+  FD_SPAD_FRAME_BEGIN( runtime_spad ) {
+
+    fd_sbpf_elf_info_t elf_info = {0};
+    uint min_sbpf_version, max_sbpf_version;
+    fd_bpf_get_sbpf_versions( &min_sbpf_version, &max_sbpf_version, slot, features );
+    if( fd_sbpf_elf_peek( &elf_info, program_data, program_data_len, /* deploy checks */ 0, min_sbpf_version, max_sbpf_version ) == NULL ) {
+      return -1;
+    }
+
+    /* Skip programs that do not fit in the remaining scratch space
+       (the exec tile spad is sized for transactions, not programs). */
+
+    ulong val_footprint  = fd_sbpf_validated_program_footprint( &elf_info );
+    ulong prog_footprint = fd_sbpf_program_footprint( &elf_info );
+    ulong scratch_sz     = val_footprint + prog_footprint + fd_sbpf_syscalls_footprint() + 3UL*128UL + 512UL;
+    if( FD_UNLIKELY( fd_spad_alloc_max( runtime_spad, 128UL )<scratch_sz ) ) {
+      return -1;
+    }
+
+    fd_sbpf_syscalls_t * syscalls = fd_sbpf_syscalls_new( fd_spad_alloc( runtime_spad, fd_sbpf_syscalls_align(), fd_sbpf_syscalls_footprint() ) );
+    if( FD_UNLIKELY( !syscalls ) ) {
+      FD_LOG_ERR(( "Call to fd_sbpf_syscalls_new() failed" ));
+    }
+    fd_vm_syscall_register_slot( syscalls, slot, features, 0 );
+
+    int direct_mapping = FD_FEATURE_ACTIVE( slot, *features, bpf_account_data_direct_mapping );
+
+    fd_progcache_key_t progcache_key[1];
+    fd_bpf_progcache_key( progcache_key, program_data, program_data_len, min_sbpf_version, max_sbpf_version, direct_mapping, syscalls );
+
+    void * val = fd_spad_alloc( runtime_spad, fd_sbpf_validated_program_align(), val_footprint );
+    if( fd_progcache_query( progcache, progcache_key, val, val_footprint ) ) {
+      return 0;
+    }
+
+    fd_sbpf_validated_program_t * validated_prog = fd_sbpf_validated_program_new( val, &elf_info );
+    if( FD_UNLIKELY( !fd_bpf_load_and_validate( validated_prog, &elf_info, program_data, program_data_len, syscalls,
+                                                slot, features, direct_mapping, runtime_spad ) ) ) {
+      return -1;
+    }
+    validated_prog->last_updated_slot = slot;
+    validated_prog->key               = *progcache_key;
+
+    return fd_progcache_insert( progcache, progcache_key, addr, val, val_footprint ) ? 0 : -1;
+
+  } FD_SPAD_FRAME_END;
+}
+
 void
 fd_bpf_is_bpf_program( fd_funk_rec_t const * rec,
                        fd_wksp_t *           funk_wksp,
@@ -4,6 +4,7 @@
 #include "../../fd_flamenco_base.h"
 #include "../fd_runtime_public.h"
 #include "../fd_acc_mgr.h"
+#include "../fd_progcache.h"
 #include "../context/fd_exec_slot_ctx.h"
 #include "../../vm/syscall/fd_vm_syscall.h"
 
@@ -31,6 +32,11 @@ struct fd_sbpf_validated_program {
 
   /* SBPF version, SIMD-0161 */
   ulong sbpf_version;
+
+  /* Content address of the program (the ELF and the loader
+     configuration, see fd_bpf_progcache_key).  Also keys compiled code
+     in the sBPF JIT cache. */
+  fd_progcache_key_t key;
 };
 typedef struct fd_sbpf_validated_program fd_sbpf_validated_program_t;
 
@@ -63,6 +69,28 @@ int
 fd_bpf_scan_and_create_bpf_program_cache_entry( fd_exec_slot_ctx_t * slot_ctx,
                                                 fd_spad_t *          runtime_spad );
 
+/* fd_bpf_progcache_warm loads and validates the program held by the
+   account addr (owner, [data,data+data_len)) under the loader
+   configuration of slot and features and inserts the result into
+   progcache, so that a later fd_bpf_scan_and_create_bpf_program_cache_entry
+   finds it there.  The account can be a v1 / v2 / v4 program or an
+   upgradeable loader programdata account.  This is only an
+   optimization (the progcache is content addressed) and can run on any
+   tile joined to progcache, concurrently with replay.  Returns 0 if the
+   program is in progcache on return and -1 otherwise (not a program,
+   fails to load / validate or does not fit in the free space of
+   runtime_spad). */
+
+int
+fd_bpf_progcache_warm( fd_progcache_t *      progcache,
+                       fd_pubkey_t const *   addr,
+                       fd_pubkey_t const *   owner,
+                       uchar const *         data,
+                       ulong                 data_len,
+                       ulong                 slot,
+                       fd_features_t *       features,
+                       fd_spad_t *           runtime_spad );
+
 void
 fd_bpf_is_bpf_program( fd_funk_rec_t const * rec,
                        fd_wksp_t *           funk_wksp,
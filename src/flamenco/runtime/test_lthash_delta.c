@@ -0,0 +1,308 @@
+#include "fd_hashes.h"
+#include "fd_acc_mgr.h"
+#include "fd_txn_account.h"
+#include "context/fd_exec_slot_ctx.h"
+
+#define WKSP_TAG (1UL)
+#define ACC_CNT  (256UL)  /* accounts [0,PAR_CNT) exist at the start of the slot */
+#define PAR_CNT  (192UL)
+#define DLEN_MAX (512UL)
+#define SLOT     (100UL)
+
+static fd_pubkey_t acc_key[ ACC_CNT ];
+
+/* randomize writes a random account value into meta.  The stored
+   account hash is random too, such that the slot end always sees the
+   account as changed. */
+
+static void
+randomize( fd_account_meta_t * meta,
+           fd_rng_t *          rng ) {
+  ulong dlen = fd_rng_ulong_roll( rng, DLEN_MAX+1UL );
+  meta->dlen          = dlen;
+  meta->info.lamports = fd_rng_uint_roll( rng, 8U ) ? 1UL+fd_rng_ulong_roll( rng, 1000000UL ) : 0UL;
+  meta->info.executable = (uchar)( fd_rng_uint( rng ) & 1U );
+  for( ulong i=0UL; i<32UL; i++ ) meta->info.owner[ i ] = fd_rng_uchar( rng );
+  for( ulong i=0UL; i<32UL; i++ ) meta->hash[ i ]       = fd_rng_uchar( rng );
+  uchar * data = (uchar *)meta + meta->hlen;
+  for( ulong i=0UL; i<dlen; i++ ) data[ i ] = fd_rng_uchar( rng );
+}
+
+/* slot_write modifies an account in place in funk, as done outside of
+   transaction execution (sysvars, rewards, fees ...). */
+
+static void
+slot_write( fd_funk_t *     funk,
+            fd_funk_txn_t * txn,
+            ulong           acc_idx,
+            fd_rng_t *      rng ) {
+  FD_TXN_ACCOUNT_DECL( acct );
+  FD_TEST( !fd_txn_account_init_from_funk_mutable( acct, &acc_key[ acc_idx ], funk, txn, 1, DLEN_MAX ) );
+  randomize( acct->private_state.meta, rng );
+  fd_txn_account_mutable_fini( acct, funk, txn );
+}
+
+/* txn_write modifies an account like a transaction does: the account
+   is copied into a buffer of the executing tile and saved back into
+   funk at finalization. */
+
+static void
+txn_write( fd_funk_t *         funk,
+           fd_funk_txn_t *     txn,
+           fd_wksp_t *         wksp,
+           fd_lthash_delta_t * delta,
+           ulong               shard_idx,
+           ulong               acc_idx,
+           fd_rng_t *          rng ) {
+  FD_TXN_ACCOUNT_DECL( acct );
+  if( fd_txn_account_init_from_funk_readonly( acct, &acc_key[ acc_idx ], funk, txn ) ) {
+    fd_txn_account_init( acct );
+    fd_memcpy( acct->pubkey, &acc_key[ acc_idx ], sizeof(fd_pubkey_t) );
+  }
+
+  void * buf = fd_wksp_alloc_laddr( wksp, FD_ACCOUNT_META_ALIGN, sizeof(fd_account_meta_t)+DLEN_MAX, WKSP_TAG );
+  FD_TEST( buf );
+  fd_txn_account_make_mutable( acct, buf, wksp );
+  randomize( acct->private_state.meta, rng );
+
+  FD_TEST( !fd_account_save_lthash( acct, funk, txn, wksp, delta, shard_idx ) );
+  fd_wksp_free_laddr( buf );
+}
+
+static void
+acc_lthash( fd_lthash_value_t *       lthash,
+            fd_account_meta_t const * meta,
+            fd_pubkey_t const *       key ) {
+  fd_lthash_zero( lthash );
+  if( !meta || !meta->info.lamports ) return;
+  fd_hash_t hash[1];
+  fd_hash_account( hash->hash, lthash, meta, key, (uchar const *)meta + meta->hlen, FD_HASH_JUST_LTHASH, NULL );
+}
+
+/* expected_lthash returns the change of the accounts lthash caused by
+   the funk transaction txn, computed from scratch. */
+
+static void
+expected_lthash( fd_lthash_value_t * out,
+                 fd_funk_t *         funk,
+                 fd_funk_txn_t *     txn ) {
+  fd_funk_txn_t const * par = fd_funk_txn_parent( txn, fd_funk_txn_pool( funk ) );
+  fd_lthash_zero( out );
+  for( ulong i=0UL; i<ACC_CNT; i++ ) {
+    fd_funk_rec_key_t   key = fd_funk_acc_key( &acc_key[ i ] );
+    fd_funk_rec_query_t query[1];
+    if( !fd_funk_rec_query_try( funk, txn, &key, query ) ) continue;
+
+    fd_lthash_value_t lthash[1];
+    acc_lthash( lthash, fd_funk_get_acc_meta_readonly( funk, txn, &acc_key[ i ], NULL, NULL, NULL ), &acc_key[ i ] );
+    fd_lthash_add( out, lthash );
+    acc_lthash( lthash, fd_funk_get_acc_meta_readonly( funk, par, &acc_key[ i ], NULL, NULL, NULL ), &acc_key[ i ] );
+    fd_lthash_sub( out, lthash );
+  }
+}
+
+static int
+lthash_eq( fd_lthash_value_t const * a,
+           fd_lthash_value_t const * b ) {
+  return !memcmp( a, b, sizeof(fd_lthash_value_t) );
+}
+
+static int
+lthash_is_zero( fd_lthash_value_t const * a ) {
+  fd_lthash_value_t zero[1]; fd_lthash_zero( zero );
+  return lthash_eq( a, zero );
+}
+
+/* slot_end_lthash computes the change of the accounts lthash the way
+   bank hashing at the end of the slot does.  Returns the number of
+   accounts whose change was taken from the delta. */
+
+static ulong
+slot_end_lthash( fd_lthash_value_t *   out,
+                 fd_exec_slot_ctx_t *  slot_ctx,
+                 fd_spad_t *           spad,
+                 ulong *               opt_stale_mask ) {
+  ulong done_cnt = 0UL;
+  FD_SPAD_FRAME_BEGIN( spad ) {
+    fd_accounts_hash_task_data_t task_data[1];
+    fd_collect_modified_accounts( slot_ctx, task_data, spad );
+
+    fd_lthash_zero( out );
+    for( ulong i=0UL; i<task_data->info_sz; i++ ) {
+      fd_account_hash( slot_ctx->funk, slot_ctx->funk_txn, &task_data->info[ i ], out, SLOT, NULL );
+      done_cnt += task_data->info[ i ].lthash_done;
+    }
+    if( slot_ctx->lthash_delta ) {
+      fd_lthash_delta_merge( slot_ctx->lthash_delta, &slot_ctx->funk_txn->xid, task_data->lthash_stale_mask, out );
+    }
+    if( opt_stale_mask ) *opt_stale_mask = task_data->lthash_stale_mask;
+  } FD_SPAD_FRAME_END;
+  return done_cnt;
+}
+
+static void
+test_delta( fd_wksp_t * wksp ) {
+  ulong shard_cnt = 3UL;
+
+  FD_TEST( !fd_lthash_delta_footprint( 0UL ) );
+  FD_TEST( fd_lthash_delta_footprint( shard_cnt ) );
+  FD_TEST( !fd_lthash_delta_new( NULL, shard_cnt ) );
+  void * mem = fd_wksp_alloc_laddr( wksp, fd_lthash_delta_align(), fd_lthash_delta_footprint( shard_cnt ), WKSP_TAG );
+  FD_TEST( mem );
+  FD_TEST( !fd_lthash_delta_new( mem, 0UL ) );
+  FD_TEST( !fd_lthash_delta_join( mem ) );
+  fd_lthash_delta_t * delta = fd_lthash_delta_join( fd_lthash_delta_new( mem, shard_cnt ) );
+  FD_TEST( delta );
+  FD_TEST( fd_lthash_delta_shard_cnt( delta )==shard_cnt );
+
+  fd_funk_txn_xid_t xid0 = { .ul = { 1UL, 1UL } };
+  fd_funk_txn_xid_t xid1 = { .ul = { 2UL, 2UL } };
+  fd_lthash_value_t out[1]; fd_lthash_zero( out );
+  FD_TEST( !fd_lthash_delta_is_tracking( delta, &xid0 ) );
+  FD_TEST( !fd_lthash_delta_merge( delta, &xid0, 0UL, out ) );
+
+  fd_lthash_delta_begin( delta, &xid0 );
+  FD_TEST(  fd_lthash_delta_is_tracking( delta, &xid0 ) );
+  FD_TEST( !fd_lthash_delta_is_tracking( delta, &xid1 ) );
+
+  /* Every bucket holds a distinct value, merge sums the non-stale ones */
+
+  fd_lthash_value_t expected[1]; fd_lthash_zero( expected );
+  for( ulong s=0UL; s<shard_cnt; s++ ) {
+    for( ulong b=0UL; b<FD_LTHASH_DELTA_BUCKET_CNT; b++ ) {
+      fd_lthash_value_t * bucket = fd_lthash_delta_bucket( delta, s, b );
+      for( ulong i=0UL; i<FD_LTHASH_LEN_ELEMS; i++ ) bucket->words[ i ] = (ushort)( 1UL+s*FD_LTHASH_DELTA_BUCKET_CNT+b+i );
+      if( b!=3UL ) fd_lthash_add( expected, bucket );
+    }
+  }
+  FD_TEST( !fd_lthash_delta_merge( delta, &xid1, 1UL<<3, out ) );
+  FD_TEST( lthash_is_zero( out ) );
+  FD_TEST( fd_lthash_delta_merge( delta, &xid0, 1UL<<3, out ) );
+  FD_TEST( lthash_eq( out, expected ) );
+
+  /* begin resets the buckets */
+
+  fd_lthash_delta_begin( delta, &xid1 );
+  fd_lthash_zero( out );
+  FD_TEST( fd_lthash_delta_merge( delta, &xid1, 0UL, out ) );
+  FD_TEST( lthash_is_zero( out ) );
+
+  FD_TEST( fd_lthash_delta_leave( delta )==mem );
+  FD_TEST( fd_lthash_delta_delete( mem )==mem );
+  FD_TEST( !fd_lthash_delta_join( mem ) );
+  fd_wksp_free_laddr( mem );
+}
+
+static void
+test_slot( fd_wksp_t * wksp,
+           fd_rng_t *  rng,
+           float       slot_write_frac,
+           int         track ) {
+  ulong txn_max = 16UL;
+  uint  rec_max = 4096U;
+  void * funk_mem = fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint( txn_max, rec_max ), WKSP_TAG );
+  FD_TEST( funk_mem );
+  fd_funk_t _funk[1];
+  fd_funk_t * funk = fd_funk_join( _funk, fd_funk_new( funk_mem, WKSP_TAG, 1234UL, txn_max, rec_max ) );
+  FD_TEST( funk );
+
+  ulong shard_cnt = 4UL;
+  void * delta_mem = fd_wksp_alloc_laddr( wksp, fd_lthash_delta_align(), fd_lthash_delta_footprint( shard_cnt ), WKSP_TAG );
+  fd_lthash_delta_t * delta = fd_lthash_delta_join( fd_lthash_delta_new( delta_mem, shard_cnt ) );
+  FD_TEST( delta );
+
+  ulong  spad_max = 1UL<<20;
+  void * spad_mem = fd_wksp_alloc_laddr( wksp, fd_spad_align(), fd_spad_footprint( spad_max ), WKSP_TAG );
+  fd_spad_t * spad = fd_spad_join( fd_spad_new( spad_mem, spad_max ) );
+  FD_TEST( spad );
+
+  for( ulong i=0UL; i<ACC_CNT; i++ ) {
+    for( ulong j=0UL; j<4UL; j++ ) acc_key[ i ].ul[ j ] = fd_rng_ulong( rng );
+  }
+
+  /* The parent slot creates the accounts existing at the start of the
+     slot, the slot under test starts with a few slot level writes */
+
+  fd_funk_txn_xid_t par_xid = { .ul = { SLOT-1UL, SLOT-1UL } };
+  fd_funk_txn_xid_t cur_xid = { .ul = { SLOT,     SLOT     } };
+  fd_funk_txn_t * root = fd_funk_txn_query( fd_funk_last_publish( funk ), fd_funk_txn_map( funk ) );
+  fd_funk_txn_t * par  = fd_funk_txn_prepare( funk, root, &par_xid, 1 );
+  FD_TEST( par );
+  for( ulong i=0UL; i<PAR_CNT; i++ ) slot_write( funk, par, i, rng );
+  fd_funk_txn_t * cur  = fd_funk_txn_prepare( funk, par, &cur_xid, 1 );
+  FD_TEST( cur );
+
+  fd_lthash_delta_begin( delta, track ? &cur_xid : &par_xid );
+  for( ulong i=0UL; i<8UL; i++ ) slot_write( funk, cur, fd_rng_ulong_roll( rng, ACC_CNT ), rng );
+
+  uint slot_write_thresh = (uint)( slot_write_frac*(float)UINT_MAX );
+  for( ulong op=0UL; op<2048UL; op++ ) {
+    ulong acc_idx = fd_rng_ulong_roll( rng, ACC_CNT );
+    if( fd_rng_uint( rng )<slot_write_thresh ) slot_write( funk, cur, acc_idx, rng );
+    else txn_write( funk, cur, wksp, delta, fd_rng_ulong_roll( rng, shard_cnt ), acc_idx, rng );
+  }
+
+  fd_lthash_value_t expected[1];
+  expected_lthash( expected, funk, cur );
+
+  fd_exec_slot_ctx_t slot_ctx[1];
+  fd_memset( slot_ctx, 0, sizeof(fd_exec_slot_ctx_t) );
+  slot_ctx->funk     = funk;
+  slot_ctx->funk_txn = cur;
+
+  /* Bank hashing without a delta hashes everything from scratch */
+
+  fd_lthash_value_t full[1];
+  FD_TEST( !slot_end_lthash( full, slot_ctx, spad, NULL ) );
+  FD_TEST( lthash_eq( full, expected ) );
+
+  /* Bank hashing with the delta only hashes what was not accumulated */
+
+  slot_ctx->lthash_delta = delta;
+  fd_lthash_value_t incr[1];
+  ulong stale_mask = 0UL;
+  ulong done_cnt   = slot_end_lthash( incr, slot_ctx, spad, &stale_mask );
+  FD_TEST( lthash_eq( incr, expected ) );
+
+  FD_LOG_NOTICE(( "slot_write_frac %.3f track %d: %lu accounts from delta, stale bucket mask %016lx",
+                  (double)slot_write_frac, track, done_cnt, stale_mask ));
+  if( !track ) {
+    FD_TEST( !done_cnt );
+  } else {
+    FD_TEST( done_cnt );
+    if( slot_write_frac==0.0f ) FD_TEST( !stale_mask );
+  }
+
+  fd_wksp_free_laddr( fd_spad_delete( fd_spad_leave( spad ) ) );
+  fd_wksp_free_laddr( fd_lthash_delta_delete( fd_lthash_delta_leave( delta ) ) );
+  void * shfunk;
+  FD_TEST( fd_funk_leave( funk, &shfunk ) );
+  fd_wksp_free_laddr( fd_funk_delete( shfunk ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "normal"                );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 32768UL                 );
+  ulong        numa_idx = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx", NULL, fd_shmem_numa_idx( 0 ) );
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 1234U, 0UL ) );
+
+  test_delta( wksp );
+  test_slot( wksp, rng, 0.00f, 1 );
+  test_slot( wksp, rng, 0.002f, 1 );
+  test_slot( wksp, rng, 0.05f,  0 );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
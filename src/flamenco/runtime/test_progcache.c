@@ -0,0 +1,188 @@
+#include "fd_progcache.h"
+
+#define WKSP_TAG (2UL)
+
+static fd_progcache_key_t
+make_key( ulong seed ) {
+  fd_progcache_key_t key;
+  for( ulong i=0UL; i<4UL; i++ ) FD_STORE( ulong, key.hash + 8UL*i, fd_ulong_hash( seed+i ) );
+  key.features = 0x1234UL;
+  return key;
+}
+
+static fd_pubkey_t
+make_addr( ulong seed ) {
+  fd_pubkey_t addr = {0};
+  addr.ul[ 0 ] = seed;
+  return addr;
+}
+
+static void
+fill( uchar * buf,
+      ulong   sz,
+      ulong   seed ) {
+  for( ulong i=0UL; i<sz; i++ ) buf[ i ] = (uchar)fd_ulong_hash( seed ^ i );
+}
+
+static fd_progcache_t *
+cache_new( fd_wksp_t * wksp,
+           ulong       set_cnt,
+           ulong       data_max ) {
+  void * mem = fd_wksp_alloc_laddr( wksp, fd_progcache_align(), fd_progcache_footprint( set_cnt ), 1UL );
+  FD_TEST( mem );
+  fd_progcache_t * cache = fd_progcache_join( fd_progcache_new( mem, set_cnt, data_max, WKSP_TAG ) );
+  FD_TEST( cache );
+  return cache;
+}
+
+static void
+cache_delete( fd_wksp_t *      wksp,
+              fd_progcache_t * cache ) {
+  void * mem = fd_progcache_delete( fd_progcache_leave( cache ) );
+  FD_TEST( mem );
+
+  fd_wksp_usage_t usage[1];
+  ulong tag = WKSP_TAG;
+  fd_wksp_usage( wksp, &tag, 1UL, usage );
+  FD_TEST( !usage->used_cnt );
+
+  fd_wksp_free_laddr( mem );
+}
+
+static void
+test_basic( fd_wksp_t * wksp ) {
+  FD_TEST( !fd_progcache_footprint( 0UL ) );
+  FD_TEST( !fd_progcache_footprint( 3UL ) );
+  FD_TEST( fd_progcache_footprint( 4UL ) );
+
+  uchar dummy[ 4096 ] __attribute__((aligned(FD_PROGCACHE_ALIGN)));
+  FD_TEST( !fd_progcache_new( NULL, 1UL, 1UL, WKSP_TAG ) );
+  FD_TEST( !fd_progcache_new( dummy, 1UL, 1UL, WKSP_TAG ) ); /* not in a wksp */
+  FD_TEST( !fd_progcache_join( NULL ) );
+
+  fd_progcache_t * cache = cache_new( wksp, 16UL, 1UL<<20 );
+
+  uchar img[ 1000 ];
+  uchar out[ 1000 ];
+  fill( img, sizeof(img), 1UL );
+
+  fd_progcache_key_t k0 = make_key( 0UL );
+  fd_progcache_key_t k1 = make_key( 1UL );
+  fd_pubkey_t        a0 = make_addr( 0UL );
+  fd_pubkey_t        a1 = make_addr( 1UL );
+
+  FD_TEST( !fd_progcache_query( cache, &k0, out, sizeof(out) ) );
+  FD_TEST( fd_progcache_insert( cache, &k0, &a0, img, sizeof(img) ) );
+  FD_TEST( fd_progcache_query( cache, &k0, out, sizeof(out) ) );
+  FD_TEST( !memcmp( img, out, sizeof(img) ) );
+
+  /* Size mismatch and feature digest mismatch are misses */
+
+  FD_TEST( !fd_progcache_query( cache, &k0, out, sizeof(out)-1UL ) );
+  fd_progcache_key_t k0f = k0; k0f.features++;
+  FD_TEST( !fd_progcache_query( cache, &k0f, out, sizeof(out) ) );
+
+  /* Reinserting an existing key is a no-op */
+
+  FD_TEST( fd_progcache_insert( cache, &k0, &a0, img, sizeof(img) ) );
+  FD_TEST( fd_progcache_insert( cache, &k1, &a1, img, sizeof(img)/2UL ) );
+
+  fd_progcache_metrics_t m[1];
+  fd_progcache_metrics_snap( cache, m );
+  FD_TEST( m->hit_cnt==1UL && m->miss_cnt==3UL && m->insert_cnt==2UL && m->evict_cnt==0UL );
+  FD_TEST( m->data_sz==sizeof(img)+sizeof(img)/2UL );
+
+  FD_TEST( fd_progcache_invalidate( cache, &a0 )==1UL );
+  FD_TEST( fd_progcache_invalidate( cache, &a0 )==0UL );
+  FD_TEST( !fd_progcache_query( cache, &k0, out, sizeof(out) ) );
+  FD_TEST( fd_progcache_query( cache, &k1, out, sizeof(img)/2UL ) );
+  FD_TEST( !memcmp( img, out, sizeof(img)/2UL ) );
+
+  fd_progcache_metrics_snap( cache, m );
+  FD_TEST( m->invalidate_cnt==1UL && m->data_sz==sizeof(img)/2UL );
+
+  /* Images larger than data_max are rejected */
+
+  static uchar big[ (1UL<<20)+1UL ];
+  FD_TEST( !fd_progcache_insert( cache, &k0, &a0, big, sizeof(big) ) );
+
+  cache_delete( wksp, cache );
+}
+
+static void
+test_evict( fd_wksp_t * wksp ) {
+
+  /* With a single set, the set is full after WAY_CNT inserts and the
+     least recently used entry gets evicted. */
+
+  fd_progcache_t * cache = cache_new( wksp, 1UL, 1UL<<20 );
+
+  uchar img[ 256 ];
+  uchar out[ 256 ];
+  fd_pubkey_t addr = make_addr( 0UL );
+  for( ulong i=0UL; i<FD_PROGCACHE_WAY_CNT; i++ ) {
+    fd_progcache_key_t k = make_key( i );
+    fill( img, sizeof(img), i );
+    FD_TEST( fd_progcache_insert( cache, &k, &addr, img, sizeof(img) ) );
+  }
+
+  fd_progcache_key_t k0 = make_key( 0UL );
+  FD_TEST( fd_progcache_query( cache, &k0, out, sizeof(out) ) ); /* make key 1 the LRU */
+
+  fd_progcache_key_t kn = make_key( FD_PROGCACHE_WAY_CNT );
+  FD_TEST( fd_progcache_insert( cache, &kn, &addr, img, sizeof(img) ) );
+
+  fd_progcache_key_t k1 = make_key( 1UL );
+  FD_TEST( !fd_progcache_query( cache, &k1, out, sizeof(out) ) );
+  FD_TEST(  fd_progcache_query( cache, &k0, out, sizeof(out) ) );
+  FD_TEST(  fd_progcache_query( cache, &kn, out, sizeof(out) ) );
+
+  fd_progcache_metrics_t m[1];
+  fd_progcache_metrics_snap( cache, m );
+  FD_TEST( m->evict_cnt==1UL && m->data_sz==FD_PROGCACHE_WAY_CNT*sizeof(img) );
+
+  cache_delete( wksp, cache );
+
+  /* With a data budget of 3 images, the 4th insert evicts the least
+     recently used image even if its set has room. */
+
+  cache = cache_new( wksp, 64UL, 3UL*sizeof(img) );
+  for( ulong i=0UL; i<4UL; i++ ) {
+    fd_progcache_key_t k = make_key( i );
+    fill( img, sizeof(img), i );
+    FD_TEST( fd_progcache_insert( cache, &k, &addr, img, sizeof(img) ) );
+    FD_TEST( fd_progcache_query( cache, &k, out, sizeof(out) ) );
+    FD_TEST( !memcmp( img, out, sizeof(img) ) );
+  }
+  FD_TEST( !fd_progcache_query( cache, &k0, out, sizeof(out) ) );
+  fd_progcache_metrics_snap( cache, m );
+  FD_TEST( m->data_sz==3UL*sizeof(img) );
+
+  FD_TEST( fd_progcache_invalidate( cache, &addr )==3UL );
+  fd_progcache_metrics_snap( cache, m );
+  FD_TEST( !m->data_sz );
+
+  cache_delete( wksp, cache );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "normal"                     );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 4096UL                       );
+  ulong        numa_idx = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx", NULL, fd_shmem_numa_idx( 0 )      );
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  test_basic( wksp );
+  test_evict( wksp );
+
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
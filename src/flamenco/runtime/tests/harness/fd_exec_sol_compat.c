@@ -23,6 +23,8 @@
 #include "generated/vm.pb.h"
 #include "generated/type.pb.h"
 
+#include "../../../vm/jit/fd_vm_jit_cache.h"
+
 /* FIXME: Spad isn't properly sized out or cleaned up */
 
 /* This file defines stable APIs for compatibility testing.
@@ -44,6 +46,20 @@ static sol_compat_features_t features;
 static uchar *               spad_mem;
 static fd_wksp_t *           wksp = NULL;
 
+/* If the SOL_COMPAT_JIT environment variable is non-zero, BPF programs
+   in instr, txn and vm_interp fixtures run through the sBPF JIT
+   (contrib/test/run_test_vectors.sh does a second pass over these
+   fixtures with it set).  Compiled code is kept across fixtures
+   (programs are content addressed). */
+
+#if FD_HAS_X86
+#define SOL_COMPAT_JIT_PROGRAM_MAX (1024UL)
+#define SOL_COMPAT_JIT_CODE_SZ     (256UL<<20)
+static fd_vm_jit_cache_t *   jit_cache;
+static uchar *               jit_code_rw;
+static uchar *               jit_code_rx;
+#endif
+
 #define WKSP_EXECUTE_ALLOC_TAG (2UL)
 #define WKSP_INIT_ALLOC_TAG    (3UL)
 
@@ -103,6 +119,18 @@ sol_compat_wksp_init( ulong wksp_page_sz ) {
       memcpy( &features.supported_features[features.supported_feature_cnt++], &current_feature->id, sizeof(ulong) );
     }
   }
+
+  if( fd_env_strip_cmdline_int( NULL, NULL, NULL, "SOL_COMPAT_JIT", 0 ) ) {
+#if FD_HAS_X86
+    FD_TEST( !fd_vm_jit_code_map( SOL_COMPAT_JIT_CODE_SZ, &jit_code_rw, &jit_code_rx ) );
+    void * jit_cache_mem = fd_wksp_alloc_laddr( wksp, fd_vm_jit_cache_align(), fd_vm_jit_cache_footprint( SOL_COMPAT_JIT_PROGRAM_MAX ), WKSP_INIT_ALLOC_TAG );
+    jit_cache = fd_vm_jit_cache_join( fd_vm_jit_cache_new( jit_cache_mem, SOL_COMPAT_JIT_PROGRAM_MAX, jit_code_rw, jit_code_rx, SOL_COMPAT_JIT_CODE_SZ ) );
+    FD_TEST( jit_cache );
+    FD_LOG_NOTICE(( "sBPF JIT enabled" ));
+#else
+    FD_LOG_ERR(( "SOL_COMPAT_JIT is only supported on x86-64" ));
+#endif
+  }
 }
 
 void
@@ -110,6 +138,17 @@ sol_compat_fini( void ) {
   fd_wksp_free_laddr( spad_mem );
   fd_wksp_free_laddr( features.hardcoded_features );
   fd_wksp_free_laddr( features.supported_features );
+#if FD_HAS_X86
+  if( jit_cache ) {
+    fd_vm_jit_cache_metrics_t const * m = fd_vm_jit_cache_metrics( jit_cache );
+    FD_LOG_NOTICE(( "sBPF JIT: %lu hits, %lu compiles, %lu failed, %lu flushes", m->hit_cnt, m->miss_cnt, m->fail_cnt, m->flush_cnt ));
+    fd_wksp_free_laddr( fd_vm_jit_cache_delete( fd_vm_jit_cache_leave( jit_cache ) ) );
+    fd_vm_jit_code_unmap( jit_code_rw, jit_code_rx, SOL_COMPAT_JIT_CODE_SZ );
+    jit_cache   = NULL;
+    jit_code_rw = NULL;
+    jit_code_rx = NULL;
+  }
+#endif
   fd_wksp_delete_anonymous( wksp );
   wksp     = NULL;
   spad_mem = NULL;
@@ -136,6 +175,9 @@ sol_compat_setup_runner( void ) {
   // Setup test runner
   void * runner_mem = fd_wksp_alloc_laddr( wksp, fd_runtime_fuzz_runner_align(), fd_runtime_fuzz_runner_footprint(), WKSP_EXECUTE_ALLOC_TAG );
   fd_runtime_fuzz_runner_t * runner = fd_runtime_fuzz_runner_new( runner_mem, spad_mem, WKSP_EXECUTE_ALLOC_TAG );
+#if FD_HAS_X86
+  if( FD_LIKELY( runner ) ) runner->vm_jit = jit_cache;
+#endif
   return runner;
 }
 
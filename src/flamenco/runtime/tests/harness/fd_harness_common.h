@@ -13,6 +13,10 @@ struct fd_runtime_fuzz_runner {
   fd_funk_t   funk[1];
   fd_wksp_t * wksp;
   fd_spad_t * spad;
+
+  /* If non-NULL, sBPF programs run through the JIT (see
+     fd_exec_txn_ctx_t::vm_jit) */
+  fd_vm_jit_cache_t * vm_jit;
 };
 typedef struct fd_runtime_fuzz_runner fd_runtime_fuzz_runner_t;
 
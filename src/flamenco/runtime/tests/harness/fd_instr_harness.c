@@ -39,6 +39,7 @@ fd_runtime_fuzz_instr_ctx_create( fd_runtime_fuzz_runner_t *           runner,
   assert( slot_ctx  );
 
   ctx->txn_ctx = txn_ctx;
+  txn_ctx->vm_jit = runner->vm_jit;
 
   /* Set up epoch context. Defaults obtained from GenesisConfig::Default() */
   fd_epoch_bank_t * epoch_bank = fd_exec_epoch_ctx_epoch_bank( epoch_ctx );
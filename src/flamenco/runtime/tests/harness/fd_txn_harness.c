@@ -289,6 +289,7 @@ fd_runtime_fuzz_txn_ctx_exec( fd_runtime_fuzz_runner_t * runner,
   /* Setup the spad for account allocation */
   task_info->txn_ctx->spad      = runner->spad;
   task_info->txn_ctx->spad_wksp = fd_wksp_containing( runner->spad );
+  task_info->txn_ctx->vm_jit    = runner->vm_jit;
 
   fd_runtime_pre_execute_check( task_info, 0 );
 
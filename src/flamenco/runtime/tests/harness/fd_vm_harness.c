@@ -1,4 +1,6 @@
 #include "fd_vm_harness.h"
+#include "../../../vm/jit/fd_vm_jit_cache.h"
+#include "../../../../ballet/sha256/fd_sha256.h"
 
 static int
 fd_runtime_fuzz_vm_syscall_noop( void * _vm,
@@ -288,7 +290,28 @@ do{
     if( DUMP_TRACE ) fd_vm_trace_printf( trace, syscalls );
     fd_vm_trace_delete( fd_vm_trace_leave( trace ) );
   } else {
+#if FD_HAS_X86 && FD_HAS_HOSTED
+    /* With SOL_COMPAT_JIT, run the program through the sBPF JIT so that
+       every vm_interp fixture also checks the compiled code.  Fixtures
+       reuse the same text with different entry points, call whitelists
+       and versions, so these are part of the cache key. */
+    fd_vm_jit_t const * jit = NULL;
+    if( runner->vm_jit ) {
+      fd_vm_jit_cache_key_t jit_key[1];
+      fd_sha256_t sha[1];
+      fd_sha256_init( sha );
+      fd_sha256_append( sha, rodata,    rodata_sz                              );
+      fd_sha256_append( sha, calldests, ((max_pc+63UL)/64UL)*sizeof(ulong)     );
+      fd_sha256_append( sha, &entry_pc, sizeof(ulong)                          );
+      fd_sha256_fini( sha, jit_key->hash );
+      jit_key->tag = input->vm_ctx.sbpf_version;
+      jit = fd_vm_jit_cache_acquire( runner->vm_jit, jit_key, vm->text, vm->text_cnt, vm->entry_pc, vm->calldests, vm->sbpf_version );
+    }
+    exec_res = jit ? fd_vm_exec_jit( vm, jit ) : fd_vm_exec_notrace( vm );
+    fd_vm_jit_cache_release( runner->vm_jit, jit );
+#else
     exec_res = fd_vm_exec_notrace( vm );
+#endif
   }
 
   /* Agave does not have a SIGCALL error, and instead throws SIGILL */
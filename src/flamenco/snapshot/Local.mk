@@ -33,5 +33,6 @@ $(call add-hdrs,fd_snapshot_create.h)
 $(call add-objs,fd_snapshot_create,fd_flamenco)
 
 $(call make-bin,fd_snapshot,fd_snapshot_main,fd_flamenco fd_disco fd_funk fd_ballet fd_util,$(SECP256K1_LIBS))
+$(call make-unit-test,bench_snapshot_restore,bench_snapshot_restore,fd_flamenco fd_disco fd_funk fd_ballet fd_util,$(SECP256K1_LIBS))
 endif
 endif
@@ -0,0 +1,130 @@
+/* bench_snapshot_restore measures the throughput of restoring accounts
+   from a local snapshot file (.tar.zst) into a fresh funk database.
+   The AppendVecs are restored on all tiles but the first one (see
+   fd_snapshot_restore_set_tpool); run with a single tile to measure
+   the serial restore.  Reports compressed input GB/s, AppendVec GB/s
+   and accounts/s.
+
+   Example:
+
+     bench_snapshot_restore --snapshot snapshot-123-abc.tar.zst \
+       --page-sz gigantic --page-cnt 256 --rec-max 1073741824 \
+       --tile-cpus 1-17 */
+
+#include "fd_snapshot_loader.h"
+#include "../../ballet/zstd/fd_zstd.h"
+
+#include <errno.h>
+#include <sys/stat.h>
+
+static uchar _tpool[ FD_TPOOL_FOOTPRINT( FD_TILE_MAX ) ] __attribute__((aligned(FD_TPOOL_ALIGN)));
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz       = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",        NULL,      "gigantic" );
+  ulong        page_cnt       = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",       NULL,             5UL );
+  ulong        near_cpu       = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu",       NULL, fd_log_cpu_id() );
+  ulong        zstd_window_sz = fd_env_strip_cmdline_ulong( &argc, &argv, "--zstd-window-sz", NULL,      33554432UL );
+  ulong        rec_max        = fd_env_strip_cmdline_ulong( &argc, &argv, "--rec-max",        NULL,      1UL<<24    );
+  ulong        buf_sz         = fd_env_strip_cmdline_ulong( &argc, &argv, "--buf-sz",         NULL, FD_SNAPSHOT_RESTORE_PARA_BUF_SZ );
+  char const * snapshot       = fd_env_strip_cmdline_cstr ( &argc, &argv, "--snapshot",       NULL,            NULL );
+
+  if( FD_UNLIKELY( !snapshot ) ) {
+    FD_LOG_WARNING(( "skip: no --snapshot specified" ));
+    fd_halt();
+    return 0;
+  }
+
+  struct stat st;
+  if( FD_UNLIKELY( 0!=stat( snapshot, &st ) ) ) FD_LOG_ERR(( "stat(%s) failed (%d-%s)", snapshot, errno, fd_io_strerror( errno ) ));
+  ulong file_sz = (ulong)st.st_size;
+
+  FD_LOG_NOTICE(( "Creating workspace (--page-cnt %lu, --page-sz %s)", page_cnt, _page_sz ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  FD_TEST( wksp );
+
+  ulong       spad_max = zstd_window_sz + (1UL<<32); /* manifest plus 4 GiB headroom */
+  fd_spad_t * spad     = fd_spad_join( fd_spad_new( fd_wksp_alloc_laddr( wksp, FD_SPAD_ALIGN, FD_SPAD_FOOTPRINT( spad_max ), 1UL ), spad_max ) );
+  FD_TEST( spad );
+  fd_spad_push( spad );
+
+  FD_LOG_NOTICE(( "Creating funk (--rec-max %lu)", rec_max ));
+  ulong const txn_max  = 16UL;
+  ulong const funk_tag = 42UL;
+  void * funk_mem = fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint( txn_max, rec_max ), funk_tag );
+  FD_TEST( funk_mem );
+  fd_funk_t funk_[1];
+  fd_funk_t * funk = fd_funk_join( funk_, fd_funk_new( funk_mem, funk_tag, 0x3c7ac4a9d5f0f8a1UL, txn_max, rec_max ) );
+  FD_TEST( funk );
+
+  fd_snapshot_restore_t * restore = fd_snapshot_restore_new(
+      fd_spad_alloc( spad, fd_snapshot_restore_align(), fd_snapshot_restore_footprint() ),
+      funk, NULL, spad, NULL, NULL, NULL, NULL );
+  FD_TEST( restore );
+
+  fd_snapshot_loader_t * loader = fd_snapshot_loader_new(
+      fd_spad_alloc( spad, fd_snapshot_loader_align(), fd_snapshot_loader_footprint( zstd_window_sz ) ),
+      zstd_window_sz );
+  FD_TEST( loader );
+
+  fd_snapshot_src_t src[1] = {{ .type = FD_SNAPSHOT_SRC_FILE, .file = { .path = snapshot } }};
+  FD_TEST( fd_snapshot_loader_init( loader, restore, src, 0UL, 0 ) );
+
+  /* Load the manifest, then time the account restore */
+
+  for(;;) {
+    int err = fd_snapshot_loader_advance( loader );
+    if( err==MANIFEST_DONE ) break;
+    if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "Failed to load manifest (%d)", err ));
+  }
+
+  ulong        tile_cnt = fd_tile_cnt();
+  fd_tpool_t * tpool    = NULL;
+  if( tile_cnt>1UL ) {
+    tpool = fd_tpool_init( _tpool, tile_cnt );
+    FD_TEST( tpool );
+    for( ulong tile_idx=1UL; tile_idx<tile_cnt; tile_idx++ )
+      FD_TEST( fd_tpool_worker_push( tpool, tile_idx, NULL, 0UL ) );
+    FD_TEST( fd_snapshot_restore_set_tpool( restore, tpool, 1UL, tile_cnt, buf_sz ) );
+  }
+  FD_LOG_NOTICE(( "Restoring accounts with %lu worker(s) (--buf-sz %lu)", fd_ulong_max( tile_cnt-1UL, 1UL ), buf_sz ));
+
+  ulong acc_cnt0 = fd_snapshot_restore_get_acc_cnt( restore );
+  ulong accv_sz0 = fd_snapshot_restore_get_accv_sz( restore );
+  long  dt       = -fd_log_wallclock();
+  for(;;) {
+    int err = fd_snapshot_loader_advance( loader );
+    if( err==-1 ) break;
+    if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "Failed to load snapshot (%d)", err ));
+  }
+  dt += fd_log_wallclock();
+
+  ulong acc_cnt = fd_snapshot_restore_get_acc_cnt( restore ) - acc_cnt0;
+  ulong accv_sz = fd_snapshot_restore_get_accv_sz( restore ) - accv_sz0;
+  double ns     = (double)dt;
+  FD_LOG_NOTICE(( "restored %lu accounts (%lu AppendVec bytes) from %lu snapshot bytes in %.3f s",
+                  acc_cnt, accv_sz, file_sz, ns*1e-9 ));
+  FD_LOG_NOTICE(( "~%.3f GB/s snapshot, ~%.3f GB/s AppendVec, ~%.3e accounts/s",
+                  (double)file_sz/ns, (double)accv_sz/ns, (double)acc_cnt*1e9/ns ));
+
+  /* Clean up */
+
+  fd_snapshot_loader_delete( loader );
+  fd_snapshot_restore_delete( restore );
+  if( tpool ) {
+    for( ulong tile_idx=tile_cnt-1UL; tile_idx>0UL; tile_idx-- ) FD_TEST( fd_tpool_worker_pop( tpool ) );
+    fd_tpool_fini( tpool );
+  }
+  fd_funk_leave( funk, NULL );
+  fd_wksp_free_laddr( fd_funk_delete( funk_mem ) );
+  fd_spad_pop( spad );
+  fd_wksp_free_laddr( fd_spad_delete( fd_spad_leave( spad ) ) );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -404,6 +404,13 @@ fd_snapshot_load_all( const char *         source_cstr,
   fd_runtime_update_slots_per_epoch( slot_ctx, FD_DEFAULT_SLOTS_PER_EPOCH );
   fd_snapshot_load_manifest_and_status_cache( ctx, base_slot_override,
     FD_SNAPSHOT_RESTORE_STATUS_CACHE | FD_SNAPSHOT_RESTORE_MANIFEST );
+
+  /* Restore AppendVecs on the tpool if we have one.  Stays serial if
+     the runtime spad can't fit the worker buffers. */
+  if( tpool && fd_tpool_worker_cnt( tpool )>1UL ) {
+    fd_snapshot_restore_set_tpool( ctx->restore, tpool, 1UL, fd_tpool_worker_cnt( tpool ), FD_SNAPSHOT_RESTORE_PARA_BUF_SZ );
+  }
+
   fd_snapshot_load_accounts( ctx );
   fd_snapshot_load_fini( ctx );
 
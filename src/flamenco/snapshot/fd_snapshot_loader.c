@@ -209,7 +209,9 @@ fd_snapshot_loader_advance( fd_snapshot_loader_t * dumper ) {
     /* Finished reading the manifest for the first time. */
     return MANIFEST_DONE;
   } else if( untar_err<0 ) {
-    /* EOF */
+    /* EOF.  Wait for any parallel restore work to complete. */
+    int drain_err = fd_snapshot_restore_drain( dumper->restore );
+    if( FD_UNLIKELY( drain_err ) ) return drain_err;
     return -1;
   } else {
     FD_LOG_WARNING(( "Failed to load snapshot (%d-%s)", untar_err, fd_io_strerror( untar_err ) ));
@@ -9,8 +9,9 @@
 
    This header provides high-level APIs for streaming loading of a
    snapshot from the local file system or over HTTP (regular sockets).
-   The loader is currently a single-threaded streaming pipeline.  This
-   is subject to change to the tile architecture in the future. */
+   The loader is a streaming pipeline running on the caller's thread.
+   Account restore can optionally be offloaded to a thread pool (see
+   fd_snapshot_restore_set_tpool). */
 
 #include "fd_snapshot.h"
 #include "fd_snapshot_istream.h"
@@ -79,7 +80,8 @@ fd_snapshot_loader_init( fd_snapshot_loader_t *    loader,
    is synchronously passed down the pipeline (ending in a manifest
    callback and new funk record insertions).  This is the primary
    polling entrypoint into fd_snapshot_loader_t.  Returns 0 if advance
-   was successful.  Returns -1 on successful EOF.  On failure, returns
+   was successful.  Returns -1 on successful EOF (at which point all
+   parallel restore work, if any, has completed).  On failure, returns
    errno-compatible code and logs error. */
 
 int
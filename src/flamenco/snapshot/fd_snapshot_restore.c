@@ -119,6 +119,7 @@ fd_snapshot_restore_new( void *                                         mem,
 void *
 fd_snapshot_restore_delete( fd_snapshot_restore_t * self ) {
   if( FD_UNLIKELY( !self ) ) return NULL;
+  fd_snapshot_restore_drain( self );
   fd_snapshot_restore_discard_buf( self );
   fd_snapshot_accv_map_delete( fd_snapshot_accv_map_leave( self->accv_map ) );
   fd_memset( self, 0, sizeof(fd_snapshot_restore_t) );
@@ -152,13 +153,19 @@ fd_snapshot_expect_account_hdr( fd_snapshot_restore_t * restore ) {
   return 0;
 }
 
-/* fd_snapshot_restore_account_hdr deserializes an account header and
-   allocates a corresponding funk record. */
+/* fd_snapshot_restore_account_insert creates the funk record for the
+   account described by hdr (found in AppendVec accv_slot.accv_id),
+   unless a newer revision of the account already exists.  On success,
+   returns 0 and sets *acc_data to the location that the account data
+   should be copied to (NULL if the account was skipped).  Safe to call
+   concurrently for distinct accounts. */
 
 static int
-fd_snapshot_restore_account_hdr( fd_snapshot_restore_t * restore ) {
-
-  fd_solana_account_hdr_t const * hdr = fd_type_pun_const( restore->buf );
+fd_snapshot_restore_account_insert( fd_snapshot_restore_t *         restore,
+                                    fd_solana_account_hdr_t const * hdr,
+                                    ulong                           accv_slot,
+                                    ulong                           accv_id,
+                                    uchar **                        acc_data ) {
 
   /* Prepare for account lookup */
   fd_funk_t *         funk     = restore->funk;
@@ -167,40 +174,58 @@ fd_snapshot_restore_account_hdr( fd_snapshot_restore_t * restore ) {
   FD_TXN_ACCOUNT_DECL( rec );
   char key_cstr[ FD_BASE58_ENCODED_32_SZ ];
 
+  *acc_data = NULL;
+
   /* Sanity checks */
   if( FD_UNLIKELY( hdr->meta.data_len > FD_ACC_SZ_MAX ) ) {
     FD_LOG_WARNING(( "accounts/%lu.%lu: account %s too large: data_len=%lu",
-                     restore->accv_slot, restore->accv_id, fd_acct_addr_cstr( key_cstr, key->uc ), hdr->meta.data_len ));
+                     accv_slot, accv_id, fd_acct_addr_cstr( key_cstr, key->uc ), hdr->meta.data_len ));
     FD_LOG_HEXDUMP_WARNING(( "account header", hdr, sizeof(fd_solana_account_hdr_t) ));
     return EINVAL;
   }
 
-  int is_dupe = 0;
-
   /* Check if account exists */
   fd_account_meta_t const * rec_meta = fd_funk_get_acc_meta_readonly( funk, funk_txn, key, NULL, NULL, NULL );
   if( rec_meta )
-    if( rec_meta->slot > restore->accv_slot )
-      is_dupe = 1;
+    if( rec_meta->slot > accv_slot )
+      return 0;  /* newer revision already restored */
 
   /* Write account */
-  if( !is_dupe ) {
-    int write_result = fd_txn_account_init_from_funk_mutable( rec, key, funk, funk_txn, /* do_create */ 1, hdr->meta.data_len );
-    if( FD_UNLIKELY( write_result != FD_ACC_MGR_SUCCESS ) ) {
-      FD_LOG_WARNING(( "fd_txn_account_init_from_funk_mutable(%s) failed (%d)", fd_acct_addr_cstr( key_cstr, key->uc ), write_result ));
-      return ENOMEM;
-    }
-    rec->vt->set_data_len( rec, hdr->meta.data_len );
-    rec->vt->set_slot( rec, restore->accv_slot );
-    rec->vt->set_hash( rec, &hdr->hash );
-    rec->vt->set_info( rec, &hdr->info );
-    if( rec->vt->get_meta( rec ) && rec->vt->get_lamports( rec ) && rec->vt->get_rent_epoch( rec ) != FD_RENT_EXEMPT_RENT_EPOCH ) {
-      restore->cb_rent_fresh_account( restore->cb_rent_fresh_account_ctx, key );
-    }
-    restore->acc_data = rec->vt->get_data_mut( rec );
-
-    fd_txn_account_mutable_fini( rec, funk, funk_txn );
+  int write_result = fd_txn_account_init_from_funk_mutable( rec, key, funk, funk_txn, /* do_create */ 1, hdr->meta.data_len );
+  if( FD_UNLIKELY( write_result != FD_ACC_MGR_SUCCESS ) ) {
+    FD_LOG_WARNING(( "fd_txn_account_init_from_funk_mutable(%s) failed (%d)", fd_acct_addr_cstr( key_cstr, key->uc ), write_result ));
+    return ENOMEM;
   }
+  rec->vt->set_data_len( rec, hdr->meta.data_len );
+  rec->vt->set_slot( rec, accv_slot );
+  rec->vt->set_hash( rec, &hdr->hash );
+  rec->vt->set_info( rec, &hdr->info );
+  if( rec->vt->get_meta( rec ) && rec->vt->get_lamports( rec ) && rec->vt->get_rent_epoch( rec ) != FD_RENT_EXEMPT_RENT_EPOCH &&
+      restore->cb_rent_fresh_account ) {
+    fd_rwlock_write( &restore->cb_lock );
+    restore->cb_rent_fresh_account( restore->cb_rent_fresh_account_ctx, key );
+    fd_rwlock_unwrite( &restore->cb_lock );
+  }
+  *acc_data = rec->vt->get_data_mut( rec );
+
+  fd_txn_account_mutable_fini( rec, funk, funk_txn );
+  return 0;
+}
+
+/* fd_snapshot_restore_account_hdr deserializes an account header and
+   allocates a corresponding funk record. */
+
+static int
+fd_snapshot_restore_account_hdr( fd_snapshot_restore_t * restore ) {
+
+  fd_solana_account_hdr_t const * hdr = fd_type_pun_const( restore->buf );
+  fd_pubkey_t const *             key = fd_type_pun_const( hdr->meta.pubkey );
+  char key_cstr[ FD_BASE58_ENCODED_32_SZ ];
+
+  int err = fd_snapshot_restore_account_insert( restore, hdr, restore->accv_slot, restore->accv_id, &restore->acc_data );
+  if( FD_UNLIKELY( err ) ) return err;
+  restore->acc_cnt++;
+
   ulong data_sz    = hdr->meta.data_len;
   restore->acc_sz  = data_sz;
   restore->acc_pad = fd_ulong_align_up( data_sz, FD_SNAPSHOT_ACC_ALIGN ) - data_sz;
@@ -224,6 +249,144 @@ fd_snapshot_restore_account_hdr( fd_snapshot_restore_t * restore ) {
   return 0;
 }
 
+/* Parallel restore ***************************************************/
+
+/* fd_snapshot_restore_accv_task restores all accounts of a buffered
+   AppendVec.  Runs on tpool thread worker_t0+m0.  Errors are reported
+   via worker->err. */
+
+static void
+fd_snapshot_restore_accv_task( void * tpool  FD_PARAM_UNUSED,
+                               ulong  t0     FD_PARAM_UNUSED, ulong t1     FD_PARAM_UNUSED,
+                               void * args,
+                               void * reduce FD_PARAM_UNUSED, ulong stride FD_PARAM_UNUSED,
+                               ulong  l0     FD_PARAM_UNUSED, ulong l1     FD_PARAM_UNUSED,
+                               ulong  m0,                     ulong m1     FD_PARAM_UNUSED,
+                               ulong  n0     FD_PARAM_UNUSED, ulong n1     FD_PARAM_UNUSED ) {
+
+  fd_snapshot_restore_t *        restore = args;
+  fd_snapshot_restore_worker_t * worker  = &restore->worker[ m0 ];
+
+  uchar const * cur     = worker->buf;
+  ulong         rem     = worker->accv_sz;
+  ulong         acc_cnt = 0UL;
+  char key_cstr[ FD_BASE58_ENCODED_32_SZ ];
+
+  while( rem ) {
+    if( FD_UNLIKELY( rem < sizeof(fd_solana_account_hdr_t) ) ) {
+      FD_LOG_WARNING(( "accounts/%lu.%lu: encountered unexpected EOF while reading account header",
+                       worker->accv_slot, worker->accv_id ));
+      worker->err = EINVAL;
+      return;
+    }
+    fd_solana_account_hdr_t const * hdr = fd_type_pun_const( cur );
+    fd_pubkey_t const *             key = fd_type_pun_const( hdr->meta.pubkey );
+    cur += sizeof(fd_solana_account_hdr_t);
+    rem -= sizeof(fd_solana_account_hdr_t);
+
+    ulong data_sz = hdr->meta.data_len;
+    if( FD_UNLIKELY( rem < data_sz ) ) {
+      FD_LOG_WARNING(( "accounts/%lu.%lu: account %s data exceeds past end of account vec (acc_sz=%lu accv_sz=%lu)",
+                       worker->accv_slot, worker->accv_id, fd_acct_addr_cstr( key_cstr, key->uc ), data_sz, rem ));
+      FD_LOG_HEXDUMP_WARNING(( "account header", hdr, sizeof(fd_solana_account_hdr_t) ));
+      worker->err = EINVAL;
+      return;
+    }
+
+    /* Serialize with other workers restoring the same account */
+    fd_rwlock_t * lock = &restore->key_lock[ fd_ulong_hash( FD_LOAD( ulong, key->uc ) ) & (FD_SNAPSHOT_RESTORE_KEY_LOCK_CNT-1UL) ];
+    fd_rwlock_write( lock );
+    uchar * acc_data;
+    int err = fd_snapshot_restore_account_insert( restore, hdr, worker->accv_slot, worker->accv_id, &acc_data );
+    if( FD_LIKELY( !err && acc_data ) ) fd_memcpy( acc_data, cur, data_sz );
+    fd_rwlock_unwrite( lock );
+    if( FD_UNLIKELY( err ) ) {
+      worker->err = err;
+      return;
+    }
+
+    ulong pad_sz = fd_ulong_min( fd_ulong_align_up( data_sz, FD_SNAPSHOT_ACC_ALIGN ) - data_sz, rem - data_sz );
+    cur += data_sz + pad_sz;
+    rem -= data_sz + pad_sz;
+    acc_cnt++;
+  }
+
+  FD_ATOMIC_FETCH_AND_ADD( &restore->acc_cnt,  acc_cnt         );
+  FD_ATOMIC_FETCH_AND_ADD( &restore->accv_tot, worker->accv_sz );
+}
+
+/* fd_snapshot_restore_worker_wait waits for worker idx to go idle.
+   Returns the worker's error code (0 on success) and marks restore as
+   failed if the worker failed. */
+
+static int
+fd_snapshot_restore_worker_wait( fd_snapshot_restore_t * restore,
+                                 ulong                   idx ) {
+  fd_tpool_wait( restore->tpool, restore->worker_t0 + idx );
+  int err = FD_VOLATILE_CONST( restore->worker[ idx ].err );
+  if( FD_UNLIKELY( err ) ) restore->failed = 1;
+  return err;
+}
+
+int
+fd_snapshot_restore_drain( fd_snapshot_restore_t * restore ) {
+  if( !restore->tpool ) return 0;
+  int err = 0;
+  for( ulong i=0UL; i<restore->worker_cnt; i++ ) {
+    int worker_err = fd_snapshot_restore_worker_wait( restore, i );
+    if( !err ) err = worker_err;
+  }
+  if( FD_UNLIKELY( err ) ) FD_LOG_WARNING(( "parallel snapshot restore failed (%d-%s)", err, fd_io_strerror( err ) ));
+  return err;
+}
+
+fd_snapshot_restore_t *
+fd_snapshot_restore_set_tpool( fd_snapshot_restore_t * restore,
+                               fd_tpool_t *            tpool,
+                               ulong                   t0,
+                               ulong                   t1,
+                               ulong                   buf_sz ) {
+
+  if( FD_UNLIKELY( restore->tpool ) ) {
+    FD_LOG_WARNING(( "tpool already set" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !tpool ) ) {
+    FD_LOG_WARNING(( "NULL tpool" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !( (1UL<=t0) & (t0<t1) & (t1<=fd_tpool_worker_cnt( tpool )) ) ) ) {
+    FD_LOG_WARNING(( "invalid tpool thread range [%lu,%lu)", t0, t1 ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !buf_sz ) ) {
+    FD_LOG_WARNING(( "zero buf_sz" ));
+    return NULL;
+  }
+
+  ulong worker_cnt = t1 - t0;
+  ulong footprint  = worker_cnt*sizeof(fd_snapshot_restore_worker_t) + worker_cnt*fd_ulong_align_up( buf_sz, FD_SPAD_ALIGN );
+  if( FD_UNLIKELY( footprint > fd_spad_alloc_max( restore->spad, FD_SPAD_ALIGN ) ) ) {
+    FD_LOG_WARNING(( "insufficient spad space for %lu restore workers with %lu byte buffers", worker_cnt, buf_sz ));
+    return NULL;
+  }
+
+  fd_snapshot_restore_worker_t * worker = fd_spad_alloc( restore->spad, alignof(fd_snapshot_restore_worker_t), worker_cnt*sizeof(fd_snapshot_restore_worker_t) );
+  for( ulong i=0UL; i<worker_cnt; i++ ) {
+    worker[ i ] = (fd_snapshot_restore_worker_t) {
+      .buf     = fd_spad_alloc( restore->spad, FD_SPAD_ALIGN, buf_sz ),
+      .buf_cap = buf_sz
+    };
+  }
+
+  restore->worker      = worker;
+  restore->worker_t0   = t0;
+  restore->worker_cnt  = worker_cnt;
+  restore->worker_next = 0UL;
+  restore->tpool       = tpool;
+  return restore;
+}
+
 /* fd_snapshot_accv_index populates the index of account vecs.  This
    index will be used when loading accounts.  Returns errno-compatible
    error code. */
@@ -414,6 +577,27 @@ fd_snapshot_restore_accv_prepare( fd_snapshot_restore_t * const restore,
   restore->accv_slot = slot;
   restore->accv_id   = id;
 
+  if( restore->tpool ) {
+    fd_snapshot_restore_worker_t * worker = &restore->worker[ restore->worker_next ];
+    if( FD_LIKELY( sz <= worker->buf_cap ) ) {
+
+      /* Buffer the AppendVec for the next worker in line */
+      if( FD_UNLIKELY( fd_snapshot_restore_worker_wait( restore, restore->worker_next ) ) ) return EINVAL;
+      worker->buf_ctr   = 0UL;
+      worker->accv_slot = slot;
+      worker->accv_id   = id;
+      worker->accv_sz   = sz;
+      restore->state    = sz ? STATE_READ_ACCV_PARA : STATE_IGNORE;
+      FD_LOG_DEBUG(( "Buffering account vec %s", meta->name ));
+      return 0;
+    }
+
+    /* Too large to buffer.  Fall back to a serial restore, which must
+       not race with the workers. */
+    if( FD_UNLIKELY( fd_snapshot_restore_drain( restore ) ) ) return EINVAL;
+  }
+  restore->accv_tot += sz;
+
   /* Prepare read of account header */
   FD_LOG_DEBUG(( "Loading account vec %s", meta->name ));
   return fd_snapshot_expect_account_hdr( restore );
@@ -604,6 +788,33 @@ fd_snapshot_read_account_chunk( fd_snapshot_restore_t * restore,
   return buf;
 }
 
+/* fd_snapshot_read_accv_para_chunk reads partial AppendVec content into
+   a worker buffer.  Dispatches the worker once the AppendVec is
+   complete. */
+
+static uchar const *
+fd_snapshot_read_accv_para_chunk( fd_snapshot_restore_t * restore,
+                                  uchar const *           buf,
+                                  ulong                   bufsz ) {
+
+  ulong                          idx    = restore->worker_next;
+  fd_snapshot_restore_worker_t * worker = &restore->worker[ idx ];
+
+  ulong sz = fd_ulong_min( bufsz, worker->accv_sz - worker->buf_ctr );
+  fd_memcpy( worker->buf + worker->buf_ctr, buf, sz );
+  worker->buf_ctr += sz;
+
+  if( worker->buf_ctr == worker->accv_sz ) {
+    worker->err = 0;
+    fd_tpool_exec( restore->tpool, restore->worker_t0 + idx, fd_snapshot_restore_accv_task,
+                   NULL, 0UL, 0UL, restore, NULL, 0UL, 0UL, 0UL, idx, 0UL, 0UL, 0UL );
+    restore->worker_next = (idx+1UL) % restore->worker_cnt;
+    restore->state       = STATE_IGNORE;  /* skip trailing garbage */
+  }
+
+  return buf+sz;
+}
+
 /* fd_snapshot_read_manifest_chunk reads partial manifest content. */
 
 static uchar const *
@@ -661,6 +872,8 @@ fd_snapshot_restore_chunk1( fd_snapshot_restore_t * restore,
     return fd_snapshot_read_account_hdr_chunk  ( restore, buf, bufsz );
   case STATE_READ_ACCOUNT_DATA:
     return fd_snapshot_read_account_chunk      ( restore, buf, bufsz );
+  case STATE_READ_ACCV_PARA:
+    return fd_snapshot_read_accv_para_chunk    ( restore, buf, bufsz );
   case STATE_READ_MANIFEST:
     return fd_snapshot_read_manifest_chunk     ( restore, buf, bufsz );
   case STATE_READ_STATUS_CACHE:
@@ -704,6 +917,16 @@ fd_snapshot_restore_get_slot( fd_snapshot_restore_t * restore ) {
   return restore->slot;
 }
 
+ulong
+fd_snapshot_restore_get_acc_cnt( fd_snapshot_restore_t * restore ) {
+  return FD_VOLATILE_CONST( restore->acc_cnt );
+}
+
+ulong
+fd_snapshot_restore_get_accv_sz( fd_snapshot_restore_t * restore ) {
+  return FD_VOLATILE_CONST( restore->accv_tot );
+}
+
 /* fd_snapshot_restore_t implements the consumer interface of a TAR
    reader. */
 
@@ -11,12 +11,23 @@
    individual snapshot files.  (The outer layers, such as the TAR stream
    and Zstandard compression, are managed by fd_snapshot_load).
 
+   By default, all restore work runs on the caller's thread.  Optionally,
+   AppendVec parsing and account insertion can be fanned out to a thread
+   pool (see fd_snapshot_restore_set_tpool), in which case the caller's
+   thread only decompresses and untars, and buffers each AppendVec for a
+   worker:
+
+     read => unzstd => untar => buffer ==> worker 1: parse => insert
+                                       ==> worker 2: parse => insert
+                                       ==> ...
+
    The snapshot format contains complex data structures without size
    restrictions.  This API will effectively make an unbounded amount of
    heap allocations while loading a snapshot. */
 
 #include "fd_snapshot_base.h"
 #include "../../util/archive/fd_tar.h"
+#include "../../util/tpool/fd_tpool.h"
 #include "../runtime/context/fd_exec_slot_ctx.h"
 
 /* We want to exit out of snapshot loading once the manifest has been loaded in.
@@ -28,6 +39,13 @@
 #define MANIFEST_DONE_NOT_SEEN (1)
 #define MANIFEST_DONE_SEEN     (2)
 
+/* FD_SNAPSHOT_RESTORE_PARA_BUF_SZ is the recommended per-worker buffer
+   size for parallel restore.  Almost all AppendVecs in a mainnet
+   snapshot fit.  Larger AppendVecs are restored on the caller's
+   thread. */
+
+#define FD_SNAPSHOT_RESTORE_PARA_BUF_SZ (16UL<<20) /* 16 MiB */
+
 /* fd_snapshot_restore_t implements a streaming TAR reader that parses
    archive records on the fly.  Records include the manifest (at the
    start of the file), and account data.  Notably, this object does on-
@@ -119,8 +137,8 @@ fd_snapshot_restore_new( void *                                         mem,
                          fd_snapshot_restore_cb_rent_fresh_account_fn_t cb_rent_fresh_account );
 
 /* fd_snapshot_restore_delete destroys the given restore object and
-   frees any resources.  Returns allocated memory region back to
-   caller. */
+   frees any resources.  Waits for any in-flight parallel restore work
+   to finish.  Returns allocated memory region back to caller. */
 
 void *
 fd_snapshot_restore_delete( fd_snapshot_restore_t * self );
@@ -145,11 +163,62 @@ fd_snapshot_restore_chunk( void *       restore,
                            void const * buf,
                            ulong        bufsz );
 
-/* fd_snapshot_restore_tar_vt implements fd_tar_read_vtable_t. */
+/* fd_snapshot_restore_set_tpool configures restore to parse AppendVec
+   files and insert their accounts on tpool threads [t0,t1).  Each
+   worker gets a buf_sz byte buffer allocated from the restore spad
+   (FD_SNAPSHOT_RESTORE_PARA_BUF_SZ is a reasonable default).  The
+   caller's thread copies each AppendVec that fits into the next
+   worker's buffer and dispatches it; AppendVecs that don't fit are
+   restored on the caller's thread after all workers went idle.
+
+   Concurrent inserts of the same account are serialized with a striped
+   lock keyed by account address, so the newest revision of an account
+   wins as in the serial case.  Ties (the same account appearing twice
+   in AppendVecs of the same slot) resolve in unspecified order.
+
+   The funk transaction restored into must not be modified by the
+   caller while restore work is in flight (see
+   fd_snapshot_restore_drain).  cb_rent_fresh_account may be called
+   from worker threads (calls are serialized).
+
+   Must be called before the first AppendVec is provided.  Assumes
+   tpool threads [t0,t1) are idle and not used by the caller while the
+   restore object is active.  Returns restore on success.  On failure
+   (invalid range or insufficient spad space), logs a warning and
+   returns NULL, leaving restore in serial mode. */
+
+fd_snapshot_restore_t *
+fd_snapshot_restore_set_tpool( fd_snapshot_restore_t * restore,
+                               fd_tpool_t *            tpool,
+                               ulong                   t0,
+                               ulong                   t1,
+                               ulong                   buf_sz );
+
+/* fd_snapshot_restore_drain waits for all in-flight parallel restore
+   work to finish.  Returns 0 on success or an errno-compatible error
+   code if any worker failed (logs details).  No-op when restore is in
+   serial mode.  fd_snapshot_loader_advance calls this before reporting
+   EOF. */
+
+int
+fd_snapshot_restore_drain( fd_snapshot_restore_t * restore );
 
 ulong
 fd_snapshot_restore_get_slot( fd_snapshot_restore_t * restore );
 
+/* fd_snapshot_restore_get_{acc_cnt,accv_sz} return the number of
+   account records and the number of AppendVec bytes restored so far.
+   Only counts completed work (call fd_snapshot_restore_drain first for
+   an exact count). */
+
+ulong
+fd_snapshot_restore_get_acc_cnt( fd_snapshot_restore_t * restore );
+
+ulong
+fd_snapshot_restore_get_accv_sz( fd_snapshot_restore_t * restore );
+
+/* fd_snapshot_restore_tar_vt implements fd_tar_read_vtable_t. */
+
 extern fd_tar_read_vtable_t const fd_snapshot_restore_tar_vt;
 
 FD_PROTOTYPES_END
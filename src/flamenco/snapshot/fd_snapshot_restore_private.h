@@ -2,6 +2,7 @@
 #define HEADER_fd_src_flamenco_snapshot_fd_snapshot_restore_private_h
 
 #include "fd_snapshot_restore.h"
+#include "../fd_rwlock.h"
 
 /* fd_valloc_limit_t wraps a heap allocator and keeps track of
    allocation quota.  Once exceeded, quota is set to 0UL and all
@@ -59,6 +60,31 @@ typedef struct fd_snapshot_accv_map fd_snapshot_accv_map_t;
 #define MAP_KEY_HASH(k0)      fd_snapshot_accv_key_hash(k0)
 #include "../../util/tmpl/fd_map.c"
 
+/* Parallel restore ***************************************************/
+
+/* fd_snapshot_restore_worker_t holds the state of a tpool thread that
+   restores a buffered AppendVec.  Fields other than err are only
+   modified by the caller's thread while the worker is idle. */
+
+struct fd_snapshot_restore_worker {
+  uchar * buf;      /* AppendVec content */
+  ulong   buf_cap;  /* byte capacity of buf */
+  ulong   buf_ctr;  /* number of bytes buffered so far */
+
+  ulong   accv_slot;
+  ulong   accv_id;
+  ulong   accv_sz;  /* AppendVec size (excluding trailing garbage) */
+
+  int     err;      /* written by worker, errno-compatible */
+};
+
+typedef struct fd_snapshot_restore_worker fd_snapshot_restore_worker_t;
+
+/* FD_SNAPSHOT_RESTORE_KEY_LOCK_CNT is the number of stripes in the
+   account address lock used for parallel inserts.  Power of 2. */
+
+#define FD_SNAPSHOT_RESTORE_KEY_LOCK_CNT (1024UL)
+
 /* Main snapshot restore **********************************************/
 
 struct fd_snapshot_restore {
@@ -108,6 +134,22 @@ struct fd_snapshot_restore {
 
   fd_snapshot_restore_cb_rent_fresh_account_fn_t cb_rent_fresh_account;
   void *                                         cb_rent_fresh_account_ctx;
+
+  /* Statistics */
+
+  ulong acc_cnt;   /* account records restored */
+  ulong accv_tot;  /* AppendVec bytes restored */
+
+  /* Parallel restore.  tpool==NULL implies serial mode. */
+
+  fd_tpool_t *                   tpool;
+  ulong                          worker_t0;    /* first tpool thread used */
+  ulong                          worker_cnt;   /* number of tpool threads used */
+  ulong                          worker_next;  /* index of next worker to dispatch to */
+  fd_snapshot_restore_worker_t * worker;       /* indexed [0,worker_cnt) */
+
+  fd_rwlock_t cb_lock;  /* serializes cb_rent_fresh_account */
+  fd_rwlock_t key_lock[ FD_SNAPSHOT_RESTORE_KEY_LOCK_CNT ];
 };
 
 /* STATE_{...} are the state IDs that control file processing in the
@@ -119,5 +161,6 @@ struct fd_snapshot_restore {
 #define STATE_READ_ACCOUNT_DATA ((uchar)3)  /* reading account data (direct copy into funk) */
 #define STATE_READ_STATUS_CACHE ((uchar)4)  /* reading status cache (buffered)*/
 #define STATE_DONE              ((uchar)5)  /* expect no more data */
+#define STATE_READ_ACCV_PARA    ((uchar)6)  /* reading AppendVec into worker buffer (buffered) */
 
 #endif /* HEADER_fd_src_flamenco_snapshot_fd_snapshot_restore_private_h */
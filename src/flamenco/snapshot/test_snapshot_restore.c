@@ -2,6 +2,7 @@
 #include "fd_snapshot_restore_private.h"
 #include "../runtime/fd_acc_mgr.h"
 #include <errno.h>
+#include <stdio.h>
 
 static void
 _set_accv_sz( fd_snapshot_restore_t * restore,
@@ -667,6 +668,132 @@ main( int     argc,
     fd_spad_pop( _spad );
   } while(0);
 
+  /* Test parallel restore.  Restores a series of AppendVecs (one per
+     slot) that overwrite each other's accounts and compares the result
+     against a reference.  The worker buffer is sized so that some
+     AppendVecs take the serial fallback path. */
+
+  static uchar _tpool[ FD_TPOOL_FOOTPRINT( FD_TILE_MAX ) ] __attribute__((aligned(FD_TPOOL_ALIGN)));
+  ulong tile_cnt = fd_tile_cnt();
+  if( tile_cnt>1UL ) do {
+    fd_tpool_t * tpool = fd_tpool_init( _tpool, tile_cnt );
+    FD_TEST( tpool );
+    for( ulong tile_idx=1UL; tile_idx<tile_cnt; tile_idx++ )
+      FD_TEST( fd_tpool_worker_push( tpool, tile_idx, NULL, 0UL ) );
+
+    fd_spad_push( _spad );
+    fd_snapshot_restore_t * restore = NEW_RESTORE_POST_MANIFEST();
+    FD_TEST( restore );
+    restore->funk_txn = fd_funk_txn_prepare( funk, NULL, xid, 0 );
+    FD_TEST( restore->funk_txn );
+
+#   define PARA_KEY_CNT   (64UL)
+#   define PARA_SLOT_CNT  (32UL)
+#   define PARA_ACCV_MAX  (16384UL)
+    ulong const buf_sz = 2048UL;
+
+    FD_TEST( !fd_snapshot_restore_set_tpool( restore, tpool, 0UL, tile_cnt,     buf_sz ) );  /* worker 0 is the caller */
+    FD_TEST( !fd_snapshot_restore_set_tpool( restore, tpool, 1UL, tile_cnt+1UL, buf_sz ) );  /* out of range */
+    FD_TEST( !fd_snapshot_restore_set_tpool( restore, tpool, 1UL, 1UL,          buf_sz ) );  /* empty range */
+    FD_TEST(  fd_snapshot_restore_set_tpool( restore, tpool, 1UL, tile_cnt,     buf_sz )==restore );
+
+    fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 1234U, 0UL ) );
+
+    ulong   ref_slot [ PARA_KEY_CNT ] = {0};  /* 0 implies absent */
+    ulong   ref_dlen [ PARA_KEY_CNT ];
+    uchar   ref_seed [ PARA_KEY_CNT ];
+    uchar * accv    = fd_spad_alloc( _spad, 8UL, PARA_ACCV_MAX );
+    ulong   acc_tot = 0UL;
+    ulong   accv_tot = 0UL;
+
+    for( ulong slot=1UL; slot<=PARA_SLOT_CNT; slot++ ) {
+
+      /* Build AppendVec with distinct keys */
+      ulong accv_sz  = 0UL;
+      ulong acc_cnt  = 1UL + fd_rng_ulong_roll( rng, 8UL ) + ( (slot%8UL)==0UL ? 48UL : 0UL );
+      ulong key_idx  = fd_rng_ulong_roll( rng, PARA_KEY_CNT );
+      acc_cnt = fd_ulong_min( acc_cnt, PARA_KEY_CNT );
+      for( ulong j=0UL; j<acc_cnt; j++ ) {
+        ulong dlen = fd_rng_ulong_roll( rng, 40UL );
+        uchar seed = fd_rng_uchar( rng );
+        ulong k    = (key_idx+j) % PARA_KEY_CNT;
+        fd_solana_account_hdr_t hdr = {
+          .meta = { .data_len = dlen, .pubkey = { (uchar)(k+1UL) } },
+          .info = { .lamports = slot*1000UL + k, .rent_epoch = ULONG_MAX }
+        };
+        ulong rec_sz = sizeof(fd_solana_account_hdr_t) + fd_ulong_align_up( dlen, FD_SNAPSHOT_ACC_ALIGN );
+        FD_TEST( accv_sz + rec_sz <= PARA_ACCV_MAX );
+        memcpy( accv+accv_sz, &hdr, sizeof(fd_solana_account_hdr_t) );
+        for( ulong b=0UL; b<fd_ulong_align_up( dlen, FD_SNAPSHOT_ACC_ALIGN ); b++ ) {
+          accv[ accv_sz+sizeof(fd_solana_account_hdr_t)+b ] = (uchar)( b<dlen ? seed+b : 0 );
+        }
+        accv_sz += rec_sz;
+        ref_slot[ k ] = slot;
+        ref_dlen[ k ] = dlen;
+        ref_seed[ k ] = seed;
+      }
+      acc_tot  += acc_cnt;
+      accv_tot += accv_sz;
+
+      /* Feed AppendVec in random chunks, followed by garbage */
+      ulong garbage_sz = fd_rng_ulong_roll( rng, 16UL );
+      FD_TEST( accv_sz + garbage_sz <= PARA_ACCV_MAX );
+      fd_memset( accv+accv_sz, 'G', garbage_sz );
+
+      _set_accv_sz( restore, slot, slot, accv_sz );
+      fd_tar_meta_t meta = { .typeflag = FD_TAR_TYPE_REGULAR };
+      snprintf( meta.name, sizeof(meta.name), "accounts/%lu.%lu", slot, slot );
+      FD_TEST( 0==fd_snapshot_restore_file( restore, &meta, accv_sz+garbage_sz ) );
+      FD_TEST( restore->state==( accv_sz<=buf_sz ? STATE_READ_ACCV_PARA : STATE_READ_ACCOUNT_HDR ) );
+      for( ulong off=0UL; off<accv_sz+garbage_sz; ) {
+        ulong chunk_sz = fd_ulong_min( 1UL+fd_rng_ulong_roll( rng, 256UL ), accv_sz+garbage_sz-off );
+        FD_TEST( 0==fd_snapshot_restore_chunk( restore, accv+off, chunk_sz ) );
+        off += chunk_sz;
+      }
+    }
+
+    FD_TEST( 0==fd_snapshot_restore_drain( restore ) );
+    FD_TEST( fd_snapshot_restore_get_acc_cnt( restore )==acc_tot  );
+    FD_TEST( fd_snapshot_restore_get_accv_sz( restore )==accv_tot );
+
+    for( ulong k=0UL; k<PARA_KEY_CNT; k++ ) {
+      fd_pubkey_t pubkey[1] = {{ .uc = { (uchar)(k+1UL) } }};
+      fd_account_meta_t const * acc = fd_funk_get_acc_meta_readonly( funk, restore->funk_txn, pubkey, NULL, NULL, NULL );
+      if( !ref_slot[ k ] ) { FD_TEST( !acc ); continue; }
+      FD_TEST( acc );
+      FD_TEST( acc->slot          == ref_slot[ k ]                 );
+      FD_TEST( acc->dlen          == ref_dlen[ k ]                 );
+      FD_TEST( acc->info.lamports == ref_slot[ k ]*1000UL + k      );
+      uchar const * data = (uchar const *)acc + acc->hlen;
+      for( ulong b=0UL; b<acc->dlen; b++ ) FD_TEST( data[ b ]==(uchar)( ref_seed[ k ]+b ) );
+    }
+
+    /* Worker failure is reported */
+
+    do {
+      fd_solana_account_hdr_t hdr = { .meta = { .data_len = 64UL } };
+      _set_accv_sz( restore, 1UL, 99UL, sizeof(fd_solana_account_hdr_t) );
+      fd_tar_meta_t meta = { .name = "accounts/1.99", .typeflag = FD_TAR_TYPE_REGULAR };
+      FD_TEST( 0==fd_snapshot_restore_file( restore, &meta, sizeof(fd_solana_account_hdr_t) ) );
+      FD_TEST( 0==fd_snapshot_restore_chunk( restore, &hdr, sizeof(fd_solana_account_hdr_t) ) );
+      FD_TEST( EINVAL==fd_snapshot_restore_drain( restore ) );
+      FD_TEST( restore->failed==1 );
+    } while(0);
+
+#   undef PARA_KEY_CNT
+#   undef PARA_SLOT_CNT
+#   undef PARA_ACCV_MAX
+
+    fd_rng_delete( fd_rng_leave( rng ) );
+    fd_funk_txn_cancel( funk, restore->funk_txn, 0 );
+    fd_snapshot_restore_delete( restore );
+    fd_spad_pop( _spad );
+
+    for( ulong tile_idx=tile_cnt-1UL; tile_idx>0UL; tile_idx-- ) FD_TEST( fd_tpool_worker_pop( tpool ) );
+    fd_tpool_fini( tpool );
+  } while(0);
+  else FD_LOG_NOTICE(( "skipping parallel restore test (use --tile-cpus to enable)" ));
+
 # undef NEW_RESTORE_POST_MANIFEST
 
   /* Clean up */
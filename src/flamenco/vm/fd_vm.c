@@ -627,6 +627,8 @@ fd_vm_init(
   vm->sbpf_version = sbpf_version;
   vm->syscalls = syscalls;
   vm->trace = trace;
+  vm->prof = NULL;
+  vm->prof_node = FD_VM_PROF_NODE_NULL;
   vm->sha = sha;
   vm->input_mem_regions = mem_regions;
   vm->input_mem_regions_cnt = mem_regions_cnt;
@@ -98,6 +98,9 @@ struct __attribute__((aligned(FD_VM_HOST_REGION_ALIGN))) fd_vm {
 
   fd_vm_trace_t * trace; /* Location to stream traces (no tracing if NULL) */
 
+  fd_vm_prof_t * prof;      /* Location to accumulate profile samples (no profiling if NULL, ignored if tracing) */
+  ulong          prof_node; /* Call stack node of this program in prof, see fd_vm_prof_node_insert */
+
   /* VM execution and syscall state */
 
   /* These are used to communicate the execution and syscall state to
@@ -224,7 +227,7 @@ FD_PROTOTYPES_BEGIN
    integer power of 2.  FOOTPRINT is a multiple of align. 
    These are provided to facilitate compile time declarations. */
 #define FD_VM_ALIGN     FD_VM_HOST_REGION_ALIGN
-#define FD_VM_FOOTPRINT (527808UL)
+#define FD_VM_FOOTPRINT (527824UL)
 
 /* fd_vm_{align,footprint} give the needed alignment and footprint
    of a memory region suitable to hold an fd_vm_t.
@@ -436,18 +439,24 @@ fd_vm_setup_state_for_execution( fd_vm_t * vm ) ;
    allowed to be part of consensus.
 
    fd_vm_exec_trace runs with tracing and requires vm to be attached to
-   a trace.  fd_vm_exec_notrace runs without without tracing even if vm
-   is attached to a trace. */
+   a trace.  fd_vm_exec_prof runs with sampling profiling (see
+   fd_vm_prof_t) and requires vm to be attached to a prof.
+   fd_vm_exec_notrace runs without without tracing or profiling even if
+   vm is attached to a trace or prof. */
 
 int
 fd_vm_exec_trace( fd_vm_t * vm );
 
+int
+fd_vm_exec_prof( fd_vm_t * vm );
+
 int
 fd_vm_exec_notrace( fd_vm_t * vm );
 
 static inline int
 fd_vm_exec( fd_vm_t * vm ) {
   if( FD_UNLIKELY( vm->trace ) ) return fd_vm_exec_trace  ( vm );
+  if( FD_UNLIKELY( vm->prof  ) ) return fd_vm_exec_prof   ( vm );
   else                           return fd_vm_exec_notrace( vm );
 }
 
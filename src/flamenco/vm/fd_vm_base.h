@@ -665,6 +665,197 @@ int
 fd_vm_trace_printf( fd_vm_trace_t      const * trace,
                     fd_sbpf_syscalls_t const * syscalls );
 
+FD_PROTOTYPES_END
+
+/* fd_vm_prof API *****************************************************/
+
+/* A fd_vm_prof_t is a sampling execution profile.  Unlike a trace, it
+   is cheap enough to leave attached to a vm in production.  It is a
+   shared memory histogram of the instructions executed and compute
+   units consumed, bucketed by (call stack,pc).
+
+   Call stacks are interned as nodes of a trie of program ids: a top
+   level program invocation is a child of FD_VM_PROF_NODE_ROOT and a
+   CPI is a child of its caller's node.  The pc of a bucket is the
+   first pc of the linear text segment (i.e. basic block) that was
+   executing when the sample was taken.
+
+   A vm attached to a prof (vm->prof non-NULL) takes a sample at the
+   first branch after every sample_period instructions and at program
+   halt.  A sample is credited with all instructions and compute units
+   consumed since the previous sample, such that per program totals are
+   exact and only the attribution to pcs is statistical.  Compute units
+   charged by a syscall are credited to the sample after the syscall.
+
+   A prof has a single writer (e.g. an exec tile) but any number of
+   concurrent readers (e.g. a profile dump tool).  Readers might observe
+   counters mid-update but never observe a partially initialized node or
+   bucket.  When either table is half full, samples for unseen stacks or
+   pcs are dropped (and accounted in the drop counters). */
+
+#define FD_VM_PROF_MAGIC (0xfdc377ace3a6f000UL) /* FD VM PROF MAGIC version 0 */
+
+#define FD_VM_PROF_ALIGN (128UL)
+
+#define FD_VM_PROF_SAMPLE_PERIOD_DEFAULT (64UL)
+
+/* FD_VM_PROF_DEPTH_MAX is the maximum call stack depth of a node
+   (comfortably above the runtime's instruction stack depth).
+   FD_VM_PROF_STACK_CSTR_MAX is the size of a buffer large enough to
+   hold any stack formatted by fd_vm_prof_stack_cstr. */
+
+#define FD_VM_PROF_DEPTH_MAX      (8UL)
+#define FD_VM_PROF_STACK_CSTR_MAX (FD_VM_PROF_DEPTH_MAX*45UL)
+
+/* FD_VM_PROF_NODE_{NULL,ROOT} are special node indices.  NULL indicates
+   no node (e.g. the node table was full) and ROOT is the parent of top
+   level invocations. */
+
+#define FD_VM_PROF_NODE_NULL (ULONG_MAX    )
+#define FD_VM_PROF_NODE_ROOT (ULONG_MAX-1UL)
+
+struct fd_vm_prof_node {
+  ulong parent;           /* Parent node index or FD_VM_PROF_NODE_ROOT */
+  uint  depth;            /* 1 for a top level invocation, in [1,FD_VM_PROF_DEPTH_MAX] */
+  uint  used;             /* 0 if this slot is free, 1 otherwise */
+  uchar program_id[ 32 ]; /* Program id invoked at this node */
+};
+
+typedef struct fd_vm_prof_node fd_vm_prof_node_t;
+
+struct fd_vm_prof_bucket {
+  ulong key;        /* 0 if this slot is free, fd_vm_prof_key( node, pc ) otherwise */
+  ulong sample_cnt; /* Number of samples credited to this bucket */
+  ulong ic;         /* Number of instructions credited to this bucket */
+  ulong cu;         /* Number of compute units credited to this bucket */
+};
+
+typedef struct fd_vm_prof_bucket fd_vm_prof_bucket_t;
+
+struct __attribute__((aligned(FD_VM_PROF_ALIGN))) fd_vm_prof {
+  ulong magic;         /* ==FD_VM_PROF_MAGIC */
+  ulong node_max;      /* Node table slot count, power of 2 */
+  ulong bucket_max;    /* Bucket table slot count, power of 2 */
+  ulong sample_period; /* Approximate instructions between samples, positive */
+  ulong seed;          /* Hash seed */
+  ulong node_cnt;      /* Used node slots, in [0,node_max/2] */
+  ulong bucket_cnt;    /* Used bucket slots, in [0,bucket_max/2] */
+  ulong sample_cnt;    /* Samples credited to a bucket */
+  ulong drop_cnt;      /* Samples dropped */
+  ulong drop_ic;       /* Instructions of dropped samples */
+  ulong drop_cu;       /* Compute units of dropped samples */
+  /* This point is aligned 8
+     fd_vm_prof_node_t   node  [ node_max   ]
+     fd_vm_prof_bucket_t bucket[ bucket_max ]
+     padding to FD_VM_PROF_ALIGN */
+};
+
+typedef struct fd_vm_prof fd_vm_prof_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* prof object structors.  node_max and bucket_max must be powers of 2
+   in [2,2^31] and sample_period must be positive.  Usual conventions
+   otherwise. */
+
+FD_FN_CONST ulong
+fd_vm_prof_align( void );
+
+FD_FN_CONST ulong
+fd_vm_prof_footprint( ulong node_max,
+                      ulong bucket_max );
+
+void *
+fd_vm_prof_new( void * shmem,
+                ulong  node_max,
+                ulong  bucket_max,
+                ulong  sample_period,
+                ulong  seed );
+
+fd_vm_prof_t *
+fd_vm_prof_join( void * _prof );
+
+void *
+fd_vm_prof_leave( fd_vm_prof_t * prof );
+
+void *
+fd_vm_prof_delete( void * _prof );
+
+/* Accessors.  Given a current local join, fd_vm_prof_node and
+   fd_vm_prof_bucket return the location in the caller's address space
+   of the node and bucket tables, indexed [0,node_max) and
+   [0,bucket_max) respectively.  Slots with used / key zero are free.
+   Lifetime of the returned pointers is the lifetime of the join. */
+
+FD_FN_PURE static inline ulong fd_vm_prof_node_max     ( fd_vm_prof_t const * prof ) { return prof->node_max;      }
+FD_FN_PURE static inline ulong fd_vm_prof_bucket_max   ( fd_vm_prof_t const * prof ) { return prof->bucket_max;    }
+FD_FN_PURE static inline ulong fd_vm_prof_sample_period( fd_vm_prof_t const * prof ) { return prof->sample_period; }
+
+FD_FN_CONST static inline fd_vm_prof_node_t const *
+fd_vm_prof_node( fd_vm_prof_t const * prof ) {
+  return (fd_vm_prof_node_t const *)(prof+1);
+}
+
+FD_FN_PURE static inline fd_vm_prof_bucket_t const *
+fd_vm_prof_bucket( fd_vm_prof_t const * prof ) {
+  return (fd_vm_prof_bucket_t const *)(fd_vm_prof_node( prof ) + prof->node_max);
+}
+
+/* fd_vm_prof_key returns the bucket key for pc in the call stack node.
+   Assumes node is in [0,2^31).  pcs are truncated to 32 bits (which is
+   beyond the largest possible text).  fd_vm_prof_key_{node,pc} extract
+   the node and pc from a key.  Assumes key is non-zero. */
+
+FD_FN_CONST static inline ulong fd_vm_prof_key     ( ulong node, ulong pc ) { return ((node+1UL)<<32) | (pc & (ulong)UINT_MAX); }
+FD_FN_CONST static inline ulong fd_vm_prof_key_node( ulong key )            { return (key>>32) - 1UL;                             }
+FD_FN_CONST static inline ulong fd_vm_prof_key_pc  ( ulong key )            { return key & (ulong)UINT_MAX;                       }
+
+/* fd_vm_prof_node_insert returns the index of the call stack node for
+   an invocation of program_id (32 bytes) by the call stack node
+   parent, interning it if necessary.  parent is FD_VM_PROF_NODE_ROOT
+   for a top level invocation.  Returns FD_VM_PROF_NODE_NULL if parent
+   is NULL, the stack is deeper than FD_VM_PROF_DEPTH_MAX or the node
+   table is full.  Only the writer should call this. */
+
+ulong
+fd_vm_prof_node_insert( fd_vm_prof_t * prof,
+                        ulong          parent,
+                        uchar const *  program_id );
+
+/* fd_vm_prof_sample credits ic instructions and cu compute units to the
+   (node,pc) bucket.  node is a node index returned by
+   fd_vm_prof_node_insert (the sample is dropped if it is NULL).  Only
+   the writer should call this.  This is called by the interpreter and
+   usually should not be called directly. */
+
+void
+fd_vm_prof_sample( fd_vm_prof_t * prof,
+                   ulong          node,
+                   ulong          pc,
+                   ulong          ic,
+                   ulong          cu );
+
+/* fd_vm_prof_reset discards all nodes and samples.  Node indices
+   previously returned by fd_vm_prof_node_insert are invalidated.  Only
+   the writer should call this and the writer should not be running a
+   vm attached to prof at the time.  Returns prof. */
+
+fd_vm_prof_t *
+fd_vm_prof_reset( fd_vm_prof_t * prof );
+
+/* fd_vm_prof_stack_cstr formats the call stack of node as the base58
+   program ids from the top level invocation to node separated by
+   semicolons (i.e. a frame list of the "folded stacks" format used by
+   flame graph tools) into buf.  buf should have space for
+   FD_VM_PROF_STACK_CSTR_MAX bytes.  Returns buf on success (always
+   '\0' terminated) and NULL if node is not a valid node of prof (e.g.
+   the table was reset concurrently). */
+
+char *
+fd_vm_prof_stack_cstr( fd_vm_prof_t const * prof,
+                       ulong                node,
+                       char *               buf );
+
 /* fd_vm_syscall API **************************************************/
 
 /* FIXME: fd_sbpf_syscalls_t and fd_sbpf_syscall_func_t probably should
@@ -76,3 +76,45 @@ fd_vm_exec_trace( fd_vm_t * vm ) {
 
   return err;
 }
+
+int
+fd_vm_exec_prof( fd_vm_t * vm ) {
+
+# undef  FD_VM_INTERP_EXE_TRACING_ENABLED
+# undef  FD_VM_INTERP_MEM_TRACING_ENABLED
+# define FD_VM_INTERP_EXE_PROFILING_ENABLED 1
+
+  if( FD_UNLIKELY( (!vm) | (!vm->prof) ) ) return FD_VM_ERR_INVAL;
+
+  /* Pull out variables needed for the fd_vm_interp_core template */
+  ulong frame_max   = FD_VM_STACK_FRAME_MAX; /* FIXME: vm->frame_max to make this run-time configured */
+
+  ulong const * FD_RESTRICT text          = vm->text;
+  ulong                     text_cnt      = vm->text_cnt;
+  ulong                     text_word_off = vm->text_off / 8UL;
+  ulong                     entry_pc      = vm->entry_pc;
+  ulong const * FD_RESTRICT calldests     = vm->calldests;
+
+  fd_sbpf_syscalls_t const * FD_RESTRICT syscalls = vm->syscalls;
+
+  ulong const * FD_RESTRICT region_haddr = vm->region_haddr;
+  uint  const * FD_RESTRICT region_ld_sz = vm->region_ld_sz;
+  uint  const * FD_RESTRICT region_st_sz = vm->region_st_sz;
+
+  ulong * FD_RESTRICT reg = vm->reg;
+
+  fd_vm_shadow_t * FD_RESTRICT shadow = vm->shadow;
+
+  fd_vm_prof_t * prof        = vm->prof;
+  ulong          prof_node   = vm->prof_node;
+  ulong          prof_period = fd_vm_prof_sample_period( prof );
+
+  int err = FD_VM_SUCCESS;
+
+  /* Run the VM */
+# include "fd_vm_interp_core.c"
+
+# undef FD_VM_INTERP_EXE_PROFILING_ENABLED
+
+  return err;
+}
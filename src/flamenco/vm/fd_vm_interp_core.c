@@ -302,6 +302,30 @@
   ulong pc0           = pc;
   ulong ic_correction = 0UL;
 
+  /* When profiling, billing a linear segment is also when we sample.
+     Once at least prof_period instructions have been billed since the
+     last sample, the segment being billed (identified by its first pc)
+     is credited with everything consumed since the last sample.  The
+     remainder is credited on halt (see interp_halt below).  This keeps
+     the per instruction overhead of profiling at zero and the per
+     branch overhead at a compare. */
+
+# ifdef FD_VM_INTERP_EXE_PROFILING_ENABLED
+  ulong prof_ic   = ic;
+  ulong prof_cu   = cu;
+  ulong prof_next = ic + prof_period;
+
+# define FD_VM_INTERP_PROF_SAMPLE                                         \
+    if( FD_UNLIKELY( ic>=prof_next ) ) {                                  \
+      fd_vm_prof_sample( prof, prof_node, pc0, ic-prof_ic, prof_cu-cu );  \
+      prof_ic   = ic;                                                     \
+      prof_cu   = cu;                                                     \
+      prof_next = ic + prof_period;                                       \
+    }
+# else
+# define FD_VM_INTERP_PROF_SAMPLE
+# endif
+
 # define FD_VM_INTERP_BRANCH_BEGIN(opcode)                                                              \
   interp_##opcode:                                                                                      \
     /* Bill linear text segment and this branch instruction as per the above */                         \
@@ -310,7 +334,8 @@
     if( FD_UNLIKELY( ic_correction>cu ) ) goto sigcost; /* Note: untaken branches don't consume BTB */  \
     cu -= ic_correction;                                                                                \
     /* At this point, cu>=0 */                                                                          \
-    ic_correction = 0UL;
+    ic_correction = 0UL;                                                                                \
+    FD_VM_INTERP_PROF_SAMPLE
 
   /* FIXME: debatable if it is better to do pc++ here or have the
      instruction implementations do it in their code path. */
@@ -1251,10 +1276,18 @@ interp_halt:
   vm->cu        = cu;
   vm->frame_cnt = frame_cnt;
 
+  /* Credit anything consumed since the last sample to the segment that
+     was executing when the vm halted */
+
+# ifdef FD_VM_INTERP_EXE_PROFILING_ENABLED
+  if( FD_LIKELY( (ic!=prof_ic) | (cu!=prof_cu) ) ) fd_vm_prof_sample( prof, prof_node, pc0, ic-prof_ic, prof_cu-cu );
+# endif
+
 # undef FD_VM_INTERP_STACK_PUSH
 
 # undef FD_VM_INTERP_BRANCH_END
 # undef FD_VM_INTERP_BRANCH_BEGIN
+# undef FD_VM_INTERP_PROF_SAMPLE
 
 # undef FD_VM_INTERP_INSTR_END
 # undef FD_VM_INTERP_INSTR_BEGIN
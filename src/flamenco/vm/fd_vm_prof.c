@@ -0,0 +1,254 @@
+#include "fd_vm_private.h"
+
+/* The node and bucket tables are open addressed with linear probing.
+   Entries are never removed individually (only by a reset) and the
+   tables are capped at half full such that probe sequences are short
+   and always terminate on a free slot. */
+
+static inline fd_vm_prof_node_t *
+fd_vm_prof_node_private( fd_vm_prof_t * prof ) {
+  return (fd_vm_prof_node_t *)(prof+1);
+}
+
+static inline fd_vm_prof_bucket_t *
+fd_vm_prof_bucket_private( fd_vm_prof_t * prof ) {
+  return (fd_vm_prof_bucket_t *)(fd_vm_prof_node_private( prof ) + prof->node_max);
+}
+
+ulong
+fd_vm_prof_align( void ) {
+  return FD_VM_PROF_ALIGN;
+}
+
+ulong
+fd_vm_prof_footprint( ulong node_max,
+                      ulong bucket_max ) {
+  if( FD_UNLIKELY( (node_max  <2UL) | (node_max  >(1UL<<31)) | !fd_ulong_is_pow2( node_max   ) ) ) return 0UL;
+  if( FD_UNLIKELY( (bucket_max<2UL) | (bucket_max>(1UL<<31)) | !fd_ulong_is_pow2( bucket_max ) ) ) return 0UL;
+  return fd_ulong_align_up( sizeof(fd_vm_prof_t) + node_max*sizeof(fd_vm_prof_node_t) + bucket_max*sizeof(fd_vm_prof_bucket_t),
+                            FD_VM_PROF_ALIGN );
+}
+
+void *
+fd_vm_prof_new( void * shmem,
+                ulong  node_max,
+                ulong  bucket_max,
+                ulong  sample_period,
+                ulong  seed ) {
+  fd_vm_prof_t * prof = (fd_vm_prof_t *)shmem;
+
+  if( FD_UNLIKELY( !prof ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_vm_prof_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_vm_prof_footprint( node_max, bucket_max );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad node_max or bucket_max" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !sample_period ) ) {
+    FD_LOG_WARNING(( "zero sample_period" ));
+    return NULL;
+  }
+
+  memset( prof, 0, footprint );
+
+  prof->node_max      = node_max;
+  prof->bucket_max    = bucket_max;
+  prof->sample_period = sample_period;
+  prof->seed          = seed;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( prof->magic ) = FD_VM_PROF_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return prof;
+}
+
+fd_vm_prof_t *
+fd_vm_prof_join( void * _prof ) {
+  fd_vm_prof_t * prof = (fd_vm_prof_t *)_prof;
+
+  if( FD_UNLIKELY( !prof ) ) {
+    FD_LOG_WARNING(( "NULL _prof" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)_prof, fd_vm_prof_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned _prof" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( prof->magic!=FD_VM_PROF_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return prof;
+}
+
+void *
+fd_vm_prof_leave( fd_vm_prof_t * prof ) {
+
+  if( FD_UNLIKELY( !prof ) ) {
+    FD_LOG_WARNING(( "NULL prof" ));
+    return NULL;
+  }
+
+  return (void *)prof;
+}
+
+void *
+fd_vm_prof_delete( void * _prof ) {
+  fd_vm_prof_t * prof = (fd_vm_prof_t *)_prof;
+
+  if( FD_UNLIKELY( !prof ) ) {
+    FD_LOG_WARNING(( "NULL _prof" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)_prof, fd_vm_prof_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned _prof" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( prof->magic!=FD_VM_PROF_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( prof->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return (void *)prof;
+}
+
+ulong
+fd_vm_prof_node_insert( fd_vm_prof_t * prof,
+                        ulong          parent,
+                        uchar const *  program_id ) {
+
+  fd_vm_prof_node_t * node     = fd_vm_prof_node_private( prof );
+  ulong               node_max = prof->node_max;
+
+  uint depth;
+  if( parent==FD_VM_PROF_NODE_ROOT ) depth = 1U;
+  else if( FD_UNLIKELY( parent>=node_max ) ) return FD_VM_PROF_NODE_NULL;
+  else depth = node[ parent ].depth + 1U;
+  if( FD_UNLIKELY( (ulong)depth>FD_VM_PROF_DEPTH_MAX ) ) return FD_VM_PROF_NODE_NULL;
+
+  ulong mask = node_max-1UL;
+  ulong idx  = fd_hash( prof->seed ^ parent, program_id, 32UL ) & mask;
+  for(;;) {
+    fd_vm_prof_node_t * n = node + idx;
+    if( !n->used ) break;
+    if( (n->parent==parent) && !memcmp( n->program_id, program_id, 32UL ) ) return idx;
+    idx = (idx+1UL) & mask;
+  }
+
+  if( FD_UNLIKELY( prof->node_cnt>=(node_max>>1) ) ) return FD_VM_PROF_NODE_NULL;
+
+  /* Fill in the node before marking it used such that concurrent
+     readers never see a partially initialized node. */
+
+  fd_vm_prof_node_t * n = node + idx;
+  n->parent = parent;
+  n->depth  = depth;
+  memcpy( n->program_id, program_id, 32UL );
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( n->used ) = 1U;
+  FD_COMPILER_MFENCE();
+  prof->node_cnt++;
+
+  return idx;
+}
+
+void
+fd_vm_prof_sample( fd_vm_prof_t * prof,
+                   ulong          node,
+                   ulong          pc,
+                   ulong          ic,
+                   ulong          cu ) {
+
+  if( FD_UNLIKELY( node>=prof->node_max ) ) goto drop;
+
+  fd_vm_prof_bucket_t * bucket = fd_vm_prof_bucket_private( prof );
+
+  ulong key  = fd_vm_prof_key( node, pc );
+  ulong mask = prof->bucket_max-1UL;
+  ulong idx  = fd_ulong_hash( prof->seed ^ key ) & mask;
+  for(;;) {
+    fd_vm_prof_bucket_t * b = bucket + idx;
+    ulong b_key = b->key;
+    if( FD_LIKELY( b_key==key ) ) break;
+    if( !b_key ) {
+      if( FD_UNLIKELY( prof->bucket_cnt>=(prof->bucket_max>>1) ) ) goto drop;
+      FD_VOLATILE( b->key ) = key; /* counters are already zero */
+      prof->bucket_cnt++;
+      break;
+    }
+    idx = (idx+1UL) & mask;
+  }
+
+  fd_vm_prof_bucket_t * b = bucket + idx;
+  b->sample_cnt++;
+  b->ic += ic;
+  b->cu += cu;
+  prof->sample_cnt++;
+  return;
+
+drop:
+  prof->drop_cnt++;
+  prof->drop_ic += ic;
+  prof->drop_cu += cu;
+}
+
+fd_vm_prof_t *
+fd_vm_prof_reset( fd_vm_prof_t * prof ) {
+  memset( prof+1, 0, prof->node_max*sizeof(fd_vm_prof_node_t) + prof->bucket_max*sizeof(fd_vm_prof_bucket_t) );
+  prof->node_cnt   = 0UL;
+  prof->bucket_cnt = 0UL;
+  prof->sample_cnt = 0UL;
+  prof->drop_cnt   = 0UL;
+  prof->drop_ic    = 0UL;
+  prof->drop_cu    = 0UL;
+  return prof;
+}
+
+char *
+fd_vm_prof_stack_cstr( fd_vm_prof_t const * prof,
+                       ulong                node,
+                       char *               buf ) {
+
+  fd_vm_prof_node_t const * node_tbl = fd_vm_prof_node( prof );
+  ulong                     node_max = prof->node_max;
+
+  /* Walk from node up to the root, then print top down */
+
+  ulong stack[ FD_VM_PROF_DEPTH_MAX ];
+  ulong depth = 0UL;
+  while( node!=FD_VM_PROF_NODE_ROOT ) {
+    if( FD_UNLIKELY( (node>=node_max) || (depth>=FD_VM_PROF_DEPTH_MAX) ) ) return NULL;
+    if( FD_UNLIKELY( !FD_VOLATILE_CONST( node_tbl[ node ].used ) ) ) return NULL;
+    stack[ depth++ ] = node;
+    node = node_tbl[ node ].parent;
+  }
+
+  char * p = fd_cstr_init( buf );
+  for( ulong i=depth; i; i-- ) {
+    char b58[ FD_BASE58_ENCODED_32_SZ ];
+    fd_base58_encode_32( node_tbl[ stack[ i-1UL ] ].program_id, NULL, b58 );
+    if( i<depth ) p = fd_cstr_append_char( p, ';' );
+    p = fd_cstr_append_cstr( p, b58 );
+  }
+  fd_cstr_fini( p );
+  return buf;
+}
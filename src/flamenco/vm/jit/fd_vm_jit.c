@@ -0,0 +1,1398 @@
+#define _GNU_SOURCE /* MAP_ANONYMOUS, memfd_create */
+#include "fd_vm_jit.h"
+
+#if FD_HAS_X86 && FD_HAS_HOSTED
+
+#include "../fd_vm_private.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* Register usage in generated code:
+
+     rbx - &vm->reg[0] (sBPF registers are accessed as [rbx+8*idx])
+     rbp - vm
+     r12 - meter (see fd_vm_jit.h)
+     r13 - frame
+     r14 - code base (start of the pc table)
+     r15 - helper table
+     rax, rcx, rdx, rsi, rdi, r8 - scratch
+
+   All of rbx, rbp and r12-r15 are callee saved in the SysV ABI such
+   that they survive helper calls.  The shared exit path expects the
+   error code in eax and the faulting / halting pc in rsi. */
+
+#define RAX (0U)
+#define RCX (1U)
+#define RDX (2U)
+#define RBX (3U)
+#define RBP (5U)
+#define RSI (6U)
+#define RDI (7U)
+#define R12 (12U)
+#define R13 (13U)
+#define R14 (14U)
+#define R15 (15U)
+
+/* ALU opcode extensions (/digit) for the 0x81 / 0xC1 / 0xD3 / 0xF7
+   opcode groups */
+
+#define ALU_ADD (0U)
+#define ALU_OR  (1U)
+#define ALU_AND (4U)
+#define ALU_SUB (5U)
+#define ALU_XOR (6U)
+#define ALU_CMP (7U)
+
+#define SHF_SHL (4U)
+#define SHF_SHR (5U)
+#define SHF_SAR (7U)
+
+#define F7_NEG  (3U)
+#define F7_MUL  (4U)
+#define F7_IMUL (5U)
+#define F7_DIV  (6U)
+#define F7_IDIV (7U)
+
+/* Condition codes (low nibble of jcc) */
+
+#define CC_B  (0x2U)
+#define CC_AE (0x3U)
+#define CC_E  (0x4U)
+#define CC_NE (0x5U)
+#define CC_BE (0x6U)
+#define CC_A  (0x7U)
+#define CC_S  (0x8U)
+#define CC_L  (0xcU)
+#define CC_GE (0xdU)
+#define CC_LE (0xeU)
+#define CC_G  (0xfU)
+
+/* Frame shared between fd_vm_exec_jit and generated code.  Offsets
+   are baked into the generated code. */
+
+struct fd_vm_jit_frame {
+  ulong meter; /* r12 spill location */
+  ulong k;     /* ic+cu (invariant except at syscalls) */
+  ulong pc;    /* pc on exit */
+};
+
+typedef struct fd_vm_jit_frame fd_vm_jit_frame_t;
+
+#define FRAME_METER (0x00U)
+#define FRAME_PC    (0x10U)
+
+/* Helpers ************************************************************/
+
+/* The helpers below are called from generated code.  Each mirrors the
+   corresponding interpreter code in fd_vm_interp_core.c exactly.
+   Helpers that can fault return an FD_VM_ERR code (or a negative
+   FD_VM_ERR code for helpers that otherwise return a pc). */
+
+#define HELPER_LD(n,T)                                                                          \
+static int                                                                                      \
+fd_vm_jit_ld_##n( fd_vm_t * vm,                                                                 \
+                  ulong     vaddr,                                                              \
+                  ulong     dst ) {                                                             \
+  uchar is_multi_region = 0;                                                                    \
+  ulong haddr = fd_vm_mem_haddr( vm, vaddr, sizeof(T), vm->region_haddr, vm->region_ld_sz, 0, \
+                                 0UL, &is_multi_region );                                       \
+  if( FD_UNLIKELY( !haddr ) ) return FD_VM_ERR_SIGSEGV;                                         \
+  vm->reg[ dst ] = fd_vm_mem_ld_##n( vm, vaddr, haddr, is_multi_region );                       \
+  return FD_VM_SUCCESS;                                                                         \
+}
+
+#define HELPER_ST(n,T)                                                                          \
+static int                                                                                      \
+fd_vm_jit_st_##n( fd_vm_t * vm,                                                                 \
+                  ulong     vaddr,                                                              \
+                  ulong     _val ) {                                                            \
+  T     val             = (T)_val;                                                              \
+  uchar is_multi_region = 0;                                                                    \
+  ulong haddr = fd_vm_mem_haddr( vm, vaddr, sizeof(T), vm->region_haddr, vm->region_st_sz, 1, \
+                                 0UL, &is_multi_region );                                       \
+  if( FD_UNLIKELY( !haddr ) ) {                                                                 \
+    vm->segv_store_vaddr = vaddr;                                                               \
+    if( vm->direct_mapping ) fd_vm_mem_st_try( vm, vaddr, sizeof(T), (uchar *)&val );           \
+    return FD_VM_ERR_SIGSEGV;                                                                   \
+  }                                                                                             \
+  fd_vm_mem_st_##n( vm, vaddr, haddr, val, is_multi_region );                                   \
+  return FD_VM_SUCCESS;                                                                         \
+}
+
+static int
+fd_vm_jit_ld_1( fd_vm_t * vm,
+                ulong     vaddr,
+                ulong     dst ) {
+  uchar is_multi_region = 0;
+  ulong haddr = fd_vm_mem_haddr( vm, vaddr, sizeof(uchar), vm->region_haddr, vm->region_ld_sz, 0, 0UL, &is_multi_region );
+  if( FD_UNLIKELY( !haddr ) ) return FD_VM_ERR_SIGSEGV;
+  vm->reg[ dst ] = fd_vm_mem_ld_1( haddr );
+  return FD_VM_SUCCESS;
+}
+
+HELPER_LD(2,ushort)
+HELPER_LD(4,uint)
+HELPER_LD(8,ulong)
+
+/* Note: STB does not do a partial store on fault (like the interpreter) */
+
+static int
+fd_vm_jit_st_1( fd_vm_t * vm,
+                ulong     vaddr,
+                ulong     val ) {
+  uchar is_multi_region = 0;
+  ulong haddr = fd_vm_mem_haddr( vm, vaddr, sizeof(uchar), vm->region_haddr, vm->region_st_sz, 1, 0UL, &is_multi_region );
+  if( FD_UNLIKELY( !haddr ) ) { vm->segv_store_vaddr = vaddr; return FD_VM_ERR_SIGSEGV; }
+  fd_vm_mem_st_1( haddr, (uchar)val );
+  return FD_VM_SUCCESS;
+}
+
+HELPER_ST(2,ushort)
+HELPER_ST(4,uint)
+HELPER_ST(8,ulong)
+
+#undef HELPER_ST
+#undef HELPER_LD
+
+/* fd_vm_jit_push is FD_VM_INTERP_STACK_PUSH */
+
+static int
+fd_vm_jit_push( fd_vm_t * vm,
+                ulong     pc ) {
+  ulong            frame_cnt = vm->frame_cnt;
+  fd_vm_shadow_t * shadow    = vm->shadow + frame_cnt;
+  ulong *          reg       = vm->reg;
+  shadow->r6  = reg[6];
+  shadow->r7  = reg[7];
+  shadow->r8  = reg[8];
+  shadow->r9  = reg[9];
+  shadow->r10 = reg[10];
+  shadow->pc  = pc;
+  vm->frame_cnt = ++frame_cnt;
+  if( FD_UNLIKELY( frame_cnt>=FD_VM_STACK_FRAME_MAX ) ) return FD_VM_ERR_SIGSTACK;
+  if( !FD_VM_SBPF_DYNAMIC_STACK_FRAMES( vm->sbpf_version ) ) reg[10] += vm->stack_frame_size;
+  return FD_VM_SUCCESS;
+}
+
+/* fd_vm_jit_ret pops a stack frame and returns the pc to resume at.
+   Returns ULONG_MAX if there are no frames (program exit). */
+
+static ulong
+fd_vm_jit_ret( fd_vm_t * vm ) {
+  ulong frame_cnt = vm->frame_cnt;
+  if( FD_UNLIKELY( !frame_cnt ) ) return ULONG_MAX;
+  frame_cnt--;
+  fd_vm_shadow_t const * shadow = vm->shadow + frame_cnt;
+  ulong *                reg    = vm->reg;
+  reg[6]  = shadow->r6;
+  reg[7]  = shadow->r7;
+  reg[8]  = shadow->r8;
+  reg[9]  = shadow->r9;
+  reg[10] = shadow->r10;
+  vm->frame_cnt = frame_cnt;
+  return shadow->pc + 1UL;
+}
+
+/* fd_vm_jit_callx{,_depr} push a frame and return the target pc of an
+   indirect call (in [0,text_cnt)) or a negative FD_VM_ERR code.  As in
+   the interpreter, _depr reads the target register after the push. */
+
+static long
+fd_vm_jit_callx_target( fd_vm_t const * vm,
+                        ulong           vaddr ) {
+  ulong region    = vaddr >> 32;
+  ulong target_pc = ((vaddr & FD_VM_OFFSET_MASK)/8UL) - vm->text_off/8UL;
+  if( FD_UNLIKELY( (region!=1UL) | (target_pc>=vm->text_cnt) ) ) return (long)FD_VM_ERR_SIGTEXT;
+  return (long)target_pc;
+}
+
+static long
+fd_vm_jit_callx( fd_vm_t * vm,
+                 ulong     pc,
+                 ulong     vaddr ) {
+  int err = fd_vm_jit_push( vm, pc );
+  if( FD_UNLIKELY( err ) ) return (long)err;
+  return fd_vm_jit_callx_target( vm, vaddr );
+}
+
+static long
+fd_vm_jit_callx_depr( fd_vm_t * vm,
+                      ulong     pc,
+                      ulong     idx ) {
+  int err = fd_vm_jit_push( vm, pc );
+  if( FD_UNLIKELY( err ) ) return (long)err;
+  return fd_vm_jit_callx_target( vm, vm->reg[ idx ] );
+}
+
+/* fd_vm_jit_syscall is FD_VM_INTERP_SYSCALL_EXEC.  Returns missing if
+   key is not a registered syscall.  The generated code spills the
+   meter to frame before the call and reloads it after. */
+
+static int
+fd_vm_jit_syscall( fd_vm_t *           vm,
+                   ulong               pc,
+                   ulong               key,
+                   fd_vm_jit_frame_t * frame,
+                   int                 missing ) {
+  fd_sbpf_syscalls_t const * syscall = key!=fd_sbpf_syscalls_key_null() ? fd_sbpf_syscalls_query_const( vm->syscalls, key, NULL ) : NULL;
+  if( FD_UNLIKELY( !syscall ) ) return missing;
+
+  ulong meter = frame->meter;
+  ulong cu    = meter - (pc+1UL);
+
+  vm->pc = pc;
+  vm->ic = frame->k - cu;
+  vm->cu = cu;
+
+  ulong * reg = vm->reg;
+  ulong   ret[1];
+  int err = syscall->func( vm, reg[1], reg[2], reg[3], reg[4], reg[5], ret );
+  reg[0] = ret[0];
+
+  ulong cu_req = vm->cu;
+  cu = fd_ulong_min( cu_req, cu );
+  if( FD_UNLIKELY( err ) ) {
+    if( err==FD_VM_SYSCALL_ERR_COMPUTE_BUDGET_EXCEEDED ) cu = 0UL; /* cmov */
+    FD_VM_TEST_ERR_EXISTS( vm );
+  }
+
+  ulong meter_new = cu + pc + 1UL;
+  frame->k     += meter_new - meter;
+  frame->meter  = meter_new;
+  return err ? FD_VM_ERR_SIGSYSCALL : FD_VM_SUCCESS;
+}
+
+typedef void (*fd_vm_jit_fn_t)( void );
+
+#define H_LD_1     (0UL)
+#define H_LD_2     (1UL)
+#define H_LD_4     (2UL)
+#define H_LD_8     (3UL)
+#define H_ST_1     (4UL)
+#define H_ST_2     (5UL)
+#define H_ST_4     (6UL)
+#define H_ST_8     (7UL)
+#define H_PUSH     (8UL)
+#define H_RET      (9UL)
+#define H_CALLX    (10UL)
+#define H_CALLXD   (11UL)
+#define H_SYSCALL  (12UL)
+
+static fd_vm_jit_fn_t const fd_vm_jit_helper[] = {
+  (fd_vm_jit_fn_t)fd_vm_jit_ld_1,
+  (fd_vm_jit_fn_t)fd_vm_jit_ld_2,
+  (fd_vm_jit_fn_t)fd_vm_jit_ld_4,
+  (fd_vm_jit_fn_t)fd_vm_jit_ld_8,
+  (fd_vm_jit_fn_t)fd_vm_jit_st_1,
+  (fd_vm_jit_fn_t)fd_vm_jit_st_2,
+  (fd_vm_jit_fn_t)fd_vm_jit_st_4,
+  (fd_vm_jit_fn_t)fd_vm_jit_st_8,
+  (fd_vm_jit_fn_t)fd_vm_jit_push,
+  (fd_vm_jit_fn_t)fd_vm_jit_ret,
+  (fd_vm_jit_fn_t)fd_vm_jit_callx,
+  (fd_vm_jit_fn_t)fd_vm_jit_callx_depr,
+  (fd_vm_jit_fn_t)fd_vm_jit_syscall
+};
+
+typedef int (*fd_vm_jit_entry_t)( fd_vm_t *               vm,
+                                  fd_vm_jit_frame_t *     frame,
+                                  fd_vm_jit_fn_t const *  helper,
+                                  ulong                   pc );
+
+/* Assembler **********************************************************/
+
+/* Fixups are recorded while emitting hot code and resolved once all
+   code is emitted.  FIX_JMP patches a rel32 to jump to the code for
+   pc.  FIX_ERR / FIX_EAX patch a rel32 to jump to an out-of-line stub
+   that exits with err (or with the error already in eax) at pc. */
+
+#define FIX_JMP (0)
+#define FIX_ERR (1)
+#define FIX_EAX (2)
+
+struct fd_vm_jit_fixup {
+  uint  at;   /* offset of the rel32 to patch */
+  int   kind;
+  ulong pc;
+  int   err;
+};
+
+typedef struct fd_vm_jit_fixup fd_vm_jit_fixup_t;
+
+/* Every text word emits at most this many fixups and this many bytes
+   of hot code */
+
+#define FD_VM_JIT_INSTR_FIX_MAX (4UL)
+#define FD_VM_JIT_INSTR_SZ_MAX  (224UL)
+
+FD_STATIC_ASSERT( FD_VM_JIT_INSTR_FIX_MAX*sizeof(fd_vm_jit_fixup_t)<=FD_VM_JIT_FIXUP_MAX, fixup_sz );
+FD_STATIC_ASSERT( FD_VM_SBPF_STATIC_SYSCALLS_LIST_SZ<=FD_VM_JIT_STATIC_SYSCALL_MAX, static_syscalls );
+
+struct fd_vm_jit_asm {
+  uchar *             code;
+  uchar *             p;        /* emit cursor */
+  uchar *             p_max;    /* emit limit */
+  uint *              tbl;      /* indexed [0,text_cnt) */
+  fd_vm_jit_fixup_t * fix;
+  ulong               fix_cnt;
+  ulong               fix_max;
+
+  ulong const *       text;
+  ulong               text_cnt;
+  ulong               entry_pc;
+  ulong const *       calldests;
+  ulong               sbpf_version;
+  ulong               static_syscalls[ FD_VM_JIT_STATIC_SYSCALL_MAX/64UL ];
+
+  ulong               sigtext_off; /* rax holds the out of bounds pc */
+  ulong               exit_off;    /* eax holds the error, rsi the pc */
+};
+
+typedef struct fd_vm_jit_asm fd_vm_jit_asm_t;
+
+static inline uchar * emit1( uchar * p, ulong b ) { *p = (uchar)b;             return p+1; }
+static inline uchar * emit4( uchar * p, ulong d ) { FD_STORE( uint,  p, (uint)d ); return p+4; }
+static inline uchar * emit8( uchar * p, ulong q ) { FD_STORE( ulong, p, q );       return p+8; }
+
+static inline uchar *
+emit_opc( uchar * p,
+          uint    rex,
+          uint    opc ) {
+  if( rex!=0x40U ) p = emit1( p, rex );
+  if( opc>0xffU  ) p = emit1( p, opc>>8 );
+  return emit1( p, opc & 0xffU );
+}
+
+/* emit_m emits "opc reg,[rbx+8*idx]" (i.e. operand is sBPF register
+   idx).  emit_r emits "opc reg,rm" with register direct rm.  w selects
+   64-bit operand size.  For opcode groups, reg is the /digit. */
+
+static inline uchar *
+emit_m( uchar * p,
+        int     w,
+        uint    opc,
+        uint    reg,
+        ulong   idx ) {
+  p = emit_opc( p, 0x40U | (w ? 8U : 0U) | ((reg & 8U)>>1), opc );
+  p = emit1( p, 0x43U | ((reg & 7U)<<3) );
+  return emit1( p, 8UL*idx );
+}
+
+static inline uchar *
+emit_r( uchar * p,
+        int     w,
+        uint    opc,
+        uint    reg,
+        uint    rm ) {
+  p = emit_opc( p, 0x40U | (w ? 8U : 0U) | ((reg & 8U)>>1) | ((rm & 8U)>>3), opc );
+  return emit1( p, 0xc0U | ((reg & 7U)<<3) | (rm & 7U) );
+}
+
+static inline uchar * emit_ld32( uchar * p, uint r, ulong idx ) { return emit_m( p, 0, 0x8bU, r, idx ); }
+static inline uchar * emit_ld64( uchar * p, uint r, ulong idx ) { return emit_m( p, 1, 0x8bU, r, idx ); }
+static inline uchar * emit_st64( uchar * p, uint r, ulong idx ) { return emit_m( p, 1, 0x89U, r, idx ); }
+static inline uchar * emit_sext( uchar * p                    ) { return emit_r( p, 1, 0x63U, RAX, RAX ); } /* movsxd rax,eax */
+
+static inline uchar * /* mov r32,imm32 (zero extends) */
+emit_mov32( uchar * p, uint r, ulong imm ) {
+  p = emit_opc( p, 0x40U | ((r & 8U)>>3), 0xb8U + (r & 7U) );
+  return emit4( p, imm );
+}
+
+static inline uchar * /* mov r64,simm32 */
+emit_movs( uchar * p, uint r, ulong imm ) {
+  return emit4( emit_r( p, 1, 0xc7U, 0U, r ), imm );
+}
+
+static inline uchar * /* mov r64,imm64 */
+emit_mov64( uchar * p, uint r, ulong imm ) {
+  p = emit_opc( p, 0x48U | ((r & 8U)>>3), 0xb8U + (r & 7U) );
+  return emit8( p, imm );
+}
+
+static inline uchar * /* op r,imm32 with op in 0x81 group */
+emit_alu_ri( uchar * p, int w, uint ext, uint r, ulong imm ) {
+  return emit4( emit_r( p, w, 0x81U, ext, r ), imm );
+}
+
+static inline uchar * /* op [idx],imm32 with op in 0x81 group */
+emit_alu_mi( uchar * p, int w, uint ext, ulong idx, ulong imm ) {
+  return emit4( emit_m( p, w, 0x81U, ext, idx ), imm );
+}
+
+static inline uchar * /* call [r15+8*h] */
+emit_call( uchar * p, ulong h ) {
+  p = emit1( p, 0x41U ); p = emit1( p, 0xffU ); p = emit1( p, 0x57U );
+  return emit1( p, 8UL*h );
+}
+
+static inline uchar * emit_vm_arg( uchar * p ) { return emit_r( p, 1, 0x89U, RBP, RDI ); } /* mov rdi,rbp */
+
+static inline uchar * /* lea r12,[r12+d] (meter adjust, preserves flags) */
+emit_meter_add( uchar * p,
+                long    d ) {
+  if( !d ) return p;
+  if( FD_LIKELY( (d>=(long)INT_MIN) & (d<=(long)INT_MAX) ) ) {
+    p = emit1( p, 0x4dU ); p = emit1( p, 0x8dU ); p = emit1( p, 0xa4U ); p = emit1( p, 0x24U );
+    return emit4( p, (ulong)d );
+  }
+  /* Only reachable for a call to an out of bounds entry_pc (flags are
+     dead at this point) */
+  p = emit_mov64( p, RAX, (ulong)d );
+  return emit_r( p, 1, 0x01U, RAX, R12 );
+}
+
+/* emit_fix emits a jmp (cc<0) or jcc rel32 and records a fixup for it */
+
+static uchar *
+emit_fix( fd_vm_jit_asm_t * a,
+          uchar *           p,
+          int               cc,
+          int               kind,
+          ulong             pc,
+          int               err ) {
+  if( cc<0 ) p = emit1( p, 0xe9U );
+  else     { p = emit1( p, 0x0fU ); p = emit1( p, 0x80U | (uint)cc ); }
+  a->fix[ a->fix_cnt++ ] = (fd_vm_jit_fixup_t){ .at = (uint)(p - a->code), .kind = kind, .pc = pc, .err = err };
+  return emit4( p, 0UL );
+}
+
+/* emit_jabs emits a jmp (cc<0) or jcc rel32 to a known code offset */
+
+static uchar *
+emit_jabs( fd_vm_jit_asm_t * a,
+           uchar *           p,
+           int               cc,
+           ulong             off ) {
+  if( cc<0 ) p = emit1( p, 0xe9U );
+  else     { p = emit1( p, 0x0fU ); p = emit1( p, 0x80U | (uint)cc ); }
+  return emit4( p, (ulong)( (long)off - (long)( (p+4) - a->code ) ) );
+}
+
+/* emit_goto jumps to pc target (cc<0 or if cc holds) without touching
+   the meter.  Out of bounds targets fault with SIGTEXT. */
+
+static inline uchar *
+emit_goto( fd_vm_jit_asm_t * a,
+           uchar *           p,
+           int               cc,
+           ulong             target ) {
+  if( FD_LIKELY( target<a->text_cnt ) ) return emit_fix( a, p, cc, FIX_JMP, target, 0 );
+  return emit_fix( a, p, cc, FIX_ERR, target, FD_VM_ERR_SIGTEXT );
+}
+
+/* emit_bill bills the linear segment ending at the branch at pc */
+
+static inline uchar *
+emit_bill( fd_vm_jit_asm_t * a,
+           uchar *           p,
+           ulong             pc ) {
+  p = emit_alu_ri( p, 1, ALU_CMP, R12, pc+1UL );
+  return emit_fix( a, p, (int)CC_L, FIX_ERR, pc, FD_VM_ERR_SIGCOST );
+}
+
+/* emit_jump emits an unconditional branch from pc to target */
+
+static inline uchar *
+emit_jump( fd_vm_jit_asm_t * a,
+           uchar *           p,
+           ulong             pc,
+           ulong             target ) {
+  p = emit_meter_add( p, (long)(target - (pc+1UL)) );
+  return emit_goto( a, p, -1, target );
+}
+
+/* emit_branch emits a conditional branch from pc to target taken if cc
+   holds for the flags set immediately before */
+
+static inline uchar *
+emit_branch( fd_vm_jit_asm_t * a,
+             uchar *           p,
+             ulong             pc,
+             uint              cc,
+             ulong             target ) {
+  long d = (long)(target - (pc+1UL));
+  if( !d ) return p;
+  p = emit_meter_add( p, d );
+  p = emit_goto( a, p, (int)cc, target );
+  return emit_meter_add( p, -d );
+}
+
+/* emit_dyn jumps from branch at pc to the pc in rax */
+
+static inline uchar *
+emit_dyn( fd_vm_jit_asm_t * a,
+          uchar *           p,
+          ulong             pc ) {
+  p = emit1( p, 0x4dU ); p = emit1( p, 0x8dU ); p = emit1( p, 0xa4U ); p = emit1( p, 0x04U ); /* lea r12,[r12+rax-(pc+1)] */
+  p = emit4( p, (ulong)(-(long)(pc+1UL)) );
+  p = emit_alu_ri( p, 1, ALU_CMP, RAX, a->text_cnt );
+  p = emit_jabs( a, p, (int)CC_AE, a->sigtext_off );
+  p = emit1( p, 0x41U ); p = emit1( p, 0x8bU ); p = emit1( p, 0x0cU ); p = emit1( p, 0x86U ); /* mov ecx,[r14+rax*4] */
+  p = emit_r( p, 1, 0x01U, R14, RCX );                                                        /* add rcx,r14 */
+  p = emit1( p, 0xffU ); return emit1( p, 0xe1U );                                            /* jmp rcx */
+}
+
+/* emit_helper_check exits at pc if the helper returned non-zero */
+
+static inline uchar *
+emit_helper_check( fd_vm_jit_asm_t * a,
+                   uchar *           p,
+                   ulong             pc ) {
+  p = emit_r( p, 0, 0x85U, RAX, RAX ); /* test eax,eax */
+  return emit_fix( a, p, (int)CC_NE, FIX_EAX, pc, 0 );
+}
+
+static inline uchar *
+emit_push( fd_vm_jit_asm_t * a,
+           uchar *           p,
+           ulong             pc ) {
+  p = emit_vm_arg( p );
+  p = emit_mov32( p, RSI, pc );
+  p = emit_call( p, H_PUSH );
+  return emit_helper_check( a, p, pc );
+}
+
+static inline uchar *
+emit_syscall( uchar * p,
+              ulong   pc,
+              ulong   key,
+              int     missing ) {
+  p = emit1( p, 0x4dU ); p = emit1( p, 0x89U ); p = emit1( p, 0x65U ); p = emit1( p, FRAME_METER ); /* mov [r13+meter],r12 */
+  p = emit_vm_arg( p );
+  p = emit_mov32( p, RSI, pc  );
+  p = emit_mov32( p, RDX, key );
+  p = emit_r( p, 1, 0x89U, R13, RCX );                                                              /* mov rcx,r13 */
+  p = emit1( p, 0x41U ); p = emit1( p, 0xb8U ); p = emit4( p, (ulong)(uint)missing );               /* mov r8d,missing */
+  p = emit_call( p, H_SYSCALL );
+  p = emit1( p, 0x4dU ); p = emit1( p, 0x8bU ); p = emit1( p, 0x65U ); return emit1( p, FRAME_METER ); /* mov r12,[r13+meter] */
+}
+
+/* emit_mem emits a load (st==0) or store (st==1) through helper h.
+   For stores, val_reg selects if the value is sBPF register src
+   (val_reg==1) or the immediate (val_reg==0, sign extended if sext). */
+
+static inline uchar *
+emit_mem( fd_vm_jit_asm_t * a,
+          uchar *           p,
+          ulong             pc,
+          ulong             h,
+          ulong             base,
+          ulong             offset,
+          int               st,
+          ulong             dst_or_src,
+          int               val_reg,
+          uint              imm,
+          int               sext ) {
+  p = emit_vm_arg( p );
+  p = emit_ld64( p, RSI, base );
+  if( offset ) p = emit_alu_ri( p, 1, ALU_ADD, RSI, offset );
+  if( !st || val_reg ) {
+    if( !st ) p = emit_mov32( p, RDX, dst_or_src );
+    else      p = emit_ld64 ( p, RDX, dst_or_src );
+  } else {
+    if( sext ) p = emit_movs ( p, RDX, imm );
+    else       p = emit_mov32( p, RDX, imm );
+  }
+  p = emit_call( p, h );
+  return emit_helper_check( a, p, pc );
+}
+
+/* emit_div emits unsigned (sgn==0) or signed (sgn==1) division /
+   remainder (rem==1) of sBPF register dst by sBPF register src
+   (is_imm==0) or by imm (is_imm==1, sign extended to 64-bit if sgn or
+   sext).  w selects 64-bit operation.  Division by zero faults with
+   SIGFPE and signed overflow with SIGFPE_OF. */
+
+static uchar *
+emit_div( fd_vm_jit_asm_t * a,
+          uchar *           p,
+          ulong             pc,
+          int               w,
+          int               sgn,
+          int               rem,
+          ulong             dst,
+          ulong             src,
+          int               is_imm,
+          uint              imm,
+          int               sext ) {
+  int chk_of;
+  if( is_imm ) {
+    if( FD_UNLIKELY( !imm ) ) return emit_fix( a, p, -1, FIX_ERR, pc, FD_VM_ERR_SIGFPE ); /* rejected by validation */
+    if( w && (sgn | sext) ) p = emit_movs ( p, RCX, imm );
+    else                    p = emit_mov32( p, RCX, imm );
+    chk_of = sgn && imm==UINT_MAX;
+  } else {
+    p = w ? emit_ld64( p, RCX, src ) : emit_ld32( p, RCX, src );
+    p = emit_r( p, w, 0x85U, RCX, RCX ); /* test rcx,rcx */
+    p = emit_fix( a, p, (int)CC_E, FIX_ERR, pc, FD_VM_ERR_SIGFPE );
+    chk_of = sgn;
+  }
+
+  p = w ? emit_ld64( p, RAX, dst ) : emit_ld32( p, RAX, dst );
+
+  if( chk_of ) {
+    uchar * skip = NULL;
+    if( !is_imm ) { /* cmp rcx,-1; jne skip */
+      p = emit_r( p, w, 0x83U, ALU_CMP, RCX ); p = emit1( p, 0xffU );
+      p = emit1( p, 0x75U ); skip = p; p = emit1( p, 0U );
+    }
+    if( w ) { p = emit_mov64( p, RDX, 1UL<<63 ); p = emit_r( p, 1, 0x39U, RDX, RAX ); } /* cmp rax,LONG_MIN */
+    else    { p = emit1( p, 0x3dU ); p = emit4( p, 0x80000000UL ); }                  /* cmp eax,INT_MIN  */
+    p = emit_fix( a, p, (int)CC_E, FIX_ERR, pc, FD_VM_ERR_SIGFPE_OF );
+    if( skip ) *skip = (uchar)(p - (skip+1));
+  }
+
+  if( sgn ) { if( w ) p = emit1( p, 0x48U ); p = emit1( p, 0x99U ); } /* cdq / cqo */
+  else      p = emit_r( p, 0, 0x31U, RDX, RDX );                      /* xor edx,edx */
+  p = emit_r( p, w, 0xf7U, sgn ? F7_IDIV : F7_DIV, RCX );
+  return emit_st64( p, rem ? RDX : RAX, dst );
+}
+
+/* fd_vm_jit_xlat maps an opcode to the label used by the interpreter
+   for the given sbpf_version (as configured at the top of
+   fd_vm_interp_core.c).  Deprecated variants are returned as
+   opcode|XLAT_DEPR.  Returns XLAT_ILL for opcodes that sigill. */
+
+#define XLAT_DEPR (0x100)
+#define XLAT_ILL  (-1)
+
+static int
+fd_vm_jit_xlat( ulong opcode,
+                ulong v ) {
+
+  /* Opcodes enabled in the default interpreter jump table */
+
+  static uchar const enabled[ 256 ] = {
+    [0x04]=1, [0x05]=1, [0x07]=1, [0x0c]=1, [0x0f]=1, [0x14]=1, [0x15]=1, [0x17]=1, [0x1c]=1, [0x1d]=1, [0x1f]=1,
+    [0x25]=1, [0x2d]=1, [0x35]=1, [0x36]=1, [0x3d]=1, [0x3e]=1,
+    [0x44]=1, [0x45]=1, [0x46]=1, [0x47]=1, [0x4c]=1, [0x4d]=1, [0x4e]=1, [0x4f]=1,
+    [0x54]=1, [0x55]=1, [0x56]=1, [0x57]=1, [0x5c]=1, [0x5d]=1, [0x5e]=1, [0x5f]=1,
+    [0x64]=1, [0x65]=1, [0x66]=1, [0x67]=1, [0x6c]=1, [0x6d]=1, [0x6e]=1, [0x6f]=1,
+    [0x74]=1, [0x75]=1, [0x76]=1, [0x77]=1, [0x7c]=1, [0x7d]=1, [0x7e]=1, [0x7f]=1,
+    [0x85]=1, [0x86]=1, [0x8c]=1, [0x8d]=1, [0x8e]=1, [0x8f]=1, [0x95]=1, [0x96]=1, [0x9e]=1,
+    [0xa4]=1, [0xa5]=1, [0xa7]=1, [0xac]=1, [0xad]=1, [0xaf]=1,
+    [0xb4]=1, [0xb5]=1, [0xb6]=1, [0xb7]=1, [0xbc]=1, [0xbd]=1, [0xbe]=1, [0xbf]=1,
+    [0xc4]=1, [0xc5]=1, [0xc6]=1, [0xc7]=1, [0xcc]=1, [0xcd]=1, [0xce]=1, [0xcf]=1,
+    [0xd5]=1, [0xd6]=1, [0xdc]=1, [0xdd]=1, [0xde]=1, [0xe6]=1, [0xee]=1, [0xf6]=1, [0xf7]=1, [0xfe]=1
+  };
+
+# define SEL(c,t,f) ( (c) ? (t) : (f) )
+# define D(op)      ( (op) | XLAT_DEPR )
+  int mv  = FD_VM_SBPF_MOVE_MEMORY_IX_CLASSES( v );
+  int pqr = FD_VM_SBPF_ENABLE_PQR( v );
+  int sx  = FD_VM_SBPF_EXPLICIT_SIGN_EXT( v );
+
+  switch( opcode ) {
+  case 0x18: return SEL( FD_VM_SBPF_ENABLE_LDDW( v ), 0x18, XLAT_ILL ); /* SIMD-0173: LDDW */
+  case 0xf7: return SEL( FD_VM_SBPF_ENABLE_LDDW( v ), XLAT_ILL, 0xf7 ); /* HOR64 */
+  case 0xd4: return SEL( FD_VM_SBPF_ENABLE_LE  ( v ), 0xd4, XLAT_ILL ); /* SIMD-0173: LE */
+
+  case 0x61: return SEL( mv, XLAT_ILL, 0x8c    ); /* SIMD-0173: LDXW, STW, STXW */
+  case 0x62: return SEL( mv, XLAT_ILL, 0x87    );
+  case 0x63: return SEL( mv, XLAT_ILL, 0x8f    );
+  case 0x8c: return SEL( mv, 0x8c,     XLAT_ILL );
+  case 0x87: return SEL( mv, 0x87,     D(0x87) );
+  case 0x8f: return SEL( mv, 0x8f,     XLAT_ILL );
+
+  case 0x69: return SEL( mv, XLAT_ILL, 0x3c    ); /* SIMD-0173: LDXH, STH, STXH */
+  case 0x6a: return SEL( mv, XLAT_ILL, 0x37    );
+  case 0x6b: return SEL( mv, XLAT_ILL, 0x3f    );
+  case 0x3c: return SEL( mv, 0x3c,     D(0x3c) );
+  case 0x37: return SEL( mv, 0x37,     D(0x37) );
+  case 0x3f: return SEL( mv, 0x3f,     D(0x3f) );
+
+  case 0x71: return SEL( mv, XLAT_ILL, 0x2c    ); /* SIMD-0173: LDXB, STB, STXB */
+  case 0x72: return SEL( mv, XLAT_ILL, 0x27    );
+  case 0x73: return SEL( mv, XLAT_ILL, 0x2f    );
+  case 0x2c: return SEL( mv, 0x2c,     D(0x2c) );
+  case 0x27: return SEL( mv, 0x27,     D(0x27) );
+  case 0x2f: return SEL( mv, 0x2f,     D(0x2f) );
+
+  case 0x79: return SEL( mv, XLAT_ILL, 0x9c    ); /* SIMD-0173: LDXDW, STDW, STXDW */
+  case 0x7a: return SEL( mv, XLAT_ILL, 0x97    );
+  case 0x7b: return SEL( mv, XLAT_ILL, 0x9f    );
+  case 0x9c: return SEL( mv, 0x9c,     D(0x9c) );
+  case 0x97: return SEL( mv, 0x97,     D(0x97) );
+  case 0x9f: return SEL( mv, 0x9f,     D(0x9f) );
+
+  case 0x8d: return SEL( FD_VM_SBPF_CALLX_USES_SRC_REG( v ), 0x8d, D(0x8d) ); /* SIMD-0173: CALLX */
+
+  case 0x36: case 0x3e: case 0x46: case 0x4e: case 0x56: case 0x5e: case 0x66: case 0x6e: /* SIMD-0174: PQR */
+  case 0x76: case 0x7e: case 0x86: case 0x8e: case 0x96: case 0x9e: case 0xb6: case 0xbe:
+  case 0xc6: case 0xce: case 0xd6: case 0xde: case 0xe6: case 0xee: case 0xf6: case 0xfe:
+    return SEL( pqr, (int)opcode, XLAT_ILL );
+
+  case 0x24: case 0x34: case 0x94: /* SIMD-0174: disable MUL, DIV, MOD */
+    return SEL( pqr, XLAT_ILL, (int)opcode );
+
+  case 0x84: return SEL( FD_VM_SBPF_ENABLE_NEG( v ), 0x84, XLAT_ILL ); /* SIMD-0174: NEG */
+
+  case 0x04: case 0x0c: case 0x1c: case 0xbc: /* SIMD-0174: explicit sign extension */
+    return SEL( sx, (int)opcode, D((int)opcode) );
+  case 0x14: case 0x17:                       /* SIMD-0174: register immediate subtraction */
+    return SEL( FD_VM_SBPF_SWAP_SUB_REG_IMM_OPERANDS( v ), (int)opcode, D((int)opcode) );
+
+  case 0x85: return SEL( FD_VM_SBPF_STATIC_SYSCALLS( v ), 0x85, D(0x85) ); /* SIMD-0178: static syscalls */
+  case 0x95: return SEL( FD_VM_SBPF_STATIC_SYSCALLS( v ), 0x95, 0x9d    );
+  case 0x9d: return SEL( FD_VM_SBPF_STATIC_SYSCALLS( v ), 0x9d, XLAT_ILL );
+
+  default: break;
+  }
+# undef D
+# undef SEL
+
+  return enabled[ opcode ] ? (int)opcode : XLAT_ILL;
+}
+
+/* fd_vm_jit_emit_instr emits code for the instruction at pc and
+   returns the pc of the next instruction in the linear segment. */
+
+static ulong
+fd_vm_jit_emit_instr( fd_vm_jit_asm_t * a,
+                      ulong             pc ) {
+
+  uchar * p = a->p;
+  a->tbl[ pc ] = (uint)(p - a->code);
+
+  ulong instr  = a->text[ pc ];
+  ulong dst    = fd_vm_instr_dst   ( instr );
+  ulong src    = fd_vm_instr_src   ( instr );
+  ulong offset = fd_vm_instr_offset( instr ); /* sign extended */
+  uint  imm    = fd_vm_instr_imm   ( instr );
+  ulong next   = pc+1UL;
+
+  int label = fd_vm_jit_xlat( fd_vm_instr_opcode( instr ), a->sbpf_version );
+
+# define ALU32_I(ext,sx) p = emit_ld32( p, RAX, dst ); p = emit_alu_ri( p, 0, (ext), RAX, imm ); if( sx ) p = emit_sext( p ); p = emit_st64( p, RAX, dst )
+# define ALU32_R(opc,sx) p = emit_ld32( p, RAX, dst ); p = emit_m( p, 0, (opc), RAX, src );      if( sx ) p = emit_sext( p ); p = emit_st64( p, RAX, dst )
+# define ALU64_I(ext)    p = emit_alu_mi( p, 1, (ext), dst, imm )
+# define ALU64_R(opc)    p = emit_ld64( p, RAX, src ); p = emit_m( p, 1, (opc), RAX, dst )
+# define SHF32_I(ext)    p = emit_ld32( p, RAX, dst ); p = emit_r( p, 0, 0xc1U, (ext), RAX ); p = emit1( p, imm & 31U ); p = emit_st64( p, RAX, dst )
+# define SHF64_I(ext)    if( imm & 63U ) { p = emit_m( p, 1, 0xc1U, (ext), dst ); p = emit1( p, imm & 63U ); }
+# define SHF32_R(ext)    p = emit_ld32( p, RCX, src ); p = emit_ld32( p, RAX, dst ); p = emit_r( p, 0, 0xd3U, (ext), RAX ); p = emit_st64( p, RAX, dst )
+# define SHF64_R(ext)    p = emit_ld32( p, RCX, src ); p = emit_m( p, 1, 0xd3U, (ext), dst )
+# define JCC_I(cc)       p = emit_bill( a, p, pc ); p = emit_alu_mi( p, 1, ALU_CMP, dst, imm ); p = emit_branch( a, p, pc, (cc), next+offset )
+# define JCC_R(cc)       p = emit_bill( a, p, pc ); p = emit_ld64( p, RAX, src ); p = emit_m( p, 1, 0x39U, RAX, dst ); p = emit_branch( a, p, pc, (cc), next+offset )
+# define LD(h)           p = emit_mem( a, p, pc, (h), src, offset, 0, dst, 0, 0U,  0 )
+# define ST_I(h,sx)      p = emit_mem( a, p, pc, (h), dst, offset, 1, src, 0, imm, (sx) )
+# define ST_R(h)         p = emit_mem( a, p, pc, (h), dst, offset, 1, src, 1, 0U,  0 )
+# define DIV(w,sgn,rem,is_imm,sx) p = emit_div( a, p, pc, (w), (sgn), (rem), dst, src, (is_imm), imm, (sx) )
+
+  switch( label ) {
+
+  /* 0x00 - 0x0f ******************************************************/
+
+  case 0x04:           ALU32_I( ALU_ADD, 0 ); break; /* ADD_IMM */
+  case 0x04|XLAT_DEPR: ALU32_I( ALU_ADD, 1 ); break;
+  case 0x05:                                         /* JA */
+    p = emit_bill( a, p, pc );
+    p = emit_jump( a, p, pc, next+offset );
+    break;
+  case 0x07:           ALU64_I( ALU_ADD );    break; /* ADD64_IMM */
+  case 0x0c:           ALU32_R( 0x03U, 0 );   break; /* ADD_REG */
+  case 0x0c|XLAT_DEPR: ALU32_R( 0x03U, 1 );   break;
+  case 0x0f:           ALU64_R( 0x01U );      break; /* ADD64_REG */
+
+  /* 0x10 - 0x1f ******************************************************/
+
+  case 0x14:                                         /* SUB_IMM */
+    p = emit_mov32( p, RAX, imm ); p = emit_m( p, 0, 0x2bU, RAX, dst ); p = emit_st64( p, RAX, dst );
+    break;
+  case 0x14|XLAT_DEPR: ALU32_I( ALU_SUB, 1 ); break;
+  case 0x15:           JCC_I( CC_E );         break; /* JEQ_IMM */
+  case 0x17:                                         /* SUB64_IMM */
+    p = emit_movs( p, RAX, imm ); p = emit_m( p, 1, 0x2bU, RAX, dst ); p = emit_st64( p, RAX, dst );
+    break;
+  case 0x17|XLAT_DEPR: ALU64_I( ALU_SUB );    break;
+  case 0x18:                                         /* LDQ */
+    p = emit1( p, 0x49U ); p = emit1( p, 0x83U ); p = emit1( p, 0xc4U ); p = emit1( p, 0x01U ); /* add r12,1 (ic_correction++) */
+    if( FD_UNLIKELY( next>=a->text_cnt ) ) { /* incomplete LDQ, rejected by validation */
+      p = emit_fix( a, p, -1, FIX_ERR, next+1UL, FD_VM_ERR_SIGTEXT );
+    } else {
+      p = emit_mov64( p, RAX, (ulong)imm | ((ulong)fd_vm_instr_imm( a->text[ next ] ) << 32) );
+      p = emit_st64( p, RAX, dst );
+    }
+    next++;
+    break;
+  case 0x1c:           ALU32_R( 0x2bU, 0 );   break; /* SUB_REG */
+  case 0x1c|XLAT_DEPR: ALU32_R( 0x2bU, 1 );   break;
+  case 0x1d:           JCC_R( CC_E );         break; /* JEQ_REG */
+  case 0x1f:           ALU64_R( 0x29U );      break; /* SUB64_REG */
+
+  /* 0x20 - 0x2f ******************************************************/
+
+  case 0x24:                                         /* MUL_IMM */
+    p = emit_ld32( p, RAX, dst ); p = emit4( emit_r( p, 0, 0x69U, RAX, RAX ), imm ); p = emit_sext( p ); p = emit_st64( p, RAX, dst );
+    break;
+  case 0x25:           JCC_I( CC_A );         break; /* JGT_IMM */
+  case 0x27:           ST_I( H_ST_1, 0 );     break; /* STB */
+  case 0x2c:           LD( H_LD_1 );          break; /* LDXB */
+  case 0x2d:           JCC_R( CC_A );         break; /* JGT_REG */
+  case 0x2f:           ST_R( H_ST_1 );        break; /* STXB */
+  case 0x27|XLAT_DEPR:                               /* MUL64_IMM */
+    p = emit_ld64( p, RAX, dst ); p = emit4( emit_r( p, 1, 0x69U, RAX, RAX ), imm ); p = emit_st64( p, RAX, dst );
+    break;
+  case 0x2c|XLAT_DEPR: ALU32_R( 0x0fafU, 1 ); break; /* MUL_REG */
+  case 0x2f|XLAT_DEPR: ALU64_R( 0x0fafU ); p = emit_st64( p, RAX, dst ); break; /* MUL64_REG (imul rax,[dst]) */
+
+  /* 0x30 - 0x3f ******************************************************/
+
+  case 0x34:           DIV( 0, 0, 0, 1, 0 );  break; /* DIV_IMM */
+  case 0x35:           JCC_I( CC_AE );        break; /* JGE_IMM */
+  case 0x36:                                         /* UHMUL64_IMM */
+    p = emit_ld64( p, RAX, dst ); p = emit_mov32( p, RCX, imm ); p = emit_r( p, 1, 0xf7U, F7_MUL, RCX ); p = emit_st64( p, RDX, dst );
+    break;
+  case 0x37:           ST_I( H_ST_2, 0 );     break; /* STH */
+  case 0x3c:           LD( H_LD_2 );          break; /* LDXH */
+  case 0x3d:           JCC_R( CC_AE );        break; /* JGE_REG */
+  case 0x3f:           ST_R( H_ST_2 );        break; /* STXH */
+  case 0x3e:                                         /* UHMUL64_REG */
+    p = emit_ld64( p, RAX, dst ); p = emit_m( p, 1, 0xf7U, F7_MUL, src ); p = emit_st64( p, RDX, dst );
+    break;
+  case 0x37|XLAT_DEPR: DIV( 1, 0, 0, 1, 1 );  break; /* DIV64_IMM */
+  case 0x3c|XLAT_DEPR: DIV( 0, 0, 0, 0, 0 );  break; /* DIV_REG */
+  case 0x3f|XLAT_DEPR: DIV( 1, 0, 0, 0, 0 );  break; /* DIV64_REG */
+
+  /* 0x40 - 0x4f ******************************************************/
+
+  case 0x44:           ALU32_I( ALU_OR, 0 );  break; /* OR_IMM */
+  case 0x45:                                         /* JSET_IMM */
+    p = emit_bill( a, p, pc ); p = emit_m( p, 1, 0xf7U, 0U, dst ); p = emit4( p, imm ); p = emit_branch( a, p, pc, CC_NE, next+offset );
+    break;
+  case 0x46:           DIV( 0, 0, 0, 1, 0 );  break; /* UDIV32_IMM */
+  case 0x47:           ALU64_I( ALU_OR );     break; /* OR64_IMM */
+  case 0x4c:           ALU32_R( 0x0bU, 0 );   break; /* OR_REG */
+  case 0x4d:                                         /* JSET_REG */
+    p = emit_bill( a, p, pc ); p = emit_ld64( p, RAX, src ); p = emit_m( p, 1, 0x85U, RAX, dst ); p = emit_branch( a, p, pc, CC_NE, next+offset );
+    break;
+  case 0x4e:           DIV( 0, 0, 0, 0, 0 );  break; /* UDIV32_REG */
+  case 0x4f:           ALU64_R( 0x09U );      break; /* OR64_REG */
+
+  /* 0x50 - 0x5f ******************************************************/
+
+  case 0x54:           ALU32_I( ALU_AND, 0 ); break; /* AND_IMM */
+  case 0x55:           JCC_I( CC_NE );        break; /* JNE_IMM */
+  case 0x56:           DIV( 1, 0, 0, 1, 0 );  break; /* UDIV64_IMM */
+  case 0x57:           ALU64_I( ALU_AND );    break; /* AND64_IMM */
+  case 0x5c:           ALU32_R( 0x23U, 0 );   break; /* AND_REG */
+  case 0x5d:           JCC_R( CC_NE );        break; /* JNE_REG */
+  case 0x5e:           DIV( 1, 0, 0, 0, 0 );  break; /* UDIV64_REG */
+  case 0x5f:           ALU64_R( 0x21U );      break; /* AND64_REG */
+
+  /* 0x60 - 0x6f ******************************************************/
+
+  case 0x64:           SHF32_I( SHF_SHL );    break; /* LSH_IMM */
+  case 0x65:           JCC_I( CC_G );         break; /* JSGT_IMM */
+  case 0x66:           DIV( 0, 0, 1, 1, 0 );  break; /* UREM32_IMM */
+  case 0x67:           SHF64_I( SHF_SHL );    break; /* LSH64_IMM */
+  case 0x6c:           SHF32_R( SHF_SHL );    break; /* LSH_REG */
+  case 0x6d:           JCC_R( CC_G );         break; /* JSGT_REG */
+  case 0x6e:           DIV( 0, 0, 1, 0, 0 );  break; /* UREM32_REG */
+  case 0x6f:           SHF64_R( SHF_SHL );    break; /* LSH64_REG */
+
+  /* 0x70 - 0x7f ******************************************************/
+
+  case 0x74:           SHF32_I( SHF_SHR );    break; /* RSH_IMM */
+  case 0x75:           JCC_I( CC_GE );        break; /* JSGE_IMM */
+  case 0x76:           DIV( 1, 0, 1, 1, 0 );  break; /* UREM64_IMM */
+  case 0x77:           SHF64_I( SHF_SHR );    break; /* RSH64_IMM */
+  case 0x7c:           SHF32_R( SHF_SHR );    break; /* RSH_REG */
+  case 0x7d:           JCC_R( CC_GE );        break; /* JSGE_REG */
+  case 0x7e:           DIV( 1, 0, 1, 0, 0 );  break; /* UREM64_REG */
+  case 0x7f:           SHF64_R( SHF_SHR );    break; /* RSH64_REG */
+
+  /* 0x80 - 0x8f ******************************************************/
+
+  case 0x84:                                         /* NEG */
+    p = emit_ld32( p, RAX, dst ); p = emit_r( p, 0, 0xf7U, F7_NEG, RAX ); p = emit_st64( p, RAX, dst );
+    break;
+  case 0x85:                                         /* CALL_IMM */
+    p = emit_bill( a, p, pc );
+    p = emit_push( a, p, pc );
+    p = emit_jump( a, p, pc, (ulong)((long)pc + (long)(int)imm) + 1UL );
+    break;
+  case 0x85|XLAT_DEPR: {                             /* CALL_IMM / SYSCALL */
+    p = emit_bill( a, p, pc );
+    p = emit_syscall( p, pc, (ulong)imm, 1 );
+    p = emit_r( p, 0, 0x85U, RAX, RAX );                                   /* test eax,eax */
+    p = emit_goto( a, p, (int)CC_E, next );                                /* syscall done */
+    p = emit_r( p, 0, 0x83U, ALU_CMP, RAX ); p = emit1( p, 1U );           /* cmp eax,1 */
+    p = emit_fix( a, p, (int)CC_NE, FIX_EAX, pc, 0 );                      /* syscall failed */
+    /* Not a syscall, resolve the call target at compile time (see
+       interpreter for the Agave order of checks) */
+    ulong target_pc;
+    if( FD_UNLIKELY( imm==0x71e3cf81U ) ) {
+      target_pc = a->entry_pc;
+    } else {
+      target_pc = (ulong)fd_pchash_inverse( imm );
+      if( FD_UNLIKELY( (target_pc>a->text_cnt) || !a->calldests ||
+                       !fd_sbpf_calldests_valid_idx( a->calldests, target_pc ) ||
+                       !fd_sbpf_calldests_test     ( a->calldests, target_pc ) ) ) {
+        p = emit_fix( a, p, -1, FIX_ERR, pc, FD_VM_ERR_SIGILL );           /* sigcall */
+        break;
+      }
+    }
+    p = emit_push( a, p, pc );
+    p = emit_jump( a, p, pc, target_pc );
+    break;
+  }
+  case 0x86:                                         /* LMUL32_IMM */
+    p = emit_ld32( p, RAX, dst ); p = emit4( emit_r( p, 0, 0x69U, RAX, RAX ), imm ); p = emit_st64( p, RAX, dst );
+    break;
+  case 0x87:           ST_I( H_ST_4, 0 );     break; /* STW */
+  case 0x87|XLAT_DEPR: p = emit_m( p, 1, 0xf7U, F7_NEG, dst ); break; /* NEG64 */
+  case 0x8c:           LD( H_LD_4 );          break; /* LDXW */
+  case 0x8d:                                         /* CALL_REG */
+  case 0x8d|XLAT_DEPR:
+    p = emit_bill( a, p, pc );
+    p = emit_vm_arg( p );
+    p = emit_mov32( p, RSI, pc );
+    if( label==0x8d ) p = emit_ld64 ( p, RDX, src      ); /* read before push */
+    else              p = emit_mov32( p, RDX, imm & 15U ); /* read after push */
+    p = emit_call( p, label==0x8d ? H_CALLX : H_CALLXD );
+    p = emit_r( p, 1, 0x85U, RAX, RAX );                   /* test rax,rax */
+    p = emit_fix( a, p, (int)CC_S, FIX_EAX, pc, 0 );
+    p = emit_dyn( a, p, pc );
+    break;
+  case 0x8e:           ALU32_R( 0x0fafU, 0 ); break; /* LMUL32_REG */
+  case 0x8f:           ST_R( H_ST_4 );        break; /* STXW */
+
+  /* 0x90 - 0x9f ******************************************************/
+
+  case 0x94:           DIV( 0, 0, 1, 1, 0 );  break; /* MOD_IMM */
+  case 0x95:                                         /* SYSCALL */
+    p = emit_bill( a, p, pc );
+    if( FD_UNLIKELY( imm>=FD_VM_SBPF_STATIC_SYSCALLS_LIST_SZ ) ) { /* rejected by validation */
+      p = emit_fix( a, p, -1, FIX_ERR, pc, FD_VM_ERR_SIGILL );
+      break;
+    }
+    /* The interpreter bills the segment a second time if the syscall
+       is not registered at exec time (sigill after BRANCH_BEGIN).  The
+       generated code cannot reproduce that (pc0 is folded into the
+       meter) so the syscalls used are recorded and fd_vm_exec_jit
+       runs the interpreter instead if any of them is missing. */
+    a->static_syscalls[ imm>>6 ] |= 1UL<<(imm & 63UL);
+    p = emit_syscall( p, pc, (ulong)FD_VM_SBPF_STATIC_SYSCALLS_LIST[ imm ], FD_VM_ERR_SIGILL );
+    p = emit_helper_check( a, p, pc );
+    break;
+  case 0x96:                                         /* LMUL64_IMM */
+    p = emit_ld64( p, RAX, dst ); p = emit4( emit_r( p, 1, 0x69U, RAX, RAX ), imm ); p = emit_st64( p, RAX, dst );
+    break;
+  case 0x97:           ST_I( H_ST_8, 1 );     break; /* STQ */
+  case 0x9c:           LD( H_LD_8 );          break; /* LDXQ */
+  case 0x9d:                                         /* EXIT */
+    p = emit_bill( a, p, pc );
+    p = emit_vm_arg( p );
+    p = emit_call( p, H_RET );
+    p = emit_r( p, 1, 0x83U, ALU_CMP, RAX ); p = emit1( p, 0xffU );        /* cmp rax,-1 */
+    p = emit_fix( a, p, (int)CC_E, FIX_ERR, pc, FD_VM_SUCCESS );           /* sigexit */
+    p = emit_dyn( a, p, pc );
+    break;
+  case 0x9e:           ALU64_R( 0x0fafU ); p = emit_st64( p, RAX, dst ); break; /* LMUL64_REG */
+  case 0x9f:           ST_R( H_ST_8 );        break; /* STXQ */
+  case 0x97|XLAT_DEPR: DIV( 1, 0, 1, 1, 1 );  break; /* MOD64_IMM */
+  case 0x9c|XLAT_DEPR: DIV( 0, 0, 1, 0, 0 );  break; /* MOD_REG */
+  case 0x9f|XLAT_DEPR: DIV( 1, 0, 1, 0, 0 );  break; /* MOD64_REG */
+
+  /* 0xa0 - 0xaf ******************************************************/
+
+  case 0xa4:           ALU32_I( ALU_XOR, 0 ); break; /* XOR_IMM */
+  case 0xa5:           JCC_I( CC_B );         break; /* JLT_IMM */
+  case 0xa7:           ALU64_I( ALU_XOR );    break; /* XOR64_IMM */
+  case 0xac:           ALU32_R( 0x33U, 0 );   break; /* XOR_REG */
+  case 0xad:           JCC_R( CC_B );         break; /* JLT_REG */
+  case 0xaf:           ALU64_R( 0x31U );      break; /* XOR64_REG */
+
+  /* 0xb0 - 0xbf ******************************************************/
+
+  case 0xb4:                                         /* MOV_IMM */
+    p = emit_mov32( p, RAX, imm ); p = emit_st64( p, RAX, dst );
+    break;
+  case 0xb5:           JCC_I( CC_BE );        break; /* JLE_IMM */
+  case 0xb6:                                         /* SHMUL64_IMM */
+    p = emit_ld64( p, RAX, dst ); p = emit_movs( p, RCX, imm ); p = emit_r( p, 1, 0xf7U, F7_IMUL, RCX ); p = emit_st64( p, RDX, dst );
+    break;
+  case 0xb7:                                         /* MOV64_IMM */
+    p = emit_m( p, 1, 0xc7U, 0U, dst ); p = emit4( p, imm );
+    break;
+  case 0xbc:                                         /* MOV_REG */
+    p = emit_m( p, 1, 0x63U, RAX, src ); p = emit_st64( p, RAX, dst );
+    break;
+  case 0xbc|XLAT_DEPR:
+    p = emit_ld32( p, RAX, src ); p = emit_st64( p, RAX, dst );
+    break;
+  case 0xbd:           JCC_R( CC_BE );        break; /* JLE_REG */
+  case 0xbe:                                         /* SHMUL64_REG */
+    p = emit_ld64( p, RAX, dst ); p = emit_m( p, 1, 0xf7U, F7_IMUL, src ); p = emit_st64( p, RDX, dst );
+    break;
+  case 0xbf:                                         /* MOV64_REG */
+    p = emit_ld64( p, RAX, src ); p = emit_st64( p, RAX, dst );
+    break;
+
+  /* 0xc0 - 0xcf ******************************************************/
+
+  case 0xc4:           SHF32_I( SHF_SAR );    break; /* ARSH_IMM */
+  case 0xc5:           JCC_I( CC_L );         break; /* JSLT_IMM */
+  case 0xc6:           DIV( 0, 1, 0, 1, 1 );  break; /* SDIV32_IMM */
+  case 0xc7:           SHF64_I( SHF_SAR );    break; /* ARSH64_IMM */
+  case 0xcc:           SHF32_R( SHF_SAR );    break; /* ARSH_REG */
+  case 0xcd:           JCC_R( CC_L );         break; /* JSLT_REG */
+  case 0xce:           DIV( 0, 1, 0, 0, 0 );  break; /* SDIV32_REG */
+  case 0xcf:           SHF64_R( SHF_SAR );    break; /* ARSH64_REG */
+
+  /* 0xd0 - 0xdf ******************************************************/
+
+  case 0xd4:                                         /* END_LE */
+    switch( imm ) {
+    case 16U: p = emit_m( p, 0, 0x0fb7U, RAX, dst ); p = emit_st64( p, RAX, dst ); break;
+    case 32U: p = emit_ld32( p, RAX, dst );          p = emit_st64( p, RAX, dst ); break;
+    case 64U:                                                                     break;
+    default:  p = emit_fix( a, p, -1, FIX_ERR, pc, FD_VM_ERR_SIGILL );            break;
+    }
+    break;
+  case 0xd5:           JCC_I( CC_LE );        break; /* JSLE_IMM */
+  case 0xd6:           DIV( 1, 1, 0, 1, 1 );  break; /* SDIV64_IMM */
+  case 0xdc:                                         /* END_BE */
+    switch( imm ) {
+    case 16U: /* movzx eax,word [dst]; rol ax,8 */
+      p = emit_m( p, 0, 0x0fb7U, RAX, dst );
+      p = emit1( p, 0x66U ); p = emit1( p, 0xc1U ); p = emit1( p, 0xc0U ); p = emit1( p, 8U );
+      p = emit_st64( p, RAX, dst );
+      break;
+    case 32U: p = emit_ld32( p, RAX, dst ); p = emit_opc( p, 0x40U, 0x0fc8U ); p = emit_st64( p, RAX, dst ); break;
+    case 64U: p = emit_ld64( p, RAX, dst ); p = emit_opc( p, 0x48U, 0x0fc8U ); p = emit_st64( p, RAX, dst ); break;
+    default:  p = emit_fix( a, p, -1, FIX_ERR, pc, FD_VM_ERR_SIGILL ); break;
+    }
+    break;
+  case 0xdd:           JCC_R( CC_LE );        break; /* JSLE_REG */
+  case 0xde:           DIV( 1, 1, 0, 0, 0 );  break; /* SDIV64_REG */
+
+  /* 0xe0 - 0xff ******************************************************/
+
+  case 0xe6:           DIV( 0, 1, 1, 1, 1 );  break; /* SREM32_IMM */
+  case 0xee:           DIV( 0, 1, 1, 0, 0 );  break; /* SREM32_REG */
+  case 0xf6:           DIV( 1, 1, 1, 1, 1 );  break; /* SREM64_IMM */
+  case 0xf7:                                         /* HOR64 (billed like a branch) */
+    p = emit_bill( a, p, pc );
+    p = emit_mov32( p, RAX, imm ); p = emit_r( p, 1, 0xc1U, SHF_SHL, RAX ); p = emit1( p, 32U ); p = emit_m( p, 1, 0x09U, RAX, dst );
+    break;
+  case 0xfe:           DIV( 1, 1, 1, 0, 0 );  break; /* SREM64_REG */
+
+  default: /* sigill */
+    p = emit_fix( a, p, -1, FIX_ERR, pc, FD_VM_ERR_SIGILL );
+    break;
+  }
+
+# undef DIV
+# undef ST_R
+# undef ST_I
+# undef LD
+# undef JCC_R
+# undef JCC_I
+# undef SHF64_R
+# undef SHF32_R
+# undef SHF64_I
+# undef SHF32_I
+# undef ALU64_R
+# undef ALU64_I
+# undef ALU32_R
+# undef ALU32_I
+
+  a->p = p;
+  return next;
+}
+
+/* fd_vm_jit_room returns 1 if there is space to emit another
+   instruction */
+
+static inline int
+fd_vm_jit_room( fd_vm_jit_asm_t const * a ) {
+  return ( (ulong)(a->p_max - a->p) >= FD_VM_JIT_INSTR_SZ_MAX ) &
+         ( a->fix_max - a->fix_cnt >= FD_VM_JIT_INSTR_FIX_MAX );
+}
+
+int
+fd_vm_jit_compile( fd_vm_jit_t *   jit,
+                   uchar *         code,
+                   ulong           code_max,
+                   ulong const *   text,
+                   ulong           text_cnt,
+                   ulong           entry_pc,
+                   ulong const *   calldests,
+                   ulong           sbpf_version ) {
+
+  if( FD_UNLIKELY( !jit                                   ) ) return FD_VM_ERR_INVAL;
+  if( FD_UNLIKELY( !code                                  ) ) return FD_VM_ERR_INVAL;
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)code, 64UL ) ) ) return FD_VM_ERR_INVAL;
+  if( FD_UNLIKELY( (!text) & (!!text_cnt)                 ) ) return FD_VM_ERR_INVAL;
+
+  ulong footprint = fd_vm_jit_code_max( text_cnt );
+  if( FD_UNLIKELY( !footprint          ) ) return FD_VM_ERR_INVAL;
+  if( FD_UNLIKELY( code_max<footprint  ) ) return FD_VM_ERR_FULL;
+
+  /* Layout: [pc table | header | hot code | deferred code | fault stubs | ... | fixup scratch] */
+
+  ulong tbl_sz  = fd_ulong_align_up( 4UL*text_cnt, 64UL );
+  ulong fix_max = FD_VM_JIT_INSTR_FIX_MAX*(text_cnt+1UL);
+  ulong fix_off = fd_ulong_align_dn( code_max - fix_max*sizeof(fd_vm_jit_fixup_t), 8UL );
+
+  fd_vm_jit_asm_t a[1] = {{
+    .code         = code,
+    .p            = code + tbl_sz,
+    .p_max        = code + fix_off,
+    .tbl          = (uint *)code,
+    .fix          = (fd_vm_jit_fixup_t *)(code + fix_off),
+    .fix_cnt      = 0UL,
+    .fix_max      = fix_max,
+    .text         = text,
+    .text_cnt     = text_cnt,
+    .entry_pc     = entry_pc,
+    .calldests    = calldests,
+    .sbpf_version = sbpf_version
+  }};
+
+  /* Entry (fd_vm_jit_entry_t) */
+
+  ulong   entry_off = tbl_sz;
+  uchar * p         = a->p;
+  p = emit1( p, 0x53U );                                                  /* push rbx */
+  p = emit1( p, 0x55U );                                                  /* push rbp */
+  p = emit1( p, 0x41U ); p = emit1( p, 0x54U );                           /* push r12 */
+  p = emit1( p, 0x41U ); p = emit1( p, 0x55U );                           /* push r13 */
+  p = emit1( p, 0x41U ); p = emit1( p, 0x56U );                           /* push r14 */
+  p = emit1( p, 0x41U ); p = emit1( p, 0x57U );                           /* push r15 */
+  p = emit1( p, 0x48U ); p = emit1( p, 0x83U ); p = emit1( p, 0xecU ); p = emit1( p, 8U ); /* sub rsp,8 */
+  p = emit_r( p, 1, 0x89U, RDI, RBP );                                    /* mov rbp,rdi */
+  p = emit1( p, 0x48U ); p = emit1( p, 0x8dU ); p = emit1( p, 0x9fU );    /* lea rbx,[rdi+reg] */
+  p = emit4( p, offsetof( fd_vm_t, reg ) );
+  p = emit_r( p, 1, 0x89U, RSI, R13 );                                    /* mov r13,rsi */
+  p = emit_r( p, 1, 0x89U, RDX, R15 );                                    /* mov r15,rdx */
+  p = emit1( p, 0x4cU ); p = emit1( p, 0x8dU ); p = emit1( p, 0x35U );    /* lea r14,[rip-(p+4-code)] */
+  p = emit4( p, (ulong)( -(long)( (p+4) - code ) ) );
+  p = emit1( p, 0x4dU ); p = emit1( p, 0x8bU ); p = emit1( p, 0x65U ); p = emit1( p, FRAME_METER ); /* mov r12,[r13+meter] */
+  p = emit_r( p, 1, 0x89U, RCX, RAX );                                    /* mov rax,rcx */
+  p = emit_alu_ri( p, 1, ALU_CMP, RAX, text_cnt );
+  p = emit1( p, 0x73U ); uchar * skip = p; p = emit1( p, 0U );            /* jae sigtext */
+  p = emit1( p, 0x41U ); p = emit1( p, 0x8bU ); p = emit1( p, 0x0cU ); p = emit1( p, 0x86U ); /* mov ecx,[r14+rax*4] */
+  p = emit_r( p, 1, 0x01U, R14, RCX );                                    /* add rcx,r14 */
+  p = emit1( p, 0xffU ); p = emit1( p, 0xe1U );                           /* jmp rcx */
+  *skip = (uchar)(p - (skip+1));
+
+  /* Jump to out of bounds pc in rax */
+
+  a->sigtext_off = (ulong)(p - code);
+  p = emit_r( p, 1, 0x89U, RAX, RSI );                                    /* mov rsi,rax */
+  p = emit_mov32( p, RAX, (ulong)(uint)FD_VM_ERR_SIGTEXT );
+
+  /* Exit with err in eax at pc in rsi */
+
+  a->exit_off = (ulong)(p - code);
+  p = emit1( p, 0x4dU ); p = emit1( p, 0x89U ); p = emit1( p, 0x65U ); p = emit1( p, FRAME_METER ); /* mov [r13+meter],r12 */
+  p = emit1( p, 0x49U ); p = emit1( p, 0x89U ); p = emit1( p, 0x75U ); p = emit1( p, FRAME_PC    ); /* mov [r13+pc],rsi */
+  p = emit1( p, 0x48U ); p = emit1( p, 0x83U ); p = emit1( p, 0xc4U ); p = emit1( p, 8U );          /* add rsp,8 */
+  p = emit1( p, 0x41U ); p = emit1( p, 0x5fU );                           /* pop r15 */
+  p = emit1( p, 0x41U ); p = emit1( p, 0x5eU );                           /* pop r14 */
+  p = emit1( p, 0x41U ); p = emit1( p, 0x5dU );                           /* pop r13 */
+  p = emit1( p, 0x41U ); p = emit1( p, 0x5cU );                           /* pop r12 */
+  p = emit1( p, 0x5dU );                                                  /* pop rbp */
+  p = emit1( p, 0x5bU );                                                  /* pop rbx */
+  p = emit1( p, 0xc3U );                                                  /* ret */
+  a->p = p;
+
+  /* Hot code.  Instructions are emitted in text order such that a
+     linear segment falls through.  The second word of an LDQ gets its
+     code emitted out of line below (it is only reachable by a jump into
+     the middle of the LDQ, which validation rejects). */
+
+  for( ulong pc=0UL; pc<text_cnt; ) {
+    if( FD_UNLIKELY( !fd_vm_jit_room( a ) ) ) return FD_VM_ERR_FULL;
+    pc = fd_vm_jit_emit_instr( a, pc );
+  }
+
+  if( FD_UNLIKELY( !fd_vm_jit_room( a ) ) ) return FD_VM_ERR_FULL;
+  a->p = emit_goto( a, a->p, -1, text_cnt ); /* ran off the end of text */
+
+  for( ulong pc=0UL; pc<text_cnt; ) {
+    if( fd_vm_jit_xlat( fd_vm_instr_opcode( text[ pc ] ), sbpf_version )!=0x18 || pc+1UL>=text_cnt ) { pc++; continue; }
+    if( FD_UNLIKELY( !fd_vm_jit_room( a ) ) ) return FD_VM_ERR_FULL;
+    ulong next = fd_vm_jit_emit_instr( a, pc+1UL );
+    a->p = emit_goto( a, a->p, -1, next );
+    pc += 2UL;
+  }
+
+  /* Fault stubs and fixups */
+
+  for( ulong i=0UL; i<a->fix_cnt; i++ ) {
+    fd_vm_jit_fixup_t const * f = a->fix + i;
+    ulong dst_off;
+    if( f->kind==FIX_JMP ) {
+      dst_off = a->tbl[ f->pc ];
+    } else {
+      if( FD_UNLIKELY( (ulong)(a->p_max - a->p) < 32UL ) ) return FD_VM_ERR_FULL;
+      p       = a->p;
+      dst_off = (ulong)(p - code);
+      if( f->kind==FIX_ERR ) p = emit_mov32( p, RAX, (ulong)(uint)f->err );
+      if( f->pc<=UINT_MAX  ) p = emit_mov32( p, RSI, f->pc );
+      else                   p = emit_mov64( p, RSI, f->pc );
+      p    = emit_jabs( a, p, -1, a->exit_off );
+      a->p = p;
+    }
+    FD_STORE( uint, code + f->at, (uint)( (long)dst_off - (long)(f->at + 4U) ) );
+  }
+
+  jit->code         = code;
+  jit->code_sz      = (ulong)(a->p - code);
+  jit->entry_off    = entry_off;
+  jit->text_cnt     = text_cnt;
+  jit->entry_pc     = entry_pc;
+  jit->sbpf_version = sbpf_version;
+  memcpy( jit->static_syscalls, a->static_syscalls, sizeof(jit->static_syscalls) );
+  return FD_VM_SUCCESS;
+}
+
+/* Code memory ********************************************************/
+
+uchar *
+fd_vm_jit_code_alloc( ulong sz ) {
+  sz = fd_ulong_align_up( sz, FD_SHMEM_NORMAL_PAGE_SZ );
+  void * mem = mmap( NULL, sz, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0 );
+  if( FD_UNLIKELY( mem==MAP_FAILED ) ) {
+    FD_LOG_WARNING(( "mmap(NULL,%lu KiB,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0) failed (%i-%s)",
+                     sz>>10, errno, fd_io_strerror( errno ) ));
+    return NULL;
+  }
+  return (uchar *)mem;
+}
+
+int
+fd_vm_jit_code_seal( uchar * code,
+                     ulong   sz ) {
+  sz = fd_ulong_align_up( sz, FD_SHMEM_NORMAL_PAGE_SZ );
+  if( FD_UNLIKELY( mprotect( code, sz, PROT_READ|PROT_EXEC ) ) ) {
+    int err = errno;
+    FD_LOG_WARNING(( "mprotect(%p,%lu KiB,PROT_READ|PROT_EXEC) failed (%i-%s)", (void *)code, sz>>10, err, fd_io_strerror( err ) ));
+    return err;
+  }
+  return 0;
+}
+
+void
+fd_vm_jit_code_free( uchar * code,
+                     ulong   sz ) {
+  if( FD_UNLIKELY( !code ) ) return;
+  sz = fd_ulong_align_up( sz, FD_SHMEM_NORMAL_PAGE_SZ );
+  if( FD_UNLIKELY( munmap( code, sz ) ) )
+    FD_LOG_WARNING(( "munmap(%p,%lu KiB) failed (%i-%s)", (void *)code, sz>>10, errno, fd_io_strerror( errno ) ));
+}
+
+int
+fd_vm_jit_code_map( ulong    sz,
+                    uchar ** _rw,
+                    uchar ** _rx ) {
+  sz = fd_ulong_align_up( sz, FD_SHMEM_NORMAL_PAGE_SZ );
+
+  int fd = memfd_create( "fd_vm_jit", MFD_CLOEXEC );
+  if( FD_UNLIKELY( fd<0 ) ) {
+    int err = errno;
+    FD_LOG_WARNING(( "memfd_create(\"fd_vm_jit\",MFD_CLOEXEC) failed (%i-%s)", err, fd_io_strerror( err ) ));
+    return err;
+  }
+
+  int    err = 0;
+  void * rw  = MAP_FAILED;
+  void * rx  = MAP_FAILED;
+  if( FD_UNLIKELY( ftruncate( fd, (long)sz ) ) ) {
+    err = errno;
+    FD_LOG_WARNING(( "ftruncate(fd_vm_jit,%lu KiB) failed (%i-%s)", sz>>10, err, fd_io_strerror( err ) ));
+    goto done;
+  }
+
+  rw = mmap( NULL, sz, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0 );
+  if( FD_UNLIKELY( rw==MAP_FAILED ) ) {
+    err = errno;
+    FD_LOG_WARNING(( "mmap(NULL,%lu KiB,PROT_READ|PROT_WRITE,MAP_SHARED,fd_vm_jit,0) failed (%i-%s)", sz>>10, err, fd_io_strerror( err ) ));
+    goto done;
+  }
+
+  rx = mmap( NULL, sz, PROT_READ|PROT_EXEC, MAP_SHARED, fd, 0 );
+  if( FD_UNLIKELY( rx==MAP_FAILED ) ) {
+    err = errno;
+    FD_LOG_WARNING(( "mmap(NULL,%lu KiB,PROT_READ|PROT_EXEC,MAP_SHARED,fd_vm_jit,0) failed (%i-%s)", sz>>10, err, fd_io_strerror( err ) ));
+    if( FD_UNLIKELY( munmap( rw, sz ) ) ) FD_LOG_WARNING(( "munmap failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+    goto done;
+  }
+
+  *_rw = (uchar *)rw;
+  *_rx = (uchar *)rx;
+
+done:
+  /* The mappings keep the memory alive */
+  if( FD_UNLIKELY( close( fd ) ) ) FD_LOG_WARNING(( "close(fd_vm_jit) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  return err;
+}
+
+void
+fd_vm_jit_code_unmap( uchar * rw,
+                      uchar * rx,
+                      ulong   sz ) {
+  sz = fd_ulong_align_up( sz, FD_SHMEM_NORMAL_PAGE_SZ );
+  if( FD_UNLIKELY( rw && munmap( rw, sz ) ) ) FD_LOG_WARNING(( "munmap(%p,%lu KiB) failed (%i-%s)", (void *)rw, sz>>10, errno, fd_io_strerror( errno ) ));
+  if( FD_UNLIKELY( rx && munmap( rx, sz ) ) ) FD_LOG_WARNING(( "munmap(%p,%lu KiB) failed (%i-%s)", (void *)rx, sz>>10, errno, fd_io_strerror( errno ) ));
+}
+
+/* Execution **********************************************************/
+
+int
+fd_vm_exec_jit( fd_vm_t *           vm,
+                fd_vm_jit_t const * jit ) {
+
+  if( FD_UNLIKELY( (!vm) | (!jit) ) ) return FD_VM_ERR_INVAL;
+
+  if( FD_UNLIKELY( (jit->text_cnt    !=vm->text_cnt    ) |
+                   (jit->entry_pc    !=vm->entry_pc    ) |
+                   (jit->sbpf_version!=vm->sbpf_version) ) ) return FD_VM_ERR_SIGABORT;
+
+  /* Tracing and profiling need pc0 and ic_correction at every event,
+     which the generated code does not track. */
+
+  if( FD_UNLIKELY( vm->trace ) ) return fd_vm_exec_trace( vm );
+  if( FD_UNLIKELY( vm->prof  ) ) return fd_vm_exec_prof ( vm );
+
+  /* See SYSCALL in fd_vm_jit_emit_instr */
+
+  for( ulong w=0UL; w<FD_VM_JIT_STATIC_SYSCALL_MAX/64UL; w++ ) {
+    for( ulong m=jit->static_syscalls[ w ]; m; m=fd_ulong_pop_lsb( m ) ) {
+      ulong key = (ulong)FD_VM_SBPF_STATIC_SYSCALLS_LIST[ 64UL*w + (ulong)fd_ulong_find_lsb( m ) ];
+      if( FD_UNLIKELY( key==fd_sbpf_syscalls_key_null() ||
+                       !fd_sbpf_syscalls_query_const( vm->syscalls, key, NULL ) ) ) return fd_vm_exec_notrace( vm );
+    }
+  }
+
+  ulong pc = vm->pc;
+
+  fd_vm_jit_frame_t frame[1];
+  frame->meter = vm->cu + pc; /* pc0==pc, ic_correction==0 */
+  frame->k     = vm->ic + vm->cu;
+  frame->pc    = pc;
+
+  fd_vm_jit_entry_t entry = (fd_vm_jit_entry_t)(ulong)(jit->code + jit->entry_off);
+  int err = entry( vm, frame, fd_vm_jit_helper, pc );
+
+  /* Reconstruct ic and cu as per FD_VM_INTERP_FAULT.  For exits that
+     already billed the faulting instruction, meter>=pc+1 here and this
+     reduces to the current values. */
+
+  pc = frame->pc;
+  long  diff = (long)( frame->meter - (pc+1UL) );
+  vm->pc = pc;
+  vm->ic = frame->k - (ulong)diff;
+  if( FD_UNLIKELY( diff<0L ) ) { err = FD_VM_ERR_SIGCOST; vm->cu = 0UL; }
+  else                         {                          vm->cu = (ulong)diff; }
+  return err;
+}
+
+#endif /* FD_HAS_X86 && FD_HAS_HOSTED */
@@ -0,0 +1,165 @@
+#ifndef HEADER_fd_src_flamenco_vm_jit_fd_vm_jit_h
+#define HEADER_fd_src_flamenco_vm_jit_fd_vm_jit_h
+
+/* fd_vm_jit translates a validated sBPF program into x86-64 machine
+   code and runs it.  The translation is a simple template JIT: each
+   text word is translated in isolation into a short instruction
+   sequence with no register allocation across instructions (sBPF
+   registers live in vm->reg).  Memory accesses, calls, returns and
+   syscalls are delegated to helpers that share their implementation
+   with the interpreter so that faulting behavior is identical.
+
+   Compute unit metering uses the same linear segment model as the
+   interpreter (see fd_vm_interp_core.c and the Agave JIT analysis at
+   the bottom of it).  Concretely, the generated code keeps the
+   instruction meter in its IM' form (called "meter" below):
+
+     meter = cu + pc0 + ic_correction
+
+   A branch at pc is billable iff pc+1<=meter, a taken branch to target
+   adds target-(pc+1) to meter and an LDQ adds 1.  Further,
+   ic+cu-meter is invariant except at syscalls.  This lets the JIT
+   reconstruct ic and cu exactly at every exit from just meter and pc.
+
+   The generated code is position independent and does not reference
+   any host addresses (helpers are reached through a table passed at
+   entry).  As such, it can be copied to and run from any executable
+   memory region (e.g. a program cache shared between tiles).
+
+   The resulting vm state after fd_vm_exec_jit is the same as after
+   fd_vm_exec_notrace for every program accepted by fd_vm_validate. */
+
+#include "../fd_vm.h"
+
+#if FD_HAS_X86 && FD_HAS_HOSTED
+
+/* FD_VM_JIT_{HOT,COLD,FIXUP}_MAX bound the number of code bytes
+   emitted per text word into the hot path, the number of code bytes
+   emitted per text word into the out of line fault path and the
+   number of scratch bytes needed per text word while compiling.
+   FD_VM_JIT_HDR_MAX bounds the size of the shared prologue / epilogue
+   code. */
+
+#define FD_VM_JIT_HDR_MAX   (256UL)
+#define FD_VM_JIT_HOT_MAX   (128UL)
+#define FD_VM_JIT_COLD_MAX  (96UL)
+#define FD_VM_JIT_FIXUP_MAX (96UL)
+
+/* FD_VM_JIT_STATIC_SYSCALL_MAX bounds the number of SIMD-0178 static
+   syscall ids (a multiple of 64). */
+
+#define FD_VM_JIT_STATIC_SYSCALL_MAX (128UL)
+
+/* fd_vm_jit_t describes a compiled program.  It does not own the code
+   memory.  code points to the first byte of the compiled program,
+   which starts with a table of text_cnt code offsets (uint, indexed by
+   pc) followed by the entry trampoline at entry_off. */
+
+struct fd_vm_jit {
+  uchar const * code;         /* compiled code, read / exec in the caller's address space */
+  ulong         code_sz;      /* bytes of code used, in [0,code_max) */
+  ulong         entry_off;    /* offset of the entry trampoline */
+  ulong         text_cnt;     /* number of text words compiled */
+  ulong         entry_pc;     /* entry pc baked into the code (for "entrypoint" calls) */
+  ulong         sbpf_version; /* sbpf version the code was compiled for */
+  ulong         static_syscalls[ FD_VM_JIT_STATIC_SYSCALL_MAX/64UL ]; /* bit set of the static syscall ids used */
+};
+
+typedef struct fd_vm_jit fd_vm_jit_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_vm_jit_code_max returns an upper bound on the memory footprint
+   needed to compile a program with text_cnt text words.  This includes
+   scratch space used during compilation.  Returns 0 if text_cnt is too
+   large to be compiled. */
+
+FD_FN_CONST static inline ulong
+fd_vm_jit_code_max( ulong text_cnt ) {
+  if( FD_UNLIKELY( text_cnt>(1UL<<22) ) ) return 0UL; /* keep all code offsets representable by a rel32 */
+  return fd_ulong_align_up( 4UL*text_cnt, 64UL ) + FD_VM_JIT_HDR_MAX
+       + text_cnt*(FD_VM_JIT_HOT_MAX + FD_VM_JIT_COLD_MAX + FD_VM_JIT_FIXUP_MAX) + 512UL;
+}
+
+/* fd_vm_jit_compile compiles text (indexed [0,text_cnt)) for the given
+   sbpf_version into the memory region [code,code+code_max).  code
+   should be writable and 64-byte aligned; code_max should be at least
+   fd_vm_jit_code_max( text_cnt ).  entry_pc and calldests are the same
+   as those given to fd_vm_init (calldests can be NULL if there are no
+   valid call destinations).  text should have passed fd_vm_validate.
+
+   On success, returns FD_VM_SUCCESS and jit is populated.  The code
+   region is only used for [code,code+jit->code_sz) on return; the
+   remainder is clobbered scratch.  On failure, returns FD_VM_ERR_INVAL
+   (bad input args) or FD_VM_ERR_FULL (code_max too small) and jit is
+   untouched.  Does no allocation and retains no interest in any of
+   the inputs. */
+
+int
+fd_vm_jit_compile( fd_vm_jit_t *   jit,
+                   uchar *         code,
+                   ulong           code_max,
+                   ulong const *   text,
+                   ulong           text_cnt,
+                   ulong           entry_pc,
+                   ulong const *   calldests,
+                   ulong           sbpf_version );
+
+/* fd_vm_jit_code_{alloc,seal,free} manage anonymous memory suitable
+   for holding compiled code.  alloc returns a page aligned writable
+   region of at least sz bytes (NULL on failure, logs details).  seal
+   makes a region returned by alloc read-only and executable (returns 0
+   on success and an errno on failure, logs details).  free releases a
+   region returned by alloc. */
+
+uchar *
+fd_vm_jit_code_alloc( ulong sz );
+
+int
+fd_vm_jit_code_seal( uchar * code,
+                     ulong   sz );
+
+void
+fd_vm_jit_code_free( uchar * code,
+                     ulong   sz );
+
+/* fd_vm_jit_code_{map,unmap} manage a region of sz bytes mapped twice
+   into the caller's address space: read / write at *_rw and read /
+   exec at *_rx (the same offset addresses the same byte in both).
+   Code compiled into the rw view can be run from the rx view without
+   further system calls (the generated code is position independent),
+   which allows compiling after a tile has been sandboxed.  map returns
+   0 on success and an errno on failure (logs details, *_rw and *_rx
+   are untouched).  unmap releases both views. */
+
+int
+fd_vm_jit_code_map( ulong    sz,
+                    uchar ** _rw,
+                    uchar ** _rx );
+
+void
+fd_vm_jit_code_unmap( uchar * rw,
+                      uchar * rx,
+                      ulong   sz );
+
+/* fd_vm_exec_jit is fd_vm_exec for a vm whose program was
+   compiled into jit.  jit->code must be executable.  Returns
+   FD_VM_ERR_INVAL if vm or jit are NULL and FD_VM_ERR_SIGABORT if jit
+   was not compiled for the program in vm.  Otherwise, the return value
+   and vm state on return are the same as fd_vm_exec.
+
+   The interpreter is run instead of the compiled code if vm has a
+   trace or a profile attached (these need the pc at every branch) or
+   if a static syscall used by the program is not registered in
+   vm->syscalls (the interpreter's fault billing differs there).  As
+   such, fd_vm_exec_jit can always be used in place of fd_vm_exec. */
+
+int
+fd_vm_exec_jit( fd_vm_t *           vm,
+                fd_vm_jit_t const * jit );
+
+FD_PROTOTYPES_END
+
+#endif /* FD_HAS_X86 && FD_HAS_HOSTED */
+
+#endif /* HEADER_fd_src_flamenco_vm_jit_fd_vm_jit_h */
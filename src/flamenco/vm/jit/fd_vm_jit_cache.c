@@ -0,0 +1,251 @@
+#include "fd_vm_jit_cache.h"
+
+#if FD_HAS_X86 && FD_HAS_HOSTED
+
+#define FD_VM_JIT_CACHE_MAGIC (0xf17eda2ce7c0dec0UL) /* firedancer vm jit cache version 0 */
+
+/* An entry with a NULL jit.code records a program that failed to
+   compile.  The entry table is open addressed with linear probing and
+   twice as many slots as entries.  Entries are only ever removed by a
+   flush, which clears the whole table. */
+
+struct fd_vm_jit_cache_entry {
+  fd_vm_jit_cache_key_t key;
+  ulong                 used;
+  fd_vm_jit_t           jit;
+};
+
+typedef struct fd_vm_jit_cache_entry fd_vm_jit_cache_entry_t;
+
+struct __attribute__((aligned(FD_VM_JIT_CACHE_ALIGN))) fd_vm_jit_cache_private {
+  ulong   magic;
+  ulong   entry_max;
+  ulong   slot_cnt;
+  ulong   entry_cnt;
+  ulong   active_cnt;  /* number of acquired entries */
+  uchar * code_rw;
+  uchar * code_rx;
+  ulong   code_sz;
+  ulong   code_off;    /* bump allocator, multiple of 64 */
+
+  fd_vm_jit_cache_metrics_t metrics[1];
+
+  /* slot_cnt fd_vm_jit_cache_entry_t follow */
+};
+
+static inline fd_vm_jit_cache_entry_t *
+fd_vm_jit_cache_private_slot( fd_vm_jit_cache_t * cache ) {
+  return (fd_vm_jit_cache_entry_t *)(cache+1);
+}
+
+FD_FN_CONST ulong
+fd_vm_jit_cache_align( void ) {
+  return FD_VM_JIT_CACHE_ALIGN;
+}
+
+FD_FN_CONST ulong
+fd_vm_jit_cache_footprint( ulong entry_max ) {
+  if( FD_UNLIKELY( !fd_ulong_is_pow2( entry_max ) || entry_max>(1UL<<20) ) ) return 0UL;
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, FD_VM_JIT_CACHE_ALIGN,             sizeof(fd_vm_jit_cache_t)                   );
+  l = FD_LAYOUT_APPEND( l, alignof(fd_vm_jit_cache_entry_t), 2UL*entry_max*sizeof(fd_vm_jit_cache_entry_t) );
+  return FD_LAYOUT_FINI( l, FD_VM_JIT_CACHE_ALIGN );
+}
+
+static void
+fd_vm_jit_cache_private_flush( fd_vm_jit_cache_t * cache ) {
+  fd_memset( fd_vm_jit_cache_private_slot( cache ), 0, cache->slot_cnt*sizeof(fd_vm_jit_cache_entry_t) );
+  cache->entry_cnt  = 0UL;
+  cache->code_off   = 0UL;
+  cache->metrics->flush_cnt++;
+  cache->metrics->code_sz = 0UL;
+}
+
+void *
+fd_vm_jit_cache_new( void *  shmem,
+                     ulong   entry_max,
+                     uchar * code_rw,
+                     uchar * code_rx,
+                     ulong   code_sz ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_vm_jit_cache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_vm_jit_cache_footprint( entry_max );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad entry_max (%lu)", entry_max ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( (!code_rw) | (!code_rx) |
+                   !fd_ulong_is_aligned( (ulong)code_rw, 64UL ) |
+                   !fd_ulong_is_aligned( (ulong)code_rx, 64UL ) ) ) {
+    FD_LOG_WARNING(( "NULL or misaligned code arena" ));
+    return NULL;
+  }
+
+  fd_memset( shmem, 0, footprint );
+
+  fd_vm_jit_cache_t * cache = (fd_vm_jit_cache_t *)shmem;
+  cache->entry_max = entry_max;
+  cache->slot_cnt  = 2UL*entry_max;
+  cache->code_rw   = code_rw;
+  cache->code_rx   = code_rx;
+  cache->code_sz   = fd_ulong_align_dn( code_sz, 64UL );
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = FD_VM_JIT_CACHE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_vm_jit_cache_t *
+fd_vm_jit_cache_join( void * shcache ) {
+  fd_vm_jit_cache_t * cache = (fd_vm_jit_cache_t *)shcache;
+
+  if( FD_UNLIKELY( !cache ) ) {
+    FD_LOG_WARNING(( "NULL shcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)cache, fd_vm_jit_cache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( cache->magic!=FD_VM_JIT_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return cache;
+}
+
+void *
+fd_vm_jit_cache_leave( fd_vm_jit_cache_t * cache ) {
+
+  if( FD_UNLIKELY( !cache ) ) {
+    FD_LOG_WARNING(( "NULL cache" ));
+    return NULL;
+  }
+
+  return (void *)cache;
+}
+
+void *
+fd_vm_jit_cache_delete( void * shcache ) {
+  fd_vm_jit_cache_t * cache = (fd_vm_jit_cache_t *)shcache;
+
+  if( FD_UNLIKELY( !cache ) ) {
+    FD_LOG_WARNING(( "NULL shcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( cache->magic!=FD_VM_JIT_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shcache;
+}
+
+/* fd_vm_jit_cache_private_find returns the entry for key or the empty
+   slot where it should be inserted. */
+
+static fd_vm_jit_cache_entry_t *
+fd_vm_jit_cache_private_find( fd_vm_jit_cache_t *           cache,
+                              fd_vm_jit_cache_key_t const * key ) {
+  fd_vm_jit_cache_entry_t * slot = fd_vm_jit_cache_private_slot( cache );
+  ulong                     mask = cache->slot_cnt - 1UL;
+  ulong                     idx  = ( FD_LOAD( ulong, key->hash ) ^ fd_ulong_hash( key->tag ) ) & mask;
+  for(;;) {
+    fd_vm_jit_cache_entry_t * e = slot + idx;
+    if( !e->used || !memcmp( &e->key, key, sizeof(fd_vm_jit_cache_key_t) ) ) return e;
+    idx = (idx+1UL) & mask;
+  }
+}
+
+fd_vm_jit_t const *
+fd_vm_jit_cache_acquire( fd_vm_jit_cache_t *           cache,
+                         fd_vm_jit_cache_key_t const * key,
+                         ulong const *                 text,
+                         ulong                         text_cnt,
+                         ulong                         entry_pc,
+                         ulong const *                 calldests,
+                         ulong                         sbpf_version ) {
+
+  fd_vm_jit_cache_entry_t * e = fd_vm_jit_cache_private_find( cache, key );
+  if( FD_LIKELY( e->used ) ) {
+    if( FD_UNLIKELY( !e->jit.code ) ) return NULL; /* failed to compile before */
+    cache->active_cnt++;
+    cache->metrics->hit_cnt++;
+    return &e->jit;
+  }
+
+  /* Make room for the entry and the compile footprint (programs that
+     can never fit are remembered as failed). */
+
+  ulong code_max = fd_vm_jit_code_max( text_cnt );
+  int   fits     = code_max && code_max<=cache->code_sz;
+  if( FD_UNLIKELY( ( cache->entry_cnt>=cache->entry_max ) |
+                   ( fits && code_max>cache->code_sz-cache->code_off ) ) ) {
+    if( FD_UNLIKELY( cache->active_cnt ) ) {
+      cache->metrics->busy_cnt++;
+      return NULL;
+    }
+    fd_vm_jit_cache_private_flush( cache );
+    e = fd_vm_jit_cache_private_find( cache, key );
+  }
+
+  cache->metrics->miss_cnt++;
+
+  e->used = 1UL;
+  e->key  = *key;
+  cache->entry_cnt++;
+
+  /* Compile into the rw view and run from the rx view.  x86 keeps
+     instruction fetch coherent with stores to aliased physical memory
+     and the call into the code serializes sufficiently for a single
+     thread. */
+
+  uchar * code = cache->code_rw + cache->code_off;
+  if( FD_UNLIKELY( !fits || fd_vm_jit_compile( &e->jit, code, code_max, text, text_cnt, entry_pc, calldests, sbpf_version ) ) ) {
+    e->jit.code = NULL;
+    cache->metrics->fail_cnt++;
+    return NULL;
+  }
+
+  e->jit.code     = cache->code_rx + cache->code_off;
+  cache->code_off = fd_ulong_align_up( cache->code_off + e->jit.code_sz, 64UL );
+  cache->metrics->code_sz = cache->code_off;
+
+  cache->active_cnt++;
+  return &e->jit;
+}
+
+void
+fd_vm_jit_cache_release( fd_vm_jit_cache_t * cache,
+                         fd_vm_jit_t const * jit ) {
+  if( FD_UNLIKELY( !jit ) ) return;
+  if( FD_UNLIKELY( !cache->active_cnt ) ) FD_LOG_CRIT(( "release without acquire" ));
+  cache->active_cnt--;
+}
+
+fd_vm_jit_cache_metrics_t const *
+fd_vm_jit_cache_metrics( fd_vm_jit_cache_t const * cache ) {
+  return cache->metrics;
+}
+
+#endif /* FD_HAS_X86 && FD_HAS_HOSTED */
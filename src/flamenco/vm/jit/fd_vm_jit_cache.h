@@ -0,0 +1,121 @@
+#ifndef HEADER_fd_src_flamenco_vm_jit_fd_vm_jit_cache_h
+#define HEADER_fd_src_flamenco_vm_jit_fd_vm_jit_cache_h
+
+/* fd_vm_jit_cache is a local cache of sBPF programs compiled by
+   fd_vm_jit.  Programs are identified by a caller provided content
+   address (e.g. the fd_progcache key of the validated program) and
+   compiled on first use into a code arena mapped with
+   fd_vm_jit_code_map, so that compiling needs no system calls and can
+   happen inside a sandboxed tile.
+
+   The arena is a bump allocator.  When it (or the entry table) is
+   full, the whole cache is flushed.  Compiled code may be running
+   while another program is acquired (CPI), so a flush is only done
+   when no entry is acquired; otherwise acquire fails and the caller
+   should fall back to the interpreter.
+
+   A cache is not thread safe and holds local pointers (it is meant to
+   live in a tile's scratch memory). */
+
+#include "fd_vm_jit.h"
+
+#if FD_HAS_X86 && FD_HAS_HOSTED
+
+#define FD_VM_JIT_CACHE_ALIGN (128UL)
+
+/* fd_vm_jit_cache_key_t is the content address of a program.  Keys
+   are assumed to be collision resistant (the cache does not compare
+   the program text). */
+
+struct fd_vm_jit_cache_key {
+  uchar hash[ 32 ];
+  ulong tag;
+};
+
+typedef struct fd_vm_jit_cache_key fd_vm_jit_cache_key_t;
+
+/* fd_vm_jit_cache_metrics_t are cumulative event counters since the
+   cache was created.  hit / miss count acquires (a miss compiles),
+   fail counts programs that could not be compiled (too large for the
+   arena, these are remembered until the next flush) and busy counts
+   acquires that could not flush because code was running. */
+
+struct fd_vm_jit_cache_metrics {
+  ulong hit_cnt;
+  ulong miss_cnt;
+  ulong fail_cnt;
+  ulong busy_cnt;
+  ulong flush_cnt;
+  ulong code_sz;   /* arena bytes currently used */
+};
+
+typedef struct fd_vm_jit_cache_metrics fd_vm_jit_cache_metrics_t;
+
+struct fd_vm_jit_cache_private;
+typedef struct fd_vm_jit_cache_private fd_vm_jit_cache_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_vm_jit_cache_{align,footprint} return the required alignment and
+   footprint of the memory region for a cache that holds up to
+   entry_max programs.  footprint returns 0 if entry_max is not a power
+   of two in [1,2^20]. */
+
+FD_FN_CONST ulong
+fd_vm_jit_cache_align( void );
+
+FD_FN_CONST ulong
+fd_vm_jit_cache_footprint( ulong entry_max );
+
+/* fd_vm_jit_cache_new formats shmem as a cache of entry_max programs
+   compiled into the arena [code_rw,code_rw+code_sz) (executed from
+   [code_rx,code_rx+code_sz), see fd_vm_jit_code_map).  Returns shmem
+   on success and NULL on failure (logs details).  The cache retains an
+   interest in the arena until deleted. */
+
+void *
+fd_vm_jit_cache_new( void *  shmem,
+                     ulong   entry_max,
+                     uchar * code_rw,
+                     uchar * code_rx,
+                     ulong   code_sz );
+
+fd_vm_jit_cache_t *
+fd_vm_jit_cache_join( void * shcache );
+
+void *
+fd_vm_jit_cache_leave( fd_vm_jit_cache_t * cache );
+
+void *
+fd_vm_jit_cache_delete( void * shcache );
+
+/* fd_vm_jit_cache_acquire returns the compiled program for key,
+   compiling text (see fd_vm_jit_compile for the other arguments) if it
+   is not cached.  Returns NULL if the program cannot be compiled or if
+   the cache would need to be flushed while another entry is acquired.
+   Every non-NULL return must be paired with a release once the code
+   has finished running.  The returned jit is valid until then. */
+
+fd_vm_jit_t const *
+fd_vm_jit_cache_acquire( fd_vm_jit_cache_t *           cache,
+                         fd_vm_jit_cache_key_t const * key,
+                         ulong const *                 text,
+                         ulong                         text_cnt,
+                         ulong                         entry_pc,
+                         ulong const *                 calldests,
+                         ulong                         sbpf_version );
+
+void
+fd_vm_jit_cache_release( fd_vm_jit_cache_t *  cache,
+                         fd_vm_jit_t const *  jit );
+
+/* fd_vm_jit_cache_metrics returns the cache's event counters. */
+
+fd_vm_jit_cache_metrics_t const *
+fd_vm_jit_cache_metrics( fd_vm_jit_cache_t const * cache );
+
+FD_PROTOTYPES_END
+
+#endif /* FD_HAS_X86 && FD_HAS_HOSTED */
+
+#endif /* HEADER_fd_src_flamenco_vm_jit_fd_vm_jit_cache_h */
@@ -0,0 +1,418 @@
+#include "fd_vm_jit.h"
+#include "../fd_vm_private.h"
+#include "../test_vm_util.h"
+#include <stdlib.h> /* aligned_alloc */
+
+/* test_vm_jit runs randomly generated programs that pass validation
+   through both the interpreter and the JIT and checks that the
+   resulting vm state is identical.  Some runs execute with only one of
+   the two static syscalls registered (as happens when a cached program
+   outlives a syscall deactivation) to cover the interpreter fallback. */
+
+#define TEXT_MAX (512UL)
+
+static int
+accumulator_syscall( FD_PARAM_UNUSED void *  _vm,
+                     /**/            ulong   arg0,
+                     /**/            ulong   arg1,
+                     /**/            ulong   arg2,
+                     /**/            ulong   arg3,
+                     /**/            ulong   arg4,
+                     /**/            ulong * ret ) {
+  *ret = arg0 + arg1 + arg2 + arg3 + arg4;
+  return 0;
+}
+
+/* burn_syscall consumes arg0 % 64 compute units and fails with
+   COMPUTE_BUDGET_EXCEEDED if there are not enough left */
+
+static int
+burn_syscall( void *  _vm,
+              ulong   arg0,
+              FD_PARAM_UNUSED ulong arg1,
+              FD_PARAM_UNUSED ulong arg2,
+              FD_PARAM_UNUSED ulong arg3,
+              FD_PARAM_UNUSED ulong arg4,
+              ulong * ret ) {
+  fd_vm_t * vm   = (fd_vm_t *)_vm;
+  ulong     cost = arg0 % 64UL;
+  *ret = cost;
+  if( FD_UNLIKELY( cost>vm->cu ) ) { vm->cu = 0UL; return FD_VM_SYSCALL_ERR_COMPUTE_BUDGET_EXCEEDED; }
+  vm->cu -= cost;
+  return 0;
+}
+
+static uint
+rand_imm( fd_rng_t * rng ) {
+  static uint const special[] = { 0U, 1U, 2U, 7U, 16U, 31U, 32U, 63U, 64U, UINT_MAX, 0x80000000U, 0x7fffffffU };
+  uint r = fd_rng_uint_roll( rng, 4U );
+  if( r==0U ) return special[ fd_rng_uint_roll( rng, (uint)(sizeof(special)/sizeof(uint)) ) ];
+  if( r==1U ) return fd_rng_uint_roll( rng, 64U );
+  if( r==2U ) return (uint)-(int)fd_rng_uint_roll( rng, 64U );
+  return fd_rng_uint( rng );
+}
+
+static ulong
+exit_instr( ulong v ) {
+  return fd_vm_instr( FD_VM_SBPF_STATIC_SYSCALLS( v ) ? 0x9dUL : 0x95UL, 0UL, 0UL, 0, 0U );
+}
+
+/* instr_ok returns 1 if instr passes validation as a standalone
+   instruction (jumps should have offset 0) */
+
+static int
+instr_ok( fd_vm_t * vm,
+          ulong     instr ) {
+  ulong const * text     = vm->text;
+  ulong         text_cnt = vm->text_cnt;
+  ulong         text_sz  = vm->text_sz;
+  uchar const * rodata   = vm->rodata;
+  ulong         rodata_sz = vm->rodata_sz;
+
+  ulong tmp[2] = { instr, exit_instr( vm->sbpf_version ) };
+  vm->text = tmp; vm->text_cnt = 2UL; vm->text_sz = 16UL; vm->rodata = (uchar const *)tmp; vm->rodata_sz = 16UL;
+  int ok = !fd_vm_validate( vm );
+  vm->text = text; vm->text_cnt = text_cnt; vm->text_sz = text_sz; vm->rodata = rodata; vm->rodata_sz = rodata_sz;
+  return ok;
+}
+
+static void
+gen_program( fd_rng_t *            rng,
+             fd_vm_t *             vm,
+             ulong *               text,
+             ulong                 text_cnt,
+             fd_sbpf_calldests_t * calldests ) {
+  ulong v = vm->sbpf_version;
+
+  static uchar const ld_v0[4] = { 0x71, 0x69, 0x61, 0x79 }; static uchar const ld_v2[4] = { 0x2c, 0x3c, 0x8c, 0x9c };
+  static uchar const st_v0[4] = { 0x72, 0x6a, 0x62, 0x7a }; static uchar const st_v2[4] = { 0x27, 0x37, 0x87, 0x97 };
+  static uchar const sx_v0[4] = { 0x73, 0x6b, 0x63, 0x7b }; static uchar const sx_v2[4] = { 0x2f, 0x3f, 0x8f, 0x9f };
+  int mv = FD_VM_SBPF_MOVE_MEMORY_IX_CLASSES( v );
+
+  fd_sbpf_calldests_null( calldests );
+  fd_sbpf_calldests_insert( calldests, 0UL );
+  for( ulong i=0UL; i<text_cnt/8UL; i++ ) fd_sbpf_calldests_insert( calldests, fd_rng_ulong_roll( rng, text_cnt ) );
+
+  for( ulong pc=0UL; pc<text_cnt; pc++ ) {
+    ulong dst    = fd_rng_ulong_roll( rng, 10UL );
+    ulong src    = fd_rng_ulong_roll( rng, 11UL );
+    ulong target = fd_rng_ulong_roll( rng, text_cnt );
+    short off    = (short)((long)target - (long)pc - 1L);
+    uint  r      = fd_rng_uint_roll( rng, 100U );
+    ulong instr;
+
+    if( r<6U && pc+2UL<text_cnt && FD_VM_SBPF_ENABLE_LDDW( v ) ) { /* LDQ */
+      text[ pc   ] = fd_vm_instr( 0x18UL, dst, 0UL, 0, rand_imm( rng ) );
+      text[ pc+1 ] = fd_vm_instr( 0x00UL, 0UL, 0UL, 0, rand_imm( rng ) );
+      pc++;
+      continue;
+    }
+
+    if( r<10U ) { /* call (or syscall) */
+      ulong key = FD_VM_SBPF_STATIC_SYSCALLS_LIST[ 1UL + fd_rng_ulong_roll( rng, 2UL ) ];
+      if( FD_VM_SBPF_STATIC_SYSCALLS( v ) ) {
+        if( fd_rng_uint_roll( rng, 2U ) ) instr = fd_vm_instr( 0x95UL, 0UL, 0UL, 0, 1U + fd_rng_uint_roll( rng, 2U ) );
+        else { fd_sbpf_calldests_insert( calldests, target ); instr = fd_vm_instr( 0x85UL, 0UL, 0UL, 0, (uint)(int)off ); }
+      } else {
+        if( fd_rng_uint_roll( rng, 2U ) ) instr = fd_vm_instr( 0x85UL, 0UL, 0UL, 0, (uint)key );
+        else { fd_sbpf_calldests_insert( calldests, target ); instr = fd_vm_instr( 0x85UL, 0UL, 0UL, 0, fd_pchash( (uint)target ) ); }
+      }
+      text[ pc ] = instr;
+      continue;
+    }
+
+    if( r<13U ) { /* callx (mostly through r9, see run) */
+      ulong reg = fd_rng_uint_roll( rng, 4U ) ? 9UL : fd_rng_ulong_roll( rng, 10UL );
+      if( FD_VM_SBPF_CALLX_USES_SRC_REG( v ) ) text[ pc ] = fd_vm_instr( 0x8dUL, 0UL, reg, 0, 0U );
+      else                                     text[ pc ] = fd_vm_instr( 0x8dUL, 0UL, 0UL, 0, (uint)reg );
+      continue;
+    }
+
+    if( r<17U ) { text[ pc ] = exit_instr( v ); continue; }
+
+    if( r<35U ) { /* stack load / store */
+      ulong k    = fd_rng_ulong_roll( rng, 4UL );
+      short moff = fd_rng_uint_roll( rng, 8U ) ? (short)-(int)(8U + 8U*fd_rng_uint_roll( rng, 64U ))
+                                               : (short)-(int)(1U + fd_rng_uint_roll( rng, 8192U ));
+      ulong base = fd_rng_uint_roll( rng, 16U ) ? 10UL : fd_rng_ulong_roll( rng, 10UL );
+      switch( fd_rng_uint_roll( rng, 3U ) ) {
+      case 0U: instr = fd_vm_instr( mv ? ld_v2[k] : ld_v0[k], dst,  base, moff, 0U );              break;
+      case 1U: instr = fd_vm_instr( mv ? st_v2[k] : st_v0[k], base, 0UL,  moff, rand_imm( rng ) ); break;
+      default: instr = fd_vm_instr( mv ? sx_v2[k] : sx_v0[k], base, src,  moff, 0U );              break;
+      }
+      text[ pc ] = instr;
+      continue;
+    }
+
+    if( r<50U ) { /* conditional / unconditional jump */
+      ulong op = fd_rng_uint_roll( rng, 8U ) ? ((1UL+fd_rng_ulong_roll( rng, 13UL ))<<4) | (fd_rng_uint_roll( rng, 2U ) ? 0x5UL : 0xdUL) : 0x05UL;
+      instr = fd_vm_instr( op, dst, src, off, rand_imm( rng ) );
+      if( !instr_ok( vm, fd_vm_instr( op, dst, src, 0, 0U ) ) ) instr = fd_vm_instr( 0x05UL, 0UL, 0UL, off, 0U );
+      text[ pc ] = instr;
+      continue;
+    }
+
+    /* ALU op (including the opcodes that got repurposed across
+       versions but not the memory ops they got repurposed to) */
+
+    instr = fd_vm_instr( 0xb7UL, dst, 0UL, 0, rand_imm( rng ) );
+    for( ulong attempt=0UL; attempt<64UL; attempt++ ) {
+      ulong op = fd_rng_ulong_roll( rng, 256UL );
+      if( ((op & 7UL)<4UL) | ((op & 7UL)==5UL) ) continue;
+      if( mv && ( (op & 0xfUL)==0x7UL || (op & 0xfUL)==0xcUL || (op & 0xfUL)==0xfUL ) &&
+          ( ((op>>4)==0x2UL) | ((op>>4)==0x3UL) | ((op>>4)==0x8UL) | ((op>>4)==0x9UL) ) ) continue;
+      ulong cand = fd_vm_instr( op, dst, fd_rng_ulong_roll( rng, 10UL ), (short)fd_rng_uint( rng ), rand_imm( rng ) );
+      if( instr_ok( vm, cand ) ) { instr = cand; break; }
+    }
+    text[ pc ] = instr;
+  }
+}
+
+/* run_state captures the vm state compared between runs */
+
+struct run_state {
+  int   err;
+  ulong reg[ FD_VM_REG_CNT ];
+  ulong pc;
+  ulong ic;
+  ulong cu;
+  ulong frame_cnt;
+  ulong segv_store_vaddr;
+  fd_vm_shadow_t shadow[ FD_VM_STACK_FRAME_MAX ];
+};
+
+typedef struct run_state run_state_t;
+
+static uchar stack0[ FD_VM_STACK_MAX ];
+static uchar stack1[ FD_VM_STACK_MAX ];
+
+static fd_vm_t *
+run_init( fd_vm_t *             vm,
+          fd_exec_instr_ctx_t * instr_ctx,
+          ulong const *         text,
+          ulong                 text_cnt,
+          ulong                 entry_cu,
+          fd_sbpf_calldests_t * calldests,
+          ulong                 sbpf_version,
+          fd_sbpf_syscalls_t *  syscalls,
+          fd_sha256_t *         sha,
+          ulong const *         reg0 ) {
+  FD_TEST( fd_vm_init( vm, instr_ctx, FD_VM_HEAP_DEFAULT, entry_cu, (uchar const *)text, 8UL*text_cnt, text, text_cnt,
+                       0UL, 8UL*text_cnt, 0UL, calldests, sbpf_version, syscalls, NULL, sha, NULL, 0U, NULL, 0, 0 ) );
+  for( ulong i=0UL; i<10UL; i++ ) vm->reg[ i ] = reg0[ i ];
+  fd_memcpy( vm->stack, stack0, FD_VM_STACK_MAX );
+  return vm;
+}
+
+static void
+run_save( run_state_t *   s,
+          fd_vm_t const * vm,
+          int             err ) {
+  memset( s, 0, sizeof(run_state_t) );
+  s->err              = err;
+  s->pc               = vm->pc;
+  s->ic               = vm->ic;
+  s->cu               = vm->cu;
+  s->frame_cnt        = vm->frame_cnt;
+  s->segv_store_vaddr = vm->segv_store_vaddr;
+  for( ulong i=0UL; i<FD_VM_REG_CNT; i++ ) s->reg[ i ] = vm->reg[ i ];
+  for( ulong i=0UL; i<fd_ulong_min( vm->frame_cnt, FD_VM_STACK_FRAME_MAX ); i++ ) s->shadow[ i ] = vm->shadow[ i ];
+}
+
+static void
+run_check( run_state_t const * a,
+           run_state_t const * b,
+           ulong const *       text,
+           ulong               text_cnt,
+           ulong               v ) {
+  if( FD_LIKELY( !memcmp( a, b, sizeof(run_state_t) ) && !memcmp( stack0, stack1, FD_VM_STACK_MAX ) ) ) return;
+  for( ulong pc=0UL; pc<text_cnt; pc++ ) FD_LOG_NOTICE(( "%4lu: %016lx", pc, text[ pc ] ));
+  FD_LOG_WARNING(( "sbpf_version %lu", v ));
+  FD_LOG_WARNING(( "interp: err %i pc %lu ic %lu cu %lu frame_cnt %lu", a->err, a->pc, a->ic, a->cu, a->frame_cnt ));
+  FD_LOG_WARNING(( "jit:    err %i pc %lu ic %lu cu %lu frame_cnt %lu", b->err, b->pc, b->ic, b->cu, b->frame_cnt ));
+  for( ulong i=0UL; i<FD_VM_REG_CNT; i++ )
+    if( a->reg[ i ]!=b->reg[ i ] ) FD_LOG_WARNING(( "r%lu: interp %016lx jit %016lx", i, a->reg[ i ], b->reg[ i ] ));
+  FD_LOG_ERR(( "FAIL: interp / jit mismatch" ));
+}
+
+static void
+test_diff( fd_rng_t *            rng,
+           fd_exec_instr_ctx_t * instr_ctx,
+           fd_sbpf_syscalls_t *  syscalls,
+           fd_sbpf_syscalls_t *  partial,
+           fd_sbpf_calldests_t * calldests,
+           ulong *               text,
+           ulong                 iter_cnt ) {
+  fd_sha256_t _sha[1]; fd_sha256_t * sha = fd_sha256_join( fd_sha256_new( _sha ) );
+  fd_vm_t     _vm[1];  fd_vm_t *     vm  = fd_vm_join( fd_vm_new( _vm ) ); FD_TEST( vm );
+
+  static run_state_t s0[1];
+  static run_state_t s1[1];
+
+  ulong run_cnt = 0UL;
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    ulong v        = fd_rng_ulong_roll( rng, FD_SBPF_V3+1UL );
+    ulong text_cnt = 2UL + fd_rng_ulong_roll( rng, TEXT_MAX-1UL );
+
+    /* Generate a program that passes validation */
+
+    for( ulong i=0UL; i<text_cnt; i++ ) text[ i ] = exit_instr( v );
+    ulong zero[10] = {0};
+    run_init( vm, instr_ctx, text, text_cnt, 0UL, calldests, v, syscalls, sha, zero );
+    gen_program( rng, vm, text, text_cnt, calldests );
+    if( fd_vm_validate( vm ) ) continue;
+
+    ulong code_max = fd_vm_jit_code_max( text_cnt );
+    uchar * code   = fd_vm_jit_code_alloc( code_max ); FD_TEST( code );
+    fd_vm_jit_t jit[1];
+    FD_TEST( !fd_vm_jit_compile( jit, code, code_max, text, text_cnt, 0UL, calldests, v ) );
+    FD_TEST( jit->code_sz<=code_max );
+    FD_TEST( !fd_vm_jit_code_seal( code, code_max ) );
+
+    for( ulong rep=0UL; rep<4UL; rep++ ) {
+      ulong reg0[10];
+      for( ulong i=0UL; i<9UL; i++ ) reg0[ i ] = fd_rng_uint_roll( rng, 4U ) ? (ulong)(long)(int)rand_imm( rng ) : fd_rng_ulong( rng );
+      reg0[ 9 ] = (1UL<<32) + 8UL*fd_rng_ulong_roll( rng, text_cnt+1UL );
+      for( ulong i=0UL; i<FD_VM_STACK_MAX; i+=8UL ) FD_STORE( ulong, stack0+i, fd_rng_ulong( rng ) );
+      ulong entry_cu = fd_rng_ulong_roll( rng, fd_rng_uint_roll( rng, 4U ) ? 200UL : 5000UL );
+      fd_sbpf_syscalls_t * run_syscalls = rep==3UL ? partial : syscalls;
+
+      run_init( vm, instr_ctx, text, text_cnt, entry_cu, calldests, v, run_syscalls, sha, reg0 );
+      run_save( s0, vm, fd_vm_exec_notrace( vm ) );
+      fd_memcpy( stack1, vm->stack, FD_VM_STACK_MAX );
+
+      run_init( vm, instr_ctx, text, text_cnt, entry_cu, calldests, v, run_syscalls, sha, reg0 );
+      run_save( s1, vm, fd_vm_exec_jit( vm, jit ) );
+      fd_memcpy( stack0, vm->stack, FD_VM_STACK_MAX );
+
+      run_check( s0, s1, text, text_cnt, v );
+      run_cnt++;
+    }
+
+    fd_vm_jit_code_free( code, code_max );
+  }
+
+  FD_LOG_NOTICE(( "%lu differential runs", run_cnt ));
+  FD_TEST( run_cnt );
+
+  fd_vm_delete( fd_vm_leave( vm ) );
+  fd_sha256_delete( fd_sha256_leave( sha ) );
+}
+
+static void
+test_api( fd_exec_instr_ctx_t * instr_ctx,
+          fd_sbpf_syscalls_t *  syscalls ) {
+  fd_sha256_t _sha[1]; fd_sha256_t * sha = fd_sha256_join( fd_sha256_new( _sha ) );
+  fd_vm_t     _vm[1];  fd_vm_t *     vm  = fd_vm_join( fd_vm_new( _vm ) ); FD_TEST( vm );
+
+  ulong text[3] = {
+    fd_vm_instr( 0xb7UL, 0UL, 0UL, 0, 42U ), /* mov64 r0, 42 */
+    fd_vm_instr( 0x07UL, 0UL, 0UL, 0,  1U ), /* add64 r0, 1 */
+    fd_vm_instr( 0x95UL, 0UL, 0UL, 0,  0U )  /* exit */
+  };
+
+  ulong   code_max = fd_vm_jit_code_max( 3UL );
+  uchar * code     = fd_vm_jit_code_alloc( code_max ); FD_TEST( code );
+
+  fd_vm_jit_t jit[1];
+  FD_TEST( fd_vm_jit_compile( NULL, code,     code_max,     text, 3UL, 0UL, NULL, FD_SBPF_V0 )==FD_VM_ERR_INVAL );
+  FD_TEST( fd_vm_jit_compile( jit,  NULL,     code_max,     text, 3UL, 0UL, NULL, FD_SBPF_V0 )==FD_VM_ERR_INVAL );
+  FD_TEST( fd_vm_jit_compile( jit,  code+1UL, code_max-1UL, text, 3UL, 0UL, NULL, FD_SBPF_V0 )==FD_VM_ERR_INVAL );
+  FD_TEST( fd_vm_jit_compile( jit,  code,     code_max,     NULL, 3UL, 0UL, NULL, FD_SBPF_V0 )==FD_VM_ERR_INVAL );
+  FD_TEST( fd_vm_jit_compile( jit,  code,     code_max-1UL, text, 3UL, 0UL, NULL, FD_SBPF_V0 )==FD_VM_ERR_FULL  );
+  FD_TEST( !fd_vm_jit_code_max( (1UL<<22)+1UL ) );
+
+  FD_TEST( !fd_vm_jit_compile( jit, code, code_max, text, 3UL, 0UL, NULL, FD_SBPF_V0 ) );
+  FD_TEST( !fd_vm_jit_code_seal( code, code_max ) );
+
+  FD_TEST( fd_vm_init( vm, instr_ctx, FD_VM_HEAP_DEFAULT, 100UL, (uchar const *)text, 24UL, text, 3UL,
+                       0UL, 24UL, 0UL, NULL, FD_SBPF_V0, syscalls, NULL, sha, NULL, 0U, NULL, 0, 0 ) );
+
+  FD_TEST( fd_vm_exec_jit( NULL, jit  )==FD_VM_ERR_INVAL );
+  FD_TEST( fd_vm_exec_jit( vm,   NULL )==FD_VM_ERR_INVAL );
+
+  fd_vm_jit_t bad[1] = { *jit }; bad->sbpf_version = FD_SBPF_V1;
+  FD_TEST( fd_vm_exec_jit( vm, bad )==FD_VM_ERR_SIGABORT );
+
+  FD_TEST( fd_vm_exec_jit( vm, jit )==FD_VM_SUCCESS );
+  FD_TEST( vm->reg[0]==43UL );
+  FD_TEST( vm->pc    ==2UL  );
+  FD_TEST( vm->ic    ==3UL  );
+  FD_TEST( vm->cu    ==97UL );
+
+  /* A traced run goes through the interpreter and produces the same
+     trace and state */
+
+  ulong   event_max = 4096UL;
+  void *  trace_mem = aligned_alloc( fd_vm_trace_align(), fd_vm_trace_footprint( event_max, 64UL ) );
+  fd_vm_trace_t * trace = fd_vm_trace_join( fd_vm_trace_new( trace_mem, event_max, 64UL ) ); FD_TEST( trace );
+
+  FD_TEST( fd_vm_init( vm, instr_ctx, FD_VM_HEAP_DEFAULT, 100UL, (uchar const *)text, 24UL, text, 3UL,
+                       0UL, 24UL, 0UL, NULL, FD_SBPF_V0, syscalls, trace, sha, NULL, 0U, NULL, 0, 0 ) );
+  FD_TEST( fd_vm_exec_jit( vm, jit )==FD_VM_SUCCESS );
+  FD_TEST( vm->reg[0]==43UL && vm->pc==2UL && vm->ic==3UL && vm->cu==97UL );
+  ulong jit_event_sz = fd_vm_trace_event_sz( trace );
+  FD_TEST( jit_event_sz );
+
+  FD_TEST( !fd_vm_trace_reset( trace ) );
+  FD_TEST( fd_vm_init( vm, instr_ctx, FD_VM_HEAP_DEFAULT, 100UL, (uchar const *)text, 24UL, text, 3UL,
+                       0UL, 24UL, 0UL, NULL, FD_SBPF_V0, syscalls, trace, sha, NULL, 0U, NULL, 0, 0 ) );
+  FD_TEST( fd_vm_exec_trace( vm )==FD_VM_SUCCESS );
+  FD_TEST( fd_vm_trace_event_sz( trace )==jit_event_sz );
+
+  free( fd_vm_trace_delete( fd_vm_trace_leave( trace ) ) );
+  fd_vm_jit_code_free( code, code_max );
+  fd_vm_delete( fd_vm_leave( vm ) );
+  fd_sha256_delete( fd_sha256_leave( sha ) );
+}
+
+static fd_sbpf_syscalls_t _syscalls[ FD_SBPF_SYSCALLS_SLOT_CNT ];
+static fd_sbpf_syscalls_t _partial [ FD_SBPF_SYSCALLS_SLOT_CNT ];
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong iter_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-cnt", NULL, 2000UL );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  fd_sbpf_syscalls_t * syscalls = fd_sbpf_syscalls_join( fd_sbpf_syscalls_new( _syscalls ) ); FD_TEST( syscalls );
+  fd_sbpf_syscalls_t * syscall;
+  syscall = fd_sbpf_syscalls_insert( syscalls, FD_VM_SBPF_STATIC_SYSCALLS_LIST[1] ); FD_TEST( syscall );
+  syscall->func = accumulator_syscall; syscall->name = "accumulator";
+  syscall = fd_sbpf_syscalls_insert( syscalls, FD_VM_SBPF_STATIC_SYSCALLS_LIST[2] ); FD_TEST( syscall );
+  syscall->func = burn_syscall;        syscall->name = "burn";
+
+  fd_sbpf_syscalls_t * partial = fd_sbpf_syscalls_join( fd_sbpf_syscalls_new( _partial ) ); FD_TEST( partial );
+  syscall = fd_sbpf_syscalls_insert( partial, FD_VM_SBPF_STATIC_SYSCALLS_LIST[1] ); FD_TEST( syscall );
+  syscall->func = accumulator_syscall; syscall->name = "accumulator";
+
+  fd_sbpf_calldests_t * calldests = fd_sbpf_calldests_join( fd_sbpf_calldests_new(
+      aligned_alloc( fd_sbpf_calldests_align(), fd_sbpf_calldests_footprint( TEXT_MAX ) ), TEXT_MAX ) );
+  ulong * text = (ulong *)aligned_alloc( 8UL, 8UL*TEXT_MAX );
+  FD_TEST( calldests ); FD_TEST( text );
+
+  fd_valloc_t valloc = fd_libc_alloc_virtual();
+  fd_exec_slot_ctx_t  * slot_ctx  = fd_valloc_malloc( valloc, FD_EXEC_SLOT_CTX_ALIGN,    FD_EXEC_SLOT_CTX_FOOTPRINT );
+  fd_exec_epoch_ctx_t * epoch_ctx = fd_valloc_malloc( valloc, fd_exec_epoch_ctx_align(), sizeof(fd_exec_epoch_ctx_t) );
+  fd_exec_instr_ctx_t * instr_ctx = test_vm_minimal_exec_instr_ctx( valloc, epoch_ctx, slot_ctx );
+
+  test_api( instr_ctx, syscalls );
+  test_diff( rng, instr_ctx, syscalls, partial, calldests, text, iter_cnt );
+
+  test_vm_exec_instr_ctx_delete( instr_ctx, valloc );
+  fd_valloc_free( valloc, epoch_ctx );
+  fd_valloc_free( valloc, slot_ctx );
+
+  free( text );
+  free( fd_sbpf_calldests_delete( fd_sbpf_calldests_leave( calldests ) ) );
+  fd_sbpf_syscalls_delete( fd_sbpf_syscalls_leave( partial  ) );
+  fd_sbpf_syscalls_delete( fd_sbpf_syscalls_leave( syscalls ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -0,0 +1,144 @@
+#include "fd_vm_jit_cache.h"
+#include "../fd_vm_private.h"
+#include "../test_vm_util.h"
+
+#define ENTRY_MAX (4UL)
+
+static uchar cache_mem[ 8192 ] __attribute__((aligned(FD_VM_JIT_CACHE_ALIGN)));
+
+static ulong text[3] = {
+  0UL, /* mov64 r0, imm (set in main) */
+  0UL, /* add64 r0, 1 */
+  0UL  /* exit */
+};
+
+static fd_vm_jit_cache_key_t
+key( ulong i ) {
+  fd_vm_jit_cache_key_t k = {0};
+  FD_STORE( ulong, k.hash, fd_ulong_hash( i ) );
+  k.tag = i & 1UL;
+  return k;
+}
+
+/* run executes jit and checks the result of the program above */
+
+static void
+run( fd_vm_t *             vm,
+     fd_exec_instr_ctx_t * instr_ctx,
+     fd_sha256_t *         sha,
+     fd_vm_jit_t const *   jit ) {
+  FD_TEST( fd_vm_init( vm, instr_ctx, FD_VM_HEAP_DEFAULT, 100UL, (uchar const *)text, 24UL, text, 3UL,
+                       0UL, 24UL, 0UL, NULL, FD_SBPF_V0, NULL, NULL, sha, NULL, 0U, NULL, 0, 0 ) );
+  FD_TEST( fd_vm_exec_jit( vm, jit )==FD_VM_SUCCESS );
+  FD_TEST( vm->reg[0]==43UL && vm->ic==3UL && vm->cu==97UL );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  text[0] = fd_vm_instr( 0xb7UL, 0UL, 0UL, 0, 42U );
+  text[1] = fd_vm_instr( 0x07UL, 0UL, 0UL, 0,  1U );
+  text[2] = fd_vm_instr( 0x95UL, 0UL, 0UL, 0,  0U );
+
+  fd_valloc_t valloc = fd_libc_alloc_virtual();
+  fd_exec_slot_ctx_t  * slot_ctx  = fd_valloc_malloc( valloc, FD_EXEC_SLOT_CTX_ALIGN,    FD_EXEC_SLOT_CTX_FOOTPRINT );
+  fd_exec_epoch_ctx_t * epoch_ctx = fd_valloc_malloc( valloc, fd_exec_epoch_ctx_align(), sizeof(fd_exec_epoch_ctx_t) );
+  fd_exec_instr_ctx_t * instr_ctx = test_vm_minimal_exec_instr_ctx( valloc, epoch_ctx, slot_ctx );
+
+  fd_sha256_t _sha[1]; fd_sha256_t * sha = fd_sha256_join( fd_sha256_new( _sha ) );
+  fd_vm_t     _vm[1];  fd_vm_t *     vm  = fd_vm_join( fd_vm_new( _vm ) ); FD_TEST( vm );
+
+  /* Arena with room for at least two compiles of the program above */
+
+  ulong   code_max = fd_vm_jit_code_max( 3UL );
+  ulong   code_sz  = FD_SHMEM_NORMAL_PAGE_SZ;
+  uchar * rw       = NULL;
+  uchar * rx       = NULL;
+  FD_TEST( !fd_vm_jit_code_map( code_sz, &rw, &rx ) );
+  FD_TEST( rw && rx && rw!=rx );
+  FD_TEST( 2UL*code_max<=code_sz );
+
+  FD_TEST( !fd_vm_jit_cache_footprint( 0UL ) );
+  FD_TEST( !fd_vm_jit_cache_footprint( 3UL ) );
+  FD_TEST( fd_vm_jit_cache_footprint( ENTRY_MAX )<=sizeof(cache_mem) );
+  FD_TEST( !fd_vm_jit_cache_new( NULL,          ENTRY_MAX, rw,   rx, code_sz ) );
+  FD_TEST( !fd_vm_jit_cache_new( cache_mem+1UL, ENTRY_MAX, rw,   rx, code_sz ) );
+  FD_TEST( !fd_vm_jit_cache_new( cache_mem,     3UL,       rw,   rx, code_sz ) );
+  FD_TEST( !fd_vm_jit_cache_new( cache_mem,     ENTRY_MAX, NULL, rx, code_sz ) );
+
+  /* Small arena: only one compile fits at a time */
+
+  ulong small_sz = code_max + 64UL;
+  fd_vm_jit_cache_t * cache = fd_vm_jit_cache_join( fd_vm_jit_cache_new( cache_mem, ENTRY_MAX, rw, rx, small_sz ) );
+  FD_TEST( cache );
+  fd_vm_jit_cache_metrics_t const * m = fd_vm_jit_cache_metrics( cache );
+
+  fd_vm_jit_cache_key_t k0 = key( 0UL );
+  fd_vm_jit_cache_key_t k1 = key( 1UL );
+  fd_vm_jit_t const * j0 = fd_vm_jit_cache_acquire( cache, &k0, text, 3UL, 0UL, NULL, FD_SBPF_V0 );
+  FD_TEST( j0 && j0->code>=rx && j0->code<rx+small_sz );
+  FD_TEST( m->miss_cnt==1UL && m->code_sz>64UL && m->code_sz<=code_max );
+  run( vm, instr_ctx, sha, j0 );
+
+  /* Nested acquire of the same program hits, of another one would need
+     a flush and is refused while j0 runs */
+
+  fd_vm_jit_t const * j0b = fd_vm_jit_cache_acquire( cache, &k0, text, 3UL, 0UL, NULL, FD_SBPF_V0 );
+  FD_TEST( j0b==j0 && m->hit_cnt==1UL );
+  fd_vm_jit_cache_release( cache, j0b );
+  FD_TEST( !fd_vm_jit_cache_acquire( cache, &k1, text, 3UL, 0UL, NULL, FD_SBPF_V0 ) );
+  FD_TEST( m->busy_cnt==1UL && !m->flush_cnt );
+  fd_vm_jit_cache_release( cache, j0 );
+
+  fd_vm_jit_t const * j1 = fd_vm_jit_cache_acquire( cache, &k1, text, 3UL, 0UL, NULL, FD_SBPF_V0 );
+  FD_TEST( j1 && m->flush_cnt==1UL );
+  run( vm, instr_ctx, sha, j1 );
+  fd_vm_jit_cache_release( cache, j1 );
+
+  /* Too large for the arena: remembered as failed until the next flush */
+
+  ulong big_cnt = 64UL;
+  FD_TEST( fd_vm_jit_code_max( big_cnt )>small_sz );
+  fd_vm_jit_cache_key_t k2 = key( 2UL );
+  FD_TEST( !fd_vm_jit_cache_acquire( cache, &k2, text, big_cnt, 0UL, NULL, FD_SBPF_V0 ) );
+  FD_TEST( !fd_vm_jit_cache_acquire( cache, &k2, text, big_cnt, 0UL, NULL, FD_SBPF_V0 ) );
+  FD_TEST( m->fail_cnt==1UL && m->miss_cnt==3UL );
+
+  FD_TEST( fd_vm_jit_cache_delete( fd_vm_jit_cache_leave( cache ) )==cache_mem );
+  FD_TEST( !fd_vm_jit_cache_join( cache_mem ) );
+
+  /* Entry table full: flushed on the next miss */
+
+  cache = fd_vm_jit_cache_join( fd_vm_jit_cache_new( cache_mem, ENTRY_MAX, rw, rx, code_sz ) );
+  FD_TEST( cache );
+  m = fd_vm_jit_cache_metrics( cache );
+  for( ulong i=0UL; i<ENTRY_MAX; i++ ) {
+    fd_vm_jit_cache_key_t k = key( 16UL+i );
+    /* NULL text fails to compile but takes an entry */
+    FD_TEST( !fd_vm_jit_cache_acquire( cache, &k, NULL, 1UL, 0UL, NULL, FD_SBPF_V0 ) );
+  }
+  FD_TEST( m->fail_cnt==ENTRY_MAX && !m->flush_cnt );
+  j0 = fd_vm_jit_cache_acquire( cache, &k0, text, 3UL, 0UL, NULL, FD_SBPF_V0 );
+  FD_TEST( j0 && m->flush_cnt==1UL );
+  j1 = fd_vm_jit_cache_acquire( cache, &k1, text, 3UL, 0UL, NULL, FD_SBPF_V0 );
+  FD_TEST( j1 && j1!=j0 && j1->code>=j0->code+j0->code_sz );
+  run( vm, instr_ctx, sha, j0 );
+  run( vm, instr_ctx, sha, j1 );
+  fd_vm_jit_cache_release( cache, j1 );
+  fd_vm_jit_cache_release( cache, j0 );
+
+  FD_TEST( fd_vm_jit_cache_delete( fd_vm_jit_cache_leave( cache ) )==cache_mem );
+  fd_vm_jit_code_unmap( rw, rx, code_sz );
+
+  fd_vm_delete( fd_vm_leave( vm ) );
+  fd_sha256_delete( fd_sha256_leave( sha ) );
+  test_vm_exec_instr_ctx_delete( instr_ctx, valloc );
+  fd_valloc_free( valloc, epoch_ctx );
+  fd_valloc_free( valloc, slot_ctx );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -328,6 +328,149 @@ vm_trace_done:
   FD_TEST( !fd_vm_trace_join  ( _trace ) ); /* not a trace */
   FD_TEST( !fd_vm_trace_delete( _trace ) ); /* not a trace */
 
+  FD_LOG_NOTICE(( "Testing fd_vm_prof" ));
+
+  /* Test prof constructors */
+
+  ulong node_max   = 32UL;
+  ulong bucket_max = 32UL;
+
+  FD_TEST( fd_vm_prof_align()==FD_VM_PROF_ALIGN );
+
+  FD_TEST( !fd_vm_prof_footprint( 0UL,      bucket_max ) ); /* bad node_max */
+  FD_TEST( !fd_vm_prof_footprint( 24UL,     bucket_max ) ); /* bad node_max */
+  FD_TEST( !fd_vm_prof_footprint( node_max, 1UL        ) ); /* bad bucket_max */
+  FD_TEST( !fd_vm_prof_footprint( node_max, 1UL<<32    ) ); /* bad bucket_max */
+  footprint = fd_vm_prof_footprint( node_max, bucket_max );
+  FD_TEST( fd_ulong_is_aligned( footprint, FD_VM_PROF_ALIGN ) );
+
+  if( FD_UNLIKELY( footprint>4096UL ) ) FD_LOG_ERR(( "update unit test to support this large prof" ));
+
+  static uchar prof_mem[ 4096 ] __attribute__((aligned(FD_VM_PROF_ALIGN)));
+
+  FD_TEST( !fd_vm_prof_new( NULL,          node_max, bucket_max, 4UL, 1234UL ) ); /* NULL shmem */
+  FD_TEST( !fd_vm_prof_new( prof_mem+8UL,  node_max, bucket_max, 4UL, 1234UL ) ); /* misaligned shmem */
+  FD_TEST( !fd_vm_prof_new( prof_mem,      3UL,      bucket_max, 4UL, 1234UL ) ); /* bad node_max */
+  FD_TEST( !fd_vm_prof_new( prof_mem,      node_max, bucket_max, 0UL, 1234UL ) ); /* bad sample_period */
+  void * _prof = fd_vm_prof_new( prof_mem, node_max, bucket_max, 4UL, 1234UL ); FD_TEST( _prof==prof_mem );
+
+  FD_TEST( !fd_vm_prof_join( NULL         ) ); /* NULL _prof */
+  FD_TEST( !fd_vm_prof_join( prof_mem+8UL ) ); /* misaligned _prof */
+  fd_vm_prof_t * prof = fd_vm_prof_join( _prof ); FD_TEST( prof );
+
+  FD_TEST( fd_vm_prof_node_max     ( prof )==node_max   );
+  FD_TEST( fd_vm_prof_bucket_max   ( prof )==bucket_max );
+  FD_TEST( fd_vm_prof_sample_period( prof )==4UL        );
+
+  /* Test keys */
+
+  for( ulong iter=0UL; iter<1000UL; iter++ ) {
+    ulong node = fd_rng_ulong( rng ) & ((1UL<<31)-1UL);
+    ulong pc   = fd_rng_ulong( rng ) & (ulong)UINT_MAX;
+    ulong key  = fd_vm_prof_key( node, pc );
+    FD_TEST( key );
+    FD_TEST( fd_vm_prof_key_node( key )==node );
+    FD_TEST( fd_vm_prof_key_pc  ( key )==pc   );
+  }
+
+  /* Test call stack interning */
+
+  uchar prog_a[ 32 ]; memset( prog_a, 0xa, 32UL );
+  uchar prog_b[ 32 ]; memset( prog_b, 0xb, 32UL );
+
+  ulong node_a  = fd_vm_prof_node_insert( prof, FD_VM_PROF_NODE_ROOT, prog_a ); FD_TEST( node_a <node_max );
+  ulong node_b  = fd_vm_prof_node_insert( prof, FD_VM_PROF_NODE_ROOT, prog_b ); FD_TEST( node_b <node_max );
+  ulong node_ab = fd_vm_prof_node_insert( prof, node_a,               prog_b ); FD_TEST( node_ab<node_max );
+  FD_TEST( (node_a!=node_b) & (node_a!=node_ab) & (node_b!=node_ab) );
+  FD_TEST( fd_vm_prof_node_insert( prof, FD_VM_PROF_NODE_ROOT, prog_a )==node_a  ); /* already interned */
+  FD_TEST( fd_vm_prof_node_insert( prof, node_a,               prog_b )==node_ab ); /* already interned */
+  FD_TEST( fd_vm_prof_node_insert( prof, FD_VM_PROF_NODE_NULL, prog_a )==FD_VM_PROF_NODE_NULL );
+
+  fd_vm_prof_node_t const * node_tbl = fd_vm_prof_node( prof );
+  FD_TEST( node_tbl[ node_ab ].used && node_tbl[ node_ab ].parent==node_a && node_tbl[ node_ab ].depth==2U );
+
+  ulong deep = node_ab;
+  for( ulong depth=3UL; depth<=FD_VM_PROF_DEPTH_MAX; depth++ ) {
+    deep = fd_vm_prof_node_insert( prof, deep, prog_a );
+    FD_TEST( deep<node_max );
+  }
+  FD_TEST( fd_vm_prof_node_insert( prof, deep, prog_a )==FD_VM_PROF_NODE_NULL ); /* too deep */
+
+  char stack_cstr[ FD_VM_PROF_STACK_CSTR_MAX ];
+  char b58_a[ FD_BASE58_ENCODED_32_SZ ]; fd_base58_encode_32( prog_a, NULL, b58_a );
+  char b58_b[ FD_BASE58_ENCODED_32_SZ ]; fd_base58_encode_32( prog_b, NULL, b58_b );
+  char expected[ 2UL*FD_BASE58_ENCODED_32_SZ ];
+  FD_TEST( fd_cstr_printf_check( expected, sizeof(expected), NULL, "%s;%s", b58_a, b58_b ) );
+  FD_TEST( fd_vm_prof_stack_cstr( prof, node_ab, stack_cstr )==stack_cstr );
+  FD_TEST( !strcmp( stack_cstr, expected ) );
+  FD_TEST( fd_vm_prof_stack_cstr( prof, deep, stack_cstr ) );
+  FD_TEST( strlen( stack_cstr )<FD_VM_PROF_STACK_CSTR_MAX );
+  FD_TEST( !fd_vm_prof_stack_cstr( prof, node_max, stack_cstr ) );
+
+  /* Fill the node table to half capacity */
+
+  for( ulong i=0UL; i<node_max; i++ ) {
+    uchar prog[ 32 ]; memset( prog, 0, 32UL ); prog[0] = (uchar)i;
+    ulong node = fd_vm_prof_node_insert( prof, FD_VM_PROF_NODE_ROOT, prog );
+    FD_TEST( node<node_max || (node==FD_VM_PROF_NODE_NULL && prof->node_cnt==node_max/2UL) );
+  }
+
+  /* Test sampling */
+
+  ulong tot_ic = 0UL;
+  ulong tot_cu = 0UL;
+  for( ulong iter=0UL; iter<1000UL; iter++ ) {
+    ulong r    = fd_rng_ulong( rng );
+    ulong node = (r & 1UL) ? node_a : node_ab;
+    ulong pc   = (r>>1) & 63UL;
+    ulong ic   = (r>>8) & 255UL;
+    ulong cu   = ic + ((r>>16) & 255UL);
+    fd_vm_prof_sample( prof, node, pc, ic, cu );
+    tot_ic += ic;
+    tot_cu += cu;
+  }
+  fd_vm_prof_sample( prof, FD_VM_PROF_NODE_NULL, 0UL, 1UL, 2UL );
+  tot_ic += 1UL;
+  tot_cu += 2UL;
+
+  FD_TEST( prof->bucket_cnt==bucket_max/2UL );
+  FD_TEST( prof->sample_cnt + prof->drop_cnt==1001UL );
+
+  fd_vm_prof_bucket_t const * bucket = fd_vm_prof_bucket( prof );
+  ulong sum_ic  = prof->drop_ic;
+  ulong sum_cu  = prof->drop_cu;
+  ulong sum_cnt = prof->drop_cnt;
+  ulong used    = 0UL;
+  for( ulong i=0UL; i<bucket_max; i++ ) {
+    if( !bucket[i].key ) continue;
+    ulong node = fd_vm_prof_key_node( bucket[i].key );
+    FD_TEST( node==node_a || node==node_ab );
+    FD_TEST( fd_vm_prof_key_pc( bucket[i].key )<64UL );
+    sum_ic  += bucket[i].ic;
+    sum_cu  += bucket[i].cu;
+    sum_cnt += bucket[i].sample_cnt;
+    used++;
+  }
+  FD_TEST( used==prof->bucket_cnt );
+  FD_TEST( sum_ic==tot_ic && sum_cu==tot_cu && sum_cnt==1001UL );
+
+  FD_TEST( fd_vm_prof_reset( prof )==prof );
+  FD_TEST( !prof->node_cnt && !prof->bucket_cnt && !prof->sample_cnt && !prof->drop_cnt );
+  for( ulong i=0UL; i<bucket_max; i++ ) FD_TEST( !bucket[i].key );
+  for( ulong i=0UL; i<node_max;   i++ ) FD_TEST( !node_tbl[i].used );
+
+  /* Test destructors */
+
+  FD_TEST( !fd_vm_prof_leave( NULL ) );
+  FD_TEST( fd_vm_prof_leave( prof )==_prof );
+
+  FD_TEST( !fd_vm_prof_delete( NULL         ) ); /* NULL       _prof */
+  FD_TEST( !fd_vm_prof_delete( prof_mem+8UL ) ); /* misaligned _prof */
+  FD_TEST( fd_vm_prof_delete( _prof )==(void *)prof_mem );
+
+  FD_TEST( !fd_vm_prof_join  ( _prof ) ); /* not a prof */
+  FD_TEST( !fd_vm_prof_delete( _prof ) ); /* not a prof */
+
   fd_rng_delete( fd_rng_leave( rng ) );
 
   FD_LOG_NOTICE(( "pass" ));
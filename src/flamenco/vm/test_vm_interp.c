@@ -296,6 +296,142 @@ test_0cu_exit( void ) {
   fd_sha256_delete( fd_sha256_leave( sha ) );
 }
 
+/* test_prof runs a loop with a sampling profile attached and checks
+   that profiling does not change execution, that every sample is
+   credited to a linear segment start and that the profile totals
+   match the instructions and compute units consumed exactly (both on
+   normal exit and on a fault). */
+
+static void
+test_prof( void ) {
+
+  fd_sha256_t _sha[1];
+  fd_sha256_t * sha = fd_sha256_join( fd_sha256_new( _sha ) );
+
+  fd_vm_t _vm[1];
+  fd_vm_t * vm = fd_vm_join( fd_vm_new( _vm ) );
+  FD_TEST( vm );
+
+  /* Primality test of 10007 (see "prime" above).  Linear segments
+     start at pc 0, 5, 8 and 15. */
+
+  ulong const text[16] = {
+    fd_vm_instr( FD_SBPF_OP_MOV64_IMM, FD_SBPF_R1, 0,           0, 10007 ),
+    fd_vm_instr( FD_SBPF_OP_MOV64_IMM, FD_SBPF_R0, 0,           0, 1     ),
+    fd_vm_instr( FD_SBPF_OP_MOV64_IMM, FD_SBPF_R2, 0,           0, 2     ),
+    fd_vm_instr( FD_SBPF_OP_JGT_IMM,   FD_SBPF_R1, 0,          +4, 2     ),
+    fd_vm_instr( FD_SBPF_OP_JA,        0,          0,         +10, 0     ),
+    fd_vm_instr( FD_SBPF_OP_ADD64_IMM, FD_SBPF_R2, 0,           0, 1     ),
+    fd_vm_instr( FD_SBPF_OP_MOV64_IMM, FD_SBPF_R0, 0,           0, 1     ),
+    fd_vm_instr( FD_SBPF_OP_JGE_REG,   FD_SBPF_R2, FD_SBPF_R1, +7, 0     ),
+    fd_vm_instr( FD_SBPF_OP_MOV64_REG, FD_SBPF_R3, FD_SBPF_R1,  0, 0     ),
+    fd_vm_instr( FD_SBPF_OP_DIV64_REG, FD_SBPF_R3, FD_SBPF_R2,  0, 0     ),
+    fd_vm_instr( FD_SBPF_OP_MUL64_REG, FD_SBPF_R3, FD_SBPF_R2,  0, 0     ),
+    fd_vm_instr( FD_SBPF_OP_MOV64_REG, FD_SBPF_R4, FD_SBPF_R1,  0, 0     ),
+    fd_vm_instr( FD_SBPF_OP_SUB64_REG, FD_SBPF_R4, FD_SBPF_R3,  0, 0     ),
+    fd_vm_instr( FD_SBPF_OP_MOV64_IMM, FD_SBPF_R0, 0,           0, 0     ),
+    fd_vm_instr( FD_SBPF_OP_JNE_IMM,   FD_SBPF_R4, 0,         -10, 0     ),
+    fd_vm_instr( FD_SBPF_OP_EXIT,      0,          0,           0, 0     )
+  };
+  ulong text_cnt = 16UL;
+
+  fd_valloc_t valloc = fd_libc_alloc_virtual();
+  fd_exec_slot_ctx_t  * slot_ctx  = fd_valloc_malloc( valloc, FD_EXEC_SLOT_CTX_ALIGN,    FD_EXEC_SLOT_CTX_FOOTPRINT );
+  fd_exec_epoch_ctx_t * epoch_ctx = fd_valloc_malloc( valloc, fd_exec_epoch_ctx_align(), sizeof(fd_exec_epoch_ctx_t) );
+  fd_exec_instr_ctx_t * instr_ctx = test_vm_minimal_exec_instr_ctx( valloc, epoch_ctx, slot_ctx );
+
+  ulong node_max   = 4UL;
+  ulong bucket_max = 16UL;
+  void * prof_mem = fd_valloc_malloc( valloc, fd_vm_prof_align(), fd_vm_prof_footprint( node_max, bucket_max ) );
+  fd_vm_prof_t * prof = fd_vm_prof_join( fd_vm_prof_new( prof_mem, node_max, bucket_max, 7UL, 0UL ) );
+  FD_TEST( prof );
+
+  uchar program_id[ 32 ] = {0};
+  ulong node = fd_vm_prof_node_insert( prof, FD_VM_PROF_NODE_ROOT, program_id );
+  FD_TEST( node<node_max );
+
+  ulong entry_cu[3] = { FD_VM_COMPUTE_UNIT_LIMIT, FD_VM_COMPUTE_UNIT_LIMIT, 1000UL };
+  ulong ref_ic = 0UL;
+  for( ulong run=0UL; run<3UL; run++ ) {
+    int vm_ok = !!fd_vm_init(
+        /* vm               */ vm,
+        /* instr_ctx        */ instr_ctx,
+        /* heap_max         */ FD_VM_HEAP_DEFAULT,
+        /* entry_cu         */ entry_cu[ run ],
+        /* rodata           */ (uchar *)text,
+        /* rodata_sz        */ 8UL*text_cnt,
+        /* text             */ text,
+        /* text_cnt         */ text_cnt,
+        /* text_off         */ 0UL,
+        /* text_sz          */ 8UL*text_cnt,
+        /* entry_pc         */ 0UL,
+        /* calldests        */ NULL,
+        /* sbpf_version     */ TEST_VM_DEFAULT_SBPF_VERSION,
+        /* syscalls         */ NULL,
+        /* trace            */ NULL,
+        /* sha              */ sha,
+        /* mem_regions      */ NULL,
+        /* mem_regions_cnt  */ 0UL,
+        /* mem_regions_accs */ NULL,
+        /* is_deprecated    */ 0,
+        /* direct mapping   */ FD_FEATURE_ACTIVE( instr_ctx->txn_ctx->slot, instr_ctx->txn_ctx->features, bpf_account_data_direct_mapping )
+    );
+    FD_TEST( vm_ok );
+    FD_TEST( !vm->prof );
+    FD_TEST( fd_vm_validate( vm )==FD_VM_SUCCESS );
+
+    if( !run ) { /* reference run without profiling */
+      FD_TEST( fd_vm_exec( vm )==FD_VM_SUCCESS );
+      FD_TEST( vm->reg[0]==1UL );
+      ref_ic = vm->ic;
+      continue;
+    }
+
+    fd_vm_prof_reset( prof );
+    node = fd_vm_prof_node_insert( prof, FD_VM_PROF_NODE_ROOT, program_id );
+    vm->prof      = prof;
+    vm->prof_node = node;
+
+    int err = fd_vm_exec( vm );
+    if( run==1UL ) {
+      FD_TEST( err==FD_VM_SUCCESS );
+      FD_TEST( vm->reg[0]==1UL );
+      FD_TEST( vm->ic==ref_ic );
+    } else {
+      FD_TEST( err==FD_VM_ERR_SIGCOST );
+      FD_TEST( !vm->cu );
+    }
+
+    /* Check the profile */
+
+    fd_vm_prof_bucket_t const * bucket = fd_vm_prof_bucket( prof );
+    ulong sum_ic = 0UL;
+    ulong sum_cu = 0UL;
+    ulong max_ic = 0UL;
+    ulong max_pc = ULONG_MAX;
+    for( ulong i=0UL; i<bucket_max; i++ ) {
+      if( !bucket[i].key ) continue;
+      ulong pc = fd_vm_prof_key_pc( bucket[i].key );
+      FD_TEST( fd_vm_prof_key_node( bucket[i].key )==node );
+      FD_TEST( pc==0UL || pc==5UL || pc==8UL || pc==15UL );
+      sum_ic += bucket[i].ic;
+      sum_cu += bucket[i].cu;
+      if( bucket[i].ic>max_ic ) { max_ic = bucket[i].ic; max_pc = pc; }
+    }
+    FD_TEST( !prof->drop_cnt );
+    FD_TEST( sum_ic==vm->ic );
+    FD_TEST( sum_cu==entry_cu[ run ]-vm->cu );
+    FD_TEST( max_pc==5UL || max_pc==8UL ); /* the loop body */
+  }
+
+  fd_valloc_free( valloc, fd_vm_prof_delete( fd_vm_prof_leave( prof ) ) );
+  fd_vm_delete( fd_vm_leave( vm ) );
+  fd_valloc_free( valloc, epoch_ctx );
+  fd_valloc_free( valloc, slot_ctx );
+  test_vm_exec_instr_ctx_delete( instr_ctx, fd_libc_alloc_virtual() );
+  fd_sha256_delete( fd_sha256_leave( sha ) );
+}
+
 static void
 test_static_syscalls_list( void ) {
   const char *static_syscalls_from_simd[] = {
@@ -1015,6 +1151,7 @@ main( int     argc,
   test_program_success( "alu64_bench_short", 0x0, text, text_cnt, syscalls, instr_ctx );
 
   test_0cu_exit();
+  test_prof();
 
   free( text );
 
@@ -1,6 +1,6 @@
 ifdef FD_HAS_ATOMIC
-$(call add-hdrs,fd_funk_base.h fd_funk_txn.h fd_funk_rec.h fd_funk_val.h fd_funk_filemap.h fd_funk.h)
-$(call add-objs,fd_funk_base fd_funk_txn fd_funk_rec fd_funk_val fd_funk_filemap fd_funk,fd_funk)
+$(call add-hdrs,fd_funk_base.h fd_funk_txn.h fd_funk_rec.h fd_funk_val.h fd_funk_filemap.h fd_funk_groove.h fd_funk.h)
+$(call add-objs,fd_funk_base fd_funk_txn fd_funk_rec fd_funk_val fd_funk_filemap fd_funk_groove fd_funk,fd_funk)
 $(call make-unit-test,test_funk_base,test_funk_base,fd_funk fd_util)
 $(call run-unit-test,test_funk_base,)
 $(call make-unit-test,test_funk,test_funk,fd_funk fd_util)
@@ -17,6 +17,8 @@ $(call make-unit-test,test_funk_txn2,test_funk_txn2,fd_funk fd_util)
 $(call run-unit-test,test_funk_txn2,)
 $(call make-unit-test,test_funk_file,test_funk_file,fd_funk fd_util)
 $(call run-unit-test,test_funk_file,)
+$(call make-unit-test,test_funk_groove,test_funk_groove,fd_funk fd_groove fd_util)
+$(call run-unit-test,test_funk_groove,)
 $(call make-unit-test,bench_funk_index,bench_funk_index,fd_funk fd_util)
 endif
 endif
@@ -124,6 +124,14 @@ fd_funk_new( void * shmem,
 
   funk->alloc_gaddr = fd_wksp_gaddr_fast( wksp, fd_alloc_join( fd_alloc_new( alloc, wksp_tag ), 0UL ) );
 
+  funk->epoch               = 0UL;
+  funk->rec_limbo_head_idx  = FD_FUNK_REC_IDX_NULL;
+  funk->rec_limbo_tail_idx  = FD_FUNK_REC_IDX_NULL;
+  funk->txn_limbo_head_cidx = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
+  funk->txn_limbo_tail_cidx = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
+  for( ulong reader_idx=0UL; reader_idx<FD_FUNK_READER_MAX; reader_idx++ ) funk->reader_epoch[ reader_idx ] = ULONG_MAX;
+  fd_memset( funk->cold, 0, sizeof(fd_funk_cold_metrics_t) );
+
   FD_COMPILER_MFENCE();
   FD_VOLATILE( funk->magic ) = FD_FUNK_MAGIC;
   FD_COMPILER_MFENCE();
@@ -193,6 +201,11 @@ fd_funk_join( void * ljoin,
     return NULL;
   }
 
+  funk->rec_miss_fn  = NULL;
+  funk->rec_miss_ctx = NULL;
+
+  funk->reader_idx = ULONG_MAX;
+
   return funk;
 }
 
@@ -207,6 +220,13 @@ fd_funk_leave( fd_funk_t * funk,
   }
   void * shfunk = funk->shmem;
 
+  ulong reader_idx = funk->reader_idx;
+  if( reader_idx<FD_FUNK_READER_MAX ) {
+    fd_funk_shmem_t * shmem = funk->shmem;
+    FD_VOLATILE( shmem->reader_epoch[ reader_idx ] ) = ULONG_MAX;
+    FD_ATOMIC_FETCH_AND_AND( &shmem->reader_used[ reader_idx>>6 ], ~(1UL<<(reader_idx & 63UL)) );
+  }
+
   memset( funk, 0, sizeof(fd_funk_t) );
 
   if( opt_shfunk ) *opt_shfunk = shfunk;
@@ -261,6 +281,13 @@ fd_funk_delete( void * shfunk ) {
     }
   }
 
+  /* Also free values of records that are awaiting reclamation */
+
+  fd_funk_rec_t * rec_ele = (fd_funk_rec_t *)shele;
+  for( uint rec_idx=shmem->rec_limbo_head_idx; !fd_funk_rec_idx_is_null( rec_idx ); rec_idx=rec_ele[ rec_idx ].next_idx ) {
+    fd_funk_val_flush( rec_ele + rec_idx, alloc, wksp );
+  }
+
   fd_funk_rec_map_leave( rec_map );
 
   /* Free the fd_alloc instance */
@@ -300,6 +327,35 @@ fd_funk_delete_fast( void * shfunk ) {
 
 }
 
+void
+fd_funk_read_begin( fd_funk_t * funk ) {
+  fd_funk_shmem_t * shmem = funk->shmem;
+
+  /* Claim a reader slot on first use */
+
+  ulong reader_idx = funk->reader_idx;
+  if( FD_UNLIKELY( reader_idx==ULONG_MAX ) ) {
+    for( reader_idx=0UL; reader_idx<FD_FUNK_READER_MAX; reader_idx++ ) {
+      ulong * used = &shmem->reader_used[ reader_idx>>6 ];
+      ulong   bit  = 1UL<<(reader_idx & 63UL);
+      if( !(FD_ATOMIC_FETCH_AND_OR( used, bit ) & bit) ) break;
+    }
+    if( FD_UNLIKELY( reader_idx>=FD_FUNK_READER_MAX ) ) FD_LOG_ERR(( "too many funk readers (increase FD_FUNK_READER_MAX)" ));
+    funk->reader_idx = reader_idx;
+  }
+
+  /* Publish the epoch we observed.  If the epoch advanced while we were
+     publishing it, a concurrent reclaim might have missed us so we try
+     again (we have not looked at anything yet so this is safe). */
+
+  ulong * reader_epoch = &shmem->reader_epoch[ reader_idx ];
+  for(;;) {
+    ulong epoch = FD_VOLATILE_CONST( shmem->epoch );
+    (void)FD_ATOMIC_XCHG( reader_epoch, epoch ); /* full fence */
+    if( FD_LIKELY( FD_VOLATILE_CONST( shmem->epoch )==epoch ) ) break;
+  }
+}
+
 int
 fd_funk_verify( fd_funk_t * join ) {
   fd_funk_shmem_t * funk = join->shmem;
@@ -142,6 +142,16 @@
      fd_funk_rec_publish
      fd_funk_rec_cancel
      fd_funk_rec_remove
+
+   Additionally, fd_funk_rec_query_try_global can be run concurrently
+   with transaction level operations (fd_funk_txn_publish*,
+   fd_funk_txn_cancel*) as long as the query is done inside a read
+   section (see fd_funk_read_begin) and the queried transaction is not
+   being published or cancelled by the operation (e.g. queries on a
+   descendant of the transaction being published).  Records and
+   transactions removed by transaction level operations are only
+   returned to their pools once no read section that could observe them
+   is active.
 */
 
 //#include "fd_funk_base.h" /* Includes ../util/fd_util.h */
@@ -158,7 +168,28 @@
 /* The details of a fd_funk_shmem_private are exposed here to facilitate
    inlining various operations. */
 
-#define FD_FUNK_MAGIC (0xf17eda2ce7fc2c02UL) /* firedancer funk version 2 */
+#define FD_FUNK_MAGIC (0xf17eda2ce7fc2c03UL) /* firedancer funk version 3 */
+
+/* FD_FUNK_READER_MAX gives the maximum number of local joins of a funk
+   that can be in a read section (see fd_funk_read_begin) at any point
+   in time.  Multiple of 64. */
+
+#define FD_FUNK_READER_MAX (128UL)
+
+/* A fd_funk_cold_metrics_t gives running counters of the cold tier of a
+   funk (see fd_funk_groove.h).  Counters are not reset and are updated
+   with relaxed atomics. */
+
+struct fd_funk_cold_metrics {
+  ulong demote_cnt;       /* Number of records demoted */
+  ulong demote_byte_cnt;  /* Number of value bytes demoted */
+  ulong demote_skip_cnt;  /* Number of demotion candidates that were kept in funk (e.g. key collision or groove full) */
+  ulong promote_cnt;      /* Number of records promoted */
+  ulong promote_byte_cnt; /* Number of value bytes promoted */
+  ulong rec_cnt;          /* Number of records currently demoted */
+};
+
+typedef struct fd_funk_cold_metrics fd_funk_cold_metrics_t;
 
 struct __attribute__((aligned(FD_FUNK_ALIGN))) fd_funk_shmem_private {
 
@@ -255,6 +286,35 @@ struct __attribute__((aligned(FD_FUNK_ALIGN))) fd_funk_shmem_private {
   ulong alloc_gaddr; /* Non-zero wksp gaddr with tag wksp tag */
   uchar lock;        /* lock for synchronizing modifications to funk object */
 
+  /* Deferred reclamation.  Records and transactions removed by
+     transaction level operations are not immediately released to their
+     pools as concurrent read sections might still be looking at them.
+     Instead, they are appended to a limbo list (linked via next_idx for
+     records and stack_cidx for transactions) tagged with the epoch they
+     got retired in.  epoch is advanced at the end of every transaction
+     level operation.
+
+     reader_epoch[ reader_idx ] gives the epoch observed when the join
+     holding reader slot reader_idx entered its current read section
+     (ULONG_MAX if not in a read section).  Slot reader_idx is held by a
+     join if bit reader_idx of reader_used is set.  Limbo entries retired
+     before the oldest active read section started are safe to release
+     (see fd_funk_reclaim). */
+
+  ulong epoch;
+  uint  rec_limbo_head_idx;  /* Oldest retired record, FD_FUNK_REC_IDX_NULL if none */
+  uint  rec_limbo_tail_idx;  /* Youngest retired record, FD_FUNK_REC_IDX_NULL if none */
+  uint  txn_limbo_head_cidx; /* Compressed idx of the oldest retired transaction, FD_FUNK_TXN_IDX_NULL if none */
+  uint  txn_limbo_tail_cidx; /* Compressed idx of the youngest retired transaction, FD_FUNK_TXN_IDX_NULL if none */
+  ulong reader_used [ FD_FUNK_READER_MAX/64UL ];
+  ulong reader_epoch[ FD_FUNK_READER_MAX ];
+
+  /* Cold tier counters (see fd_funk_groove.h).  cold->rec_cnt is
+     non-zero while any record of the last published transaction is
+     held outside of funk. */
+
+  fd_funk_cold_metrics_t cold[1];
+
   /* Padding to FD_FUNK_ALIGN here */
 };
 
@@ -263,6 +323,16 @@ struct __attribute__((aligned(FD_FUNK_ALIGN))) fd_funk_shmem_private {
 
 #define FD_FUNK_JOIN_ALIGN 64
 
+/* fd_funk_rec_miss_fn_t is the type of an optional handler that gets
+   called when a record lookup in the last published transaction misses
+   (see fd_funk_groove.h).  ctx is the rec_miss_ctx of the join and key
+   is the record key that missed.  Returns 1 if the handler inserted key
+   into the last published transaction (such that the lookup should be
+   retried) and 0 otherwise. */
+
+typedef int (* fd_funk_rec_miss_fn_t)( void *                    ctx,
+                                       fd_funk_rec_key_t const * key );
+
 struct __attribute__((aligned(FD_FUNK_JOIN_ALIGN))) fd_funk_private {
 
   fd_funk_shmem_t *  shmem;
@@ -276,6 +346,16 @@ struct __attribute__((aligned(FD_FUNK_JOIN_ALIGN))) fd_funk_private {
   fd_wksp_t *  wksp;
   fd_alloc_t * alloc;
 
+  /* Record miss handler of this join (NULL if none) */
+
+  fd_funk_rec_miss_fn_t rec_miss_fn;
+  void *                rec_miss_ctx;
+
+  /* Reader slot of this join (ULONG_MAX if none, see
+     fd_funk_read_begin) */
+
+  ulong reader_idx;
+
 };
 
 FD_PROTOTYPES_BEGIN
@@ -369,6 +449,11 @@ fd_funk_delete_fast( void * shfunk );
 
 FD_FN_PURE static inline fd_wksp_t * fd_funk_wksp( fd_funk_t const * funk ) { return funk->wksp; }
 
+/* fd_funk_cold_metrics returns the cold tier counters of funk.  The
+   lifetime of the returned pointer is the lifetime of the join. */
+
+FD_FN_PURE static inline fd_funk_cold_metrics_t const * fd_funk_cold_metrics( fd_funk_t const * funk ) { return funk->shmem->cold; }
+
 /* fd_funk_wksp_tag returns the workspace allocation tag used by the
    funk for its wksp allocations.  Will be positive.  Assumes funk is a
    current local join. */
@@ -491,6 +576,49 @@ fd_funk_txn_is_full( fd_funk_t * funk ) {
 int
 fd_funk_verify( fd_funk_t * funk );
 
+/* Read sections */
+
+/* fd_funk_read_{begin,end} begin and end a read section on a funk
+   join.  Records and transactions that a read section can observe (e.g.
+   a record returned by fd_funk_rec_query_try_global, a record value or
+   an ancestor transaction of the queried transaction) are not returned
+   to their pools while the read section is active, even if a
+   concurrent transaction level operation removed them.  This is what
+   makes it safe to query records on a fork that is not being published
+   or cancelled while another thread publishes or cancels.
+
+   The first fd_funk_read_begin on a join claims one of the
+   FD_FUNK_READER_MAX reader slots of the funk for the lifetime of the
+   join (logs details and terminates the thread group if none is
+   available).  A join should be used for at most one read section at a
+   time (e.g. use a join per thread).  Read sections should be short:
+   retired records and transactions accumulate while any read section is
+   active.  Read sections do not nest.
+
+   IMPORTANT SAFETY TIP!  A thread group that terminates while holding
+   a reader slot (e.g. without fd_funk_leave) prevents reclamation of
+   anything retired afterward until the funk is recreated. */
+
+void
+fd_funk_read_begin( fd_funk_t * funk );
+
+static inline void
+fd_funk_read_end( fd_funk_t * funk ) {
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( funk->shmem->reader_epoch[ funk->reader_idx ] ) = ULONG_MAX;
+  FD_COMPILER_MFENCE();
+}
+
+/* fd_funk_reclaim returns all retired records and transactions that
+   no active read section can observe to their pools.  Returns the
+   number of records and transactions released.  This is a
+   transaction level operation.  fd_funk_txn_prepare, publish and cancel
+   call this implicitly, so this only needs to be called explicitly to
+   release resources faster (e.g. when the record pool is full). */
+
+ulong
+fd_funk_reclaim( fd_funk_t * funk );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_funk_fd_funk_h */
@@ -0,0 +1,545 @@
+#define _GNU_SOURCE
+#define _FILE_OFFSET_BITS 64
+#include "fd_funk_groove.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+struct __attribute__((aligned(FD_FUNK_GROOVE_ALIGN))) fd_funk_groove_shmem_private {
+  ulong                    magic;     /* ==FD_FUNK_GROOVE_MAGIC */
+  ulong                    ele_max;   /* Capacity of the meta map */
+  ulong                    lock_cnt;  /* Meta map version lock count */
+  ulong                    probe_max; /* Meta map max probe sequence length */
+  ulong                    map_off;   /* Offset of the meta map from the start of the shmem region */
+  ulong                    ele_off;   /* Offset of the meta map element store */
+  ulong                    data_off;  /* Offset of the groove data store */
+};
+
+/* A demoted record is stored as a groove data object holding a
+   fd_funk_groove_obj_t followed by the record value.  The full funk
+   record key is kept to detect groove key collisions. */
+
+struct fd_funk_groove_obj {
+  fd_funk_rec_key_t key;
+  ulong             flags;
+  ulong             val_sz;
+};
+
+typedef struct fd_funk_groove_obj fd_funk_groove_obj_t;
+
+#define FD_FUNK_GROOVE_VAL_MAX (FD_GROOVE_DATA_ALLOC_FOOTPRINT_MAX - FD_GROOVE_DATA_HDR_FOOTPRINT - sizeof(fd_funk_groove_obj_t))
+
+FD_STATIC_ASSERT( FD_FUNK_GROOVE_VAL_MAX<(1UL<<24), val_sz_bits );
+
+static inline fd_groove_key_t *
+fd_funk_groove_private_key( fd_groove_key_t *         gkey,
+                            fd_funk_rec_key_t const * key ) {
+  return fd_groove_key_init_ulong( gkey, key->ul[0], key->ul[1], key->ul[2], key->ul[3] ^ fd_ulong_hash( key->ul[4] ) );
+}
+
+static inline fd_funk_groove_obj_t *
+fd_funk_groove_private_obj( fd_funk_groove_t * join,
+                            ulong              val_off ) {
+  return (fd_funk_groove_obj_t *)( (ulong)fd_groove_data_volume0( join->data ) + val_off );
+}
+
+/* fd_funk_groove_private_root_has returns 1 if key is a record of the
+   last published transaction of funk and 0 otherwise. */
+
+static int
+fd_funk_groove_private_root_has( fd_funk_t *               funk,
+                                 fd_funk_rec_key_t const * key ) {
+  fd_funk_xid_key_pair_t pair[1];
+  fd_funk_txn_xid_set_root( pair->xid );
+  fd_funk_rec_key_copy( pair->key, key );
+  for(;;) {
+    fd_funk_rec_query_t query[1];
+    int err = fd_funk_rec_map_query_try( funk->rec_map, pair, NULL, query, 0 );
+    if( err == FD_MAP_SUCCESS )   return 1;
+    if( err == FD_MAP_ERR_KEY )   return 0;
+    if( err == FD_MAP_ERR_AGAIN ) continue;
+    FD_LOG_CRIT(( "query returned err %d", err ));
+  }
+}
+
+/* fd_funk_groove_private_is_shared returns 1 if an in-preparation
+   transaction has a version of the last published record rec. */
+
+static int
+fd_funk_groove_private_is_shared( fd_funk_t *           funk,
+                                  fd_funk_rec_t const * rec ) {
+  if( FD_LIKELY( !fd_funk_last_publish_is_frozen( funk ) ) ) return 0;
+
+  fd_funk_rec_map_shmem_t * rec_map = funk->rec_map->map;
+  ulong chain_idx = rec->map_hash & (rec_map->chain_cnt-1UL);
+  for( fd_funk_rec_map_iter_t iter = fd_funk_rec_map_iter( funk->rec_map, chain_idx );
+       !fd_funk_rec_map_iter_done( iter );
+       iter = fd_funk_rec_map_iter_next( iter ) ) {
+    fd_funk_rec_t const * ele = fd_funk_rec_map_iter_ele_const( iter );
+    if( ele!=rec && ele->map_hash==rec->map_hash && fd_funk_rec_key_eq( ele->pair.key, rec->pair.key ) ) return 1;
+  }
+  return 0;
+}
+
+ulong
+fd_funk_groove_align( void ) {
+  return FD_FUNK_GROOVE_ALIGN;
+}
+
+ulong
+fd_funk_groove_footprint( ulong ele_max ) {
+  if( FD_UNLIKELY( !fd_ulong_is_pow2( ele_max ) ) ) return 0UL;
+  ulong lock_cnt  = fd_groove_meta_map_lock_cnt_est ( ele_max );
+  ulong probe_max = fd_groove_meta_map_probe_max_est( ele_max );
+  ulong map_footprint = fd_groove_meta_map_footprint( ele_max, lock_cnt, probe_max );
+  if( FD_UNLIKELY( !map_footprint ) ) return 0UL;
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, FD_FUNK_GROOVE_ALIGN,          sizeof(fd_funk_groove_shmem_t)    );
+  l = FD_LAYOUT_APPEND( l, fd_groove_meta_map_align(),    map_footprint                     );
+  l = FD_LAYOUT_APPEND( l, alignof(fd_groove_meta_t),     ele_max*sizeof(fd_groove_meta_t)  );
+  l = FD_LAYOUT_APPEND( l, fd_groove_data_align(),        fd_groove_data_footprint()        );
+  return FD_LAYOUT_FINI( l, FD_FUNK_GROOVE_ALIGN );
+}
+
+void *
+fd_funk_groove_new( void * shmem,
+                    ulong  ele_max,
+                    ulong  seed ) {
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_funk_groove_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_funk_groove_footprint( ele_max );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad ele_max (%lu)", ele_max ));
+    return NULL;
+  }
+
+  ulong lock_cnt  = fd_groove_meta_map_lock_cnt_est ( ele_max );
+  ulong probe_max = fd_groove_meta_map_probe_max_est( ele_max );
+
+  FD_SCRATCH_ALLOC_INIT( l, shmem );
+  fd_funk_groove_shmem_t * groove = FD_SCRATCH_ALLOC_APPEND( l, FD_FUNK_GROOVE_ALIGN,      sizeof(fd_funk_groove_shmem_t)                               );
+  void *                   shmap  = FD_SCRATCH_ALLOC_APPEND( l, fd_groove_meta_map_align(), fd_groove_meta_map_footprint( ele_max, lock_cnt, probe_max ) );
+  fd_groove_meta_t *       shele  = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_groove_meta_t),  ele_max*sizeof(fd_groove_meta_t)                             );
+  void *                   shdata = FD_SCRATCH_ALLOC_APPEND( l, fd_groove_data_align(),     fd_groove_data_footprint()                                   );
+  FD_SCRATCH_ALLOC_FINI( l, FD_FUNK_GROOVE_ALIGN );
+
+  fd_memset( groove, 0, sizeof(fd_funk_groove_shmem_t) );
+  groove->ele_max   = ele_max;
+  groove->lock_cnt  = lock_cnt;
+  groove->probe_max = probe_max;
+  groove->map_off   = (ulong)shmap  - (ulong)shmem;
+  groove->ele_off   = (ulong)shele  - (ulong)shmem;
+  groove->data_off  = (ulong)shdata - (ulong)shmem;
+
+  /* The element store must be marked free before creating the map */
+
+  fd_memset( shele, 0, ele_max*sizeof(fd_groove_meta_t) );
+
+  if( FD_UNLIKELY( !fd_groove_meta_map_new( shmap, ele_max, lock_cnt, probe_max, seed ) ) ) {
+    FD_LOG_WARNING(( "fd_groove_meta_map_new failed" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_groove_data_new( shdata ) ) ) {
+    FD_LOG_WARNING(( "fd_groove_data_new failed" ));
+    fd_groove_meta_map_delete( shmap );
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( groove->magic ) = FD_FUNK_GROOVE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_funk_groove_t *
+fd_funk_groove_join( void *      ljoin,
+                     void *      shgroove,
+                     fd_funk_t * funk,
+                     void *      volume0,
+                     ulong       volume_max ) {
+  if( FD_UNLIKELY( !ljoin ) ) {
+    FD_LOG_WARNING(( "NULL ljoin" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)ljoin, alignof(fd_funk_groove_t) ) ) ) {
+    FD_LOG_WARNING(( "misaligned ljoin" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !shgroove ) ) {
+    FD_LOG_WARNING(( "NULL shgroove" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shgroove, fd_funk_groove_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shgroove" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !funk ) ) {
+    FD_LOG_WARNING(( "NULL funk" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( funk->rec_miss_fn ) ) {
+    FD_LOG_WARNING(( "funk join already has a record miss handler" ));
+    return NULL;
+  }
+
+  fd_funk_groove_shmem_t * shmem = (fd_funk_groove_shmem_t *)shgroove;
+  if( FD_UNLIKELY( shmem->magic!=FD_FUNK_GROOVE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  fd_funk_groove_t * join = (fd_funk_groove_t *)ljoin;
+
+  if( FD_UNLIKELY( !fd_groove_meta_map_join( join->meta_map, (uchar *)shmem + shmem->map_off, (uchar *)shmem + shmem->ele_off ) ) ) {
+    FD_LOG_WARNING(( "fd_groove_meta_map_join failed" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_groove_data_join( join->data, (uchar *)shmem + shmem->data_off, volume0, volume_max, fd_tile_idx() ) ) ) {
+    FD_LOG_WARNING(( "fd_groove_data_join failed" ));
+    fd_groove_meta_map_leave( join->meta_map );
+    return NULL;
+  }
+
+  join->shmem = shmem;
+  join->funk  = funk;
+
+  funk->rec_miss_ctx = join;
+  FD_COMPILER_MFENCE();
+  funk->rec_miss_fn  = fd_funk_groove_promote;
+
+  return join;
+}
+
+void *
+fd_funk_groove_leave( fd_funk_groove_t * join ) {
+  if( FD_UNLIKELY( !join ) ) {
+    FD_LOG_WARNING(( "NULL join" ));
+    return NULL;
+  }
+
+  join->funk->rec_miss_fn  = NULL;
+  FD_COMPILER_MFENCE();
+  join->funk->rec_miss_ctx = NULL;
+
+  fd_groove_data_leave( join->data );
+  fd_groove_meta_map_leave( join->meta_map );
+
+  return (void *)join;
+}
+
+void *
+fd_funk_groove_delete( void * shgroove ) {
+  if( FD_UNLIKELY( !shgroove ) ) {
+    FD_LOG_WARNING(( "NULL shgroove" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shgroove, fd_funk_groove_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shgroove" ));
+    return NULL;
+  }
+
+  fd_funk_groove_shmem_t * shmem = (fd_funk_groove_shmem_t *)shgroove;
+  if( FD_UNLIKELY( shmem->magic!=FD_FUNK_GROOVE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  fd_groove_data_delete    ( (uchar *)shmem + shmem->data_off );
+  fd_groove_meta_map_delete( (uchar *)shmem + shmem->map_off  );
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( shmem->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shgroove;
+}
+
+/* fd_funk_groove_private_meta_query looks up gkey in the meta map.
+   Returns 1 and copies the metadata into *out if found and 0
+   otherwise. */
+
+static int
+fd_funk_groove_private_meta_query( fd_funk_groove_t *      join,
+                                   fd_groove_key_t const * gkey,
+                                   fd_groove_meta_t *      out ) {
+  for(;;) {
+    fd_groove_meta_map_query_t query[1];
+    int err = fd_groove_meta_map_query_try( join->meta_map, gkey, NULL, query, FD_MAP_FLAG_BLOCKING );
+    if( err==FD_MAP_ERR_KEY ) return 0;
+    if( FD_UNLIKELY( err ) ) FD_LOG_CRIT(( "fd_groove_meta_map_query_try failed (%i-%s)", err, fd_groove_meta_map_strerror( err ) ));
+    *out = *fd_groove_meta_map_query_ele_const( query );
+    if( FD_LIKELY( fd_groove_meta_map_query_test( query )==FD_MAP_SUCCESS ) ) return 1;
+  }
+}
+
+int
+fd_funk_groove_promote( void *                    ctx,
+                        fd_funk_rec_key_t const * key ) {
+  fd_funk_groove_t * join = (fd_funk_groove_t *)ctx;
+  fd_funk_t *        funk = join->funk;
+
+  fd_groove_key_t  gkey[1]; fd_funk_groove_private_key( gkey, key );
+  fd_groove_meta_t meta[1];
+
+  /* Fast path for keys that are not demoted (e.g. creating a new
+     record).  A concurrent promotion of key inserts key into funk
+     before removing it from the meta map, so checking funk after the
+     meta map misses tells if key got promoted in the meantime. */
+
+  if( FD_LIKELY( !fd_funk_groove_private_meta_query( join, gkey, meta ) ) ) return fd_funk_groove_private_root_has( funk, key );
+
+  /* Promotions of the same key are serialized on the lock of the last
+     published transaction.  Somebody else might have gotten here
+     first. */
+
+  uchar * lock = &funk->shmem->lock;
+  while( FD_ATOMIC_CAS( lock, 0, 1 ) ) FD_SPIN_PAUSE();
+
+  if( FD_UNLIKELY( fd_funk_groove_private_root_has( funk, key ) ) ) {
+    FD_VOLATILE( *lock ) = 0;
+    return 1;
+  }
+
+  fd_funk_groove_obj_t * obj = NULL;
+  if( FD_LIKELY( fd_funk_groove_private_meta_query( join, gkey, meta ) ) ) {
+    obj = fd_funk_groove_private_obj( join, meta->val_off );
+    if( FD_UNLIKELY( !fd_funk_rec_key_eq( &obj->key, key ) ) ) obj = NULL; /* groove key collision */
+  }
+  if( FD_UNLIKELY( !obj ) ) {
+    FD_VOLATILE( *lock ) = 0;
+    return 0;
+  }
+
+  /* Recreate the record in the last published transaction.  This
+     mirrors fd_funk_rec_prepare / fd_funk_rec_publish (minus the frozen
+     check as this does not change the contents of the last published
+     transaction from the application's point of view). */
+
+  int err;
+  fd_funk_rec_t * rec = fd_funk_rec_pool_acquire( funk->rec_pool, NULL, 1, &err );
+  if( FD_UNLIKELY( !rec ) ) FD_LOG_ERR(( "funk rec pool exhausted while promoting a record (%i)", err ));
+
+  ulong val_sz = obj->val_sz;
+
+  fd_funk_txn_xid_set_root( rec->pair.xid );
+  fd_funk_rec_key_copy( rec->pair.key, key );
+  rec->txn_cidx = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
+  rec->tag      = 0;
+  rec->flags    = obj->flags;
+  fd_funk_val_init( rec );
+  if( FD_LIKELY( val_sz ) ) {
+    void * val = fd_funk_val_truncate( rec, val_sz, funk->alloc, funk->wksp, &err );
+    if( FD_UNLIKELY( !val ) ) FD_LOG_ERR(( "fd_funk_val_truncate failed while promoting a record (%i-%s)", err, fd_funk_strerror( err ) ));
+    fd_memcpy( val, obj+1, val_sz );
+  }
+
+  uint rec_idx      = (uint)( rec - funk->rec_pool->ele );
+  uint rec_prev_idx = funk->shmem->rec_tail_idx;
+  rec->prev_idx = rec_prev_idx;
+  rec->next_idx = FD_FUNK_REC_IDX_NULL;
+  if( fd_funk_rec_idx_is_null( rec_prev_idx ) ) funk->shmem->rec_head_idx                    = rec_idx;
+  else                                          funk->rec_pool->ele[ rec_prev_idx ].next_idx = rec_idx;
+  funk->shmem->rec_tail_idx = rec_idx;
+
+  if( FD_UNLIKELY( fd_funk_rec_map_insert( funk->rec_map, rec, FD_MAP_FLAG_BLOCKING ) ) ) {
+    FD_LOG_CRIT(( "fd_funk_rec_map_insert failed" ));
+  }
+
+  /* Only now that key is visible in funk, drop it from groove */
+
+  err = fd_groove_meta_map_remove( join->meta_map, gkey, NULL, FD_MAP_FLAG_BLOCKING );
+  if( FD_UNLIKELY( err ) ) FD_LOG_CRIT(( "fd_groove_meta_map_remove failed (%i-%s)", err, fd_groove_meta_map_strerror( err ) ));
+
+  FD_VOLATILE( *lock ) = 0;
+
+  err = fd_groove_data_free( join->data, obj );
+  if( FD_UNLIKELY( err ) ) FD_LOG_CRIT(( "fd_groove_data_free failed (%i-%s)", err, fd_groove_strerror( err ) ));
+
+  fd_funk_cold_metrics_t * metrics = funk->shmem->cold;
+  FD_ATOMIC_FETCH_AND_ADD( &metrics->promote_cnt,      1UL    );
+  FD_ATOMIC_FETCH_AND_ADD( &metrics->promote_byte_cnt, val_sz );
+  FD_ATOMIC_FETCH_AND_SUB( &metrics->rec_cnt,          1UL    );
+
+  return 1;
+}
+
+/* fd_funk_groove_private_demote_rec demotes the last published record
+   rec.  Returns FD_GROOVE_SUCCESS on success, FD_GROOVE_ERR_KEY if rec
+   cannot be demoted and FD_GROOVE_ERR_FULL if groove is out of space. */
+
+static int
+fd_funk_groove_private_demote_rec( fd_funk_groove_t * join,
+                                   fd_funk_rec_t *    rec ) {
+  fd_funk_t * funk = join->funk;
+
+  if( FD_UNLIKELY( rec->flags & FD_FUNK_REC_FLAG_ERASE ) ) return FD_GROOVE_ERR_KEY;
+  if( FD_UNLIKELY( fd_funk_groove_private_is_shared( funk, rec ) ) ) return FD_GROOVE_ERR_KEY;
+
+  ulong val_sz = rec->val_sz;
+  if( FD_UNLIKELY( val_sz>FD_FUNK_GROOVE_VAL_MAX ) ) return FD_GROOVE_ERR_KEY;
+
+  int err;
+  fd_funk_groove_obj_t * obj = fd_groove_data_alloc( join->data, 0UL, sizeof(fd_funk_groove_obj_t)+val_sz, fd_funk_wksp_tag( funk ), &err );
+  if( FD_UNLIKELY( !obj ) ) return FD_GROOVE_ERR_FULL;
+
+  fd_funk_rec_key_copy( &obj->key, rec->pair.key );
+  obj->flags  = rec->flags;
+  obj->val_sz = val_sz;
+  if( FD_LIKELY( val_sz ) ) fd_memcpy( obj+1, fd_funk_val( rec, funk->wksp ), val_sz );
+
+  fd_groove_key_t gkey[1]; fd_funk_groove_private_key( gkey, rec->pair.key );
+
+  fd_groove_meta_map_query_t query[1];
+  err = fd_groove_meta_map_prepare( join->meta_map, gkey, NULL, query, FD_MAP_FLAG_BLOCKING );
+  if( FD_UNLIKELY( err ) ) {
+    fd_groove_data_free( join->data, obj );
+    if( FD_LIKELY( err==FD_MAP_ERR_FULL ) ) return FD_GROOVE_ERR_FULL;
+    FD_LOG_CRIT(( "fd_groove_meta_map_prepare failed (%i-%s)", err, fd_groove_meta_map_strerror( err ) ));
+  }
+
+  fd_groove_meta_t * ele = fd_groove_meta_map_query_ele( query );
+  int replace = fd_groove_meta_bits_used( ele->bits );
+  if( FD_UNLIKELY( replace ) ) {
+    fd_funk_groove_obj_t * old = fd_funk_groove_private_obj( join, ele->val_off );
+    if( FD_UNLIKELY( !fd_funk_rec_key_eq( &old->key, rec->pair.key ) ) ) { /* groove key collision */
+      fd_groove_meta_map_cancel( query );
+      fd_groove_data_free( join->data, obj );
+      return FD_GROOVE_ERR_KEY;
+    }
+    /* A stale copy of this record (should not happen as records are
+       faulted in before they get modified) */
+    fd_groove_data_free( join->data, old );
+  }
+
+  ele->key     = *gkey;
+  ele->bits    = fd_groove_meta_bits( 1, 1, 0, val_sz, val_sz );
+  ele->val_off = (ulong)obj - (ulong)fd_groove_data_volume0( join->data );
+  fd_groove_meta_map_publish( query );
+
+  /* The miss handler sees the record is still in funk and leaves it
+     alone here */
+
+  fd_funk_rec_hard_remove( funk, NULL, &obj->key );
+
+  fd_funk_cold_metrics_t * metrics = funk->shmem->cold;
+  FD_ATOMIC_FETCH_AND_ADD( &metrics->demote_cnt,      1UL    );
+  FD_ATOMIC_FETCH_AND_ADD( &metrics->demote_byte_cnt, val_sz );
+  if( FD_LIKELY( !replace ) ) FD_ATOMIC_FETCH_AND_ADD( &metrics->rec_cnt, 1UL );
+
+  return FD_GROOVE_SUCCESS;
+}
+
+ulong
+fd_funk_groove_demote( fd_funk_groove_t * join,
+                       ulong              demote_max ) {
+  fd_funk_t *              funk    = join->funk;
+  fd_funk_cold_metrics_t * metrics = funk->shmem->cold;
+
+  ulong demote_cnt = 0UL;
+  uint  rec_idx    = funk->shmem->rec_head_idx;
+  while( demote_cnt<demote_max && !fd_funk_rec_idx_is_null( rec_idx ) ) {
+    fd_funk_rec_t * rec = funk->rec_pool->ele + rec_idx;
+    rec_idx = rec->next_idx;
+
+    int err = fd_funk_groove_private_demote_rec( join, rec );
+    if( FD_LIKELY( !err ) ) { demote_cnt++; continue; }
+    FD_ATOMIC_FETCH_AND_ADD( &metrics->demote_skip_cnt, 1UL );
+    if( err==FD_GROOVE_ERR_FULL ) break;
+  }
+
+  return demote_cnt;
+}
+
+ulong
+fd_funk_groove_promote_all( fd_funk_groove_t * join ) {
+  fd_groove_meta_t * ele     = (fd_groove_meta_t *)fd_groove_meta_map_shele( join->meta_map );
+  ulong              ele_max = fd_groove_meta_map_ele_max( join->meta_map );
+
+  /* Promoting a key can move other keys around in the meta map, so
+     rescan until there is nothing left. */
+
+  ulong promote_cnt = 0UL;
+  for(;;) {
+    ulong pass_cnt = 0UL;
+    for( ulong ele_idx=0UL; ele_idx<ele_max; ele_idx++ ) {
+      while( fd_groove_meta_bits_used( ele[ ele_idx ].bits ) ) {
+        fd_funk_groove_obj_t * obj = fd_funk_groove_private_obj( join, ele[ ele_idx ].val_off );
+        if( FD_UNLIKELY( !fd_funk_groove_promote( join, &obj->key ) ) ) FD_LOG_CRIT(( "failed to promote a demoted record" ));
+        pass_cnt++;
+      }
+    }
+    if( !pass_cnt ) break;
+    promote_cnt += pass_cnt;
+  }
+  return promote_cnt;
+}
+
+void *
+fd_funk_groove_volume_map( char const * path,
+                           ulong        volume_cnt ) {
+  if( FD_UNLIKELY( !path ) ) {
+    FD_LOG_WARNING(( "NULL path" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !volume_cnt || volume_cnt>(ULONG_MAX/FD_GROOVE_VOLUME_FOOTPRINT) ) ) {
+    FD_LOG_WARNING(( "bad volume_cnt (%lu)", volume_cnt ));
+    return NULL;
+  }
+
+  ulong sz = volume_cnt*FD_GROOVE_VOLUME_FOOTPRINT;
+
+  int fd = open( path, O_RDWR|O_CREAT, 0600 );
+  if( FD_UNLIKELY( fd<0 ) ) {
+    FD_LOG_WARNING(( "open(%s) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( ftruncate( fd, (off_t)sz )<0 ) ) {
+    FD_LOG_WARNING(( "ftruncate(%s,%lu) failed (%i-%s)", path, sz, errno, fd_io_strerror( errno ) ));
+    close( fd );
+    return NULL;
+  }
+
+  /* mmap is page aligned, which satisfies FD_GROOVE_VOLUME_ALIGN */
+
+  void * volume0 = mmap( NULL, sz, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0 );
+  if( FD_UNLIKELY( volume0==MAP_FAILED ) ) {
+    FD_LOG_WARNING(( "mmap(%s,%lu) failed (%i-%s)", path, sz, errno, fd_io_strerror( errno ) ));
+    close( fd );
+    return NULL;
+  }
+
+  /* The mapping keeps the file open */
+
+  if( FD_UNLIKELY( close( fd ) ) ) FD_LOG_WARNING(( "close(%s) failed (%i-%s); attempting to continue", path, errno, fd_io_strerror( errno ) ));
+
+  return volume0;
+}
+
+void
+fd_funk_groove_volume_unmap( void * volume0,
+                             ulong  volume_cnt ) {
+  if( FD_UNLIKELY( !volume0 ) ) return;
+  if( FD_UNLIKELY( munmap( volume0, volume_cnt*FD_GROOVE_VOLUME_FOOTPRINT ) ) ) {
+    FD_LOG_WARNING(( "munmap failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  }
+}
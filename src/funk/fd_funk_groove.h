@@ -0,0 +1,201 @@
+#ifndef HEADER_fd_src_funk_fd_funk_groove_h
+#define HEADER_fd_src_funk_fd_funk_groove_h
+
+/* fd_funk_groove is a cold tier for the records of the last published
+   transaction of a funk.  Funk keeps every record value in wksp memory.
+   A funk groove moves ("demotes") the coldest published records into a
+   groove data store (see ../groove/fd_groove.h) and moves them back
+   ("promotes") into funk the first time they are looked up again.  When
+   the groove volumes are memory mapped files on fast storage, the
+   kernel writes demoted values back asynchronously and is free to evict
+   them from the page cache, so the total record set can exceed the
+   memory available to funk.
+
+   A record lives in exactly one tier at a time.  A demoted record is
+   removed from funk and a promoted record is removed from groove.
+
+   Promotion is transparent to funk users.  Joining a funk groove
+   installs a record miss handler into the given funk join (see
+   fd_funk_rec_miss_fn_t).  fd_funk_rec_query_try (on the last
+   published transaction), fd_funk_rec_query_try_global and friends
+   call it when a key is not found, and the handler faults the record
+   back in.  Promotion is safe to do concurrently from many threads.
+   As such, every funk join that queries records must also join the
+   funk groove.  A funk join without a miss handler cannot tell a
+   demoted record from a missing one, so a lookup miss in the last
+   published transaction (or iterating over it) on such a join while
+   any record is demoted is treated as unrecoverable (FD_LOG_CRIT)
+   rather than silently returning a wrong answer.
+
+   Demotion is a transaction level operation (it has the same
+   concurrency requirements as fd_funk_txn_publish).  Only records of
+   the last published transaction that have no version in any
+   in-preparation transaction are demoted.  Records are demoted oldest
+   first in the order they got published into the last published
+   transaction (promoted records count as just published).
+
+   IMPORTANT SAFETY TIP!  Iterating over the records of the last
+   published transaction (e.g. fd_funk_all_iter) does not see demoted
+   records.  Use fd_funk_groove_promote_all first.  For the same reason,
+   fd_funk_txn_first_rec on the last published transaction is fatal
+   while any record is demoted.
+
+   IMPORTANT SAFETY TIP!  Groove keys are 32 bytes while funk record
+   keys are 40 bytes.  The last 16 bytes of the funk record key are
+   hashed into the last 8 bytes of the groove key.  A funk record whose
+   groove key collides with the groove key of a record already demoted
+   is not demoted. */
+
+#include "fd_funk.h"
+#include "../groove/fd_groove.h"
+
+/* FD_FUNK_GROOVE_{ALIGN,MAGIC} give the alignment and magic number of
+   the shared state of a funk groove. */
+
+#define FD_FUNK_GROOVE_ALIGN (128UL)
+#define FD_FUNK_GROOVE_MAGIC (0xf17eda2ce7960000UL) /* Firedancer funk groove version 0 */
+
+struct fd_funk_groove_shmem_private;
+typedef struct fd_funk_groove_shmem_private fd_funk_groove_shmem_t;
+
+/* The details of a fd_funk_groove_private are exposed here to allow
+   declaring local joins on the stack. */
+
+struct fd_funk_groove_private {
+  fd_funk_groove_shmem_t * shmem;
+  fd_funk_t *              funk;
+  fd_groove_meta_map_t     meta_map[1];
+  fd_groove_data_t         data[1];
+};
+
+typedef struct fd_funk_groove_private fd_funk_groove_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_funk_groove_{align,footprint} return the alignment and footprint
+   of a memory region suitable for holding the shared state of a funk
+   groove that can hold up to ele_max demoted records.  ele_max should
+   be an integer power of two.  footprint returns 0 on bad ele_max.
+
+   fd_funk_groove_new formats such a memory region.  seed is an
+   arbitrary hash seed.  Returns shmem on success and NULL on failure
+   (logs details).  The funk groove has no groove volumes and holds no
+   records on return.
+
+   fd_funk_groove_join joins the funk groove at shgroove.  ljoin points
+   to a fd_funk_groove_t compatible memory region in the caller's
+   address space used to hold the local join's state.  funk is the
+   caller's current local join of the funk to tier.  volume0 points to
+   the caller's address space range reserved for mapping up to
+   volume_max groove volumes (see fd_groove_data_join).  On success,
+   installs the miss handler into funk and returns the local join.
+   Returns NULL on failure (logs details).  Every funk join that queries
+   the last published transaction must be paired with a funk groove
+   join.
+
+   fd_funk_groove_leave uninstalls the miss handler from the funk join
+   and leaves the funk groove.  Returns ljoin on success and NULL on
+   failure (logs details).
+
+   fd_funk_groove_delete unformats the memory region used as a funk
+   groove.  Assumes nobody is joined.  Any records still demoted are
+   lost.  Returns shgroove on success and NULL on failure (logs
+   details). */
+
+FD_FN_CONST ulong
+fd_funk_groove_align( void );
+
+FD_FN_CONST ulong
+fd_funk_groove_footprint( ulong ele_max );
+
+void *
+fd_funk_groove_new( void * shmem,
+                    ulong  ele_max,
+                    ulong  seed );
+
+fd_funk_groove_t *
+fd_funk_groove_join( void *      ljoin,
+                     void *      shgroove,
+                     fd_funk_t * funk,
+                     void *      volume0,
+                     ulong       volume_max );
+
+void *
+fd_funk_groove_leave( fd_funk_groove_t * join );
+
+void *
+fd_funk_groove_delete( void * shgroove );
+
+/* fd_funk_groove_data returns the groove data store of a funk groove
+   join.  Use fd_groove_data_volume_add on it to give the funk groove
+   storage (e.g. volumes mapped with fd_funk_groove_volume_map). */
+
+FD_FN_PURE static inline fd_groove_data_t *
+fd_funk_groove_data( fd_funk_groove_t * join ) {
+  return join->data;
+}
+
+/* fd_funk_groove_metrics returns the cold tier counters of the funk of
+   a funk groove (see fd_funk_cold_metrics).  The counters live in the
+   funk such that any funk join can report them.  The lifetime of the
+   returned pointer is the lifetime of the join. */
+
+FD_FN_PURE static inline fd_funk_cold_metrics_t const *
+fd_funk_groove_metrics( fd_funk_groove_t const * join ) {
+  return fd_funk_cold_metrics( join->funk );
+}
+
+/* fd_funk_groove_demote demotes up to demote_max of the oldest records
+   of the last published transaction into groove.  Returns the number of
+   records demoted.  Erased records (tombstones) and records with a
+   version in an in-preparation transaction are never demoted.
+   Demotion stops early if groove runs out of space or metadata slots.
+
+   This is a transaction level operation.  The caller promises that no
+   other thread is operating on funk and that no pointers to values of
+   records of the last published transaction are held. */
+
+ulong
+fd_funk_groove_demote( fd_funk_groove_t * join,
+                       ulong              demote_max );
+
+/* fd_funk_groove_promote promotes the record with key into the last
+   published transaction of funk if it is demoted.  Returns 1 if key is
+   a record of the last published transaction on return and 0 otherwise.
+   This is the miss handler installed by fd_funk_groove_join (ctx is the
+   join) and does not normally need to be called directly.  Safe to call
+   concurrently. */
+
+int
+fd_funk_groove_promote( void *                    ctx,
+                        fd_funk_rec_key_t const * key );
+
+/* fd_funk_groove_promote_all promotes all demoted records.  Returns the
+   number of records promoted.  Same concurrency requirements as
+   fd_funk_groove_demote. */
+
+ulong
+fd_funk_groove_promote_all( fd_funk_groove_t * join );
+
+/* fd_funk_groove_volume_map maps volume_cnt groove volumes backed by
+   the file at path (created if needed and resized to hold exactly
+   volume_cnt volumes) into the caller's address space.  Returns the
+   location of the first volume on success, suitable for use as volume0
+   in fd_funk_groove_join, and NULL on failure (logs details).  The
+   volumes are not added to any groove.  Writes to the volumes are
+   written back to the file by the kernel asynchronously.
+
+   fd_funk_groove_volume_unmap unmaps volumes mapped by
+   fd_funk_groove_volume_map. */
+
+void *
+fd_funk_groove_volume_map( char const * path,
+                           ulong        volume_cnt );
+
+void
+fd_funk_groove_volume_unmap( void * volume0,
+                             ulong  volume_cnt );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_funk_fd_funk_groove_h */
@@ -23,6 +23,24 @@
 #define MAP_IMPL_STYLE        2
 #include "../util/tmpl/fd_map_chain_para.c"
 
+/* fd_funk_rec_private_miss is called when key is not found in the last
+   published transaction.  Returns 1 if the miss handler of this join
+   faulted key in (the lookup should be retried) and 0 if key is not a
+   record of the last published transaction.  A join without a miss
+   handler cannot tell the two apart while records are demoted, which is
+   treated as unrecoverable instead of silently reporting a miss. */
+
+static int
+fd_funk_rec_private_miss( fd_funk_t const *         funk,
+                          fd_funk_rec_key_t const * key ) {
+  if( FD_UNLIKELY( funk->rec_miss_fn ) ) return funk->rec_miss_fn( funk->rec_miss_ctx, key );
+  if( FD_UNLIKELY( FD_VOLATILE_CONST( funk->shmem->cold->rec_cnt ) ) ) {
+    FD_LOG_CRIT(( "record lookup missed on a funk join without a record miss handler while %lu records are demoted",
+                  FD_VOLATILE_CONST( funk->shmem->cold->rec_cnt ) ));
+  }
+  return 0;
+}
+
 fd_funk_rec_t const *
 fd_funk_rec_query_try( fd_funk_t *               funk,
                        fd_funk_txn_t const *     txn,
@@ -47,7 +65,10 @@ fd_funk_rec_query_try( fd_funk_t *               funk,
   for(;;) {
     int err = fd_funk_rec_map_query_try( funk->rec_map, pair, NULL, query, 0 );
     if( err == FD_MAP_SUCCESS )   break;
-    if( err == FD_MAP_ERR_KEY )   return NULL;
+    if( err == FD_MAP_ERR_KEY ) {
+      if( FD_UNLIKELY( !txn ) && fd_funk_rec_private_miss( funk, key ) ) continue;
+      return NULL;
+    }
     if( err == FD_MAP_ERR_AGAIN ) continue;
     FD_LOG_CRIT(( "query returned err %d", err ));
   }
@@ -91,34 +112,60 @@ fd_funk_rec_query_try_global( fd_funk_t const *         funk,
   query->chain   = chain;
   query->ver_cnt = chain->ver_cnt; /* After unlock */
 
+  fd_funk_txn_t const * txn_ele = funk->txn_pool->ele;
+
   for( fd_funk_rec_map_iter_t iter = fd_funk_rec_map_iter( funk->rec_map, chain_idx );
        !fd_funk_rec_map_iter_done( iter );
        iter = fd_funk_rec_map_iter_next( iter ) ) {
     fd_funk_rec_t const * ele = fd_funk_rec_map_iter_ele_const( iter );
     if( FD_LIKELY( hash == ele->map_hash ) && FD_LIKELY( fd_funk_rec_key_eq( key, ele->pair.key ) ) ) {
 
-      /* For cur_txn in path from [txn] to [root] where root is NULL */
-
-      for( fd_funk_txn_t const * cur_txn = txn; ; cur_txn = fd_funk_txn_parent( cur_txn, funk->txn_pool ) ) {
-        /* If record ele is part of transaction cur_txn, we have a
-           match. According to the property above, this will be the
-           youngest descendent in the transaction stack. */
-
-        int match = FD_UNLIKELY( cur_txn ) ? /* opt for root find (FIXME: eliminate branch with cmov into txn_xid_eq?) */
-          fd_funk_txn_xid_eq( &cur_txn->xid, ele->pair.xid ) :
-          fd_funk_txn_xid_eq_root( ele->pair.xid );
-
-        if( FD_LIKELY( match ) ) {
-          if( txn_out ) *txn_out = cur_txn;
-          query->ele = ( FD_UNLIKELY( ele->flags & FD_FUNK_REC_FLAG_ERASE ) ? NULL :
-                         (fd_funk_rec_t *)ele );
-          return query->ele;
+      /* Records are matched to transactions by their compressed
+         transaction index (updated atomically) rather than their xid
+         (updated non-atomically when a transaction is published).  A
+         concurrent publish moves the records of a transaction into its
+         parent (or the last published transaction) before it reparents
+         the transaction's children.  So if ele did not match anything
+         on the path but its txn_cidx changed meanwhile, the path we
+         walked might have been the post-publish one while the txn_cidx
+         we compared against was the pre-publish one and we retry. */
+
+      for(;;) {
+        uint ele_txn_cidx = FD_VOLATILE_CONST( ele->txn_cidx );
+        FD_COMPILER_MFENCE();
+
+        /* For cur_txn in path from [txn] to [root] where root is NULL */
+
+        for( fd_funk_txn_t const * cur_txn = txn; ; cur_txn = fd_funk_txn_parent( cur_txn, funk->txn_pool ) ) {
+          /* If record ele is part of transaction cur_txn, we have a
+             match. According to the property above, this will be the
+             youngest descendent in the transaction stack. */
+
+          ulong cur_txn_idx = FD_UNLIKELY( cur_txn ) ? (ulong)(cur_txn - txn_ele) : FD_FUNK_TXN_IDX_NULL;
+
+          if( FD_LIKELY( fd_funk_txn_idx( ele_txn_cidx )==cur_txn_idx ) ) {
+            if( txn_out ) *txn_out = cur_txn;
+            query->ele = ( FD_UNLIKELY( ele->flags & FD_FUNK_REC_FLAG_ERASE ) ? NULL :
+                           (fd_funk_rec_t *)ele );
+            return query->ele;
+          }
+
+          if( cur_txn == NULL ) break;
         }
 
-        if( cur_txn == NULL ) break;
+        FD_COMPILER_MFENCE();
+        if( FD_LIKELY( FD_VOLATILE_CONST( ele->txn_cidx )==ele_txn_cidx ) ) break;
       }
     }
   }
+
+  /* key is not in txn or any of its ancestors.  Give the miss handler
+     (if any) a chance to fault key into the last published
+     transaction. */
+
+  if( fd_funk_rec_private_miss( funk, key ) ) {
+    return fd_funk_rec_query_try_global( funk, txn, key, txn_out, query );
+  }
   return NULL;
 }
 
@@ -142,6 +189,7 @@ fd_funk_rec_query_copy( fd_funk_t *               funk,
     fd_funk_rec_query_t query[1];
     int err = fd_funk_rec_map_query_try( funk->rec_map, pair, NULL, query, 0 );
     if( err == FD_MAP_ERR_KEY )   {
+      if( FD_UNLIKELY( !txn ) && fd_funk_rec_private_miss( funk, key ) ) continue;
       if( last_copy ) fd_valloc_free( valloc, last_copy );
       return NULL;
     }
@@ -196,6 +244,15 @@ fd_funk_rec_prepare( fd_funk_t *               funk,
     }
   }
 
+  if( FD_UNLIKELY( funk->rec_miss_fn ) ) {
+    /* Make sure a version of key in the last published transaction
+       that is held by the miss handler is faulted in before a younger
+       version gets inserted ahead of it in the hash chain (see
+       fd_funk_rec_query_try_global). */
+    fd_funk_rec_query_t query[1];
+    fd_funk_rec_query_try( funk, NULL, key, query );
+  }
+
   fd_funk_rec_t * rec = prepare->rec = fd_funk_rec_pool_acquire( funk->rec_pool, NULL, 1, opt_err );
   if( opt_err && *opt_err == FD_POOL_ERR_CORRUPT ) {
     FD_LOG_ERR(( "corrupt element returned from funk rec pool" ));
@@ -308,6 +365,13 @@ fd_funk_rec_hard_remove( fd_funk_t *               funk,
   }
   fd_funk_rec_key_copy( pair->key, key );
 
+  if( FD_UNLIKELY( !txn && funk->rec_miss_fn ) ) {
+    /* Fault key in (if the miss handler holds it) such that it is
+       removed for good */
+    fd_funk_rec_query_t query[1];
+    fd_funk_rec_query_try( funk, NULL, key, query );
+  }
+
   uchar * lock = NULL;
   if( txn==NULL ) {
     lock = &funk->shmem->lock;
@@ -387,7 +451,10 @@ fd_funk_rec_remove( fd_funk_t *               funk,
   for(;;) {
     int err = fd_funk_rec_map_query_try( funk->rec_map, pair, NULL, query, 0 );
     if( err == FD_MAP_SUCCESS )   break;
-    if( err == FD_MAP_ERR_KEY )   return FD_FUNK_ERR_KEY;
+    if( err == FD_MAP_ERR_KEY ) {
+      if( FD_UNLIKELY( !txn ) && fd_funk_rec_private_miss( funk, key ) ) continue;
+      return FD_FUNK_ERR_KEY;
+    }
     if( err == FD_MAP_ERR_AGAIN ) continue;
     FD_LOG_CRIT(( "query returned err %d", err ));
   }
@@ -489,6 +556,9 @@ fd_funk_all_iter_skip_nulls( fd_funk_all_iter_t * iter ) {
 
 void
 fd_funk_all_iter_new( fd_funk_t * funk, fd_funk_all_iter_t * iter ) {
+  if( FD_UNLIKELY( !funk->rec_miss_fn && FD_VOLATILE_CONST( funk->shmem->cold->rec_cnt ) ) ) {
+    FD_LOG_CRIT(( "iterating over a funk join without a record miss handler while records are demoted" ));
+  }
   iter->rec_map      = *funk->rec_map;
   iter->chain_cnt    = fd_funk_rec_map_chain_cnt( &iter->rec_map );
   iter->chain_idx    = 0;
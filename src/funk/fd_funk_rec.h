@@ -31,7 +31,11 @@
    - ERASE indicates a record in an in-preparation transaction should be
    erased if and when the in-preparation transaction is published. If
    set on a published record, it serves as a tombstone.
-   If set, there will be no value resources used by this record. */
+   If set, there will be no value resources used by this record.
+
+   Bits 1 through 23 are not used by funk.  Users can keep their own
+   per record state there (e.g. FD_ACC_REC_FLAG_*); new records start
+   with all flags clear. */
 
 #define FD_FUNK_REC_FLAG_ERASE (1UL<<0)
 
@@ -74,6 +78,8 @@ struct __attribute__((aligned(FD_FUNK_REC_ALIGN))) fd_funk_rec {
                       has tag wksp_tag) and the owner of the region will be the record. The allocator is
                       fd_funk_alloc(). IMPORTANT! HAS NO GUARANTEED ALIGNMENT! */
 
+  ulong retire_epoch; /* Internal use by funk for deferred reclamation */
+
   /* Padding to FD_FUNK_REC_ALIGN here */
 };
 
@@ -192,6 +198,13 @@ int fd_funk_rec_query_test( fd_funk_rec_query_t * query );
 
    This is reasonably fast O(in_prep_ancestor_cnt).
 
+   This can be run inside a read section (see fd_funk_read_begin)
+   concurrently with transaction level operations that do not publish or
+   cancel txn itself.  E.g. a query on a descendant of a transaction
+   being published will observe the records of the transaction either
+   before or after they got merged into the last published transaction
+   but will not miss them.
+
    Important safety tip!  This function can encounter records
    that have the ERASE flag set (i.e. are tombstones of erased
    records). fd_funk_rec_query_try_global will return a NULL in this case
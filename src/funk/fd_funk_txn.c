@@ -45,6 +45,103 @@ fd_funk_txn_end_write( fd_funk_t * funk FD_PARAM_UNUSED ) {
   fd_rwlock_unwrite( funk_txn_lock );
 }
 
+/* fd_funk_{rec,txn}_retire append a record / transaction that was
+   just removed from its map to the corresponding limbo list (see
+   fd_funk_read_begin).  The element keeps its map_next, xid and
+   txn_cidx intact such that concurrent read sections that are
+   traversing it are unaffected.  It is released by fd_funk_reclaim
+   once no read section can observe it anymore. */
+
+static void
+fd_funk_rec_retire( fd_funk_t *     funk,
+                    fd_funk_rec_t * rec ) {
+  fd_funk_shmem_t * shmem   = funk->shmem;
+  fd_funk_rec_t *   rec_ele = funk->rec_pool->ele;
+  uint              rec_idx = (uint)(rec - rec_ele);
+
+  rec->retire_epoch = shmem->epoch;
+  rec->next_idx     = FD_FUNK_REC_IDX_NULL;
+
+  if( fd_funk_rec_idx_is_null( shmem->rec_limbo_tail_idx ) ) shmem->rec_limbo_head_idx                        = rec_idx;
+  else                                                       rec_ele[ shmem->rec_limbo_tail_idx ].next_idx = rec_idx;
+  shmem->rec_limbo_tail_idx = rec_idx;
+}
+
+static void
+fd_funk_txn_retire( fd_funk_t *     funk,
+                    fd_funk_txn_t * txn ) {
+  fd_funk_shmem_t * shmem   = funk->shmem;
+  fd_funk_txn_t *   txn_ele = funk->txn_pool->ele;
+  ulong             txn_idx = (ulong)(txn - txn_ele);
+
+  txn->retire_epoch = shmem->epoch;
+  txn->stack_cidx   = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
+
+  ulong tail_idx = fd_funk_txn_idx( shmem->txn_limbo_tail_cidx );
+  if( fd_funk_txn_idx_is_null( tail_idx ) ) shmem->txn_limbo_head_cidx          = fd_funk_txn_cidx( txn_idx );
+  else                                      txn_ele[ tail_idx ].stack_cidx = fd_funk_txn_cidx( txn_idx );
+  shmem->txn_limbo_tail_cidx = fd_funk_txn_cidx( txn_idx );
+}
+
+ulong
+fd_funk_reclaim( fd_funk_t * funk ) {
+  fd_funk_shmem_t * shmem = funk->shmem;
+
+  if( FD_LIKELY( fd_funk_rec_idx_is_null( shmem->rec_limbo_head_idx ) &&
+                 fd_funk_txn_idx_is_null( fd_funk_txn_idx( shmem->txn_limbo_head_cidx ) ) ) ) return 0UL;
+
+  /* Find the epoch of the oldest active read section.  Everything
+     retired before that is unreachable. */
+
+  ulong safe_epoch = ULONG_MAX;
+  for( ulong reader_idx=0UL; reader_idx<FD_FUNK_READER_MAX; reader_idx++ ) {
+    safe_epoch = fd_ulong_min( safe_epoch, FD_VOLATILE_CONST( shmem->reader_epoch[ reader_idx ] ) );
+  }
+  FD_COMPILER_MFENCE();
+
+  ulong release_cnt = 0UL;
+
+  fd_funk_rec_t * rec_ele = funk->rec_pool->ele;
+  uint            rec_idx = shmem->rec_limbo_head_idx;
+  while( !fd_funk_rec_idx_is_null( rec_idx ) ) {
+    fd_funk_rec_t * rec = &rec_ele[ rec_idx ];
+    if( rec->retire_epoch>=safe_epoch ) break;
+    uint next_idx = rec->next_idx;
+    rec->txn_cidx = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
+    fd_funk_val_flush( rec, funk->alloc, funk->wksp );
+    fd_funk_rec_pool_release( funk->rec_pool, rec, 1 );
+    release_cnt++;
+    rec_idx = next_idx;
+  }
+  shmem->rec_limbo_head_idx = rec_idx;
+  if( fd_funk_rec_idx_is_null( rec_idx ) ) shmem->rec_limbo_tail_idx = FD_FUNK_REC_IDX_NULL;
+
+  fd_funk_txn_t * txn_ele = funk->txn_pool->ele;
+  ulong           txn_idx = fd_funk_txn_idx( shmem->txn_limbo_head_cidx );
+  while( !fd_funk_txn_idx_is_null( txn_idx ) ) {
+    fd_funk_txn_t * txn = &txn_ele[ txn_idx ];
+    if( txn->retire_epoch>=safe_epoch ) break;
+    ulong next_idx = fd_funk_txn_idx( txn->stack_cidx );
+    fd_funk_txn_pool_release( funk->txn_pool, txn, 1 );
+    release_cnt++;
+    txn_idx = next_idx;
+  }
+  shmem->txn_limbo_head_cidx = fd_funk_txn_cidx( txn_idx );
+  if( fd_funk_txn_idx_is_null( txn_idx ) ) shmem->txn_limbo_tail_cidx = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
+
+  return release_cnt;
+}
+
+/* fd_funk_txn_op_end ends a transaction level operation.  Everything
+   retired by the operation gets released as soon as all read sections
+   that started before the end of the operation are done. */
+
+static void
+fd_funk_txn_op_end( fd_funk_t * funk ) {
+  FD_ATOMIC_FETCH_AND_ADD( &funk->shmem->epoch, 1UL ); /* full fence */
+  fd_funk_reclaim( funk );
+}
+
 fd_funk_txn_t *
 fd_funk_txn_prepare( fd_funk_t *               funk,
                      fd_funk_txn_t *           parent,
@@ -102,6 +199,7 @@ fd_funk_txn_prepare( fd_funk_t *               funk,
 
   /* Get a new transaction from the map */
 
+  fd_funk_reclaim( funk );
   fd_funk_txn_t * txn = fd_funk_txn_pool_acquire( funk->txn_pool, NULL, 1, NULL );
   if( txn == NULL ) {
     if( FD_UNLIKELY( verbose ) ) FD_LOG_WARNING(( "transaction pool is exhuasted" ));
@@ -123,6 +221,8 @@ fd_funk_txn_prepare( fd_funk_t *               funk,
   txn->sibling_next_cidx = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
   txn->stack_cidx        = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
   txn->tag               = 0UL;
+  txn->retire_epoch      = 0UL;
+  txn->lock              = (uchar)0;
 
   txn->rec_head_idx = FD_FUNK_REC_IDX_NULL;
   txn->rec_tail_idx = FD_FUNK_REC_IDX_NULL;
@@ -150,12 +250,10 @@ fd_funk_txn_cancel_childless( fd_funk_t * funk,
 
   /* Remove all records used by this transaction.  Note that we don't
      need to bother doing all the individual removal operations as we
-     are removing the whole list.  We do reset the record transaction
-     idx with NULL though we can detect cycles as soon as possible
-     and abort. */
+     are removing the whole list.  Removed records keep their
+     transaction idx until they are reclaimed (concurrent readers on
+     other forks could otherwise mistake them for published records). */
 
-  fd_wksp_t *          wksp     = funk->wksp;
-  fd_alloc_t *         alloc    = funk->alloc;
   fd_funk_rec_map_t *  rec_map  = funk->rec_map;
   fd_funk_rec_pool_t * rec_pool = funk->rec_pool;
   ulong                rec_max  = fd_funk_rec_pool_ele_max( rec_pool );
@@ -172,7 +270,6 @@ fd_funk_txn_cancel_childless( fd_funk_t * funk,
 
     fd_funk_rec_t * rec = &rec_pool->ele[ rec_idx ];
     uint next_idx = rec->next_idx;
-    rec->txn_cidx = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
 
     for(;;) {
       fd_funk_rec_map_query_t rec_query[1];
@@ -181,8 +278,7 @@ fd_funk_txn_cancel_childless( fd_funk_t * funk,
       if( err == FD_MAP_ERR_KEY ) break;
       if( FD_UNLIKELY( err != FD_MAP_SUCCESS ) ) FD_LOG_CRIT(( "map corruption" ));
       if( rec != fd_funk_rec_map_query_ele( rec_query ) ) break;
-      fd_funk_val_flush( rec, alloc, wksp );
-      fd_funk_rec_pool_release( rec_pool, rec, 1 );
+      fd_funk_rec_retire( funk, rec );
       break;
     }
 
@@ -220,7 +316,7 @@ fd_funk_txn_cancel_childless( fd_funk_t * funk,
 
   fd_funk_txn_map_query_t query[1];
   if( fd_funk_txn_map_remove( txn_map, fd_funk_txn_xid( txn ), NULL, query, FD_MAP_FLAG_BLOCKING ) == FD_MAP_SUCCESS ) {
-    fd_funk_txn_pool_release( txn_pool, txn, 1 );
+    fd_funk_txn_retire( funk, txn );
   }
 }
 
@@ -286,7 +382,9 @@ fd_funk_txn_cancel( fd_funk_t *     funk,
 #endif
 
   ulong txn_idx = (ulong)(txn - funk->txn_pool->ele);
-  return fd_funk_txn_cancel_family( funk, funk->shmem->cycle_tag++, txn_idx );
+  ulong cancel_cnt = fd_funk_txn_cancel_family( funk, funk->shmem->cycle_tag++, txn_idx );
+  fd_funk_txn_op_end( funk );
+  return cancel_cnt;
 }
 
 /* fd_funk_txn_oldest_sibling returns the index of the oldest sibling
@@ -378,7 +476,9 @@ fd_funk_txn_cancel_siblings( fd_funk_t *     funk,
 
   ulong oldest_idx = fd_funk_txn_oldest_sibling( funk, txn_idx );
 
-  return fd_funk_txn_cancel_sibling_list( funk, funk->shmem->cycle_tag++, oldest_idx, txn_idx );
+  ulong cancel_cnt = fd_funk_txn_cancel_sibling_list( funk, funk->shmem->cycle_tag++, oldest_idx, txn_idx );
+  fd_funk_txn_op_end( funk );
+  return cancel_cnt;
 }
 
 ulong
@@ -411,7 +511,9 @@ fd_funk_txn_cancel_children( fd_funk_t *     funk,
     return 0UL;
   }
 
-  return fd_funk_txn_cancel_sibling_list( funk, funk->shmem->cycle_tag++, oldest_idx, FD_FUNK_TXN_IDX_NULL );
+  ulong cancel_cnt = fd_funk_txn_cancel_sibling_list( funk, funk->shmem->cycle_tag++, oldest_idx, FD_FUNK_TXN_IDX_NULL );
+  fd_funk_txn_op_end( funk );
+  return cancel_cnt;
 }
 
 /* Cancel all outstanding transactions */
@@ -456,8 +558,6 @@ fd_funk_txn_update( fd_funk_t *                  funk,
                        ulong                     dst_txn_idx,       /* Transaction index of the merge destination */
                        fd_funk_txn_xid_t const * dst_xid,        /* dst xid */
                        ulong                     txn_idx ) {        /* Transaction index of the records to merge */
-  fd_wksp_t *          wksp     = funk->wksp;
-  fd_alloc_t *         alloc    = funk->alloc;
   fd_funk_rec_map_t *  rec_map  = funk->rec_map;
   fd_funk_rec_pool_t * rec_pool = funk->rec_pool;
   fd_funk_txn_pool_t * txn_pool = funk->txn_pool;
@@ -492,10 +592,8 @@ fd_funk_txn_update( fd_funk_t *                  funk,
       } else {
         rec_pool->ele[ next_idx ].prev_idx = prev_idx;
       }
-      /* Clean up value */
-      fd_funk_val_flush( rec2, alloc, wksp );
-      rec2->txn_cidx = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
-      fd_funk_rec_pool_release( rec_pool, rec2, 1 );
+      /* Clean up value (once no reader can see it) */
+      fd_funk_rec_retire( funk, rec2 );
       break;
     }
 
@@ -504,10 +602,12 @@ fd_funk_txn_update( fd_funk_t *                  funk,
        to preserve the original element to preserve the
        newest-to-oldest ordering in the hash
        chain. fd_funk_rec_query_global relies on this subtle
-       property. */
+       property.  It also relies on txn_cidx being updated atomically
+       and before the children of txn get reparented. */
 
     rec->pair.xid[0] = *dst_xid;
-    rec->txn_cidx = fd_funk_txn_cidx( dst_txn_idx );
+    FD_COMPILER_MFENCE();
+    FD_VOLATILE( rec->txn_cidx ) = fd_funk_txn_cidx( dst_txn_idx );
 
     if( fd_funk_rec_idx_is_null( *_dst_rec_head_idx ) ) {
       *_dst_rec_head_idx = rec_idx;
@@ -548,6 +648,7 @@ fd_funk_txn_publish_funk_child( fd_funk_t * const funk,
 
   /* Make all the children children of funk */
 
+  FD_COMPILER_MFENCE();
   fd_funk_txn_t * txn = fd_funk_txn_pool_ele( funk->txn_pool, txn_idx );
   ulong child_head_idx = fd_funk_txn_idx( txn->child_head_cidx );
   ulong child_tail_idx = fd_funk_txn_idx( txn->child_tail_cidx );
@@ -569,7 +670,7 @@ fd_funk_txn_publish_funk_child( fd_funk_t * const funk,
 
   fd_funk_txn_map_query_t query[1];
   if( fd_funk_txn_map_remove( funk->txn_map, funk->shmem->last_publish, NULL, query, FD_MAP_FLAG_BLOCKING ) == FD_MAP_SUCCESS ) {
-    fd_funk_txn_pool_release( funk->txn_pool, txn, 1 );
+    fd_funk_txn_retire( funk, txn );
   }
 
   return FD_FUNK_SUCCESS;
@@ -637,6 +738,7 @@ fd_funk_txn_publish( fd_funk_t *     funk,
     publish_stack_idx = fd_funk_txn_idx( funk->txn_pool->ele[ txn_idx ].stack_cidx );
   }
 
+  fd_funk_txn_op_end( funk );
   return publish_cnt;
 }
 
@@ -680,6 +782,7 @@ fd_funk_txn_publish_into_parent( fd_funk_t *     funk,
   }
 
   /* Adjust the parent pointers of the children to point to their grandparent */
+  FD_COMPILER_MFENCE();
   ulong child_idx = fd_funk_txn_idx( txn->child_head_cidx );
   while( FD_UNLIKELY( !fd_funk_txn_idx_is_null( child_idx ) ) ) {
     txn_pool->ele[ child_idx ].parent_cidx = fd_funk_txn_cidx( parent_idx );
@@ -688,9 +791,10 @@ fd_funk_txn_publish_into_parent( fd_funk_t *     funk,
 
   fd_funk_txn_map_query_t query[1];
   if( fd_funk_txn_map_remove( txn_map, fd_funk_txn_xid( txn ), NULL, query, FD_MAP_FLAG_BLOCKING ) == FD_MAP_SUCCESS ) {
-    fd_funk_txn_pool_release( txn_pool, txn, 1 );
+    fd_funk_txn_retire( funk, txn );
   }
 
+  fd_funk_txn_op_end( funk );
   return FD_FUNK_SUCCESS;
 }
 
@@ -701,10 +805,14 @@ fd_funk_rec_t const *
 fd_funk_txn_first_rec( fd_funk_t *           funk,
                        fd_funk_txn_t const * txn ) {
   uint rec_idx;
-  if( FD_UNLIKELY( NULL == txn ))
+  if( FD_UNLIKELY( NULL == txn )) {
+    if( FD_UNLIKELY( FD_VOLATILE_CONST( funk->shmem->cold->rec_cnt ) ) ) {
+      FD_LOG_CRIT(( "iterating over the last published transaction while records are demoted" ));
+    }
     rec_idx = funk->shmem->rec_head_idx;
-  else
+  } else {
     rec_idx = txn->rec_head_idx;
+  }
   if( fd_funk_rec_idx_is_null( rec_idx ) ) return NULL;
   return funk->rec_pool->ele + rec_idx;
 }
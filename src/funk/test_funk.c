@@ -6,7 +6,7 @@ FD_STATIC_ASSERT( FD_FUNK_ALIGN    ==4096UL,                unit-test );
 
 FD_STATIC_ASSERT( FD_FUNK_ALIGN    >=alignof(fd_funk_t), unit-test );
 
-FD_STATIC_ASSERT( FD_FUNK_MAGIC    ==0xf17eda2ce7fc2c02UL,  unit-test );
+FD_STATIC_ASSERT( FD_FUNK_MAGIC    ==0xf17eda2ce7fc2c03UL,  unit-test );
 
 int
 main( int     argc,
@@ -94,15 +94,205 @@ static void * work_thread(void * arg) {
   return NULL;
 }
 
+/* Benchmark of fork-aware queries during continuous publishing.  The
+   main thread keeps a linear chain of BENCH_DEPTH in-preparation
+   transactions.  Every step, it prepares a new transaction at the tip
+   of the chain (updating BENCH_UPDATE_CNT distinct records) and publishes
+   the oldest one.  Reader threads concurrently query random records on
+   the current tip.  Every query must hit.
+
+   Tips are handed to readers by generation: bench_tip[ gen ] is the tip
+   of generation gen and bench_reader_gen[ i ] is the oldest generation
+   reader i might be querying (ULONG_MAX if none).  Before publishing
+   the tip of generation gen, the main thread waits until no reader
+   might still be querying it (this only happens when a reader stalls
+   for BENCH_DEPTH steps) such that queries are only ever done on forks
+   unaffected by the concurrent publish. */
+
+#define BENCH_KEY_CNT    (1UL<<16)
+#define BENCH_DEPTH      (16UL)
+#define BENCH_UPDATE_CNT (256UL)
+#define BENCH_KEY_STRIDE (197UL) /* Odd, so updates of a transaction hit distinct keys */
+#define BENCH_TIP_RING   (2UL*BENCH_DEPTH)
+
+static void *           bench_shfunk = NULL;
+static fd_funk_txn_t * volatile bench_tip[ BENCH_TIP_RING ];
+static volatile ulong  bench_gen = 0UL;
+static volatile ulong  bench_reader_gen[ NUM_THREADS ];
+static volatile int    bench_state = (int)STARTUP;
+static volatile ulong  bench_query_cnt = 0UL;
+
+static void
+bench_key( fd_funk_rec_key_t * key,
+           ulong               key_idx ) {
+  memset( key, 0, sizeof(fd_funk_rec_key_t) );
+  key->ul[0] = key_idx;
+  key->ul[1] = 0xfeedUL;
+}
+
+static void *
+bench_thread( void * arg ) {
+  ulong reader_idx = (ulong)arg;
+  fd_rng_t rng_[1];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( rng_, (uint)reader_idx, 0UL ) );
+
+  fd_funk_t funk_[1];
+  fd_funk_t * funk = fd_funk_join( funk_, bench_shfunk );
+  FD_TEST( funk );
+  fd_wksp_t * wksp = fd_funk_wksp( funk );
+
+  while( bench_state==(int)STARTUP ) FD_SPIN_PAUSE();
+
+  ulong query_cnt = 0UL;
+  while( bench_state==(int)RUN ) {
+    fd_funk_rec_key_t key;
+    ulong key_idx = fd_rng_ulong_roll( rng, BENCH_KEY_CNT );
+    bench_key( &key, key_idx );
+
+    (void)FD_ATOMIC_XCHG( &bench_reader_gen[ reader_idx ], bench_gen );
+    fd_funk_txn_t * txn = bench_tip[ bench_gen % BENCH_TIP_RING ];
+
+    fd_funk_read_begin( funk );
+    fd_funk_rec_query_t query[1];
+    fd_funk_rec_t const * rec = fd_funk_rec_query_try_global( funk, txn, &key, NULL, query );
+    FD_TEST( rec && fd_funk_val_sz( rec )==sizeof(ulong) );
+    ulong val = FD_LOAD( ulong, fd_funk_val( rec, wksp ) );
+    fd_funk_read_end( funk );
+
+    FD_COMPILER_MFENCE();
+    bench_reader_gen[ reader_idx ] = ULONG_MAX;
+
+    FD_TEST( val==key_idx );
+    query_cnt++;
+  }
+  FD_ATOMIC_FETCH_AND_ADD( &bench_query_cnt, query_cnt );
+
+  fd_funk_leave( funk, NULL );
+  fd_rng_delete( fd_rng_leave( rng ) );
+  return NULL;
+}
+
+static void
+bench_insert( fd_funk_t *     funk,
+              fd_funk_txn_t * txn,
+              ulong           key_idx ) {
+  fd_funk_rec_key_t key;
+  bench_key( &key, key_idx );
+  fd_funk_rec_prepare_t prepare[1];
+  fd_funk_rec_t * rec = fd_funk_rec_prepare( funk, txn, &key, prepare, NULL );
+  FD_TEST( rec );
+  void * val = fd_funk_val_truncate( rec, sizeof(ulong), fd_funk_alloc( funk ), fd_funk_wksp( funk ), NULL );
+  FD_TEST( val );
+  FD_STORE( ulong, val, key_idx );
+  fd_funk_rec_publish( funk, prepare );
+}
+
+static void
+bench_run( fd_wksp_t * wksp,
+           double      duration,
+           int         publish ) {
+  ulong txn_max = 4UL*BENCH_DEPTH;
+  ulong rec_max = 4UL*BENCH_KEY_CNT;
+  void * mem = fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint( txn_max, rec_max ), FD_FUNK_MAGIC );
+  FD_TEST( mem );
+  bench_shfunk = fd_funk_new( mem, 1, 5678U, txn_max, rec_max );
+  fd_funk_t funk_[1];
+  fd_funk_t * funk = fd_funk_join( funk_, bench_shfunk );
+  FD_TEST( funk );
+
+  fd_rng_t rng_[1];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( rng_, 1234U, 0UL ) );
+
+  for( ulong key_idx=0UL; key_idx<BENCH_KEY_CNT; key_idx++ ) bench_insert( funk, NULL, key_idx );
+
+  fd_funk_txn_t * chain[ BENCH_DEPTH ];
+  fd_funk_txn_xid_t xid;
+  memset( &xid, 0, sizeof(xid) );
+  for( ulong i=0UL; i<BENCH_DEPTH; i++ ) {
+    xid.ul[0]++;
+    chain[i] = fd_funk_txn_prepare( funk, i ? chain[i-1] : NULL, &xid, 1 );
+    FD_TEST( chain[i] );
+  }
+  bench_gen       = 0UL;
+  bench_tip[ 0 ]  = chain[ BENCH_DEPTH-1UL ];
+  bench_state     = (int)STARTUP;
+  bench_query_cnt = 0UL;
+  for( ulong i=0UL; i<NUM_THREADS; i++ ) bench_reader_gen[ i ] = ULONG_MAX;
+
+  pthread_t thr[NUM_THREADS];
+  for( ulong i=0UL; i<NUM_THREADS; i++ ) FD_TEST( !pthread_create( &thr[i], NULL, bench_thread, (void *)i ) );
+
+  long  dt          = (long)(duration*1e9);
+  ulong publish_cnt = 0UL;
+  long  t0          = fd_log_wallclock();
+  bench_state = (int)RUN;
+  for(;;) {
+    long t1 = fd_log_wallclock();
+    if( t1-t0>=dt ) break;
+    if( !publish ) { FD_SPIN_PAUSE(); continue; }
+
+    /* Extend the chain */
+
+    /* Transactions retired by recent publishes might still be visible
+       to a reader (e.g. one that got descheduled in a read section) so
+       preparing can transiently fail. */
+
+    xid.ul[0]++;
+    fd_funk_txn_t * tip;
+    while( !(tip = fd_funk_txn_prepare( funk, chain[ BENCH_DEPTH-1UL ], &xid, 0 )) ) FD_YIELD();
+    ulong key0 = fd_rng_ulong_roll( rng, BENCH_KEY_CNT );
+    for( ulong i=0UL; i<BENCH_UPDATE_CNT; i++ ) bench_insert( funk, tip, (key0+i*BENCH_KEY_STRIDE) & (BENCH_KEY_CNT-1UL) );
+    ulong gen = bench_gen + 1UL;
+    bench_tip[ gen % BENCH_TIP_RING ] = tip;
+    (void)FD_ATOMIC_XCHG( &bench_gen, gen );
+
+    /* Publish the oldest transaction of the chain (the tip of
+       generation gen-BENCH_DEPTH) once no reader can be using it */
+
+    if( gen>=BENCH_DEPTH ) {
+      for( ulong i=0UL; i<NUM_THREADS; i++ ) {
+        while( bench_reader_gen[ i ]<=gen-BENCH_DEPTH ) FD_YIELD();
+      }
+    }
+    FD_TEST( fd_funk_txn_publish( funk, chain[0], 1 )==1UL );
+    publish_cnt++;
+    memmove( chain, chain+1, (BENCH_DEPTH-1UL)*sizeof(fd_funk_txn_t *) );
+    chain[ BENCH_DEPTH-1UL ] = tip;
+  }
+  bench_state = (int)DONE;
+  long t1 = fd_log_wallclock();
+  for( ulong i=0UL; i<NUM_THREADS; i++ ) pthread_join( thr[i], NULL );
+
+  double secs = (double)(t1-t0)*1e-9;
+  FD_LOG_NOTICE(( "%s publishing: %.3e queries/s (%lu threads), %.3e publishes/s",
+                  publish ? "with" : "without", (double)bench_query_cnt/secs, (ulong)NUM_THREADS, (double)publish_cnt/secs ));
+
+  fd_funk_reclaim( funk );
+  FD_TEST( fd_funk_rec_idx_is_null( funk->shmem->rec_limbo_head_idx ) );
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_funk_leave( funk, NULL );
+  fd_wksp_free_laddr( fd_funk_delete( mem ) );
+}
+
 int main(int argc, char** argv) {
   srand(1234);
 
   fd_boot( &argc, &argv );
 
+  char const * _page_sz   = fd_env_strip_cmdline_cstr  ( &argc, &argv, "--page-sz",   NULL, "gigantic" );
+  ulong        page_cnt   = fd_env_strip_cmdline_ulong ( &argc, &argv, "--page-cnt",  NULL, 1UL        );
+  double       bench_secs = fd_env_strip_cmdline_double( &argc, &argv, "--bench-secs", NULL, 2.0      );
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+
   ulong txn_max = MAX_TXN_CNT;
   uint  rec_max = 1<<20;
   ulong  numa_idx = fd_shmem_numa_idx( 0 );
-  fd_wksp_t * wksp = fd_wksp_new_anonymous( FD_SHMEM_GIGANTIC_PAGE_SZ, 1U, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
   void * mem = fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint( txn_max, rec_max ), FD_FUNK_MAGIC );
   fd_funk_t funk_[1];
   fd_funk_t * funk = fd_funk_join( funk_, fd_funk_new( mem, 1, 1234U, txn_max, rec_max ) );
@@ -150,7 +340,10 @@ int main(int argc, char** argv) {
   }
 
   fd_funk_leave( funk, NULL );
-  fd_funk_delete( mem );
+  fd_wksp_free_laddr( fd_funk_delete( mem ) );
+
+  bench_run( wksp, 0.5*bench_secs, 0 );
+  bench_run( wksp,     bench_secs, 1 );
 
   printf("test passed!\n");
   return 0;
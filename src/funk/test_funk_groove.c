@@ -0,0 +1,330 @@
+#include "fd_funk_groove.h"
+
+#if FD_HAS_HOSTED
+
+#include <stdlib.h>
+#include <unistd.h>
+
+static fd_funk_rec_key_t
+test_key( ulong i ) {
+  fd_funk_rec_key_t key = {0};
+  key.ul[0] = fd_ulong_hash( i );
+  key.ul[4] = i;
+  return key;
+}
+
+static ulong
+test_val_sz( ulong i,
+             ulong ver ) {
+  return ( fd_ulong_hash( i ^ (ver<<32) ) % 3000UL ) + 1UL;
+}
+
+static void
+test_val_fill( uchar * val,
+               ulong   i,
+               ulong   ver ) {
+  ulong sz = test_val_sz( i, ver );
+  for( ulong b=0UL; b<sz; b++ ) val[ b ] = (uchar)( i + ver + b );
+}
+
+static int
+test_val_eq( fd_funk_t *           funk,
+             fd_funk_rec_t const * rec,
+             ulong                 i,
+             ulong                 ver ) {
+  ulong sz = test_val_sz( i, ver );
+  if( fd_funk_val_sz( rec )!=sz ) return 0;
+  uchar const * val = fd_funk_val_const( rec, fd_funk_wksp( funk ) );
+  for( ulong b=0UL; b<sz; b++ ) if( val[ b ]!=(uchar)( i + ver + b ) ) return 0;
+  return 1;
+}
+
+static void
+test_insert( fd_funk_t *     funk,
+             fd_funk_txn_t * txn,
+             ulong           i,
+             ulong           ver ) {
+  fd_funk_rec_key_t     key = test_key( i );
+  fd_funk_rec_prepare_t prepare[1];
+  int                   err;
+  fd_funk_rec_t * rec = fd_funk_rec_prepare( funk, txn, &key, prepare, &err );
+  FD_TEST( rec );
+  uchar * val = fd_funk_val_truncate( rec, test_val_sz( i, ver ), fd_funk_alloc( funk ), fd_funk_wksp( funk ), &err );
+  FD_TEST( val );
+  test_val_fill( val, i, ver );
+  fd_funk_rec_publish( funk, prepare );
+}
+
+/* test_resident returns 1 if key i is a record of the last published
+   transaction without going through the miss handler */
+
+static int
+test_resident( fd_funk_t * funk,
+               ulong       i ) {
+  fd_funk_xid_key_pair_t pair[1];
+  fd_funk_txn_xid_set_root( pair->xid );
+  fd_funk_rec_key_t key = test_key( i );
+  fd_funk_rec_key_copy( pair->key, &key );
+  fd_funk_rec_query_t query[1];
+  return !fd_funk_rec_map_query_try( fd_funk_rec_map( funk ), pair, NULL, query, 0 );
+}
+
+static ulong
+test_root_cnt( fd_funk_t * funk ) {
+  ulong cnt = 0UL;
+  fd_funk_rec_t * ele = fd_funk_rec_pool( funk )->ele;
+  for( uint idx=funk->shmem->rec_head_idx; !fd_funk_rec_idx_is_null( idx ); idx=ele[ idx ].next_idx ) cnt++;
+  return cnt;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL,         "normal" );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL,          16384UL );
+  ulong        near_cpu = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu", NULL, fd_log_cpu_id() );
+  ulong        rec_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--rec-cnt",  NULL,            512UL );
+
+  FD_LOG_NOTICE(( "Testing with --page-sz %s --page-cnt %lu --near-cpu %lu --rec-cnt %lu", _page_sz, page_cnt, near_cpu, rec_cnt ));
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  FD_TEST( wksp );
+
+  ulong wksp_tag = 1UL;
+  ulong txn_max  = 16UL;
+  uint  rec_max  = 2048U;
+  void * shfunk = fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint( txn_max, rec_max ), wksp_tag ),
+                               wksp_tag, 1234UL, txn_max, rec_max );
+  fd_funk_t funk_[1];
+  fd_funk_t * funk = fd_funk_join( funk_, shfunk );
+  FD_TEST( funk );
+
+  /* Create the tier backed by a file volume */
+
+  ulong ele_max = 1024UL;
+  FD_TEST( !fd_funk_groove_footprint( 1000UL ) );
+  ulong footprint = fd_funk_groove_footprint( ele_max );
+  FD_TEST( footprint && fd_ulong_is_aligned( footprint, fd_funk_groove_align() ) );
+  void * shmem = fd_wksp_alloc_laddr( wksp, fd_funk_groove_align(), footprint, wksp_tag );
+  FD_TEST( shmem );
+
+  FD_TEST( !fd_funk_groove_new( NULL,        ele_max, 0UL ) );
+  FD_TEST( !fd_funk_groove_new( (void *)1UL, ele_max, 0UL ) );
+  FD_TEST( !fd_funk_groove_new( shmem,       1000UL,  0UL ) );
+  void * shgroove = fd_funk_groove_new( shmem, ele_max, 5678UL );
+  FD_TEST( shgroove==shmem );
+
+  char path[] = "/tmp/test_funk_groove.XXXXXX";
+  int fd = mkstemp( path );
+  FD_TEST( fd>=0 );
+  FD_TEST( !close( fd ) );
+
+  void * volume0 = fd_funk_groove_volume_map( path, 1UL );
+  FD_TEST( volume0 );
+  FD_TEST( !unlink( path ) ); /* mapping keeps the file alive */
+
+  fd_funk_groove_t join_[1];
+  FD_TEST( !fd_funk_groove_join( NULL,  shgroove, funk, volume0, 1UL ) );
+  FD_TEST( !fd_funk_groove_join( join_, NULL,     funk, volume0, 1UL ) );
+  FD_TEST( !fd_funk_groove_join( join_, shgroove, NULL, volume0, 1UL ) );
+  fd_funk_groove_t * join = fd_funk_groove_join( join_, shgroove, funk, volume0, 1UL );
+  FD_TEST( join==join_ );
+  FD_TEST( funk->rec_miss_fn );
+  FD_TEST( !fd_funk_groove_join( join_, shgroove, funk, volume0, 1UL ) ); /* already has a miss handler */
+
+  FD_TEST( !fd_groove_data_volume_add( fd_funk_groove_data( join ), volume0, FD_GROOVE_VOLUME_FOOTPRINT, NULL, 0UL ) );
+
+  fd_funk_cold_metrics_t const * metrics = fd_funk_groove_metrics( join );
+  FD_TEST( metrics==fd_funk_cold_metrics( funk ) );
+
+  /* Demotion takes the oldest records first */
+
+  for( ulong i=0UL; i<rec_cnt; i++ ) test_insert( funk, NULL, i, 0UL );
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  FD_TEST( fd_funk_groove_demote( join, 0UL )==0UL );
+  FD_TEST( fd_funk_groove_demote( join, rec_cnt/2UL )==rec_cnt/2UL );
+  FD_TEST( metrics->demote_cnt==rec_cnt/2UL );
+  FD_TEST( metrics->rec_cnt   ==rec_cnt/2UL );
+  FD_TEST( test_root_cnt( funk )==rec_cnt-rec_cnt/2UL );
+  ulong byte_cnt = 0UL;
+  for( ulong i=0UL; i<rec_cnt; i++ ) {
+    FD_TEST( test_resident( funk, i )==(i>=rec_cnt/2UL) );
+    if( i<rec_cnt/2UL ) byte_cnt += test_val_sz( i, 0UL );
+  }
+  FD_TEST( metrics->demote_byte_cnt==byte_cnt );
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  /* A miss in the last published transaction faults the record in */
+
+  for( ulong i=0UL; i<rec_cnt/4UL; i++ ) {
+    fd_funk_rec_key_t   key = test_key( i );
+    fd_funk_rec_query_t query[1];
+    fd_funk_rec_t const * rec = fd_funk_rec_query_try( funk, NULL, &key, query );
+    FD_TEST( rec );
+    FD_TEST( test_val_eq( funk, rec, i, 0UL ) );
+    FD_TEST( test_resident( funk, i ) );
+  }
+  FD_TEST( metrics->promote_cnt==rec_cnt/4UL );
+  FD_TEST( metrics->rec_cnt    ==rec_cnt/2UL-rec_cnt/4UL );
+
+  /* Keys that were never inserted still miss */
+
+  do {
+    fd_funk_rec_key_t   key = test_key( rec_cnt );
+    fd_funk_rec_query_t query[1];
+    FD_TEST( !fd_funk_rec_query_try       ( funk, NULL, &key,       query ) );
+    FD_TEST( !fd_funk_rec_query_try_global( funk, NULL, &key, NULL, query ) );
+  } while(0);
+
+  /* Promoted records went to the back of the line */
+
+  FD_TEST( fd_funk_groove_demote( join, rec_cnt/2UL )==rec_cnt/2UL );
+  for( ulong i=0UL; i<rec_cnt; i++ ) FD_TEST( test_resident( funk, i )==(i<rec_cnt/4UL) );
+  FD_TEST( fd_funk_groove_demote( join, rec_cnt )==rec_cnt/4UL );
+  FD_TEST( !test_root_cnt( funk ) );
+  FD_TEST( metrics->rec_cnt==rec_cnt );
+
+  /* Lookups through an in-preparation transaction fault in the last
+     published version, and new versions in a child land ahead of it */
+
+  fd_funk_txn_xid_t xid = { .ul = { 1UL, 1UL } };
+  fd_funk_txn_t * txn = fd_funk_txn_prepare( funk, NULL, &xid, 0 );
+  FD_TEST( txn );
+
+  do {
+    fd_funk_rec_key_t     key = test_key( 0UL );
+    fd_funk_rec_query_t   query[1];
+    fd_funk_txn_t const * txn_out = txn;
+    fd_funk_rec_t const * rec = fd_funk_rec_query_try_global( funk, txn, &key, &txn_out, query );
+    FD_TEST( rec );
+    FD_TEST( !txn_out );
+    FD_TEST( test_val_eq( funk, rec, 0UL, 0UL ) );
+
+    key = test_key( 1UL );
+    fd_funk_rec_prepare_t prepare[1];
+    int err;
+    fd_funk_rec_t * clone = fd_funk_rec_clone( funk, txn, &key, prepare, &err );
+    FD_TEST( clone );
+    FD_TEST( test_val_eq( funk, clone, 1UL, 0UL ) );
+    fd_funk_rec_publish( funk, prepare );
+    FD_TEST( test_resident( funk, 1UL ) );
+
+    /* Prepare without a prior query */
+    test_insert( funk, txn, 2UL, 1UL );
+    FD_TEST( test_resident( funk, 2UL ) );
+    key = test_key( 2UL );
+    rec = fd_funk_rec_query_try_global( funk, txn, &key, &txn_out, query );
+    FD_TEST( rec && txn_out==txn );
+    FD_TEST( test_val_eq( funk, rec, 2UL, 1UL ) );
+    rec = fd_funk_rec_query_try( funk, NULL, &key, query );
+    FD_TEST( rec && test_val_eq( funk, rec, 2UL, 0UL ) );
+  } while(0);
+
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  /* Records with a version in an in-preparation transaction stay */
+
+  ulong skip_cnt = metrics->demote_skip_cnt;
+  FD_TEST( fd_funk_groove_demote( join, rec_cnt )==1UL ); /* only key 0 */
+  FD_TEST( metrics->demote_skip_cnt==skip_cnt+2UL );
+  FD_TEST( !test_resident( funk, 0UL ) );
+  FD_TEST(  test_resident( funk, 1UL ) );
+  FD_TEST(  test_resident( funk, 2UL ) );
+
+  FD_TEST( fd_funk_txn_publish( funk, txn, 0 )==1UL );
+  do {
+    fd_funk_rec_key_t   key = test_key( 2UL );
+    fd_funk_rec_query_t query[1];
+    fd_funk_rec_t const * rec = fd_funk_rec_query_try( funk, NULL, &key, query );
+    FD_TEST( rec && test_val_eq( funk, rec, 2UL, 1UL ) );
+  } while(0);
+
+  /* Tombstones are not demoted, removing a demoted record removes it
+     for good */
+
+  do {
+    fd_funk_rec_key_t key = test_key( 3UL );
+    FD_TEST( !fd_funk_rec_remove( funk, NULL, &key, NULL, 0UL ) );
+    FD_TEST( test_resident( funk, 3UL ) );
+    FD_TEST( fd_funk_groove_demote( join, rec_cnt )==2UL ); /* keys 1 and 2 */
+    FD_TEST( test_resident( funk, 3UL ) );
+
+    ulong demoted = metrics->rec_cnt;
+    key = test_key( 4UL );
+    fd_funk_rec_hard_remove( funk, NULL, &key );
+    FD_TEST( metrics->rec_cnt==demoted-1UL );
+    fd_funk_rec_query_t query[1];
+    FD_TEST( !fd_funk_rec_query_try( funk, NULL, &key, query ) );
+  } while(0);
+
+  /* Promote everything back */
+
+  ulong demoted = metrics->rec_cnt;
+  FD_TEST( demoted==rec_cnt-2UL );
+  FD_TEST( fd_funk_groove_promote_all( join )==demoted );
+  FD_TEST( !metrics->rec_cnt );
+  FD_TEST( test_root_cnt( funk )==rec_cnt-1UL );
+  for( ulong i=0UL; i<rec_cnt; i++ ) {
+    if( i==3UL || i==4UL ) continue;
+    fd_funk_rec_key_t   key = test_key( i );
+    fd_funk_rec_query_t query[1];
+    fd_funk_rec_t const * rec = fd_funk_rec_query_try( funk, NULL, &key, query );
+    FD_TEST( rec && test_val_eq( funk, rec, i, i==2UL ? 1UL : 0UL ) );
+  }
+  FD_TEST( !fd_funk_verify( funk ) );
+  FD_TEST( !fd_groove_data_verify( fd_funk_groove_data( join ) ) );
+
+  /* With nothing demoted, joins without a miss handler see everything
+     and misses are plain misses */
+
+  do {
+    fd_funk_t   plain_[1];
+    fd_funk_t * plain = fd_funk_join( plain_, shfunk );
+    FD_TEST( plain && !plain->rec_miss_fn );
+    FD_TEST( fd_funk_cold_metrics( plain )==metrics );
+    fd_funk_rec_key_t   key = test_key( 5UL );
+    fd_funk_rec_query_t query[1];
+    fd_funk_rec_t const * rec = fd_funk_rec_query_try( plain, NULL, &key, query );
+    FD_TEST( rec && test_val_eq( plain, rec, 5UL, 0UL ) );
+    key = test_key( 4UL );
+    FD_TEST( !fd_funk_rec_query_try       ( plain, NULL, &key,       query ) );
+    FD_TEST( !fd_funk_rec_query_try_global( plain, NULL, &key, NULL, query ) );
+    FD_TEST( fd_funk_txn_first_rec( plain, NULL ) );
+    FD_TEST( fd_funk_leave( plain, NULL )==plain_ );
+  } while(0);
+
+  FD_LOG_NOTICE(( "demote %lu (%lu bytes, %lu skipped) promote %lu (%lu bytes)",
+                  metrics->demote_cnt, metrics->demote_byte_cnt, metrics->demote_skip_cnt,
+                  metrics->promote_cnt, metrics->promote_byte_cnt ));
+
+  FD_TEST( fd_funk_groove_leave( join )==join_ );
+  FD_TEST( !funk->rec_miss_fn );
+  FD_TEST( fd_funk_groove_delete( shgroove )==shmem );
+  FD_TEST( !fd_funk_groove_delete( shgroove ) ); /* bad magic */
+  fd_funk_groove_volume_unmap( volume0, 1UL );
+  fd_wksp_free_laddr( shmem );
+
+  fd_funk_leave( funk, NULL );
+  fd_wksp_free_laddr( fd_funk_delete( shfunk ) );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
@@ -9,6 +9,9 @@ $(call add-objs,fd_quic_ack_tx,fd_quic)
 $(call add-hdrs,fd_quic_conn.h)
 $(call add-objs,fd_quic_conn,fd_quic)
 
+$(call add-hdrs,fd_quic_cc.h)
+$(call add-objs,fd_quic_cc,fd_quic)
+
 $(call add-hdrs,fd_quic_conn_id.h)
 
 $(call add-hdrs,fd_quic_conn_map.h)
@@ -418,6 +418,16 @@ fd_quic_init( fd_quic_t * quic ) {
     config->ack_threshold = FD_QUIC_DEFAULT_ACK_THRESHOLD;
   }
 
+  if( FD_UNLIKELY( config->cc_algo>=FD_QUIC_CC_ALGO_CNT ) ) {
+    FD_LOG_WARNING(( "invalid cfg.cc_algo (%u)", config->cc_algo ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( config->net.tx_batch>FD_QUIC_TX_BATCH_MAX ) ) {
+    FD_LOG_WARNING(( "cfg.net.tx_batch (%u) exceeds FD_QUIC_TX_BATCH_MAX (%u)", config->net.tx_batch, FD_QUIC_TX_BATCH_MAX ));
+    return NULL;
+  }
+
   fd_quic_layout_t layout = {0};
   if( FD_UNLIKELY( !fd_quic_footprint_ext( &quic->limits, &layout ) ) ) {
     FD_LOG_CRIT(( "fd_quic_footprint_ext failed" ));
@@ -1270,6 +1280,7 @@ fd_quic_abandon_enc_level( fd_quic_conn_t * conn,
       if( FD_LIKELY( prev ) ) {
         fd_quic_pkt_meta_pool_ele_release( pool, prev );
       }
+      fd_quic_cc_on_discard( conn->cc, e->sz );
       fd_quic_reclaim_pkt_meta( conn, e, j );
       prev = e;
     }
@@ -2500,6 +2511,9 @@ fd_quic_aio_cb_receive( void *                    context,
 
   quic->metrics.net_rx_pkt_cnt += batch_cnt;
 
+  /* send any datagrams generated inline (e.g. Retry) */
+  fd_quic_tx_flush( quic );
+
   FD_DEBUG(
     t1 = fd_quic_now( quic );
     ulong delta = t1 - t0;
@@ -2887,10 +2901,12 @@ fd_quic_service( fd_quic_t * quic ) {
   fd_quic_svc_timers_t * timers = state->svc_timers;
   fd_quic_svc_event_t    next   = fd_quic_svc_timers_next( timers, now, 1 /* pop */);
   if( FD_UNLIKELY( next.conn == NULL ) ) {
+    fd_quic_tx_flush( quic );
     return 0;
   }
 
   int cnt = fd_quic_svc_poll( quic, next.conn, now );
+  fd_quic_tx_flush( quic );
 
   long delta_ticks = fd_tickcount() - now_ticks;
 
@@ -2936,10 +2952,18 @@ fd_quic_tx_buffered_raw(
   fd_quic_config_t * config = &quic->config;
   fd_quic_state_t *  state  = fd_quic_get_state( quic );
 
-  uchar * const crypt_scratch = state->crypt_scratch;
+  /* if batching, encode the datagram directly into the next batch slot.
+     Datagrams produced while a flush is in progress (aio_tx called back
+     into this quic) are sent immediately, since the batch slots are
+     still owned by the outer fd_aio_send. */
+  int batch = config->net.tx_batch>1U && !state->tx_flush_busy;
+  if( batch && state->tx_batch_cnt>=config->net.tx_batch ) {
+    fd_quic_tx_flush( quic );
+  }
+  uchar * const out_buf = batch ? state->tx_batch_buf[ state->tx_batch_cnt ] : state->crypt_scratch;
 
-  uchar * cur_ptr = state->crypt_scratch;
-  ulong   cur_sz  = sizeof( state->crypt_scratch );
+  uchar * cur_ptr = out_buf;
+  ulong   cur_sz  = FD_QUIC_MTU;
 
   /* TODO much of this may be prepared ahead of time */
   fd_quic_pkt_t pkt;
@@ -2993,8 +3017,17 @@ fd_quic_tx_buffered_raw(
   cur_ptr += (ulong)payload_sz;
   cur_sz  -= (ulong)payload_sz;
 
-  fd_aio_pkt_info_t aio_buf = { .buf = crypt_scratch, .buf_sz = (ushort)( cur_ptr - crypt_scratch ) };
+  fd_aio_pkt_info_t aio_buf = { .buf = out_buf, .buf_sz = (ushort)( cur_ptr - out_buf ) };
+
+  if( batch ) {
+    /* sent (and counted) by the next fd_quic_tx_flush */
+    state->tx_batch[ state->tx_batch_cnt++ ] = aio_buf;
+    *tx_ptr_ptr = tx_buf;
+    return FD_QUIC_SUCCESS;
+  }
+
   int aio_rc = fd_aio_send( &quic->aio_tx, &aio_buf, 1, NULL, 1 );
+  quic->metrics.net_tx_batch_cnt++;
   if( aio_rc == FD_AIO_ERR_AGAIN ) {
     /* transient condition - try later */
     return FD_QUIC_FAILED;
@@ -3014,6 +3047,38 @@ fd_quic_tx_buffered_raw(
   return FD_QUIC_SUCCESS; /* success */
 }
 
+FD_QUIC_API void
+fd_quic_tx_flush( fd_quic_t * quic ) {
+  fd_quic_state_t * state     = fd_quic_get_state( quic );
+  ulong             batch_cnt = state->tx_batch_cnt;
+  if( FD_LIKELY( !batch_cnt ) ) return;
+
+  /* aio_tx may synchronously call back into this quic (e.g. a virtual
+     pair delivering a Retry).  The batch slots stay reserved until the
+     send returns, nested sends bypass the batch meanwhile. */
+  if( FD_UNLIKELY( state->tx_flush_busy ) ) return;
+  state->tx_flush_busy = 1;
+
+  ulong sent_cnt = batch_cnt;
+  int aio_rc = fd_aio_send( &quic->aio_tx, state->tx_batch, batch_cnt, &sent_cnt, 1 );
+  if( FD_LIKELY( aio_rc==FD_AIO_SUCCESS ) ) {
+    sent_cnt = batch_cnt;
+  } else if( aio_rc!=FD_AIO_ERR_AGAIN ) {
+    FD_LOG_WARNING(( "Fatal error reported by aio peer" ));
+  }
+  /* datagrams not accepted by aio_tx are dropped, loss recovery
+     retransmits their frames */
+
+  quic->metrics.net_tx_batch_cnt++;
+  quic->metrics.net_tx_pkt_cnt += sent_cnt;
+  for( ulong j=0UL; j<sent_cnt; j++ ) {
+    quic->metrics.net_tx_byte_cnt += state->tx_batch[ j ].buf_sz;
+  }
+
+  state->tx_batch_cnt  = 0UL;
+  state->tx_flush_busy = 0;
+}
+
 uint
 fd_quic_tx_buffered( fd_quic_t *      quic,
                      fd_quic_conn_t * conn ) {
@@ -3329,6 +3394,7 @@ fd_quic_gen_stream_frames( fd_quic_conn_t             * conn,
   fd_quic_stream_t * cur_stream = sentinel->next;
   ulong pkt_num = pkt_meta_tmpl->key.pkt_num;
   fd_quic_state_t * state = fd_quic_get_state( conn->quic );
+  int cc_ok = 0;
   while( !cur_stream->sentinel ) {
     /* required, since cur_stream may get removed from list */
     fd_quic_stream_t * nxt_stream = cur_stream->next;
@@ -3359,6 +3425,21 @@ fd_quic_gen_stream_frames( fd_quic_conn_t             * conn,
           break;
         }
 
+        /* check congestion window and pacer (once per packet)
+           If only the pacer blocks, retry once it has refilled.
+           If the cwnd blocks, an incoming ACK reschedules. */
+        if( !cc_ok ) {
+          fd_quic_cc_t * cc = conn->cc;
+          if( !fd_quic_cc_can_send( cc, pkt_meta_tmpl->tx_time ) ) {
+            conn->quic->metrics.pkt_cc_blocked_cnt++;
+            if( cc->inflight<cc->cwnd ) {
+              fd_quic_svc_prep_schedule( conn, fd_quic_cc_next_send( cc, pkt_meta_tmpl->tx_time ) );
+            }
+            break;
+          }
+          cc_ok = 1;
+        }
+
         /* Leave placeholder for frame/stream type */
         uchar * const frame_type_p = payload_ptr++;
         uint          frame_type   = 0x0a; /* stream frame with length */
@@ -3740,6 +3821,8 @@ fd_quic_conn_tx( fd_quic_t      * quic,
     /* everything successful up to here
        encrypt into tx_ptr,tx_ptr+tx_sz */
 
+    uchar * const pkt_start = conn->tx_ptr;
+
 #if FD_QUIC_DISABLE_CRYPTO
     ulong quic_pkt_sz = hdr_sz + tot_frame_sz + padding;
     fd_memcpy( conn->tx_ptr, hdr_ptr, quic_pkt_sz );
@@ -3769,6 +3852,21 @@ fd_quic_conn_tx( fd_quic_t      * quic,
     conn->tx_ptr += cipher_text_sz;
 #endif
 
+    /* count ack-eliciting app packets (those with a pkt_meta) as in
+       flight for congestion control */
+    if( enc_level==fd_quic_enc_level_appdata_id && conn->cc->algo!=FD_QUIC_CC_ALGO_NONE ) {
+      fd_quic_pkt_meta_tracker_t *   tracker = &conn->pkt_meta_tracker;
+      fd_quic_pkt_meta_ds_fwd_iter_t iter    = fd_quic_pkt_meta_ds_idx_ge( &tracker->sent_pkt_metas[ enc_level ], pkt_number, tracker->pool );
+      if( !fd_quic_pkt_meta_ds_fwd_iter_done( iter ) ) {
+        fd_quic_pkt_meta_t * e = fd_quic_pkt_meta_ds_fwd_iter_ele( iter, tracker->pool );
+        if( e->key.pkt_num==pkt_number ) {
+          ulong pkt_sz = (ulong)( conn->tx_ptr - pkt_start );
+          e->sz = (ushort)pkt_sz;
+          fd_quic_cc_on_send( conn->cc, pkt_sz );
+        }
+      }
+    }
+
     if( enc_level == fd_quic_enc_level_appdata_id ) {
       /* short header must be last in datagram
          so send in packet immediately */
@@ -4267,6 +4365,8 @@ fd_quic_conn_create( fd_quic_t *               quic,
   rtt->var_rtt                  = FD_QUIC_INITIAL_RTT_US * (float)quic->config.tick_per_us * 0.5f;
   rtt->rtt_period_ticks         = FD_QUIC_RTT_PERIOD_US  * (float)quic->config.tick_per_us;
 
+  fd_quic_cc_init( conn->cc, config->cc_algo, FD_QUIC_MAX_PAYLOAD_SZ, rtt->smoothed_rtt, state->now );
+
   /* highest peer encryption level */
   conn->peer_enc_level = 0;
 
@@ -4520,6 +4620,12 @@ fd_quic_pkt_meta_retry( fd_quic_t *          quic,
     /* reschedule to ensure the data gets processed */
     fd_quic_svc_prep_schedule_now( conn );
 
+    /* remove from flight.  Forced reclaims are not a congestion signal */
+    if( pkt_meta->sz ) {
+      if( force ) fd_quic_cc_on_discard( conn->cc, pkt_meta->sz );
+      else        fd_quic_cc_on_loss( conn->cc, pkt_meta->sz, pkt_meta->tx_time, now, conn->rtt->smoothed_rtt );
+    }
+
     /* free pkt_meta */
     fd_quic_pkt_meta_remove_range( &tracker->sent_pkt_metas[enc_level],
                                     pool,
@@ -4818,6 +4924,10 @@ fd_quic_process_ack_range( fd_quic_conn_t      * conn,
   fd_quic_pkt_meta_t         * pool     =  tracker->pool;
   fd_quic_pkt_meta_ds_t      * sent     =  &tracker->sent_pkt_metas[enc_level];
 
+  /* bytes acked for congestion control */
+  ulong acked_sz      = 0UL;
+  ulong acked_tx_time = 0UL;
+
   /* start at oldest sent */
   for( fd_quic_pkt_meta_ds_fwd_iter_t iter = fd_quic_pkt_meta_ds_idx_ge( sent, lo, pool );
                                              !fd_quic_pkt_meta_ds_fwd_iter_done( iter );
@@ -4829,10 +4939,20 @@ fd_quic_process_ack_range( fd_quic_conn_t      * conn,
       pkt->rtt_ack_time   = now - e->tx_time; /* in ticks */
       pkt->rtt_ack_delay  = ack_delay;               /* in peer units */
     }
+    if( e->sz ) {
+      acked_sz     += e->sz;
+      acked_tx_time = fd_ulong_max( acked_tx_time, e->tx_time );
+    }
     fd_quic_reclaim_pkt_meta( conn, e, enc_level );
   }
 
   conn->used_pkt_meta -= fd_quic_pkt_meta_remove_range( sent, pool, lo, hi );
+
+  if( acked_sz ) {
+    fd_quic_cc_on_ack( conn->cc, acked_sz, acked_tx_time, now, conn->rtt->smoothed_rtt, conn->rtt->min_rtt );
+    /* cwnd opened up, so try sending more */
+    fd_quic_svc_prep_schedule( conn, now );
+  }
 }
 
 static ulong
@@ -194,6 +194,11 @@ struct __attribute__((aligned(16UL))) fd_quic_config {
   ulong tls_hs_ttl;
 # define FD_QUIC_DEFAULT_TLS_HS_TTL (ulong)(3e9) /* 3s */
 
+  /* cc_algo: congestion control and pacing algorithm for new conns.
+     One of FD_QUIC_CC_ALGO_{NONE,NEWRENO,BBR} (see fd_quic_cc.h).
+     Default is NONE (no congestion control). */
+  uint cc_algo;
+
   /* TLS config ********************************************/
 
   /* identity_key: Ed25519 public key of node identity */
@@ -214,6 +219,17 @@ struct __attribute__((aligned(16UL))) fd_quic_config {
     /* dscp: Differentiated services code point.
        Set on all outgoing IPv4 packets. */
     uchar dscp;
+
+    /* tx_batch: max number of outgoing datagrams buffered before they
+       are handed to aio_tx in a single fd_aio_send call.  Buffered
+       datagrams are flushed at the end of each fd_quic_service and
+       RX callback, so all packets produced for a conn in one service
+       pass reach aio_tx as one contiguous train (typically of equal
+       size, allowing the receiver to use UDP_SEGMENT or a single XDP
+       TX batch).  0 or 1 sends each datagram immediately (default).
+       Must not exceed FD_QUIC_TX_BATCH_MAX. */
+    uint tx_batch;
+#   define FD_QUIC_TX_BATCH_MAX (32U)
   } net;
 };
 
@@ -306,6 +322,7 @@ union fd_quic_metrics {
     ulong net_rx_byte_cnt; /* total bytes received (including IP, UDP, QUIC headers) */
     ulong net_tx_pkt_cnt;  /* number of IP packets sent */
     ulong net_tx_byte_cnt; /* total bytes sent */
+    ulong net_tx_batch_cnt; /* number of send calls to aio_tx */
     ulong retry_tx_cnt;    /* number of Retry packets sent */
 
     /* Conn metrics */
@@ -329,6 +346,7 @@ union fd_quic_metrics {
     ulong pkt_tx_alloc_fail_cnt;   /* number of pkt_meta alloc fails */
     ulong pkt_verneg_cnt;          /* number of QUIC version negotiation packets or packets with wrong version */
     ulong pkt_retransmissions_cnt;  /* number of pkt_meta retries */
+    ulong pkt_cc_blocked_cnt;      /* number of times congestion control or pacing deferred stream data */
 
     /* Frame metrics */
     ulong frame_rx_cnt[ 22 ];      /* number of frames received (indexed by implementation-defined IDs) */
@@ -550,6 +568,17 @@ fd_quic_get_next_wakeup( fd_quic_t * quic );
 FD_QUIC_API int
 fd_quic_service( fd_quic_t * quic );
 
+/* fd_quic_tx_flush hands any datagrams buffered for transmit (see
+   config.net.tx_batch) to aio_tx.  fd_quic_service and the RX callback
+   flush implicitly, so this only needs to be called by users that
+   drive conns outside those entry points.  No-op if nothing is
+   buffered.  Safe to reach re-entrantly from aio_tx: datagrams
+   generated while a flush is in progress bypass the batch and are sent
+   immediately, and the nested flush is a no-op. */
+
+FD_QUIC_API void
+fd_quic_tx_flush( fd_quic_t * quic );
+
 /* fd_quic_state_validate checks for violations of service queue and free
    list invariants, such as cycles in linked lists.  Prints to warning/
    error log and exits the process if checks fail.  Intended for use in
@@ -0,0 +1,229 @@
+#include "fd_quic_cc.h"
+
+/* BBRv1 gains */
+
+#define FD_QUIC_CC_BBR_HIGH_GAIN  (2.885f) /* 2/ln(2) */
+#define FD_QUIC_CC_BBR_CWND_GAIN  (2.0f)
+#define FD_QUIC_CC_BBR_CYCLE_CNT  (8U)
+
+static float const fd_quic_cc_bbr_cycle[ FD_QUIC_CC_BBR_CYCLE_CNT ] =
+  { 1.25f, 0.75f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+
+/* FD_QUIC_CC_PACER_BURST is the pacer bucket depth in datagrams */
+
+#define FD_QUIC_CC_PACER_BURST (4UL)
+
+char const *
+fd_quic_cc_algo_cstr( uint algo ) {
+  switch( algo ) {
+  case FD_QUIC_CC_ALGO_NONE:    return "none";
+  case FD_QUIC_CC_ALGO_NEWRENO: return "newreno";
+  case FD_QUIC_CC_ALGO_BBR:     return "bbr";
+  default:                      return "unknown";
+  }
+}
+
+static void
+fd_quic_cc_set_pacing_rate( fd_quic_cc_t * cc,
+                            float          rate ) {
+  /* never stall the pacer entirely */
+  cc->pacer->rate = fmaxf( rate, 1e-6f );
+}
+
+fd_quic_cc_t *
+fd_quic_cc_init( fd_quic_cc_t * cc,
+                 uint           algo,
+                 ulong          mss,
+                 float          rtt,
+                 ulong          now ) {
+  *cc = (fd_quic_cc_t){0};
+  cc->algo = algo;
+  cc->mss  = mss;
+
+  /* RFC 9002 Section 7.2: initial window */
+  cc->cwnd     = fd_ulong_min( 10UL*mss, fd_ulong_max( 14720UL, 2UL*mss ) );
+  cc->cwnd_min = ( algo==FD_QUIC_CC_ALGO_BBR ? 4UL : 2UL ) * mss;
+  cc->ssthresh = ULONG_MAX;
+
+  cc->bbr_state   = FD_QUIC_CC_BBR_STATE_STARTUP;
+  cc->pacing_gain = FD_QUIC_CC_BBR_HIGH_GAIN;
+  cc->cwnd_gain   = FD_QUIC_CC_BBR_HIGH_GAIN;
+  cc->round_start = now;
+  cc->min_rtt     = rtt;
+
+  float burst = (float)( FD_QUIC_CC_PACER_BURST * mss );
+  cc->pacer->ts      = (long)now;
+  cc->pacer->burst   = burst;
+  cc->pacer->balance = burst;
+  float gain = algo==FD_QUIC_CC_ALGO_BBR ? cc->pacing_gain : 1.25f;
+  fd_quic_cc_set_pacing_rate( cc, gain * (float)cc->cwnd / fmaxf( rtt, 1.0f ) );
+
+  return cc;
+}
+
+int
+fd_quic_cc_can_send( fd_quic_cc_t * cc,
+                     ulong          now ) {
+  if( cc->algo==FD_QUIC_CC_ALGO_NONE ) return 1;
+  if( cc->inflight>=cc->cwnd ) return 0;
+  return fd_token_bucket_consume( cc->pacer, (float)cc->mss, (long)now );
+}
+
+ulong
+fd_quic_cc_next_send( fd_quic_cc_t const * cc,
+                      ulong                now ) {
+  if( cc->algo==FD_QUIC_CC_ALGO_NONE ) return now;
+  fd_token_bucket_t const * pacer = cc->pacer;
+  float balance = pacer->balance + (float)( (long)now - pacer->ts ) * pacer->rate;
+  balance = fminf( balance, pacer->burst );
+  float deficit = (float)cc->mss - balance;
+  if( deficit<=0.0f ) return now;
+  return now + (ulong)ceilf( deficit / pacer->rate );
+}
+
+static void
+fd_quic_cc_newreno_on_ack( fd_quic_cc_t * cc,
+                           ulong          acked_sz,
+                           ulong          sent_time,
+                           float          srtt ) {
+  if( cc->in_recovery && sent_time<=cc->recovery_start ) {
+    /* RFC 9002 Section 7.3.2: no growth during recovery */
+  } else {
+    cc->in_recovery = 0;
+    if( cc->cwnd<cc->ssthresh ) {
+      /* slow start */
+      cc->cwnd += acked_sz;
+    } else {
+      /* congestion avoidance: one mss per cwnd acked */
+      cc->ca_acked += acked_sz;
+      while( cc->ca_acked>=cc->cwnd ) {
+        cc->ca_acked -= cc->cwnd;
+        cc->cwnd     += cc->mss;
+      }
+    }
+  }
+  fd_quic_cc_set_pacing_rate( cc, 1.25f * (float)cc->cwnd / fmaxf( srtt, 1.0f ) );
+}
+
+static void
+fd_quic_cc_bbr_on_ack( fd_quic_cc_t * cc,
+                       ulong          acked_sz,
+                       ulong          now,
+                       float          srtt,
+                       float          min_rtt ) {
+  cc->delivered += acked_sz;
+  cc->min_rtt    = fmaxf( min_rtt, 1.0f );
+
+  /* A round ends after min_rtt worth of time.  Take a delivery rate
+     sample over the round and feed the windowed max filter. */
+  ulong round_time = now - cc->round_start;
+  if( (float)round_time>=cc->min_rtt ) {
+    float sample = (float)( cc->delivered - cc->round_delivered ) / (float)round_time;
+    cc->round_cnt++;
+    cc->bw_win[ cc->round_cnt % FD_QUIC_CC_BBR_BW_WIN ] = sample;
+    float bw = 0.0f;
+    for( ulong j=0UL; j<FD_QUIC_CC_BBR_BW_WIN; j++ ) bw = fmaxf( bw, cc->bw_win[ j ] );
+    cc->btl_bw          = bw;
+    cc->round_start     = now;
+    cc->round_delivered = cc->delivered;
+
+    switch( cc->bbr_state ) {
+    case FD_QUIC_CC_BBR_STATE_STARTUP:
+      /* exit STARTUP once bandwidth stops growing by 25% for 3 rounds */
+      if( cc->btl_bw>=cc->full_bw*1.25f ) {
+        cc->full_bw     = cc->btl_bw;
+        cc->full_bw_cnt = 0UL;
+      } else if( ++cc->full_bw_cnt>=3UL ) {
+        cc->bbr_state   = FD_QUIC_CC_BBR_STATE_DRAIN;
+        cc->pacing_gain = 1.0f / FD_QUIC_CC_BBR_HIGH_GAIN;
+        cc->cwnd_gain   = FD_QUIC_CC_BBR_HIGH_GAIN;
+      }
+      break;
+    case FD_QUIC_CC_BBR_STATE_PROBE_BW:
+      cc->cycle_idx   = ( cc->cycle_idx + 1U ) % FD_QUIC_CC_BBR_CYCLE_CNT;
+      cc->pacing_gain = fd_quic_cc_bbr_cycle[ cc->cycle_idx ];
+      break;
+    default:
+      break;
+    }
+  }
+
+  float bdp = cc->btl_bw * cc->min_rtt;
+
+  if( cc->bbr_state==FD_QUIC_CC_BBR_STATE_DRAIN && (float)cc->inflight<=bdp ) {
+    cc->bbr_state   = FD_QUIC_CC_BBR_STATE_PROBE_BW;
+    cc->cycle_idx   = 2U; /* start cruising */
+    cc->pacing_gain = fd_quic_cc_bbr_cycle[ cc->cycle_idx ];
+    cc->cwnd_gain   = FD_QUIC_CC_BBR_CWND_GAIN;
+  }
+
+  /* cwnd tracks cwnd_gain*BDP once the pipe is full, and grows like
+     slow start before that */
+  ulong target = fd_ulong_max( (ulong)( cc->cwnd_gain * bdp ), cc->cwnd_min );
+  if( cc->bbr_state!=FD_QUIC_CC_BBR_STATE_STARTUP ) {
+    cc->cwnd = fd_ulong_min( cc->cwnd + acked_sz, target );
+  } else if( cc->cwnd<target || cc->btl_bw==0.0f ) {
+    cc->cwnd += acked_sz;
+  }
+  cc->cwnd = fd_ulong_max( cc->cwnd, cc->cwnd_min );
+
+  if( cc->btl_bw>0.0f ) {
+    fd_quic_cc_set_pacing_rate( cc, cc->pacing_gain * cc->btl_bw );
+  } else {
+    fd_quic_cc_set_pacing_rate( cc, cc->pacing_gain * (float)cc->cwnd / fmaxf( srtt, 1.0f ) );
+  }
+}
+
+void
+fd_quic_cc_on_ack( fd_quic_cc_t * cc,
+                   ulong          acked_sz,
+                   ulong          sent_time,
+                   ulong          now,
+                   float          srtt,
+                   float          min_rtt ) {
+  cc->inflight -= fd_ulong_min( cc->inflight, acked_sz );
+  switch( cc->algo ) {
+  case FD_QUIC_CC_ALGO_NEWRENO:
+    fd_quic_cc_newreno_on_ack( cc, acked_sz, sent_time, srtt );
+    break;
+  case FD_QUIC_CC_ALGO_BBR:
+    fd_quic_cc_bbr_on_ack( cc, acked_sz, now, srtt, min_rtt );
+    break;
+  default:
+    break;
+  }
+}
+
+void
+fd_quic_cc_on_loss( fd_quic_cc_t * cc,
+                    ulong          lost_sz,
+                    ulong          sent_time,
+                    ulong          now,
+                    float          srtt ) {
+  cc->inflight -= fd_ulong_min( cc->inflight, lost_sz );
+
+  if( cc->algo==FD_QUIC_CC_ALGO_BBR ) {
+    /* Loss during STARTUP means the bottleneck queue overflowed, so
+       the pipe is full (BBRv2).  Leave STARTUP instead of waiting
+       for three rounds of bandwidth plateau. */
+    if( cc->bbr_state==FD_QUIC_CC_BBR_STATE_STARTUP && cc->btl_bw>0.0f ) {
+      cc->bbr_state   = FD_QUIC_CC_BBR_STATE_DRAIN;
+      cc->pacing_gain = 1.0f / FD_QUIC_CC_BBR_HIGH_GAIN;
+      fd_quic_cc_set_pacing_rate( cc, cc->pacing_gain * cc->btl_bw );
+    }
+    return;
+  }
+  if( cc->algo!=FD_QUIC_CC_ALGO_NEWRENO ) return;
+
+  /* RFC 9002 Section 7.3.2: reduce the window once per recovery
+     period, i.e. ignore losses of packets sent before recovery
+     started */
+  if( cc->in_recovery && sent_time<=cc->recovery_start ) return;
+
+  cc->in_recovery    = 1;
+  cc->recovery_start = now;
+  cc->ssthresh       = fd_ulong_max( cc->cwnd/2UL, cc->cwnd_min );
+  cc->cwnd           = cc->ssthresh;
+  cc->ca_acked       = 0UL;
+  fd_quic_cc_set_pacing_rate( cc, 1.25f * (float)cc->cwnd / fmaxf( srtt, 1.0f ) );
+}
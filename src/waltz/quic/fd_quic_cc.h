@@ -0,0 +1,167 @@
+#ifndef HEADER_fd_src_waltz_quic_fd_quic_cc_h
+#define HEADER_fd_src_waltz_quic_fd_quic_cc_h
+
+/* fd_quic_cc.h provides sender-side congestion control and pacing for
+   fd_quic conns.
+
+   Congestion control limits the number of bytes in flight (sent in
+   ack-eliciting packets, not yet acknowledged or declared lost) to a
+   congestion window (cwnd).  Pacing spreads packet transmissions over
+   time using a token bucket (see fd_token_bucket.h) that refills at
+   the current pacing rate, such that bursts do not overflow NIC queues
+   or the peer's receive path.
+
+   Supported algorithms:
+
+   - FD_QUIC_CC_ALGO_NONE disables congestion control and pacing
+     (legacy behavior, the default)
+
+   - FD_QUIC_CC_ALGO_NEWRENO is loss-based NewReno as specified in
+     RFC 9002 Section 7 (slow start, congestion avoidance, one window
+     reduction per recovery period).  The pacing rate is
+     1.25*cwnd/smoothed_rtt (RFC 9002 Section 7.7).
+
+   - FD_QUIC_CC_ALGO_BBR is a simplified model-based controller after
+     BBRv1.  It estimates the bottleneck bandwidth (windowed max of
+     per-round delivery rate samples) and the min RTT, paces at
+     pacing_gain*btl_bw and caps inflight at cwnd_gain*BDP.  It cycles
+     through STARTUP, DRAIN and PROBE_BW.  PROBE_RTT is not
+     implemented; min_rtt comes from the conn's RTT estimator.  Loss
+     ends STARTUP early (as in BBRv2) but otherwise does not reduce
+     the model.
+
+   All times are in fd_quic clock ticks (see fd_quic_now_t).  Sizes are
+   in UDP payload bytes.  An fd_quic_cc_t is owned by a single conn and
+   not thread safe. */
+
+#include "fd_quic_common.h"
+#include "../fd_token_bucket.h"
+#include "../../util/bits/fd_bits.h"
+
+#define FD_QUIC_CC_ALGO_NONE    (0U)
+#define FD_QUIC_CC_ALGO_NEWRENO (1U)
+#define FD_QUIC_CC_ALGO_BBR     (2U)
+#define FD_QUIC_CC_ALGO_CNT     (3U)
+
+#define FD_QUIC_CC_BBR_STATE_STARTUP  (0U)
+#define FD_QUIC_CC_BBR_STATE_DRAIN    (1U)
+#define FD_QUIC_CC_BBR_STATE_PROBE_BW (2U)
+
+/* FD_QUIC_CC_BBR_BW_WIN is the number of rounds over which the
+   bottleneck bandwidth max filter runs. */
+
+#define FD_QUIC_CC_BBR_BW_WIN (10UL)
+
+struct fd_quic_cc {
+  uint  algo;           /* FD_QUIC_CC_ALGO_{...} */
+  uint  bbr_state;      /* FD_QUIC_CC_BBR_STATE_{...} */
+
+  ulong mss;            /* max datagram size */
+  ulong cwnd;           /* congestion window in bytes */
+  ulong cwnd_min;       /* minimum congestion window in bytes */
+  ulong inflight;       /* bytes in flight */
+
+  /* NewReno */
+  ulong ssthresh;       /* slow start threshold in bytes */
+  ulong ca_acked;       /* bytes acked since last cwnd increase in congestion avoidance */
+  ulong recovery_start; /* packets sent at or before this time do not trigger another reduction */
+  int   in_recovery;
+
+  /* BBR */
+  ulong delivered;       /* total bytes acked */
+  ulong round_start;     /* start time of current round */
+  ulong round_delivered; /* value of delivered at round_start */
+  ulong round_cnt;       /* number of completed rounds */
+  float bw_win[ FD_QUIC_CC_BBR_BW_WIN ]; /* per-round max delivery rate (bytes per tick) */
+  float btl_bw;          /* bottleneck bandwidth estimate (bytes per tick) */
+  float full_bw;         /* btl_bw at last significant STARTUP growth */
+  ulong full_bw_cnt;     /* rounds without significant growth */
+  uint  cycle_idx;       /* PROBE_BW gain cycle index */
+  float pacing_gain;
+  float cwnd_gain;
+  float min_rtt;         /* last min_rtt seen (ticks) */
+
+  /* Pacer (rate in bytes per tick, burst in bytes) */
+  fd_token_bucket_t pacer[1];
+};
+
+typedef struct fd_quic_cc fd_quic_cc_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_quic_cc_init initializes cc with the given algorithm, max
+   datagram size, initial RTT estimate (ticks) and current time.
+   Returns cc. */
+
+fd_quic_cc_t *
+fd_quic_cc_init( fd_quic_cc_t * cc,
+                 uint           algo,
+                 ulong          mss,
+                 float          rtt,
+                 ulong          now );
+
+/* fd_quic_cc_algo_cstr returns a static cstr describing algo. */
+
+char const *
+fd_quic_cc_algo_cstr( uint algo );
+
+/* fd_quic_cc_can_send returns 1 if the congestion window and the pacer
+   allow sending another max size datagram at time now, and 0
+   otherwise.  On success, one mss worth of pacing tokens is consumed.
+   Always returns 1 for FD_QUIC_CC_ALGO_NONE. */
+
+int
+fd_quic_cc_can_send( fd_quic_cc_t * cc,
+                     ulong          now );
+
+/* fd_quic_cc_next_send returns the earliest time at which the pacer
+   will allow another datagram, assuming the cwnd is not the limiting
+   factor.  Returns now if sending is already allowed. */
+
+ulong
+fd_quic_cc_next_send( fd_quic_cc_t const * cc,
+                      ulong                now );
+
+/* fd_quic_cc_on_send records an ack-eliciting datagram of sz bytes
+   as in flight. */
+
+static inline void
+fd_quic_cc_on_send( fd_quic_cc_t * cc,
+                    ulong          sz ) {
+  cc->inflight += sz;
+}
+
+/* fd_quic_cc_on_discard removes sz bytes from flight without
+   signalling congestion (e.g. abandoned packet number space). */
+
+static inline void
+fd_quic_cc_on_discard( fd_quic_cc_t * cc,
+                       ulong          sz ) {
+  cc->inflight -= fd_ulong_min( cc->inflight, sz );
+}
+
+/* fd_quic_cc_on_ack processes acknowledgement of acked_sz bytes, the
+   most recent of which was sent at time sent_time.  srtt and min_rtt
+   are the conn's current RTT estimates in ticks. */
+
+void
+fd_quic_cc_on_ack( fd_quic_cc_t * cc,
+                   ulong          acked_sz,
+                   ulong          sent_time,
+                   ulong          now,
+                   float          srtt,
+                   float          min_rtt );
+
+/* fd_quic_cc_on_loss processes loss of lost_sz bytes, the most recent
+   of which was sent at time sent_time. */
+
+void
+fd_quic_cc_on_loss( fd_quic_cc_t * cc,
+                    ulong          lost_sz,
+                    ulong          sent_time,
+                    ulong          now,
+                    float          srtt );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_waltz_quic_fd_quic_cc_h */
@@ -8,6 +8,7 @@
 #include "crypto/fd_quic_crypto_suites.h"
 #include "fd_quic_pkt_meta.h"
 #include "fd_quic_svc_q.h"
+#include "fd_quic_cc.h"
 
 #define FD_QUIC_CONN_STATE_INVALID            0 /* dead object / freed */
 #define FD_QUIC_CONN_STATE_HANDSHAKE          1 /* currently doing handshaking with peer */
@@ -239,6 +240,9 @@ struct fd_quic_conn {
   /* round trip time related members */
   fd_quic_conn_rtt_t rtt[1];
 
+  /* congestion control and pacing (see config.cc_algo) */
+  fd_quic_cc_t       cc[1];
+
   ulong token_len;
   uchar token[ FD_QUIC_RETRY_MAX_TOKEN_SZ ];
 
@@ -66,6 +66,8 @@ struct fd_quic_pkt_meta {
   fd_quic_pkt_meta_value_t val;
   uchar                    enc_level: 2;
   uchar                    pn_space;    /* packet number space (derived from enc_level) */
+  ushort                   sz;          /* datagram bytes counted in flight for congestion
+                                           control, set on at most one pkt_meta per packet */
   ulong                    tx_time;     /* transmit time */
   ulong                    expiry;      /* time pkt_meta expires... this is the time the
                                          ack is expected by */
@@ -106,6 +106,13 @@ struct __attribute__((aligned(16UL))) fd_quic_state_private {
   /* Scratch space for packet protection */
   uchar                   crypt_scratch[FD_QUIC_MTU];
 
+  /* Outgoing datagrams pending fd_quic_tx_flush (config.net.tx_batch).
+     tx_flush_busy is set while the batch is being handed to aio_tx. */
+  ulong                   tx_batch_cnt;
+  int                     tx_flush_busy;
+  fd_aio_pkt_info_t       tx_batch    [FD_QUIC_TX_BATCH_MAX];
+  uchar                   tx_batch_buf[FD_QUIC_TX_BATCH_MAX][FD_QUIC_MTU];
+
   /* the timer structs, large private fields / data follow */
   fd_quic_svc_timers_t  * svc_timers;
 };
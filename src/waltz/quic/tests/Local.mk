@@ -11,22 +11,26 @@ $(call make-unit-test,test_quic_streams,    test_quic_streams,    $(QUIC_TEST_LI
 $(call make-unit-test,test_quic_conn,       test_quic_conn,       $(QUIC_TEST_LIBS))
 $(call make-unit-test,test_quic_drops,      test_quic_drops,      $(QUIC_TEST_LIBS) fd_fibre)
 $(call make-unit-test,test_quic_bw,         test_quic_bw,         $(QUIC_TEST_LIBS))
+$(call make-unit-test,test_quic_tx_batch,   test_quic_tx_batch,   $(QUIC_TEST_LIBS))
 $(call make-unit-test,test_quic_layout,     test_quic_layout,     fd_util)
 $(call make-unit-test,test_quic_conformance,test_quic_conformance,$(QUIC_TEST_LIBS) fd_util)
 $(call make-unit-test,test_quic_ack_tx,     test_quic_ack_tx,     $(QUIC_TEST_LIBS))
 $(call make-unit-test,test_quic_concurrency,test_quic_concurrency,$(QUIC_TEST_LIBS))
 $(call make-unit-test,test_quic_svc_q,test_quic_svc_q,$(QUIC_TEST_LIBS))
 $(call make-unit-test,test_quic_pkt_meta,test_quic_pkt_meta,$(QUIC_TEST_LIBS))
+$(call make-unit-test,test_quic_cc,test_quic_cc,$(QUIC_TEST_LIBS))
 $(call run-unit-test,test_quic_proto)
 $(call run-unit-test,test_quic_hs)
 $(call run-unit-test,test_quic_streams)
 $(call run-unit-test,test_quic_conn)
 $(call run-unit-test,test_quic_bw)
+$(call run-unit-test,test_quic_tx_batch)
 $(call run-unit-test,test_quic_layout)
 $(call run-unit-test,test_quic_ack_tx)
 $(call run-unit-test,test_quic_concurrency)
 $(call run-unit-test,test_quic_svc_q)
 $(call run-unit-test,test_quic_pkt_meta)
+$(call run-unit-test,test_quic_cc)
 
 # fd_quic_tls unit tests
 $(call make-unit-test,test_quic_tls_hs,test_quic_tls_hs,$(QUIC_TEST_LIBS))
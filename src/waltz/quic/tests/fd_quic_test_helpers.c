@@ -529,3 +529,85 @@ fd_quic_netem_send( void *                    ctx, /* fd_quic_net_em_t */
 
   return FD_AIO_SUCCESS;
 }
+
+static int
+fd_quic_netlink_send( void *                    ctx,
+                      fd_aio_pkt_info_t const * batch,
+                      ulong                     batch_cnt,
+                      ulong *                   opt_batch_idx FD_PARAM_UNUSED,
+                      int                       flush FD_PARAM_UNUSED ) {
+  fd_quic_netlink_t * link = ctx;
+  ulong now = *link->now;
+
+  for( ulong j=0UL; j<batch_cnt; j++ ) {
+    ulong sz = batch[j].buf_sz;
+    link->tx_cnt++;
+    link->tx_sz += sz;
+
+    float rnd = (float)fd_rng_private_expand( link->seed++ ) * (float)0x1p-64;
+    if( rnd < link->loss ) {
+      link->loss_drop_cnt++;
+      continue;
+    }
+
+    /* count packets still waiting to be serialized */
+    ulong backlog = 0UL;
+    for( ulong idx=link->tail; idx!=link->head && backlog<link->depth; idx-- ) {
+      fd_quic_netlink_pkt_t const * pkt = &link->slot[ (idx-1UL) % FD_QUIC_NETLINK_SLOT_MAX ];
+      if( pkt->deliver_ts - link->delay <= now ) break;
+      backlog++;
+    }
+    if( backlog>=link->depth || link->tail-link->head>=FD_QUIC_NETLINK_SLOT_MAX || sz>FD_QUIC_MTU ) {
+      link->queue_drop_cnt++;
+      continue;
+    }
+
+    link->busy_until = fd_ulong_max( link->busy_until, now ) + (ulong)( (float)sz / link->rate );
+
+    fd_quic_netlink_pkt_t * pkt = &link->slot[ link->tail % FD_QUIC_NETLINK_SLOT_MAX ];
+    pkt->deliver_ts = link->busy_until + link->delay;
+    pkt->sz         = (ushort)sz;
+    fd_memcpy( pkt->buf, batch[j].buf, sz );
+    link->tail++;
+  }
+
+  return FD_AIO_SUCCESS;
+}
+
+fd_quic_netlink_t *
+fd_quic_netlink_init( fd_quic_netlink_t * link,
+                      fd_aio_t const *    dst,
+                      ulong const *       now,
+                      float               rate,
+                      ulong               delay,
+                      ulong               depth,
+                      float               loss,
+                      uint                seed ) {
+  memset( link, 0, sizeof(fd_quic_netlink_t) );
+  link->dst   = dst;
+  link->now   = now;
+  link->rate  = rate;
+  link->delay = delay;
+  link->depth = depth;
+  link->loss  = loss;
+  link->seed  = seed;
+  fd_aio_new( &link->local, link, fd_quic_netlink_send );
+  return link;
+}
+
+ulong
+fd_quic_netlink_pump( fd_quic_netlink_t * link ) {
+  ulong now = *link->now;
+  ulong cnt = 0UL;
+  while( link->head!=link->tail ) {
+    fd_quic_netlink_pkt_t const * pkt = &link->slot[ link->head % FD_QUIC_NETLINK_SLOT_MAX ];
+    if( pkt->deliver_ts > now ) break;
+    fd_aio_pkt_info_t info[1] = {{ .buf = (void *)pkt->buf, .buf_sz = pkt->sz }};
+    link->head++;
+    link->rx_cnt++;
+    link->rx_sz += pkt->sz;
+    cnt++;
+    fd_aio_send( link->dst, info, 1UL, NULL, 1 );
+  }
+  return cnt;
+}
@@ -198,6 +198,76 @@ fd_quic_netem_send( void *                    ctx, /* fd_quic_net_em_t */
                     ulong *                   opt_batch_idx,
                     int                       flush );
 
+/* fd_quic_netlink simulates a lossy bottleneck link for congestion
+   control tests.  Packets sent to it are randomly dropped (loss),
+   serialized at a fixed rate, held for a fixed propagation delay, and
+   then forwarded to dst by fd_quic_netlink_pump.  Packets arriving
+   while more than depth packets are waiting for serialization are
+   dropped (drop-tail queue).  Time is read from *now, which the caller
+   advances (typically the same virtual clock given to fd_quic). */
+
+#define FD_QUIC_NETLINK_SLOT_MAX (4096UL)
+
+struct fd_quic_netlink_pkt {
+  ulong  deliver_ts;
+  ushort sz;
+  uchar  buf[ FD_QUIC_MTU ];
+};
+
+typedef struct fd_quic_netlink_pkt fd_quic_netlink_pkt_t;
+
+struct fd_quic_netlink {
+  fd_aio_t         local;
+  fd_aio_t const * dst;
+  ulong const *    now;
+
+  float rate;       /* bytes per tick */
+  ulong delay;      /* one-way propagation delay in ticks */
+  ulong depth;      /* drop-tail queue depth in packets */
+  float loss;       /* random loss probability */
+  ulong busy_until; /* time at which the last queued packet is serialized */
+  uint  seed;
+
+  ulong head;       /* next slot to deliver */
+  ulong tail;       /* next slot to fill */
+
+  ulong tx_cnt;         /* packets offered */
+  ulong tx_sz;          /* bytes offered */
+  ulong queue_drop_cnt; /* packets dropped due to queue overflow */
+  ulong loss_drop_cnt;  /* packets dropped randomly */
+  ulong rx_cnt;         /* packets delivered */
+  ulong rx_sz;          /* bytes delivered */
+
+  fd_quic_netlink_pkt_t slot[ FD_QUIC_NETLINK_SLOT_MAX ];
+};
+
+typedef struct fd_quic_netlink fd_quic_netlink_t;
+
+fd_quic_netlink_t *
+fd_quic_netlink_init( fd_quic_netlink_t * link,
+                      fd_aio_t const *    dst,
+                      ulong const *       now,
+                      float               rate,
+                      ulong               delay,
+                      ulong               depth,
+                      float               loss,
+                      uint                seed );
+
+/* fd_quic_netlink_pump forwards all packets due at *now to dst.
+   Returns the number of packets delivered. */
+
+ulong
+fd_quic_netlink_pump( fd_quic_netlink_t * link );
+
+/* fd_quic_netlink_next returns the delivery time of the next queued
+   packet or ULONG_MAX if the link is idle. */
+
+static inline ulong
+fd_quic_netlink_next( fd_quic_netlink_t const * link ) {
+  if( link->head==link->tail ) return ULONG_MAX;
+  return link->slot[ link->head % FD_QUIC_NETLINK_SLOT_MAX ].deliver_ts;
+}
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_waltz_quic_tests_fd_quic_helpers_h */
@@ -95,7 +95,10 @@ main( int     argc,
   float        reorder  = fd_env_strip_cmdline_float ( &argc, &argv, "--reorder",   NULL, 0.0f                         );
   float        duration = fd_env_strip_cmdline_float ( &argc, &argv, "--duration",  NULL, 10.0f                        );
   ushort       sz       = fd_env_strip_cmdline_ushort( &argc, &argv, "--sz",        NULL, FRAG_SZ                      );
+  uint         tx_batch = fd_env_strip_cmdline_uint  ( &argc, &argv, "--tx-batch",  NULL, 0U                           );
+  ulong        burst    = fd_env_strip_cmdline_ulong ( &argc, &argv, "--burst",     NULL, 1UL                          );
   FD_TEST( sz<=FRAG_SZ );
+  FD_TEST( tx_batch<=FD_QUIC_TX_BATCH_MAX );
 
   ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
   if( FD_UNLIKELY( !page_sz ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
@@ -148,6 +151,10 @@ main( int     argc,
 
   server_quic->config.initial_rx_max_stream_data = FRAG_SZ;
 
+  FD_LOG_NOTICE(( "Using --tx-batch %u --burst %lu", tx_batch, burst ));
+  server_quic->config.net.tx_batch = tx_batch;
+  client_quic->config.net.tx_batch = tx_batch;
+
   FD_LOG_NOTICE(( "Creating virtual pair" ));
   fd_quic_virtual_pair_t vp;
   fd_quic_virtual_pair_init( &vp, /*a*/ client_quic, /*b*/ server_quic );
@@ -207,19 +214,30 @@ main( int     argc,
   long last_ts = fd_log_wallclock();
   long rprt_ts = fd_log_wallclock() + (long)1e9;
 
+  /* txn_cnt counts streams (i.e. transactions) sent by the client.
+     Client aio_tx send calls per 1k txns approximates the syscall cost
+     of a sendmmsg based or GSO based sender (see --tx-batch). */
+  ulong txn_cnt = 0UL;
+  ulong client_tx_pkt_cnt0   = client_quic->metrics.net_tx_pkt_cnt;
+  ulong client_tx_batch_cnt0 = client_quic->metrics.net_tx_batch_cnt;
+
   long start_ts = fd_log_wallclock();
   long end_ts   = start_ts + (long)(duration * 1e9f);
   while(1) {
     service_client( client_quic );
     service_server( server_quic );
 
-    client_stream = fd_quic_conn_new_stream( client_conn );
     if( client_conn->state != FD_QUIC_CONN_STATE_ACTIVE ) {
       FD_LOG_NOTICE(( "Early break due to inactive connection"));
       break;
     }
-    else if( !client_stream ) continue;
-    fd_quic_stream_send( client_stream, buf, sz, 1 );
+
+    /* queue up to burst txns per service pass */
+    for( ulong j=0UL; j<burst; j++ ) {
+      client_stream = fd_quic_conn_new_stream( client_conn );
+      if( !client_stream ) break;
+      txn_cnt += fd_quic_stream_send( client_stream, buf, sz, 1 )==FD_QUIC_SUCCESS;
+    }
 
     long t = fd_log_wallclock();
     if( t >= rprt_ts ) {
@@ -237,6 +255,17 @@ main( int     argc,
                       (double)net_rx_gbps, (double)net_rx_gpps * 1e3,
                       (double)net_tx_gbps, (double)net_tx_gpps * 1e3,
                       (double)rx_tot_sz ));
+      ulong client_tx_pkt_cnt   = client_quic->metrics.net_tx_pkt_cnt   - client_tx_pkt_cnt0;
+      ulong client_tx_batch_cnt = client_quic->metrics.net_tx_batch_cnt - client_tx_batch_cnt0;
+      FD_LOG_NOTICE(( "client_tx=(%6.4g Mpps  %6.4g pkt/send  %6.4g sends/1k txns)  txns=%lu",
+                      (double)client_tx_pkt_cnt / (double)dt * 1e3,
+                      (double)client_tx_pkt_cnt / (double)fd_ulong_max( client_tx_batch_cnt, 1UL ),
+                      1e3 * (double)client_tx_batch_cnt / (double)fd_ulong_max( txn_cnt, 1UL ),
+                      txn_cnt ));
+      client_tx_pkt_cnt0   = client_quic->metrics.net_tx_pkt_cnt;
+      client_tx_batch_cnt0 = client_quic->metrics.net_tx_batch_cnt;
+      txn_cnt              = 0UL;
+
       server_quic->metrics.net_rx_byte_cnt = 0;
       server_quic->metrics.net_rx_pkt_cnt  = 0;
       server_quic->metrics.net_tx_byte_cnt = 0;
@@ -0,0 +1,381 @@
+/* test_quic_cc tests fd_quic congestion control and pacing.
+
+   The first part exercises fd_quic_cc_t directly with synthetic
+   send/ack/loss events.  The second part runs a client blasting
+   transactions at a server across a simulated lossy bottleneck link
+   (fd_quic_netlink_t) driven by a virtual clock, once per congestion
+   control algorithm, and compares queue drops and retransmissions. */
+
+#include "../fd_quic.h"
+#include "../fd_quic_cc.h"
+#include "fd_quic_test_helpers.h"
+
+#define MSS (1472UL)
+
+static void
+test_cc_newreno( void ) {
+  fd_quic_cc_t cc[1];
+  fd_quic_cc_init( cc, FD_QUIC_CC_ALGO_NEWRENO, MSS, 1e6f, 0UL );
+  FD_TEST( cc->cwnd==14720UL );
+  FD_TEST( cc->cwnd_min==2UL*MSS );
+
+  /* cwnd limits inflight */
+  ulong now = 1000000000UL;
+  ulong sent = 0UL;
+  while( fd_quic_cc_can_send( cc, now ) || cc->inflight<cc->cwnd ) {
+    fd_quic_cc_on_send( cc, MSS );
+    sent++;
+    now += 1000000UL; /* refill pacer */
+    FD_TEST( sent<=10UL );
+  }
+  FD_TEST( sent==10UL );
+  FD_TEST( !fd_quic_cc_can_send( cc, now ) );
+
+  /* slow start: cwnd grows by acked bytes */
+  fd_quic_cc_on_ack( cc, 5UL*MSS, now, now, 1e6f, 1e6f );
+  FD_TEST( cc->cwnd==14720UL+5UL*MSS );
+  FD_TEST( cc->inflight==5UL*MSS );
+
+  /* loss halves the window and starts recovery */
+  ulong cwnd0 = cc->cwnd;
+  fd_quic_cc_on_loss( cc, MSS, now-1UL, now, 1e6f );
+  FD_TEST( cc->in_recovery );
+  FD_TEST( cc->cwnd==cwnd0/2UL );
+  FD_TEST( cc->ssthresh==cc->cwnd );
+  FD_TEST( cc->inflight==4UL*MSS );
+
+  /* more losses from before recovery started are ignored */
+  ulong cwnd1 = cc->cwnd;
+  fd_quic_cc_on_loss( cc, MSS, now, now+1UL, 1e6f );
+  FD_TEST( cc->cwnd==cwnd1 );
+
+  /* acks for packets sent before recovery do not grow cwnd */
+  fd_quic_cc_on_ack( cc, MSS, now, now+2UL, 1e6f, 1e6f );
+  FD_TEST( cc->cwnd==cwnd1 );
+
+  /* congestion avoidance: one mss per cwnd acked */
+  now += 10000000UL;
+  ulong acked = 0UL;
+  while( acked<cwnd1 ) {
+    FD_TEST( cc->cwnd==cwnd1 );
+    fd_quic_cc_on_ack( cc, MSS, now, now, 1e6f, 1e6f );
+    acked += MSS;
+  }
+  FD_TEST( cc->cwnd==cwnd1+MSS );
+  FD_TEST( !cc->in_recovery );
+
+  /* repeated loss never shrinks below the minimum window */
+  for( ulong j=0UL; j<16UL; j++ ) {
+    now += 1000UL;
+    fd_quic_cc_on_loss( cc, 0UL, now, now+1UL, 1e6f );
+  }
+  FD_TEST( cc->cwnd==cc->cwnd_min );
+
+  FD_LOG_NOTICE(( "newreno: pass" ));
+}
+
+static void
+test_cc_pacer( void ) {
+  fd_quic_cc_t cc[1];
+  fd_quic_cc_init( cc, FD_QUIC_CC_ALGO_NEWRENO, MSS, 1e6f, 0UL );
+  cc->cwnd = ULONG_MAX/2UL; /* only test the pacer */
+
+  /* the bucket starts full and allows a short burst */
+  ulong now = 0UL;
+  ulong burst = 0UL;
+  while( fd_quic_cc_can_send( cc, now ) ) burst++;
+  FD_TEST( burst==4UL );
+
+  /* next_send predicts when the next datagram may go out */
+  for( ulong j=0UL; j<64UL; j++ ) {
+    ulong next = fd_quic_cc_next_send( cc, now );
+    FD_TEST( next>now );
+    FD_TEST( !fd_quic_cc_can_send( cc, next-1UL ) );
+    FD_TEST(  fd_quic_cc_can_send( cc, next     ) );
+    FD_TEST( fd_quic_cc_next_send( cc, next )>next );
+    now = next;
+  }
+
+  /* pacing rate is 1.25*cwnd/srtt */
+  fd_quic_cc_init( cc, FD_QUIC_CC_ALGO_NEWRENO, MSS, 1e6f, 0UL );
+  FD_TEST( fabsf( cc->pacer->rate - 1.25f*14720.0f/1e6f )<1e-6f );
+
+  /* cc disabled: no limits */
+  fd_quic_cc_init( cc, FD_QUIC_CC_ALGO_NONE, MSS, 1e6f, 0UL );
+  for( ulong j=0UL; j<1000UL; j++ ) {
+    FD_TEST( fd_quic_cc_can_send( cc, 0UL ) );
+    fd_quic_cc_on_send( cc, MSS );
+  }
+  FD_TEST( fd_quic_cc_next_send( cc, 7UL )==7UL );
+
+  FD_LOG_NOTICE(( "pacer: pass" ));
+}
+
+static void
+test_cc_bbr( void ) {
+  fd_quic_cc_t cc[1];
+  float rtt = 1e6f;
+  fd_quic_cc_init( cc, FD_QUIC_CC_ALGO_BBR, MSS, rtt, 0UL );
+  FD_TEST( cc->bbr_state==FD_QUIC_CC_BBR_STATE_STARTUP );
+
+  /* Model a paced sender on a path with a fixed bottleneck rate of
+     0.01 bytes per tick.  A packet sent at t is acked at
+     max(t+rtt, previous ack+serialization time). */
+  static ulong ack_ts[ 4096 ];
+  ulong head = 0UL, tail = 0UL;
+  float bw   = 0.01f;
+  ulong step = (ulong)( (float)MSS / bw );
+  ulong last = 0UL;
+  for( ulong now=0UL; now<200UL*(ulong)rtt; now+=step/8UL ) {
+    while( fd_quic_cc_can_send( cc, now ) ) {
+      FD_TEST( tail-head<4096UL );
+      fd_quic_cc_on_send( cc, MSS );
+      last = fd_ulong_max( now+(ulong)rtt, last+step );
+      ack_ts[ tail++ % 4096UL ] = last;
+    }
+    while( head!=tail && ack_ts[ head % 4096UL ]<=now ) {
+      fd_quic_cc_on_ack( cc, MSS, now, now, rtt, rtt );
+      head++;
+    }
+  }
+  ulong now = 200UL*(ulong)rtt;
+  FD_TEST( cc->bbr_state==FD_QUIC_CC_BBR_STATE_PROBE_BW );
+  FD_TEST( cc->btl_bw>=bw*0.9f && cc->btl_bw<=bw*1.1f );
+
+  /* cwnd converges to cwnd_gain*BDP */
+  float bdp = cc->btl_bw * rtt;
+  FD_TEST( (float)cc->cwnd<=2.0f*bdp+(float)MSS );
+  FD_TEST( (float)cc->cwnd>=1.5f*bdp );
+
+  /* loss does not shrink the BBR model */
+  ulong cwnd0 = cc->cwnd;
+  fd_quic_cc_on_loss( cc, MSS, now, now, rtt );
+  FD_TEST( cc->cwnd==cwnd0 );
+
+  FD_LOG_NOTICE(( "bbr: pass (btl_bw=%g B/tick cwnd=%lu)", (double)cc->btl_bw, cc->cwnd ));
+}
+
+/* Simulated link test ************************************************/
+
+static ulong sim_now;
+
+static ulong
+sim_clock( void * ctx ) {
+  (void)ctx;
+  return sim_now;
+}
+
+static ulong sim_rx_txn_cnt;
+static int   sim_server_complete;
+static int   sim_client_complete;
+
+static int
+sim_stream_rx( fd_quic_conn_t * conn,
+               ulong            stream_id,
+               ulong            offset,
+               uchar const *    data,
+               ulong            data_sz,
+               int              fin ) {
+  (void)conn; (void)stream_id; (void)offset; (void)data; (void)data_sz;
+  sim_rx_txn_cnt += !!fin;
+  return FD_QUIC_SUCCESS;
+}
+
+static void
+sim_conn_new( fd_quic_conn_t * conn,
+              void *           ctx ) {
+  (void)conn; (void)ctx;
+  sim_server_complete = 1;
+}
+
+static void
+sim_hs_complete( fd_quic_conn_t * conn,
+                 void *           ctx ) {
+  (void)conn; (void)ctx;
+  sim_client_complete = 1;
+}
+
+/* Link parameters: 100 Mbps bottleneck, 10ms RTT, 32 packet queue
+   (i.e. a queue shallower than the BDP, as on a busy NIC), 0.1% random
+   loss.  Time is in ns. */
+
+#define SIM_RATE     (0.0125f)
+#define SIM_DELAY    (5000000UL)
+#define SIM_DEPTH    (32UL)
+#define SIM_LOSS     (0.001f)
+#define SIM_DURATION (2000000000UL)
+#define SIM_TXN_SZ   (1000UL)
+
+struct sim_result {
+  ulong rx_txn_cnt;
+  ulong queue_drop_cnt;
+  ulong loss_drop_cnt;
+  ulong retx_cnt;
+  ulong cc_blocked_cnt;
+  ulong tx_pkt_cnt;
+  float link_util;
+};
+
+typedef struct sim_result sim_result_t;
+
+static fd_quic_netlink_t sim_link_a2b;
+static fd_quic_netlink_t sim_link_b2a;
+
+static sim_result_t
+test_sim( fd_wksp_t * wksp,
+          fd_rng_t *  rng,
+          uint        cc_algo ) {
+  sim_now             = 1UL;
+  sim_rx_txn_cnt      = 0UL;
+  sim_server_complete = 0;
+  sim_client_complete = 0;
+
+  fd_quic_limits_t const server_limits = {
+    .conn_cnt           = 1,
+    .conn_id_cnt        = 4,
+    .handshake_cnt      = 1,
+    .stream_id_cnt      = 512,
+    .stream_pool_cnt    = 1,
+    .inflight_frame_cnt = 256,
+  };
+  fd_quic_t * server = fd_quic_new_anonymous( wksp, &server_limits, FD_QUIC_ROLE_SERVER, rng );
+  FD_TEST( server );
+
+  fd_quic_limits_t const client_limits = {
+    .conn_cnt           = 1,
+    .conn_id_cnt        = 4,
+    .handshake_cnt      = 1,
+    .stream_id_cnt      = 512,
+    .stream_pool_cnt    = 512,
+    .inflight_frame_cnt = 2048,
+    .tx_buf_sz          = SIM_TXN_SZ
+  };
+  fd_quic_t * client = fd_quic_new_anonymous( wksp, &client_limits, FD_QUIC_ROLE_CLIENT, rng );
+  FD_TEST( client );
+
+  server->cb.conn_new         = sim_conn_new;
+  server->cb.stream_rx        = sim_stream_rx;
+  client->cb.conn_hs_complete = sim_hs_complete;
+  client->config.cc_algo      = cc_algo;
+
+  /* ACK every other packet (RFC 9000 Section 13.2.2), otherwise ACK
+     clocking is dominated by the ACK delay */
+  server->config.ack_delay     = 1000000UL;
+  server->config.ack_threshold = 2UL*MSS;
+
+  fd_quic_netlink_init( &sim_link_a2b, fd_quic_get_aio_net_rx( server ), &sim_now, SIM_RATE, SIM_DELAY, SIM_DEPTH, SIM_LOSS, 1U );
+  fd_quic_netlink_init( &sim_link_b2a, fd_quic_get_aio_net_rx( client ), &sim_now, SIM_RATE, SIM_DELAY, SIM_DEPTH, SIM_LOSS, 2U );
+  fd_quic_set_aio_net_tx( client, &sim_link_a2b.local );
+  fd_quic_set_aio_net_tx( server, &sim_link_b2a.local );
+
+  fd_quic_set_clock( server, sim_clock, NULL, 1000.0 );
+  fd_quic_set_clock( client, sim_clock, NULL, 1000.0 );
+  FD_TEST( fd_quic_init( server ) );
+  FD_TEST( fd_quic_init( client ) );
+
+  fd_quic_conn_t * conn = fd_quic_connect( client, 0U, 0, 0U, 0 );
+  FD_TEST( conn );
+
+  static uchar txn[ SIM_TXN_SZ ];
+  ulong end = sim_now + SIM_DURATION;
+  while( sim_now<end ) {
+    if( conn->state==FD_QUIC_CONN_STATE_ACTIVE ) {
+      /* blast as many txns as the stream limits allow */
+      for(;;) {
+        fd_quic_stream_t * stream = fd_quic_conn_new_stream( conn );
+        if( !stream ) break;
+        FD_TEST( fd_quic_stream_send( stream, txn, SIM_TXN_SZ, 1 )==FD_QUIC_SUCCESS );
+      }
+    } else if( sim_client_complete ) {
+      break;
+    }
+
+    fd_quic_service( client );
+    fd_quic_service( server );
+    fd_quic_netlink_pump( &sim_link_a2b );
+    fd_quic_netlink_pump( &sim_link_b2a );
+
+    /* advance the virtual clock to the next event, in steps of at
+       least 1us and at most 1ms */
+    ulong next = fd_quic_get_next_wakeup( client );
+    next = fd_ulong_min( next, fd_quic_get_next_wakeup( server ) );
+    next = fd_ulong_min( next, fd_quic_netlink_next( &sim_link_a2b ) );
+    next = fd_ulong_min( next, fd_quic_netlink_next( &sim_link_b2a ) );
+    sim_now = fd_ulong_max( sim_now+1000UL, fd_ulong_min( next, sim_now+1000000UL ) );
+  }
+
+  FD_TEST( sim_server_complete && sim_client_complete );
+  FD_TEST( conn->state==FD_QUIC_CONN_STATE_ACTIVE );
+
+  sim_result_t res = {
+    .rx_txn_cnt     = sim_rx_txn_cnt,
+    .queue_drop_cnt = sim_link_a2b.queue_drop_cnt,
+    .loss_drop_cnt  = sim_link_a2b.loss_drop_cnt,
+    .retx_cnt       = client->metrics.pkt_retransmissions_cnt,
+    .cc_blocked_cnt = client->metrics.pkt_cc_blocked_cnt,
+    .tx_pkt_cnt     = sim_link_a2b.tx_cnt,
+    .link_util      = (float)sim_link_a2b.rx_sz / ( SIM_RATE*(float)SIM_DURATION )
+  };
+
+  FD_LOG_NOTICE(( "%-8s rx_txns=%6lu link_util=%5.1f%% tx_pkts=%6lu queue_drops=%5lu loss_drops=%3lu retx=%5lu cc_blocked=%lu",
+                  fd_quic_cc_algo_cstr( cc_algo ),
+                  res.rx_txn_cnt, (double)res.link_util*100.0,
+                  res.tx_pkt_cnt, res.queue_drop_cnt, res.loss_drop_cnt,
+                  res.retx_cnt, res.cc_blocked_cnt ));
+
+  fd_wksp_free_laddr( fd_quic_delete( fd_quic_leave( fd_quic_fini( client ) ) ) );
+  fd_wksp_free_laddr( fd_quic_delete( fd_quic_leave( fd_quic_fini( server ) ) ) );
+  return res;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot          ( &argc, &argv );
+  fd_quic_test_boot( &argc, &argv );
+
+  ulong cpu_idx = fd_tile_cpu_id( fd_tile_idx() );
+  if( cpu_idx>fd_shmem_cpu_cnt() ) cpu_idx = 0UL;
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "gigantic"                   );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 1UL                          );
+  ulong        numa_idx = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx", NULL, fd_shmem_numa_idx( cpu_idx ) );
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  test_cc_newreno();
+  test_cc_pacer();
+  test_cc_bbr();
+
+  FD_LOG_NOTICE(( "Creating workspace (--page-cnt %lu, --page-sz %s, --numa-idx %lu)", page_cnt, _page_sz, numa_idx ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  FD_LOG_NOTICE(( "Simulating 100 Mbps link, 10 ms RTT, %lu pkt queue, %g loss", SIM_DEPTH, (double)SIM_LOSS ));
+  sim_result_t none    = test_sim( wksp, rng, FD_QUIC_CC_ALGO_NONE    );
+  sim_result_t newreno = test_sim( wksp, rng, FD_QUIC_CC_ALGO_NEWRENO );
+  sim_result_t bbr     = test_sim( wksp, rng, FD_QUIC_CC_ALGO_BBR     );
+
+  /* congestion control avoids overflowing the bottleneck queue */
+  FD_TEST( newreno.rx_txn_cnt>0UL );
+  FD_TEST( bbr.rx_txn_cnt    >0UL );
+  FD_TEST( newreno.queue_drop_cnt*4UL < none.queue_drop_cnt );
+  FD_TEST( bbr.queue_drop_cnt*4UL     < none.queue_drop_cnt );
+  FD_TEST( newreno.retx_cnt < none.retx_cnt );
+  FD_TEST( bbr.retx_cnt     < none.retx_cnt );
+  FD_TEST( bbr.link_util>0.5f );
+  FD_TEST( newreno.cc_blocked_cnt>0UL );
+  FD_TEST( bbr.cc_blocked_cnt    >0UL );
+  FD_TEST( none.cc_blocked_cnt==0UL );
+
+  fd_wksp_delete_anonymous( wksp );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_quic_test_halt();
+  fd_halt();
+  return 0;
+}
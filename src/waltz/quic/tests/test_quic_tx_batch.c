@@ -0,0 +1,251 @@
+/* test_quic_tx_batch checks that batched transmit (config.net.tx_batch)
+   survives aio_tx calling back into the sending quic.  A virtual pair
+   delivers each datagram synchronously, so the peer may transmit (and
+   flush) while the sender's own fd_aio_send is still on the stack.
+
+   The interposed aio below snapshots every batch before forwarding it
+   and verifies that no datagram is modified before it was delivered.
+   While the server's top-level flush is in progress, it also replays
+   the client's first Initial into the server, which makes the server
+   send a Retry from within its RX callback, i.e. re-entrantly. */
+
+#include "../fd_quic.h"
+#include "../fd_quic_private.h"
+#include "fd_quic_test_helpers.h"
+
+#define DEPTH_MAX (4UL)
+
+struct check_aio {
+  fd_aio_t         self[1];
+  fd_aio_t const * dst;
+  ulong            batch_cnt;   /* sends with more than one datagram */
+  ulong            pkt_cnt;
+};
+typedef struct check_aio check_aio_t;
+
+static ulong             send_depth;  /* sends currently on the stack */
+static ulong             nested_cnt;  /* sends observed during another send */
+
+static uchar             initial_buf[ FD_QUIC_MTU ];
+static fd_aio_pkt_info_t initial_pkt;
+static fd_aio_t const *  inject_dst;  /* server RX, NULL to disable */
+static ulong             inject_rem;
+
+static int
+check_aio_send( void *                    ctx,
+                fd_aio_pkt_info_t const * batch,
+                ulong                     batch_cnt,
+                ulong *                   opt_batch_idx,
+                int                       flush ) {
+  check_aio_t * chk = ctx;
+  FD_TEST( batch_cnt<=FD_QUIC_TX_BATCH_MAX );
+
+  static uchar snap[ DEPTH_MAX ][ FD_QUIC_TX_BATCH_MAX ][ FD_QUIC_MTU ];
+  FD_TEST( send_depth<DEPTH_MAX );
+  uchar (* my_snap)[ FD_QUIC_MTU ] = snap[ send_depth ];
+
+  for( ulong j=0UL; j<batch_cnt; j++ ) {
+    FD_TEST( batch[ j ].buf_sz<=FD_QUIC_MTU );
+    fd_memcpy( my_snap[ j ], batch[ j ].buf, batch[ j ].buf_sz );
+  }
+
+  /* remember the first Initial sent by the client */
+  if( !initial_pkt.buf_sz ) {
+    fd_memcpy( initial_buf, batch[ 0 ].buf, batch[ 0 ].buf_sz );
+    initial_pkt = (fd_aio_pkt_info_t){ .buf = initial_buf, .buf_sz = batch[ 0 ].buf_sz };
+  }
+
+  nested_cnt     += send_depth>0UL;
+  chk->batch_cnt += batch_cnt>1UL;
+  chk->pkt_cnt   += batch_cnt;
+  send_depth++;
+
+  /* forward one datagram at a time, so that the peer can reply before
+     the rest of this batch has been consumed */
+  for( ulong j=0UL; j<batch_cnt; j++ ) {
+    if( send_depth==1UL && chk->dst!=inject_dst && inject_dst && inject_rem ) {
+      inject_rem--;
+      fd_aio_send( inject_dst, &initial_pkt, 1UL, NULL, 1 );
+    }
+    for( ulong k=j; k<batch_cnt; k++ ) {
+      FD_TEST( 0==memcmp( my_snap[ k ], batch[ k ].buf, batch[ k ].buf_sz ) );
+    }
+    fd_aio_send( chk->dst, batch+j, 1UL, NULL, flush && j+1UL==batch_cnt );
+  }
+
+  send_depth--;
+  if( opt_batch_idx ) *opt_batch_idx = batch_cnt;
+  return FD_AIO_SUCCESS;
+}
+
+static ulong rx_byte_cnt;
+
+static int
+test_stream_rx( fd_quic_conn_t * conn,
+                ulong            stream_id,
+                ulong            offset,
+                uchar const *    data,
+                ulong            data_sz,
+                int              fin ) {
+  (void)conn; (void)stream_id; (void)offset; (void)fin;
+  for( ulong j=0UL; j<data_sz; j++ ) FD_TEST( data[ j ]==(uchar)( offset+j ) );
+  rx_byte_cnt += data_sz;
+  return FD_QUIC_SUCCESS;
+}
+
+static int server_complete;
+static int client_complete;
+
+static void
+test_conn_new( fd_quic_conn_t * conn,
+               void *           ctx ) {
+  (void)conn; (void)ctx;
+  server_complete = 1;
+}
+
+static void
+test_hs_complete( fd_quic_conn_t * conn,
+                  void *           ctx ) {
+  (void)conn; (void)ctx;
+  client_complete = 1;
+}
+
+static ulong now = 123;
+
+static ulong
+test_clock( void * ctx ) {
+  (void)ctx;
+  return now;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot          ( &argc, &argv );
+  fd_quic_test_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  ulong cpu_idx = fd_tile_cpu_id( fd_tile_idx() );
+  if( cpu_idx>fd_shmem_cpu_cnt() ) cpu_idx = 0UL;
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "gigantic"                   );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 1UL                          );
+  ulong        numa_idx = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx", NULL, fd_shmem_numa_idx( cpu_idx ) );
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  fd_quic_limits_t const quic_limits = {
+    .conn_cnt           = 2,
+    .conn_id_cnt        = 4,
+    .handshake_cnt      = 2,
+    .stream_id_cnt      = 16,
+    .stream_pool_cnt    = 64,
+    .inflight_frame_cnt = 1024,
+    .tx_buf_sz          = 1<<14
+  };
+
+  fd_quic_t * server_quic = fd_quic_new_anonymous( wksp, &quic_limits, FD_QUIC_ROLE_SERVER, rng );
+  fd_quic_t * client_quic = fd_quic_new_anonymous( wksp, &quic_limits, FD_QUIC_ROLE_CLIENT, rng );
+  FD_TEST( server_quic );
+  FD_TEST( client_quic );
+
+  server_quic->cb.now              = test_clock;
+  server_quic->cb.conn_new         = test_conn_new;
+  server_quic->cb.stream_rx        = test_stream_rx;
+  client_quic->cb.now              = test_clock;
+  client_quic->cb.conn_hs_complete = test_hs_complete;
+
+  /* Retry forces the server to transmit from inside its RX callback */
+  server_quic->config.retry        = 1;
+  server_quic->config.net.tx_batch = 4U;
+  client_quic->config.net.tx_batch = 4U;
+  server_quic->config.ack_delay    = 1UL; /* ACK from every service */
+
+  server_quic->config.initial_rx_max_stream_data = 1<<16;
+  client_quic->config.initial_rx_max_stream_data = 1<<16;
+
+  fd_quic_virtual_pair_t vp;
+  fd_quic_virtual_pair_init( &vp, server_quic, client_quic );
+
+  /* interpose checkers between the pair */
+  check_aio_t chk_s2c = { .dst = vp.aio_a2b };
+  check_aio_t chk_c2s = { .dst = vp.aio_b2a };
+  FD_TEST( fd_aio_join( fd_aio_new( chk_s2c.self, &chk_s2c, check_aio_send ) ) );
+  FD_TEST( fd_aio_join( fd_aio_new( chk_c2s.self, &chk_c2s, check_aio_send ) ) );
+  fd_quic_set_aio_net_tx( server_quic, chk_s2c.self );
+  fd_quic_set_aio_net_tx( client_quic, chk_c2s.self );
+
+  FD_TEST( fd_quic_init( server_quic ) );
+  FD_TEST( fd_quic_init( client_quic ) );
+
+  fd_quic_conn_t * client_conn = fd_quic_connect( client_quic, 0U, 0, 0U, 0 );
+  FD_TEST( client_conn );
+
+  for( ulong j=0UL; j<20UL && !( server_complete && client_complete ); j++ ) {
+    fd_quic_service( client_quic );
+    fd_quic_service( server_quic );
+  }
+  FD_TEST( server_complete && client_complete );
+  FD_TEST( server_quic->metrics.conn_retry_cnt==1UL );
+  FD_TEST( initial_pkt.buf_sz );
+
+  /* from now on, re-enter the server during its own flushes */
+  inject_dst = vp.aio_b2a;
+  inject_rem = 8UL;
+
+  /* several streams worth of data per service call, so that client
+     batches fill up while server ACKs re-enter the client */
+
+  uchar buf[ 1000 ];
+  for( ulong j=0UL; j<sizeof(buf); j++ ) buf[ j ] = (uchar)j;
+
+  ulong sent_byte_cnt = 0UL;
+  for( ulong j=0UL; j<64UL; j++ ) {
+    for( ulong k=0UL; k<4UL; k++ ) {
+      fd_quic_stream_t * stream = fd_quic_conn_new_stream( client_conn );
+      if( !stream ) break;
+      FD_TEST( fd_quic_stream_send( stream, buf, sizeof(buf), 1 )==FD_QUIC_SUCCESS );
+      sent_byte_cnt += sizeof(buf);
+    }
+    now += (ulong)1e6; /* let delayed ACKs fire */
+    fd_quic_service( client_quic );
+    fd_quic_service( server_quic );
+  }
+
+  for( ulong j=0UL; j<16UL; j++ ) {
+    now += (ulong)1e6;
+    fd_quic_service( client_quic );
+    fd_quic_service( server_quic );
+  }
+
+  FD_LOG_NOTICE(( "client: %lu pkts, %lu batches", chk_c2s.pkt_cnt, chk_c2s.batch_cnt ));
+  FD_LOG_NOTICE(( "server: %lu pkts, %lu batches", chk_s2c.pkt_cnt, chk_s2c.batch_cnt ));
+  FD_LOG_NOTICE(( "%lu nested sends, %lu retries", nested_cnt, server_quic->metrics.retry_tx_cnt ));
+
+  FD_TEST( sent_byte_cnt );
+  FD_TEST( rx_byte_cnt==sent_byte_cnt );
+  FD_TEST( chk_c2s.batch_cnt );
+  FD_TEST( !inject_rem );
+  FD_TEST( nested_cnt>=8UL );
+  FD_TEST( server_quic->metrics.retry_tx_cnt==9UL );
+  FD_TEST( !fd_quic_get_state( client_quic )->tx_flush_busy );
+  FD_TEST( !fd_quic_get_state( server_quic )->tx_flush_busy );
+
+  fd_quic_virtual_pair_fini( &vp );
+  fd_aio_delete( fd_aio_leave( chk_s2c.self ) );
+  fd_aio_delete( fd_aio_leave( chk_c2s.self ) );
+  fd_wksp_free_laddr( fd_quic_delete( fd_quic_leave( fd_quic_fini( server_quic ) ) ) );
+  fd_wksp_free_laddr( fd_quic_delete( fd_quic_leave( fd_quic_fini( client_quic ) ) ) );
+  fd_wksp_delete_anonymous( wksp );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_quic_test_halt();
+  fd_halt();
+  return 0;
+}
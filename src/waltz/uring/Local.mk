@@ -0,0 +1,8 @@
+ifdef FD_HAS_HOSTED
+ifdef FD_HAS_LINUX
+$(call add-hdrs,fd_io_uring.h)
+$(call add-objs,fd_io_uring,fd_waltz)
+$(call make-unit-test,test_io_uring,test_io_uring,fd_waltz fd_util)
+$(call run-unit-test,test_io_uring)
+endif # FD_HAS_LINUX
+endif # FD_HAS_HOSTED
@@ -0,0 +1,233 @@
+#if !defined(__linux__)
+#error "fd_io_uring requires Linux operating system with io_uring support"
+#endif
+
+#define _GNU_SOURCE /* syscall, MAP_POPULATE */
+
+#include "fd_io_uring.h"
+#include "../../util/log/fd_log.h"
+
+#include <errno.h>
+#include <unistd.h> /* close, syscall */
+#include <sys/mman.h> /* mmap */
+#include <sys/syscall.h> /* SYS_io_uring_* */
+
+static int
+fd_io_uring_setup_sys( uint                     entries,
+                       struct io_uring_params * p ) {
+  return (int)syscall( SYS_io_uring_setup, entries, p );
+}
+
+static int
+fd_io_uring_register_sys( int    fd,
+                          uint   opcode,
+                          void * arg,
+                          uint   nr_args ) {
+  return (int)syscall( SYS_io_uring_register, fd, opcode, arg, nr_args );
+}
+
+int
+fd_io_uring_enter( fd_io_uring_t * ring,
+                   uint            to_submit,
+                   uint            min_complete,
+                   uint            flags ) {
+  long res = syscall( SYS_io_uring_enter, ring->ring_fd, to_submit, min_complete, flags, NULL, 0UL );
+  if( FD_UNLIKELY( res<0L ) ) return -errno;
+  return (int)res;
+}
+
+fd_io_uring_t *
+fd_io_uring_init( fd_io_uring_t *              ring,
+                  fd_io_uring_params_t const * params ) {
+
+  if( FD_UNLIKELY( !ring   ) ) { FD_LOG_WARNING(( "NULL ring"   )); return NULL; }
+  if( FD_UNLIKELY( !params ) ) { FD_LOG_WARNING(( "NULL params" )); return NULL; }
+
+  uint cq_depth = params->cq_depth ? params->cq_depth : 2U*params->sq_depth;
+  if( FD_UNLIKELY( !fd_uint_is_pow2( params->sq_depth ) || !fd_uint_is_pow2( cq_depth ) || cq_depth<params->sq_depth ) ) {
+    FD_LOG_WARNING(( "invalid {sq,cq}_depth (%u,%u)", params->sq_depth, cq_depth ));
+    return NULL;
+  }
+
+  memset( ring, 0, sizeof(fd_io_uring_t) );
+  ring->ring_fd = -1;
+
+  struct io_uring_params p = {
+    .flags      = params->flags | IORING_SETUP_CQSIZE,
+    .cq_entries = cq_depth
+  };
+  int ring_fd = fd_io_uring_setup_sys( params->sq_depth, &p );
+  if( FD_UNLIKELY( ring_fd<0 ) ) {
+    FD_LOG_WARNING(( "io_uring_setup(%u,flags=%#x) failed (%i-%s)", params->sq_depth, p.flags, errno, fd_io_strerror( errno ) ));
+    return NULL;
+  }
+  ring->ring_fd  = ring_fd;
+  ring->features = p.features;
+
+  /* Map rings.  With IORING_FEAT_SINGLE_MMAP (Linux 5.4), the SQ and CQ
+     rings share one mapping. */
+
+  ulong sq_ring_sz = p.sq_off.array + p.sq_entries*sizeof(uint);
+  ulong cq_ring_sz = p.cq_off.cqes  + p.cq_entries*sizeof(struct io_uring_cqe);
+  int   single     = !!( p.features & IORING_FEAT_SINGLE_MMAP );
+  if( single ) sq_ring_sz = cq_ring_sz = fd_ulong_max( sq_ring_sz, cq_ring_sz );
+
+  void * sq_mem = mmap( NULL, sq_ring_sz, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING );
+  if( FD_UNLIKELY( sq_mem==MAP_FAILED ) ) {
+    FD_LOG_WARNING(( "mmap(IORING_OFF_SQ_RING,%lu) failed (%i-%s)", sq_ring_sz, errno, fd_io_strerror( errno ) ));
+    goto fail;
+  }
+  ring->sq.ring_mem = sq_mem;
+  ring->sq.ring_sz  = sq_ring_sz;
+
+  void * cq_mem = sq_mem;
+  if( !single ) {
+    cq_mem = mmap( NULL, cq_ring_sz, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING );
+    if( FD_UNLIKELY( cq_mem==MAP_FAILED ) ) {
+      FD_LOG_WARNING(( "mmap(IORING_OFF_CQ_RING,%lu) failed (%i-%s)", cq_ring_sz, errno, fd_io_strerror( errno ) ));
+      goto fail;
+    }
+    ring->cq.ring_mem = cq_mem;
+    ring->cq.ring_sz  = cq_ring_sz;
+  }
+
+  ulong sqes_sz = p.sq_entries*sizeof(struct io_uring_sqe);
+  void * sqes = mmap( NULL, sqes_sz, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, ring_fd, IORING_OFF_SQES );
+  if( FD_UNLIKELY( sqes==MAP_FAILED ) ) {
+    FD_LOG_WARNING(( "mmap(IORING_OFF_SQES,%lu) failed (%i-%s)", sqes_sz, errno, fd_io_strerror( errno ) ));
+    goto fail;
+  }
+  ring->sq.sqes    = sqes;
+  ring->sq.sqes_sz = sqes_sz;
+
+  ring->sq.khead  = (uint *)( (ulong)sq_mem + p.sq_off.head  );
+  ring->sq.ktail  = (uint *)( (ulong)sq_mem + p.sq_off.tail  );
+  ring->sq.kflags = (uint *)( (ulong)sq_mem + p.sq_off.flags );
+  ring->sq.array  = (uint *)( (ulong)sq_mem + p.sq_off.array );
+  ring->sq.mask   = FD_VOLATILE_CONST( *(uint *)( (ulong)sq_mem + p.sq_off.ring_mask ) );
+  ring->sq.depth  = p.sq_entries;
+  ring->sq.tail   = FD_VOLATILE_CONST( *ring->sq.ktail );
+
+  ring->cq.khead     = (uint *)( (ulong)cq_mem + p.cq_off.head     );
+  ring->cq.ktail     = (uint *)( (ulong)cq_mem + p.cq_off.tail     );
+  ring->cq.koverflow = (uint *)( (ulong)cq_mem + p.cq_off.overflow );
+  ring->cq.cqes      = (struct io_uring_cqe *)( (ulong)cq_mem + p.cq_off.cqes );
+  ring->cq.mask      = FD_VOLATILE_CONST( *(uint *)( (ulong)cq_mem + p.cq_off.ring_mask ) );
+  ring->cq.depth     = p.cq_entries;
+
+  /* Identity-map the SQ index array so that SQE i is at slot i */
+
+  for( uint j=0U; j<p.sq_entries; j++ ) ring->sq.array[ j ] = j;
+
+  return ring;
+
+fail:
+  fd_io_uring_fini( ring );
+  return NULL;
+}
+
+fd_io_uring_t *
+fd_io_uring_fini( fd_io_uring_t * ring ) {
+  if( FD_UNLIKELY( !ring ) ) return NULL;
+
+  if( ring->sq.sqes && FD_UNLIKELY( 0!=munmap( ring->sq.sqes, ring->sq.sqes_sz ) ) ) {
+    FD_LOG_WARNING(( "munmap(sqes) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  }
+  if( ring->cq.ring_mem && FD_UNLIKELY( 0!=munmap( ring->cq.ring_mem, ring->cq.ring_sz ) ) ) {
+    FD_LOG_WARNING(( "munmap(cq_ring) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  }
+  if( ring->sq.ring_mem && FD_UNLIKELY( 0!=munmap( ring->sq.ring_mem, ring->sq.ring_sz ) ) ) {
+    FD_LOG_WARNING(( "munmap(sq_ring) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  }
+  if( ring->ring_fd>=0 && FD_UNLIKELY( 0!=close( ring->ring_fd ) ) ) {
+    FD_LOG_WARNING(( "close(%d) failed (%i-%s)", ring->ring_fd, errno, fd_io_strerror( errno ) ));
+  }
+
+  memset( ring, 0, sizeof(fd_io_uring_t) );
+  ring->ring_fd = -1;
+  return ring;
+}
+
+fd_io_uring_t *
+fd_io_uring_restrict( fd_io_uring_t * ring,
+                      uchar const *   sqe_op,
+                      ulong           sqe_op_cnt,
+                      uchar           sqe_flags,
+                      uchar const *   register_op,
+                      ulong           register_op_cnt ) {
+
+  struct io_uring_restriction res[ FD_IO_URING_RESTRICTION_MAX ];
+  if( FD_UNLIKELY( sqe_op_cnt+register_op_cnt+1UL>FD_IO_URING_RESTRICTION_MAX ) ) {
+    FD_LOG_WARNING(( "too many restrictions (%lu ops, %lu register ops)", sqe_op_cnt, register_op_cnt ));
+    return NULL;
+  }
+  memset( res, 0, sizeof(res) );
+
+  ulong cnt = 0UL;
+  for( ulong j=0UL; j<sqe_op_cnt; j++ ) {
+    res[ cnt ].opcode = IORING_RESTRICTION_SQE_OP;
+    res[ cnt ].sqe_op = sqe_op[ j ];
+    cnt++;
+  }
+  for( ulong j=0UL; j<register_op_cnt; j++ ) {
+    res[ cnt ].opcode      = IORING_RESTRICTION_REGISTER_OP;
+    res[ cnt ].register_op = register_op[ j ];
+    cnt++;
+  }
+  res[ cnt ].opcode    = IORING_RESTRICTION_SQE_FLAGS_ALLOWED;
+  res[ cnt ].sqe_flags = sqe_flags;
+  cnt++;
+
+  if( FD_UNLIKELY( 0!=fd_io_uring_register_sys( ring->ring_fd, IORING_REGISTER_RESTRICTIONS, res, (uint)cnt ) ) ) {
+    FD_LOG_WARNING(( "io_uring_register(IORING_REGISTER_RESTRICTIONS,%lu) failed (%i-%s)", cnt, errno, fd_io_strerror( errno ) ));
+    return NULL;
+  }
+  return ring;
+}
+
+fd_io_uring_t *
+fd_io_uring_enable( fd_io_uring_t * ring ) {
+  if( FD_UNLIKELY( 0!=fd_io_uring_register_sys( ring->ring_fd, IORING_REGISTER_ENABLE_RINGS, NULL, 0U ) ) ) {
+    FD_LOG_WARNING(( "io_uring_register(IORING_REGISTER_ENABLE_RINGS) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+    return NULL;
+  }
+  return ring;
+}
+
+fd_io_uring_buf_ring_t *
+fd_io_uring_buf_ring_register( fd_io_uring_t *          ring,
+                               fd_io_uring_buf_ring_t * buf_ring,
+                               void *                   mem,
+                               ulong                    depth,
+                               ushort                   bgid ) {
+
+  if( FD_UNLIKELY( !buf_ring ) ) { FD_LOG_WARNING(( "NULL buf_ring" )); return NULL; }
+  if( FD_UNLIKELY( !mem      ) ) { FD_LOG_WARNING(( "NULL mem"      )); return NULL; }
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)mem, FD_IO_URING_BUF_RING_ALIGN ) ) ) {
+    FD_LOG_WARNING(( "misaligned mem" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !fd_ulong_is_pow2( depth ) || depth>32768UL ) ) {
+    FD_LOG_WARNING(( "invalid depth %lu", depth ));
+    return NULL;
+  }
+
+  memset( mem, 0, fd_io_uring_buf_ring_footprint( depth ) );
+
+  struct io_uring_buf_reg reg = {
+    .ring_addr    = (ulong)mem,
+    .ring_entries = (uint)depth,
+    .bgid         = bgid
+  };
+  if( FD_UNLIKELY( 0!=fd_io_uring_register_sys( ring->ring_fd, IORING_REGISTER_PBUF_RING, &reg, 1U ) ) ) {
+    FD_LOG_WARNING(( "io_uring_register(IORING_REGISTER_PBUF_RING,bgid=%u,depth=%lu) failed (%i-%s)",
+                     bgid, depth, errno, fd_io_strerror( errno ) ));
+    return NULL;
+  }
+
+  buf_ring->br   = mem;
+  buf_ring->mask = (uint)depth-1U;
+  buf_ring->tail = 0;
+  buf_ring->bgid = bgid;
+  return buf_ring;
+}
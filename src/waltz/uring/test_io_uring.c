@@ -0,0 +1,245 @@
+#include "fd_io_uring.h"
+#include "../../util/fd_util.h"
+#include "../../util/net/fd_ip4.h"
+
+#include <errno.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+/* Tests a multishot recvmsg with provided buffers and batched sendmsg
+   over loopback UDP. */
+
+#define BUF_CNT (8U)
+#define BUF_SZ  (256U)
+#define PKT_CNT (5U)
+
+static uchar buf_ring_mem[ 4096 ] __attribute__((aligned(FD_IO_URING_BUF_RING_ALIGN)));
+static uchar buf_ring_mem2[ 4096 ] __attribute__((aligned(FD_IO_URING_BUF_RING_ALIGN)));
+static uchar bufs[ BUF_CNT ][ BUF_SZ ];
+
+static int
+udp_socket_loopback( ushort * port ) {
+  int fd = socket( AF_INET, SOCK_DGRAM, IPPROTO_UDP );
+  FD_TEST( fd>=0 );
+  struct sockaddr_in sa = {
+    .sin_family      = AF_INET,
+    .sin_addr.s_addr = FD_IP4_ADDR( 127,0,0,1 ),
+    .sin_port        = 0
+  };
+  FD_TEST( 0==bind( fd, fd_type_pun_const( &sa ), sizeof(struct sockaddr_in) ) );
+  socklen_t sa_sz = sizeof(struct sockaddr_in);
+  FD_TEST( 0==getsockname( fd, fd_type_pun( &sa ), &sa_sz ) );
+  *port = sa.sin_port;
+  return fd;
+}
+
+/* Tests that a restricted ring only runs the allowed requests */
+
+static void
+test_restrict( void ) {
+  fd_io_uring_params_t params = { .sq_depth = 16U, .flags = IORING_SETUP_R_DISABLED|IORING_SETUP_SUBMIT_ALL };
+  fd_io_uring_t ring[1];
+  if( FD_UNLIKELY( !fd_io_uring_init( ring, &params ) ) ) {
+    FD_LOG_WARNING(( "skip: IORING_SETUP_R_DISABLED unsupported" ));
+    return;
+  }
+
+  /* Nothing runs before the ring is enabled */
+  FD_TEST( fd_io_uring_sqe_acquire( ring ) );
+  FD_TEST( fd_io_uring_submit( ring, 0U )==-EBADFD );
+
+  /* Buffer rings can be registered before restricting (like the sock
+     tile does) */
+  fd_io_uring_buf_ring_t buf_ring[2];
+  int pbuf = !!fd_io_uring_buf_ring_register( ring, buf_ring, buf_ring_mem, BUF_CNT, 0 );
+
+  uchar const op[1] = { IORING_OP_NOP };
+  FD_TEST( !fd_io_uring_restrict( ring, op, FD_IO_URING_RESTRICTION_MAX, 0, NULL, 0UL ) );
+  FD_TEST( fd_io_uring_restrict( ring, op, 1UL, IOSQE_IO_LINK, NULL, 0UL )==ring );
+  FD_TEST( !fd_io_uring_restrict( ring, op, 1UL, 0, NULL, 0UL ) ); /* only once */
+  FD_TEST( fd_io_uring_enable( ring )==ring );
+
+  struct io_uring_sqe * sqe;
+  sqe = fd_io_uring_sqe_acquire( ring ); sqe->opcode = IORING_OP_NOP;  sqe->user_data = 1UL;
+  sqe = fd_io_uring_sqe_acquire( ring ); sqe->opcode = IORING_OP_NOP;  sqe->user_data = 2UL; sqe->flags = IOSQE_IO_DRAIN;
+  sqe = fd_io_uring_sqe_acquire( ring ); sqe->opcode = IORING_OP_READ; sqe->user_data = 3UL;
+  FD_TEST( fd_io_uring_submit( ring, 4U )==4 );
+
+  /* The SQE submitted while disabled is still pending in the SQ and
+     runs now.  Rejected SQEs don't stop the batch (SUBMIT_ALL). */
+  uint ready = fd_io_uring_cq_ready( ring );
+  FD_TEST( ready==4U );
+  for( uint j=0U; j<ready; j++ ) {
+    struct io_uring_cqe const * cqe = fd_io_uring_cqe( ring, j );
+    switch( cqe->user_data ) {
+    case 0UL: FD_TEST( cqe->res==0       ); break;
+    case 1UL: FD_TEST( cqe->res==0       ); break;
+    case 2UL: FD_TEST( cqe->res==-EACCES ); break; /* flag not allowed */
+    case 3UL: FD_TEST( cqe->res==-EACCES ); break; /* op not allowed */
+    default:  FD_TEST( 0 );
+    }
+  }
+  fd_io_uring_cq_advance( ring, ready );
+
+  /* No register opcodes were allowed */
+  if( pbuf ) FD_TEST( !fd_io_uring_buf_ring_register( ring, buf_ring+1, buf_ring_mem2, BUF_CNT, 1 ) );
+
+  FD_TEST( fd_io_uring_fini( ring )==ring );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_io_uring_params_t params = { .sq_depth = 16U, .cq_depth = 64U };
+  fd_io_uring_t ring[1];
+  if( FD_UNLIKELY( !fd_io_uring_init( ring, &params ) ) ) {
+    FD_LOG_WARNING(( "skip: io_uring unavailable" ));
+    fd_halt();
+    return 0;
+  }
+  FD_TEST( ring->sq.depth==16U );
+  FD_TEST( ring->cq.depth==64U );
+
+  /* NOP round trip */
+
+  for( ulong j=0UL; j<3UL; j++ ) {
+    struct io_uring_sqe * sqe = fd_io_uring_sqe_acquire( ring );
+    FD_TEST( sqe );
+    sqe->opcode    = IORING_OP_NOP;
+    sqe->user_data = 100UL+j;
+  }
+  FD_TEST( fd_io_uring_submit( ring, 3U )==3 );
+  FD_TEST( fd_io_uring_cq_ready( ring )==3U );
+  for( uint j=0U; j<3U; j++ ) {
+    struct io_uring_cqe const * cqe = fd_io_uring_cqe( ring, j );
+    FD_TEST( cqe->user_data==100UL+j );
+    FD_TEST( cqe->res==0 );
+  }
+  fd_io_uring_cq_advance( ring, 3U );
+  FD_TEST( fd_io_uring_cq_ready( ring )==0U );
+
+  /* SQ full */
+
+  for( ulong j=0UL; j<16UL; j++ ) FD_TEST( fd_io_uring_sqe_acquire( ring ) );
+  FD_TEST( !fd_io_uring_sqe_acquire( ring ) );
+  FD_TEST( fd_io_uring_submit( ring, 16U )==16 );
+  fd_io_uring_cq_advance( ring, fd_io_uring_cq_ready( ring ) );
+
+  /* Provided buffer ring */
+
+  fd_io_uring_buf_ring_t buf_ring[1];
+  FD_TEST( fd_io_uring_buf_ring_footprint( BUF_CNT )<=sizeof(buf_ring_mem) );
+  FD_TEST( !fd_io_uring_buf_ring_register( ring, buf_ring, buf_ring_mem+1, BUF_CNT, 0 ) ); /* misaligned */
+  FD_TEST( !fd_io_uring_buf_ring_register( ring, buf_ring, buf_ring_mem, 3UL, 0 ) ); /* not pow2 */
+  if( FD_UNLIKELY( !fd_io_uring_buf_ring_register( ring, buf_ring, buf_ring_mem, BUF_CNT, 7 ) ) ) {
+    FD_LOG_WARNING(( "skip: provided buffer rings unsupported" ));
+    fd_io_uring_fini( ring );
+    fd_halt();
+    return 0;
+  }
+  for( uint j=0U; j<BUF_CNT; j++ ) {
+    fd_io_uring_buf_ring_add( buf_ring, bufs[ j ], BUF_SZ, (ushort)j, j );
+  }
+  fd_io_uring_buf_ring_advance( buf_ring, BUF_CNT );
+
+  ushort rx_port; int rx_fd = udp_socket_loopback( &rx_port );
+  ushort tx_port; int tx_fd = udp_socket_loopback( &tx_port );
+
+  /* Arm a multishot recvmsg.  The kernel writes each datagram into a
+     provided buffer as io_uring_recvmsg_out, name, control, payload. */
+
+  struct msghdr rx_msg = { .msg_namelen = sizeof(struct sockaddr_in) };
+  struct io_uring_sqe * sqe = fd_io_uring_sqe_acquire( ring );
+  FD_TEST( sqe );
+  sqe->opcode    = IORING_OP_RECVMSG;
+  sqe->fd        = rx_fd;
+  sqe->addr      = (ulong)&rx_msg;
+  sqe->len       = 1U;
+  sqe->ioprio    = IORING_RECV_MULTISHOT;
+  sqe->flags     = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = buf_ring->bgid;
+  sqe->user_data = 1UL;
+  FD_TEST( fd_io_uring_submit( ring, 0U )==1 );
+
+  /* Send a batch of datagrams with one SENDMSG SQE each */
+
+  struct sockaddr_in dst = {
+    .sin_family      = AF_INET,
+    .sin_addr.s_addr = FD_IP4_ADDR( 127,0,0,1 ),
+    .sin_port        = rx_port
+  };
+  uchar         payload[ PKT_CNT ][ 64 ];
+  struct iovec  tx_iov [ PKT_CNT ];
+  struct msghdr tx_msg [ PKT_CNT ];
+  for( uint j=0U; j<PKT_CNT; j++ ) {
+    memset( payload[ j ], (int)j, sizeof(payload[ j ]) );
+    tx_iov[ j ] = (struct iovec) { .iov_base = payload[ j ], .iov_len = 10UL+j };
+    tx_msg[ j ] = (struct msghdr) {
+      .msg_name    = &dst,
+      .msg_namelen = sizeof(struct sockaddr_in),
+      .msg_iov     = tx_iov+j,
+      .msg_iovlen  = 1
+    };
+    sqe = fd_io_uring_sqe_acquire( ring );
+    FD_TEST( sqe );
+    sqe->opcode    = IORING_OP_SENDMSG;
+    sqe->fd        = tx_fd;
+    sqe->addr      = (ulong)( tx_msg+j );
+    sqe->len       = 1U;
+    sqe->msg_flags = MSG_DONTWAIT;
+    sqe->user_data = 2UL;
+  }
+  FD_TEST( fd_io_uring_submit( ring, 0U )==(int)PKT_CNT );
+
+  /* Reap completions until all sends and receives are accounted for */
+
+  uint send_cnt = 0U;
+  uint recv_cnt = 0U;
+  for( ulong iter=0UL; iter<1000UL && ( send_cnt<PKT_CNT || recv_cnt<PKT_CNT ); iter++ ) {
+    if( !fd_io_uring_cq_ready( ring ) ) {
+      FD_TEST( fd_io_uring_enter( ring, 0U, 1U, IORING_ENTER_GETEVENTS )>=0 );
+    }
+    uint ready = fd_io_uring_cq_ready( ring );
+    for( uint j=0U; j<ready; j++ ) {
+      struct io_uring_cqe const * cqe = fd_io_uring_cqe( ring, j );
+      if( cqe->user_data==2UL ) {
+        FD_TEST( cqe->res==(int)(10U+send_cnt) );
+        send_cnt++;
+        continue;
+      }
+      FD_TEST( cqe->user_data==1UL );
+      FD_TEST( cqe->res>0 );
+      FD_TEST( cqe->flags & IORING_CQE_F_BUFFER );
+      FD_TEST( cqe->flags & IORING_CQE_F_MORE );
+      uint bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+      FD_TEST( bid==recv_cnt ); /* buffers are consumed in ring order */
+
+      struct io_uring_recvmsg_out out = FD_LOAD( struct io_uring_recvmsg_out, bufs[ bid ] );
+      FD_TEST( out.namelen==sizeof(struct sockaddr_in) );
+      FD_TEST( out.payloadlen==10U+recv_cnt );
+      struct sockaddr_in src = FD_LOAD( struct sockaddr_in, bufs[ bid ]+sizeof(struct io_uring_recvmsg_out) );
+      FD_TEST( src.sin_port==tx_port );
+      uchar const * data = bufs[ bid ] + sizeof(struct io_uring_recvmsg_out) + rx_msg.msg_namelen + rx_msg.msg_controllen;
+      FD_TEST( (ulong)cqe->res==sizeof(struct io_uring_recvmsg_out) + rx_msg.msg_namelen + rx_msg.msg_controllen + out.payloadlen );
+      for( uint k=0U; k<out.payloadlen; k++ ) FD_TEST( data[ k ]==(uchar)recv_cnt );
+      recv_cnt++;
+    }
+    fd_io_uring_cq_advance( ring, ready );
+  }
+  FD_TEST( send_cnt==PKT_CNT );
+  FD_TEST( recv_cnt==PKT_CNT );
+
+  FD_TEST( 0==close( tx_fd ) );
+  FD_TEST( 0==close( rx_fd ) );
+  FD_TEST( fd_io_uring_fini( ring )==ring );
+  FD_TEST( ring->ring_fd==-1 );
+
+  test_restrict();
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -6,6 +6,8 @@ $(call add-objs,fd_xsk fd_xdp1 fd_xdp_redirect_user,fd_waltz)
 
 $(call make-unit-test,test_xdp_ebpf,test_xdp_ebpf,fd_waltz fd_util)
 $(call run-unit-test,test_xdp_ebpf)
+$(call make-unit-test,test_xsk,test_xsk,fd_waltz fd_util)
+$(call run-unit-test,test_xsk)
 endif # FD_HAS_LINUX
 endif # FD_HAS_HOSTED
 
@@ -110,7 +110,8 @@ fd_xdp_install( uint           if_idx,
                 uint           listen_ip4_addr,
                 ulong          ports_cnt,
                 ushort const * ports,
-                char const *   xdp_mode ) {
+                char const *   xdp_mode,
+                int            has_frags ) {
   /* Check args */
 
   uint uxdp_mode = 0;
@@ -143,14 +144,15 @@ fd_xdp_install( uint           if_idx,
 
   char ebpf_kern_log[ 32768UL ];
   union bpf_attr attr = {
-    .prog_type = BPF_PROG_TYPE_XDP,
-    .insn_cnt  = (uint)code_cnt,
-    .insns     = (ulong)code_buf,
-    .license   = (ulong)FD_LICENSE,
+    .prog_type  = BPF_PROG_TYPE_XDP,
+    .insn_cnt   = (uint)code_cnt,
+    .insns      = (ulong)code_buf,
+    .license    = (ulong)FD_LICENSE,
+    .prog_flags = has_frags ? BPF_F_XDP_HAS_FRAGS : 0U,
     /* Verifier logs */
-    .log_level = 6,
-    .log_size  = 32768UL,
-    .log_buf   = (ulong)ebpf_kern_log
+    .log_level  = 6,
+    .log_size   = 32768UL,
+    .log_buf    = (ulong)ebpf_kern_log
   };
   int prog_fd = (int)bpf( BPF_PROG_LOAD, &attr, sizeof(union bpf_attr) );
   if( FD_UNLIKELY( -1==prog_fd ) ) {
@@ -30,6 +30,11 @@ fd_xdp_gen_program( ulong          code_buf[ 512 ],
    descriptors inserted, one per each queue, with BPF_MAP_UPDATE_ELEM,
    where the sockets are correctly configured XSK sockets.
 
+   If has_frags is non-zero, the program is loaded with
+   BPF_F_XDP_HAS_FRAGS, which is required to redirect multi-buffer
+   packets (e.g. on devices with an MTU larger than a page) to XSKs
+   bound with XDP_USE_SG.
+
    This function will print a diagnostic error message and terminate the
    process if it fails, and will not return in failure cases. */
 
@@ -38,6 +43,7 @@ fd_xdp_install( uint           if_idx,
                 uint           listen_ip4_addr,
                 ulong          ports_cnt,
                 ushort const * ports,
-                char const *   xdp_mode );
+                char const *   xdp_mode,
+                int            has_frags );
 
 #endif /* HEADER_fd_src_waltz_xdp_fd_xdp1_h */
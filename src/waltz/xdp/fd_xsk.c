@@ -239,10 +239,15 @@ fd_xsk_init( fd_xsk_t *              xsk,
   char if_name[ IF_NAMESIZE ] = {0};
 
   if( FD_UNLIKELY( 0!=bind( xsk->xsk_fd, (void *)&sa, sizeof(struct sockaddr_xdp) ) ) ) {
+    int bind_err = errno;
     FD_LOG_WARNING(( "bind( PF_XDP, ifindex=%u (%s), queue_id=%u, flags=%x ) failed (%i-%s)",
                      xsk->if_idx, if_indextoname( xsk->if_idx, if_name ),
                      xsk->if_queue_id, flags,
-                     errno, fd_io_strerror( errno ) ));
+                     bind_err, fd_io_strerror( bind_err ) ));
+    if( ( flags & XDP_USE_SG ) && ( bind_err==EINVAL || bind_err==EOPNOTSUPP ) ) {
+      FD_LOG_WARNING(( "AF_XDP multi-buffer (XDP_USE_SG) requires Linux 6.6 or newer and, in zero copy "
+                       "mode, support from the network driver" ));
+    }
     goto fail;
   }
 
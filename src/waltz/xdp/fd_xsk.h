@@ -99,7 +99,17 @@
                    queue.
 
    Combined, the FILL-RX and TX-COMPLETION rings form two pairs.  The
-   kernel will not move frames between the pairs. */
+   kernel will not move frames between the pairs.
+
+   ### Multi-buffer
+
+   By default, each packet occupies exactly one UMEM frame, which limits
+   the MTU of the network device to the frame size (minus headroom).  If
+   the XSK is bound with the XDP_USE_SG flag (Linux 6.6), packets larger
+   than a frame are split across a chain of frames.  Each descriptor of
+   a chain except the last has the XDP_PKT_CONTD bit set in its options
+   field.  The kernel always delivers complete chains.  The XDP program
+   redirecting to such an XSK must be loaded with BPF_F_XDP_HAS_FRAGS. */
 
 #include <linux/if_link.h>
 #include <linux/if_xdp.h>
@@ -107,6 +117,17 @@
 
 #include "../../util/fd_util_base.h"
 
+/* Multi-buffer (scatter-gather) definitions, missing from older
+   kernel headers */
+
+#ifndef XDP_USE_SG
+#define XDP_USE_SG (1 << 4)
+#endif
+
+#ifndef XDP_PKT_CONTD
+#define XDP_PKT_CONTD (1 << 0)
+#endif
+
 /* FD_XSK_UMEM_ALIGN: byte alignment of UMEM area within fd_xsk_t.
    This requirement is set by the kernel as of Linux 4.18. */
 #define FD_XSK_UMEM_ALIGN (4096UL)
@@ -180,7 +201,8 @@ struct fd_xsk_params {
   /* Interface queue index */
   uint if_queue_id;
 
-  /* sockaddr_xdp.sxdp_flags additional params, e.g. XDP_ZEROCOPY */
+  /* sockaddr_xdp.sxdp_flags additional params, e.g. XDP_ZEROCOPY,
+     XDP_USE_SG */
   uint bind_flags;
 };
 
@@ -239,6 +261,12 @@ fd_xsk_init( fd_xsk_t *              xsk,
 void *
 fd_xsk_delete( void * shxsk );
 
+/* fd_xsk_fini undoes a (partial) fd_xsk_init by unmapping the rings
+   and closing the XSK file descriptor.  Returns xsk. */
+
+fd_xsk_t *
+fd_xsk_fini( fd_xsk_t * xsk );
+
 /* fd_xsk_rx_need_wakeup: returns whether a wakeup is required to
    complete a rx operation */
 
@@ -255,6 +283,29 @@ fd_xsk_tx_need_wakeup( fd_xsk_t * xsk ) {
   return !!( *xsk->ring_tx.flags & XDP_RING_NEED_WAKEUP );
 }
 
+/* fd_xsk_rx_pkt_desc_cnt returns the number of RX descriptors of the
+   packet starting at sequence number rx_seq, or 0 if the descriptor
+   chain of that packet is not fully visible in [rx_seq,rx_prod).  Sets
+   *pkt_sz to the sum of the descriptor lengths on success.  Always
+   returns 1 (if rx_seq!=rx_prod) for an XSK without XDP_USE_SG. */
+
+static inline uint
+fd_xsk_rx_pkt_desc_cnt( fd_xdp_ring_t const * rx_ring,
+                        uint                  rx_seq,
+                        uint                  rx_prod,
+                        ulong *               pkt_sz ) {
+  uint  mask = rx_ring->depth - 1U;
+  ulong sz   = 0UL;
+  for( uint seq=rx_seq; seq!=rx_prod; seq++ ) {
+    struct xdp_desc const * desc = rx_ring->packet_ring + ( seq&mask );
+    sz += desc->len;
+    if( FD_LIKELY( !( desc->options & XDP_PKT_CONTD ) ) ) {
+      *pkt_sz = sz;
+      return seq-rx_seq+1U;
+    }
+  }
+  return 0U;
+}
 
 FD_PROTOTYPES_END
 
@@ -0,0 +1,274 @@
+/* test_xsk: Tests XSK RX descriptor chain handling (AF_XDP
+   multi-buffer).
+
+   With --veth, additionally runs an end-to-end test over a veth pair
+   with a jumbo MTU: creates the pair, installs the XDP program with
+   multi-buffer support, binds an XSK with XDP_USE_SG, injects packets
+   spanning one or more UMEM frames from the peer, and checks that the
+   RX descriptor chains reassemble to the original packets.  Requires
+   root, iproute2, and Linux 6.6 or newer.  Modifies the host network
+   configuration (the veth pair is removed on exit). */
+
+#if !defined(__linux__)
+#error "test_xsk requires Linux operating system with XDP support"
+#endif
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/if_packet.h>
+#include <net/ethernet.h>
+
+#include "fd_xsk.h"
+#include "fd_xdp1.h"
+#include "fd_xdp_redirect_user.h"
+#include "../../util/fd_util.h"
+#include "../../util/net/fd_eth.h"
+#include "../../util/net/fd_ip4.h"
+#include "../../util/net/fd_udp.h"
+
+/* Synthetic descriptor rings *****************************************/
+
+static struct xdp_desc desc_buf[ 8 ];
+
+static void
+test_rx_pkt_desc_cnt( void ) {
+  fd_xdp_ring_t ring = { .packet_ring = desc_buf, .depth = 8U };
+  ulong sz;
+
+  /* Empty ring */
+  sz = 42UL;
+  FD_TEST( fd_xsk_rx_pkt_desc_cnt( &ring, 5U, 5U, &sz )==0U );
+  FD_TEST( sz==42UL );
+
+  /* Single-frame packets */
+  desc_buf[ 5 ] = (struct xdp_desc){ .addr=0x0000, .len=100 };
+  desc_buf[ 6 ] = (struct xdp_desc){ .addr=0x0800, .len=200 };
+  FD_TEST( fd_xsk_rx_pkt_desc_cnt( &ring, 5U, 7U, &sz )==1U ); FD_TEST( sz==100UL );
+  FD_TEST( fd_xsk_rx_pkt_desc_cnt( &ring, 6U, 7U, &sz )==1U ); FD_TEST( sz==200UL );
+
+  /* Chain wrapping around the end of the ring */
+  desc_buf[ 6 ] = (struct xdp_desc){ .addr=0x1000, .len=2048, .options=XDP_PKT_CONTD };
+  desc_buf[ 7 ] = (struct xdp_desc){ .addr=0x1800, .len=2048, .options=XDP_PKT_CONTD };
+  desc_buf[ 0 ] = (struct xdp_desc){ .addr=0x2000, .len= 904 };
+  desc_buf[ 1 ] = (struct xdp_desc){ .addr=0x2800, .len=  64 };
+  FD_TEST( fd_xsk_rx_pkt_desc_cnt( &ring, 6U, 10U, &sz )==3U ); FD_TEST( sz==5000UL );
+  FD_TEST( fd_xsk_rx_pkt_desc_cnt( &ring, 9U, 10U, &sz )==1U ); FD_TEST( sz==  64UL );
+
+  /* Incomplete chain */
+  sz = 42UL;
+  FD_TEST( fd_xsk_rx_pkt_desc_cnt( &ring, 6U, 7U, &sz )==0U );
+  FD_TEST( fd_xsk_rx_pkt_desc_cnt( &ring, 6U, 8U, &sz )==0U );
+  FD_TEST( sz==42UL );
+
+  /* Sequence number wraparound */
+  desc_buf[ 7 ] = (struct xdp_desc){ .addr=0x1800, .len=1000, .options=XDP_PKT_CONTD };
+  desc_buf[ 0 ] = (struct xdp_desc){ .addr=0x2000, .len=  10 };
+  FD_TEST( fd_xsk_rx_pkt_desc_cnt( &ring, UINT_MAX, 1U, &sz )==2U ); FD_TEST( sz==1010UL );
+}
+
+/* veth end-to-end test ***********************************************/
+
+#define VETH_TX   "fdxsk0"
+#define VETH_RX   "fdxsk1"
+#define VETH_MTU  (9000U)
+#define UDP_PORT  (9001)
+#define FRAME_SZ  (2048UL)
+#define FRAME_CNT (64UL)
+#define RING_SZ   (32UL)
+
+static uchar umem[ FRAME_CNT*FRAME_SZ ] __attribute__((aligned(FD_XSK_UMEM_ALIGN)));
+
+static int
+run( char const * cmd ) {
+  int ret = system( cmd );
+  if( FD_UNLIKELY( ret ) ) FD_LOG_WARNING(( "`%s` failed (%d)", cmd, ret ));
+  return ret;
+}
+
+static void
+veth_fini( void ) {
+  (void)!system( "ip link del dev " VETH_TX " 2>/dev/null" );
+}
+
+static void
+if_mac( char const * ifname,
+        uchar        mac[ 6 ] ) {
+  int fd = socket( AF_INET, SOCK_DGRAM, 0 );
+  FD_TEST( fd>=0 );
+  struct ifreq ifr = {0};
+  strncpy( ifr.ifr_name, ifname, IFNAMSIZ-1 );
+  FD_TEST( 0==ioctl( fd, SIOCGIFHWADDR, &ifr ) );
+  memcpy( mac, ifr.ifr_hwaddr.sa_data, 6 );
+  FD_TEST( 0==close( fd ) );
+}
+
+static ulong
+pkt_build( uchar *       pkt,
+           ulong         pkt_sz,
+           uchar const * dst_mac,
+           uchar const * src_mac,
+           uchar         fill ) {
+  fd_eth_hdr_t eth = { .net_type = fd_ushort_bswap( FD_ETH_HDR_TYPE_IP ) };
+  memcpy( eth.dst, dst_mac, 6 );
+  memcpy( eth.src, src_mac, 6 );
+  fd_ip4_hdr_t ip4 = {
+    .verihl      = FD_IP4_VERIHL( 4, 5 ),
+    .net_tot_len = fd_ushort_bswap( (ushort)( pkt_sz-sizeof(fd_eth_hdr_t) ) ),
+    .ttl         = 64,
+    .protocol    = FD_IP4_HDR_PROTOCOL_UDP,
+    .saddr       = FD_IP4_ADDR( 10,0,0,1 ),
+    .daddr       = FD_IP4_ADDR( 10,0,0,2 )
+  };
+  ip4.check = fd_ip4_hdr_check_fast( &ip4 );
+  fd_udp_hdr_t udp = {
+    .net_sport = fd_ushort_bswap( 9000 ),
+    .net_dport = fd_ushort_bswap( UDP_PORT ),
+    .net_len   = fd_ushort_bswap( (ushort)( pkt_sz-sizeof(fd_eth_hdr_t)-sizeof(fd_ip4_hdr_t) ) )
+  };
+  ulong hdr_sz = sizeof(fd_eth_hdr_t)+sizeof(fd_ip4_hdr_t)+sizeof(fd_udp_hdr_t);
+  memcpy( pkt,                                           &eth, sizeof(fd_eth_hdr_t) );
+  memcpy( pkt+sizeof(fd_eth_hdr_t),                      &ip4, sizeof(fd_ip4_hdr_t) );
+  memcpy( pkt+sizeof(fd_eth_hdr_t)+sizeof(fd_ip4_hdr_t), &udp, sizeof(fd_udp_hdr_t) );
+  for( ulong j=hdr_sz; j<pkt_sz; j++ ) pkt[ j ] = (uchar)( fill+j );
+  return pkt_sz;
+}
+
+static void
+test_veth( void ) {
+  if( FD_UNLIKELY( geteuid()!=0 ) ) {
+    FD_LOG_WARNING(( "skip: --veth requires root" ));
+    return;
+  }
+
+  veth_fini();
+  if( FD_UNLIKELY( run( "ip link add dev " VETH_TX " type veth peer name " VETH_RX ) ) ) {
+    FD_LOG_WARNING(( "skip: cannot create veth pair" ));
+    return;
+  }
+  FD_TEST( !run( "ip link set dev " VETH_TX " mtu 9000 up" ) );
+  FD_TEST( !run( "ip link set dev " VETH_RX " mtu 9000 up" ) );
+
+  uint rx_if_idx = if_nametoindex( VETH_RX );
+  uint tx_if_idx = if_nametoindex( VETH_TX );
+  FD_TEST( rx_if_idx && tx_if_idx );
+  uchar rx_mac[ 6 ]; if_mac( VETH_RX, rx_mac );
+  uchar tx_mac[ 6 ]; if_mac( VETH_TX, tx_mac );
+
+  /* Install XDP program on RX side (native veth XDP) */
+
+  ushort port = UDP_PORT;
+  fd_xdp_fds_t fds = fd_xdp_install( rx_if_idx, 0U, 1UL, &port, "drv", 1 );
+
+  /* Bind multi-buffer XSK */
+
+  fd_xsk_params_t params = {
+    .fr_depth    = RING_SZ,
+    .rx_depth    = RING_SZ,
+    .tx_depth    = RING_SZ,
+    .cr_depth    = RING_SZ,
+    .umem_addr   = umem,
+    .frame_sz    = FRAME_SZ,
+    .umem_sz     = sizeof(umem),
+    .if_idx      = rx_if_idx,
+    .if_queue_id = 0U,
+    .bind_flags  = XDP_COPY | XDP_USE_SG
+  };
+  fd_xsk_t xsk[1];
+  if( FD_UNLIKELY( !fd_xsk_init( xsk, &params ) ) ) {
+    FD_LOG_WARNING(( "skip: XDP_USE_SG unsupported" ));
+    FD_TEST( 0==close( fds.prog_link_fd ) );
+    FD_TEST( 0==close( fds.xsk_map_fd   ) );
+    veth_fini();
+    return;
+  }
+  FD_TEST( fd_xsk_activate( xsk, fds.xsk_map_fd ) );
+
+  fd_xdp_ring_t * fill = &xsk->ring_fr;
+  for( ulong j=0UL; j<RING_SZ; j++ ) fill->frame_ring[ j ] = j*FRAME_SZ;
+  FD_VOLATILE( *fill->prod ) = fill->cached_prod = (uint)RING_SZ;
+
+  /* Inject packets from the peer */
+
+  int tx_fd = socket( AF_PACKET, SOCK_RAW, 0 );
+  FD_TEST( tx_fd>=0 );
+  struct sockaddr_ll sll = {
+    .sll_family  = AF_PACKET,
+    .sll_ifindex = (int)tx_if_idx,
+    .sll_halen   = 6
+  };
+  memcpy( sll.sll_addr, rx_mac, 6 );
+
+  static ulong const pkt_szs[] = { 1000UL, 2048UL, 3000UL, 5000UL, 8000UL };
+  ulong const pkt_cnt = sizeof(pkt_szs)/sizeof(pkt_szs[0]);
+  static uchar pkt[ VETH_MTU+sizeof(fd_eth_hdr_t) ];
+  static uchar rx_pkt[ VETH_MTU+sizeof(fd_eth_hdr_t) ];
+
+  fd_xdp_ring_t * rx      = &xsk->ring_rx;
+  uint            rx_seq  = 0U;
+  uint            rx_mask = rx->depth-1U;
+  for( ulong i=0UL; i<pkt_cnt; i++ ) {
+    ulong sz = pkt_build( pkt, pkt_szs[ i ], rx_mac, tx_mac, (uchar)i );
+    FD_TEST( sendto( tx_fd, pkt, sz, 0, fd_type_pun( &sll ), sizeof(struct sockaddr_ll) )==(long)sz );
+
+    /* Wait for the complete chain */
+
+    ulong rx_sz    = 0UL;
+    uint  desc_cnt = 0U;
+    for( ulong iter=0UL; iter<1000000UL && !desc_cnt; iter++ ) {
+      if( fd_xsk_rx_need_wakeup( xsk ) ) {
+        struct msghdr _ignored[ 1 ] = { 0 };
+        (void)recvmsg( xsk->xsk_fd, _ignored, MSG_DONTWAIT );
+      }
+      uint rx_prod = FD_VOLATILE_CONST( *rx->prod );
+      desc_cnt = fd_xsk_rx_pkt_desc_cnt( rx, rx_seq, rx_prod, &rx_sz );
+    }
+    FD_TEST( desc_cnt );
+    FD_LOG_INFO(( "packet of %lu bytes arrived in %u frames", sz, desc_cnt ));
+    FD_TEST( desc_cnt>=(uint)( ( sz+FRAME_SZ-1UL )/FRAME_SZ ) ); /* frames might have headroom */
+    FD_TEST( rx_sz==sz );
+
+    /* Reassemble and return frames to the fill ring */
+
+    ulong off = 0UL;
+    for( uint j=0U; j<desc_cnt; j++ ) {
+      struct xdp_desc desc = rx->packet_ring[ (rx_seq+j)&rx_mask ];
+      FD_TEST( desc.addr+desc.len<=sizeof(umem) );
+      FD_TEST( ( desc.addr & (FRAME_SZ-1UL) )+desc.len<=FRAME_SZ );
+      FD_TEST( !!( desc.options & XDP_PKT_CONTD )==( j+1U<desc_cnt ) );
+      memcpy( rx_pkt+off, umem+desc.addr, desc.len );
+      off += desc.len;
+      fill->frame_ring[ fill->cached_prod&(fill->depth-1U) ] = desc.addr & ~(FRAME_SZ-1UL);
+      fill->cached_prod++;
+    }
+    FD_TEST( 0==memcmp( rx_pkt, pkt, sz ) );
+    rx_seq += desc_cnt;
+    FD_VOLATILE( *rx->cons   ) = rx_seq;
+    FD_VOLATILE( *fill->prod ) = fill->cached_prod;
+  }
+
+  FD_TEST( 0==close( tx_fd ) );
+  fd_xsk_fini( xsk );
+  FD_TEST( 0==close( fds.prog_link_fd ) );
+  FD_TEST( 0==close( fds.xsk_map_fd   ) );
+  veth_fini();
+  FD_LOG_NOTICE(( "veth multi-buffer test passed" ));
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  int veth = fd_env_strip_cmdline_contains( &argc, &argv, "--veth" );
+
+  test_rx_pkt_desc_cnt();
+  if( veth ) test_veth();
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}